@@ -0,0 +1,1065 @@
+/*
+ *  libaes_bench.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This program measures the performance of each AES engine available
+ *      on the processor for each key size and reports the time, throughput,
+ *      and cycles consumed by key setup, batch key setup, single block
+ *      encryption and decryption, multi-block encryption and decryption of
+ *      1 block through 1 MiB, multi-block encryption and decryption under
+ *      cache pressure, CTR mode, AES-CMAC, AES-CCM, OCB, AES Key Wrap, and
+ *      the AES-256 CTR_DRBG.  Each row of output is one measurement,
+ *      written either as CSV or as JSON Lines so that results may be
+ *      compared from one build or machine to the next.
+ *
+ *      The engines are instantiated directly so that each may be measured
+ *      without regard to which engine the AES object would select.  The
+ *      modes use the AES object internally, so they are measured only with
+ *      the engine that AES selects, which may be changed by setting the
+ *      TERRA_AES_ENGINE environment variable.
+ *
+ *      Cycles are read from the time stamp counter on x86 processors, which
+ *      advances at a fixed rate that may differ from the core clock when the
+ *      processor changes frequency.  On other processors, cycles are computed
+ *      from the elapsed time if the clock rate is given via --ghz, which
+ *      also overrides the time stamp counter.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <terra/crypto/cipher/aes.h>
+#include <terra/crypto/cipher/aes_ctr.h>
+#include <terra/crypto/cipher/aes_ctr_drbg.h>
+#include <terra/crypto/cipher/aes_cmac.h>
+#include <terra/crypto/cipher/aes_ccm.h>
+#include <terra/crypto/cipher/aes_ocb.h>
+#include <terra/crypto/cipher/aes_key_wrap.h>
+#include <terra/crypto/cipher/aes_stream.h>
+#include "aes_universal.h"
+#include "aes_intel.h"
+#include "aes_intel_vaes.h"
+#include "aes_arm.h"
+#include "aes_bitsliced.h"
+#include "aes_vector_permute.h"
+
+#ifdef TERRA_USE_INTEL_INTRINSICS
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Key sizes in octets
+constexpr std::size_t Key_Sizes[] = {16, 24, 32};
+
+// Number of blocks processed by each call to EncryptBlocks() and CTR mode
+constexpr std::size_t Block_Counts[] =
+{
+    1, 4, 8, 16, 64, 256, 1024, 4096, 16384, 65536
+};
+
+// Number of blocks processed by each call measured under cache pressure
+constexpr std::size_t Pressure_Block_Counts[] = {1, 4, 16, 64, 256};
+
+// Number of keys expanded by each call to SetKeys()
+constexpr std::size_t Batch_Keys{64};
+
+// Length in octets of the messages authenticated by AES-CMAC
+constexpr std::size_t CMAC_Lengths[] = {16, 64, 256, 1024};
+
+// Length in octets of the keys wrapped by AES Key Wrap
+constexpr std::size_t Key_Wrap_Lengths[] = {16, 32, 64, 512, 4096};
+
+// Length in octets of the random values requested from the CTR_DRBG
+constexpr std::size_t DRBG_Lengths[] = {16, 32, 256, 4096};
+
+// Length in octets of the file encrypted by AESStream
+constexpr std::size_t Stream_File_Length{64 * 1024 * 1024};
+
+// Options given on the command line
+struct Options
+{
+    bool json{false};
+    std::vector<std::string> engines;
+    std::vector<std::string> operations;
+    std::chrono::nanoseconds min_time{std::chrono::milliseconds(100)};
+    double ghz{0.0};
+    std::size_t pressure_length{64 * 1024};
+};
+
+// Result of measuring a single operation
+struct Measurement
+{
+    std::uint64_t iterations;
+    double nanoseconds;
+    std::optional<double> cycles;
+};
+
+/*
+ *  EngineName()
+ *
+ *  Description:
+ *      Return the name used to identify the given engine in the output and
+ *      on the command line.
+ *
+ *  Parameters:
+ *      engine_type [in]
+ *          The AES engine type.
+ *
+ *  Returns:
+ *      The name of the engine.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string EngineName(AESEngineType engine_type)
+{
+    switch (engine_type)
+    {
+        case AESEngineType::Universal:
+            return "universal";
+        case AESEngineType::Intel:
+            return "intel";
+        case AESEngineType::IntelVAES:
+            return "intel_vaes";
+        case AESEngineType::ARM:
+            return "arm";
+        case AESEngineType::Bitsliced:
+            return "bitsliced";
+        case AESEngineType::VectorPermute:
+            return "vector_permute";
+        default:
+            break;
+    }
+
+    return "unavailable";
+}
+
+/*
+ *  ReadCycles()
+ *
+ *  Description:
+ *      Read the processor's time stamp counter, if there is one.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The current cycle count or std::nullopt if no counter is available.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::uint64_t> ReadCycles()
+{
+#ifdef TERRA_USE_INTEL_INTRINSICS
+    return __rdtsc();
+#else
+    return std::nullopt;
+#endif
+}
+
+/*
+ *  Selected()
+ *
+ *  Description:
+ *      Determine whether the given name appears in the list of names given
+ *      on the command line, with an empty list selecting every name.
+ *
+ *  Parameters:
+ *      names [in]
+ *          The names given on the command line.
+ *
+ *      name [in]
+ *          The name to check.
+ *
+ *  Returns:
+ *      True if the name is selected, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool Selected(const std::vector<std::string> &names, const std::string &name)
+{
+    if (names.empty()) return true;
+
+    for (const auto &selected : names)
+    {
+        if (selected == name) return true;
+    }
+
+    return false;
+}
+
+/*
+ *  Measure()
+ *
+ *  Description:
+ *      Repeatedly call the given operation, doubling the number of calls
+ *      until they take at least the minimum time, and return the time and
+ *      cycles consumed by the final set of calls.
+ *
+ *  Parameters:
+ *      options [in]
+ *          The options given on the command line.
+ *
+ *      operation [in]
+ *          The operation to measure.
+ *
+ *      evict [in]
+ *          If given, a function called before each call to the operation to
+ *          evict the operation's data from the processor cache.  The time
+ *          and cycles consumed by this function are not measured.
+ *
+ *  Returns:
+ *      The measurement of the operation.
+ *
+ *  Comments:
+ *      The operation is called once before measuring so that the code and
+ *      data are in the processor cache.  When evicting, each call is timed
+ *      separately, so the measurement includes the cost of reading the
+ *      clock once per call.
+ */
+Measurement Measure(const Options &options,
+                    const std::function<void()> &operation,
+                    const std::function<void()> &evict = {})
+{
+    Measurement measurement{};
+    std::uint64_t iterations = 1;
+
+    operation();
+
+    while (true)
+    {
+        std::chrono::steady_clock::duration elapsed{};
+        std::optional<std::uint64_t> cycles;
+
+        auto start_cycles = ReadCycles();
+        auto start_time = std::chrono::steady_clock::now();
+
+        if (evict)
+        {
+            if (start_cycles) cycles = 0;
+
+            for (std::uint64_t i = 0; i < iterations; i++)
+            {
+                evict();
+
+                auto call_start_cycles = ReadCycles();
+                auto call_start_time = std::chrono::steady_clock::now();
+
+                operation();
+
+                auto call_end_time = std::chrono::steady_clock::now();
+                auto call_end_cycles = ReadCycles();
+
+                elapsed += call_end_time - call_start_time;
+                if (cycles && call_start_cycles && call_end_cycles)
+                {
+                    *cycles += *call_end_cycles - *call_start_cycles;
+                }
+            }
+        }
+        else
+        {
+            for (std::uint64_t i = 0; i < iterations; i++) operation();
+
+            auto end_cycles = ReadCycles();
+
+            elapsed = std::chrono::steady_clock::now() - start_time;
+            if (start_cycles && end_cycles)
+            {
+                cycles = *end_cycles - *start_cycles;
+            }
+        }
+
+        // Stop once the calls, including any eviction, take the minimum time
+        if ((std::chrono::steady_clock::now() - start_time >=
+             options.min_time) ||
+            (iterations >= (std::uint64_t(1) << 40)))
+        {
+            measurement.iterations = iterations;
+            measurement.nanoseconds =
+                std::chrono::duration<double, std::nano>(elapsed).count();
+            if (options.ghz > 0.0)
+            {
+                measurement.cycles = measurement.nanoseconds * options.ghz;
+            }
+            else if (cycles)
+            {
+                measurement.cycles = static_cast<double>(*cycles);
+            }
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    return measurement;
+}
+
+/*
+ *  FormatNumber()
+ *
+ *  Description:
+ *      Format the given value for output, or produce an empty value in the
+ *      chosen output format if there is none.
+ *
+ *  Parameters:
+ *      options [in]
+ *          The options given on the command line.
+ *
+ *      value [in]
+ *          The value to format.
+ *
+ *  Returns:
+ *      The formatted value.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string FormatNumber(const Options &options,
+                         const std::optional<double> &value)
+{
+    std::ostringstream oss;
+
+    if (!value) return options.json ? "null" : "";
+
+    oss << std::fixed << std::setprecision(3) << *value;
+
+    return oss.str();
+}
+
+/*
+ *  PrintHeader()
+ *
+ *  Description:
+ *      Print the column names when producing CSV output.
+ *
+ *  Parameters:
+ *      options [in]
+ *          The options given on the command line.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void PrintHeader(const Options &options)
+{
+    if (options.json) return;
+
+    std::cout << "engine,operation,key_bits,bytes,iterations,ns_per_op,"
+                 "mb_per_s,cycles_per_op,cycles_per_byte"
+              << std::endl;
+}
+
+/*
+ *  Report()
+ *
+ *  Description:
+ *      Measure the given operation and print the result.
+ *
+ *  Parameters:
+ *      options [in]
+ *          The options given on the command line.
+ *
+ *      engine [in]
+ *          The name of the engine performing the operation.
+ *
+ *      name [in]
+ *          The name of the operation.
+ *
+ *      key_length [in]
+ *          The length of the key in octets.
+ *
+ *      bytes [in]
+ *          The number of octets processed by each call to the operation,
+ *          which is zero for key setup.
+ *
+ *      operation [in]
+ *          The operation to measure.
+ *
+ *      count [in]
+ *          The number of operations performed by each call, such as the
+ *          number of keys expanded at once.  The time and cycles reported
+ *          are for a single operation.
+ *
+ *      evict [in]
+ *          If given, a function called before each call to the operation
+ *          to evict its data from the processor cache (see Measure()).
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Report(const Options &options,
+            const std::string &engine,
+            const std::string &name,
+            std::size_t key_length,
+            std::size_t bytes,
+            const std::function<void()> &operation,
+            std::size_t count = 1,
+            const std::function<void()> &evict = {})
+{
+    if (!Selected(options.operations, name)) return;
+
+    Measurement measurement = Measure(options, operation, evict);
+
+    double iterations = static_cast<double>(measurement.iterations * count);
+    double ns_per_op = measurement.nanoseconds / iterations;
+    std::optional<double> mb_per_s;
+    std::optional<double> cycles_per_op;
+    std::optional<double> cycles_per_byte;
+
+    if ((bytes > 0) && (measurement.nanoseconds > 0.0))
+    {
+        mb_per_s = (static_cast<double>(bytes) * iterations * 1000.0) /
+                   measurement.nanoseconds;
+    }
+
+    if (measurement.cycles)
+    {
+        cycles_per_op = *measurement.cycles / iterations;
+        if (bytes > 0) cycles_per_byte = *cycles_per_op / bytes;
+    }
+
+    if (options.json)
+    {
+        std::cout << "{\"engine\":\"" << engine << "\""
+                  << ",\"operation\":\"" << name << "\""
+                  << ",\"key_bits\":" << key_length * 8
+                  << ",\"bytes\":" << bytes
+                  << ",\"iterations\":" << measurement.iterations
+                  << ",\"ns_per_op\":" << FormatNumber(options, ns_per_op)
+                  << ",\"mb_per_s\":" << FormatNumber(options, mb_per_s)
+                  << ",\"cycles_per_op\":"
+                  << FormatNumber(options, cycles_per_op)
+                  << ",\"cycles_per_byte\":"
+                  << FormatNumber(options, cycles_per_byte) << "}"
+                  << std::endl;
+    }
+    else
+    {
+        std::cout << engine << ","
+                  << name << ","
+                  << key_length * 8 << ","
+                  << bytes << ","
+                  << measurement.iterations << ","
+                  << FormatNumber(options, ns_per_op) << ","
+                  << FormatNumber(options, mb_per_s) << ","
+                  << FormatNumber(options, cycles_per_op) << ","
+                  << FormatNumber(options, cycles_per_byte)
+                  << std::endl;
+    }
+}
+
+/*
+ *  ReportKeySetupBatch()
+ *
+ *  Description:
+ *      Measure the expansion of a batch of keys using the SetKeys() function
+ *      of the given engine type.
+ *
+ *  Parameters:
+ *      options [in]
+ *          The options given on the command line.
+ *
+ *      name [in]
+ *          The name of the engine.
+ *
+ *      key_length [in]
+ *          The length of each key in octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Engine is the type of engine to construct and Base is the class that
+ *      provides SetKeys().  The time reported is for one key.
+ */
+template<typename Engine, typename Base>
+void ReportKeySetupBatch(const Options &options,
+                         const std::string &name,
+                         std::size_t key_length)
+{
+    std::vector<std::vector<std::uint8_t>> keys;
+    std::vector<std::span<const std::uint8_t>> key_spans;
+    std::vector<Engine> engines(Batch_Keys);
+    std::vector<Base *> pointers;
+
+    for (std::size_t i = 0; i < Batch_Keys; i++)
+    {
+        keys.emplace_back(key_length, static_cast<std::uint8_t>(i));
+    }
+
+    for (std::size_t i = 0; i < Batch_Keys; i++)
+    {
+        key_spans.emplace_back(keys[i]);
+        pointers.push_back(&engines[i]);
+    }
+
+    Report(options, name, "key_setup_batch", key_length, 0, [&]()
+    {
+        Base::SetKeys(pointers, key_spans);
+    },
+    Batch_Keys);
+}
+
+/*
+ *  BenchmarkEngine()
+ *
+ *  Description:
+ *      Measure key setup and block operations for every key size using the
+ *      given AES engine.
+ *
+ *  Parameters:
+ *      options [in]
+ *          The options given on the command line.
+ *
+ *      engine [in]
+ *          The AES engine to measure.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Single block encryption and decryption operate on the same buffer
+ *      for each call, so these measure the latency of one block.
+ *
+ *      The encrypt_blocks_pressure and decrypt_blocks_pressure operations
+ *      write to a buffer of the length given via --pressure before each
+ *      call, as an application's own data would, evicting any tables used
+ *      by the engine from the processor cache.  Comparing these with the
+ *      encrypt_blocks and decrypt_blocks operations shows the cost of
+ *      reloading the tables, which is reduced for the universal engine by
+ *      building with the TERRA_ENABLE_AES_COMPACT_TABLES or
+ *      TERRA_ENABLE_AES_TABLE_PREFETCH options.
+ */
+void BenchmarkEngine(const Options &options, AESEngine &engine)
+{
+    const std::string name = EngineName(engine.GetEngineType());
+    std::vector<std::uint8_t> key(32, 0x5a);
+    std::vector<std::uint8_t> input(Block_Counts[std::size(Block_Counts) - 1] *
+                                    16);
+    std::vector<std::uint8_t> output(input.size());
+    std::vector<std::uint8_t> pressure(options.pressure_length);
+
+    for (std::size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<std::uint8_t>(i);
+    }
+
+    // Write to each cache line of the pressure buffer
+    auto evict = [&]()
+    {
+        for (std::size_t i = 0; i < pressure.size(); i += 64) pressure[i]++;
+    };
+
+    for (std::size_t key_length : Key_Sizes)
+    {
+        std::span<const std::uint8_t> key_span(key.data(), key_length);
+
+        Report(options, name, "key_setup", key_length, 0, [&]()
+        {
+            engine.SetKey(key_span);
+        });
+        Report(options, name, "key_setup_encrypt_only", key_length, 0, [&]()
+        {
+            engine.SetKey(key_span, AESKeyUsage::EncryptOnly);
+        });
+
+        // Measure batch key expansion for the engines that provide it
+        switch (engine.GetEngineType())
+        {
+#ifdef TERRA_USE_INTEL_INTRINSICS
+#ifdef HAVE_VAES
+            case AESEngineType::IntelVAES:
+                ReportKeySetupBatch<AESIntelVAES, AESIntel>(options,
+                                                            name,
+                                                            key_length);
+                break;
+#endif
+
+            case AESEngineType::Intel:
+                ReportKeySetupBatch<AESIntel, AESIntel>(options,
+                                                        name,
+                                                        key_length);
+                break;
+#endif
+
+            case AESEngineType::Universal:
+                ReportKeySetupBatch<AESUniversal, AESUniversal>(options,
+                                                                name,
+                                                                key_length);
+                break;
+
+            default:
+                break;
+        }
+
+        engine.SetKey(key_span);
+
+        std::span<std::uint8_t, 16> block(output.data(), 16);
+
+        Report(options, name, "encrypt_block", key_length, 16, [&]()
+        {
+            engine.Encrypt(block, block);
+        });
+        Report(options, name, "decrypt_block", key_length, 16, [&]()
+        {
+            engine.Decrypt(block, block);
+        });
+
+        for (std::size_t blocks : Block_Counts)
+        {
+            std::span<const std::uint8_t> in(input.data(), blocks * 16);
+            std::span<std::uint8_t> out(output.data(), blocks * 16);
+
+            Report(options, name, "encrypt_blocks", key_length, in.size(),
+                   [&]() { engine.EncryptBlocks(in, out); });
+            Report(options, name, "decrypt_blocks", key_length, in.size(),
+                   [&]() { engine.DecryptBlocks(in, out); });
+        }
+
+        if (pressure.empty()) continue;
+
+        for (std::size_t blocks : Pressure_Block_Counts)
+        {
+            std::span<const std::uint8_t> in(input.data(), blocks * 16);
+            std::span<std::uint8_t> out(output.data(), blocks * 16);
+
+            Report(options, name, "encrypt_blocks_pressure", key_length,
+                   in.size(), [&]() { engine.EncryptBlocks(in, out); }, 1,
+                   evict);
+            Report(options, name, "decrypt_blocks_pressure", key_length,
+                   in.size(), [&]() { engine.DecryptBlocks(in, out); }, 1,
+                   evict);
+        }
+    }
+}
+
+/*
+ *  BenchmarkModes()
+ *
+ *  Description:
+ *      Measure CTR mode, AES-CMAC, AES-CCM, OCB, and AES Key Wrap for every
+ *      key size, and the CTR_DRBG for 256-bit keys, using the engine that
+ *      the AES object selects.
+ *
+ *  Parameters:
+ *      options [in]
+ *          The options given on the command line.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void BenchmarkModes(const Options &options)
+{
+    std::vector<std::uint8_t> key(32, 0xa5);
+    std::vector<std::uint8_t> input(Block_Counts[std::size(Block_Counts) - 1] *
+                                    16);
+    std::vector<std::uint8_t> output(input.size() + 8);
+    std::array<std::uint8_t, 16> counter{};
+
+    for (std::size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<std::uint8_t>(i);
+    }
+
+    for (std::size_t key_length : Key_Sizes)
+    {
+        std::span<const std::uint8_t> key_span(key.data(), key_length);
+        const std::string name =
+            EngineName(AES(key_span).GetEngineType());
+
+        if (!Selected(options.engines, name)) continue;
+
+        AESCTR aes_ctr(key_span, counter);
+
+        for (std::size_t blocks : Block_Counts)
+        {
+            std::span<const std::uint8_t> in(input.data(), blocks * 16);
+            std::span<std::uint8_t> out(output.data(), blocks * 16);
+
+            Report(options, name, "ctr", key_length, in.size(), [&]()
+            {
+                aes_ctr.Encrypt(in, out);
+            });
+        }
+
+        AESCMAC aes_cmac(key_span);
+        std::array<std::uint8_t, 16> tag{};
+
+        for (std::size_t length : CMAC_Lengths)
+        {
+            std::span<const std::uint8_t> in(input.data(), length);
+            std::vector<std::span<const std::uint8_t>> messages;
+            std::vector<std::span<std::uint8_t>> tags;
+
+            // Independent messages, one for each lane of ComputeTags()
+            for (std::size_t i = 0; i < AESCMAC::Parallel_Messages; i++)
+            {
+                messages.emplace_back(input.data() + i * length, length);
+                tags.emplace_back(output.data() + i * 16, 16);
+            }
+
+            Report(options, name, "cmac", key_length, length, [&]()
+            {
+                aes_cmac.Compute(in, tag);
+            });
+            Report(options,
+                   name,
+                   "cmac_tags",
+                   key_length,
+                   length * messages.size(),
+                   [&]() { aes_cmac.ComputeTags(messages, tags); });
+        }
+
+        AESCCM aes_ccm(key_span);
+        std::array<std::uint8_t, 12> nonce{};
+
+        for (std::size_t blocks : Block_Counts)
+        {
+            std::span<const std::uint8_t> in(input.data(), blocks * 16);
+            std::span<std::uint8_t> out(output.data(), blocks * 16);
+
+            Report(options, name, "ccm", key_length, in.size(), [&]()
+            {
+                aes_ccm.Encrypt(nonce, {}, in, out, tag);
+            });
+        }
+
+        AESOCB aes_ocb(key_span);
+
+        for (std::size_t blocks : Block_Counts)
+        {
+            std::span<const std::uint8_t> in(input.data(), blocks * 16);
+            std::span<std::uint8_t> out(output.data(), blocks * 16);
+
+            Report(options, name, "ocb", key_length, in.size(), [&]()
+            {
+                aes_ocb.Encrypt(nonce, {}, in, out, tag);
+            });
+        }
+
+        AESKeyWrap aes_key_wrap(key_span);
+
+        for (std::size_t length : Key_Wrap_Lengths)
+        {
+            std::span<const std::uint8_t> in(input.data(), length);
+            std::span<std::uint8_t> out(output.data(), length + 8);
+            std::vector<std::uint8_t> wrapped(length + 8);
+
+            aes_key_wrap.Wrap(in, wrapped);
+
+            Report(options, name, "key_wrap", key_length, length, [&]()
+            {
+                aes_key_wrap.Wrap(in, out);
+            });
+            Report(options, name, "key_unwrap", key_length, length, [&]()
+            {
+                if (!aes_key_wrap.Unwrap(wrapped, out.first(length)))
+                {
+                    throw AESException("Key unwrap failed");
+                }
+            });
+        }
+
+        if (key_length != AESCTRDRBG::Key_Length) continue;
+
+        AESCTRDRBG drbg;
+
+        for (std::size_t length : DRBG_Lengths)
+        {
+            std::span<std::uint8_t> out(output.data(), length);
+
+            Report(options, name, "drbg", key_length, length, [&]()
+            {
+                drbg.Generate(out);
+            });
+        }
+    }
+}
+
+/*
+ *  BenchmarkStreams()
+ *
+ *  Description:
+ *      Measure AESStream encrypting a file in place with CTR, GCM, and XTS
+ *      using 256-bit keys and the engine that the AES object selects.
+ *
+ *  Parameters:
+ *      options [in]
+ *          The options given on the command line.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The file is created in the temporary directory and will usually
+ *      remain in the page cache, so this measures the cost of the cipher
+ *      and of mapping the file rather than the speed of the storage device.
+ */
+void BenchmarkStreams(const Options &options)
+{
+    const std::vector<std::uint8_t> key(64, 0xa5);
+    const std::span<const std::uint8_t> key_span(key.data(), 32);
+    const std::array<std::uint8_t, 16> iv{};
+    std::array<std::uint8_t, 16> tag{};
+    const std::string name = EngineName(AES(key_span).GetEngineType());
+
+    if (!Selected(options.engines, name)) return;
+
+    if (!Selected(options.operations, "stream_ctr") &&
+        !Selected(options.operations, "stream_gcm") &&
+        !Selected(options.operations, "stream_xts"))
+    {
+        return;
+    }
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "libaes_bench_stream";
+
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        const std::vector<char> data(Stream_File_Length, 0x5a);
+
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file) throw AESException("Unable to write the stream file");
+    }
+
+    try
+    {
+        AESStream aes_ctr(AESStreamMode::CTR, key_span);
+        AESStream aes_gcm(AESStreamMode::GCM, key_span);
+        AESStream aes_xts(AESStreamMode::XTS, key);
+
+        // Each encryption consumes the IV, so it is set for every run
+        Report(options, name, "stream_ctr", 32, Stream_File_Length, [&]()
+        {
+            aes_ctr.SetIV(iv);
+            aes_ctr.EncryptFileInPlace(path);
+        });
+        Report(options, name, "stream_gcm", 32, Stream_File_Length, [&]()
+        {
+            aes_gcm.SetIV(std::span(iv).first(12));
+            aes_gcm.EncryptFileInPlace(path, tag);
+        });
+        Report(options, name, "stream_xts", 32, Stream_File_Length, [&]()
+        {
+            aes_xts.EncryptFileInPlace(path);
+        });
+    }
+    catch (...)
+    {
+        std::filesystem::remove(path);
+        throw;
+    }
+
+    std::filesystem::remove(path);
+}
+
+/*
+ *  Usage()
+ *
+ *  Description:
+ *      Print the command-line syntax.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Usage()
+{
+    std::cerr << "usage: libaes_bench [options]" << std::endl
+              << "  --json             Output JSON Lines rather than CSV"
+              << std::endl
+              << "  --engine NAME      Measure only the named engine "
+                 "(repeatable)" << std::endl
+              << "  --operation NAME   Measure only the named operation "
+                 "(repeatable)" << std::endl
+              << "  --min-time MS      Minimum time per measurement "
+                 "(default 100)" << std::endl
+              << "  --ghz GHZ          Compute cycles from the given clock "
+                 "rate" << std::endl
+              << "  --pressure KIB     Data written between calls under "
+                 "cache pressure" << std::endl
+              << "                     (default 64, 0 to disable)"
+              << std::endl
+              << std::endl
+              << "engines: universal, intel, intel_vaes, arm, bitsliced, "
+                 "vector_permute" << std::endl
+              << "operations: key_setup, key_setup_encrypt_only, "
+                 "key_setup_batch," << std::endl
+              << "    encrypt_block, decrypt_block, encrypt_blocks, "
+                 "decrypt_blocks," << std::endl
+              << "    encrypt_blocks_pressure, decrypt_blocks_pressure, ctr,"
+              << std::endl
+              << "    cmac, cmac_tags, ccm, ocb, key_wrap, key_unwrap, drbg,"
+              << std::endl
+              << "    stream_ctr, stream_gcm, stream_xts" << std::endl;
+}
+
+/*
+ *  ParseOptions()
+ *
+ *  Description:
+ *      Parse the command-line options.
+ *
+ *  Parameters:
+ *      argc [in]
+ *          The number of command-line arguments.
+ *
+ *      argv [in]
+ *          The command-line arguments.
+ *
+ *      options [out]
+ *          The parsed options.
+ *
+ *  Returns:
+ *      True if the options are valid, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool ParseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = argv[i];
+
+        if (option == "--json")
+        {
+            options.json = true;
+            continue;
+        }
+
+        if ((option == "--help") || (i + 1 >= argc)) return false;
+
+        std::string value = argv[++i];
+
+        if (option == "--engine")
+        {
+            options.engines.push_back(value);
+        }
+        else if (option == "--operation")
+        {
+            options.operations.push_back(value);
+        }
+        else if (option == "--min-time")
+        {
+            options.min_time = std::chrono::milliseconds(
+                std::strtoul(value.c_str(), nullptr, 10));
+        }
+        else if (option == "--ghz")
+        {
+            options.ghz = std::strtod(value.c_str(), nullptr);
+        }
+        else if (option == "--pressure")
+        {
+            options.pressure_length =
+                std::strtoul(value.c_str(), nullptr, 10) * 1024;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+
+    if (!ParseOptions(argc, argv, options))
+    {
+        Usage();
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::unique_ptr<AESEngine>> engines;
+    engines.push_back(std::make_unique<AESUniversal>());
+    engines.push_back(std::make_unique<AESIntel>());
+    engines.push_back(std::make_unique<AESIntelVAES>());
+    engines.push_back(std::make_unique<AESARM>());
+    engines.push_back(std::make_unique<AESBitsliced>());
+    engines.push_back(std::make_unique<AESVectorPermute>());
+
+    try
+    {
+        PrintHeader(options);
+
+        for (auto &engine : engines)
+        {
+            const std::string name = EngineName(engine->GetEngineType());
+
+            // Skip engines not built or not supported by this processor
+            if (engine->GetEngineType() == AESEngineType::Unavailable)
+            {
+                continue;
+            }
+
+            if (Selected(options.engines, name))
+            {
+                BenchmarkEngine(options, *engine);
+            }
+        }
+
+        BenchmarkModes(options);
+        BenchmarkStreams(options);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "libaes_bench: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
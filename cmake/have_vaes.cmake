@@ -0,0 +1,23 @@
+#
+# Handle checks to see if the compiler can build functions that use the VAES
+# instructions on 256-bit and 512-bit registers
+#
+
+include(CheckCXXSourceCompiles)
+
+check_cxx_source_compiles("
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+    #define TARGET
+    #else
+    #define TARGET __attribute__((target(\"avx2,avx512f,vaes\")))
+    #endif
+    TARGET __m512i Encrypt512(__m512i a, __m512i b) {
+        return _mm512_aesenc_epi128(a, b);
+    }
+    TARGET __m256i Encrypt256(__m256i a, __m256i b) {
+        return _mm256_aesenc_epi128(a, b);
+    }
+    int main() {
+        return 0;
+    }" HAVE_VAES)
@@ -1,7 +1,7 @@
 /*
  *  aes.h
  *
- *  Copyright (C) 2024, 2025
+ *  Copyright (C) 2024, 2025, 2026
  *  Terrapane Corporation
  *  All Rights Reserved
  *
@@ -14,6 +14,15 @@
  *      This object utilizes one of the underlying AES engines to perform
  *      the actual encryption.
  *
+ *      The engine is normally the fastest one available on the processor.
+ *      A different engine may be chosen for the whole process by setting
+ *      the TERRA_AES_ENGINE environment variable to one of "universal",
+ *      "intel", "intel_vaes", "arm", "bitsliced", or "vector_permute", or
+ *      by calling AES::SetPreferredEngine(), which takes precedence over
+ *      the environment variable.  An engine type given to the constructor
+ *      takes precedence over both.  If the preferred engine cannot be used
+ *      on the processor, the engine is selected as it would be otherwise.
+ *
  *  Portability Issues:
  *      None.
  */
@@ -40,7 +49,19 @@ enum class AESEngineType : std::uint8_t
 {
     Unavailable,
     Universal,
-    Intel
+    Intel,
+    IntelVAES,
+    ARM,
+    Bitsliced,
+    VectorPermute
+};
+
+// Enum that defines how a key will be used, allowing the decryption key
+// schedule to be skipped when only encryption is required (e.g., CTR, GCM)
+enum class AESKeyUsage : std::uint8_t
+{
+    EncryptDecrypt,
+    EncryptOnly
 };
 
 // Define an interface class to facilitate a plurality of AES implementations
@@ -52,25 +73,41 @@ class AESEngine
 
         virtual AESEngineType GetEngineType() const noexcept = 0;
 
-        virtual void SetKey(const std::span<const std::uint8_t> key) = 0;
+        virtual void SetKey(
+            const std::span<const std::uint8_t> key,
+            AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt) = 0;
 
         virtual void ClearKeyState() = 0;
 
         virtual void Encrypt(
             const std::span<const std::uint8_t, 16> plaintext,
-            std::span<std::uint8_t, 16> ciphertext) noexcept = 0;
+            std::span<std::uint8_t, 16> ciphertext) const noexcept = 0;
 
         virtual void Decrypt(
             const std::span<const std::uint8_t, 16> ciphertext,
-            std::span<std::uint8_t, 16> plaintext) noexcept = 0;
+            std::span<std::uint8_t, 16> plaintext) const noexcept = 0;
+
+        virtual void EncryptBlocks(
+            const std::span<const std::uint8_t> plaintext,
+            std::span<std::uint8_t> ciphertext) const noexcept = 0;
+
+        virtual void DecryptBlocks(
+            const std::span<const std::uint8_t> ciphertext,
+            std::span<std::uint8_t> plaintext) const noexcept = 0;
 };
 
 // Define the AES class
 class AES
 {
     public:
+        // Environment variable naming the engine preferred by the process
+        static constexpr char Engine_Variable[] = "TERRA_AES_ENGINE";
+
         AES();
         AES(const std::span<const std::uint8_t> key);
+        AES(AESEngineType engine_type);
+        AES(const std::span<const std::uint8_t> key,
+            AESEngineType engine_type);
         AES(const AES &other);
         AES(AES &&other) noexcept;
         ~AES() = default;
@@ -78,21 +115,35 @@ class AES
         AES &operator=(const AES &other);
         AES &operator=(AES &&other) noexcept;
 
-        void SetKey(const std::span<const std::uint8_t> key);
+        static void SetPreferredEngine(AESEngineType engine_type) noexcept;
+        static AESEngineType GetPreferredEngine() noexcept;
+
+        AESEngineType GetEngineType() const noexcept;
+
+        void SetKey(const std::span<const std::uint8_t> key,
+                    AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt);
 
         void Encrypt(const std::span<const std::uint8_t, 16> plaintext,
-                     std::span<std::uint8_t, 16> ciphertext) noexcept;
+                     std::span<std::uint8_t, 16> ciphertext) const noexcept;
 
         void Decrypt(const std::span<const std::uint8_t, 16> ciphertext,
-                     std::span<std::uint8_t, 16> plaintext) noexcept;
+                     std::span<std::uint8_t, 16> plaintext) const noexcept;
+
+        void EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const;
+
+        void DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const;
 
         bool operator==(const AES &other) const;
         bool operator!=(const AES &other) const;
 
     protected:
         void CreateEngine();
+        void CreateEngine(AESEngineType engine_type);
 
         std::unique_ptr<AESEngine> aes_engine;  // AES engine
+        AESKeyUsage key_usage;                  // Usage of the current key
 };
 
 } // namespace Terra::Crypto::Cipher
@@ -0,0 +1,79 @@
+/*
+ *  aes_cbc.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESCBC object that implements the Cipher Block
+ *      Chaining (CBC) mode of operation as specified in NIST Special
+ *      Publication 800-38A.  This code relies on the AES object to perform
+ *      the encryption and decryption of blocks.
+ *
+ *      CBC encryption of a single message is inherently serial, as each
+ *      block depends on the previous ciphertext block.  Decryption, however,
+ *      depends only on ciphertext, so Decrypt() deciphers several blocks at
+ *      a time using AES::DecryptBlocks().  To gain the same benefit when
+ *      encrypting, EncryptStreams() advances a number of independent
+ *      messages in lockstep, encrypting one block from each with a single
+ *      call to AES::EncryptBlocks().
+ *
+ *      No padding is applied, so the plaintext and ciphertext must be an
+ *      integral number of 16-octet blocks.  Note that invalid span or key
+ *      lengths will cause an exception to be thrown.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <array>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+class AESCBC
+{
+    public:
+        // Number of blocks (or streams) processed per call to the engine
+        static constexpr std::size_t Parallel_Blocks{8};
+
+        AESCBC();
+        AESCBC(const std::span<const std::uint8_t> key);
+        ~AESCBC();
+
+        void SetKey(const std::span<const std::uint8_t> key);
+
+        void Encrypt(const std::span<const std::uint8_t, 16> iv,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext);
+        void Decrypt(const std::span<const std::uint8_t, 16> iv,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext);
+
+        void EncryptStreams(
+                    const std::span<const std::span<const std::uint8_t>> ivs,
+                    const std::span<const std::span<const std::uint8_t>>
+                        plaintexts,
+                    const std::span<const std::span<std::uint8_t>>
+                        ciphertexts);
+
+    protected:
+        AES aes;                                // AES block cipher
+
+        std::array<std::uint8_t, 16> previous;  // Previous ciphertext block
+
+        std::array<std::uint8_t, 16 * Parallel_Blocks> buffer;
+                                                // Block buffer
+};
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,92 @@
+/*
+ *  aes_ccm.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESCCM object that implements the Counter with
+ *      CBC-MAC (CCM) authenticated encryption algorithm as specified in NIST
+ *      Special Publication 800-38C and IETF RFC 3610.  This code relies on
+ *      the AES object to perform the encryption of blocks.
+ *
+ *      CCM requires two AES operations for each block of the payload: one
+ *      to produce the CTR keystream and one to advance the CBC-MAC.  Rather
+ *      than performing these separately, each block of keystream is
+ *      encrypted together with the CBC-MAC block with a single call to
+ *      AES::EncryptBlocks(), allowing the engine to interleave the two.
+ *
+ *      The nonce may be between 7 and 13 octets and the tag may be any even
+ *      length between 4 and 16 octets.  The associated data is
+ *      authenticated directly from the caller's buffer.  Note that invalid
+ *      span or key lengths will cause an exception to be thrown.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <array>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+class AESCCM
+{
+    public:
+        // Minimum and maximum nonce length in octets
+        static constexpr std::size_t Min_Nonce_Length{7};
+        static constexpr std::size_t Max_Nonce_Length{13};
+
+        // Minimum and maximum tag length in octets
+        static constexpr std::size_t Min_Tag_Length{4};
+        static constexpr std::size_t Max_Tag_Length{16};
+
+        AESCCM();
+        AESCCM(const std::span<const std::uint8_t> key);
+        ~AESCCM();
+
+        void SetKey(const std::span<const std::uint8_t> key);
+
+        void Encrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> tag);
+        bool Decrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext,
+                     const std::span<const std::uint8_t> tag);
+
+    protected:
+        void CheckParameters(const std::span<const std::uint8_t> nonce,
+                             const std::span<const std::uint8_t> input,
+                             const std::span<const std::uint8_t> output,
+                             std::size_t tag_length) const;
+        void Start(const std::span<const std::uint8_t> nonce,
+                   const std::span<const std::uint8_t> aad,
+                   std::size_t text_length,
+                   std::size_t tag_length);
+        void Absorb(const std::uint8_t *data, std::size_t length);
+        void EncryptPair(const std::array<std::uint8_t, 16> &counter_block);
+
+        AES aes;                                // AES block cipher
+
+        std::array<std::uint8_t, 16> counter;   // Next counter block
+        std::array<std::uint8_t, 16> counter0;  // Counter block for the tag
+
+        std::array<std::uint8_t, 32> blocks;    // CBC-MAC and keystream
+        std::size_t absorbed;                   // Data octets in MAC block
+};
+
+} // namespace Terra::Crypto::Cipher
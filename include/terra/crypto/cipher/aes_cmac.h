@@ -0,0 +1,94 @@
+/*
+ *  aes_cmac.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESCMAC object that implements the AES-CMAC
+ *      message authentication code as specified in IETF RFC 4493 and NIST
+ *      Special Publication 800-38B.  This code relies on the AES object to
+ *      perform the encryption of blocks.
+ *
+ *      The subkeys K1 and K2 are derived once when the key is set.  A
+ *      message may be authenticated incrementally via Update() and Final(),
+ *      or with a single call to Compute() or Verify().
+ *
+ *      CMAC is a CBC-MAC and therefore inherently serial within a message.
+ *      To make use of the parallelism offered by the AES engine, ComputeTags()
+ *      advances a number of independent messages in lockstep, encrypting one
+ *      block from each with a single call to AES::EncryptBlocks().
+ *
+ *      Tags may be truncated to as few as 4 octets by providing a shorter
+ *      span for the tag.  Note that invalid span or key lengths will cause
+ *      an exception to be thrown.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <array>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+class AESCMAC
+{
+    public:
+        // Number of messages processed per call to the engine
+        static constexpr std::size_t Parallel_Messages{8};
+
+        // Minimum and maximum tag length in octets
+        static constexpr std::size_t Min_Tag_Length{4};
+        static constexpr std::size_t Max_Tag_Length{16};
+
+        AESCMAC();
+        AESCMAC(const std::span<const std::uint8_t> key);
+        ~AESCMAC();
+
+        void SetKey(const std::span<const std::uint8_t> key);
+
+        void Reset() noexcept;
+        void Update(const std::span<const std::uint8_t> data);
+        void Final(std::span<std::uint8_t> tag);
+
+        void Compute(const std::span<const std::uint8_t> message,
+                     std::span<std::uint8_t> tag);
+        bool Verify(const std::span<const std::uint8_t> message,
+                    const std::span<const std::uint8_t> tag);
+
+        void ComputeTags(
+                    const std::span<const std::span<const std::uint8_t>>
+                        messages,
+                    const std::span<const std::span<std::uint8_t>> tags);
+
+    protected:
+        void DeriveSubkeys();
+        void CheckTagLength(std::size_t tag_length) const;
+        void FinalBlock(const std::uint8_t *data,
+                        std::size_t length,
+                        std::uint8_t *block) const noexcept;
+
+        AES aes;                                // AES block cipher
+
+        std::array<std::uint8_t, 16> K1;        // Subkey for a full block
+        std::array<std::uint8_t, 16> K2;        // Subkey for a partial block
+        std::array<std::uint8_t, 16> X;         // Chaining value
+        std::array<std::uint8_t, 16> pending;   // Data not yet processed
+        std::size_t pending_length;             // Octets in pending
+
+        std::array<std::uint8_t, 16 * Parallel_Messages> buffer;
+                                                // Block buffer
+};
+
+} // namespace Terra::Crypto::Cipher
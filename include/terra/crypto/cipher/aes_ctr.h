@@ -0,0 +1,75 @@
+/*
+ *  aes_ctr.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESCTR object that implements the Counter (CTR)
+ *      mode of operation as specified in NIST Special Publication 800-38A.
+ *      This code relies on the AES object to perform the encryption of
+ *      counter blocks.  The counter block is treated as a single 128-bit
+ *      big endian integer that is incremented for each block of keystream.
+ *
+ *      Input of any length may be provided and an operation may be split
+ *      across any number of calls, as unused keystream is retained between
+ *      calls.  Since CTR mode encryption and decryption are the same
+ *      operation, Decrypt() is provided merely for readability.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <array>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+class AESCTR
+{
+    public:
+        // Number of counter blocks encrypted with each call to the engine
+        static constexpr std::size_t Keystream_Blocks{32};
+
+        AESCTR();
+        AESCTR(const std::span<const std::uint8_t> key,
+               const std::span<const std::uint8_t, 16> initial_counter);
+        ~AESCTR();
+
+        void SetKey(const std::span<const std::uint8_t> key);
+        void SetCounter(const std::span<const std::uint8_t, 16> counter);
+
+        void Encrypt(const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext);
+        void Decrypt(const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext);
+
+        AESEngineType GetEngineType() const noexcept
+        {
+            return aes.GetEngineType();
+        }
+
+    protected:
+        void GenerateKeystream(std::size_t blocks);
+
+        AES aes;                                // AES block cipher
+
+        std::array<std::uint8_t, 16> counter;   // Next counter block
+
+        std::array<std::uint8_t, 16 * Keystream_Blocks> keystream;
+                                                // Keystream buffer
+
+        std::size_t keystream_position;         // Next unused keystream octet
+};
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,133 @@
+/*
+ *  aes_ctr_drbg.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESCTRDRBG object that implements the CTR_DRBG
+ *      deterministic random bit generator as specified in NIST Special
+ *      Publication 800-90A using AES-256 without a derivation function.
+ *      This code relies on the AES object to perform the encryption of
+ *      counter blocks.
+ *
+ *      Rather than running the generate function for each request, random
+ *      octets are produced Buffer_Size octets at a time by a single generate
+ *      request and handed out from that buffer until it is exhausted.  Each
+ *      octet handed out is erased from the buffer.  Requests that provide
+ *      additional input, and all requests when prediction resistance is
+ *      enabled, bypass the buffer.
+ *
+ *      Entropy is obtained from the entropy source given to the constructor
+ *      when the DRBG is instantiated and reseeded.  If none is given, the
+ *      operating system's random number generator is used (getrandom(),
+ *      arc4random_buf(), or BCryptGenRandom()).  The entropy source must
+ *      provide full entropy, as there is no derivation function to condition
+ *      it.
+ *
+ *      An AESCTRDRBG object is not thread-safe.  ThreadInstance() returns an
+ *      instance owned by the calling thread, so that each thread may
+ *      generate random octets without locking.
+ *
+ *      If the process forks, an object copied into the child process is
+ *      reseeded, and any buffered octets discarded, before it next produces
+ *      output, so that the parent and child do not produce the same octets.
+ *
+ *      Note that invalid span lengths will cause an exception to be thrown.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <array>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// An entropy source must fill the given span with full-entropy octets or
+// throw an exception if it is unable to do so
+using AESEntropySource = std::function<void(std::span<std::uint8_t>)>;
+
+class AESCTRDRBG
+{
+    public:
+        // Length of the AES-256 key in octets
+        static constexpr std::size_t Key_Length{32};
+
+        // Length of the seed (key and V) in octets
+        static constexpr std::size_t Seed_Length{Key_Length + 16};
+
+        // Number of octets generated per request to refill the buffer
+        static constexpr std::size_t Buffer_Size{4096};
+
+        // Maximum number of octets in a request that bypasses the buffer
+        static constexpr std::size_t Max_Request_Length{65536};
+
+        // Maximum and default requests between reseeds
+        static constexpr std::uint64_t Max_Reseed_Interval{
+            std::uint64_t(1) << 48};
+        static constexpr std::uint64_t Default_Reseed_Interval{
+            std::uint64_t(1) << 20};
+
+        AESCTRDRBG(AESEntropySource entropy_source = {},
+                   const std::span<const std::uint8_t> personalization = {});
+        AESCTRDRBG(const AESCTRDRBG &) = delete;
+        ~AESCTRDRBG();
+
+        AESCTRDRBG &operator=(const AESCTRDRBG &) = delete;
+
+        static AESCTRDRBG &ThreadInstance();
+        static void SystemEntropy(std::span<std::uint8_t> entropy);
+
+        void Reseed(const std::span<const std::uint8_t> additional_input = {});
+
+        void SetPredictionResistance(bool enabled) noexcept;
+        bool GetPredictionResistance() const noexcept;
+
+        void SetReseedInterval(std::uint64_t interval);
+
+        void Generate(std::span<std::uint8_t> output);
+        void Generate(std::span<std::uint8_t> output,
+                      const std::span<const std::uint8_t> additional_input);
+
+    protected:
+        void Instantiate(const std::span<const std::uint8_t> personalization);
+        void Update(const std::span<const std::uint8_t> provided_data);
+        void EncryptCounters(std::uint8_t *output, std::size_t blocks);
+        void SetState(std::uint8_t *temp,
+                      const std::span<const std::uint8_t> provided_data);
+        void GenerateRequest(std::span<std::uint8_t> output,
+                             const std::span<const std::uint8_t>
+                                 additional_input);
+        void CheckFork();
+        void DiscardBuffer() noexcept;
+
+        AESEntropySource entropy_source;        // Source of entropy input
+        bool prediction_resistance;             // Reseed on each request?
+        std::uint64_t reseed_interval;          // Requests between reseeds
+        std::uint64_t reseed_counter;           // Requests since reseeding
+
+        AES aes;                                // AES keyed with Key
+        std::array<std::uint8_t, 16> V;         // Counter block
+
+        std::array<std::uint8_t, 16 * 4> seed;  // Seed material buffer
+
+        std::array<std::uint8_t, Buffer_Size> buffer;
+                                                // Generated octets
+        std::size_t buffer_position;            // Next unused octet
+
+        std::uint64_t fork_count;               // Fork count when seeded
+};
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,122 @@
+/*
+ *  aes_gcm.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESGCM object that implements the Galois/Counter
+ *      Mode (GCM) authenticated encryption algorithm as specified in NIST
+ *      Special Publication 800-38D.  This code relies on the AES object to
+ *      perform the encryption of counter blocks and on an internal GHASH
+ *      engine that uses the PCLMULQDQ instruction when available or a
+ *      table-driven implementation otherwise.
+ *
+ *      Encryption and authentication are performed in a single pass over
+ *      the data: each group of eight blocks is encrypted and then
+ *      immediately hashed while still resident in the processor cache.
+ *
+ *      A message may also be processed incrementally by calling Start(),
+ *      then EncryptUpdate() or DecryptUpdate() any number of times, and then
+ *      Final() or Verify().  Every update except the last must be an
+ *      integral number of blocks.  When decrypting incrementally, plaintext
+ *      is produced before the tag is verified, so it must not be used unless
+ *      Verify() returns true.
+ *
+ *      Note that invalid span or key lengths will cause an exception to be
+ *      thrown.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <array>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// Forward declaration of the internal GHASH engine interface
+class GHASHEngine;
+
+class AESGCM
+{
+    public:
+        // Number of blocks encrypted and hashed per loop iteration
+        static constexpr std::size_t Pipeline_Blocks{8};
+
+        // Maximum plaintext length (2^39 - 256 bits) in octets
+        static constexpr std::uint64_t Max_Plaintext_Length{
+            (std::uint64_t(1) << 36) - 32};
+
+        AESGCM();
+        AESGCM(const std::span<const std::uint8_t> key);
+        ~AESGCM();
+
+        void SetKey(const std::span<const std::uint8_t> key);
+
+        void Encrypt(const std::span<const std::uint8_t> iv,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> tag);
+        bool Decrypt(const std::span<const std::uint8_t> iv,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext,
+                     const std::span<const std::uint8_t> tag);
+
+        void Start(const std::span<const std::uint8_t> iv,
+                   const std::span<const std::uint8_t> aad);
+        void EncryptUpdate(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext);
+        void DecryptUpdate(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext);
+        void Final(std::span<std::uint8_t> tag);
+        bool Verify(const std::span<const std::uint8_t> tag);
+
+        AESEngineType GetEngineType() const noexcept
+        {
+            return aes.GetEngineType();
+        }
+
+    protected:
+        void CreateGHASHEngine();
+        void ComputeJ0(const std::span<const std::uint8_t> iv);
+        void CheckParameters(const std::span<const std::uint8_t> iv,
+                             const std::span<const std::uint8_t> input,
+                             const std::span<const std::uint8_t> output,
+                             std::size_t tag_length) const;
+        void CheckTagLength(std::size_t tag_length) const;
+        void CheckUpdate(const std::span<const std::uint8_t> input,
+                         const std::span<const std::uint8_t> output);
+        void GenerateKeystream(std::size_t blocks);
+        void ComputeTag();
+
+        AES aes;                                // AES block cipher
+        std::unique_ptr<GHASHEngine> ghash;     // GHASH engine
+
+        std::array<std::uint8_t, 16> J0;        // Pre-counter block
+        std::array<std::uint8_t, 16> counter;   // Next counter block
+        std::array<std::uint8_t, 16> S;         // Computed tag
+
+        std::uint64_t aad_length;               // Octets of AAD
+        std::uint64_t text_length;              // Octets of text so far
+        bool text_complete;                     // Partial block processed?
+        bool finalized;                         // Tag computed in S?
+
+        std::array<std::uint8_t, 16 * Pipeline_Blocks> keystream;
+                                                // Keystream buffer
+};
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,106 @@
+/*
+ *  aes_inline.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESInline object that performs encryption and
+ *      decryption as specified in FIPS 197 ("Advanced Encryption Standard").
+ *
+ *      Like the AES object, it selects the best AES engine for the
+ *      processor, but the engine (including the key schedule) is stored
+ *      within the object rather than allocated on the heap.  The engine is
+ *      selected once at construction and calls are dispatched to it
+ *      directly, without a virtual function call.  This makes the object
+ *      suitable where many short-lived AES objects are created (e.g., one
+ *      per session) or where heap allocation is undesirable.
+ *
+ *      Only the engines that AES selects by default may be used, so the
+ *      object is not as large as the largest engine (AESBitsliced).
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// Define the AESInline class
+class AESInline
+{
+    protected:
+        // Space reserved to hold any of the engines that might be selected
+        static constexpr std::size_t Engine_Storage_Size{1056};
+
+    public:
+        AESInline() noexcept;
+        AESInline(const std::span<const std::uint8_t> key,
+                  AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt);
+        AESInline(const AESInline &other) noexcept;
+        AESInline(AESInline &&other) noexcept;
+        ~AESInline();
+
+        AESInline &operator=(const AESInline &other) noexcept;
+        AESInline &operator=(AESInline &&other) noexcept;
+
+        AESEngineType GetEngineType() const noexcept
+        {
+            return engine_type;
+        }
+
+        AESKeyUsage GetKeyUsage() const noexcept
+        {
+            return key_usage;
+        }
+
+        void SetKey(const std::span<const std::uint8_t> key,
+                    AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt);
+
+        void ClearKeyState() noexcept;
+
+        void Encrypt(const std::span<const std::uint8_t, 16> plaintext,
+                     std::span<std::uint8_t, 16> ciphertext) const noexcept;
+
+        void Decrypt(const std::span<const std::uint8_t, 16> ciphertext,
+                     std::span<std::uint8_t, 16> plaintext) const noexcept;
+
+        void EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const;
+
+        void DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const;
+
+        bool operator==(const AESInline &other) const noexcept;
+        bool operator!=(const AESInline &other) const noexcept;
+
+    protected:
+        // AESKeySchedule accesses the engine to encrypt with several keys
+        friend class AESKeySchedule;
+
+        void CreateEngine() noexcept;
+        void CopyEngine(const AESInline &other) noexcept;
+        void DestroyEngine() noexcept;
+
+        // The type of engine held in engine_storage
+        AESEngineType engine_type;
+
+        // The usage given when the key was set
+        AESKeyUsage key_usage;
+
+        // Storage for the AES engine
+        alignas(16) std::uint8_t engine_storage[Engine_Storage_Size];
+};
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,91 @@
+/*
+ *  aes_instrumentation.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines functions to retrieve counts of the work performed
+ *      by the library for each AES engine: blocks encrypted and decrypted,
+ *      keys set, keys wrapped and unwrapped, integrity check failures
+ *      (AES Key Wrap or GCM), and the octets and time spent processing data
+ *      with AESStream, from which throughput may be computed.
+ *
+ *      Counting is performed only if the library is built with the CMake
+ *      option TERRA_ENABLE_AES_INSTRUMENTATION, as otherwise the counting
+ *      code is not compiled and there is no cost.  These functions are
+ *      always present, though all counts will be zero and the hook will
+ *      never be called if instrumentation is not enabled.
+ *
+ *      Counters are updated using relaxed atomic operations, so a snapshot
+ *      taken while other threads use the library may not reflect all of the
+ *      operations in progress at the time.  Blocks processed by the modes
+ *      of operation, AESKeyWrap, and AESParallel are included in the block
+ *      counts, as these use the AES, AESInline, or AESKeySchedule objects.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// Number of values in AESEngineType, used to index per-engine counters
+constexpr std::size_t AES_Engine_Type_Count{7};
+
+// Enum that identifies each of the counters maintained per engine
+enum class AESCounter : std::uint8_t
+{
+    BlocksEncrypted,
+    BlocksDecrypted,
+    KeySetups,
+    KeyWraps,
+    KeyUnwraps,
+    IntegrityFailures,
+    StreamOctets,
+    StreamNanoseconds
+};
+
+// Counts for a single AES engine
+struct AESEngineCounters
+{
+    std::uint64_t blocks_encrypted;
+    std::uint64_t blocks_decrypted;
+    std::uint64_t key_setups;
+    std::uint64_t key_wraps;
+    std::uint64_t key_unwraps;
+    std::uint64_t integrity_failures;
+    std::uint64_t stream_octets;
+    std::uint64_t stream_nanoseconds;
+};
+
+// Counts for all engines, indexed by the AESEngineType value
+using AESInstrumentationSnapshot =
+    std::array<AESEngineCounters, AES_Engine_Type_Count>;
+
+// Function called as each event is counted, which must be thread-safe and
+// must not throw
+using AESInstrumentationHook = void (*)(AESEngineType engine_type,
+                                        AESCounter counter,
+                                        std::uint64_t count);
+
+bool AESInstrumentationEnabled() noexcept;
+
+AESInstrumentationSnapshot GetAESInstrumentation() noexcept;
+
+void ResetAESInstrumentation() noexcept;
+
+void SetAESInstrumentationHook(AESInstrumentationHook hook) noexcept;
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,146 @@
+/*
+ *  aes_key_pool.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESKeyPool object, which holds a large number
+ *      of AES key schedules in a single contiguous region of memory.  Each
+ *      key occupies a slot aligned to 64 octets and sized to the engine
+ *      selected for the pool, which holds only the number of rounds and the
+ *      round keys.  Allocating or freeing a slot takes constant time.
+ *
+ *      Every key in the pool uses the same engine, which is selected as it
+ *      would be for AESInline.  A slot is erased when it is freed and the
+ *      entire region is erased when the pool is destroyed.  The region may
+ *      optionally be locked in memory so that the keys are not written to
+ *      swap space.
+ *
+ *      The Allocate() and Free() functions modify the pool and must not be
+ *      called concurrently with any other function.  The encryption and
+ *      decryption functions are const and may be called concurrently, even
+ *      using the same key.  EncryptBlocks() and DecryptBlocks() throw an
+ *      exception if the handle does not refer to an allocated slot or if
+ *      decrypting with a key allocated for encryption only, while Encrypt()
+ *      and Decrypt() assert the same.
+ *
+ *  Portability Issues:
+ *      Locking memory requires the mlock() (or VirtualLock() on Windows)
+ *      function and is subject to the limits the operating system places
+ *      on the amount of locked memory.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// Enum that defines the type of memory used to hold the key pool
+enum class AESKeyPoolMemory : std::uint8_t
+{
+    Heap,
+    Locked
+};
+
+// Define the AESKeyPool class
+class AESKeyPool
+{
+    public:
+        // Alignment of each key slot
+        static constexpr std::size_t Slot_Alignment{64};
+
+        AESKeyPool(std::size_t capacity,
+                   AESKeyPoolMemory memory = AESKeyPoolMemory::Heap);
+        AESKeyPool(const AESKeyPool &) = delete;
+        ~AESKeyPool();
+
+        AESKeyPool &operator=(const AESKeyPool &) = delete;
+
+        AESEngineType GetEngineType() const noexcept
+        {
+            return engine_type;
+        }
+
+        std::size_t GetCapacity() const noexcept
+        {
+            return capacity;
+        }
+
+        std::size_t GetAllocated() const noexcept
+        {
+            return capacity - free_slots.size();
+        }
+
+        std::size_t GetSlotSize() const noexcept
+        {
+            return slot_size;
+        }
+
+        std::size_t Allocate(
+                    const std::span<const std::uint8_t> key,
+                    AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt);
+
+        void Allocate(
+                    const std::span<const std::span<const std::uint8_t>> keys,
+                    std::span<std::size_t> handles,
+                    AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt);
+
+        void Free(std::size_t handle);
+
+        void Encrypt(std::size_t handle,
+                     const std::span<const std::uint8_t, 16> plaintext,
+                     std::span<std::uint8_t, 16> ciphertext) const noexcept;
+
+        void Decrypt(std::size_t handle,
+                     const std::span<const std::uint8_t, 16> ciphertext,
+                     std::span<std::uint8_t, 16> plaintext) const noexcept;
+
+        void EncryptBlocks(std::size_t handle,
+                           const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const;
+
+        void DecryptBlocks(std::size_t handle,
+                           const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const;
+
+    protected:
+        std::uint8_t *Slot(std::size_t handle) const noexcept
+        {
+            return storage + handle * slot_size;
+        }
+
+        bool ValidHandle(std::size_t handle) const noexcept
+        {
+            return (handle < capacity) && allocated[handle];
+        }
+
+        void ExpandKeys(
+                    const std::span<const std::span<const std::uint8_t>> keys,
+                    const std::span<const std::size_t> handles,
+                    AESKeyUsage key_usage);
+
+        void DestroySlot(std::size_t handle) noexcept;
+
+        AESEngineType engine_type;              // Engine used by every key
+        AESKeyPoolMemory memory;                // Type of memory used
+        std::size_t capacity;                   // Number of slots
+        std::size_t slot_size;                  // Octets per slot
+        std::size_t storage_size;               // Octets in storage
+        std::uint8_t *storage;                  // The slots
+        std::vector<std::size_t> free_slots;    // Slots not allocated
+        std::vector<bool> allocated;            // Slots allocated
+        std::vector<AESKeyUsage> key_usage;     // Key usage of each slot
+};
+
+} // namespace Terra::Crypto::Cipher
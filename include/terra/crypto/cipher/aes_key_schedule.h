@@ -0,0 +1,106 @@
+/*
+ *  aes_key_schedule.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESKeySchedule object, which holds an expanded
+ *      AES key that is computed once at construction and never modified
+ *      thereafter.
+ *
+ *      All of the encryption and decryption functions are const and keep
+ *      their temporary values on the stack, so a single AESKeySchedule
+ *      object may be shared by any number of threads concurrently without
+ *      locking.  This avoids creating a copy of the key schedule for each
+ *      thread in a worker pool.  The object may be copied, but it cannot be
+ *      assigned to or re-keyed, as doing so while another thread is using
+ *      the object would not be safe.
+ *
+ *      The key schedule is held within the object using the same engine
+ *      AESInline would select.
+ *
+ *      The EncryptMultiKey() and DecryptMultiKey() functions process one
+ *      block for each of several key schedules, such as to protect the
+ *      headers of packets belonging to many different connections.  When the
+ *      keys are held by the AES-NI engine, eight blocks are processed in
+ *      lockstep so that the rounds of each are interleaved.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include "aes.h"
+#include "aes_inline.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// Define the AESKeySchedule class
+class AESKeySchedule
+{
+    public:
+        explicit AESKeySchedule(
+            const std::span<const std::uint8_t> key,
+            AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt);
+        AESKeySchedule(const AESKeySchedule &other) noexcept;
+        ~AESKeySchedule() = default;
+
+        AESKeySchedule &operator=(const AESKeySchedule &) = delete;
+        AESKeySchedule &operator=(AESKeySchedule &&) = delete;
+
+        AESEngineType GetEngineType() const noexcept
+        {
+            return engine.GetEngineType();
+        }
+
+        AESKeyUsage GetKeyUsage() const noexcept
+        {
+            return engine.GetKeyUsage();
+        }
+
+        void Encrypt(const std::span<const std::uint8_t, 16> plaintext,
+                     std::span<std::uint8_t, 16> ciphertext) const noexcept;
+
+        void Decrypt(const std::span<const std::uint8_t, 16> ciphertext,
+                     std::span<std::uint8_t, 16> plaintext) const noexcept;
+
+        void EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const;
+
+        void DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const;
+
+        static void EncryptMultiKey(
+            const std::span<const AESKeySchedule * const> key_schedules,
+            const std::span<const std::uint8_t> plaintext,
+            std::span<std::uint8_t> ciphertext);
+
+        static void DecryptMultiKey(
+            const std::span<const AESKeySchedule * const> key_schedules,
+            const std::span<const std::uint8_t> ciphertext,
+            std::span<std::uint8_t> plaintext);
+
+        bool operator==(const AESKeySchedule &other) const noexcept;
+        bool operator!=(const AESKeySchedule &other) const noexcept;
+
+    protected:
+        static void ProcessMultiKey(
+            bool encrypt,
+            const std::span<const AESKeySchedule * const> key_schedules,
+            const std::span<const std::uint8_t> input,
+            std::span<std::uint8_t> output);
+
+        // The engine holding the expanded key
+        const AESInline engine;
+};
+
+} // namespace Terra::Crypto::Cipher
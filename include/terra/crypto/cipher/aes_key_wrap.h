@@ -15,6 +15,16 @@
  *      decryption.  Note that invalid span or key lengths will cause an
  *      exception to be thrown.
  *
+ *      The WrapKeys() and UnwrapKeys() functions (and the corresponding
+ *      functions with padding) process a number of independent keys under
+ *      the same key encryption key, interleaving the steps of up to
+ *      Parallel_Blocks keys so that the AES engine can process those
+ *      blocks in parallel.
+ *
+ *      The InPlace functions operate on a single buffer laid out as the
+ *      eight octet integrity check register followed by the key data, so
+ *      wrapping or unwrapping requires no copy of the input.
+ *
  *      These routines are also documented in NIST Special Publication 800-38F.
  *
  *  Portability Issues:
@@ -24,6 +34,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <memory>
 #include <span>
 #include <array>
@@ -50,9 +61,12 @@ class AESKeyWrap
         // The maximum plaintext length for Key Wrap with Padding
         static constexpr std::size_t AES_Key_Wrap_with_Padding_Max{0xFFFFFFFF};
 
+        // Number of keys processed in parallel by the batch functions
+        static constexpr std::size_t Parallel_Blocks{8};
+
         AESKeyWrap();
         AESKeyWrap(const std::span<const std::uint8_t> key);
-        ~AESKeyWrap();
+        ~AESKeyWrap() = default;
 
         void SetKey(const std::span<const std::uint8_t> key);
 
@@ -64,6 +78,13 @@ class AESKeyWrap
                     std::span<std::uint8_t> integrity = {},
                     const std::span<const std::uint8_t> alternative_iv = {});
 
+        void WrapInPlace(
+                    std::span<std::uint8_t> data,
+                    const std::span<const std::uint8_t> alternative_iv = {});
+        bool UnwrapInPlace(
+                    std::span<std::uint8_t> data,
+                    const std::span<const std::uint8_t> alternative_iv = {});
+
         std::size_t WrapWithPadding(
                     const std::span<const std::uint8_t> plaintext,
                     std::span<std::uint8_t> ciphertext,
@@ -73,27 +94,41 @@ class AESKeyWrap
                     std::span<std::uint8_t> plaintext,
                     const std::span<const std::uint8_t> alternative_iv = {});
 
-    protected:
-        AES aes;                                // AES block cipher
-
-        std::size_t i, j, k;                    // Loop counters
-        std::size_t n;                          // Number of 64-bit blocks
-        std::size_t t, tt;                      // Step counters
-        std::uint8_t *A;                        // Integrity check register
-        std::array<std::uint8_t, 16> B;         // Buffer to encrypt/decrypt
-        std::uint8_t *R;                        // Pointer to register i
-
-        std::uint32_t network_word;             // Word in network byte order
-
-        std::size_t padding_length;             // Number of padding octets
+        std::size_t WrapWithPaddingInPlace(
+                    std::span<std::uint8_t> data,
+                    std::size_t plaintext_length,
+                    const std::span<const std::uint8_t> alternative_iv = {});
+        std::size_t UnwrapWithPaddingInPlace(
+                    std::span<std::uint8_t> data,
+                    const std::span<const std::uint8_t> alternative_iv = {});
 
-        std::uint32_t message_length_indicator; // Message length indicator
+        void WrapKeys(
+                    const std::span<const std::span<const std::uint8_t>>
+                        plaintexts,
+                    const std::span<const std::span<std::uint8_t>> ciphertexts,
+                    const std::span<const std::uint8_t> alternative_iv = {});
+        std::size_t UnwrapKeys(
+                    const std::span<const std::span<const std::uint8_t>>
+                        ciphertexts,
+                    const std::span<const std::span<std::uint8_t>> plaintexts,
+                    std::span<bool> results,
+                    const std::span<const std::uint8_t> alternative_iv = {});
 
-        std::array<std::uint8_t, 8> integrity_data;
-                                                // Integrity data
+        void WrapKeysWithPadding(
+                    const std::span<const std::span<const std::uint8_t>>
+                        plaintexts,
+                    const std::span<const std::span<std::uint8_t>> ciphertexts,
+                    std::span<std::size_t> ciphertext_lengths,
+                    const std::span<const std::uint8_t> alternative_iv = {});
+        std::size_t UnwrapKeysWithPadding(
+                    const std::span<const std::span<const std::uint8_t>>
+                        ciphertexts,
+                    const std::span<const std::span<std::uint8_t>> plaintexts,
+                    std::span<std::size_t> plaintext_lengths,
+                    const std::span<const std::uint8_t> alternative_iv = {});
 
-        std::array<std::uint8_t, 16> plaintext_buffer;
-                                                // Plaintext for one block
+    protected:
+        AES aes;                                // AES block cipher
 };
 
 } // namespace Terra::Crypto::Cipher
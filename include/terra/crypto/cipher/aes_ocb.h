@@ -0,0 +1,142 @@
+/*
+ *  aes_ocb.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESOCB object that implements the OCB
+ *      authenticated encryption algorithm (OCB3) as specified in IETF RFC
+ *      7253.  This code relies on the AES object to perform the encryption
+ *      and decryption of blocks.
+ *
+ *      OCB requires a single AES operation per block of data and no field
+ *      multiplication, and every block may be processed independently.  The
+ *      offsets L_*, L_$, and L_i are computed once when the key is set, and
+ *      the offsets for each group of eight blocks are computed and then
+ *      applied to all eight blocks with a single call to the engine.
+ *
+ *      Associated data may be given to Encrypt() or Decrypt() directly, or
+ *      may be provided in pieces via UpdateAAD() before calling the forms of
+ *      Encrypt() or Decrypt() that do not accept associated data.  Either
+ *      way, the associated data is consumed by the call to Encrypt() or
+ *      Decrypt().
+ *
+ *      The nonce may be between 1 and 15 octets and the tag between 4 and
+ *      16 octets.  Note that invalid span or key lengths will cause an
+ *      exception to be thrown.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <array>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+class AESOCB
+{
+    public:
+        // Number of blocks processed with each call to the engine
+        static constexpr std::size_t Pipeline_Blocks{8};
+
+        // Number of offsets L_i computed when the key is set
+        static constexpr std::size_t L_Table_Size{32};
+
+        // Minimum and maximum nonce length in octets
+        static constexpr std::size_t Min_Nonce_Length{1};
+        static constexpr std::size_t Max_Nonce_Length{15};
+
+        // Minimum and maximum tag length in octets
+        static constexpr std::size_t Min_Tag_Length{4};
+        static constexpr std::size_t Max_Tag_Length{16};
+
+        AESOCB();
+        AESOCB(const std::span<const std::uint8_t> key);
+        ~AESOCB();
+
+        void SetKey(const std::span<const std::uint8_t> key);
+
+        void ResetAAD() noexcept;
+        void UpdateAAD(const std::span<const std::uint8_t> aad);
+
+        void Encrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> tag);
+        void Encrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> tag);
+
+        bool Decrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext,
+                     const std::span<const std::uint8_t> tag);
+        bool Decrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext,
+                     const std::span<const std::uint8_t> tag);
+
+    protected:
+        void CheckParameters(const std::span<const std::uint8_t> nonce,
+                             const std::span<const std::uint8_t> input,
+                             const std::span<const std::uint8_t> output,
+                             std::size_t tag_length) const;
+        void InitialOffset(const std::span<const std::uint8_t> nonce,
+                           std::size_t tag_length);
+        const std::array<std::uint8_t, 16> &GetL(unsigned i);
+        void ComputeOffsets(std::array<std::uint8_t, 16> &current,
+                            std::uint64_t &index,
+                            std::size_t blocks);
+        void HashBlocks(const std::uint8_t *data, std::size_t blocks);
+        void ProcessText(const std::span<const std::uint8_t> input,
+                         std::span<std::uint8_t> output,
+                         bool encrypt);
+        void ComputeTag();
+
+        AES aes;                                // AES block cipher
+
+        std::array<std::uint8_t, 16> L_star;    // L_* = ENCIPHER(K, 0^128)
+        std::array<std::uint8_t, 16> L_dollar;  // L_$ = double(L_*)
+        std::array<std::array<std::uint8_t, 16>, L_Table_Size> L;
+                                                // L_i = double(L_{i-1})
+        std::array<std::uint8_t, 16> L_extra;   // L_i beyond the table
+
+        std::array<std::uint8_t, 16> ktop_input;
+                                                // Nonce input for Ktop
+        std::array<std::uint8_t, 24> stretch;   // Ktop and its extension
+        bool stretch_valid;                     // Is stretch for ktop_input?
+
+        std::array<std::uint8_t, 16> offset;    // Offset for the text
+        std::array<std::uint8_t, 16> checksum;  // Checksum of the plaintext
+        std::uint64_t text_blocks;              // Text blocks processed
+
+        std::array<std::uint8_t, 16> aad_offset;
+                                                // Offset for the AAD
+        std::array<std::uint8_t, 16> aad_sum;   // Sum over the AAD
+        std::array<std::uint8_t, 16> aad_pending;
+                                                // AAD not yet processed
+        std::size_t aad_pending_length;         // Octets in aad_pending
+        std::uint64_t aad_blocks;               // AAD blocks processed
+
+        std::array<std::uint8_t, 16> block;     // Block buffer
+
+        std::array<std::uint8_t, 16 * Pipeline_Blocks> offsets;
+                                                // Offsets or work buffer
+};
+
+} // namespace Terra::Crypto::Cipher
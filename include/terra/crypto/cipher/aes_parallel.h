@@ -0,0 +1,128 @@
+/*
+ *  aes_parallel.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESParallel object, which encrypts or decrypts
+ *      large buffers using multiple threads with the modes of operation
+ *      that do not chain one block to the next: ECB, CTR, the GCTR function
+ *      used by GCM, CBC decryption, and XTS-AES.
+ *
+ *      The buffer is split into chunks of Default_Chunk_Size octets (or the
+ *      size given to the constructor), chosen so that a chunk's input and
+ *      output remain in the processor cache.  The counter, chaining value,
+ *      or sector number at the start of each chunk is computed from its
+ *      position, so the result is identical to that produced by AESCTR,
+ *      AESCBC, AESXTS, or AESGCM on a single thread.
+ *
+ *      Each function accepts an AESKeySchedule, which all of the threads
+ *      use concurrently without copying the key schedule.  The chunks are
+ *      run by a caller-supplied executor or, if none is given, by threads
+ *      created for the call that each claim the next unprocessed chunk
+ *      until none remain.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include "aes_key_schedule.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// An executor must call task(i) once for each i from 0 to tasks - 1, which
+// it may do concurrently on any threads, and return once all calls are done
+using AESTaskExecutor =
+    std::function<void(std::size_t tasks,
+                       const std::function<void(std::size_t)> &task)>;
+
+// Define the AESParallel class
+class AESParallel
+{
+    public:
+        // Default number of octets processed by one thread at a time
+        static constexpr std::size_t Default_Chunk_Size{64 * 1024};
+
+        explicit AESParallel(std::size_t threads = 0,
+                             std::size_t chunk_size = Default_Chunk_Size);
+        explicit AESParallel(AESTaskExecutor executor,
+                             std::size_t chunk_size = Default_Chunk_Size);
+        ~AESParallel() = default;
+
+        void EncryptBlocks(const AESKeySchedule &key_schedule,
+                           const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const;
+        void DecryptBlocks(const AESKeySchedule &key_schedule,
+                           const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const;
+
+        void EncryptCTR(const AESKeySchedule &key_schedule,
+                        const std::span<const std::uint8_t, 16> counter,
+                        const std::span<const std::uint8_t> plaintext,
+                        std::span<std::uint8_t> ciphertext) const;
+        void DecryptCTR(const AESKeySchedule &key_schedule,
+                        const std::span<const std::uint8_t, 16> counter,
+                        const std::span<const std::uint8_t> ciphertext,
+                        std::span<std::uint8_t> plaintext) const;
+
+        void EncryptGCTR(const AESKeySchedule &key_schedule,
+                         const std::span<const std::uint8_t, 16> counter,
+                         const std::span<const std::uint8_t> plaintext,
+                         std::span<std::uint8_t> ciphertext) const;
+        void DecryptGCTR(const AESKeySchedule &key_schedule,
+                         const std::span<const std::uint8_t, 16> counter,
+                         const std::span<const std::uint8_t> ciphertext,
+                         std::span<std::uint8_t> plaintext) const;
+
+        void DecryptCBC(const AESKeySchedule &key_schedule,
+                        const std::span<const std::uint8_t, 16> iv,
+                        const std::span<const std::uint8_t> ciphertext,
+                        std::span<std::uint8_t> plaintext) const;
+
+        void EncryptXTS(const AESKeySchedule &data_key_schedule,
+                        const AESKeySchedule &tweak_key_schedule,
+                        const std::uint64_t sector,
+                        const std::size_t sector_size,
+                        const std::span<const std::uint8_t> plaintext,
+                        std::span<std::uint8_t> ciphertext) const;
+        void DecryptXTS(const AESKeySchedule &data_key_schedule,
+                        const AESKeySchedule &tweak_key_schedule,
+                        const std::uint64_t sector,
+                        const std::size_t sector_size,
+                        const std::span<const std::uint8_t> ciphertext,
+                        std::span<std::uint8_t> plaintext) const;
+
+    protected:
+        void ProcessCounter(const AESKeySchedule &key_schedule,
+                            const std::span<const std::uint8_t, 16> counter,
+                            const std::span<const std::uint8_t> input,
+                            std::span<std::uint8_t> output,
+                            bool counter32) const;
+        void ProcessXTS(const AESKeySchedule &data_key_schedule,
+                        const AESKeySchedule &tweak_key_schedule,
+                        const std::uint64_t sector,
+                        const std::size_t sector_size,
+                        const std::span<const std::uint8_t> input,
+                        std::span<std::uint8_t> output,
+                        bool encrypt) const;
+        void Run(std::size_t tasks,
+                 const std::function<void(std::size_t)> &task) const;
+
+        AESTaskExecutor executor;               // Caller-supplied executor
+        std::size_t threads;                    // Threads if no executor
+        std::size_t chunk_size;                 // Octets per task
+};
+
+} // namespace Terra::Crypto::Cipher
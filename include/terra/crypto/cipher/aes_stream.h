@@ -0,0 +1,186 @@
+/*
+ *  aes_stream.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESStream object that encrypts or decrypts
+ *      files and streams of any length using CTR, GCM, or XTS mode.  This
+ *      code relies on the AESCTR, AESGCM, and AESXTS objects to perform the
+ *      encryption and decryption.
+ *
+ *      Data is processed one chunk at a time so that reading the next chunk
+ *      overlaps with the encryption of the current one.  Files are memory
+ *      mapped one chunk at a time and encrypted directly in the mapped
+ *      pages; the following chunk is mapped and the operating system asked
+ *      to begin reading it before the current chunk is processed, and each
+ *      chunk is scheduled to be written back as soon as it is complete.
+ *      Streams are read into two alternating buffers, with the next chunk
+ *      read on another thread as the current chunk is processed and written.
+ *
+ *      The IV (CTR and GCM) is consumed by each encryption, so SetIV() must
+ *      be called with a new IV before encrypting again; decryption leaves
+ *      it in place.  The additional authenticated data (GCM) and the first
+ *      data unit number and data unit length (XTS) given to this object are
+ *      used for each subsequent operation.  As with the modes themselves, a
+ *      counter or IV must never be reused with the same key.
+ *      XTS data units are processed as with AESXTS, so the final data unit
+ *      must be at least 16 octets in length.  The length of a GCM message
+ *      is limited to AESGCM::Max_Plaintext_Length.  The length of a file is
+ *      checked against these limits before any of it is processed.
+ *
+ *      When decrypting with GCM, a file written to a separate output file is
+ *      truncated if the tag is not valid, and a file decrypted in place is
+ *      first authenticated and only then decrypted, so that unauthenticated
+ *      plaintext is not released.  Plaintext written to an output stream is
+ *      not authenticated until Decrypt() returns true.
+ *
+ *      The octets processed and the time taken are available from
+ *      GetStatistics() and are also counted by the instrumentation counters
+ *      (see aes_instrumentation.h), from which throughput may be computed.
+ *
+ *      Note that invalid span, key, or chunk lengths will cause an exception
+ *      to be thrown, as will any errors reading or writing.
+ *
+ *  Portability Issues:
+ *      Memory mapping is not used on Windows.  Files are instead read and
+ *      written as streams.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <filesystem>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+#include "aes.h"
+#include "aes_ctr.h"
+#include "aes_gcm.h"
+#include "aes_xts.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// Modes of operation supported by AESStream
+enum class AESStreamMode : std::uint8_t
+{
+    CTR,
+    GCM,
+    XTS
+};
+
+// Statistics for the most recent operation
+struct AESStreamStatistics
+{
+    std::uint64_t octets;                   // Octets processed
+    std::uint64_t chunks;                   // Chunks processed
+    std::chrono::nanoseconds elapsed;       // Duration of the operation
+    std::chrono::nanoseconds cipher_time;   // Time spent in the cipher
+    std::chrono::nanoseconds io_time;       // Time waiting for I/O calls
+};
+
+class AESStream
+{
+    public:
+        // Default number of octets processed per chunk
+        static constexpr std::size_t Default_Chunk_Size{4 * 1024 * 1024};
+
+        // Chunk sizes must be a multiple of this, the largest page size
+        static constexpr std::size_t Chunk_Alignment{64 * 1024};
+
+        // Default XTS data unit length in octets
+        static constexpr std::size_t Default_Data_Unit_Length{4096};
+
+        AESStream(AESStreamMode mode,
+                  std::size_t chunk_size = Default_Chunk_Size);
+        AESStream(AESStreamMode mode,
+                  const std::span<const std::uint8_t> key,
+                  std::size_t chunk_size = Default_Chunk_Size);
+        AESStream(const AESStream &) = delete;
+        ~AESStream();
+
+        AESStream &operator=(const AESStream &) = delete;
+
+        void SetKey(const std::span<const std::uint8_t> key);
+        void SetIV(const std::span<const std::uint8_t> iv);
+        void SetAAD(const std::span<const std::uint8_t> aad);
+        void SetDataUnit(std::uint64_t data_unit,
+                         std::size_t data_unit_length =
+                             Default_Data_Unit_Length);
+
+        void EncryptFile(const std::filesystem::path &input,
+                         const std::filesystem::path &output,
+                         std::span<std::uint8_t> tag = {});
+        bool DecryptFile(const std::filesystem::path &input,
+                         const std::filesystem::path &output,
+                         const std::span<const std::uint8_t> tag = {});
+
+        void EncryptFileInPlace(const std::filesystem::path &file,
+                                std::span<std::uint8_t> tag = {});
+        bool DecryptFileInPlace(const std::filesystem::path &file,
+                                const std::span<const std::uint8_t> tag = {});
+
+        void Encrypt(std::istream &input,
+                     std::ostream &output,
+                     std::span<std::uint8_t> tag = {});
+        bool Decrypt(std::istream &input,
+                     std::ostream &output,
+                     const std::span<const std::uint8_t> tag = {});
+
+        const AESStreamStatistics &GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+        AESEngineType GetEngineType() const noexcept;
+
+    protected:
+        void ClearIV() noexcept;
+        void Start(std::size_t tag_length, bool encrypt);
+        void Final(std::span<std::uint8_t> tag);
+        bool Verify(const std::span<const std::uint8_t> tag);
+        void CheckLength(std::uint64_t length) const;
+        void ProcessChunk(const std::uint8_t *input,
+                          std::uint8_t *output,
+                          std::size_t length,
+                          bool encrypt);
+        void ProcessStream(std::istream &input,
+                           std::ostream &output,
+                           bool encrypt);
+        void ProcessFile(const std::filesystem::path &input,
+                         const std::filesystem::path &output,
+                         bool encrypt);
+        void ProcessFileInPlace(const std::filesystem::path &file,
+                                bool encrypt,
+                                bool authenticate_only);
+        void RecordChunk(std::size_t length,
+                         std::chrono::steady_clock::time_point &last);
+
+        AESStreamMode mode;                     // Mode of operation
+        std::size_t chunk_size;                 // Octets per chunk
+
+        AESCTR ctr;                             // CTR mode
+        AESGCM gcm;                             // GCM mode
+        AESXTS xts;                             // XTS mode
+
+        std::vector<std::uint8_t> iv;           // Counter block or IV
+        std::vector<std::uint8_t> aad;          // Additional data for GCM
+        std::uint64_t first_data_unit;          // First XTS data unit
+        std::size_t data_unit_length;           // XTS data unit length
+        std::uint64_t data_unit;                // Next XTS data unit
+
+        std::vector<std::uint8_t> buffers[2];   // Chunk buffers
+
+        AESStreamStatistics statistics;         // Most recent statistics
+};
+
+} // namespace Terra::Crypto::Cipher
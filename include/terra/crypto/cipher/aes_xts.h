@@ -0,0 +1,98 @@
+/*
+ *  aes_xts.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESXTS object that implements the XTS-AES mode
+ *      of operation as specified in IEEE Std 1619 and NIST Special
+ *      Publication 800-38E.  XTS-AES is intended for the encryption of data
+ *      on storage devices, where each sector (or "data unit") is encrypted
+ *      independently using a tweak derived from the sector number.
+ *
+ *      The key is the concatenation of two AES keys of equal length: the
+ *      first half is used to encrypt the data and the second half is used
+ *      to encrypt the tweak.  Thus, the key must be 32 octets (XTS-AES-128)
+ *      or 64 octets (XTS-AES-256) in length.
+ *
+ *      Each call to Encrypt() or Decrypt() processes one complete data unit,
+ *      which must be at least 16 octets in length.  Data units that are not
+ *      an integral number of blocks are handled using ciphertext stealing.
+ *      Note that invalid span or key lengths will cause an exception to be
+ *      thrown.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <array>
+#include "aes.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+class AESXTS
+{
+    public:
+        // Number of blocks processed with each call to the engine
+        static constexpr std::size_t Parallel_Blocks{8};
+
+        // Maximum data unit length (2^20 blocks) per IEEE Std 1619
+        static constexpr std::size_t Max_Data_Unit_Length{16 * (1 << 20)};
+
+        AESXTS();
+        AESXTS(const std::span<const std::uint8_t> key);
+        ~AESXTS();
+
+        void SetKey(const std::span<const std::uint8_t> key);
+
+        void Encrypt(const std::uint64_t sector,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext);
+        void Encrypt(const std::span<const std::uint8_t, 16> tweak,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext);
+
+        void Decrypt(const std::uint64_t sector,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext);
+        void Decrypt(const std::span<const std::uint8_t, 16> tweak,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext);
+
+        AESEngineType GetEngineType() const noexcept
+        {
+            return data_aes.GetEngineType();
+        }
+
+    protected:
+        void InitializeTweak(const std::uint64_t sector);
+        void InitializeTweak(const std::span<const std::uint8_t, 16> tweak);
+        void ComputeTweaks(std::size_t blocks);
+        void ProcessDataUnit(const std::span<const std::uint8_t> input,
+                             std::span<std::uint8_t> output,
+                             bool encrypt);
+        void ProcessBlock(std::size_t tweak_index, bool encrypt);
+
+        AES data_aes;                           // AES for the data
+        AES tweak_aes;                          // AES for the tweak
+
+        std::array<std::uint8_t, 16> tweak;     // Tweak for the next block
+
+        std::array<std::uint8_t, 16 * Parallel_Blocks> tweaks;
+                                                // Tweaks for a group of blocks
+
+        std::array<std::uint8_t, 16> block;     // Block buffer
+};
+
+} // namespace Terra::Crypto::Cipher
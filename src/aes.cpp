@@ -1,7 +1,7 @@
 /*
  *  aes.cpp
  *
- *  Copyright (C) 2024, 2025
+ *  Copyright (C) 2024, 2025, 2026
  *  Terrapane Corporation
  *  All Rights Reserved
  *
@@ -19,17 +19,200 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include <terra/secutil/secure_erase.h>
 #include <terra/crypto/cipher/aes.h>
 #include "aes_tables.h"
 #include "aes_utilities.h"
 #include "aes_universal.h"
 #include "aes_intel.h"
+#include "aes_intel_vaes.h"
+#include "aes_arm.h"
+#include "aes_bitsliced.h"
+#include "aes_vector_permute.h"
 #include "cpu_check.h"
+#include "instrumentation.h"
 
 namespace Terra::Crypto::Cipher
 {
 
+namespace
+{
+
+/*
+ *  EngineFromName()
+ *
+ *  Description:
+ *      Return the engine type having the given name, as accepted in the
+ *      TERRA_AES_ENGINE environment variable.
+ *
+ *  Parameters:
+ *      name [in]
+ *          The name of the engine.
+ *
+ *  Returns:
+ *      The engine type or AESEngineType::Unavailable if the name is not
+ *      recognized.
+ *
+ *  Comments:
+ *      None.
+ */
+AESEngineType EngineFromName(const char *name) noexcept
+{
+    static constexpr struct
+    {
+        const char *name;
+        AESEngineType engine_type;
+    } Engine_Names[] =
+    {
+        {"universal", AESEngineType::Universal},
+        {"intel", AESEngineType::Intel},
+        {"intel_vaes", AESEngineType::IntelVAES},
+        {"arm", AESEngineType::ARM},
+        {"bitsliced", AESEngineType::Bitsliced},
+        {"vector_permute", AESEngineType::VectorPermute}
+    };
+
+    for (const auto &engine_name : Engine_Names)
+    {
+        if (std::strcmp(name, engine_name.name) == 0)
+        {
+            return engine_name.engine_type;
+        }
+    }
+
+    return AESEngineType::Unavailable;
+}
+
+/*
+ *  EngineFromEnvironment()
+ *
+ *  Description:
+ *      Return the engine type named by the TERRA_AES_ENGINE environment
+ *      variable.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The engine type or AESEngineType::Unavailable if the variable is not
+ *      set or does not name an engine.
+ *
+ *  Comments:
+ *      None.
+ */
+AESEngineType EngineFromEnvironment() noexcept
+{
+    AESEngineType engine_type = AESEngineType::Unavailable;
+
+#ifdef _MSC_VER
+    char *value = nullptr;
+    std::size_t length = 0;
+
+    if ((_dupenv_s(&value, &length, AES::Engine_Variable) == 0) && value)
+    {
+        engine_type = EngineFromName(value);
+    }
+
+    std::free(value);
+#else
+    const char *value = std::getenv(AES::Engine_Variable);
+
+    if (value != nullptr) engine_type = EngineFromName(value);
+#endif
+
+    return engine_type;
+}
+
+/*
+ *  PreferredEngine()
+ *
+ *  Description:
+ *      Return the engine type preferred by this process, which is initialized
+ *      from the environment on first use.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the preferred engine type.
+ *
+ *  Comments:
+ *      None.
+ */
+std::atomic<AESEngineType> &PreferredEngine() noexcept
+{
+    static std::atomic<AESEngineType> preferred_engine{
+        EngineFromEnvironment()};
+
+    return preferred_engine;
+}
+
+/*
+ *  MakeEngine()
+ *
+ *  Description:
+ *      Create the specified AES engine if it can be used on this processor.
+ *
+ *  Parameters:
+ *      engine_type [in]
+ *          The AES engine to create.
+ *
+ *  Returns:
+ *      The AES engine or nullptr if that engine is not available.
+ *
+ *  Comments:
+ *      None.
+ */
+std::unique_ptr<AESEngine> MakeEngine(AESEngineType engine_type)
+{
+    std::unique_ptr<AESEngine> aes_engine;
+
+    switch (engine_type)
+    {
+        case AESEngineType::Universal:
+            aes_engine = std::make_unique<AESUniversal>();
+            break;
+
+        case AESEngineType::Intel:
+            aes_engine = std::make_unique<AESIntel>();
+            break;
+
+        case AESEngineType::IntelVAES:
+            aes_engine = std::make_unique<AESIntelVAES>();
+            break;
+
+        case AESEngineType::ARM:
+            aes_engine = std::make_unique<AESARM>();
+            break;
+
+        case AESEngineType::Bitsliced:
+            aes_engine = std::make_unique<AESBitsliced>();
+            break;
+
+        case AESEngineType::VectorPermute:
+            aes_engine = std::make_unique<AESVectorPermute>();
+            break;
+
+        default:
+            break;
+    }
+
+    // Discard the engine if it cannot be used
+    if (aes_engine &&
+        (aes_engine->GetEngineType() == AESEngineType::Unavailable))
+    {
+        aes_engine.reset();
+    }
+
+    return aes_engine;
+}
+
+} // namespace
+
 /*
  *  AES::AES()
  *
@@ -46,7 +229,7 @@ namespace Terra::Crypto::Cipher
  *  Comments:
  *      None.
  */
-AES::AES()
+AES::AES() : key_usage{AESKeyUsage::EncryptDecrypt}
 {
     // Create the AES engine
     CreateEngine();
@@ -73,7 +256,67 @@ AES::AES()
  */
 AES::AES(const std::span<const std::uint8_t> key) : AES()
 {
-    aes_engine->SetKey(key);
+    SetKey(key);
+}
+
+/*
+ *  AES::AES()
+ *
+ *  Description:
+ *      This is a constructor for the AES object with no given key that
+ *      will use the specified AES engine, if available.
+ *
+ *  Parameters:
+ *      engine_type [in]
+ *          The AES engine to use.  If that engine cannot be used on this
+ *          processor or was not built, the engine that would otherwise be
+ *          selected is used.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The bitsliced engine is only used when requested, since it is most
+ *      effective when data is processed via EncryptBlocks() and
+ *      DecryptBlocks().
+ */
+AES::AES(AESEngineType engine_type) :
+    key_usage{AESKeyUsage::EncryptDecrypt}
+{
+    // Create the requested AES engine
+    CreateEngine(engine_type);
+}
+
+/*
+ *  AES::AES()
+ *
+ *  Description:
+ *      This is a constructor for the AES object that accepts a span of octets
+ *      as input that contains the key and will use the specified AES engine,
+ *      if available.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *      engine_type [in]
+ *          The AES engine to use.  If that engine cannot be used on this
+ *          processor or was not built, the engine that would otherwise be
+ *          selected is used.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *      This corresponds to 128, 192, and 256 bits.
+ *
+ *  Comments:
+ *      None.
+ */
+AES::AES(const std::span<const std::uint8_t> key,
+         AESEngineType engine_type) :
+    AES(engine_type)
+{
+    SetKey(key);
 }
 
 /*
@@ -93,7 +336,7 @@ AES::AES(const std::span<const std::uint8_t> key) : AES()
  *  Comments:
  *      None.
  */
-AES::AES(const AES &other)
+AES::AES(const AES &other) : key_usage{other.key_usage}
 {
     // Create an engine like that of the other object
     switch (other.aes_engine->GetEngineType())
@@ -114,6 +357,38 @@ AES::AES(const AES &other)
             }
             break;
 
+        case AESEngineType::IntelVAES:
+            {
+                AESIntelVAES *other_engine =
+                    dynamic_cast<AESIntelVAES *>(other.aes_engine.get());
+                aes_engine = std::make_unique<AESIntelVAES>(*other_engine);
+            }
+            break;
+
+        case AESEngineType::ARM:
+            {
+                AESARM *other_engine =
+                    dynamic_cast<AESARM *>(other.aes_engine.get());
+                aes_engine = std::make_unique<AESARM>(*other_engine);
+            }
+            break;
+
+        case AESEngineType::Bitsliced:
+            {
+                AESBitsliced *other_engine =
+                    dynamic_cast<AESBitsliced *>(other.aes_engine.get());
+                aes_engine = std::make_unique<AESBitsliced>(*other_engine);
+            }
+            break;
+
+        case AESEngineType::VectorPermute:
+            {
+                AESVectorPermute *other_engine =
+                    dynamic_cast<AESVectorPermute *>(other.aes_engine.get());
+                aes_engine = std::make_unique<AESVectorPermute>(*other_engine);
+            }
+            break;
+
         default:
             // Should only happen if there was an allocation failure previously
             throw AESException("Failed to determine AES engine type");
@@ -145,30 +420,49 @@ AES::AES(AES &&other) noexcept : AES()
 
     // Swap the engine in this object with other
     std::swap(aes_engine, other.aes_engine);
+    std::swap(key_usage, other.key_usage);
 }
 
 /*
- *  AES::SetKey()
+ *  AES::CreateEngine()
  *
  *  Description:
- *      This function will set the key to be used for subsequent calls to
- *      Encrypt() or Decrypt().
+ *      Create the engine preferred by this process or, if there is none or
+ *      it cannot be used, the best AES engine available on this processor.
  *
  *  Parameters:
- *      key [in]
- *          The encryption key to use with this instance of the object.
+ *      None.
  *
  *  Returns:
- *      Nothing, though an exception will be thrown if the key provided is not
- *      one of 16, 24, or 32 octets in length as required by the standard.
+ *      Nothing.
  *
  *  Comments:
- *      None.
+ *      The processor features are probed only once per process, so this
+ *      does not execute cpuid (or query the operating system) each time.
  */
 void AES::CreateEngine()
 {
+    const CPUFeatures &features = GetCPUFeatures();
+
+    // Use the engine preferred by this process, if one is usable
+    aes_engine = MakeEngine(GetPreferredEngine());
+    if (aes_engine) return;
+
+    // If the processor supports VAES instructions, try the Intel VAES engine
+    if (features.aes_ni && features.vaes)
+    {
+        // Use the AES engine that uses VAES instructions
+        aes_engine = std::make_unique<AESIntelVAES>();
+
+        // Reset the pointer if VAES cannot be used
+        if (aes_engine->GetEngineType() == AESEngineType::Unavailable)
+        {
+            aes_engine.reset();
+        }
+    }
+
     // If the processor support AES-NI instructions, try the Intel engine
-    if (CPUSupportsAES_NI())
+    if (!aes_engine && features.aes_ni)
     {
         // Use the AES engine that uses AES-NI instructions
         aes_engine = std::make_unique<AESIntel>();
@@ -180,6 +474,33 @@ void AES::CreateEngine()
         }
     }
 
+    // If the processor supports the ARMv8 AES instructions, try the ARM engine
+    if (!aes_engine && features.arm_aes)
+    {
+        // Use the AES engine that uses ARMv8 AES instructions
+        aes_engine = std::make_unique<AESARM>();
+
+        // Reset the pointer if the ARM AES instructions cannot be used
+        if (aes_engine->GetEngineType() == AESEngineType::Unavailable)
+        {
+            aes_engine.reset();
+        }
+    }
+
+    // If the processor has vector permute instructions, but no AES
+    // instructions, try the vector permute engine
+    if (!aes_engine)
+    {
+        // Use the AES engine that uses SSSE3 or NEON permute instructions
+        aes_engine = std::make_unique<AESVectorPermute>();
+
+        // Reset the pointer if the vector permute engine cannot be used
+        if (aes_engine->GetEngineType() == AESEngineType::Unavailable)
+        {
+            aes_engine.reset();
+        }
+    }
+
     // If no other engine is available, use the universal engine
     if (!aes_engine)
     {
@@ -188,6 +509,99 @@ void AES::CreateEngine()
     }
 }
 
+/*
+ *  AES::CreateEngine()
+ *
+ *  Description:
+ *      Create the specified AES engine.  If that engine is not available,
+ *      the engine is selected as it would be otherwise.
+ *
+ *  Parameters:
+ *      engine_type [in]
+ *          The AES engine to create.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AES::CreateEngine(AESEngineType engine_type)
+{
+    aes_engine = MakeEngine(engine_type);
+
+    // Fall back to the usual selection if the engine cannot be used
+    if (!aes_engine) CreateEngine();
+}
+
+/*
+ *  AES::SetPreferredEngine()
+ *
+ *  Description:
+ *      Set the AES engine to be used by AES objects subsequently created
+ *      without specifying an engine type, overriding the TERRA_AES_ENGINE
+ *      environment variable.
+ *
+ *  Parameters:
+ *      engine_type [in]
+ *          The preferred AES engine.  If AESEngineType::Unavailable, the
+ *          fastest available engine is selected.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Existing objects retain their engines.  AESInline (and therefore
+ *      AESKeySchedule) also honors this preference for the engines it is
+ *      able to hold.
+ */
+void AES::SetPreferredEngine(AESEngineType engine_type) noexcept
+{
+    PreferredEngine().store(engine_type, std::memory_order_relaxed);
+}
+
+/*
+ *  AES::GetPreferredEngine()
+ *
+ *  Description:
+ *      Return the AES engine preferred by this process, as set via
+ *      SetPreferredEngine() or the TERRA_AES_ENGINE environment variable.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The preferred AES engine or AESEngineType::Unavailable if there is
+ *      no preference.
+ *
+ *  Comments:
+ *      The environment variable is read only once per process.
+ */
+AESEngineType AES::GetPreferredEngine() noexcept
+{
+    return PreferredEngine().load(std::memory_order_relaxed);
+}
+
+/*
+ *  AES::GetEngineType()
+ *
+ *  Description:
+ *      Return the type of AES engine used by this object.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The AES engine type.
+ *
+ *  Comments:
+ *      None.
+ */
+AESEngineType AES::GetEngineType() const noexcept
+{
+    return aes_engine->GetEngineType();
+}
+
 /*
  *  AES::SetKey()
  *
@@ -199,6 +613,13 @@ void AES::CreateEngine()
  *      key [in]
  *          The encryption key to use with this instance of the object.
  *
+ *      key_usage [in]
+ *          Indicates whether the key will be used for both encryption and
+ *          decryption or only for encryption.  If AESKeyUsage::EncryptOnly,
+ *          the decryption key schedule is not computed, DecryptBlocks()
+ *          will throw an exception, and Decrypt() must not be called until
+ *          the key is set again.
+ *
  *  Returns:
  *      Nothing, though an exception will be thrown if the key provided is not
  *      one of 16, 24, or 32 octets in length as required by the standard.
@@ -206,9 +627,13 @@ void AES::CreateEngine()
  *  Comments:
  *      None.
  */
-void AES::SetKey(const std::span<const std::uint8_t> key)
+void AES::SetKey(const std::span<const std::uint8_t> key,
+                 AESKeyUsage key_usage)
 {
-    aes_engine->SetKey(key);
+    aes_engine->SetKey(key, key_usage);
+    this->key_usage = key_usage;
+
+    RecordAESEvent(*this, AESCounter::KeySetups);
 }
 
 /*
@@ -234,9 +659,11 @@ void AES::SetKey(const std::span<const std::uint8_t> key)
  *      None.
  */
 void AES::Encrypt(const std::span<const std::uint8_t, 16> plaintext,
-                  std::span<std::uint8_t, 16> ciphertext) noexcept
+                  std::span<std::uint8_t, 16> ciphertext) const noexcept
 {
     aes_engine->Encrypt(plaintext, ciphertext);
+
+    RecordAESEvent(*this, AESCounter::BlocksEncrypted);
 }
 
 /*
@@ -262,9 +689,106 @@ void AES::Encrypt(const std::span<const std::uint8_t, 16> plaintext,
  *      None.
  */
 void AES::Decrypt(const std::span<const std::uint8_t, 16> ciphertext,
-                  std::span<std::uint8_t, 16> plaintext) noexcept
+                  std::span<std::uint8_t, 16> plaintext) const noexcept
 {
+    // The decryption key schedule must have been computed
+    assert(key_usage == AESKeyUsage::EncryptDecrypt);
+
     aes_engine->Decrypt(ciphertext, plaintext);
+
+    RecordAESEvent(*this, AESCounter::BlocksDecrypted);
+}
+
+/*
+ *  AES::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a contiguous series of plaintext blocks
+ *      and return the ciphertext (i.e., ECB mode).  Since each block is
+ *      independent, the underlying engine is free to process several blocks
+ *      in parallel.
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The data to encrypt.  The length must be an integral number of
+ *          16-octet blocks.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span.  AES operates in place, so this span may be the
+ *          same memory location as the plaintext span, though the spans
+ *          must not otherwise overlap.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.  An exception will be thrown if the span lengths
+ *      are invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+void AES::EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                        std::span<std::uint8_t> ciphertext) const
+{
+    // Ensure the spans are of equal length and are whole blocks
+    if ((plaintext.size() != ciphertext.size()) ||
+        ((plaintext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    aes_engine->EncryptBlocks(plaintext, ciphertext);
+
+    RecordAESEvent(*this, AESCounter::BlocksEncrypted, plaintext.size() / 16);
+}
+
+/*
+ *  AES::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a contiguous series of ciphertext blocks
+ *      and return the plaintext (i.e., ECB mode).  Since each block is
+ *      independent, the underlying engine is free to process several blocks
+ *      in parallel.
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The data to decrypt.  The length must be an integral number of
+ *          16-octet blocks.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span.  AES operates in place, so this span may be
+ *          the same memory location as the ciphertext span, though the spans
+ *          must not otherwise overlap.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.  An exception will be thrown if the span lengths
+ *      are invalid or if the key was set for encryption only.
+ *
+ *  Comments:
+ *      None.
+ */
+void AES::DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                        std::span<std::uint8_t> plaintext) const
+{
+    // Ensure the spans are of equal length and are whole blocks
+    if ((ciphertext.size() != plaintext.size()) ||
+        ((ciphertext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    // The decryption key schedule must have been computed
+    if (key_usage == AESKeyUsage::EncryptOnly)
+    {
+        throw AESException("The key was set for encryption only");
+    }
+
+    aes_engine->DecryptBlocks(ciphertext, plaintext);
+
+    RecordAESEvent(*this, AESCounter::BlocksDecrypted, ciphertext.size() / 16);
 }
 
 /*
@@ -316,6 +840,46 @@ bool AES::operator==(const AES &other) const
             }
             break;
 
+        case AESEngineType::IntelVAES:
+            {
+                AESIntelVAES *this_engine =
+                    dynamic_cast<AESIntelVAES *>(aes_engine.get());
+                AESIntelVAES *other_engine =
+                    dynamic_cast<AESIntelVAES *>(other.aes_engine.get());
+                result = (*this_engine == *other_engine);
+            }
+            break;
+
+        case AESEngineType::ARM:
+            {
+                AESARM *this_engine =
+                    dynamic_cast<AESARM *>(aes_engine.get());
+                AESARM *other_engine =
+                    dynamic_cast<AESARM *>(other.aes_engine.get());
+                result = (*this_engine == *other_engine);
+            }
+            break;
+
+        case AESEngineType::Bitsliced:
+            {
+                AESBitsliced *this_engine =
+                    dynamic_cast<AESBitsliced *>(aes_engine.get());
+                AESBitsliced *other_engine =
+                    dynamic_cast<AESBitsliced *>(other.aes_engine.get());
+                result = (*this_engine == *other_engine);
+            }
+            break;
+
+        case AESEngineType::VectorPermute:
+            {
+                AESVectorPermute *this_engine =
+                    dynamic_cast<AESVectorPermute *>(aes_engine.get());
+                AESVectorPermute *other_engine =
+                    dynamic_cast<AESVectorPermute *>(other.aes_engine.get());
+                result = (*this_engine == *other_engine);
+            }
+            break;
+
         default:
             throw AESException("Failed to determine AES engine type");
             break;
@@ -384,11 +948,45 @@ AES &AES::operator=(const AES &other)
             }
             break;
 
+        case AESEngineType::IntelVAES:
+            {
+                AESIntelVAES *other_engine =
+                    dynamic_cast<AESIntelVAES *>(other.aes_engine.get());
+                aes_engine = std::make_unique<AESIntelVAES>(*other_engine);
+            }
+            break;
+
+        case AESEngineType::ARM:
+            {
+                AESARM *other_engine =
+                    dynamic_cast<AESARM *>(other.aes_engine.get());
+                aes_engine = std::make_unique<AESARM>(*other_engine);
+            }
+            break;
+
+        case AESEngineType::Bitsliced:
+            {
+                AESBitsliced *other_engine =
+                    dynamic_cast<AESBitsliced *>(other.aes_engine.get());
+                aes_engine = std::make_unique<AESBitsliced>(*other_engine);
+            }
+            break;
+
+        case AESEngineType::VectorPermute:
+            {
+                AESVectorPermute *other_engine =
+                    dynamic_cast<AESVectorPermute *>(other.aes_engine.get());
+                aes_engine = std::make_unique<AESVectorPermute>(*other_engine);
+            }
+            break;
+
         default:
             throw AESException("Failed to determine AES engine type");
             break;
     }
 
+    key_usage = other.key_usage;
+
     return *this;
 }
 
@@ -418,6 +1016,7 @@ AES &AES::operator=(AES &&other) noexcept
 
     // Swap the aes_engine values
     std::swap(aes_engine, other.aes_engine);
+    std::swap(key_usage, other.key_usage);
 
     return *this;
 }
@@ -0,0 +1,863 @@
+/*
+ *  aes_arm.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AESARM object which performs encryption and
+ *      decryption as specified in FIPS 197 ("Advanced Encryption Standard")
+ *      using the AES instructions of the ARMv8 Cryptography Extension.
+ *
+ *      The ARM instructions divide an AES round differently than AES-NI.
+ *      The aese instruction performs AddRoundKey, SubBytes, and ShiftRows
+ *      (in that order) and aesmc performs MixColumns.  Thus, a round key is
+ *      applied at the start of each aese, and the final round key is applied
+ *      with an exclusive-or operation.  Decryption is similar using aesd and
+ *      aesimc with the Equivalent Inverse Cipher key schedule.
+ *
+ *  Portability Issues:
+ *      The ARMv8 Cryptography Extension must be enabled when compiling this
+ *      file (e.g., -march=armv8-a+crypto), which the CMake file does.
+ */
+
+#include "arm_intrinsics.h"
+
+// Do not attempt to compile unless told to use ARM intrinsics
+#ifdef TERRA_USE_ARM_INTRINSICS
+
+#include <cstring>
+#include <array>
+#include <terra/secutil/secure_erase.h>
+#include "aes_arm.h"
+#include "aes_tables.h"
+#include "aes_utilities.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+/*
+ * AESARM::AESARM()
+ *
+ *  Description:
+ *      This is a constructor for the AESARM object with no given key.
+ *      It will initialize internal structures to zero.  Since a key is not
+ *      provided to this version of the constructor, one must call
+ *      SetKey() with a valid key before calling Encrypt() or Decrypt(),
+ *      as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESARM::AESARM() noexcept :
+    AESEngine(),
+    Nr{},
+    W{},
+    DW{}
+{
+    // Nothing to do
+}
+
+/*
+ * AESARM::AESARM()
+ *
+ *  Description:
+ *      This is a constructor for the AESARM object that accepts a span
+ *      of octets as input that contains the key.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *      This corresponds to 128, 192, and 256 bits.
+ *
+ *  Comments:
+ *      None.
+ */
+AESARM::AESARM(const std::span<const std::uint8_t> key) : AESARM()
+{
+    // Only set the key if the ARM AES instructions are supported
+    if (GetEngineType() == AESEngineType::ARM) SetKey(key);
+}
+
+/*
+ * AESARM::AESARM()
+ *
+ *  Description:
+ *      This is a copy constructor for the AESARM object that accepts a
+ *      reference to another AESARM object as a parameter.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESARM object from which to copy values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESARM::AESARM(const AESARM &other) noexcept : AESARM()
+{
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+    std::memcpy(DW, other.DW, sizeof(DW));
+}
+
+/*
+ * AESARM::AESARM()
+ *
+ *  Description:
+ *      This is a move constructor for the AESARM object that accepts a
+ *      reference to another AESARM object as a parameter.  Note that
+ *      this move operation actually just performs a copy of data, since there
+ *      is no dynamic data to really move.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESARM object from which to move values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function just copies the other AESARM object's values since
+ *      there is no internal data that can be moved.
+ */
+AESARM::AESARM(AESARM &&other) noexcept : AESARM()
+{
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+    std::memcpy(DW, other.DW, sizeof(DW));
+}
+
+/*
+ * AESARM::~AESARM()
+ *
+ *  Description:
+ *      This is the destructor for the AESARM object and is responsible
+ *      for zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESARM::~AESARM()
+{
+    SecUtil::SecureErase(&Nr, sizeof(Nr));
+    SecUtil::SecureErase(W, sizeof(W));
+    SecUtil::SecureErase(DW, sizeof(DW));
+}
+
+/*
+ * AESARM::operator=()
+ *
+ *  Description:
+ *      Assign one AESARM object to another.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESARM from which to copy data.
+ *
+ *  Returns:
+ *      A reference to this AESARM object.
+ *
+ *  Comments:
+ *      None.
+ */
+AESARM &AESARM::operator=(const AESARM &other)
+{
+    // If this is the same object, just return this
+    if (this == &other) return *this;
+
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+    std::memcpy(DW, other.DW, sizeof(DW));
+
+    return *this;
+}
+
+/*
+ * AESARM::operator=()
+ *
+ *  Description:
+ *      Move assignment operator to assign another AESARM object to this
+ *      one.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESARM from which to move data.
+ *
+ *  Returns:
+ *      A reference to this AESARM object.
+ *
+ *  Comments:
+ *      None.
+ */
+AESARM &AESARM::operator=(AESARM &&other) noexcept
+{
+    // If this is the same object, just return this
+    if (this == &other) return *this;
+
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+    std::memcpy(DW, other.DW, sizeof(DW));
+
+    return *this;
+}
+
+/*
+ * AESARM::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent calls to
+ *      Encrypt() or Decrypt().
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *      key_usage [in]
+ *          Indicates whether the key will be used for both encryption and
+ *          decryption or only for encryption.  If AESKeyUsage::EncryptOnly,
+ *          the decryption key schedule is not computed and Decrypt() and
+ *          DecryptBlocks() must not be called until the key is set again.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *
+ *  Comments:
+ *      The ARMv8 Cryptography Extension has no key expansion instruction,
+ *      so the key schedule is computed as words per FIPS 197 Section 5.2
+ *      and then loaded into vector registers.  The decryption key schedule
+ *      is in the form required by the Equivalent Inverse Cipher (FIPS 197
+ *      Section 5.3.5), with aesimc applied to the inner round keys.
+ */
+void AESARM::SetKey(const std::span<const std::uint8_t> key,
+                    AESKeyUsage key_usage)
+{
+    std::uint32_t words[Nb * (Max_Rounds + 1)];
+    std::uint8_t round_key[AES_Block_Size];
+    std::size_t Nk;
+
+    // Zero the key schedule
+    SecUtil::SecureErase(W, sizeof(W));
+    SecUtil::SecureErase(DW, sizeof(DW));
+
+    // Determine the number of rounds given the key length
+    switch (key.size())
+    {
+        case 16:
+            Nr = 10;
+            Nk = 4;
+            break;
+
+        case 24:
+            Nr = 12;
+            Nk = 6;
+            break;
+
+        case 32:
+            Nr = 14;
+            Nk = 8;
+            break;
+
+        default:
+            throw AESException("Invalid key length provided");
+    }
+
+    // Fill the first Nk words in the round key array
+    for (std::size_t i = 0; i < Nk; i++)
+    {
+        words[i] = GetWordFromBuffer<std::uint32_t>(key, i);
+    }
+
+    // Fill the remaining words in the round key array
+    for (std::size_t i = Nk; i < Nb * (Nr + 1); i++)
+    {
+        std::uint32_t temp = words[i - 1];
+
+        if ((i % Nk) == 0)
+        {
+            temp = SubBytes(RotWord(temp)) ^ Rcon[(i / Nk) - 1];
+        }
+        else if ((Nk > 6) && ((i % Nk) == 4))
+        {
+            temp = SubBytes(temp);
+        }
+
+        words[i] = words[i - Nk] ^ temp;
+    }
+
+    // Load the round keys into vector registers in FIPS 197 octet order
+    for (std::size_t i = 0; i <= Nr; i++)
+    {
+        for (std::size_t j = 0; j < Nb; j++)
+        {
+            const std::uint32_t word = words[(i * Nb) + j];
+
+            round_key[(j << 2)    ] = static_cast<std::uint8_t>(word >> 24);
+            round_key[(j << 2) + 1] = static_cast<std::uint8_t>(word >> 16);
+            round_key[(j << 2) + 2] = static_cast<std::uint8_t>(word >>  8);
+            round_key[(j << 2) + 3] = static_cast<std::uint8_t>(word      );
+        }
+
+        W[i] = vld1q_u8(round_key);
+    }
+
+    // Create the decryption round keys, unless only encrypting
+    if (key_usage == AESKeyUsage::EncryptDecrypt)
+    {
+        DW[0] = W[Nr];
+        for (std::size_t i = 1; i < Nr; i++) DW[i] = vaesimcq_u8(W[Nr - i]);
+        DW[Nr] = W[0];
+    }
+
+    // Erase the temporary key material
+    SecUtil::SecureErase(words, sizeof(words));
+    SecUtil::SecureErase(round_key, sizeof(round_key));
+}
+
+/*
+ * AESARM::ClearKeyState()
+ *
+ *  Description:
+ *      Clear the key and all state data.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESARM::ClearKeyState()
+{
+    SecUtil::SecureErase(&Nr, sizeof(Nr));
+    SecUtil::SecureErase(W, sizeof(W));
+    SecUtil::SecureErase(DW, sizeof(DW));
+}
+
+/*
+ * AESARM::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt a block of plaintext and return the
+ *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The 16-octet data block to encrypt.
+ *
+ *      ciphertext [out]
+ *          The 16-octet encrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the plaintext span.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESARM::Encrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> plaintext,
+            std::span<std::uint8_t, AES_Block_Size> ciphertext) const noexcept
+{
+    uint8x16_t B = vld1q_u8(plaintext.data());
+
+    // Rounds 1 to Nr - 1 (aese applies the previous round key)
+    B = vaesmcq_u8(vaeseq_u8(B, W[0]));
+    B = vaesmcq_u8(vaeseq_u8(B, W[1]));
+    B = vaesmcq_u8(vaeseq_u8(B, W[2]));
+    B = vaesmcq_u8(vaeseq_u8(B, W[3]));
+    B = vaesmcq_u8(vaeseq_u8(B, W[4]));
+    B = vaesmcq_u8(vaeseq_u8(B, W[5]));
+    B = vaesmcq_u8(vaeseq_u8(B, W[6]));
+    B = vaesmcq_u8(vaeseq_u8(B, W[7]));
+    B = vaesmcq_u8(vaeseq_u8(B, W[8]));
+
+    // If Nr > 10 implies either AES-192 or AES-256
+    if (Nr > 10)
+    {
+        B = vaesmcq_u8(vaeseq_u8(B, W[9]));
+        B = vaesmcq_u8(vaeseq_u8(B, W[10]));
+
+        // Nr > 12 implies AES-256
+        if (Nr > 12)
+        {
+            B = vaesmcq_u8(vaeseq_u8(B, W[11]));
+            B = vaesmcq_u8(vaeseq_u8(B, W[12]));
+        }
+    }
+
+    // Final round (no MixColumns) and the last AddRoundKey
+    B = veorq_u8(vaeseq_u8(B, W[Nr - 1]), W[Nr]);
+
+    // Store the result in the ciphertext buffer
+    vst1q_u8(ciphertext.data(), B);
+}
+
+/*
+ * AESARM::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt a block of ciphertext and return the
+ *      plaintext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The 16-octet data block to decrypt.
+ *
+ *      plaintext [out]
+ *          The 16-octet decrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the ciphertext span.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESARM::Decrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> ciphertext,
+            std::span<std::uint8_t, AES_Block_Size> plaintext) const noexcept
+{
+    uint8x16_t B = vld1q_u8(ciphertext.data());
+
+    // Rounds 1 to Nr - 1 (aesd applies the previous round key)
+    B = vaesimcq_u8(vaesdq_u8(B, DW[0]));
+    B = vaesimcq_u8(vaesdq_u8(B, DW[1]));
+    B = vaesimcq_u8(vaesdq_u8(B, DW[2]));
+    B = vaesimcq_u8(vaesdq_u8(B, DW[3]));
+    B = vaesimcq_u8(vaesdq_u8(B, DW[4]));
+    B = vaesimcq_u8(vaesdq_u8(B, DW[5]));
+    B = vaesimcq_u8(vaesdq_u8(B, DW[6]));
+    B = vaesimcq_u8(vaesdq_u8(B, DW[7]));
+    B = vaesimcq_u8(vaesdq_u8(B, DW[8]));
+
+    // If Nr > 10 implies either AES-192 or AES-256
+    if (Nr > 10)
+    {
+        B = vaesimcq_u8(vaesdq_u8(B, DW[9]));
+        B = vaesimcq_u8(vaesdq_u8(B, DW[10]));
+
+        // Nr > 12 implies AES-256
+        if (Nr > 12)
+        {
+            B = vaesimcq_u8(vaesdq_u8(B, DW[11]));
+            B = vaesimcq_u8(vaesdq_u8(B, DW[12]));
+        }
+    }
+
+    // Final round (no InvMixColumns) and the last AddRoundKey
+    B = veorq_u8(vaesdq_u8(B, DW[Nr - 1]), DW[Nr]);
+
+    // Store the result in the plaintext buffer
+    vst1q_u8(plaintext.data(), B);
+}
+
+/*
+ * AESARM::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a series of plaintext blocks and return the
+ *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The data to encrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      As with AES-NI, the aese/aesmc instructions have a latency of several
+ *      cycles but may be issued every cycle, so this function interleaves
+ *      the rounds of eight independent blocks (then four, then one for any
+ *      remaining blocks).  Each aese is immediately followed by the aesmc
+ *      consuming its result, as many ARM cores fuse that pair of
+ *      instructions.
+ */
+void AESARM::EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const noexcept
+{
+    const std::uint8_t *p = plaintext.data();
+    std::uint8_t *c = ciphertext.data();
+    std::size_t blocks = plaintext.size() / AES_Block_Size;
+    uint8x16_t B0, B1, B2, B3, B4, B5, B6, B7;
+
+    // Encrypt eight blocks at a time
+    {
+        auto Round = [&](const uint8x16_t &key)
+        {
+            B0 = vaesmcq_u8(vaeseq_u8(B0, key));
+            B1 = vaesmcq_u8(vaeseq_u8(B1, key));
+            B2 = vaesmcq_u8(vaeseq_u8(B2, key));
+            B3 = vaesmcq_u8(vaeseq_u8(B3, key));
+            B4 = vaesmcq_u8(vaeseq_u8(B4, key));
+            B5 = vaesmcq_u8(vaeseq_u8(B5, key));
+            B6 = vaesmcq_u8(vaeseq_u8(B6, key));
+            B7 = vaesmcq_u8(vaeseq_u8(B7, key));
+        };
+
+        for (; blocks >= 8; blocks -= 8, p += 128, c += 128)
+        {
+            B0 = vld1q_u8(p);
+            B1 = vld1q_u8(p + 16);
+            B2 = vld1q_u8(p + 32);
+            B3 = vld1q_u8(p + 48);
+            B4 = vld1q_u8(p + 64);
+            B5 = vld1q_u8(p + 80);
+            B6 = vld1q_u8(p + 96);
+            B7 = vld1q_u8(p + 112);
+
+            // Rounds 1 to Nr - 1
+            Round(W[0]);
+            Round(W[1]);
+            Round(W[2]);
+            Round(W[3]);
+            Round(W[4]);
+            Round(W[5]);
+            Round(W[6]);
+            Round(W[7]);
+            Round(W[8]);
+
+            // If Nr > 10 implies either AES-192 or AES-256
+            if (Nr > 10)
+            {
+                Round(W[9]);
+                Round(W[10]);
+
+                // Nr > 12 implies AES-256
+                if (Nr > 12)
+                {
+                    Round(W[11]);
+                    Round(W[12]);
+                }
+            }
+
+            // Final round, storing the results
+            vst1q_u8(c,       veorq_u8(vaeseq_u8(B0, W[Nr - 1]), W[Nr]));
+            vst1q_u8(c + 16,  veorq_u8(vaeseq_u8(B1, W[Nr - 1]), W[Nr]));
+            vst1q_u8(c + 32,  veorq_u8(vaeseq_u8(B2, W[Nr - 1]), W[Nr]));
+            vst1q_u8(c + 48,  veorq_u8(vaeseq_u8(B3, W[Nr - 1]), W[Nr]));
+            vst1q_u8(c + 64,  veorq_u8(vaeseq_u8(B4, W[Nr - 1]), W[Nr]));
+            vst1q_u8(c + 80,  veorq_u8(vaeseq_u8(B5, W[Nr - 1]), W[Nr]));
+            vst1q_u8(c + 96,  veorq_u8(vaeseq_u8(B6, W[Nr - 1]), W[Nr]));
+            vst1q_u8(c + 112, veorq_u8(vaeseq_u8(B7, W[Nr - 1]), W[Nr]));
+        }
+    }
+
+    // Encrypt four blocks if at least that many remain
+    if (blocks >= 4)
+    {
+        auto Round = [&](const uint8x16_t &key)
+        {
+            B0 = vaesmcq_u8(vaeseq_u8(B0, key));
+            B1 = vaesmcq_u8(vaeseq_u8(B1, key));
+            B2 = vaesmcq_u8(vaeseq_u8(B2, key));
+            B3 = vaesmcq_u8(vaeseq_u8(B3, key));
+        };
+
+        B0 = vld1q_u8(p);
+        B1 = vld1q_u8(p + 16);
+        B2 = vld1q_u8(p + 32);
+        B3 = vld1q_u8(p + 48);
+
+        // Rounds 1 to Nr - 1
+        Round(W[0]);
+        Round(W[1]);
+        Round(W[2]);
+        Round(W[3]);
+        Round(W[4]);
+        Round(W[5]);
+        Round(W[6]);
+        Round(W[7]);
+        Round(W[8]);
+
+        // If Nr > 10 implies either AES-192 or AES-256
+        if (Nr > 10)
+        {
+            Round(W[9]);
+            Round(W[10]);
+
+            // Nr > 12 implies AES-256
+            if (Nr > 12)
+            {
+                Round(W[11]);
+                Round(W[12]);
+            }
+        }
+
+        // Final round, storing the results
+        vst1q_u8(c,      veorq_u8(vaeseq_u8(B0, W[Nr - 1]), W[Nr]));
+        vst1q_u8(c + 16, veorq_u8(vaeseq_u8(B1, W[Nr - 1]), W[Nr]));
+        vst1q_u8(c + 32, veorq_u8(vaeseq_u8(B2, W[Nr - 1]), W[Nr]));
+        vst1q_u8(c + 48, veorq_u8(vaeseq_u8(B3, W[Nr - 1]), W[Nr]));
+
+        blocks -= 4;
+        p += 64;
+        c += 64;
+    }
+
+    // Encrypt any remaining blocks individually
+    for (; blocks > 0; blocks--, p += 16, c += 16)
+    {
+        AESARM::Encrypt(std::span<const std::uint8_t, AES_Block_Size>(p, 16),
+                        std::span<std::uint8_t, AES_Block_Size>(c, 16));
+    }
+}
+
+/*
+ * AESARM::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a series of ciphertext blocks and return the
+ *      plaintext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The data to decrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      See the comments for EncryptBlocks().
+ */
+void AESARM::DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const noexcept
+{
+    const std::uint8_t *c = ciphertext.data();
+    std::uint8_t *p = plaintext.data();
+    std::size_t blocks = ciphertext.size() / AES_Block_Size;
+    uint8x16_t B0, B1, B2, B3, B4, B5, B6, B7;
+
+    // Decrypt eight blocks at a time
+    {
+        auto Round = [&](const uint8x16_t &key)
+        {
+            B0 = vaesimcq_u8(vaesdq_u8(B0, key));
+            B1 = vaesimcq_u8(vaesdq_u8(B1, key));
+            B2 = vaesimcq_u8(vaesdq_u8(B2, key));
+            B3 = vaesimcq_u8(vaesdq_u8(B3, key));
+            B4 = vaesimcq_u8(vaesdq_u8(B4, key));
+            B5 = vaesimcq_u8(vaesdq_u8(B5, key));
+            B6 = vaesimcq_u8(vaesdq_u8(B6, key));
+            B7 = vaesimcq_u8(vaesdq_u8(B7, key));
+        };
+
+        for (; blocks >= 8; blocks -= 8, c += 128, p += 128)
+        {
+            B0 = vld1q_u8(c);
+            B1 = vld1q_u8(c + 16);
+            B2 = vld1q_u8(c + 32);
+            B3 = vld1q_u8(c + 48);
+            B4 = vld1q_u8(c + 64);
+            B5 = vld1q_u8(c + 80);
+            B6 = vld1q_u8(c + 96);
+            B7 = vld1q_u8(c + 112);
+
+            // Rounds 1 to Nr - 1
+            Round(DW[0]);
+            Round(DW[1]);
+            Round(DW[2]);
+            Round(DW[3]);
+            Round(DW[4]);
+            Round(DW[5]);
+            Round(DW[6]);
+            Round(DW[7]);
+            Round(DW[8]);
+
+            // If Nr > 10 implies either AES-192 or AES-256
+            if (Nr > 10)
+            {
+                Round(DW[9]);
+                Round(DW[10]);
+
+                // Nr > 12 implies AES-256
+                if (Nr > 12)
+                {
+                    Round(DW[11]);
+                    Round(DW[12]);
+                }
+            }
+
+            // Final round, storing the results
+            vst1q_u8(p,       veorq_u8(vaesdq_u8(B0, DW[Nr - 1]), DW[Nr]));
+            vst1q_u8(p + 16,  veorq_u8(vaesdq_u8(B1, DW[Nr - 1]), DW[Nr]));
+            vst1q_u8(p + 32,  veorq_u8(vaesdq_u8(B2, DW[Nr - 1]), DW[Nr]));
+            vst1q_u8(p + 48,  veorq_u8(vaesdq_u8(B3, DW[Nr - 1]), DW[Nr]));
+            vst1q_u8(p + 64,  veorq_u8(vaesdq_u8(B4, DW[Nr - 1]), DW[Nr]));
+            vst1q_u8(p + 80,  veorq_u8(vaesdq_u8(B5, DW[Nr - 1]), DW[Nr]));
+            vst1q_u8(p + 96,  veorq_u8(vaesdq_u8(B6, DW[Nr - 1]), DW[Nr]));
+            vst1q_u8(p + 112, veorq_u8(vaesdq_u8(B7, DW[Nr - 1]), DW[Nr]));
+        }
+    }
+
+    // Decrypt four blocks if at least that many remain
+    if (blocks >= 4)
+    {
+        auto Round = [&](const uint8x16_t &key)
+        {
+            B0 = vaesimcq_u8(vaesdq_u8(B0, key));
+            B1 = vaesimcq_u8(vaesdq_u8(B1, key));
+            B2 = vaesimcq_u8(vaesdq_u8(B2, key));
+            B3 = vaesimcq_u8(vaesdq_u8(B3, key));
+        };
+
+        B0 = vld1q_u8(c);
+        B1 = vld1q_u8(c + 16);
+        B2 = vld1q_u8(c + 32);
+        B3 = vld1q_u8(c + 48);
+
+        // Rounds 1 to Nr - 1
+        Round(DW[0]);
+        Round(DW[1]);
+        Round(DW[2]);
+        Round(DW[3]);
+        Round(DW[4]);
+        Round(DW[5]);
+        Round(DW[6]);
+        Round(DW[7]);
+        Round(DW[8]);
+
+        // If Nr > 10 implies either AES-192 or AES-256
+        if (Nr > 10)
+        {
+            Round(DW[9]);
+            Round(DW[10]);
+
+            // Nr > 12 implies AES-256
+            if (Nr > 12)
+            {
+                Round(DW[11]);
+                Round(DW[12]);
+            }
+        }
+
+        // Final round, storing the results
+        vst1q_u8(p,      veorq_u8(vaesdq_u8(B0, DW[Nr - 1]), DW[Nr]));
+        vst1q_u8(p + 16, veorq_u8(vaesdq_u8(B1, DW[Nr - 1]), DW[Nr]));
+        vst1q_u8(p + 32, veorq_u8(vaesdq_u8(B2, DW[Nr - 1]), DW[Nr]));
+        vst1q_u8(p + 48, veorq_u8(vaesdq_u8(B3, DW[Nr - 1]), DW[Nr]));
+
+        blocks -= 4;
+        c += 64;
+        p += 64;
+    }
+
+    // Decrypt any remaining blocks individually
+    for (; blocks > 0; blocks--, c += 16, p += 16)
+    {
+        AESARM::Decrypt(std::span<const std::uint8_t, AES_Block_Size>(c, 16),
+                        std::span<std::uint8_t, AES_Block_Size>(p, 16));
+    }
+}
+
+/*
+ * AESARM::operator==()
+ *
+ *  Description:
+ *      Compare two AESARM objects for equality.  Equality means that the
+ *      two objects have the same key data.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESARM object with which to compare.
+ *
+ *  Returns:
+ *      True if the objects are equal, false otherwise.
+ *
+ *  Comments:
+ *      Since this function is unlikely to be called frequently, this function
+ *      takes a slower approach of unloading the values for comparison.
+ */
+bool AESARM::operator==(const AESARM &other) const
+{
+    const std::array<std::uint8_t, 16> zeros{};
+    std::array<std::uint8_t, 16> result{};
+
+    // If comparing to self, return true
+    if (this == &other) return true;
+
+    if (Nr != other.Nr) return false;
+
+    // Compare the key schedules
+    for (std::size_t i = 0; i < Max_Rounds + 1; i++)
+    {
+        // XOR the two arrays, so all zeros means they are equal
+        vst1q_u8(result.data(), veorq_u8(W[i], other.W[i]));
+
+        // If the result is not all zeros, they are not equal
+        if (result != zeros) return false;
+
+        // XOR the two arrays, so all zeros means they are equal
+        vst1q_u8(result.data(), veorq_u8(DW[i], other.DW[i]));
+
+        // If the result is not all zeros, they are not equal
+        if (result != zeros) return false;
+    }
+
+    return true;
+}
+
+/*
+ * AESARM::operator!=()
+ *
+ *  Description:
+ *      Compare two AESARM objects for inequality.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESARM object with which to compare.
+ *
+ *  Returns:
+ *      True if the objects are not equal, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESARM::operator!=(const AESARM &other) const
+{
+    return !(*this == other);
+}
+
+} // namespace Terra::Crypto::Cipher
+
+#endif // TERRA_USE_ARM_INTRINSICS
@@ -0,0 +1,118 @@
+/*
+ *  aes_arm.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESARM object which performs encryption and
+ *      decryption as specified in FIPS 197 ("Advanced Encryption Standard")
+ *      using the AES instructions of the ARMv8 Cryptography Extension.
+ *
+ *      Note that if one attempts to use this AES engine on a processor that
+ *      does not support the ARMv8 AES instructions it will not work and will
+ *      likely cause the process to terminate with an illegal instruction.
+ *      One should always call GetEngineType() to ensure that it does not
+ *      return "AESEngineType::Unavailable" before attempting to use any of
+ *      the functions.
+ *
+ *  Portability Issues:
+ *      Only 64-bit ARM (AArch64) is supported.  The implementation file is
+ *      compiled with the Cryptography Extension enabled so that the rest of
+ *      the library may run on processors that lack it.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <terra/crypto/cipher/aes.h>
+#include "arm_intrinsics.h"
+#include "cpu_check.h"
+#include "aes_unavailable.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+#ifdef TERRA_USE_ARM_INTRINSICS
+
+// Define the AESARM class
+class AESARM : public AESEngine
+{
+    protected:
+        // The block size of the AES cipher is fixed at 16 octets
+        static constexpr std::size_t AES_Block_Size{16};
+
+        // Number of columns in the State array
+        static constexpr std::size_t Nb{4};
+
+        // Specify the maximum number of rounds per the standard
+        static constexpr std::size_t Max_Rounds{14};
+
+    public:
+        AESARM() noexcept;
+        AESARM(const std::span<const std::uint8_t> key);
+        AESARM(const AESARM &other) noexcept;
+        AESARM(AESARM &&other) noexcept;
+        ~AESARM();
+
+        AESARM &operator=(const AESARM &other);
+        AESARM &operator=(AESARM &&other) noexcept;
+
+        AESEngineType GetEngineType() const noexcept override
+        {
+            if (CPUSupportsARM_AES()) return AESEngineType::ARM;
+
+            return AESEngineType::Unavailable;
+        }
+
+        void SetKey(
+            const std::span<const std::uint8_t> key,
+            AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt) override;
+
+        void ClearKeyState() override;
+
+        void Encrypt(const std::span<const std::uint8_t, 16> plaintext,
+                     std::span<std::uint8_t, 16> ciphertext) const noexcept
+            override;
+
+        void Decrypt(const std::span<const std::uint8_t, 16> ciphertext,
+                     std::span<std::uint8_t, 16> plaintext) const noexcept
+            override;
+
+        void EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const noexcept
+            override;
+
+        void DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const noexcept
+            override;
+
+        bool operator==(const AESARM &other) const;
+        bool operator!=(const AESARM &other) const;
+
+    protected:
+        // Number of encryption rounds
+        std::size_t Nr;
+
+        // Encryption round key schedule array
+        uint8x16_t W[Max_Rounds + 1];
+
+        // Decryption round key schedule array
+        uint8x16_t DW[Max_Rounds + 1];
+};
+
+#else // TERRA_USE_ARM_INTRINSICS
+
+// If building without ARM intrinsics, alias this engine type as unavailable
+
+using AESARM = AESUnavailable;
+
+#endif // TERRA_USE_ARM_INTRINSICS
+
+} // namespace Terra::Crypto::Cipher
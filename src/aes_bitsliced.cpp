@@ -0,0 +1,1748 @@
+/*
+ *  aes_bitsliced.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AESBitsliced object which performs
+ *      encryption and decryption as specified in FIPS 197 ("Advanced
+ *      Encryption Standard") using a bitsliced representation of the AES
+ *      state.
+ *
+ *      Four blocks are held in eight 64-bit words, where word i holds bit i
+ *      of every octet of the four blocks.  In that form, SubBytes is a
+ *      Boolean circuit applied to the eight words and MixColumns is a
+ *      series of rotations and exclusive-or operations.  ShiftRows, a
+ *      permutation of bits within each word, is folded into MixColumns and
+ *      the round keys ("fixslicing").  Each 64-bit "slice" is
+ *      paired with a second to form a 128-bit vector, so eight blocks are
+ *      processed together.
+ *
+ *      References:
+ *      https://bearssl.org/constanttime.html
+ *      https://eprint.iacr.org/2011/332 (Boyar and Peralta S-box circuit)
+ *      https://eprint.iacr.org/2020/1123 (Adomnicai and Peyrin, fixslicing)
+ *
+ *  Portability Issues:
+ *      SSE2 or NEON is used when building with Intel or ARM intrinsics,
+ *      respectively.  Otherwise, pairs of 64-bit integers are used.
+ */
+
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <terra/secutil/secure_erase.h>
+#include "aes_bitsliced.h"
+#include "aes_tables.h"
+#include "intel_intrinsics.h"
+#include "arm_intrinsics.h"
+#include "mode_utilities.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+namespace
+{
+
+// Define a 128-bit vector holding two 64-bit slices
+#if defined(TERRA_USE_INTEL_INTRINSICS)
+
+struct Slice
+{
+    __m128i v;
+};
+
+inline Slice operator^(const Slice a, const Slice b) noexcept
+{
+    return {_mm_xor_si128(a.v, b.v)};
+}
+
+inline Slice operator&(const Slice a, const Slice b) noexcept
+{
+    return {_mm_and_si128(a.v, b.v)};
+}
+
+inline Slice operator|(const Slice a, const Slice b) noexcept
+{
+    return {_mm_or_si128(a.v, b.v)};
+}
+
+inline Slice operator~(const Slice a) noexcept
+{
+    return {_mm_xor_si128(a.v, _mm_set1_epi32(-1))};
+}
+
+template<int N>
+inline Slice ShiftLeft(const Slice a) noexcept
+{
+    return {_mm_slli_epi64(a.v, N)};
+}
+
+template<int N>
+inline Slice ShiftRight(const Slice a) noexcept
+{
+    return {_mm_srli_epi64(a.v, N)};
+}
+
+inline Slice RotateRight16(const Slice a) noexcept
+{
+    return {_mm_shufflehi_epi16(_mm_shufflelo_epi16(a.v, 0x39), 0x39)};
+}
+
+inline Slice RotateRight32(const Slice a) noexcept
+{
+    return {_mm_shuffle_epi32(a.v, 0xb1)};
+}
+
+template<int N>
+inline Slice RotateRows(const Slice a) noexcept
+{
+    if constexpr (N == 0) return a;
+    else return {_mm_or_si128(_mm_srli_epi16(a.v, N), _mm_slli_epi16(a.v, 16 - N))};
+}
+
+inline Slice SliceMask(const std::uint64_t mask) noexcept
+{
+    return {_mm_set1_epi64x(static_cast<long long>(mask))};
+}
+
+inline Slice LoadSlice(const std::uint64_t *p) noexcept
+{
+    return {_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))};
+}
+
+inline void LoadPair(const std::uint8_t *a,
+                     const std::uint8_t *b,
+                     Slice &low,
+                     Slice &high) noexcept
+{
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+
+    low.v = _mm_unpacklo_epi64(x, y);
+    high.v = _mm_unpackhi_epi64(x, y);
+}
+
+inline void StorePair(const Slice low,
+                      const Slice high,
+                      std::uint8_t *a,
+                      std::uint8_t *b) noexcept
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(a),
+                     _mm_unpacklo_epi64(low.v, high.v));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(b),
+                     _mm_unpackhi_epi64(low.v, high.v));
+}
+
+#elif defined(TERRA_USE_ARM_INTRINSICS)
+
+struct Slice
+{
+    uint64x2_t v;
+};
+
+inline Slice operator^(const Slice a, const Slice b) noexcept
+{
+    return {veorq_u64(a.v, b.v)};
+}
+
+inline Slice operator&(const Slice a, const Slice b) noexcept
+{
+    return {vandq_u64(a.v, b.v)};
+}
+
+inline Slice operator|(const Slice a, const Slice b) noexcept
+{
+    return {vorrq_u64(a.v, b.v)};
+}
+
+inline Slice operator~(const Slice a) noexcept
+{
+    return {vreinterpretq_u64_u32(vmvnq_u32(vreinterpretq_u32_u64(a.v)))};
+}
+
+template<int N>
+inline Slice ShiftLeft(const Slice a) noexcept
+{
+    return {vshlq_n_u64(a.v, N)};
+}
+
+template<int N>
+inline Slice ShiftRight(const Slice a) noexcept
+{
+    return {vshrq_n_u64(a.v, N)};
+}
+
+inline Slice RotateRight16(const Slice a) noexcept
+{
+    return {vorrq_u64(vshrq_n_u64(a.v, 16), vshlq_n_u64(a.v, 48))};
+}
+
+inline Slice RotateRight32(const Slice a) noexcept
+{
+    return {vreinterpretq_u64_u32(vrev64q_u32(vreinterpretq_u32_u64(a.v)))};
+}
+
+template<int N>
+inline Slice RotateRows(const Slice a) noexcept
+{
+    if constexpr (N == 0)
+    {
+        return a;
+    }
+    else
+    {
+        const uint16x8_t x = vreinterpretq_u16_u64(a.v);
+
+        return {vreinterpretq_u64_u16(
+            vorrq_u16(vshrq_n_u16(x, N), vshlq_n_u16(x, 16 - N)))};
+    }
+}
+
+inline Slice SliceMask(const std::uint64_t mask) noexcept
+{
+    return {vdupq_n_u64(mask)};
+}
+
+inline Slice LoadSlice(const std::uint64_t *p) noexcept
+{
+    return {vld1q_u64(p)};
+}
+
+inline void LoadPair(const std::uint8_t *a,
+                     const std::uint8_t *b,
+                     Slice &low,
+                     Slice &high) noexcept
+{
+    uint64x2_t x = vreinterpretq_u64_u8(vld1q_u8(a));
+    uint64x2_t y = vreinterpretq_u64_u8(vld1q_u8(b));
+
+    low.v = vcombine_u64(vget_low_u64(x), vget_low_u64(y));
+    high.v = vcombine_u64(vget_high_u64(x), vget_high_u64(y));
+}
+
+inline void StorePair(const Slice low,
+                      const Slice high,
+                      std::uint8_t *a,
+                      std::uint8_t *b) noexcept
+{
+    vst1q_u8(a,
+             vreinterpretq_u8_u64(
+                 vcombine_u64(vget_low_u64(low.v), vget_low_u64(high.v))));
+    vst1q_u8(b,
+             vreinterpretq_u8_u64(
+                 vcombine_u64(vget_high_u64(low.v), vget_high_u64(high.v))));
+}
+
+#else
+
+struct Slice
+{
+    std::uint64_t lo;
+    std::uint64_t hi;
+};
+
+inline Slice operator^(const Slice a, const Slice b) noexcept
+{
+    return {a.lo ^ b.lo, a.hi ^ b.hi};
+}
+
+inline Slice operator&(const Slice a, const Slice b) noexcept
+{
+    return {a.lo & b.lo, a.hi & b.hi};
+}
+
+inline Slice operator|(const Slice a, const Slice b) noexcept
+{
+    return {a.lo | b.lo, a.hi | b.hi};
+}
+
+inline Slice operator~(const Slice a) noexcept
+{
+    return {~a.lo, ~a.hi};
+}
+
+template<int N>
+inline Slice ShiftLeft(const Slice a) noexcept
+{
+    return {a.lo << N, a.hi << N};
+}
+
+template<int N>
+inline Slice ShiftRight(const Slice a) noexcept
+{
+    return {a.lo >> N, a.hi >> N};
+}
+
+inline Slice RotateRight16(const Slice a) noexcept
+{
+    return {(a.lo >> 16) | (a.lo << 48), (a.hi >> 16) | (a.hi << 48)};
+}
+
+inline Slice RotateRight32(const Slice a) noexcept
+{
+    return {(a.lo >> 32) | (a.lo << 32), (a.hi >> 32) | (a.hi << 32)};
+}
+
+template<int N>
+inline Slice RotateRows(const Slice a) noexcept
+{
+    if constexpr (N == 0)
+    {
+        return a;
+    }
+    else
+    {
+        constexpr std::uint64_t Low =
+            (0xffff'ffff'ffff'ffff >> (48 + N)) * 0x0001'0001'0001'0001;
+
+        return {((a.lo >> N) & Low) | ((a.lo << (16 - N)) & ~Low),
+                ((a.hi >> N) & Low) | ((a.hi << (16 - N)) & ~Low)};
+    }
+}
+
+inline Slice SliceMask(const std::uint64_t mask) noexcept
+{
+    return {mask, mask};
+}
+
+inline Slice LoadSlice(const std::uint64_t *p) noexcept
+{
+    return {p[0], p[1]};
+}
+
+inline void LoadPair(const std::uint8_t *a,
+                     const std::uint8_t *b,
+                     Slice &low,
+                     Slice &high) noexcept
+{
+    low = {LoadLittleEndian64(a), LoadLittleEndian64(b)};
+    high = {LoadLittleEndian64(a + 8), LoadLittleEndian64(b + 8)};
+}
+
+inline void StorePair(const Slice low,
+                      const Slice high,
+                      std::uint8_t *a,
+                      std::uint8_t *b) noexcept
+{
+    StoreLittleEndian64(low.lo, a);
+    StoreLittleEndian64(high.lo, a + 8);
+    StoreLittleEndian64(low.hi, b);
+    StoreLittleEndian64(high.hi, b + 8);
+}
+
+#endif
+
+// Scalar equivalents used when computing the key schedule
+template<int N>
+inline std::uint64_t ShiftLeft(const std::uint64_t a) noexcept
+{
+    return a << N;
+}
+
+template<int N>
+inline std::uint64_t ShiftRight(const std::uint64_t a) noexcept
+{
+    return a >> N;
+}
+
+template<typename T>
+inline T Mask(const std::uint64_t mask) noexcept;
+
+template<>
+inline std::uint64_t Mask<std::uint64_t>(const std::uint64_t mask) noexcept
+{
+    return mask;
+}
+
+template<>
+inline Slice Mask<Slice>(const std::uint64_t mask) noexcept
+{
+    return SliceMask(mask);
+}
+
+/*
+ *  SwapBits()
+ *
+ *  Description:
+ *      Exchange the bits selected by the high mask in x with the bits
+ *      selected by the low mask in y, as one step of a bit matrix
+ *      transposition.
+ *
+ *  Parameters:
+ *      x [in/out]
+ *          The first word to modify.
+ *
+ *      y [in/out]
+ *          The second word to modify.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename T, std::uint64_t Low, int N>
+inline void SwapBits(T &x, T &y) noexcept
+{
+    const T a = x;
+    const T b = y;
+
+    x = (a & Mask<T>(Low)) | ShiftLeft<N>(b & Mask<T>(Low));
+    y = ShiftRight<N>(a & Mask<T>(~Low)) | (b & Mask<T>(~Low));
+}
+
+/*
+ *  Ortho()
+ *
+ *  Description:
+ *      Transpose the bits of eight words so that word i holds bit i of each
+ *      octet.  The transformation is its own inverse.
+ *
+ *  Parameters:
+ *      q [in/out]
+ *          The eight words to transform.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename T>
+inline void Ortho(T *q) noexcept
+{
+    SwapBits<T, 0x5555'5555'5555'5555, 1>(q[0], q[1]);
+    SwapBits<T, 0x5555'5555'5555'5555, 1>(q[2], q[3]);
+    SwapBits<T, 0x5555'5555'5555'5555, 1>(q[4], q[5]);
+    SwapBits<T, 0x5555'5555'5555'5555, 1>(q[6], q[7]);
+
+    SwapBits<T, 0x3333'3333'3333'3333, 2>(q[0], q[2]);
+    SwapBits<T, 0x3333'3333'3333'3333, 2>(q[1], q[3]);
+    SwapBits<T, 0x3333'3333'3333'3333, 2>(q[4], q[6]);
+    SwapBits<T, 0x3333'3333'3333'3333, 2>(q[5], q[7]);
+
+    SwapBits<T, 0x0f0f'0f0f'0f0f'0f0f, 4>(q[0], q[4]);
+    SwapBits<T, 0x0f0f'0f0f'0f0f'0f0f, 4>(q[1], q[5]);
+    SwapBits<T, 0x0f0f'0f0f'0f0f'0f0f, 4>(q[2], q[6]);
+    SwapBits<T, 0x0f0f'0f0f'0f0f'0f0f, 4>(q[3], q[7]);
+}
+
+/*
+ *  InterleaveIn()
+ *
+ *  Description:
+ *      Spread the four 32-bit words of a block (each held in the low half
+ *      of a 64-bit word) across two 64-bit words so that, following
+ *      Ortho(), each block occupies every fourth bit.
+ *
+ *  Parameters:
+ *      q0 [out]
+ *          The word receiving columns 0 and 2.
+ *
+ *      q1 [out]
+ *          The word receiving columns 1 and 3.
+ *
+ *      x0, x1, x2, x3 [in]
+ *          The four columns of the block in little endian order.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename T>
+inline void InterleaveIn(T &q0, T &q1, T x0, T x1, T x2, T x3) noexcept
+{
+    x0 = (x0 | ShiftLeft<16>(x0)) & Mask<T>(0x0000'ffff'0000'ffff);
+    x1 = (x1 | ShiftLeft<16>(x1)) & Mask<T>(0x0000'ffff'0000'ffff);
+    x2 = (x2 | ShiftLeft<16>(x2)) & Mask<T>(0x0000'ffff'0000'ffff);
+    x3 = (x3 | ShiftLeft<16>(x3)) & Mask<T>(0x0000'ffff'0000'ffff);
+    x0 = (x0 | ShiftLeft<8>(x0)) & Mask<T>(0x00ff'00ff'00ff'00ff);
+    x1 = (x1 | ShiftLeft<8>(x1)) & Mask<T>(0x00ff'00ff'00ff'00ff);
+    x2 = (x2 | ShiftLeft<8>(x2)) & Mask<T>(0x00ff'00ff'00ff'00ff);
+    x3 = (x3 | ShiftLeft<8>(x3)) & Mask<T>(0x00ff'00ff'00ff'00ff);
+
+    q0 = x0 | ShiftLeft<8>(x2);
+    q1 = x1 | ShiftLeft<8>(x3);
+}
+
+/*
+ *  InterleaveOut()
+ *
+ *  Description:
+ *      Perform the inverse of InterleaveIn(), producing the four 32-bit
+ *      words of a block.  The upper 32 bits of each output are garbage.
+ *
+ *  Parameters:
+ *      q0 [in]
+ *          The word holding columns 0 and 2.
+ *
+ *      q1 [in]
+ *          The word holding columns 1 and 3.
+ *
+ *      x0, x1, x2, x3 [out]
+ *          The four columns of the block in little endian order.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename T>
+inline void InterleaveOut(const T q0, const T q1, T &x0, T &x1, T &x2, T &x3)
+    noexcept
+{
+    x0 = q0 & Mask<T>(0x00ff'00ff'00ff'00ff);
+    x1 = q1 & Mask<T>(0x00ff'00ff'00ff'00ff);
+    x2 = ShiftRight<8>(q0) & Mask<T>(0x00ff'00ff'00ff'00ff);
+    x3 = ShiftRight<8>(q1) & Mask<T>(0x00ff'00ff'00ff'00ff);
+    x0 = (x0 | ShiftRight<8>(x0)) & Mask<T>(0x0000'ffff'0000'ffff);
+    x1 = (x1 | ShiftRight<8>(x1)) & Mask<T>(0x0000'ffff'0000'ffff);
+    x2 = (x2 | ShiftRight<8>(x2)) & Mask<T>(0x0000'ffff'0000'ffff);
+    x3 = (x3 | ShiftRight<8>(x3)) & Mask<T>(0x0000'ffff'0000'ffff);
+    x0 = x0 | ShiftRight<16>(x0);
+    x1 = x1 | ShiftRight<16>(x1);
+    x2 = x2 | ShiftRight<16>(x2);
+    x3 = x3 | ShiftRight<16>(x3);
+}
+
+/*
+ *  SubBytes()
+ *
+ *  Description:
+ *      Apply the AES S-box to every octet of the bitsliced state using the
+ *      circuit of Boyar and Peralta (113 logical operations).
+ *
+ *  Parameters:
+ *      q [in/out]
+ *          The eight slices of the state.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The variable names follow the published circuit, where x0 is the
+ *      most significant bit of each octet.
+ */
+template<typename T>
+inline void SubBytes(T *q) noexcept
+{
+    const T x0 = q[7];
+    const T x1 = q[6];
+    const T x2 = q[5];
+    const T x3 = q[4];
+    const T x4 = q[3];
+    const T x5 = q[2];
+    const T x6 = q[1];
+    const T x7 = q[0];
+
+    // Top linear transformation
+    const T y14 = x3 ^ x5;
+    const T y13 = x0 ^ x6;
+    const T y9 = x0 ^ x3;
+    const T y8 = x0 ^ x5;
+    const T t0 = x1 ^ x2;
+    const T y1 = t0 ^ x7;
+    const T y4 = y1 ^ x3;
+    const T y12 = y13 ^ y14;
+    const T y2 = y1 ^ x0;
+    const T y5 = y1 ^ x6;
+    const T y3 = y5 ^ y8;
+    const T t1 = x4 ^ y12;
+    const T y15 = t1 ^ x5;
+    const T y20 = t1 ^ x1;
+    const T y6 = y15 ^ x7;
+    const T y10 = y15 ^ t0;
+    const T y11 = y20 ^ y9;
+    const T y7 = x7 ^ y11;
+    const T y17 = y10 ^ y11;
+    const T y19 = y10 ^ y8;
+    const T y16 = t0 ^ y11;
+    const T y21 = y13 ^ y16;
+    const T y18 = x0 ^ y16;
+
+    // Non-linear section
+    const T t2 = y12 & y15;
+    const T t3 = y3 & y6;
+    const T t4 = t3 ^ t2;
+    const T t5 = y4 & x7;
+    const T t6 = t5 ^ t2;
+    const T t7 = y13 & y16;
+    const T t8 = y5 & y1;
+    const T t9 = t8 ^ t7;
+    const T t10 = y2 & y7;
+    const T t11 = t10 ^ t7;
+    const T t12 = y9 & y11;
+    const T t13 = y14 & y17;
+    const T t14 = t13 ^ t12;
+    const T t15 = y8 & y10;
+    const T t16 = t15 ^ t12;
+    const T t17 = t4 ^ t14;
+    const T t18 = t6 ^ t16;
+    const T t19 = t9 ^ t14;
+    const T t20 = t11 ^ t16;
+    const T t21 = t17 ^ y20;
+    const T t22 = t18 ^ y19;
+    const T t23 = t19 ^ y21;
+    const T t24 = t20 ^ y18;
+
+    const T t25 = t21 ^ t22;
+    const T t26 = t21 & t23;
+    const T t27 = t24 ^ t26;
+    const T t28 = t25 & t27;
+    const T t29 = t28 ^ t22;
+    const T t30 = t23 ^ t24;
+    const T t31 = t22 ^ t26;
+    const T t32 = t31 & t30;
+    const T t33 = t32 ^ t24;
+    const T t34 = t23 ^ t33;
+    const T t35 = t27 ^ t33;
+    const T t36 = t24 & t35;
+    const T t37 = t36 ^ t34;
+    const T t38 = t27 ^ t36;
+    const T t39 = t29 & t38;
+    const T t40 = t25 ^ t39;
+
+    const T t41 = t40 ^ t37;
+    const T t42 = t29 ^ t33;
+    const T t43 = t29 ^ t40;
+    const T t44 = t33 ^ t37;
+    const T t45 = t42 ^ t41;
+    const T z0 = t44 & y15;
+    const T z1 = t37 & y6;
+    const T z2 = t33 & x7;
+    const T z3 = t43 & y16;
+    const T z4 = t40 & y1;
+    const T z5 = t29 & y7;
+    const T z6 = t42 & y11;
+    const T z7 = t45 & y17;
+    const T z8 = t41 & y10;
+    const T z9 = t44 & y12;
+    const T z10 = t37 & y3;
+    const T z11 = t33 & y4;
+    const T z12 = t43 & y13;
+    const T z13 = t40 & y5;
+    const T z14 = t29 & y2;
+    const T z15 = t42 & y9;
+    const T z16 = t45 & y14;
+    const T z17 = t41 & y8;
+
+    // Bottom linear transformation
+    const T t46 = z15 ^ z16;
+    const T t47 = z10 ^ z11;
+    const T t48 = z5 ^ z13;
+    const T t49 = z9 ^ z10;
+    const T t50 = z2 ^ z12;
+    const T t51 = z2 ^ z5;
+    const T t52 = z7 ^ z8;
+    const T t53 = z0 ^ z3;
+    const T t54 = z6 ^ z7;
+    const T t55 = z16 ^ z17;
+    const T t56 = z12 ^ t48;
+    const T t57 = t50 ^ t53;
+    const T t58 = z4 ^ t46;
+    const T t59 = z3 ^ t54;
+    const T t60 = t46 ^ t57;
+    const T t61 = z14 ^ t57;
+    const T t62 = t52 ^ t58;
+    const T t63 = t49 ^ t58;
+    const T t64 = z4 ^ t59;
+    const T t65 = t61 ^ t62;
+    const T t66 = z1 ^ t63;
+    const T s0 = t59 ^ t63;
+    const T s6 = t56 ^ ~t62;
+    const T s7 = t48 ^ ~t60;
+    const T t67 = t64 ^ t65;
+    const T s3 = t53 ^ t66;
+    const T s4 = t51 ^ t66;
+    const T s5 = t47 ^ t65;
+    const T s1 = t64 ^ ~s3;
+    const T s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+/*
+ *  InverseAffine()
+ *
+ *  Description:
+ *      Apply the inverse of the affine transformation used in the AES S-box
+ *      to every octet of the bitsliced state.
+ *
+ *  Parameters:
+ *      q [in/out]
+ *          The eight slices of the state.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void InverseAffine(Slice *q) noexcept
+{
+    const Slice q0 = ~q[0];
+    const Slice q1 = ~q[1];
+    const Slice q2 = q[2];
+    const Slice q3 = q[3];
+    const Slice q4 = q[4];
+    const Slice q5 = ~q[5];
+    const Slice q6 = ~q[6];
+    const Slice q7 = q[7];
+
+    q[7] = q1 ^ q4 ^ q6;
+    q[6] = q0 ^ q3 ^ q5;
+    q[5] = q7 ^ q2 ^ q4;
+    q[4] = q6 ^ q1 ^ q3;
+    q[3] = q5 ^ q0 ^ q2;
+    q[2] = q4 ^ q7 ^ q1;
+    q[1] = q3 ^ q6 ^ q0;
+    q[0] = q2 ^ q5 ^ q7;
+}
+
+/*
+ *  InvSubBytes()
+ *
+ *  Description:
+ *      Apply the inverse AES S-box to every octet of the bitsliced state.
+ *
+ *  Parameters:
+ *      q [in/out]
+ *          The eight slices of the state.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Since the S-box is the affine transformation A applied to the field
+ *      inverse, the inverse S-box is computed as A^-1(S(A^-1(x))).
+ */
+inline void InvSubBytes(Slice *q) noexcept
+{
+    InverseAffine(q);
+    SubBytes(q);
+    InverseAffine(q);
+}
+
+/*
+ *  ShiftRows()
+ *
+ *  Description:
+ *      Perform the ShiftRows() transformation on a bitsliced value.  Each
+ *      16-bit group of a slice holds one row of four columns for four
+ *      blocks, so the rotation of a row is a rotation of 4-bit groups.
+ *
+ *  Parameters:
+ *      q [in/out]
+ *          The eight slices to transform.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The cipher itself never performs this step (see MixColumns()).  It
+ *      is used only to place each round key in the column order of the
+ *      state at the point the round key is applied.
+ */
+template<typename T>
+inline void ShiftRows(T *q) noexcept
+{
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        const T x = q[i];
+
+        q[i] = (x & Mask<T>(0x0000'0000'0000'ffff)) |
+               ShiftRight<4>(x & Mask<T>(0x0000'0000'fff0'0000)) |
+               ShiftLeft<12>(x & Mask<T>(0x0000'0000'000f'0000)) |
+               ShiftRight<8>(x & Mask<T>(0x0000'ff00'0000'0000)) |
+               ShiftLeft<8>(x & Mask<T>(0x0000'00ff'0000'0000)) |
+               ShiftRight<12>(x & Mask<T>(0xf000'0000'0000'0000)) |
+               ShiftLeft<4>(x & Mask<T>(0x0fff'0000'0000'0000));
+    }
+}
+
+/*
+ *  RestoreColumns()
+ *
+ *  Description:
+ *      Return the state to the normal column order when it is two
+ *      ShiftRows() steps away from it, which is the case at the end of
+ *      encryption with 10 or 14 rounds.  Rows 1 and 3 are rotated by two
+ *      columns, and this step is its own inverse.
+ *
+ *  Parameters:
+ *      q [in/out]
+ *          The eight slices of the state.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void RestoreColumns(Slice *q) noexcept
+{
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        q[i] = (q[i] & SliceMask(0x0000'ffff'0000'ffff)) |
+               (RotateRows<8>(q[i]) & SliceMask(0xffff'0000'ffff'0000));
+    }
+}
+
+/*
+ *  MixColumns()
+ *
+ *  Description:
+ *      Perform the MixColumns() transformation on the bitsliced state.
+ *      Rotating a slice by 16 bits moves each octet to the next row of the
+ *      same column, and multiplication by {02} is a shift across slices
+ *      with reduction by the AES polynomial.
+ *
+ *  Parameters:
+ *      q [in/out]
+ *          The eight slices of the state.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      ShiftRows() is never applied to the state ("fixslicing").  After K
+ *      rounds (modulo 4), the octet in row r of column c is instead found
+ *      in column c + K * r, so the octet below it in the same column is
+ *      found one row down and K columns over.  Each row is rotated
+ *      accordingly when pairing octets, which costs far less than moving
+ *      the state itself.
+ */
+template<unsigned K>
+inline void MixColumns(Slice *q) noexcept
+{
+    auto rotate16 = [](const Slice x) {
+        return RotateRows<(4 * K) % 16>(RotateRight16(x));
+    };
+    auto rotate32 = [](const Slice x) {
+        return RotateRows<(8 * K) % 16>(RotateRight32(x));
+    };
+
+    const Slice q0 = q[0];
+    const Slice q1 = q[1];
+    const Slice q2 = q[2];
+    const Slice q3 = q[3];
+    const Slice q4 = q[4];
+    const Slice q5 = q[5];
+    const Slice q6 = q[6];
+    const Slice q7 = q[7];
+    const Slice r0 = rotate16(q0);
+    const Slice r1 = rotate16(q1);
+    const Slice r2 = rotate16(q2);
+    const Slice r3 = rotate16(q3);
+    const Slice r4 = rotate16(q4);
+    const Slice r5 = rotate16(q5);
+    const Slice r6 = rotate16(q6);
+    const Slice r7 = rotate16(q7);
+
+    q[0] = q7 ^ r7 ^ r0 ^ rotate32(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ rotate32(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ rotate32(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ rotate32(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ rotate32(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ rotate32(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ rotate32(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ rotate32(q7 ^ r7);
+}
+
+/*
+ *  InvMixColumns()
+ *
+ *  Description:
+ *      Perform the InvMixColumns() transformation on the bitsliced state.
+ *
+ *  Parameters:
+ *      q [in/out]
+ *          The eight slices of the state.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The column order of the state is handled as in MixColumns().
+ */
+template<unsigned K>
+inline void InvMixColumns(Slice *q) noexcept
+{
+    auto rotate16 = [](const Slice x) {
+        return RotateRows<(4 * K) % 16>(RotateRight16(x));
+    };
+    auto rotate32 = [](const Slice x) {
+        return RotateRows<(8 * K) % 16>(RotateRight32(x));
+    };
+
+    const Slice q0 = q[0];
+    const Slice q1 = q[1];
+    const Slice q2 = q[2];
+    const Slice q3 = q[3];
+    const Slice q4 = q[4];
+    const Slice q5 = q[5];
+    const Slice q6 = q[6];
+    const Slice q7 = q[7];
+    const Slice r0 = rotate16(q0);
+    const Slice r1 = rotate16(q1);
+    const Slice r2 = rotate16(q2);
+    const Slice r3 = rotate16(q3);
+    const Slice r4 = rotate16(q4);
+    const Slice r5 = rotate16(q5);
+    const Slice r6 = rotate16(q6);
+    const Slice r7 = rotate16(q7);
+
+    q[0] = q5 ^ q6 ^ q7 ^ r0 ^ r5 ^ r7 ^
+           rotate32(q0 ^ q5 ^ q6 ^ r0 ^ r5);
+    q[1] = q0 ^ q5 ^ r0 ^ r1 ^ r5 ^ r6 ^ r7 ^
+           rotate32(q1 ^ q5 ^ q7 ^ r1 ^ r5 ^ r6);
+    q[2] = q0 ^ q1 ^ q6 ^ r1 ^ r2 ^ r6 ^ r7 ^
+           rotate32(q0 ^ q2 ^ q6 ^ r2 ^ r6 ^ r7);
+    q[3] = q0 ^ q1 ^ q2 ^ q5 ^ q6 ^ r0 ^ r2 ^ r3 ^ r5 ^
+           rotate32(q0 ^ q1 ^ q3 ^ q5 ^ q6 ^ q7 ^ r0 ^ r3 ^ r5 ^ r7);
+    q[4] = q1 ^ q2 ^ q3 ^ q5 ^ r1 ^ r3 ^ r4 ^ r5 ^ r6 ^ r7 ^
+           rotate32(q1 ^ q2 ^ q4 ^ q5 ^ q7 ^ r1 ^ r4 ^ r5 ^ r6);
+    q[5] = q2 ^ q3 ^ q4 ^ q6 ^ r2 ^ r4 ^ r5 ^ r6 ^ r7 ^
+           rotate32(q2 ^ q3 ^ q5 ^ q6 ^ r2 ^ r5 ^ r6 ^ r7);
+    q[6] = q3 ^ q4 ^ q5 ^ q7 ^ r3 ^ r5 ^ r6 ^ r7 ^
+           rotate32(q3 ^ q4 ^ q6 ^ q7 ^ r3 ^ r6 ^ r7);
+    q[7] = q4 ^ q5 ^ q6 ^ r4 ^ r6 ^ r7 ^
+           rotate32(q4 ^ q5 ^ q7 ^ r4 ^ r7);
+}
+
+/*
+ *  AddRoundKey()
+ *
+ *  Description:
+ *      XOR the bitsliced round key with the state.
+ *
+ *  Parameters:
+ *      q [in/out]
+ *          The eight slices of the state.
+ *
+ *      key [in]
+ *          The sixteen 64-bit words of the bitsliced round key.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void AddRoundKey(Slice *q, const std::uint64_t *key) noexcept
+{
+    for (std::size_t i = 0; i < 8; i++) q[i] = q[i] ^ LoadSlice(key + i * 2);
+}
+
+/*
+ *  LoadBlocks()
+ *
+ *  Description:
+ *      Load eight blocks into the bitsliced representation.  Blocks 0 to 3
+ *      are held in the low lane of each slice and blocks 4 to 7 in the high
+ *      lane.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The 128 octets to load.
+ *
+ *      q [out]
+ *          The eight slices of the state.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void LoadBlocks(const std::uint8_t *input, Slice *q) noexcept
+{
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        Slice low, high;
+
+        LoadPair(input + i * 16, input + (i + 4) * 16, low, high);
+
+        InterleaveIn(q[i],
+                     q[i + 4],
+                     low & SliceMask(0x0000'0000'ffff'ffff),
+                     ShiftRight<32>(low),
+                     high & SliceMask(0x0000'0000'ffff'ffff),
+                     ShiftRight<32>(high));
+    }
+
+    Ortho(q);
+}
+
+/*
+ *  StoreBlocks()
+ *
+ *  Description:
+ *      Store the bitsliced representation as eight blocks.
+ *
+ *  Parameters:
+ *      q [in/out]
+ *          The eight slices of the state, which are modified.
+ *
+ *      output [out]
+ *          The 128 octets to write.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void StoreBlocks(Slice *q, std::uint8_t *output) noexcept
+{
+    Ortho(q);
+
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        Slice x0, x1, x2, x3;
+
+        InterleaveOut(q[i], q[i + 4], x0, x1, x2, x3);
+
+        StorePair((x0 & SliceMask(0x0000'0000'ffff'ffff)) | ShiftLeft<32>(x1),
+                  (x2 & SliceMask(0x0000'0000'ffff'ffff)) | ShiftLeft<32>(x3),
+                  output + i * 16,
+                  output + (i + 4) * 16);
+    }
+}
+
+/*
+ *  EncryptParallel()
+ *
+ *  Description:
+ *      Encrypt eight blocks using the bitsliced key schedule.
+ *
+ *  Parameters:
+ *      W [in]
+ *          The bitsliced key schedule.
+ *
+ *      Nr [in]
+ *          The number of rounds.
+ *
+ *      input [in]
+ *          The 128 octets of plaintext.
+ *
+ *      output [out]
+ *          The 128 octets of ciphertext, which may be the same memory as
+ *          the input.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void EncryptParallel(const std::uint64_t *W,
+                            const std::size_t Nr,
+                            const std::uint8_t *input,
+                            std::uint8_t *output) noexcept
+{
+    Slice q[8];
+
+    LoadBlocks(input, q);
+
+    AddRoundKey(q, W);
+
+    for (std::size_t round = 1; round < Nr; round++)
+    {
+        SubBytes(q);
+
+        switch (round & 3)
+        {
+            case 0: MixColumns<0>(q); break;
+            case 1: MixColumns<1>(q); break;
+            case 2: MixColumns<2>(q); break;
+            default: MixColumns<3>(q); break;
+        }
+
+        AddRoundKey(q, W + round * 16);
+    }
+
+    SubBytes(q);
+    AddRoundKey(q, W + Nr * 16);
+
+    // Return the columns to their normal order (Nr is 10, 12, or 14)
+    if ((Nr & 3) == 2) RestoreColumns(q);
+
+    StoreBlocks(q, output);
+
+    Terra::SecUtil::SecureErase(q, sizeof(q));
+}
+
+/*
+ *  DecryptParallel()
+ *
+ *  Description:
+ *      Decrypt eight blocks using the bitsliced key schedule.
+ *
+ *  Parameters:
+ *      W [in]
+ *          The bitsliced key schedule.
+ *
+ *      Nr [in]
+ *          The number of rounds.
+ *
+ *      input [in]
+ *          The 128 octets of ciphertext.
+ *
+ *      output [out]
+ *          The 128 octets of plaintext, which may be the same memory as
+ *          the input.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The encryption key schedule is used in reverse order, as the
+ *      inverse steps are applied in the order of the Inverse Cipher.  As
+ *      with encryption, InvShiftRows() is never applied to the state.
+ */
+inline void DecryptParallel(const std::uint64_t *W,
+                            const std::size_t Nr,
+                            const std::uint8_t *input,
+                            std::uint8_t *output) noexcept
+{
+    Slice q[8];
+
+    LoadBlocks(input, q);
+
+    // Place the columns in the order left by the last round of encryption
+    if ((Nr & 3) == 2) RestoreColumns(q);
+
+    AddRoundKey(q, W + Nr * 16);
+
+    for (std::size_t round = Nr - 1; round > 0; round--)
+    {
+        InvSubBytes(q);
+        AddRoundKey(q, W + round * 16);
+
+        switch (round & 3)
+        {
+            case 0: InvMixColumns<0>(q); break;
+            case 1: InvMixColumns<1>(q); break;
+            case 2: InvMixColumns<2>(q); break;
+            default: InvMixColumns<3>(q); break;
+        }
+    }
+
+    InvSubBytes(q);
+    AddRoundKey(q, W);
+
+    StoreBlocks(q, output);
+
+    Terra::SecUtil::SecureErase(q, sizeof(q));
+}
+
+/*
+ *  SubWord()
+ *
+ *  Description:
+ *      Apply the S-box to each octet of a 32-bit word, as used in the key
+ *      expansion, without the use of table lookups.
+ *
+ *  Parameters:
+ *      word [in]
+ *          The word to transform.
+ *
+ *  Returns:
+ *      The transformed word.
+ *
+ *  Comments:
+ *      The word is placed in a scalar bitsliced state by itself, since the
+ *      S-box operates on each octet independently.
+ */
+inline std::uint32_t SubWord(const std::uint32_t word) noexcept
+{
+    std::uint64_t q[8]{};
+
+    q[0] = word;
+
+    Ortho(q);
+    SubBytes(q);
+    Ortho(q);
+
+    const std::uint32_t result = static_cast<std::uint32_t>(q[0]);
+
+    Terra::SecUtil::SecureErase(q, sizeof(q));
+
+    return result;
+}
+
+} // namespace
+
+/*
+ * AESBitsliced::AESBitsliced()
+ *
+ *  Description:
+ *      This is a constructor for the AESBitsliced object with no given key.
+ *      It will initialize internal structures to zero.  Since a key is not
+ *      provided to this version of the constructor, one must call
+ *      SetKey() with a valid key before calling Encrypt() or Decrypt(),
+ *      as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESBitsliced::AESBitsliced() noexcept :
+    AESEngine(),
+    Nr{},
+    W{}
+{
+    // Nothing to do
+}
+
+/*
+ * AESBitsliced::AESBitsliced()
+ *
+ *  Description:
+ *      This is a constructor for the AESBitsliced object that accepts a span
+ *      of octets as input that contains the key.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *      This corresponds to 128, 192, and 256 bits.
+ *
+ *  Comments:
+ *      None.
+ */
+AESBitsliced::AESBitsliced(const std::span<const std::uint8_t> key) :
+    AESBitsliced()
+{
+    SetKey(key);
+}
+
+/*
+ * AESBitsliced::AESBitsliced()
+ *
+ *  Description:
+ *      This is a copy constructor for the AESBitsliced object that accepts a
+ *      reference to another AESBitsliced object as a parameter.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESBitsliced object from which to copy values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESBitsliced::AESBitsliced(const AESBitsliced &other) noexcept :
+    AESBitsliced()
+{
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+}
+
+/*
+ * AESBitsliced::AESBitsliced()
+ *
+ *  Description:
+ *      This is a move constructor for the AESBitsliced object that accepts a
+ *      reference to another AESBitsliced object as a parameter.  Note that
+ *      this move operation actually just performs a copy of data, since there
+ *      is no dynamic data to really move.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESBitsliced object from which to move values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function just copies the other AESBitsliced object's values
+ *      since there is no internal data that can be moved.
+ */
+AESBitsliced::AESBitsliced(AESBitsliced &&other) noexcept : AESBitsliced()
+{
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+}
+
+/*
+ * AESBitsliced::~AESBitsliced()
+ *
+ *  Description:
+ *      This is the destructor for the AESBitsliced object and is responsible
+ *      for zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESBitsliced::~AESBitsliced()
+{
+    SecUtil::SecureErase(&Nr, sizeof(Nr));
+    SecUtil::SecureErase(W, sizeof(W));
+}
+
+/*
+ * AESBitsliced::operator=()
+ *
+ *  Description:
+ *      Assign one AESBitsliced object to another.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESBitsliced from which to copy data.
+ *
+ *  Returns:
+ *      A reference to this AESBitsliced object.
+ *
+ *  Comments:
+ *      None.
+ */
+AESBitsliced &AESBitsliced::operator=(const AESBitsliced &other)
+{
+    // If this is the same object, just return this
+    if (this == &other) return *this;
+
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+
+    return *this;
+}
+
+/*
+ * AESBitsliced::operator=()
+ *
+ *  Description:
+ *      Move assignment operator to assign another AESBitsliced object to
+ *      this one.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESBitsliced from which to move data.
+ *
+ *  Returns:
+ *      A reference to this AESBitsliced object.
+ *
+ *  Comments:
+ *      None.
+ */
+AESBitsliced &AESBitsliced::operator=(AESBitsliced &&other) noexcept
+{
+    // If this is the same object, just return this
+    if (this == &other) return *this;
+
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+
+    return *this;
+}
+
+/*
+ * AESBitsliced::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent calls to
+ *      Encrypt() or Decrypt().
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *      key_usage [in]
+ *          Indicates how the key will be used.  This engine uses the same key
+ *          schedule for encryption and decryption, so this is ignored.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *
+ *  Comments:
+ *      The key expansion of FIPS 197 Section 5.2 is performed on little
+ *      endian words, using the bitsliced S-box for SubWord() so that no
+ *      table lookups depend on the key.  Each round key is then replicated
+ *      for all four blocks of a lane and converted to bitsliced form.
+ */
+void AESBitsliced::SetKey(const std::span<const std::uint8_t> key,
+                          AESKeyUsage)
+{
+    std::uint32_t words[4 * (Max_Rounds + 1)];
+    std::uint64_t q[8];
+    std::size_t Nk;
+
+    // Zero the key schedule
+    SecUtil::SecureErase(W, sizeof(W));
+
+    // Determine the number of rounds given the key length
+    switch (key.size())
+    {
+        case 16:
+            Nr = 10;
+            Nk = 4;
+            break;
+
+        case 24:
+            Nr = 12;
+            Nk = 6;
+            break;
+
+        case 32:
+            Nr = 14;
+            Nk = 8;
+            break;
+
+        default:
+            throw AESException("Invalid key length provided");
+    }
+
+    // Fill the first Nk words in the round key array
+    for (std::size_t i = 0; i < Nk; i++)
+    {
+        words[i] = static_cast<std::uint32_t>(key[(i << 2)    ])       |
+                   static_cast<std::uint32_t>(key[(i << 2) + 1]) <<  8 |
+                   static_cast<std::uint32_t>(key[(i << 2) + 2]) << 16 |
+                   static_cast<std::uint32_t>(key[(i << 2) + 3]) << 24;
+    }
+
+    // Fill the remaining words in the round key array
+    for (std::size_t i = Nk; i < 4 * (Nr + 1); i++)
+    {
+        std::uint32_t temp = words[i - 1];
+
+        if ((i % Nk) == 0)
+        {
+            temp = SubWord((temp << 24) | (temp >> 8)) ^
+                   (Rcon[(i / Nk) - 1] >> 24);
+        }
+        else if ((Nk > 6) && ((i % Nk) == 4))
+        {
+            temp = SubWord(temp);
+        }
+
+        words[i] = words[i - Nk] ^ temp;
+    }
+
+    // Convert each round key to bitsliced form, duplicated in both lanes
+    for (std::size_t i = 0; i <= Nr; i++)
+    {
+        InterleaveIn<std::uint64_t>(q[0],
+                                    q[4],
+                                    words[(i << 2)    ],
+                                    words[(i << 2) + 1],
+                                    words[(i << 2) + 2],
+                                    words[(i << 2) + 3]);
+        q[1] = q[2] = q[3] = q[0];
+        q[5] = q[6] = q[7] = q[4];
+
+        Ortho(q);
+
+        // Match the column order of the state in round i (see MixColumns())
+        for (std::size_t j = 0; j < ((4 - (i & 3)) & 3); j++) ShiftRows(q);
+
+        for (std::size_t j = 0; j < 8; j++)
+        {
+            W[(i * Round_Key_Words) + (j * 2)    ] = q[j];
+            W[(i * Round_Key_Words) + (j * 2) + 1] = q[j];
+        }
+    }
+
+    // Erase the temporary key material
+    SecUtil::SecureErase(words, sizeof(words));
+    SecUtil::SecureErase(q, sizeof(q));
+}
+
+/*
+ * AESBitsliced::ClearKeyState()
+ *
+ *  Description:
+ *      Clear the key and all state data.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESBitsliced::ClearKeyState()
+{
+    SecUtil::SecureErase(&Nr, sizeof(Nr));
+    SecUtil::SecureErase(W, sizeof(W));
+}
+
+/*
+ * AESBitsliced::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt a block of plaintext and return the
+ *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The 16-octet data block to encrypt.
+ *
+ *      ciphertext [out]
+ *          The 16-octet encrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the plaintext span.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      This costs the same as encrypting eight blocks.
+ */
+void AESBitsliced::Encrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> plaintext,
+            std::span<std::uint8_t, AES_Block_Size> ciphertext) const noexcept
+{
+    ProcessPartial(plaintext.data(), ciphertext.data(), 1, true);
+}
+
+/*
+ * AESBitsliced::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt a block of ciphertext and return the
+ *      plaintext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The 16-octet data block to decrypt.
+ *
+ *      plaintext [out]
+ *          The 16-octet decrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the ciphertext span.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      This costs the same as decrypting eight blocks.
+ */
+void AESBitsliced::Decrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> ciphertext,
+            std::span<std::uint8_t, AES_Block_Size> plaintext) const noexcept
+{
+    ProcessPartial(ciphertext.data(), plaintext.data(), 1, false);
+}
+
+/*
+ * AESBitsliced::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a series of plaintext blocks and return the
+ *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The data to encrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      Blocks are encrypted eight at a time, with any remaining blocks
+ *      encrypted together as a final partial group.
+ */
+void AESBitsliced::EncryptBlocks(
+                const std::span<const std::uint8_t> plaintext,
+                std::span<std::uint8_t> ciphertext) const noexcept
+{
+    const std::uint8_t *p = plaintext.data();
+    std::uint8_t *c = ciphertext.data();
+    std::size_t blocks = plaintext.size() / AES_Block_Size;
+
+    for (; blocks >= Parallel_Blocks;
+         blocks -= Parallel_Blocks,
+         p += Parallel_Blocks * AES_Block_Size,
+         c += Parallel_Blocks * AES_Block_Size)
+    {
+        EncryptParallel(W, Nr, p, c);
+    }
+
+    if (blocks > 0) ProcessPartial(p, c, blocks, true);
+}
+
+/*
+ * AESBitsliced::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a series of ciphertext blocks and return the
+ *      plaintext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The data to decrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      See the comments for EncryptBlocks().
+ */
+void AESBitsliced::DecryptBlocks(
+                const std::span<const std::uint8_t> ciphertext,
+                std::span<std::uint8_t> plaintext) const noexcept
+{
+    const std::uint8_t *c = ciphertext.data();
+    std::uint8_t *p = plaintext.data();
+    std::size_t blocks = ciphertext.size() / AES_Block_Size;
+
+    for (; blocks >= Parallel_Blocks;
+         blocks -= Parallel_Blocks,
+         c += Parallel_Blocks * AES_Block_Size,
+         p += Parallel_Blocks * AES_Block_Size)
+    {
+        DecryptParallel(W, Nr, c, p);
+    }
+
+    if (blocks > 0) ProcessPartial(c, p, blocks, false);
+}
+
+/*
+ * AESBitsliced::ProcessPartial()
+ *
+ *  Description:
+ *      Encrypt or decrypt fewer than Parallel_Blocks blocks by copying them
+ *      into a local buffer and processing a full group.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The blocks to process.
+ *
+ *      output [out]
+ *          The processed blocks, which may be the same memory as the input.
+ *
+ *      blocks [in]
+ *          The number of blocks to process, which must be between 1 and
+ *          Parallel_Blocks.
+ *
+ *      encrypt [in]
+ *          True to encrypt, false to decrypt.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESBitsliced::ProcessPartial(const std::uint8_t *input,
+                                  std::uint8_t *output,
+                                  std::size_t blocks,
+                                  bool encrypt) const noexcept
+{
+    const std::size_t length = blocks * AES_Block_Size;
+    std::uint8_t buffer[Parallel_Blocks * AES_Block_Size]{};
+
+    std::memcpy(buffer, input, length);
+
+    if (encrypt)
+    {
+        EncryptParallel(W, Nr, buffer, buffer);
+    }
+    else
+    {
+        DecryptParallel(W, Nr, buffer, buffer);
+    }
+
+    std::memcpy(output, buffer, length);
+
+    SecUtil::SecureErase(buffer, sizeof(buffer));
+}
+
+/*
+ * AESBitsliced::operator==()
+ *
+ *  Description:
+ *      Compare two AESBitsliced objects for equality.  Equality means that
+ *      the two objects have the same key data.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESBitsliced object with which to compare.
+ *
+ *  Returns:
+ *      True if the objects are equal, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESBitsliced::operator==(const AESBitsliced &other) const
+{
+    // If comparing to self, return true
+    if (this == &other) return true;
+
+    if (Nr != other.Nr) return false;
+
+    return std::equal(std::begin(W), std::end(W), std::begin(other.W));
+}
+
+/*
+ * AESBitsliced::operator!=()
+ *
+ *  Description:
+ *      Compare two AESBitsliced objects for inequality.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESBitsliced object with which to compare.
+ *
+ *  Returns:
+ *      True if the objects are not equal, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESBitsliced::operator!=(const AESBitsliced &other) const
+{
+    return !(*this == other);
+}
+
+} // namespace Terra::Crypto::Cipher
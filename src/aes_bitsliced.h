@@ -0,0 +1,115 @@
+/*
+ *  aes_bitsliced.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESBitsliced object which performs encryption
+ *      and decryption as specified in FIPS 197 ("Advanced Encryption
+ *      Standard") using a bitsliced representation of the AES state.
+ *
+ *      Rather than using table lookups, the S-box is computed as a Boolean
+ *      circuit and all other steps are performed using shifts and logical
+ *      operations, so execution time and memory access patterns do not
+ *      depend on the key or the data.  Eight blocks are processed together
+ *      using either 128-bit vector registers (SSE2 or NEON) or pairs of
+ *      64-bit integers, with each 64-bit lane holding four blocks.
+ *
+ *      Since eight blocks cost about as much as one, this engine is best
+ *      used with EncryptBlocks() and DecryptBlocks().  Single-block calls
+ *      are still constant-time, but slower than the T-table engine.
+ *
+ *      The bitsliced representation follows that described in Thomas
+ *      Pornin's BearSSL ("aes_ct64"), with the S-box circuit published by
+ *      Joan Boyar and René Peralta.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <terra/crypto/cipher/aes.h>
+
+namespace Terra::Crypto::Cipher
+{
+
+// Define the AESBitsliced class
+class AESBitsliced : public AESEngine
+{
+    protected:
+        // The block size of the AES cipher is fixed at 16 octets
+        static constexpr std::size_t AES_Block_Size{16};
+
+        // Specify the maximum number of rounds per the standard
+        static constexpr std::size_t Max_Rounds{14};
+
+        // Number of blocks processed in parallel
+        static constexpr std::size_t Parallel_Blocks{8};
+
+        // Number of 64-bit words in each bitsliced round key
+        static constexpr std::size_t Round_Key_Words{16};
+
+    public:
+        AESBitsliced() noexcept;
+        AESBitsliced(const std::span<const std::uint8_t> key);
+        AESBitsliced(const AESBitsliced &other) noexcept;
+        AESBitsliced(AESBitsliced &&other) noexcept;
+        ~AESBitsliced();
+
+        AESBitsliced &operator=(const AESBitsliced &other);
+        AESBitsliced &operator=(AESBitsliced &&other) noexcept;
+
+        AESEngineType GetEngineType() const noexcept override
+        {
+            return AESEngineType::Bitsliced;
+        }
+
+        void SetKey(
+            const std::span<const std::uint8_t> key,
+            AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt) override;
+
+        void ClearKeyState() override;
+
+        void Encrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> plaintext,
+            std::span<std::uint8_t, AES_Block_Size> ciphertext) const noexcept
+            override;
+
+        void Decrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> ciphertext,
+            std::span<std::uint8_t, AES_Block_Size> plaintext) const noexcept
+            override;
+
+        void EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const noexcept
+            override;
+
+        void DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const noexcept
+            override;
+
+        bool operator==(const AESBitsliced &other) const;
+        bool operator!=(const AESBitsliced &other) const;
+
+    protected:
+        void ProcessPartial(const std::uint8_t *input,
+                            std::uint8_t *output,
+                            std::size_t blocks,
+                            bool encrypt) const noexcept;
+
+        std::size_t Nr;                         // Number of encryption rounds
+
+        // Bitsliced round keys (eight slices per round, one per lane)
+        std::uint64_t W[Round_Key_Words * (Max_Rounds + 1)];
+};
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,390 @@
+/*
+ *  aes_cbc.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AES Cipher Block Chaining (CBC) mode of
+ *      operation as specified in NIST Special Publication 800-38A.
+ *
+ *      Decryption is performed Parallel_Blocks blocks at a time: the blocks
+ *      are deciphered with a single call to AES::DecryptBlocks() and then
+ *      each is XORed with the preceding ciphertext block.  A copy of the
+ *      ciphertext is retained so that decryption may be performed in place.
+ *
+ *      EncryptStreams() assigns up to Parallel_Blocks independent messages
+ *      to "lanes" and encrypts the next block of every lane with a single
+ *      call to AES::EncryptBlocks().  When a message is complete, its lane
+ *      is given to the next message waiting to be processed.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <terra/crypto/cipher/aes_cbc.h>
+#include <terra/secutil/secure_erase.h>
+#include "mode_utilities.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+/*
+ *  AESCBC::AESCBC()
+ *
+ *  Description:
+ *      This is a constructor for the AESCBC object with no given key.
+ *      Since a key is not provided to this version of the constructor, one
+ *      must call SetKey() with a valid key before calling Encrypt() or
+ *      Decrypt(), as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCBC::AESCBC() :
+    aes(),
+    previous{},
+    buffer{}
+{
+    // Nothing more to do
+}
+
+/*
+ *  AESCBC::AESCBC()
+ *
+ *  Description:
+ *      This is a constructor for the AESCBC object that accepts a span
+ *      of octets holding a AES key that will be used for subsequent
+ *      operations.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  The
+ *          length of the key must be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the key provided is
+ *      an invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCBC::AESCBC(const std::span<const std::uint8_t> key) :
+    aes(key),
+    previous{},
+    buffer{}
+{
+    // Nothing more to do
+}
+
+/*
+ *  AESCBC::~AESCBC()
+ *
+ *  Description:
+ *      This is the destructor for the AESCBC object and is responsible for
+ *      zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCBC::~AESCBC()
+{
+    SecUtil::SecureErase(&previous, sizeof(previous));
+    SecUtil::SecureErase(&buffer, sizeof(buffer));
+}
+
+/*
+ *  AESCBC::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent encryption
+ *      and decryption calls.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  The
+ *          length of the key must be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCBC::SetKey(const std::span<const std::uint8_t> key)
+{
+    aes.SetKey(key);
+}
+
+/*
+ *  AESCBC::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt the plaintext using CBC mode.
+ *
+ *  Parameters:
+ *      iv [in]
+ *          The initialization vector.
+ *
+ *      plaintext [in]
+ *          The plaintext to be encrypted.  This must be an integral number
+ *          of 16-octet blocks.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext.  This may be the same memory location as the
+ *          plaintext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCBC::Encrypt(const std::span<const std::uint8_t, 16> iv,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext)
+{
+    const std::uint8_t *chain = iv.data();
+
+    // Ensure buffers appear sane ("& 0x0f" performs a mod 16 check)
+    if ((plaintext.size() != ciphertext.size()) ||
+        ((plaintext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    for (std::size_t offset = 0; offset < plaintext.size(); offset += 16)
+    {
+        XorBuffers(plaintext.data() + offset, chain, buffer.data(), 16);
+
+        aes.Encrypt(std::span(buffer).first<16>(),
+                    ciphertext.subspan(offset).first<16>());
+
+        chain = ciphertext.data() + offset;
+    }
+}
+
+/*
+ *  AESCBC::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt the ciphertext using CBC mode.
+ *
+ *  Parameters:
+ *      iv [in]
+ *          The initialization vector used when encrypting.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to be decrypted.  This must be an integral number
+ *          of 16-octet blocks.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext.  This may be the same memory location as the
+ *          ciphertext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCBC::Decrypt(const std::span<const std::uint8_t, 16> iv,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext)
+{
+    std::size_t length{};
+
+    // Ensure buffers appear sane ("& 0x0f" performs a mod 16 check)
+    if ((plaintext.size() != ciphertext.size()) ||
+        ((ciphertext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    std::copy(iv.begin(), iv.end(), previous.begin());
+
+    for (std::size_t offset = 0; offset < ciphertext.size(); offset += length)
+    {
+        length = std::min(buffer.size(), ciphertext.size() - offset);
+
+        // Retain the ciphertext, as it may be overwritten by the plaintext
+        std::copy(ciphertext.begin() + offset,
+                  ciphertext.begin() + offset + length,
+                  buffer.begin());
+
+        // Decipher all of the blocks at once
+        aes.DecryptBlocks(ciphertext.subspan(offset, length),
+                          plaintext.subspan(offset, length));
+
+        // XOR each block with the preceding ciphertext block
+        XorBuffers(plaintext.data() + offset,
+                   previous.data(),
+                   plaintext.data() + offset,
+                   16);
+        XorBuffers(plaintext.data() + offset + 16,
+                   buffer.data(),
+                   plaintext.data() + offset + 16,
+                   length - 16);
+
+        std::copy(buffer.begin() + length - 16,
+                  buffer.begin() + length,
+                  previous.begin());
+    }
+}
+
+/*
+ *  AESCBC::EncryptStreams()
+ *
+ *  Description:
+ *      This function will encrypt a number of independent messages using
+ *      CBC mode, producing the same result as calling Encrypt() for each.
+ *      Up to Parallel_Blocks messages are processed in lockstep so that
+ *      the AES engine can encrypt the blocks of different messages in
+ *      parallel.
+ *
+ *  Parameters:
+ *      ivs [in]
+ *          The initialization vector for each message.  Each must be 16
+ *          octets in length.
+ *
+ *      plaintexts [in]
+ *          The plaintext of each message.  Each must be an integral number of
+ *          16-octet blocks, though the messages may differ in length.
+ *
+ *      ciphertexts [out]
+ *          A buffer to hold the ciphertext of each message.  Each must be the
+ *          same length as the corresponding plaintext and may be the same
+ *          memory location as the plaintext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the number of
+ *      IVs, plaintexts, and ciphertexts differ or if any span has an invalid
+ *      length.  Lengths are verified before any message is encrypted.
+ *
+ *  Comments:
+ *      The ciphertext buffers of different messages must not overlap.
+ */
+void AESCBC::EncryptStreams(
+                    const std::span<const std::span<const std::uint8_t>> ivs,
+                    const std::span<const std::span<const std::uint8_t>>
+                        plaintexts,
+                    const std::span<const std::span<std::uint8_t>> ciphertexts)
+{
+    std::array<std::size_t, Parallel_Blocks> lane_stream{};
+    std::array<std::size_t, Parallel_Blocks> lane_offset{};
+    std::array<const std::uint8_t *, Parallel_Blocks> lane_chain{};
+    std::size_t lanes{};
+    std::size_t next_stream{};
+
+    // Ensure buffers appear sane ("& 0x0f" performs a mod 16 check)
+    if ((ivs.size() != plaintexts.size()) ||
+        (ciphertexts.size() != plaintexts.size()))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+    for (std::size_t i = 0; i < plaintexts.size(); i++)
+    {
+        if ((ivs[i].size() != 16) ||
+            (plaintexts[i].size() != ciphertexts[i].size()) ||
+            ((plaintexts[i].size() & 0x0f) != 0))
+        {
+            throw AESException("One or more spans have an invalid length");
+        }
+    }
+
+    // Assign the next message having data to the given lane
+    auto AssignLane = [&](std::size_t lane) -> bool
+    {
+        while (next_stream < plaintexts.size())
+        {
+            if (!plaintexts[next_stream].empty())
+            {
+                lane_stream[lane] = next_stream;
+                lane_offset[lane] = 0;
+                lane_chain[lane] = ivs[next_stream].data();
+                next_stream++;
+                return true;
+            }
+            next_stream++;
+        }
+
+        return false;
+    };
+
+    // Initially assign messages to all available lanes
+    while ((lanes < Parallel_Blocks) && AssignLane(lanes)) lanes++;
+
+    while (lanes > 0)
+    {
+        // XOR the next plaintext block of each lane with its chaining value
+        for (std::size_t i = 0; i < lanes; i++)
+        {
+            XorBuffers(plaintexts[lane_stream[i]].data() + lane_offset[i],
+                       lane_chain[i],
+                       buffer.data() + i * 16,
+                       16);
+        }
+
+        // Encrypt one block from every lane
+        aes.EncryptBlocks(std::span(buffer).first(lanes * 16),
+                          std::span(buffer).first(lanes * 16));
+
+        // Store the ciphertext and advance each lane
+        for (std::size_t i = 0; i < lanes; i++)
+        {
+            std::uint8_t *c = ciphertexts[lane_stream[i]].data() +
+                              lane_offset[i];
+
+            std::copy(buffer.begin() + i * 16,
+                      buffer.begin() + i * 16 + 16,
+                      c);
+            lane_chain[i] = c;
+            lane_offset[i] += 16;
+        }
+
+        // Replace completed messages, compacting the lanes if none remain
+        for (std::size_t i = 0; i < lanes;)
+        {
+            if (lane_offset[i] < plaintexts[lane_stream[i]].size())
+            {
+                i++;
+                continue;
+            }
+
+            if (AssignLane(i))
+            {
+                i++;
+                continue;
+            }
+
+            lanes--;
+            lane_stream[i] = lane_stream[lanes];
+            lane_offset[i] = lane_offset[lanes];
+            lane_chain[i] = lane_chain[lanes];
+        }
+    }
+}
+
+} // namespace Terra::Crypto::Cipher
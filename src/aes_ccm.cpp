@@ -0,0 +1,510 @@
+/*
+ *  aes_ccm.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the Counter with CBC-MAC (CCM) authenticated
+ *      encryption algorithm as specified in NIST Special Publication
+ *      800-38C and IETF RFC 3610.
+ *
+ *      The first 16 octets of the blocks buffer hold the CBC-MAC block that
+ *      is next to be encrypted, which is the previous MAC value XORed with
+ *      the next block of formatted input.  The associated data is XORed into
+ *      this block as it is read from the caller's buffer.  For each block of
+ *      the payload, the pending MAC block is encrypted together with the
+ *      next counter block, and the resulting keystream is used to encrypt
+ *      or decrypt the payload block, which is then XORed into the MAC value
+ *      to form the next pending MAC block.  Thus every call to the engine
+ *      processes one block of each.  The final MAC block is encrypted
+ *      together with the first counter block, which is used to encrypt the
+ *      tag.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <terra/crypto/cipher/aes_ccm.h>
+#include <terra/secutil/secure_erase.h>
+#include "mode_utilities.h"
+#include "instrumentation.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+/*
+ *  AESCCM::AESCCM()
+ *
+ *  Description:
+ *      This is a constructor for the AESCCM object with no given key.
+ *      Since a key is not provided to this version of the constructor, one
+ *      must call SetKey() with a valid key before calling Encrypt() or
+ *      Decrypt(), as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCCM::AESCCM() :
+    aes(),
+    counter{},
+    counter0{},
+    blocks{},
+    absorbed{}
+{
+    // Nothing more to do
+}
+
+/*
+ *  AESCCM::AESCCM()
+ *
+ *  Description:
+ *      This is a constructor for the AESCCM object that accepts a span
+ *      of octets holding a AES key that will be used for subsequent
+ *      operations.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  The
+ *          length of the key must be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the key provided is
+ *      an invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCCM::AESCCM(const std::span<const std::uint8_t> key) :
+    aes(),
+    counter{},
+    counter0{},
+    blocks{},
+    absorbed{}
+{
+    SetKey(key);
+}
+
+/*
+ *  AESCCM::~AESCCM()
+ *
+ *  Description:
+ *      This is the destructor for the AESCCM object and is responsible for
+ *      zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCCM::~AESCCM()
+{
+    SecUtil::SecureErase(&counter, sizeof(counter));
+    SecUtil::SecureErase(&counter0, sizeof(counter0));
+    SecUtil::SecureErase(&blocks, sizeof(blocks));
+}
+
+/*
+ *  AESCCM::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent encryption
+ *      and decryption calls.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  The
+ *          length of the key must be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *
+ *  Comments:
+ *      Only the encryption key schedule is computed, since CCM uses the AES
+ *      forward cipher for both encryption and decryption.
+ */
+void AESCCM::SetKey(const std::span<const std::uint8_t> key)
+{
+    aes.SetKey(key, AESKeyUsage::EncryptOnly);
+}
+
+/*
+ *  AESCCM::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt the plaintext and produce an
+ *      authentication tag over the associated data and plaintext.
+ *
+ *  Parameters:
+ *      nonce [in]
+ *          The nonce, which must be between 7 and 13 octets in length and
+ *          must never be reused with the same key.
+ *
+ *      aad [in]
+ *          The additional authenticated data, which may be empty.
+ *
+ *      plaintext [in]
+ *          The plaintext to be encrypted, which may be empty.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext.  This may be the same memory location as the
+ *          plaintext.
+ *
+ *      tag [out]
+ *          A buffer to hold the authentication tag, which must be an even
+ *          number of octets between 4 and 16.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length.
+ *
+ *  Comments:
+ *      The nonce length determines the maximum plaintext length, which must
+ *      be less than 2^(8 * (15 - nonce length)) octets.
+ */
+void AESCCM::Encrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> tag)
+{
+    std::size_t length{};
+
+    CheckParameters(nonce, plaintext, ciphertext, tag.size());
+
+    Start(nonce, aad, plaintext.size(), tag.size());
+
+    for (std::size_t offset = 0; offset < plaintext.size(); offset += length)
+    {
+        length = std::min(std::size_t(16), plaintext.size() - offset);
+
+        EncryptPair(counter);
+        IncrementCounter(counter);
+
+        // Authenticate the plaintext before it may be overwritten
+        XorBuffers(blocks.data(),
+                   plaintext.data() + offset,
+                   blocks.data(),
+                   length);
+
+        XorBuffers(plaintext.data() + offset,
+                   blocks.data() + 16,
+                   ciphertext.data() + offset,
+                   length);
+    }
+
+    // Encrypt the final MAC block and the tag's counter block
+    EncryptPair(counter0);
+
+    XorBuffers(blocks.data(), blocks.data() + 16, tag.data(), tag.size());
+}
+
+/*
+ *  AESCCM::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt the ciphertext and verify the
+ *      authentication tag over the associated data and plaintext.
+ *
+ *  Parameters:
+ *      nonce [in]
+ *          The nonce used when encrypting.
+ *
+ *      aad [in]
+ *          The additional authenticated data, which may be empty.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to be decrypted, which may be empty.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext.  This may be the same memory location as the
+ *          ciphertext.
+ *
+ *      tag [in]
+ *          The authentication tag produced when encrypting.
+ *
+ *  Returns:
+ *      True if the tag is valid, false otherwise.  If the tag is not valid,
+ *      the plaintext buffer is zeroed.  An AESException will be thrown if the
+ *      spans have an invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESCCM::Decrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext,
+                     const std::span<const std::uint8_t> tag)
+{
+    std::size_t length{};
+    std::uint8_t difference{};
+
+    CheckParameters(nonce, ciphertext, plaintext, tag.size());
+
+    Start(nonce, aad, ciphertext.size(), tag.size());
+
+    for (std::size_t offset = 0; offset < ciphertext.size(); offset += length)
+    {
+        length = std::min(std::size_t(16), ciphertext.size() - offset);
+
+        EncryptPair(counter);
+        IncrementCounter(counter);
+
+        XorBuffers(ciphertext.data() + offset,
+                   blocks.data() + 16,
+                   plaintext.data() + offset,
+                   length);
+
+        // Authenticate the recovered plaintext
+        XorBuffers(blocks.data(),
+                   plaintext.data() + offset,
+                   blocks.data(),
+                   length);
+    }
+
+    // Encrypt the final MAC block and the tag's counter block
+    EncryptPair(counter0);
+
+    // Compute the authentication tag and compare in constant time
+    for (std::size_t i = 0; i < tag.size(); i++)
+    {
+        difference |= blocks[i] ^ blocks[i + 16] ^ tag[i];
+    }
+
+    if (difference != 0)
+    {
+        SecUtil::SecureErase(plaintext.data(), plaintext.size());
+        RecordAESEvent(aes, AESCounter::IntegrityFailures);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ *  AESCCM::CheckParameters()
+ *
+ *  Description:
+ *      This function will verify that the lengths of the parameters to
+ *      Encrypt() or Decrypt() are valid.
+ *
+ *  Parameters:
+ *      nonce [in]
+ *          The nonce.
+ *
+ *      input [in]
+ *          The input text.
+ *
+ *      output [in]
+ *          The output text buffer.
+ *
+ *      tag_length [in]
+ *          The length of the authentication tag.
+ *
+ *  Returns:
+ *      Nothing, though an AESException is thrown if any length is invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCCM::CheckParameters(const std::span<const std::uint8_t> nonce,
+                             const std::span<const std::uint8_t> input,
+                             const std::span<const std::uint8_t> output,
+                             std::size_t tag_length) const
+{
+    if ((nonce.size() < Min_Nonce_Length) ||
+        (nonce.size() > Max_Nonce_Length) ||
+        (input.size() != output.size()) ||
+        (tag_length < Min_Tag_Length) || (tag_length > Max_Tag_Length) ||
+        ((tag_length & 1) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    // The length must be representable in the octets following the nonce
+    const std::size_t length_octets = 15 - nonce.size();
+    if ((length_octets < sizeof(std::uint64_t)) &&
+        ((static_cast<std::uint64_t>(input.size()) >> (8 * length_octets)) !=
+         0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+}
+
+/*
+ *  AESCCM::Start()
+ *
+ *  Description:
+ *      This function will form the counter blocks and the first block of the
+ *      CBC-MAC and then authenticate the associated data, as described in
+ *      Appendix A of NIST SP 800-38C.
+ *
+ *  Parameters:
+ *      nonce [in]
+ *          The nonce.
+ *
+ *      aad [in]
+ *          The additional authenticated data.
+ *
+ *      text_length [in]
+ *          The length of the plaintext.
+ *
+ *      tag_length [in]
+ *          The length of the authentication tag.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      On return, the first 16 octets of the blocks buffer hold the MAC
+ *      block that is next to be encrypted and counter holds the counter
+ *      block for the first block of the payload.
+ */
+void AESCCM::Start(const std::span<const std::uint8_t> nonce,
+                   const std::span<const std::uint8_t> aad,
+                   std::size_t text_length,
+                   std::size_t tag_length)
+{
+    const std::size_t length_octets = 15 - nonce.size();
+    std::array<std::uint8_t, 10> encoded_length{};
+    std::size_t encoded_octets{};
+
+    // Form the counter block for the tag, followed by that for the payload
+    counter0.fill(0);
+    counter0[0] = static_cast<std::uint8_t>(length_octets - 1);
+    std::copy(nonce.begin(), nonce.end(), counter0.begin() + 1);
+    counter = counter0;
+    IncrementCounter(counter);
+
+    // Form B0, which holds the flags, nonce, and payload length
+    blocks.fill(0);
+    blocks[0] = static_cast<std::uint8_t>((aad.empty() ? 0 : 0x40) |
+                                          (((tag_length - 2) / 2) << 3) |
+                                          (length_octets - 1));
+    std::copy(nonce.begin(), nonce.end(), blocks.begin() + 1);
+    for (std::size_t i = 15; i > nonce.size(); i--, text_length >>= 8)
+    {
+        blocks[i] = static_cast<std::uint8_t>(text_length);
+    }
+    absorbed = 16;
+
+    if (aad.empty()) return;
+
+    // Encode the length of the associated data
+    const std::uint64_t aad_length = aad.size();
+    if (aad_length < 0xff00)
+    {
+        StoreBigEndian32(static_cast<std::uint32_t>(aad_length << 16),
+                         encoded_length.data());
+        encoded_octets = 2;
+    }
+    else if (aad_length <= 0xffff'ffff)
+    {
+        encoded_length[0] = 0xff;
+        encoded_length[1] = 0xfe;
+        StoreBigEndian32(static_cast<std::uint32_t>(aad_length),
+                         encoded_length.data() + 2);
+        encoded_octets = 6;
+    }
+    else
+    {
+        encoded_length[0] = 0xff;
+        encoded_length[1] = 0xff;
+        StoreBigEndian64(aad_length, encoded_length.data() + 2);
+        encoded_octets = 10;
+    }
+
+    Absorb(encoded_length.data(), encoded_octets);
+    Absorb(aad.data(), aad.size());
+}
+
+/*
+ *  AESCCM::Absorb()
+ *
+ *  Description:
+ *      This function will XOR the given data into the CBC-MAC, encrypting
+ *      the pending MAC block each time it has been filled and more data
+ *      follows.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to authenticate.
+ *
+ *      length [in]
+ *          The length of the data.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The last MAC block is left pending, implicitly padded with zeros.
+ */
+void AESCCM::Absorb(const std::uint8_t *data, std::size_t length)
+{
+    std::span<std::uint8_t, 16> mac(blocks.data(), 16);
+    std::size_t octets{};
+
+    for (; length > 0; data += octets, length -= octets)
+    {
+        if (absorbed == 16)
+        {
+            aes.Encrypt(mac, mac);
+            absorbed = 0;
+        }
+
+        octets = std::min(16 - absorbed, length);
+
+        XorBuffers(mac.data() + absorbed,
+                   data,
+                   mac.data() + absorbed,
+                   octets);
+
+        absorbed += octets;
+    }
+}
+
+/*
+ *  AESCCM::EncryptPair()
+ *
+ *  Description:
+ *      This function will encrypt the pending MAC block together with the
+ *      given counter block using a single call to the AES engine.
+ *
+ *  Parameters:
+ *      counter_block [in]
+ *          The counter block to be encrypted to produce keystream.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      On return, the first 16 octets of the blocks buffer hold the new MAC
+ *      value and the last 16 octets hold the keystream.
+ */
+void AESCCM::EncryptPair(const std::array<std::uint8_t, 16> &counter_block)
+{
+    std::copy(counter_block.begin(), counter_block.end(), blocks.begin() + 16);
+
+    aes.EncryptBlocks(blocks, blocks);
+}
+
+} // namespace Terra::Crypto::Cipher
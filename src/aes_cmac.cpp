@@ -0,0 +1,569 @@
+/*
+ *  aes_cmac.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AES-CMAC message authentication code as
+ *      specified in IETF RFC 4493 and NIST Special Publication 800-38B.
+ *
+ *      The final block of a message is XORed with K1 if it is complete or
+ *      padded and XORed with K2 if it is not, so Update() always retains the
+ *      last (possibly complete) block until Final() is called.
+ *
+ *      ComputeTags() assigns up to Parallel_Messages independent messages
+ *      to "lanes", each holding the chaining value for its message in the
+ *      block buffer, and encrypts the next block of every lane with a single
+ *      call to AES::EncryptBlocks().  When a message is complete, its lane
+ *      is given to the next message waiting to be processed.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <terra/crypto/cipher/aes_cmac.h>
+#include <terra/secutil/secure_erase.h>
+#include "mode_utilities.h"
+#include "instrumentation.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+/*
+ *  AESCMAC::AESCMAC()
+ *
+ *  Description:
+ *      This is a constructor for the AESCMAC object with no given key.
+ *      Since a key is not provided to this version of the constructor, one
+ *      must call SetKey() with a valid key before computing a tag, as the
+ *      results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCMAC::AESCMAC() :
+    aes(),
+    K1{},
+    K2{},
+    X{},
+    pending{},
+    pending_length{},
+    buffer{}
+{
+    // Nothing more to do
+}
+
+/*
+ *  AESCMAC::AESCMAC()
+ *
+ *  Description:
+ *      This is a constructor for the AESCMAC object that accepts a span
+ *      of octets holding a AES key that will be used for subsequent
+ *      operations.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The key to use with this instance of the object.  The length of
+ *          the key must be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the key provided is
+ *      an invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCMAC::AESCMAC(const std::span<const std::uint8_t> key) :
+    aes(),
+    K1{},
+    K2{},
+    X{},
+    pending{},
+    pending_length{},
+    buffer{}
+{
+    SetKey(key);
+}
+
+/*
+ *  AESCMAC::~AESCMAC()
+ *
+ *  Description:
+ *      This is the destructor for the AESCMAC object and is responsible for
+ *      zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCMAC::~AESCMAC()
+{
+    SecUtil::SecureErase(&K1, sizeof(K1));
+    SecUtil::SecureErase(&K2, sizeof(K2));
+    SecUtil::SecureErase(&X, sizeof(X));
+    SecUtil::SecureErase(&pending, sizeof(pending));
+    SecUtil::SecureErase(&buffer, sizeof(buffer));
+}
+
+/*
+ *  AESCMAC::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent calls and
+ *      derive the subkeys from it.  Any message being authenticated
+ *      incrementally is discarded.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The key to use with this instance of the object.  The length of
+ *          the key must be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCMAC::SetKey(const std::span<const std::uint8_t> key)
+{
+    aes.SetKey(key, AESKeyUsage::EncryptOnly);
+
+    DeriveSubkeys();
+
+    Reset();
+}
+
+/*
+ *  AESCMAC::Reset()
+ *
+ *  Description:
+ *      This function will discard any message being authenticated
+ *      incrementally so that a new message may be started.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Final() calls this function, so it is only needed to abandon a
+ *      message before its tag is produced.
+ */
+void AESCMAC::Reset() noexcept
+{
+    SecUtil::SecureErase(&X, sizeof(X));
+    SecUtil::SecureErase(&pending, sizeof(pending));
+    pending_length = 0;
+}
+
+/*
+ *  AESCMAC::Update()
+ *
+ *  Description:
+ *      This function will authenticate the next portion of the message.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The next portion of the message, which may be any length.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Whole blocks are processed directly from the data, except that the
+ *      last block seen is retained until it is known whether it is the
+ *      final block of the message.
+ */
+void AESCMAC::Update(const std::span<const std::uint8_t> data)
+{
+    std::size_t offset{};
+    std::size_t length{};
+
+    while (offset < data.size())
+    {
+        // More data follows, so the pending block is not the final block
+        if (pending_length == 16)
+        {
+            XorBuffers(X.data(), pending.data(), X.data(), 16);
+            aes.Encrypt(X, X);
+            pending_length = 0;
+        }
+
+        // Process all but the last block directly from the data
+        if (pending_length == 0)
+        {
+            for (; data.size() - offset > 16; offset += 16)
+            {
+                XorBuffers(X.data(), data.data() + offset, X.data(), 16);
+                aes.Encrypt(X, X);
+            }
+        }
+
+        length = std::min(16 - pending_length, data.size() - offset);
+
+        std::copy(data.begin() + offset,
+                  data.begin() + offset + length,
+                  pending.begin() + pending_length);
+
+        pending_length += length;
+        offset += length;
+    }
+}
+
+/*
+ *  AESCMAC::Final()
+ *
+ *  Description:
+ *      This function will produce the tag for the message passed to
+ *      Update() and then reset the object to begin a new message.
+ *
+ *  Parameters:
+ *      tag [out]
+ *          A buffer to hold the tag, which must be between Min_Tag_Length
+ *          and Max_Tag_Length octets.  A tag shorter than 16 octets holds
+ *          the leftmost octets of the full tag.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the tag length is
+ *      invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCMAC::Final(std::span<std::uint8_t> tag)
+{
+    CheckTagLength(tag.size());
+
+    FinalBlock(pending.data(), pending_length, X.data());
+    aes.Encrypt(X, X);
+
+    std::copy(X.begin(), X.begin() + tag.size(), tag.begin());
+
+    Reset();
+}
+
+/*
+ *  AESCMAC::Compute()
+ *
+ *  Description:
+ *      This function will produce the tag for the given message.
+ *
+ *  Parameters:
+ *      message [in]
+ *          The message to authenticate, which may be any length.
+ *
+ *      tag [out]
+ *          A buffer to hold the tag, which must be between Min_Tag_Length
+ *          and Max_Tag_Length octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the tag length is
+ *      invalid.
+ *
+ *  Comments:
+ *      This does not disturb any message being authenticated incrementally.
+ */
+void AESCMAC::Compute(const std::span<const std::uint8_t> message,
+                      std::span<std::uint8_t> tag)
+{
+    std::array<std::uint8_t, 16> chain{};
+    std::size_t offset{};
+
+    CheckTagLength(tag.size());
+
+    // Process all but the final block
+    for (; message.size() - offset > 16; offset += 16)
+    {
+        XorBuffers(chain.data(), message.data() + offset, chain.data(), 16);
+        aes.Encrypt(chain, chain);
+    }
+
+    FinalBlock(message.data() + offset, message.size() - offset, chain.data());
+    aes.Encrypt(chain, chain);
+
+    std::copy(chain.begin(), chain.begin() + tag.size(), tag.begin());
+
+    SecUtil::SecureErase(&chain, sizeof(chain));
+}
+
+/*
+ *  AESCMAC::Verify()
+ *
+ *  Description:
+ *      This function will compute the tag for the given message and compare
+ *      it with the given tag.
+ *
+ *  Parameters:
+ *      message [in]
+ *          The message to authenticate, which may be any length.
+ *
+ *      tag [in]
+ *          The tag received with the message, which must be between
+ *          Min_Tag_Length and Max_Tag_Length octets.
+ *
+ *  Returns:
+ *      True if the tag is valid, false otherwise.  An AESException will be
+ *      thrown if the tag length is invalid.
+ *
+ *  Comments:
+ *      The tags are compared in constant time.
+ */
+bool AESCMAC::Verify(const std::span<const std::uint8_t> message,
+                     const std::span<const std::uint8_t> tag)
+{
+    std::array<std::uint8_t, 16> computed{};
+    std::uint8_t difference{};
+
+    CheckTagLength(tag.size());
+
+    Compute(message, computed);
+
+    for (std::size_t i = 0; i < tag.size(); i++)
+    {
+        difference |= computed[i] ^ tag[i];
+    }
+
+    SecUtil::SecureErase(&computed, sizeof(computed));
+
+    if (difference != 0)
+    {
+        RecordAESEvent(aes, AESCounter::IntegrityFailures);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ *  AESCMAC::ComputeTags()
+ *
+ *  Description:
+ *      This function will produce the tag for each of a number of
+ *      independent messages, producing the same result as calling Compute()
+ *      for each.  Up to Parallel_Messages messages are processed in
+ *      lockstep so that the AES engine can encrypt the blocks of different
+ *      messages in parallel.
+ *
+ *  Parameters:
+ *      messages [in]
+ *          The messages to authenticate, which may differ in length.
+ *
+ *      tags [out]
+ *          A buffer to hold the tag for each message.  Each must be between
+ *          Min_Tag_Length and Max_Tag_Length octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the number of
+ *      messages and tags differ or if any tag length is invalid.  Lengths
+ *      are verified before any tag is computed.
+ *
+ *  Comments:
+ *      This does not disturb any message being authenticated incrementally.
+ */
+void AESCMAC::ComputeTags(
+                    const std::span<const std::span<const std::uint8_t>>
+                        messages,
+                    const std::span<const std::span<std::uint8_t>> tags)
+{
+    std::array<std::size_t, Parallel_Messages> lane_message{};
+    std::array<std::size_t, Parallel_Messages> lane_offset{};
+    std::array<bool, Parallel_Messages> lane_final{};
+    std::size_t lanes{};
+    std::size_t next_message{};
+
+    if (messages.size() != tags.size())
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+    for (const auto &tag : tags) CheckTagLength(tag.size());
+
+    // Assign the next message to the given lane
+    auto AssignLane = [&](std::size_t lane) -> bool
+    {
+        if (next_message >= messages.size()) return false;
+
+        lane_message[lane] = next_message++;
+        lane_offset[lane] = 0;
+        lane_final[lane] = false;
+        std::fill_n(buffer.begin() + lane * 16, 16, 0);
+
+        return true;
+    };
+
+    // Initially assign messages to all available lanes
+    while ((lanes < Parallel_Messages) && AssignLane(lanes)) lanes++;
+
+    while (lanes > 0)
+    {
+        // XOR the next block of each message into its chaining value
+        for (std::size_t i = 0; i < lanes; i++)
+        {
+            const auto &message = messages[lane_message[i]];
+            const std::size_t remaining = message.size() - lane_offset[i];
+
+            if (remaining > 16)
+            {
+                XorBuffers(buffer.data() + i * 16,
+                           message.data() + lane_offset[i],
+                           buffer.data() + i * 16,
+                           16);
+                lane_offset[i] += 16;
+                continue;
+            }
+
+            FinalBlock(message.data() + lane_offset[i],
+                       remaining,
+                       buffer.data() + i * 16);
+            lane_final[i] = true;
+        }
+
+        // Encrypt one block from every lane
+        aes.EncryptBlocks(std::span(buffer).first(lanes * 16),
+                          std::span(buffer).first(lanes * 16));
+
+        // Store the tags of completed messages, compacting the lanes if no
+        // messages remain
+        for (std::size_t i = 0; i < lanes;)
+        {
+            if (!lane_final[i])
+            {
+                i++;
+                continue;
+            }
+
+            const auto &tag = tags[lane_message[i]];
+
+            std::copy(buffer.begin() + i * 16,
+                      buffer.begin() + i * 16 + tag.size(),
+                      tag.begin());
+
+            if (AssignLane(i))
+            {
+                i++;
+                continue;
+            }
+
+            lanes--;
+            lane_message[i] = lane_message[lanes];
+            lane_offset[i] = lane_offset[lanes];
+            lane_final[i] = lane_final[lanes];
+            std::copy(buffer.begin() + lanes * 16,
+                      buffer.begin() + lanes * 16 + 16,
+                      buffer.begin() + i * 16);
+        }
+    }
+}
+
+/*
+ *  AESCMAC::DeriveSubkeys()
+ *
+ *  Description:
+ *      This function will derive the subkeys K1 and K2 from the key, as
+ *      described in Section 2.3 of RFC 4493.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCMAC::DeriveSubkeys()
+{
+    std::array<std::uint8_t, 16> L{};
+
+    aes.Encrypt(L, L);
+
+    DoubleBlock(L, K1);
+    DoubleBlock(K1, K2);
+
+    SecUtil::SecureErase(&L, sizeof(L));
+}
+
+/*
+ *  AESCMAC::CheckTagLength()
+ *
+ *  Description:
+ *      This function will verify that the tag length is valid.
+ *
+ *  Parameters:
+ *      tag_length [in]
+ *          The length of the tag in octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException is thrown if the length is invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCMAC::CheckTagLength(std::size_t tag_length) const
+{
+    if ((tag_length < Min_Tag_Length) || (tag_length > Max_Tag_Length))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+}
+
+/*
+ *  AESCMAC::FinalBlock()
+ *
+ *  Description:
+ *      This function will XOR the final block of a message, combined with
+ *      the appropriate subkey, into the given chaining value.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The final octets of the message.
+ *
+ *      length [in]
+ *          The number of final octets, which is between 0 and 16.  If less
+ *          than 16, the block is padded with a single 1 bit followed by 0
+ *          bits.
+ *
+ *      block [in/out]
+ *          The chaining value into which the final block is XORed.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCMAC::FinalBlock(const std::uint8_t *data,
+                         std::size_t length,
+                         std::uint8_t *block) const noexcept
+{
+    if (length == 16)
+    {
+        XorBuffers(block, data, block, 16);
+        XorBuffers(block, K1.data(), block, 16);
+        return;
+    }
+
+    XorBuffers(block, data, block, length);
+    block[length] ^= 0x80;
+    XorBuffers(block, K2.data(), block, 16);
+}
+
+} // namespace Terra::Crypto::Cipher
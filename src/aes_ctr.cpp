@@ -0,0 +1,314 @@
+/*
+ *  aes_ctr.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AES Counter (CTR) mode of operation as
+ *      specified in NIST Special Publication 800-38A.
+ *
+ *      Rather than encrypting one counter block at a time, this code fills
+ *      a buffer with up to Keystream_Blocks consecutive counter blocks and
+ *      encrypts them all with a single call to AES::EncryptBlocks().  This
+ *      allows engines that are able to process multiple independent blocks
+ *      in parallel (e.g., AES-NI) to keep the processor's AES unit fully
+ *      occupied.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <terra/crypto/cipher/aes_ctr.h>
+#include <terra/secutil/secure_erase.h>
+#include "mode_utilities.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+/*
+ *  AESCTR::AESCTR()
+ *
+ *  Description:
+ *      This is a constructor for the AESCTR object with no given key or
+ *      counter.  One must call SetKey() and SetCounter() before calling
+ *      Encrypt() or Decrypt(), as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCTR::AESCTR() :
+    aes(),
+    counter{},
+    keystream{},
+    keystream_position{keystream.size()}
+{
+    // Nothing more to do
+}
+
+/*
+ *  AESCTR::AESCTR()
+ *
+ *  Description:
+ *      This is a constructor for the AESCTR object that accepts the key
+ *      and initial counter block to use for subsequent operations.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  The
+ *          length of the key must be 16, 24, or 32 octets.
+ *
+ *      initial_counter [in]
+ *          The initial counter block.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the key provided is
+ *      an invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCTR::AESCTR(const std::span<const std::uint8_t> key,
+               const std::span<const std::uint8_t, 16> initial_counter) :
+    aes(),
+    counter{},
+    keystream{},
+    keystream_position{keystream.size()}
+{
+    SetKey(key);
+    std::copy(initial_counter.begin(), initial_counter.end(), counter.begin());
+}
+
+/*
+ *  AESCTR::~AESCTR()
+ *
+ *  Description:
+ *      This is the destructor for the AESCTR object and is responsible for
+ *      zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCTR::~AESCTR()
+{
+    SecUtil::SecureErase(&counter, sizeof(counter));
+    SecUtil::SecureErase(&keystream, sizeof(keystream));
+    SecUtil::SecureErase(&keystream_position, sizeof(keystream_position));
+}
+
+/*
+ *  AESCTR::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent encryption
+ *      and decryption calls.  Any unused keystream is discarded, though the
+ *      counter value is left unchanged.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  The
+ *          length of the key must be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *
+ *  Comments:
+ *      Only the encryption key schedule is computed, since CTR mode uses
+ *      the AES forward cipher for both encryption and decryption.
+ */
+void AESCTR::SetKey(const std::span<const std::uint8_t> key)
+{
+    aes.SetKey(key, AESKeyUsage::EncryptOnly);
+
+    SecUtil::SecureErase(&keystream, sizeof(keystream));
+    keystream_position = keystream.size();
+}
+
+/*
+ *  AESCTR::SetCounter()
+ *
+ *  Description:
+ *      This function will set the counter block to be used for the next
+ *      octet of keystream.  Any unused keystream is discarded.
+ *
+ *  Parameters:
+ *      counter [in]
+ *          The counter block to use for the next encryption or decryption
+ *          call.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCTR::SetCounter(const std::span<const std::uint8_t, 16> counter)
+{
+    std::copy(counter.begin(), counter.end(), this->counter.begin());
+
+    SecUtil::SecureErase(&keystream, sizeof(keystream));
+    keystream_position = keystream.size();
+}
+
+/*
+ *  AESCTR::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt the plaintext by XORing it with keystream
+ *      produced by encrypting successive counter blocks.  The plaintext
+ *      may be of any length and any keystream left unused at the end of
+ *      this call will be used by the next call.
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The plaintext to be encrypted.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext.  This may be the same memory location as the
+ *          plaintext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans are of
+ *      different lengths.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCTR::Encrypt(const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext)
+{
+    std::size_t offset{};
+    std::size_t length{};
+
+    // Ensure buffers appear sane
+    if (plaintext.size() != ciphertext.size())
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    // Consume any keystream remaining from a previous call
+    length = std::min(keystream.size() - keystream_position, plaintext.size());
+    if (length > 0)
+    {
+        XorBuffers(plaintext.data(),
+                   keystream.data() + keystream_position,
+                   ciphertext.data(),
+                   length);
+        keystream_position += length;
+        offset = length;
+    }
+
+    // Process the remaining input, generating only the keystream needed
+    while (offset < plaintext.size())
+    {
+        length = std::min(keystream.size(), plaintext.size() - offset);
+
+        GenerateKeystream((length + 15) / 16);
+
+        XorBuffers(plaintext.data() + offset,
+                   keystream.data() + keystream_position,
+                   ciphertext.data() + offset,
+                   length);
+        keystream_position += length;
+        offset += length;
+    }
+}
+
+/*
+ *  AESCTR::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt the ciphertext.  Since CTR mode decryption
+ *      is identical to encryption, this simply calls Encrypt().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The ciphertext to be decrypted.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext.  This may be the same memory location as the
+ *          ciphertext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans are of
+ *      different lengths.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCTR::Decrypt(const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext)
+{
+    Encrypt(ciphertext, plaintext);
+}
+
+/*
+ *  AESCTR::GenerateKeystream()
+ *
+ *  Description:
+ *      This function will fill the end of the keystream buffer with the
+ *      given number of successive counter blocks, advancing the counter,
+ *      and then encrypt them in place with a single call to the AES engine.
+ *
+ *  Parameters:
+ *      blocks [in]
+ *          The number of keystream blocks to produce.  This must not exceed
+ *          Keystream_Blocks.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The counter is manipulated as a pair of 64-bit integers rather than
+ *      octet by octet, as the latter is measurably slower.  The blocks are
+ *      placed at the end of the buffer and the keystream position is set
+ *      to the first of them, so any keystream left unused by the caller
+ *      remains the unused portion of the buffer for the next call.
+ */
+void AESCTR::GenerateKeystream(std::size_t blocks)
+{
+    const std::size_t position = keystream.size() - blocks * counter.size();
+    std::uint64_t high = LoadBigEndian64(counter.data());
+    std::uint64_t low = LoadBigEndian64(counter.data() + 8);
+
+    // Write the counter blocks, carrying into the high 64 bits as needed
+    for (std::size_t i = 0; i < blocks; i++)
+    {
+        std::uint8_t *block = keystream.data() + position + i * counter.size();
+
+        StoreBigEndian64(high, block);
+        StoreBigEndian64(low, block + 8);
+        if (++low == 0) high++;
+    }
+
+    // Retain the next counter value
+    StoreBigEndian64(high, counter.data());
+    StoreBigEndian64(low, counter.data() + 8);
+
+    aes.EncryptBlocks(std::span(keystream).subspan(position),
+                      std::span(keystream).subspan(position));
+
+    keystream_position = position;
+}
+
+} // namespace Terra::Crypto::Cipher
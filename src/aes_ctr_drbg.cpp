@@ -0,0 +1,738 @@
+/*
+ *  aes_ctr_drbg.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the CTR_DRBG deterministic random bit generator
+ *      as specified in NIST Special Publication 800-90A using AES-256
+ *      without a derivation function and with a 128-bit counter field.
+ *
+ *      Each generate request writes the successive values of V into the
+ *      output and encrypts them with a single call to AES::EncryptBlocks(),
+ *      as AESCTR does with its keystream buffer.  The update function that
+ *      follows continues with the next three values of V, so those are
+ *      encrypted together with any final partial block of output.
+ *
+ *      A handler registered with pthread_atfork() counts the number of
+ *      times the process has been forked.  Each object records the count
+ *      when it is seeded and reseeds, discarding any buffered output, if
+ *      the count has since changed, so that a parent and child process
+ *      never produce the same output.
+ *
+ *  Portability Issues:
+ *      Detecting a fork requires pthread_atfork(), which is not used on
+ *      Windows, where processes are not forked.  SystemEntropy() uses the
+ *      random number generator interface of each operating system, and
+ *      throws an exception on systems where there is none.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <utility>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <bcrypt.h>
+#else
+#include <pthread.h>
+#include <cerrno>
+#include <cstdlib>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif
+#include <terra/crypto/cipher/aes_ctr_drbg.h>
+#include <terra/secutil/secure_erase.h>
+#include "mode_utilities.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+namespace
+{
+
+// Number of times this process has been forked from its ancestors
+std::atomic<std::uint64_t> Fork_Count{0};
+
+/*
+ *  CountFork()
+ *
+ *  Description:
+ *      This function is called in the child process after a fork to
+ *      increment the fork count.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This only performs an atomic increment, as very little may safely be
+ *      done in a child process following a fork.
+ */
+void CountFork() noexcept
+{
+    Fork_Count.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+ *  RegisterForkHandler()
+ *
+ *  Description:
+ *      This function will register CountFork() to be called in the child
+ *      process after each fork, doing so only on the first call.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the handler cannot
+ *      be registered.
+ *
+ *  Comments:
+ *      None.
+ */
+void RegisterForkHandler()
+{
+#ifndef _WIN32
+    static std::once_flag registered;
+
+    std::call_once(registered, []()
+    {
+        if (pthread_atfork(nullptr, nullptr, CountFork) != 0)
+        {
+            throw AESException("Unable to register the fork handler");
+        }
+    });
+#endif
+}
+
+} // namespace
+
+/*
+ *  AESCTRDRBG::AESCTRDRBG()
+ *
+ *  Description:
+ *      This is a constructor for the AESCTRDRBG object, which instantiates
+ *      the DRBG using entropy from the given entropy source.
+ *
+ *  Parameters:
+ *      entropy_source [in]
+ *          The function that will provide entropy input when the DRBG is
+ *          instantiated and reseeded.  If empty, SystemEntropy() is used.
+ *
+ *      personalization [in]
+ *          An optional personalization string, which must be no longer than
+ *          Seed_Length octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the
+ *      personalization string is too long or the handler that detects a
+ *      fork cannot be registered.  Any exception thrown by the entropy
+ *      source is not caught.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCTRDRBG::AESCTRDRBG(AESEntropySource entropy_source,
+                       const std::span<const std::uint8_t> personalization) :
+    entropy_source{entropy_source ? std::move(entropy_source) : SystemEntropy},
+    prediction_resistance{false},
+    reseed_interval{Default_Reseed_Interval},
+    reseed_counter{0},
+    aes(),
+    V{},
+    seed{},
+    buffer{},
+    buffer_position{Buffer_Size},
+    fork_count{0}
+{
+    RegisterForkHandler();
+
+    Instantiate(personalization);
+}
+
+/*
+ *  AESCTRDRBG::~AESCTRDRBG()
+ *
+ *  Description:
+ *      This is the destructor for the AESCTRDRBG object and is responsible
+ *      for zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESCTRDRBG::~AESCTRDRBG()
+{
+    SecUtil::SecureErase(&V, sizeof(V));
+    SecUtil::SecureErase(&seed, sizeof(seed));
+    SecUtil::SecureErase(&buffer, sizeof(buffer));
+}
+
+/*
+ *  AESCTRDRBG::ThreadInstance()
+ *
+ *  Description:
+ *      This function will return the AESCTRDRBG object owned by the calling
+ *      thread, instantiating it with SystemEntropy() on first use.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the calling thread's AESCTRDRBG object.
+ *
+ *  Comments:
+ *      The object is destroyed when the thread exits.  Since each thread
+ *      has its own instance, no locking is required to use it.  If the
+ *      process forks, the instance in the child is reseeded before it is
+ *      next used.
+ */
+AESCTRDRBG &AESCTRDRBG::ThreadInstance()
+{
+    thread_local AESCTRDRBG instance;
+
+    return instance;
+}
+
+/*
+ *  AESCTRDRBG::SystemEntropy()
+ *
+ *  Description:
+ *      This function will fill the given span with octets from the
+ *      operating system's random number generator.  This is the default
+ *      entropy source.
+ *
+ *  Parameters:
+ *      entropy [out]
+ *          The buffer to fill with entropy.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the operating
+ *      system's random number generator is unavailable or fails.
+ *
+ *  Comments:
+ *      The getrandom() system call is used on Linux and Android,
+ *      arc4random_buf() on macOS and the BSDs, and BCryptGenRandom() on
+ *      Windows.  std::random_device is not used, as it is not required to
+ *      be nondeterministic, and without a derivation function the entropy
+ *      input must be full entropy.  The random number generator is only
+ *      consulted when instantiating or reseeding, so the system call is
+ *      amortized over a great many requests.
+ */
+void AESCTRDRBG::SystemEntropy(std::span<std::uint8_t> entropy)
+{
+#if defined(_WIN32)
+    if (!BCRYPT_SUCCESS(
+            BCryptGenRandom(nullptr,
+                            entropy.data(),
+                            static_cast<ULONG>(entropy.size()),
+                            BCRYPT_USE_SYSTEM_PREFERRED_RNG)))
+    {
+        throw AESException("Unable to obtain system entropy");
+    }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || \
+      defined(__NetBSD__) || defined(__DragonFly__)
+    arc4random_buf(entropy.data(), entropy.size());
+#elif defined(__linux__) && defined(SYS_getrandom)
+    while (!entropy.empty())
+    {
+        // Block until the kernel's random number generator is initialized
+        long result = syscall(SYS_getrandom, entropy.data(), entropy.size(), 0);
+
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            throw AESException("Unable to obtain system entropy");
+        }
+
+        entropy = entropy.subspan(static_cast<std::size_t>(result));
+    }
+#else
+    static_cast<void>(entropy);
+    throw AESException("No system entropy source is available");
+#endif
+}
+
+/*
+ *  AESCTRDRBG::Reseed()
+ *
+ *  Description:
+ *      This function will reseed the DRBG with fresh entropy input from the
+ *      entropy source, as described in Section 10.2.1.4 of SP 800-90A.
+ *
+ *  Parameters:
+ *      additional_input [in]
+ *          Optional additional input, which must be no longer than
+ *          Seed_Length octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the additional
+ *      input is too long.  Any exception thrown by the entropy source is not
+ *      caught.
+ *
+ *  Comments:
+ *      Any buffered octets are discarded, so all subsequent output is
+ *      produced from the reseeded state.
+ */
+void AESCTRDRBG::Reseed(const std::span<const std::uint8_t> additional_input)
+{
+    std::array<std::uint8_t, Seed_Length> seed_material{};
+
+    if (additional_input.size() > Seed_Length)
+    {
+        throw AESException("Additional input is too long");
+    }
+
+    DiscardBuffer();
+
+    fork_count = Fork_Count.load(std::memory_order_relaxed);
+
+    entropy_source(seed_material);
+
+    XorBuffers(seed_material.data(),
+               additional_input.data(),
+               seed_material.data(),
+               additional_input.size());
+
+    Update(seed_material);
+
+    SecUtil::SecureErase(&seed_material, sizeof(seed_material));
+
+    reseed_counter = 1;
+}
+
+/*
+ *  AESCTRDRBG::SetPredictionResistance()
+ *
+ *  Description:
+ *      This function will enable or disable prediction resistance.  When
+ *      enabled, the DRBG is reseeded before every request.
+ *
+ *  Parameters:
+ *      enabled [in]
+ *          True to enable prediction resistance, false to disable it.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Enabling prediction resistance discards any buffered octets.
+ */
+void AESCTRDRBG::SetPredictionResistance(bool enabled) noexcept
+{
+    prediction_resistance = enabled;
+
+    if (prediction_resistance) DiscardBuffer();
+}
+
+/*
+ *  AESCTRDRBG::GetPredictionResistance()
+ *
+ *  Description:
+ *      This function will return whether prediction resistance is enabled.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if prediction resistance is enabled, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESCTRDRBG::GetPredictionResistance() const noexcept
+{
+    return prediction_resistance;
+}
+
+/*
+ *  AESCTRDRBG::SetReseedInterval()
+ *
+ *  Description:
+ *      This function will set the number of generate requests after which
+ *      the DRBG is automatically reseeded.
+ *
+ *  Parameters:
+ *      interval [in]
+ *          The number of requests, which must be between 1 and
+ *          Max_Reseed_Interval.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the interval is
+ *      invalid.
+ *
+ *  Comments:
+ *      Each refill of the buffer is one request.
+ */
+void AESCTRDRBG::SetReseedInterval(std::uint64_t interval)
+{
+    if ((interval == 0) || (interval > Max_Reseed_Interval))
+    {
+        throw AESException("Invalid reseed interval");
+    }
+
+    reseed_interval = interval;
+}
+
+/*
+ *  AESCTRDRBG::Generate()
+ *
+ *  Description:
+ *      This function will fill the output with random octets, taking them
+ *      from the buffer and refilling it as required.
+ *
+ *  Parameters:
+ *      output [out]
+ *          The buffer to fill with random octets, which may be any length.
+ *
+ *  Returns:
+ *      Nothing.  Any exception thrown by the entropy source when reseeding
+ *      is not caught.
+ *
+ *  Comments:
+ *      When prediction resistance is enabled, the output is produced by
+ *      requests of at most Max_Request_Length octets directly into the
+ *      output, each preceded by a reseed.  If the process has forked since
+ *      the DRBG was seeded, it is first reseeded.
+ */
+void AESCTRDRBG::Generate(std::span<std::uint8_t> output)
+{
+    std::size_t length{};
+
+    CheckFork();
+
+    while (!output.empty())
+    {
+        if (prediction_resistance)
+        {
+            length = std::min(output.size(), Max_Request_Length);
+            GenerateRequest(output.first(length), {});
+            output = output.subspan(length);
+            continue;
+        }
+
+        if (buffer_position == buffer.size())
+        {
+            GenerateRequest(buffer, {});
+            buffer_position = 0;
+        }
+
+        length = std::min(output.size(), buffer.size() - buffer_position);
+
+        std::copy(buffer.begin() + buffer_position,
+                  buffer.begin() + buffer_position + length,
+                  output.begin());
+        SecUtil::SecureErase(buffer.data() + buffer_position, length);
+
+        buffer_position += length;
+        output = output.subspan(length);
+    }
+}
+
+/*
+ *  AESCTRDRBG::Generate()
+ *
+ *  Description:
+ *      This function will fill the output with random octets produced by a
+ *      single generate request using the given additional input, bypassing
+ *      the buffer.
+ *
+ *  Parameters:
+ *      output [out]
+ *          The buffer to fill with random octets, which must be no longer
+ *          than Max_Request_Length octets.
+ *
+ *      additional_input [in]
+ *          The additional input, which must be no longer than Seed_Length
+ *          octets.  If empty, this is the same as Generate(output).
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if either span is too
+ *      long.  Any exception thrown by the entropy source when reseeding is
+ *      not caught.
+ *
+ *  Comments:
+ *      As with Generate(output), the DRBG is first reseeded if the process
+ *      has forked since it was seeded.
+ */
+void AESCTRDRBG::Generate(std::span<std::uint8_t> output,
+                          const std::span<const std::uint8_t> additional_input)
+{
+    if (additional_input.empty())
+    {
+        Generate(output);
+        return;
+    }
+
+    if ((output.size() > Max_Request_Length) ||
+        (additional_input.size() > Seed_Length))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    CheckFork();
+
+    GenerateRequest(output, additional_input);
+}
+
+/*
+ *  AESCTRDRBG::Instantiate()
+ *
+ *  Description:
+ *      This function will instantiate the DRBG using entropy input from the
+ *      entropy source, as described in Section 10.2.1.3.1 of SP 800-90A.
+ *
+ *  Parameters:
+ *      personalization [in]
+ *          The personalization string, which may be empty.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the
+ *      personalization string is too long.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCTRDRBG::Instantiate(
+                        const std::span<const std::uint8_t> personalization)
+{
+    const std::array<std::uint8_t, Key_Length> zero_key{};
+
+    if (personalization.size() > Seed_Length)
+    {
+        throw AESException("Personalization string is too long");
+    }
+
+    // Key = 0^keylen and V = 0^blocklen
+    aes.SetKey(zero_key, AESKeyUsage::EncryptOnly);
+    V.fill(0);
+
+    // Reseeding from this state is exactly the instantiate function
+    Reseed(personalization);
+}
+
+/*
+ *  AESCTRDRBG::Update()
+ *
+ *  Description:
+ *      This function implements the CTR_DRBG_Update function described in
+ *      Section 10.2.1.2 of SP 800-90A.
+ *
+ *  Parameters:
+ *      provided_data [in]
+ *          The data to XOR with the new seed, which must be no longer than
+ *          Seed_Length octets.  A shorter span is treated as if padded with
+ *          zeros.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCTRDRBG::Update(const std::span<const std::uint8_t> provided_data)
+{
+    EncryptCounters(seed.data(), Seed_Length / 16);
+
+    SetState(seed.data(), provided_data);
+}
+
+/*
+ *  AESCTRDRBG::EncryptCounters()
+ *
+ *  Description:
+ *      This function will increment V the given number of times, writing
+ *      each value into the output, and then encrypt the output in place.
+ *
+ *  Parameters:
+ *      output [out]
+ *          The buffer to hold the encrypted counter blocks, which must be at
+ *          least 16 * blocks octets in length.
+ *
+ *      blocks [in]
+ *          The number of counter blocks to produce.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      V is manipulated as a pair of 64-bit integers, as in AESCTR.
+ */
+void AESCTRDRBG::EncryptCounters(std::uint8_t *output, std::size_t blocks)
+{
+    if (blocks == 0) return;
+
+    std::uint64_t high = LoadBigEndian64(V.data());
+    std::uint64_t low = LoadBigEndian64(V.data() + 8);
+
+    // V = (V + 1) mod 2^128 before each block
+    for (std::size_t i = 0; i < blocks; i++)
+    {
+        if (++low == 0) high++;
+        StoreBigEndian64(high, output + i * 16);
+        StoreBigEndian64(low, output + i * 16 + 8);
+    }
+
+    StoreBigEndian64(high, V.data());
+    StoreBigEndian64(low, V.data() + 8);
+
+    std::span<std::uint8_t> counters(output, blocks * 16);
+    aes.EncryptBlocks(counters, counters);
+}
+
+/*
+ *  AESCTRDRBG::SetState()
+ *
+ *  Description:
+ *      This function will XOR the provided data into the given Seed_Length
+ *      octets of encrypted counter blocks and take the result as the new
+ *      Key and V, completing the CTR_DRBG_Update function.
+ *
+ *  Parameters:
+ *      temp [in/out]
+ *          The encrypted counter blocks, which are erased once used.
+ *
+ *      provided_data [in]
+ *          The data to XOR with the encrypted counter blocks, which must be
+ *          no longer than Seed_Length octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCTRDRBG::SetState(std::uint8_t *temp,
+                          const std::span<const std::uint8_t> provided_data)
+{
+    XorBuffers(temp, provided_data.data(), temp, provided_data.size());
+
+    aes.SetKey(std::span<const std::uint8_t>(temp, Key_Length),
+               AESKeyUsage::EncryptOnly);
+    std::copy(temp + Key_Length, temp + Seed_Length, V.begin());
+
+    SecUtil::SecureErase(&seed, sizeof(seed));
+}
+
+/*
+ *  AESCTRDRBG::GenerateRequest()
+ *
+ *  Description:
+ *      This function implements the CTR_DRBG_Generate function described in
+ *      Section 10.2.1.5.1 of SP 800-90A, reseeding first if prediction
+ *      resistance is enabled or the reseed interval has been reached.
+ *
+ *  Parameters:
+ *      output [out]
+ *          The buffer to fill with random octets, which must be no longer
+ *          than Max_Request_Length octets.
+ *
+ *      additional_input [in]
+ *          The additional input, which may be empty and must be no longer
+ *          than Seed_Length octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The full blocks of output are produced in the output buffer.  The
+ *      final partial block, if any, and the three blocks for the update
+ *      function are produced in the seed buffer with a single call to the
+ *      engine.
+ */
+void AESCTRDRBG::GenerateRequest(
+                        std::span<std::uint8_t> output,
+                        const std::span<const std::uint8_t> additional_input)
+{
+    std::span<const std::uint8_t> additional = additional_input;
+    const std::size_t complete = output.size() / 16;
+    const std::size_t remaining = output.size() % 16;
+    const std::size_t tail = (remaining > 0) ? 16 : 0;
+
+    // Reseed as required, with the additional input consumed by the reseed
+    if (prediction_resistance || (reseed_counter > reseed_interval))
+    {
+        Reseed(additional);
+        additional = {};
+    }
+
+    if (!additional.empty()) Update(additional);
+
+    EncryptCounters(output.data(), complete);
+
+    EncryptCounters(seed.data(), (tail + Seed_Length) / 16);
+
+    std::copy(seed.begin(),
+              seed.begin() + remaining,
+              output.begin() + complete * 16);
+
+    SetState(seed.data() + tail, additional);
+
+    reseed_counter++;
+}
+
+/*
+ *  AESCTRDRBG::CheckFork()
+ *
+ *  Description:
+ *      This function will reseed the DRBG, discarding any buffered octets,
+ *      if the process has forked since the DRBG was last seeded.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.  Any exception thrown by the entropy source is not caught.
+ *
+ *  Comments:
+ *      Without this, the parent and child processes would both continue
+ *      from the same state and produce identical output.
+ */
+void AESCTRDRBG::CheckFork()
+{
+    if (fork_count != Fork_Count.load(std::memory_order_relaxed)) Reseed();
+}
+
+/*
+ *  AESCTRDRBG::DiscardBuffer()
+ *
+ *  Description:
+ *      This function will erase any unused octets in the buffer so that
+ *      the next buffered request refills it.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESCTRDRBG::DiscardBuffer() noexcept
+{
+    SecUtil::SecureErase(buffer.data() + buffer_position,
+                         buffer.size() - buffer_position);
+
+    buffer_position = buffer.size();
+}
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,739 @@
+/*
+ *  aes_gcm.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the Galois/Counter Mode (GCM) authenticated
+ *      encryption algorithm as specified in NIST Special Publication 800-38D.
+ *
+ *      Rather than encrypting the entire message and then hashing the
+ *      ciphertext in a second pass, the message is processed in groups of
+ *      Pipeline_Blocks blocks.  For each group, the counter blocks are
+ *      encrypted with a single call to AES::EncryptBlocks(), the keystream
+ *      is combined with the input, and the ciphertext is passed to the GHASH
+ *      engine while it is still in the processor cache.  The GHASH engine
+ *      using PCLMULQDQ in turn processes each group of eight blocks with a
+ *      single reduction.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <terra/crypto/cipher/aes_gcm.h>
+#include <terra/secutil/secure_erase.h>
+#include "ghash_universal.h"
+#include "ghash_intel.h"
+#include "cpu_check.h"
+#include "mode_utilities.h"
+#include "instrumentation.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+/*
+ *  AESGCM::AESGCM()
+ *
+ *  Description:
+ *      This is a constructor for the AESGCM object with no given key.
+ *      Since a key is not provided to this version of the constructor, one
+ *      must call SetKey() with a valid key before calling Encrypt() or
+ *      Decrypt(), as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESGCM::AESGCM() :
+    aes(),
+    J0{},
+    counter{},
+    S{},
+    aad_length{},
+    text_length{},
+    text_complete{},
+    finalized{},
+    keystream{}
+{
+    CreateGHASHEngine();
+}
+
+/*
+ *  AESGCM::AESGCM()
+ *
+ *  Description:
+ *      This is a constructor for the AESGCM object that accepts a span
+ *      of octets holding a AES key that will be used for subsequent
+ *      operations.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  The
+ *          length of the key must be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the key provided is
+ *      an invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+AESGCM::AESGCM(const std::span<const std::uint8_t> key) : AESGCM()
+{
+    SetKey(key);
+}
+
+/*
+ *  AESGCM::~AESGCM()
+ *
+ *  Description:
+ *      This is the destructor for the AESGCM object and is responsible for
+ *      zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESGCM::~AESGCM()
+{
+    SecUtil::SecureErase(&J0, sizeof(J0));
+    SecUtil::SecureErase(&counter, sizeof(counter));
+    SecUtil::SecureErase(&S, sizeof(S));
+    SecUtil::SecureErase(&keystream, sizeof(keystream));
+}
+
+/*
+ *  AESGCM::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent encryption
+ *      and decryption calls and derive the GHASH subkey H from it.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  The
+ *          length of the key must be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *
+ *  Comments:
+ *      Only the encryption key schedule is computed, since GCM uses the AES
+ *      forward cipher for both encryption and decryption.
+ */
+void AESGCM::SetKey(const std::span<const std::uint8_t> key)
+{
+    std::array<std::uint8_t, 16> H{};
+
+    aes.SetKey(key, AESKeyUsage::EncryptOnly);
+
+    // The hash subkey is the encryption of the zero block
+    aes.Encrypt(H, H);
+    ghash->SetKey(H);
+
+    SecUtil::SecureErase(&H, sizeof(H));
+}
+
+/*
+ *  AESGCM::Encrypt()
+ *
+ *  Description:
+ *      This function performs the authenticated encryption function
+ *      GCM-AE_K(IV, P, A) defined in Section 7.1 of NIST SP 800-38D.
+ *
+ *  Parameters:
+ *      iv [in]
+ *          The initialization vector.  This must not be empty and should be
+ *          12 octets in length.  An IV must never be reused with the same
+ *          key.
+ *
+ *      aad [in]
+ *          Additional authenticated data, which may be empty.
+ *
+ *      plaintext [in]
+ *          The plaintext to be encrypted, which may be empty.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext.  This may be the same memory location as the
+ *          plaintext.
+ *
+ *      tag [out]
+ *          A buffer to hold the authentication tag.  The length of this span
+ *          determines the tag length and must be one of 4, 8, 12, 13, 14, 15,
+ *          or 16 octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if any span has an
+ *      invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESGCM::Encrypt(const std::span<const std::uint8_t> iv,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> tag)
+{
+    CheckParameters(iv, plaintext, ciphertext, tag.size());
+
+    Start(iv, aad);
+    EncryptUpdate(plaintext, ciphertext);
+    Final(tag);
+}
+
+/*
+ *  AESGCM::Decrypt()
+ *
+ *  Description:
+ *      This function performs the authenticated decryption function
+ *      GCM-AD_K(IV, C, A, T) defined in Section 7.2 of NIST SP 800-38D.
+ *
+ *  Parameters:
+ *      iv [in]
+ *          The initialization vector used when encrypting.
+ *
+ *      aad [in]
+ *          Additional authenticated data, which may be empty.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to be decrypted, which may be empty.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext.  This may be the same memory location as the
+ *          ciphertext.
+ *
+ *      tag [in]
+ *          The authentication tag to verify.  This must be one of 4, 8, 12,
+ *          13, 14, 15, or 16 octets in length.
+ *
+ *  Returns:
+ *      True if the tag is valid, false otherwise.  An AESException will be
+ *      thrown if any span has an invalid length.
+ *
+ *  Comments:
+ *      If the tag is not valid, the plaintext buffer is zeroed so that
+ *      unauthenticated data is not released to the caller.
+ */
+bool AESGCM::Decrypt(const std::span<const std::uint8_t> iv,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext,
+                     const std::span<const std::uint8_t> tag)
+{
+    CheckParameters(iv, ciphertext, plaintext, tag.size());
+
+    Start(iv, aad);
+    DecryptUpdate(ciphertext, plaintext);
+
+    if (!Verify(tag))
+    {
+        SecUtil::SecureErase(plaintext.data(), plaintext.size());
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ *  AESGCM::Start()
+ *
+ *  Description:
+ *      This function will begin the incremental encryption or decryption
+ *      of a message by deriving the pre-counter block from the IV and
+ *      hashing the additional authenticated data.
+ *
+ *  Parameters:
+ *      iv [in]
+ *          The initialization vector.  This must not be empty and should be
+ *          12 octets in length.  An IV must never be reused with the same
+ *          key.
+ *
+ *      aad [in]
+ *          Additional authenticated data, which may be empty.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the IV is empty.
+ *
+ *  Comments:
+ *      Any message previously started and not completed is abandoned.
+ */
+void AESGCM::Start(const std::span<const std::uint8_t> iv,
+                   const std::span<const std::uint8_t> aad)
+{
+    if (iv.empty()) throw AESException("The IV must not be empty");
+
+    // Derive the pre-counter block and hash the additional data
+    ComputeJ0(iv);
+    ghash->Reset();
+    ghash->Update(aad);
+
+    // The first counter block used for the text is inc32(J0)
+    counter = J0;
+    IncrementCounter32(counter);
+
+    aad_length = aad.size();
+    text_length = 0;
+    text_complete = false;
+    finalized = false;
+}
+
+/*
+ *  AESGCM::EncryptUpdate()
+ *
+ *  Description:
+ *      This function will encrypt the next part of a message started with
+ *      Start(), hashing the ciphertext as it is produced.
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The next part of the plaintext to be encrypted.  This must be an
+ *          integral number of blocks unless it is the final part.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext.  This may be the same memory location as the
+ *          plaintext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have
+ *      different lengths, if a partial block was already processed, if the
+ *      message would exceed Max_Plaintext_Length, or if the message was
+ *      already completed by Final() or Verify().
+ *
+ *  Comments:
+ *      None.
+ */
+void AESGCM::EncryptUpdate(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext)
+{
+    std::size_t offset{};
+    std::size_t length{};
+
+    CheckUpdate(plaintext, ciphertext);
+
+    // Encrypt and hash the plaintext one group of blocks at a time
+    while (offset < plaintext.size())
+    {
+        length = std::min(keystream.size(), plaintext.size() - offset);
+
+        GenerateKeystream((length + 15) / 16);
+
+        XorBuffers(plaintext.data() + offset,
+                   keystream.data(),
+                   ciphertext.data() + offset,
+                   length);
+
+        ghash->Update(ciphertext.subspan(offset, length));
+
+        offset += length;
+    }
+}
+
+/*
+ *  AESGCM::DecryptUpdate()
+ *
+ *  Description:
+ *      This function will decrypt the next part of a message started with
+ *      Start(), hashing the ciphertext before it is decrypted.
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The next part of the ciphertext to be decrypted.  This must be an
+ *          integral number of blocks unless it is the final part.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext.  This may be the same memory location as the
+ *          ciphertext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have
+ *      different lengths, if a partial block was already processed, if the
+ *      message would exceed Max_Plaintext_Length, or if the message was
+ *      already completed by Final() or Verify().
+ *
+ *  Comments:
+ *      The plaintext is not authenticated until Verify() returns true.
+ */
+void AESGCM::DecryptUpdate(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext)
+{
+    std::size_t offset{};
+    std::size_t length{};
+
+    CheckUpdate(ciphertext, plaintext);
+
+    // Hash and decrypt the ciphertext one group of blocks at a time
+    while (offset < ciphertext.size())
+    {
+        length = std::min(keystream.size(), ciphertext.size() - offset);
+
+        // Hash first, since the plaintext may overwrite the ciphertext
+        ghash->Update(ciphertext.subspan(offset, length));
+
+        GenerateKeystream((length + 15) / 16);
+
+        XorBuffers(ciphertext.data() + offset,
+                   keystream.data(),
+                   plaintext.data() + offset,
+                   length);
+
+        offset += length;
+    }
+}
+
+/*
+ *  AESGCM::Final()
+ *
+ *  Description:
+ *      This function will complete the incremental encryption of a message
+ *      and produce the authentication tag.
+ *
+ *  Parameters:
+ *      tag [out]
+ *          A buffer to hold the authentication tag.  The length of this span
+ *          determines the tag length and must be one of 4, 8, 12, 13, 14, 15,
+ *          or 16 octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the tag length is
+ *      invalid.
+ *
+ *  Comments:
+ *      The tag is computed only once per message, so calling this again
+ *      returns the same tag.  No further updates are accepted until Start()
+ *      is called.
+ */
+void AESGCM::Final(std::span<std::uint8_t> tag)
+{
+    CheckTagLength(tag.size());
+
+    // Compute the authentication tag and truncate as requested
+    ComputeTag();
+    std::copy(S.begin(), S.begin() + tag.size(), tag.begin());
+}
+
+/*
+ *  AESGCM::Verify()
+ *
+ *  Description:
+ *      This function will complete the incremental decryption of a message
+ *      and verify the authentication tag.
+ *
+ *  Parameters:
+ *      tag [in]
+ *          The authentication tag to verify.  This must be one of 4, 8, 12,
+ *          13, 14, 15, or 16 octets in length.
+ *
+ *  Returns:
+ *      True if the tag is valid, false otherwise.  An AESException will be
+ *      thrown if the tag length is invalid.
+ *
+ *  Comments:
+ *      The comparison is performed in constant time.  As with Final(), the
+ *      tag is computed only once per message, so the result is the same if
+ *      this is called again, and no further updates are accepted until
+ *      Start() is called.
+ */
+bool AESGCM::Verify(const std::span<const std::uint8_t> tag)
+{
+    std::uint8_t difference{};
+
+    CheckTagLength(tag.size());
+
+    ComputeTag();
+    for (std::size_t i = 0; i < tag.size(); i++) difference |= S[i] ^ tag[i];
+
+    if (difference != 0)
+    {
+        RecordAESEvent(aes, AESCounter::IntegrityFailures);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ *  AESGCM::CreateGHASHEngine()
+ *
+ *  Description:
+ *      This function will create the GHASH engine, preferring the engine
+ *      that uses PCLMULQDQ instructions if the processor supports them.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESGCM::CreateGHASHEngine()
+{
+    if (CPUSupportsPCLMULQDQ())
+    {
+        ghash = std::make_unique<GHASHIntel>();
+    }
+    else
+    {
+        ghash = std::make_unique<GHASHUniversal>();
+    }
+}
+
+/*
+ *  AESGCM::ComputeJ0()
+ *
+ *  Description:
+ *      This function will compute the pre-counter block J0 from the IV as
+ *      described in Section 7.1 of NIST SP 800-38D.
+ *
+ *  Parameters:
+ *      iv [in]
+ *          The initialization vector.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      A 96-bit IV is used directly with a 32-bit block counter of 1, while
+ *      an IV of any other length is hashed with GHASH.
+ */
+void AESGCM::ComputeJ0(const std::span<const std::uint8_t> iv)
+{
+    if (iv.size() == 12)
+    {
+        std::copy(iv.begin(), iv.end(), J0.begin());
+        J0[12] = 0;
+        J0[13] = 0;
+        J0[14] = 0;
+        J0[15] = 1;
+        return;
+    }
+
+    std::array<std::uint8_t, 16> length_block{};
+
+    StoreBigEndian64(static_cast<std::uint64_t>(iv.size()) * 8,
+                     length_block.data() + 8);
+
+    ghash->Reset();
+    ghash->Update(iv);
+    ghash->Update(length_block);
+    ghash->GetDigest(J0);
+}
+
+/*
+ *  AESGCM::CheckParameters()
+ *
+ *  Description:
+ *      This function will verify that the spans given to Encrypt() or
+ *      Decrypt() have valid lengths.
+ *
+ *  Parameters:
+ *      iv [in]
+ *          The initialization vector.
+ *
+ *      input [in]
+ *          The input text.
+ *
+ *      output [in]
+ *          The output text buffer.
+ *
+ *      tag_length [in]
+ *          The length of the authentication tag.
+ *
+ *  Returns:
+ *      Nothing, though an AESException is thrown if any length is invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESGCM::CheckParameters(const std::span<const std::uint8_t> iv,
+                             const std::span<const std::uint8_t> input,
+                             const std::span<const std::uint8_t> output,
+                             std::size_t tag_length) const
+{
+    if (iv.empty() || (input.size() != output.size()) ||
+        (static_cast<std::uint64_t>(input.size()) > Max_Plaintext_Length) ||
+        ((tag_length != 4) && (tag_length != 8) &&
+         ((tag_length < 12) || (tag_length > 16))))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+}
+
+/*
+ *  AESGCM::CheckTagLength()
+ *
+ *  Description:
+ *      This function will verify that the given tag length is one of the
+ *      lengths permitted by NIST SP 800-38D.
+ *
+ *  Parameters:
+ *      tag_length [in]
+ *          The length of the authentication tag.
+ *
+ *  Returns:
+ *      Nothing, though an AESException is thrown if the length is invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESGCM::CheckTagLength(std::size_t tag_length) const
+{
+    if ((tag_length != 4) && (tag_length != 8) &&
+        ((tag_length < 12) || (tag_length > 16)))
+    {
+        throw AESException("The tag length is invalid");
+    }
+}
+
+/*
+ *  AESGCM::CheckUpdate()
+ *
+ *  Description:
+ *      This function will verify that the spans given to EncryptUpdate() or
+ *      DecryptUpdate() may be processed and account for their length.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The input text.
+ *
+ *      output [in]
+ *          The output text buffer.
+ *
+ *  Returns:
+ *      Nothing, though an AESException is thrown if the spans cannot be
+ *      processed.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESGCM::CheckUpdate(const std::span<const std::uint8_t> input,
+                         const std::span<const std::uint8_t> output)
+{
+    if (input.size() != output.size())
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    if (finalized)
+    {
+        throw AESException("The message is complete; call Start() first");
+    }
+
+    if (input.empty()) return;
+
+    if (text_complete)
+    {
+        throw AESException("Only the final update may hold a partial block");
+    }
+
+    if (static_cast<std::uint64_t>(input.size()) >
+        Max_Plaintext_Length - text_length)
+    {
+        throw AESException("The message length exceeds the maximum");
+    }
+
+    text_length += input.size();
+    text_complete = (input.size() % 16) != 0;
+}
+
+/*
+ *  AESGCM::GenerateKeystream()
+ *
+ *  Description:
+ *      This function will fill the keystream buffer with the given number
+ *      of successive counter blocks, advancing the counter using inc32(),
+ *      and then encrypt them with a single call to the AES engine.
+ *
+ *  Parameters:
+ *      blocks [in]
+ *          The number of keystream blocks to produce.  This must not exceed
+ *          Pipeline_Blocks.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Only the rightmost 32 bits of the counter block change, so those are
+ *      handled as an integer that wraps modulo 2^32.
+ */
+void AESGCM::GenerateKeystream(std::size_t blocks)
+{
+    std::uint32_t low = LoadBigEndian32(counter.data() + 12);
+
+    for (std::size_t i = 0; i < blocks; i++)
+    {
+        std::copy(counter.begin(),
+                  counter.begin() + 12,
+                  keystream.begin() + i * counter.size());
+        StoreBigEndian32(low++, keystream.data() + i * counter.size() + 12);
+    }
+
+    // Retain the next counter value
+    StoreBigEndian32(low, counter.data() + 12);
+
+    aes.EncryptBlocks(std::span(keystream).first(blocks * counter.size()),
+                      std::span(keystream).first(blocks * counter.size()));
+}
+
+/*
+ *  AESGCM::ComputeTag()
+ *
+ *  Description:
+ *      This function will complete the GHASH computation by hashing the
+ *      lengths of the additional data and text and then encrypt the result
+ *      with the pre-counter block to produce the full 16-octet tag in S.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Since hashing the lengths changes the GHASH state, the tag is
+ *      computed only on the first call after Start(), and later calls leave
+ *      S unchanged.
+ */
+void AESGCM::ComputeTag()
+{
+    std::array<std::uint8_t, 16> length_block{};
+
+    if (finalized) return;
+
+    StoreBigEndian64(aad_length * 8, length_block.data());
+    StoreBigEndian64(text_length * 8, length_block.data() + 8);
+
+    ghash->Update(length_block);
+    ghash->GetDigest(S);
+
+    // Encrypt the hash with J0 (i.e., GCTR applied to a single block)
+    aes.Encrypt(J0, std::span(keystream).first<16>());
+    XorBuffers(S.data(), keystream.data(), S.data(), S.size());
+
+    finalized = true;
+}
+
+} // namespace Terra::Crypto::Cipher
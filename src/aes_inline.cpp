@@ -0,0 +1,631 @@
+/*
+ *  aes_inline.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AESInline object that performs encryption
+ *      and decryption as specified in FIPS 197 ("Advanced Encryption
+ *      Standard").  The selected AES engine is constructed within the
+ *      object's own storage and each call is dispatched on the engine type
+ *      to a non-virtual call to that engine's member function.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cassert>
+#include <new>
+#include <type_traits>
+#include <terra/crypto/cipher/aes_inline.h>
+#include "engine_dispatch.h"
+#include "cpu_check.h"
+#include "instrumentation.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// Call the named member function of the engine without virtual dispatch
+#define DISPATCH(function, ...)                                               \
+    Dispatch(engine_type,                                                     \
+             engine_storage,                                                  \
+             [&](auto &engine)                                                \
+             {                                                                \
+                 using Engine = std::remove_cvref_t<decltype(engine)>;        \
+                 return engine.Engine::function(__VA_ARGS__);                 \
+             })
+
+/*
+ *  AESInline::AESInline()
+ *
+ *  Description:
+ *      This is a constructor for the AESInline object with no given key.
+ *      It will select and create the AES engine.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESInline::AESInline() noexcept :
+    engine_type{AESEngineType::Unavailable},
+    key_usage{AESKeyUsage::EncryptDecrypt}
+{
+    CreateEngine();
+}
+
+/*
+ *  AESInline::AESInline()
+ *
+ *  Description:
+ *      This is a constructor for the AESInline object that accepts a span
+ *      of octets as input that contains the key.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *      key_usage [in]
+ *          Indicates whether the key will be used for both encryption and
+ *          decryption or only for encryption.  If AESKeyUsage::EncryptOnly,
+ *          the decryption key schedule is not computed, DecryptBlocks()
+ *          will throw an exception, and Decrypt() must not be called until
+ *          the key is set again.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *      This corresponds to 128, 192, and 256 bits.
+ *
+ *  Comments:
+ *      None.
+ */
+AESInline::AESInline(const std::span<const std::uint8_t> key,
+                     AESKeyUsage key_usage) :
+    AESInline()
+{
+    SetKey(key, key_usage);
+}
+
+/*
+ *  AESInline::AESInline()
+ *
+ *  Description:
+ *      This is a copy constructor for the AESInline object that accepts a
+ *      reference to another AESInline object as a parameter.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESInline object from which to copy values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESInline::AESInline(const AESInline &other) noexcept :
+    engine_type{AESEngineType::Unavailable},
+    key_usage{AESKeyUsage::EncryptDecrypt}
+{
+    CopyEngine(other);
+}
+
+/*
+ *  AESInline::AESInline()
+ *
+ *  Description:
+ *      This is a move constructor for the AESInline object that accepts a
+ *      reference to another AESInline object as a parameter.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESInline object from which to move values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Since the engine is held within the object, this copies the engine
+ *      and then clears the key state of the other object.
+ */
+AESInline::AESInline(AESInline &&other) noexcept :
+    engine_type{AESEngineType::Unavailable},
+    key_usage{AESKeyUsage::EncryptDecrypt}
+{
+    CopyEngine(other);
+    other.ClearKeyState();
+}
+
+/*
+ *  AESInline::~AESInline()
+ *
+ *  Description:
+ *      This is the destructor for the AESInline object.  Destroying the
+ *      engine will erase the key schedule.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESInline::~AESInline()
+{
+    DestroyEngine();
+}
+
+/*
+ *  AESInline::operator=()
+ *
+ *  Description:
+ *      Assign one AESInline object to another.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESInline from which to copy data.
+ *
+ *  Returns:
+ *      A reference to this AESInline object.
+ *
+ *  Comments:
+ *      None.
+ */
+AESInline &AESInline::operator=(const AESInline &other) noexcept
+{
+    // If this is the same object, just return this
+    if (this == &other) return *this;
+
+    DestroyEngine();
+    CopyEngine(other);
+
+    return *this;
+}
+
+/*
+ *  AESInline::operator=()
+ *
+ *  Description:
+ *      Move assignment operator to assign another AESInline object to this
+ *      one.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESInline from which to move data.
+ *
+ *  Returns:
+ *      A reference to this AESInline object.
+ *
+ *  Comments:
+ *      None.
+ */
+AESInline &AESInline::operator=(AESInline &&other) noexcept
+{
+    // If this is the same object, just return this
+    if (this == &other) return *this;
+
+    DestroyEngine();
+    CopyEngine(other);
+    other.ClearKeyState();
+
+    return *this;
+}
+
+/*
+ *  AESInline::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent calls to
+ *      Encrypt() or Decrypt().
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *      key_usage [in]
+ *          Indicates whether the key will be used for both encryption and
+ *          decryption or only for encryption.  If AESKeyUsage::EncryptOnly,
+ *          the decryption key schedule is not computed, DecryptBlocks()
+ *          will throw an exception, and Decrypt() must not be called until
+ *          the key is set again.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESInline::SetKey(const std::span<const std::uint8_t> key,
+                       AESKeyUsage key_usage)
+{
+    DISPATCH(SetKey, key, key_usage);
+    this->key_usage = key_usage;
+
+    RecordAESEvent(*this, AESCounter::KeySetups);
+}
+
+/*
+ *  AESInline::ClearKeyState()
+ *
+ *  Description:
+ *      Clear the key and all state data.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESInline::ClearKeyState() noexcept
+{
+    DISPATCH(ClearKeyState);
+}
+
+/*
+ *  AESInline::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt a block of plaintext and return the
+ *      ciphertext.
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The 16-octet data block to encrypt.
+ *
+ *      ciphertext [out]
+ *          The 16-octet encrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the plaintext span.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESInline::Encrypt(const std::span<const std::uint8_t, 16> plaintext,
+                        std::span<std::uint8_t, 16> ciphertext) const noexcept
+{
+    DISPATCH(Encrypt, plaintext, ciphertext);
+
+    RecordAESEvent(*this, AESCounter::BlocksEncrypted);
+}
+
+/*
+ *  AESInline::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt a block of ciphertext and return the
+ *      plaintext.
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The 16-octet data block to decrypt.
+ *
+ *      plaintext [out]
+ *          The 16-octet decrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the ciphertext span.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESInline::Decrypt(const std::span<const std::uint8_t, 16> ciphertext,
+                        std::span<std::uint8_t, 16> plaintext) const noexcept
+{
+    // The decryption key schedule must have been computed
+    assert(key_usage == AESKeyUsage::EncryptDecrypt);
+
+    DISPATCH(Decrypt, ciphertext, plaintext);
+
+    RecordAESEvent(*this, AESCounter::BlocksDecrypted);
+}
+
+/*
+ *  AESInline::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a contiguous series of plaintext blocks
+ *      and return the ciphertext (i.e., ECB mode).
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The data to encrypt.  The length must be an integral number of
+ *          16-octet blocks.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.  An exception will be thrown if the span lengths
+ *      are invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESInline::EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                              std::span<std::uint8_t> ciphertext) const
+{
+    // Ensure the spans are of equal length and are whole blocks
+    if ((plaintext.size() != ciphertext.size()) ||
+        ((plaintext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    DISPATCH(EncryptBlocks, plaintext, ciphertext);
+
+    RecordAESEvent(*this, AESCounter::BlocksEncrypted, plaintext.size() / 16);
+}
+
+/*
+ *  AESInline::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a contiguous series of ciphertext blocks
+ *      and return the plaintext (i.e., ECB mode).
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The data to decrypt.  The length must be an integral number of
+ *          16-octet blocks.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.  An exception will be thrown if the span lengths
+ *      are invalid or if the key was set for encryption only.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESInline::DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                              std::span<std::uint8_t> plaintext) const
+{
+    // Ensure the spans are of equal length and are whole blocks
+    if ((ciphertext.size() != plaintext.size()) ||
+        ((ciphertext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    // The decryption key schedule must have been computed
+    if (key_usage == AESKeyUsage::EncryptOnly)
+    {
+        throw AESException("The key was set for encryption only");
+    }
+
+    DISPATCH(DecryptBlocks, ciphertext, plaintext);
+
+    RecordAESEvent(*this, AESCounter::BlocksDecrypted, ciphertext.size() / 16);
+}
+
+/*
+ *  AESInline::operator==()
+ *
+ *  Description:
+ *      Compare two AESInline objects for equality.  Equality means that the
+ *      two objects use the same engine and have the same key data.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESInline object with which to compare.
+ *
+ *  Returns:
+ *      True if the objects are equal, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESInline::operator==(const AESInline &other) const noexcept
+{
+    // If comparing to self, return true
+    if (this == &other) return true;
+
+    if (engine_type != other.engine_type) return false;
+
+    return Dispatch(engine_type,
+                    engine_storage,
+                    [&](const auto &engine)
+                    {
+                        using Engine = std::remove_cvref_t<decltype(engine)>;
+
+                        return engine == StoredEngine<Engine>(
+                                             other.engine_storage);
+                    });
+}
+
+/*
+ *  AESInline::operator!=()
+ *
+ *  Description:
+ *      Compare two AESInline objects for inequality.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESInline object with which to compare.
+ *
+ *  Returns:
+ *      True if the objects are not equal, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESInline::operator!=(const AESInline &other) const noexcept
+{
+    return !(*this == other);
+}
+
+/*
+ *  AESInline::CreateEngine()
+ *
+ *  Description:
+ *      Select the AES engine to use and construct it in the engine storage.
+ *      The order of preference is the same as for the AES object, including
+ *      the engine preferred by the process if it is one that this object
+ *      is able to hold.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESInline::CreateEngine() noexcept
+{
+    // Ensure each engine that might be selected fits within the storage
+    static_assert(sizeof(AESIntelVAES) <= Engine_Storage_Size);
+    static_assert(sizeof(AESIntel) <= Engine_Storage_Size);
+    static_assert(sizeof(AESARM) <= Engine_Storage_Size);
+    static_assert(sizeof(AESVectorPermute) <= Engine_Storage_Size);
+    static_assert(sizeof(AESUniversal) <= Engine_Storage_Size);
+    static_assert(alignof(AESIntelVAES) <= alignof(AESInline));
+    static_assert(alignof(AESIntel) <= alignof(AESInline));
+    static_assert(alignof(AESARM) <= alignof(AESInline));
+    static_assert(alignof(AESVectorPermute) <= alignof(AESInline));
+    static_assert(alignof(AESUniversal) <= alignof(AESInline));
+
+    const CPUFeatures &features = GetCPUFeatures();
+
+    // Use the engine preferred by this process, if one is usable
+    switch (AES::GetPreferredEngine())
+    {
+        case AESEngineType::IntelVAES:
+            if (TryEngine<AESIntelVAES>(engine_storage, engine_type)) return;
+            break;
+
+        case AESEngineType::Intel:
+            if (TryEngine<AESIntel>(engine_storage, engine_type)) return;
+            break;
+
+        case AESEngineType::ARM:
+            if (TryEngine<AESARM>(engine_storage, engine_type)) return;
+            break;
+
+        case AESEngineType::VectorPermute:
+            if (TryEngine<AESVectorPermute>(engine_storage, engine_type))
+            {
+                return;
+            }
+            break;
+
+        case AESEngineType::Universal:
+            if (TryEngine<AESUniversal>(engine_storage, engine_type)) return;
+            break;
+
+        default:
+            break;
+    }
+
+    if (features.aes_ni && features.vaes &&
+        TryEngine<AESIntelVAES>(engine_storage, engine_type))
+    {
+        return;
+    }
+
+    if (features.aes_ni && TryEngine<AESIntel>(engine_storage, engine_type))
+    {
+        return;
+    }
+
+    if (features.arm_aes && TryEngine<AESARM>(engine_storage, engine_type))
+    {
+        return;
+    }
+
+    if (TryEngine<AESVectorPermute>(engine_storage, engine_type)) return;
+
+    // Use the universal engine that works on all processors
+    new (engine_storage) AESUniversal();
+    engine_type = AESEngineType::Universal;
+}
+
+/*
+ *  AESInline::CopyEngine()
+ *
+ *  Description:
+ *      Construct a copy of the other object's engine in this object's
+ *      engine storage.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESInline object from which to copy the engine.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The engines' copy constructors simply copy the key schedule.  Any
+ *      engine previously held in this object must have been destroyed.
+ */
+void AESInline::CopyEngine(const AESInline &other) noexcept
+{
+    Dispatch(other.engine_type,
+             other.engine_storage,
+             [&](const auto &engine)
+             {
+                 using Engine = std::remove_cvref_t<decltype(engine)>;
+
+                 new (engine_storage) Engine(engine);
+             });
+
+    engine_type = other.engine_type;
+    key_usage = other.key_usage;
+}
+
+/*
+ *  AESInline::DestroyEngine()
+ *
+ *  Description:
+ *      Destroy the engine held in the engine storage, which erases the key
+ *      schedule.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESInline::DestroyEngine() noexcept
+{
+    Dispatch(engine_type,
+             engine_storage,
+             [](auto &engine)
+             {
+                 using Engine = std::remove_cvref_t<decltype(engine)>;
+
+                 engine.~Engine();
+             });
+}
+
+} // namespace Terra::Crypto::Cipher
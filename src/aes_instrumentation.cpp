@@ -0,0 +1,165 @@
+/*
+ *  aes_instrumentation.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the functions that report the counts of work
+ *      performed by the library, along with the counters themselves when
+ *      TERRA_ENABLE_AES_INSTRUMENTATION is defined.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <terra/crypto/cipher/aes_instrumentation.h>
+#include "instrumentation.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// Ensure there is a set of counters for every engine type
+static_assert(static_cast<std::size_t>(AESEngineType::VectorPermute) + 1 ==
+              AES_Engine_Type_Count);
+
+#ifdef TERRA_ENABLE_AES_INSTRUMENTATION
+
+// Ensure there is a counter for every member of AESEngineCounters
+static_assert(static_cast<std::size_t>(AESCounter::StreamNanoseconds) + 1 ==
+              AES_Counter_Count);
+
+AESEngineCounterSet AES_Engine_Counters[AES_Engine_Type_Count]{};
+std::atomic<AESInstrumentationHook> AES_Instrumentation_Hook{nullptr};
+
+#endif
+
+/*
+ *  AESInstrumentationEnabled()
+ *
+ *  Description:
+ *      Indicate whether the library was built to count the work performed.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if instrumentation is enabled, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESInstrumentationEnabled() noexcept
+{
+#ifdef TERRA_ENABLE_AES_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ *  GetAESInstrumentation()
+ *
+ *  Description:
+ *      Return the current value of every counter for every engine.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The counters, indexed by the AESEngineType value.  All counters are
+ *      zero if instrumentation is not enabled.
+ *
+ *  Comments:
+ *      Each counter is read individually, so counts updated concurrently by
+ *      other threads may be reflected in some counters and not others.
+ */
+AESInstrumentationSnapshot GetAESInstrumentation() noexcept
+{
+    AESInstrumentationSnapshot snapshot{};
+
+#ifdef TERRA_ENABLE_AES_INSTRUMENTATION
+    for (std::size_t i = 0; i < AES_Engine_Type_Count; i++)
+    {
+        const auto &counters = AES_Engine_Counters[i].counters;
+        auto load = [&](AESCounter counter)
+        {
+            return counters[static_cast<std::size_t>(counter)].load(
+                std::memory_order_relaxed);
+        };
+
+        snapshot[i].blocks_encrypted = load(AESCounter::BlocksEncrypted);
+        snapshot[i].blocks_decrypted = load(AESCounter::BlocksDecrypted);
+        snapshot[i].key_setups = load(AESCounter::KeySetups);
+        snapshot[i].key_wraps = load(AESCounter::KeyWraps);
+        snapshot[i].key_unwraps = load(AESCounter::KeyUnwraps);
+        snapshot[i].integrity_failures = load(AESCounter::IntegrityFailures);
+        snapshot[i].stream_octets = load(AESCounter::StreamOctets);
+        snapshot[i].stream_nanoseconds = load(AESCounter::StreamNanoseconds);
+    }
+#endif
+
+    return snapshot;
+}
+
+/*
+ *  ResetAESInstrumentation()
+ *
+ *  Description:
+ *      Set every counter for every engine to zero.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ResetAESInstrumentation() noexcept
+{
+#ifdef TERRA_ENABLE_AES_INSTRUMENTATION
+    for (auto &engine_counters : AES_Engine_Counters)
+    {
+        for (auto &counter : engine_counters.counters)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+#endif
+}
+
+/*
+ *  SetAESInstrumentationHook()
+ *
+ *  Description:
+ *      Set the function to be called as each event is counted, such as to
+ *      forward counts to a metrics or tracing system.
+ *
+ *  Parameters:
+ *      hook [in]
+ *          The function to call, or nullptr to stop calling a function.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The hook is called on the thread performing the operation, after
+ *      the counter is updated, and may be called from several threads at
+ *      once.  It is never called if instrumentation is not enabled.
+ */
+void SetAESInstrumentationHook([[maybe_unused]] AESInstrumentationHook hook)
+    noexcept
+{
+#ifdef TERRA_ENABLE_AES_INSTRUMENTATION
+    AES_Instrumentation_Hook.store(hook, std::memory_order_relaxed);
+#endif
+}
+
+} // namespace Terra::Crypto::Cipher
@@ -30,10 +30,88 @@
 #include <terra/secutil/secure_erase.h>
 #include "aes_intel.h"
 #include "aes_tables.h"
+#include "aes_utilities.h"
 
 namespace Terra::Crypto::Cipher
 {
 
+namespace
+{
+
+// Round constants used in expanding the key, in the form aeskeygenassist uses
+constexpr int Key_Rcon[10] =
+{
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+};
+
+/*
+ *  KeyAssist()
+ *
+ *  Description:
+ *      Compute SubWord() of the last word of the given round key, placing
+ *      the result in all four words.  If Rotate is true, RotWord() is also
+ *      applied and the round constant is added.  This produces the same
+ *      value as the corresponding word of _mm_aeskeygenassist_si128().
+ *
+ *  Parameters:
+ *      round_key [in]
+ *          The round key whose last word is to be transformed.
+ *
+ *      rcon [in]
+ *          The round constant to add.  This should be zero if Rotate is
+ *          false.
+ *
+ *  Returns:
+ *      The transformed word, repeated in all four words.
+ *
+ *  Comments:
+ *      Since all four columns of the state are the same, ShiftRows has no
+ *      effect and aesenclast performs only SubBytes and the XOR with the
+ *      round constant.  Unlike aeskeygenassist, which on many processors
+ *      may only be issued every several cycles, aesenclast may be issued
+ *      every cycle, so the key expansion of several keys may be interleaved.
+ */
+template<bool Rotate>
+inline __m128i KeyAssist(const __m128i round_key, int rcon) noexcept
+{
+    __m128i word = _mm_shuffle_epi32(round_key, _MM_SHUFFLE(3, 3, 3, 3));
+
+    // RotWord() moves each octet to the next lower address
+    if constexpr (Rotate)
+    {
+        word = _mm_or_si128(_mm_srli_epi32(word, 8), _mm_slli_epi32(word, 24));
+    }
+
+    return _mm_aesenclast_si128(word, _mm_set1_epi32(rcon));
+}
+
+/*
+ *  PrefixXor()
+ *
+ *  Description:
+ *      XOR each word of the given round key with all of the words that
+ *      precede it, which is the chain of XORs performed in producing each
+ *      word of the next round key.
+ *
+ *  Parameters:
+ *      round_key [in]
+ *          The round key to transform.
+ *
+ *  Returns:
+ *      The transformed round key.
+ *
+ *  Comments:
+ *      None.
+ */
+inline __m128i PrefixXor(__m128i round_key) noexcept
+{
+    round_key = _mm_xor_si128(round_key, _mm_slli_si128(round_key, 4));
+
+    return _mm_xor_si128(round_key, _mm_slli_si128(round_key, 8));
+}
+
+} // namespace
+
 /*
  * AESIntel::AESIntel()
  *
@@ -57,11 +135,7 @@ AESIntel::AESIntel() noexcept :
     AESEngine(),
     Nr{},
     W{},
-    DW{},
-    T1{},
-    T2{},
-    T3{},
-    T4{}
+    DW{}
 {
     // Nothing to do
 }
@@ -164,10 +238,6 @@ AESIntel::~AESIntel()
     SecUtil::SecureErase(&Nr, sizeof(Nr));
     SecUtil::SecureErase(W, sizeof(W));
     SecUtil::SecureErase(DW, sizeof(DW));
-    SecUtil::SecureErase(&T1, sizeof(T1));
-    SecUtil::SecureErase(&T2, sizeof(T2));
-    SecUtil::SecureErase(&T3, sizeof(T3));
-    SecUtil::SecureErase(&T4, sizeof(T4));
 }
 
 /*
@@ -238,15 +308,27 @@ AESIntel &AESIntel::operator=(AESIntel &&other) noexcept
  *      key [in]
  *          The encryption key to use with this instance of the object.
  *
+ *      key_usage [in]
+ *          Indicates whether the key will be used for both encryption and
+ *          decryption or only for encryption.  If AESKeyUsage::EncryptOnly,
+ *          the decryption key schedule is not computed and Decrypt() and
+ *          DecryptBlocks() must not be called until the key is set again.
+ *
  *  Returns:
  *      Nothing, though an exception will be thrown if the key provided is not
  *      one of 16, 24, or 32 octets in length as required by the standard.
  *
  *  Comments:
- *      None.
+ *      The temporary variables used in key expansion are local to this
+ *      function and erased before it returns, so that they are not carried
+ *      in each engine object.
  */
-void AESIntel::SetKey(const std::span<const std::uint8_t> key)
+void AESIntel::SetKey(const std::span<const std::uint8_t> key,
+                      AESKeyUsage key_usage)
 {
+    // Temporary variables used in key expansion
+    __m128i T1{}, T2{}, T3{}, T4{};
+
     // Zero the key schedule
     SecUtil::SecureErase(W, sizeof(W));
     SecUtil::SecureErase(DW, sizeof(DW));
@@ -410,6 +492,36 @@ void AESIntel::SetKey(const std::span<const std::uint8_t> key)
             break;
     }
 
+    // Erase the key expansion temporaries
+    SecUtil::SecureErase(&T1, sizeof(T1));
+    SecUtil::SecureErase(&T2, sizeof(T2));
+    SecUtil::SecureErase(&T3, sizeof(T3));
+    SecUtil::SecureErase(&T4, sizeof(T4));
+
+    // The decryption round keys are not needed if only encrypting
+    if (key_usage == AESKeyUsage::EncryptOnly) return;
+
+    SetDecryptionKeys();
+}
+
+/*
+ * AESIntel::SetDecryptionKeys()
+ *
+ *  Description:
+ *      Compute the decryption round keys (DW) from the encryption round
+ *      keys (W).
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESIntel::SetDecryptionKeys() noexcept
+{
     // Populate decryption round key array (DW)
     DW[Nr] = W[0];
     DW[Nr - 1] = _mm_aesimc_si128(W[1]);
@@ -435,6 +547,229 @@ void AESIntel::SetKey(const std::span<const std::uint8_t> key)
     DW[0] = W[Nr];
 }
 
+/*
+ * AESIntel::SetKeys()
+ *
+ *  Description:
+ *      This function will set the key for each of the given engines,
+ *      expanding several keys at once where possible.
+ *
+ *  Parameters:
+ *      engines [in]
+ *          The engines whose keys are to be set.
+ *
+ *      keys [in]
+ *          The key for each engine, in the same order as the engines.
+ *
+ *      key_usage [in]
+ *          Indicates whether the keys will be used for both encryption and
+ *          decryption or only for encryption.  See SetKey().
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the number of keys
+ *      does not match the number of engines or if any key is not 16, 24, or
+ *      32 octets in length.  No engine is modified if an exception is thrown.
+ *
+ *  Comments:
+ *      Expanding a key is a serial chain of dependent operations, so a single
+ *      key leaves the processor mostly idle.  Groups of four consecutive keys
+ *      that are all 128 or 256 bits are expanded together, interleaving each
+ *      step of the four chains.  Any other key, including every 192-bit key,
+ *      is expanded individually via SetKey().  Rather than erasing the entire
+ *      key schedule first, only round keys not replaced by the new key
+ *      schedule are erased.
+ */
+void AESIntel::SetKeys(
+            const std::span<AESIntel * const> engines,
+            const std::span<const std::span<const std::uint8_t>> keys,
+            AESKeyUsage key_usage)
+{
+    std::size_t i{};
+
+    // There must be exactly one key for each engine
+    if (engines.size() != keys.size())
+    {
+        throw AESException("There must be one key for each engine");
+    }
+
+    // Verify all of the keys before modifying any engine
+    for (const auto &key : keys)
+    {
+        if ((key.size() != 16) && (key.size() != 24) && (key.size() != 32))
+        {
+            throw AESException("Invalid key length provided");
+        }
+    }
+
+    while (i < engines.size())
+    {
+        const std::size_t key_length = keys[i].size();
+        std::size_t count = 1;
+
+        // Count the consecutive keys having the same length
+        while ((count < Key_Expansion_Lanes) && (i + count < keys.size()) &&
+               (keys[i + count].size() == key_length))
+        {
+            count++;
+        }
+
+        // Expand this key alone if it cannot be expanded with others
+        if ((count < Key_Expansion_Lanes) || (key_length == 24))
+        {
+            engines[i]->AESIntel::SetKey(keys[i], key_usage);
+            i++;
+            continue;
+        }
+
+        if (key_length == 16)
+        {
+            ExpandKeys128(engines.data() + i, keys.data() + i);
+        }
+        else
+        {
+            ExpandKeys256(engines.data() + i, keys.data() + i);
+        }
+
+        for (std::size_t j = i; j < i + Key_Expansion_Lanes; j++)
+        {
+            AESIntel &engine = *engines[j];
+            const std::size_t unused = Max_Rounds - engine.Nr;
+
+            // Erase only the round keys the new key schedule does not replace
+            SecUtil::SecureErase(engine.W + engine.Nr + 1,
+                                 unused * sizeof(__m128i));
+
+            // The decryption round keys are not needed if only encrypting
+            if (key_usage == AESKeyUsage::EncryptOnly)
+            {
+                SecUtil::SecureErase(engine.DW, sizeof(engine.DW));
+                continue;
+            }
+
+            engine.SetDecryptionKeys();
+            SecUtil::SecureErase(engine.DW + engine.Nr + 1,
+                                 unused * sizeof(__m128i));
+        }
+
+        i += Key_Expansion_Lanes;
+    }
+}
+
+/*
+ * AESIntel::ExpandKeys128()
+ *
+ *  Description:
+ *      Compute the encryption round keys (W) for four 128-bit keys at once.
+ *
+ *  Parameters:
+ *      engines [in]
+ *          The four engines whose round keys are to be computed.
+ *
+ *      keys [in]
+ *          The four 16-octet keys.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Each step computes W[i] = PrefixXor(W[i - 1]) ^ the transformed last
+ *      word of W[i - 1], which is equivalent to the four steps of the key
+ *      expansion in Section 5.2 of FIPS 197 that produce the next four
+ *      words.
+ */
+void AESIntel::ExpandKeys128(
+            AESIntel * const *engines,
+            const std::span<const std::uint8_t> *keys) noexcept
+{
+    __m128i K[Key_Expansion_Lanes];
+
+    ForEachLane<Key_Expansion_Lanes>([&](auto lane)
+    {
+        engines[lane]->Nr = 10;
+        K[lane] = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i *>(keys[lane].data()));
+        engines[lane]->W[0] = K[lane];
+    });
+
+    for (std::size_t i = 1; i <= 10; i++)
+    {
+        ForEachLane<Key_Expansion_Lanes>([&](auto lane)
+        {
+            K[lane] = _mm_xor_si128(PrefixXor(K[lane]),
+                                    KeyAssist<true>(K[lane], Key_Rcon[i - 1]));
+            engines[lane]->W[i] = K[lane];
+        });
+    }
+
+    // Erase the temporary key material
+    SecUtil::SecureErase(K, sizeof(K));
+}
+
+/*
+ * AESIntel::ExpandKeys256()
+ *
+ *  Description:
+ *      Compute the encryption round keys (W) for four 256-bit keys at once.
+ *
+ *  Parameters:
+ *      engines [in]
+ *          The four engines whose round keys are to be computed.
+ *
+ *      keys [in]
+ *          The four 32-octet keys.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Each even round key is computed from the two before it using
+ *      RotWord(), SubWord(), and the round constant, while each odd round
+ *      key uses only SubWord(), per Section 5.2 of FIPS 197.
+ */
+void AESIntel::ExpandKeys256(
+            AESIntel * const *engines,
+            const std::span<const std::uint8_t> *keys) noexcept
+{
+    __m128i A[Key_Expansion_Lanes];
+    __m128i B[Key_Expansion_Lanes];
+
+    ForEachLane<Key_Expansion_Lanes>([&](auto lane)
+    {
+        engines[lane]->Nr = 14;
+        A[lane] = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i *>(keys[lane].data()));
+        B[lane] = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(keys[lane].data() + 16));
+        engines[lane]->W[0] = A[lane];
+        engines[lane]->W[1] = B[lane];
+    });
+
+    for (std::size_t i = 2; i <= 14; i += 2)
+    {
+        ForEachLane<Key_Expansion_Lanes>([&](auto lane)
+        {
+            A[lane] = _mm_xor_si128(
+                PrefixXor(A[lane]),
+                KeyAssist<true>(B[lane], Key_Rcon[(i / 2) - 1]));
+            engines[lane]->W[i] = A[lane];
+        });
+
+        // The last round key is W[14]
+        if (i == 14) break;
+
+        ForEachLane<Key_Expansion_Lanes>([&](auto lane)
+        {
+            B[lane] = _mm_xor_si128(PrefixXor(B[lane]),
+                                    KeyAssist<false>(A[lane], 0));
+            engines[lane]->W[i + 1] = B[lane];
+        });
+    }
+
+    // Erase the temporary key material
+    SecUtil::SecureErase(A, sizeof(A));
+    SecUtil::SecureErase(B, sizeof(B));
+}
+
 /*
  * AESIntel::ClearKeyState()
  *
@@ -455,10 +790,6 @@ void AESIntel::ClearKeyState()
     SecUtil::SecureErase(&Nr, sizeof(Nr));
     SecUtil::SecureErase(W, sizeof(W));
     SecUtil::SecureErase(DW, sizeof(DW));
-    SecUtil::SecureErase(&T1, sizeof(T1));
-    SecUtil::SecureErase(&T2, sizeof(T2));
-    SecUtil::SecureErase(&T3, sizeof(T3));
-    SecUtil::SecureErase(&T4, sizeof(T4));
 }
 
 /*
@@ -484,43 +815,44 @@ void AESIntel::ClearKeyState()
  *      None.
  */
 void AESIntel::Encrypt(
-                const std::span<const std::uint8_t, AES_Block_Size> plaintext,
-                std::span<std::uint8_t, AES_Block_Size> ciphertext) noexcept
+            const std::span<const std::uint8_t, AES_Block_Size> plaintext,
+            std::span<std::uint8_t, AES_Block_Size> ciphertext) const noexcept
 {
     // Step 1 - AddRoundKey() (i.e., XOR with W[0])
-    T1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plaintext.data()));
-    T1 = _mm_xor_si128(T1, W[0]);
+    __m128i B =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(plaintext.data()));
+    B = _mm_xor_si128(B, W[0]);
 
     // Step 2 - Rounds 1 to Nr - 1
-    T1 = _mm_aesenc_si128(T1, W[1]);
-    T1 = _mm_aesenc_si128(T1, W[2]);
-    T1 = _mm_aesenc_si128(T1, W[3]);
-    T1 = _mm_aesenc_si128(T1, W[4]);
-    T1 = _mm_aesenc_si128(T1, W[5]);
-    T1 = _mm_aesenc_si128(T1, W[6]);
-    T1 = _mm_aesenc_si128(T1, W[7]);
-    T1 = _mm_aesenc_si128(T1, W[8]);
-    T1 = _mm_aesenc_si128(T1, W[9]);
+    B = _mm_aesenc_si128(B, W[1]);
+    B = _mm_aesenc_si128(B, W[2]);
+    B = _mm_aesenc_si128(B, W[3]);
+    B = _mm_aesenc_si128(B, W[4]);
+    B = _mm_aesenc_si128(B, W[5]);
+    B = _mm_aesenc_si128(B, W[6]);
+    B = _mm_aesenc_si128(B, W[7]);
+    B = _mm_aesenc_si128(B, W[8]);
+    B = _mm_aesenc_si128(B, W[9]);
 
     // If Nr > 10 implies either AES-192 or AES-256
     if (Nr > 10)
     {
-        T1 = _mm_aesenc_si128(T1, W[10]);
-        T1 = _mm_aesenc_si128(T1, W[11]);
+        B = _mm_aesenc_si128(B, W[10]);
+        B = _mm_aesenc_si128(B, W[11]);
 
         // Nr > 12 implies AES-256
         if (Nr > 12)
         {
-            T1 = _mm_aesenc_si128(T1, W[12]);
-            T1 = _mm_aesenc_si128(T1, W[13]);
+            B = _mm_aesenc_si128(B, W[12]);
+            B = _mm_aesenc_si128(B, W[13]);
         }
     }
 
     // Step 3 - Final round
-    T1 = _mm_aesenclast_si128(T1, W[Nr]);
+    B = _mm_aesenclast_si128(B, W[Nr]);
 
     // Store the result in the ciphertext buffer
-    _mm_storeu_si128(reinterpret_cast<__m128i *>(ciphertext.data()), T1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(ciphertext.data()), B);
 }
 
 /*
@@ -546,43 +878,779 @@ void AESIntel::Encrypt(
  *      None.
  */
 void AESIntel::Decrypt(
-                const std::span<const std::uint8_t, AES_Block_Size> ciphertext,
-                std::span<std::uint8_t, AES_Block_Size> plaintext) noexcept
+            const std::span<const std::uint8_t, AES_Block_Size> ciphertext,
+            std::span<std::uint8_t, AES_Block_Size> plaintext) const noexcept
 {
     // Step 1 - AddRoundKey() (i.e., XOR with W[0])
-    T1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ciphertext.data()));
-    T1 = _mm_xor_si128(T1, DW[0]);
+    __m128i B =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(ciphertext.data()));
+    B = _mm_xor_si128(B, DW[0]);
 
     // Step 2 - Rounds 1 to Nr - 1
-    T1 = _mm_aesdec_si128(T1, DW[1]);
-    T1 = _mm_aesdec_si128(T1, DW[2]);
-    T1 = _mm_aesdec_si128(T1, DW[3]);
-    T1 = _mm_aesdec_si128(T1, DW[4]);
-    T1 = _mm_aesdec_si128(T1, DW[5]);
-    T1 = _mm_aesdec_si128(T1, DW[6]);
-    T1 = _mm_aesdec_si128(T1, DW[7]);
-    T1 = _mm_aesdec_si128(T1, DW[8]);
-    T1 = _mm_aesdec_si128(T1, DW[9]);
+    B = _mm_aesdec_si128(B, DW[1]);
+    B = _mm_aesdec_si128(B, DW[2]);
+    B = _mm_aesdec_si128(B, DW[3]);
+    B = _mm_aesdec_si128(B, DW[4]);
+    B = _mm_aesdec_si128(B, DW[5]);
+    B = _mm_aesdec_si128(B, DW[6]);
+    B = _mm_aesdec_si128(B, DW[7]);
+    B = _mm_aesdec_si128(B, DW[8]);
+    B = _mm_aesdec_si128(B, DW[9]);
 
     // If Nr > 10 implies either AES-192 or AES-256
     if (Nr > 10)
     {
-        T1 = _mm_aesdec_si128(T1, DW[10]);
-        T1 = _mm_aesdec_si128(T1, DW[11]);
+        B = _mm_aesdec_si128(B, DW[10]);
+        B = _mm_aesdec_si128(B, DW[11]);
 
         // Nr > 12 implies AES-256
         if (Nr > 12)
         {
-            T1 = _mm_aesdec_si128(T1, DW[12]);
-            T1 = _mm_aesdec_si128(T1, DW[13]);
+            B = _mm_aesdec_si128(B, DW[12]);
+            B = _mm_aesdec_si128(B, DW[13]);
         }
     }
 
     // Step 3 - Final round
-    T1 = _mm_aesdeclast_si128(T1, DW[Nr]);
+    B = _mm_aesdeclast_si128(B, DW[Nr]);
 
     // Store the result in the ciphertext buffer
-    _mm_storeu_si128(reinterpret_cast<__m128i *>(plaintext.data()), T1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(plaintext.data()), B);
+}
+
+/*
+ * AESIntel::EncryptRounds()
+ *
+ *  Description:
+ *      This function will encrypt a series of plaintext blocks using a key
+ *      schedule with the number of rounds given as the template parameter.
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The data to encrypt.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks, which may refer to the same memory
+ *          location as the plaintext.
+ *
+ *      blocks [in]
+ *          The number of 16-octet blocks to encrypt.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      The aesenc instruction has a latency of several cycles, but the
+ *      processor can issue one or two per cycle.  Encrypting a single block
+ *      leaves the pipeline mostly idle, so this function interleaves the
+ *      rounds of eight independent blocks (then four, two, and one for any
+ *      remaining blocks) so that each round key is applied to all blocks
+ *      before moving to the next round.  Since the number of rounds is
+ *      known at compile time, the rounds are fully unrolled and the round
+ *      keys are loaded once, allowing the compiler to hold them in
+ *      registers across all of the blocks.  The local copy of the round
+ *      keys is erased before returning.
+ */
+template<std::size_t Rounds>
+void AESIntel::EncryptRounds(const std::uint8_t *plaintext,
+                             std::uint8_t *ciphertext,
+                             std::size_t blocks) const noexcept
+{
+    const std::uint8_t *p = plaintext;
+    std::uint8_t *c = ciphertext;
+    __m128i K[Rounds + 1];
+    __m128i B0, B1, B2, B3, B4, B5, B6, B7;
+
+    // Load the round keys once for all blocks
+    std::copy(W, W + Rounds + 1, K);
+
+    // Load a block and perform AddRoundKey() (i.e., XOR with K[0])
+    auto Load = [&](const std::uint8_t *in)
+    {
+        return _mm_xor_si128(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), K[0]);
+    };
+
+    // Perform the final round and store the block
+    auto Store = [&](std::uint8_t *out, const __m128i &block)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                         _mm_aesenclast_si128(block, K[Rounds]));
+    };
+
+    // Encrypt eight blocks at a time
+    for (; blocks >= 8; blocks -= 8, p += 128, c += 128)
+    {
+        // Step 1 - AddRoundKey()
+        B0 = Load(p);
+        B1 = Load(p + 16);
+        B2 = Load(p + 32);
+        B3 = Load(p + 48);
+        B4 = Load(p + 64);
+        B5 = Load(p + 80);
+        B6 = Load(p + 96);
+        B7 = Load(p + 112);
+
+        // Step 2 - Rounds 1 to Nr - 1
+        ForEachRound<Rounds>([&](auto round)
+        {
+            B0 = _mm_aesenc_si128(B0, K[round]);
+            B1 = _mm_aesenc_si128(B1, K[round]);
+            B2 = _mm_aesenc_si128(B2, K[round]);
+            B3 = _mm_aesenc_si128(B3, K[round]);
+            B4 = _mm_aesenc_si128(B4, K[round]);
+            B5 = _mm_aesenc_si128(B5, K[round]);
+            B6 = _mm_aesenc_si128(B6, K[round]);
+            B7 = _mm_aesenc_si128(B7, K[round]);
+        });
+
+        // Step 3 - Final round, storing the results
+        Store(c, B0);
+        Store(c + 16, B1);
+        Store(c + 32, B2);
+        Store(c + 48, B3);
+        Store(c + 64, B4);
+        Store(c + 80, B5);
+        Store(c + 96, B6);
+        Store(c + 112, B7);
+    }
+
+    // Encrypt four blocks if at least that many remain
+    if (blocks >= 4)
+    {
+        B0 = Load(p);
+        B1 = Load(p + 16);
+        B2 = Load(p + 32);
+        B3 = Load(p + 48);
+
+        ForEachRound<Rounds>([&](auto round)
+        {
+            B0 = _mm_aesenc_si128(B0, K[round]);
+            B1 = _mm_aesenc_si128(B1, K[round]);
+            B2 = _mm_aesenc_si128(B2, K[round]);
+            B3 = _mm_aesenc_si128(B3, K[round]);
+        });
+
+        Store(c, B0);
+        Store(c + 16, B1);
+        Store(c + 32, B2);
+        Store(c + 48, B3);
+
+        blocks -= 4;
+        p += 64;
+        c += 64;
+    }
+
+    // Encrypt two blocks if at least that many remain
+    if (blocks >= 2)
+    {
+        B0 = Load(p);
+        B1 = Load(p + 16);
+
+        ForEachRound<Rounds>([&](auto round)
+        {
+            B0 = _mm_aesenc_si128(B0, K[round]);
+            B1 = _mm_aesenc_si128(B1, K[round]);
+        });
+
+        Store(c, B0);
+        Store(c + 16, B1);
+
+        blocks -= 2;
+        p += 32;
+        c += 32;
+    }
+
+    // Encrypt any remaining block
+    for (; blocks > 0; blocks--, p += 16, c += 16)
+    {
+        B0 = Load(p);
+
+        ForEachRound<Rounds>([&](auto round)
+        {
+            B0 = _mm_aesenc_si128(B0, K[round]);
+        });
+
+        Store(c, B0);
+    }
+
+    // Erase the copy of the round keys
+    SecUtil::SecureErase(K, sizeof(K));
+}
+
+/*
+ * AESIntel::DecryptRounds()
+ *
+ *  Description:
+ *      This function will decrypt a series of ciphertext blocks using a key
+ *      schedule with the number of rounds given as the template parameter.
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The data to decrypt.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks, which may refer to the same memory
+ *          location as the ciphertext.
+ *
+ *      blocks [in]
+ *          The number of 16-octet blocks to decrypt.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      See the comments for EncryptRounds().
+ */
+template<std::size_t Rounds>
+void AESIntel::DecryptRounds(const std::uint8_t *ciphertext,
+                             std::uint8_t *plaintext,
+                             std::size_t blocks) const noexcept
+{
+    const std::uint8_t *c = ciphertext;
+    std::uint8_t *p = plaintext;
+    __m128i K[Rounds + 1];
+    __m128i B0, B1, B2, B3, B4, B5, B6, B7;
+
+    // Load the round keys once for all blocks
+    std::copy(DW, DW + Rounds + 1, K);
+
+    // Load a block and perform AddRoundKey() (i.e., XOR with K[0])
+    auto Load = [&](const std::uint8_t *in)
+    {
+        return _mm_xor_si128(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), K[0]);
+    };
+
+    // Perform the final round and store the block
+    auto Store = [&](std::uint8_t *out, const __m128i &block)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                         _mm_aesdeclast_si128(block, K[Rounds]));
+    };
+
+    // Decrypt eight blocks at a time
+    for (; blocks >= 8; blocks -= 8, c += 128, p += 128)
+    {
+        // Step 1 - AddRoundKey()
+        B0 = Load(c);
+        B1 = Load(c + 16);
+        B2 = Load(c + 32);
+        B3 = Load(c + 48);
+        B4 = Load(c + 64);
+        B5 = Load(c + 80);
+        B6 = Load(c + 96);
+        B7 = Load(c + 112);
+
+        // Step 2 - Rounds 1 to Nr - 1
+        ForEachRound<Rounds>([&](auto round)
+        {
+            B0 = _mm_aesdec_si128(B0, K[round]);
+            B1 = _mm_aesdec_si128(B1, K[round]);
+            B2 = _mm_aesdec_si128(B2, K[round]);
+            B3 = _mm_aesdec_si128(B3, K[round]);
+            B4 = _mm_aesdec_si128(B4, K[round]);
+            B5 = _mm_aesdec_si128(B5, K[round]);
+            B6 = _mm_aesdec_si128(B6, K[round]);
+            B7 = _mm_aesdec_si128(B7, K[round]);
+        });
+
+        // Step 3 - Final round, storing the results
+        Store(p, B0);
+        Store(p + 16, B1);
+        Store(p + 32, B2);
+        Store(p + 48, B3);
+        Store(p + 64, B4);
+        Store(p + 80, B5);
+        Store(p + 96, B6);
+        Store(p + 112, B7);
+    }
+
+    // Decrypt four blocks if at least that many remain
+    if (blocks >= 4)
+    {
+        B0 = Load(c);
+        B1 = Load(c + 16);
+        B2 = Load(c + 32);
+        B3 = Load(c + 48);
+
+        ForEachRound<Rounds>([&](auto round)
+        {
+            B0 = _mm_aesdec_si128(B0, K[round]);
+            B1 = _mm_aesdec_si128(B1, K[round]);
+            B2 = _mm_aesdec_si128(B2, K[round]);
+            B3 = _mm_aesdec_si128(B3, K[round]);
+        });
+
+        Store(p, B0);
+        Store(p + 16, B1);
+        Store(p + 32, B2);
+        Store(p + 48, B3);
+
+        blocks -= 4;
+        c += 64;
+        p += 64;
+    }
+
+    // Decrypt two blocks if at least that many remain
+    if (blocks >= 2)
+    {
+        B0 = Load(c);
+        B1 = Load(c + 16);
+
+        ForEachRound<Rounds>([&](auto round)
+        {
+            B0 = _mm_aesdec_si128(B0, K[round]);
+            B1 = _mm_aesdec_si128(B1, K[round]);
+        });
+
+        Store(p, B0);
+        Store(p + 16, B1);
+
+        blocks -= 2;
+        c += 32;
+        p += 32;
+    }
+
+    // Decrypt any remaining block
+    for (; blocks > 0; blocks--, c += 16, p += 16)
+    {
+        B0 = Load(c);
+
+        ForEachRound<Rounds>([&](auto round)
+        {
+            B0 = _mm_aesdec_si128(B0, K[round]);
+        });
+
+        Store(p, B0);
+    }
+
+    // Erase the copy of the round keys
+    SecUtil::SecureErase(K, sizeof(K));
+}
+
+/*
+ * AESIntel::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a series of plaintext blocks and return the
+ *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The data to encrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      The number of rounds is checked once here, rather than for every
+ *      block, to select the specialization of EncryptRounds() for the key
+ *      size.
+ */
+void AESIntel::EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                             std::span<std::uint8_t> ciphertext) const noexcept
+{
+    const std::size_t blocks = plaintext.size() / AES_Block_Size;
+
+    switch (Nr)
+    {
+        case 10:
+            EncryptRounds<10>(plaintext.data(), ciphertext.data(), blocks);
+            break;
+
+        case 12:
+            EncryptRounds<12>(plaintext.data(), ciphertext.data(), blocks);
+            break;
+
+        default:
+            EncryptRounds<14>(plaintext.data(), ciphertext.data(), blocks);
+            break;
+    }
+}
+
+/*
+ * AESIntel::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a series of ciphertext blocks and return the
+ *      plaintext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The data to decrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      See the comments for EncryptBlocks().
+ */
+void AESIntel::DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                             std::span<std::uint8_t> plaintext) const noexcept
+{
+    const std::size_t blocks = ciphertext.size() / AES_Block_Size;
+
+    switch (Nr)
+    {
+        case 10:
+            DecryptRounds<10>(ciphertext.data(), plaintext.data(), blocks);
+            break;
+
+        case 12:
+            DecryptRounds<12>(ciphertext.data(), plaintext.data(), blocks);
+            break;
+
+        default:
+            DecryptRounds<14>(ciphertext.data(), plaintext.data(), blocks);
+            break;
+    }
+}
+
+/*
+ * AESIntel::EncryptMultiKeyRounds()
+ *
+ *  Description:
+ *      This function will encrypt eight blocks of plaintext, each using a
+ *      different key schedule with the number of rounds given as the
+ *      template parameter.
+ *
+ *  Parameters:
+ *      engines [in]
+ *          The eight engines holding the key schedules.
+ *
+ *      plaintext [in]
+ *          The eight blocks to encrypt, one for each engine in order.
+ *
+ *      ciphertext [out]
+ *          The eight encrypted blocks, which may refer to the same memory
+ *          location as the plaintext.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      As with EncryptRounds(), the rounds of the eight blocks are
+ *      interleaved so that eight independent aesenc chains are in flight.
+ */
+template<std::size_t Rounds>
+void AESIntel::EncryptMultiKeyRounds(const AESIntel * const *engines,
+                                     const std::uint8_t *plaintext,
+                                     std::uint8_t *ciphertext) noexcept
+{
+    const __m128i *K0 = engines[0]->W;
+    const __m128i *K1 = engines[1]->W;
+    const __m128i *K2 = engines[2]->W;
+    const __m128i *K3 = engines[3]->W;
+    const __m128i *K4 = engines[4]->W;
+    const __m128i *K5 = engines[5]->W;
+    const __m128i *K6 = engines[6]->W;
+    const __m128i *K7 = engines[7]->W;
+
+    // Load a block and perform AddRoundKey() with the given key
+    auto Load = [&](std::size_t offset, const __m128i &key)
+    {
+        return _mm_xor_si128(
+            _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(plaintext + offset)),
+            key);
+    };
+
+    // Perform the final round with the given key and store the block
+    auto Store = [&](std::size_t offset,
+                     const __m128i &block,
+                     const __m128i &key)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(ciphertext + offset),
+                         _mm_aesenclast_si128(block, key));
+    };
+
+    // Step 1 - AddRoundKey()
+    __m128i B0 = Load(0, K0[0]);
+    __m128i B1 = Load(16, K1[0]);
+    __m128i B2 = Load(32, K2[0]);
+    __m128i B3 = Load(48, K3[0]);
+    __m128i B4 = Load(64, K4[0]);
+    __m128i B5 = Load(80, K5[0]);
+    __m128i B6 = Load(96, K6[0]);
+    __m128i B7 = Load(112, K7[0]);
+
+    // Step 2 - Rounds 1 to Nr - 1
+    ForEachRound<Rounds>([&](auto round)
+    {
+        B0 = _mm_aesenc_si128(B0, K0[round]);
+        B1 = _mm_aesenc_si128(B1, K1[round]);
+        B2 = _mm_aesenc_si128(B2, K2[round]);
+        B3 = _mm_aesenc_si128(B3, K3[round]);
+        B4 = _mm_aesenc_si128(B4, K4[round]);
+        B5 = _mm_aesenc_si128(B5, K5[round]);
+        B6 = _mm_aesenc_si128(B6, K6[round]);
+        B7 = _mm_aesenc_si128(B7, K7[round]);
+    });
+
+    // Step 3 - Final round, storing the results
+    Store(0, B0, K0[Rounds]);
+    Store(16, B1, K1[Rounds]);
+    Store(32, B2, K2[Rounds]);
+    Store(48, B3, K3[Rounds]);
+    Store(64, B4, K4[Rounds]);
+    Store(80, B5, K5[Rounds]);
+    Store(96, B6, K6[Rounds]);
+    Store(112, B7, K7[Rounds]);
+}
+
+/*
+ * AESIntel::DecryptMultiKeyRounds()
+ *
+ *  Description:
+ *      This function will decrypt eight blocks of ciphertext, each using a
+ *      different key schedule with the number of rounds given as the
+ *      template parameter.
+ *
+ *  Parameters:
+ *      engines [in]
+ *          The eight engines holding the key schedules.
+ *
+ *      ciphertext [in]
+ *          The eight blocks to decrypt, one for each engine in order.
+ *
+ *      plaintext [out]
+ *          The eight decrypted blocks, which may refer to the same memory
+ *          location as the ciphertext.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      See the comments for EncryptMultiKeyRounds().
+ */
+template<std::size_t Rounds>
+void AESIntel::DecryptMultiKeyRounds(const AESIntel * const *engines,
+                                     const std::uint8_t *ciphertext,
+                                     std::uint8_t *plaintext) noexcept
+{
+    const __m128i *K0 = engines[0]->DW;
+    const __m128i *K1 = engines[1]->DW;
+    const __m128i *K2 = engines[2]->DW;
+    const __m128i *K3 = engines[3]->DW;
+    const __m128i *K4 = engines[4]->DW;
+    const __m128i *K5 = engines[5]->DW;
+    const __m128i *K6 = engines[6]->DW;
+    const __m128i *K7 = engines[7]->DW;
+
+    // Load a block and perform AddRoundKey() with the given key
+    auto Load = [&](std::size_t offset, const __m128i &key)
+    {
+        return _mm_xor_si128(
+            _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(ciphertext + offset)),
+            key);
+    };
+
+    // Perform the final round with the given key and store the block
+    auto Store = [&](std::size_t offset,
+                     const __m128i &block,
+                     const __m128i &key)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(plaintext + offset),
+                         _mm_aesdeclast_si128(block, key));
+    };
+
+    // Step 1 - AddRoundKey()
+    __m128i B0 = Load(0, K0[0]);
+    __m128i B1 = Load(16, K1[0]);
+    __m128i B2 = Load(32, K2[0]);
+    __m128i B3 = Load(48, K3[0]);
+    __m128i B4 = Load(64, K4[0]);
+    __m128i B5 = Load(80, K5[0]);
+    __m128i B6 = Load(96, K6[0]);
+    __m128i B7 = Load(112, K7[0]);
+
+    // Step 2 - Rounds 1 to Nr - 1
+    ForEachRound<Rounds>([&](auto round)
+    {
+        B0 = _mm_aesdec_si128(B0, K0[round]);
+        B1 = _mm_aesdec_si128(B1, K1[round]);
+        B2 = _mm_aesdec_si128(B2, K2[round]);
+        B3 = _mm_aesdec_si128(B3, K3[round]);
+        B4 = _mm_aesdec_si128(B4, K4[round]);
+        B5 = _mm_aesdec_si128(B5, K5[round]);
+        B6 = _mm_aesdec_si128(B6, K6[round]);
+        B7 = _mm_aesdec_si128(B7, K7[round]);
+    });
+
+    // Step 3 - Final round, storing the results
+    Store(0, B0, K0[Rounds]);
+    Store(16, B1, K1[Rounds]);
+    Store(32, B2, K2[Rounds]);
+    Store(48, B3, K3[Rounds]);
+    Store(64, B4, K4[Rounds]);
+    Store(80, B5, K5[Rounds]);
+    Store(96, B6, K6[Rounds]);
+    Store(112, B7, K7[Rounds]);
+}
+
+/*
+ * AESIntel::EncryptMultiKey()
+ *
+ *  Description:
+ *      This function will encrypt eight blocks of plaintext, each using the
+ *      key schedule held by a different engine.
+ *
+ *  Parameters:
+ *      engines [in]
+ *          The eight engines holding the key schedules.  The same engine may
+ *          appear more than once.
+ *
+ *      plaintext [in]
+ *          The eight blocks to encrypt, one for each engine in order.
+ *
+ *      ciphertext [out]
+ *          The eight encrypted blocks.  This span may refer to the same
+ *          memory location as the plaintext span.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      The blocks are encrypted in lockstep only if all of the keys are the
+ *      same length.  Otherwise, each block is encrypted individually.
+ */
+void AESIntel::EncryptMultiKey(
+        const std::span<const AESIntel * const, Multi_Key_Lanes> engines,
+        const std::span<const std::uint8_t, Multi_Key_Size> plaintext,
+        std::span<std::uint8_t, Multi_Key_Size> ciphertext) noexcept
+{
+    const std::size_t rounds = engines[0]->Nr;
+
+    // Encrypt individually if the keys are not all the same length
+    if (std::any_of(engines.begin(),
+                    engines.end(),
+                    [&](const AESIntel *engine)
+                    {
+                        return engine->Nr != rounds;
+                    }))
+    {
+        for (std::size_t i = 0; i < Multi_Key_Lanes; i++)
+        {
+            engines[i]->AESIntel::Encrypt(
+                plaintext.subspan(i * AES_Block_Size).first<AES_Block_Size>(),
+                ciphertext.subspan(i * AES_Block_Size).first<AES_Block_Size>());
+        }
+
+        return;
+    }
+
+    switch (rounds)
+    {
+        case 10:
+            EncryptMultiKeyRounds<10>(engines.data(),
+                                      plaintext.data(),
+                                      ciphertext.data());
+            break;
+
+        case 12:
+            EncryptMultiKeyRounds<12>(engines.data(),
+                                      plaintext.data(),
+                                      ciphertext.data());
+            break;
+
+        default:
+            EncryptMultiKeyRounds<14>(engines.data(),
+                                      plaintext.data(),
+                                      ciphertext.data());
+            break;
+    }
+}
+
+/*
+ * AESIntel::DecryptMultiKey()
+ *
+ *  Description:
+ *      This function will decrypt eight blocks of ciphertext, each using the
+ *      key schedule held by a different engine.
+ *
+ *  Parameters:
+ *      engines [in]
+ *          The eight engines holding the key schedules.  The same engine may
+ *          appear more than once.
+ *
+ *      ciphertext [in]
+ *          The eight blocks to decrypt, one for each engine in order.
+ *
+ *      plaintext [out]
+ *          The eight decrypted blocks.  This span may refer to the same
+ *          memory location as the ciphertext span.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      See the comments for EncryptMultiKey().
+ */
+void AESIntel::DecryptMultiKey(
+        const std::span<const AESIntel * const, Multi_Key_Lanes> engines,
+        const std::span<const std::uint8_t, Multi_Key_Size> ciphertext,
+        std::span<std::uint8_t, Multi_Key_Size> plaintext) noexcept
+{
+    const std::size_t rounds = engines[0]->Nr;
+
+    // Decrypt individually if the keys are not all the same length
+    if (std::any_of(engines.begin(),
+                    engines.end(),
+                    [&](const AESIntel *engine)
+                    {
+                        return engine->Nr != rounds;
+                    }))
+    {
+        for (std::size_t i = 0; i < Multi_Key_Lanes; i++)
+        {
+            engines[i]->AESIntel::Decrypt(
+                ciphertext.subspan(i * AES_Block_Size).first<AES_Block_Size>(),
+                plaintext.subspan(i * AES_Block_Size).first<AES_Block_Size>());
+        }
+
+        return;
+    }
+
+    switch (rounds)
+    {
+        case 10:
+            DecryptMultiKeyRounds<10>(engines.data(),
+                                      ciphertext.data(),
+                                      plaintext.data());
+            break;
+
+        case 12:
+            DecryptMultiKeyRounds<12>(engines.data(),
+                                      ciphertext.data(),
+                                      plaintext.data());
+            break;
+
+        default:
+            DecryptMultiKeyRounds<14>(engines.data(),
+                                      ciphertext.data(),
+                                      plaintext.data());
+            break;
+    }
 }
 
 /*
@@ -57,6 +57,16 @@ class AESIntel : public AESEngine
         static constexpr std::size_t Max_Rounds{14};
 
     public:
+        // Number of keys used by EncryptMultiKey() and DecryptMultiKey()
+        static constexpr std::size_t Multi_Key_Lanes{8};
+
+        // Octets of data processed by EncryptMultiKey() and DecryptMultiKey()
+        static constexpr std::size_t Multi_Key_Size{Multi_Key_Lanes *
+                                                    AES_Block_Size};
+
+        // Number of keys expanded together by SetKeys()
+        static constexpr std::size_t Key_Expansion_Lanes{4};
+
         AESIntel() noexcept;
         AESIntel(const std::span<const std::uint8_t> key);
         AESIntel(const AESIntel &other) noexcept;
@@ -73,20 +83,77 @@ class AESIntel : public AESEngine
             return AESEngineType::Unavailable;
         }
 
-        void SetKey(const std::span<const std::uint8_t> key) override;
+        void SetKey(
+            const std::span<const std::uint8_t> key,
+            AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt) override;
+
+        static void SetKeys(
+            const std::span<AESIntel * const> engines,
+            const std::span<const std::span<const std::uint8_t>> keys,
+            AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt);
 
         void ClearKeyState() override;
 
         void Encrypt(const std::span<const std::uint8_t, 16> plaintext,
-                     std::span<std::uint8_t, 16> ciphertext) noexcept override;
+                     std::span<std::uint8_t, 16> ciphertext) const noexcept
+            override;
 
         void Decrypt(const std::span<const std::uint8_t, 16> ciphertext,
-                     std::span<std::uint8_t, 16> plaintext) noexcept override;
+                     std::span<std::uint8_t, 16> plaintext) const noexcept
+            override;
+
+        void EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const noexcept
+            override;
+
+        void DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const noexcept
+            override;
+
+        static void EncryptMultiKey(
+            const std::span<const AESIntel * const, Multi_Key_Lanes> engines,
+            const std::span<const std::uint8_t, Multi_Key_Size> plaintext,
+            std::span<std::uint8_t, Multi_Key_Size> ciphertext) noexcept;
+
+        static void DecryptMultiKey(
+            const std::span<const AESIntel * const, Multi_Key_Lanes> engines,
+            const std::span<const std::uint8_t, Multi_Key_Size> ciphertext,
+            std::span<std::uint8_t, Multi_Key_Size> plaintext) noexcept;
 
         bool operator==(const AESIntel &other) const;
         bool operator!=(const AESIntel &other) const;
 
     protected:
+        void SetDecryptionKeys() noexcept;
+
+        static void ExpandKeys128(
+            AESIntel * const *engines,
+            const std::span<const std::uint8_t> *keys) noexcept;
+
+        static void ExpandKeys256(
+            AESIntel * const *engines,
+            const std::span<const std::uint8_t> *keys) noexcept;
+
+        template<std::size_t Rounds>
+        static void EncryptMultiKeyRounds(const AESIntel * const *engines,
+                                          const std::uint8_t *plaintext,
+                                          std::uint8_t *ciphertext) noexcept;
+
+        template<std::size_t Rounds>
+        static void DecryptMultiKeyRounds(const AESIntel * const *engines,
+                                          const std::uint8_t *ciphertext,
+                                          std::uint8_t *plaintext) noexcept;
+
+        template<std::size_t Rounds>
+        void EncryptRounds(const std::uint8_t *plaintext,
+                           std::uint8_t *ciphertext,
+                           std::size_t blocks) const noexcept;
+
+        template<std::size_t Rounds>
+        void DecryptRounds(const std::uint8_t *ciphertext,
+                           std::uint8_t *plaintext,
+                           std::size_t blocks) const noexcept;
+
         // Number of encryption rounds
         std::size_t Nr;
 
@@ -95,9 +162,6 @@ class AESIntel : public AESEngine
 
         // Decryption round key schedule array
         __m128i DW[Max_Rounds + 1];
-
-        // Temporary variables used in key expansion
-        __m128i T1, T2, T3, T4;
 };
 
 #else // TERRA_USE_INTEL_INTRINSICS
@@ -0,0 +1,816 @@
+/*
+ *  aes_intel_vaes.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AESIntelVAES object which performs encryption
+ *      and decryption as specified in FIPS 197 ("Advanced Encryption
+ *      Standard") using the vector AES (VAES) instructions.
+ *
+ *      Each round key is broadcast to all 128-bit lanes of a wide register
+ *      so that a single instruction applies the round to two (256-bit) or
+ *      four (512-bit) blocks.  Four wide registers are processed in an
+ *      interleaved fashion to hide the latency of the instruction.  Any
+ *      blocks that do not fill a wide register, as well as requests too
+ *      small to benefit from the wide registers, are handled by AESIntel.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include "intel_intrinsics.h"
+
+// Do not attempt to compile unless told to use Intel Intrinsics
+#ifdef TERRA_USE_INTEL_INTRINSICS
+
+#include <terra/secutil/secure_erase.h>
+#include "aes_intel_vaes.h"
+
+#ifdef HAVE_VAES
+
+namespace Terra::Crypto::Cipher
+{
+
+namespace
+{
+
+/*
+ *  EncryptRounds512()
+ *
+ *  Description:
+ *      This function will perform AES rounds 1 through Nr on each block held
+ *      in a 512-bit register that has already been XORed with the first
+ *      round key.
+ *
+ *  Parameters:
+ *      B [in]
+ *          The blocks to encrypt.
+ *
+ *      K [in]
+ *          The encryption round keys, each broadcast to every lane.
+ *
+ *      K_last [in]
+ *          The round key for the final round (i.e., K[Nr]).
+ *
+ *      rounds [in]
+ *          The number of rounds (Nr).
+ *
+ *  Returns:
+ *      The encrypted blocks.
+ *
+ *  Comments:
+ *      The rounds are fully unrolled so that the round keys may be held in
+ *      registers.  When processing several registers, the processor will
+ *      overlap the independent operations.
+ */
+TERRA_VAES_TARGET inline __m512i EncryptRounds512(__m512i B,
+                                                  const __m512i *K,
+                                                  const __m512i K_last,
+                                                  std::size_t rounds) noexcept
+{
+    // Rounds 1 to 9 are common to all key lengths
+    B = _mm512_aesenc_epi128(B, K[1]);
+    B = _mm512_aesenc_epi128(B, K[2]);
+    B = _mm512_aesenc_epi128(B, K[3]);
+    B = _mm512_aesenc_epi128(B, K[4]);
+    B = _mm512_aesenc_epi128(B, K[5]);
+    B = _mm512_aesenc_epi128(B, K[6]);
+    B = _mm512_aesenc_epi128(B, K[7]);
+    B = _mm512_aesenc_epi128(B, K[8]);
+    B = _mm512_aesenc_epi128(B, K[9]);
+
+    // If Nr > 10 implies either AES-192 or AES-256
+    if (rounds > 10)
+    {
+        B = _mm512_aesenc_epi128(B, K[10]);
+        B = _mm512_aesenc_epi128(B, K[11]);
+
+        // Nr > 12 implies AES-256
+        if (rounds > 12)
+        {
+            B = _mm512_aesenc_epi128(B, K[12]);
+            B = _mm512_aesenc_epi128(B, K[13]);
+        }
+    }
+
+    // Final round
+    return _mm512_aesenclast_epi128(B, K_last);
+}
+
+/*
+ *  DecryptRounds512()
+ *
+ *  Description:
+ *      This function will perform AES rounds 1 through Nr on each block held
+ *      in a 512-bit register that has already been XORed with the first
+ *      round key.
+ *
+ *  Parameters:
+ *      B [in]
+ *          The blocks to decrypt.
+ *
+ *      K [in]
+ *          The decryption round keys, each broadcast to every lane.
+ *
+ *      K_last [in]
+ *          The round key for the final round (i.e., K[Nr]).
+ *
+ *      rounds [in]
+ *          The number of rounds (Nr).
+ *
+ *  Returns:
+ *      The decrypted blocks.
+ *
+ *  Comments:
+ *      The rounds are fully unrolled so that the round keys may be held in
+ *      registers.  When processing several registers, the processor will
+ *      overlap the independent operations.
+ */
+TERRA_VAES_TARGET inline __m512i DecryptRounds512(__m512i B,
+                                                  const __m512i *K,
+                                                  const __m512i K_last,
+                                                  std::size_t rounds) noexcept
+{
+    // Rounds 1 to 9 are common to all key lengths
+    B = _mm512_aesdec_epi128(B, K[1]);
+    B = _mm512_aesdec_epi128(B, K[2]);
+    B = _mm512_aesdec_epi128(B, K[3]);
+    B = _mm512_aesdec_epi128(B, K[4]);
+    B = _mm512_aesdec_epi128(B, K[5]);
+    B = _mm512_aesdec_epi128(B, K[6]);
+    B = _mm512_aesdec_epi128(B, K[7]);
+    B = _mm512_aesdec_epi128(B, K[8]);
+    B = _mm512_aesdec_epi128(B, K[9]);
+
+    // If Nr > 10 implies either AES-192 or AES-256
+    if (rounds > 10)
+    {
+        B = _mm512_aesdec_epi128(B, K[10]);
+        B = _mm512_aesdec_epi128(B, K[11]);
+
+        // Nr > 12 implies AES-256
+        if (rounds > 12)
+        {
+            B = _mm512_aesdec_epi128(B, K[12]);
+            B = _mm512_aesdec_epi128(B, K[13]);
+        }
+    }
+
+    // Final round
+    return _mm512_aesdeclast_epi128(B, K_last);
+}
+
+/*
+ *  EncryptRounds256()
+ *
+ *  Description:
+ *      This function will perform AES rounds 1 through Nr on each block held
+ *      in a 256-bit register that has already been XORed with the first
+ *      round key.
+ *
+ *  Parameters:
+ *      B [in]
+ *          The blocks to encrypt.
+ *
+ *      K [in]
+ *          The encryption round keys, each broadcast to every lane.
+ *
+ *      K_last [in]
+ *          The round key for the final round (i.e., K[Nr]).
+ *
+ *      rounds [in]
+ *          The number of rounds (Nr).
+ *
+ *  Returns:
+ *      The encrypted blocks.
+ *
+ *  Comments:
+ *      The rounds are fully unrolled so that the round keys may be held in
+ *      registers.  When processing several registers, the processor will
+ *      overlap the independent operations.
+ */
+TERRA_VAES256_TARGET inline __m256i EncryptRounds256(__m256i B,
+                                                     const __m256i *K,
+                                                     const __m256i K_last,
+                                                     std::size_t rounds)
+                                                     noexcept
+{
+    // Rounds 1 to 9 are common to all key lengths
+    B = _mm256_aesenc_epi128(B, K[1]);
+    B = _mm256_aesenc_epi128(B, K[2]);
+    B = _mm256_aesenc_epi128(B, K[3]);
+    B = _mm256_aesenc_epi128(B, K[4]);
+    B = _mm256_aesenc_epi128(B, K[5]);
+    B = _mm256_aesenc_epi128(B, K[6]);
+    B = _mm256_aesenc_epi128(B, K[7]);
+    B = _mm256_aesenc_epi128(B, K[8]);
+    B = _mm256_aesenc_epi128(B, K[9]);
+
+    // If Nr > 10 implies either AES-192 or AES-256
+    if (rounds > 10)
+    {
+        B = _mm256_aesenc_epi128(B, K[10]);
+        B = _mm256_aesenc_epi128(B, K[11]);
+
+        // Nr > 12 implies AES-256
+        if (rounds > 12)
+        {
+            B = _mm256_aesenc_epi128(B, K[12]);
+            B = _mm256_aesenc_epi128(B, K[13]);
+        }
+    }
+
+    // Final round
+    return _mm256_aesenclast_epi128(B, K_last);
+}
+
+/*
+ *  DecryptRounds256()
+ *
+ *  Description:
+ *      This function will perform AES rounds 1 through Nr on each block held
+ *      in a 256-bit register that has already been XORed with the first
+ *      round key.
+ *
+ *  Parameters:
+ *      B [in]
+ *          The blocks to decrypt.
+ *
+ *      K [in]
+ *          The decryption round keys, each broadcast to every lane.
+ *
+ *      K_last [in]
+ *          The round key for the final round (i.e., K[Nr]).
+ *
+ *      rounds [in]
+ *          The number of rounds (Nr).
+ *
+ *  Returns:
+ *      The decrypted blocks.
+ *
+ *  Comments:
+ *      The rounds are fully unrolled so that the round keys may be held in
+ *      registers.  When processing several registers, the processor will
+ *      overlap the independent operations.
+ */
+TERRA_VAES256_TARGET inline __m256i DecryptRounds256(__m256i B,
+                                                     const __m256i *K,
+                                                     const __m256i K_last,
+                                                     std::size_t rounds)
+                                                     noexcept
+{
+    // Rounds 1 to 9 are common to all key lengths
+    B = _mm256_aesdec_epi128(B, K[1]);
+    B = _mm256_aesdec_epi128(B, K[2]);
+    B = _mm256_aesdec_epi128(B, K[3]);
+    B = _mm256_aesdec_epi128(B, K[4]);
+    B = _mm256_aesdec_epi128(B, K[5]);
+    B = _mm256_aesdec_epi128(B, K[6]);
+    B = _mm256_aesdec_epi128(B, K[7]);
+    B = _mm256_aesdec_epi128(B, K[8]);
+    B = _mm256_aesdec_epi128(B, K[9]);
+
+    // If Nr > 10 implies either AES-192 or AES-256
+    if (rounds > 10)
+    {
+        B = _mm256_aesdec_epi128(B, K[10]);
+        B = _mm256_aesdec_epi128(B, K[11]);
+
+        // Nr > 12 implies AES-256
+        if (rounds > 12)
+        {
+            B = _mm256_aesdec_epi128(B, K[12]);
+            B = _mm256_aesdec_epi128(B, K[13]);
+        }
+    }
+
+    // Final round
+    return _mm256_aesdeclast_epi128(B, K_last);
+}
+
+} // namespace
+
+/*
+ * AESIntelVAES::AESIntelVAES()
+ *
+ *  Description:
+ *      This is a constructor for the AESIntelVAES object with no given key.
+ *      Since a key is not provided to this version of the constructor, one
+ *      must call SetKey() with a valid key before calling Encrypt() or
+ *      Decrypt(), as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESIntelVAES::AESIntelVAES() noexcept :
+    AESIntel(),
+    use_512_bit{CPUSupportsAVX512F()}
+{
+    // Nothing to do
+}
+
+/*
+ * AESIntelVAES::AESIntelVAES()
+ *
+ *  Description:
+ *      This is a constructor for the AESIntelVAES object that accepts a span
+ *      of octets as input that contains the key.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *      This corresponds to 128, 192, and 256 bits.
+ *
+ *  Comments:
+ *      None.
+ */
+AESIntelVAES::AESIntelVAES(const std::span<const std::uint8_t> key) :
+    AESIntelVAES()
+{
+    // Only set the key if VAES instructions are supported
+    if (GetEngineType() == AESEngineType::IntelVAES) SetKey(key);
+}
+
+/*
+ * AESIntelVAES::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a series of plaintext blocks and return the
+ *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The data to encrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESIntelVAES::EncryptBlocks(
+            const std::span<const std::uint8_t> plaintext,
+            std::span<std::uint8_t> ciphertext) const noexcept
+{
+    std::size_t blocks = plaintext.size() / AES_Block_Size;
+    std::size_t processed{};
+
+    // Small requests do not benefit from the wide registers
+    if (blocks < Minimum_Wide_Blocks)
+    {
+        AESIntel::EncryptBlocks(plaintext, ciphertext);
+        return;
+    }
+
+    if (use_512_bit)
+    {
+        processed = EncryptBlocks512(plaintext.data(),
+                                     ciphertext.data(),
+                                     blocks);
+    }
+    else
+    {
+        processed = EncryptBlocks256(plaintext.data(),
+                                     ciphertext.data(),
+                                     blocks);
+    }
+
+    // Encrypt any remaining blocks using AES-NI
+    if (processed < blocks)
+    {
+        AESIntel::EncryptBlocks(
+            plaintext.subspan(processed * AES_Block_Size),
+            ciphertext.subspan(processed * AES_Block_Size));
+    }
+}
+
+/*
+ * AESIntelVAES::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a series of ciphertext blocks and return
+ *      the plaintext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The data to decrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESIntelVAES::DecryptBlocks(
+            const std::span<const std::uint8_t> ciphertext,
+            std::span<std::uint8_t> plaintext) const noexcept
+{
+    std::size_t blocks = ciphertext.size() / AES_Block_Size;
+    std::size_t processed{};
+
+    // Small requests do not benefit from the wide registers
+    if (blocks < Minimum_Wide_Blocks)
+    {
+        AESIntel::DecryptBlocks(ciphertext, plaintext);
+        return;
+    }
+
+    if (use_512_bit)
+    {
+        processed = DecryptBlocks512(ciphertext.data(),
+                                     plaintext.data(),
+                                     blocks);
+    }
+    else
+    {
+        processed = DecryptBlocks256(ciphertext.data(),
+                                     plaintext.data(),
+                                     blocks);
+    }
+
+    // Decrypt any remaining blocks using AES-NI
+    if (processed < blocks)
+    {
+        AESIntel::DecryptBlocks(
+            ciphertext.subspan(processed * AES_Block_Size),
+            plaintext.subspan(processed * AES_Block_Size));
+    }
+}
+
+/*
+ * AESIntelVAES::EncryptBlocks512()
+ *
+ *  Description:
+ *      This function will encrypt as many blocks as possible using 512-bit
+ *      registers, each holding four blocks.
+ *
+ *  Parameters:
+ *      p [in]
+ *          The plaintext blocks to encrypt.
+ *
+ *      c [out]
+ *          The buffer into which the ciphertext is written.  This may be the
+ *          same memory location as the plaintext.
+ *
+ *      blocks [in]
+ *          The number of blocks to encrypt.
+ *
+ *  Returns:
+ *      The number of blocks encrypted, which will be a multiple of four.
+ *
+ *  Comments:
+ *      Sixteen blocks are processed per iteration, followed by groups of
+ *      four blocks.
+ */
+TERRA_VAES_TARGET std::size_t AESIntelVAES::EncryptBlocks512(
+                                                const std::uint8_t *p,
+                                                std::uint8_t *c,
+                                                std::size_t blocks) const
+                                                noexcept
+{
+    const std::size_t rounds = Nr;
+    std::size_t processed{};
+    __m512i K[Max_Rounds + 1];
+    __m512i K_last;
+    __m512i B0, B1, B2, B3;
+
+    // Broadcast each round key to all lanes (the masked form avoids
+    // an uninitialized variable warning in some compilers' headers)
+    for (std::size_t i = 0; i <= Max_Rounds; i++)
+    {
+        K[i] = _mm512_maskz_broadcast_i32x4(0xffff, W[i]);
+    }
+    K_last = _mm512_maskz_broadcast_i32x4(0xffff, W[rounds]);
+
+    // Process 16 blocks at a time
+    for (; blocks - processed >= 16; processed += 16, p += 256, c += 256)
+    {
+        // Step 1 - AddRoundKey() (i.e., XOR with W[0])
+        B0 = _mm512_xor_si512(_mm512_loadu_si512(p), K[0]);
+        B1 = _mm512_xor_si512(_mm512_loadu_si512(p + 64), K[0]);
+        B2 = _mm512_xor_si512(_mm512_loadu_si512(p + 128), K[0]);
+        B3 = _mm512_xor_si512(_mm512_loadu_si512(p + 192), K[0]);
+
+        // Step 2 - Rounds 1 to Nr
+        B0 = EncryptRounds512(B0, K, K_last, rounds);
+        B1 = EncryptRounds512(B1, K, K_last, rounds);
+        B2 = EncryptRounds512(B2, K, K_last, rounds);
+        B3 = EncryptRounds512(B3, K, K_last, rounds);
+
+        // Step 3 - Store the results
+        _mm512_storeu_si512(c, B0);
+        _mm512_storeu_si512(c + 64, B1);
+        _mm512_storeu_si512(c + 128, B2);
+        _mm512_storeu_si512(c + 192, B3);
+    }
+
+    // Process four blocks at a time
+    for (; blocks - processed >= 4; processed += 4, p += 64, c += 64)
+    {
+        B0 = _mm512_xor_si512(_mm512_loadu_si512(p), K[0]);
+        B0 = EncryptRounds512(B0, K, K_last, rounds);
+        _mm512_storeu_si512(c, B0);
+    }
+
+    // Erase the broadcast round keys
+    SecUtil::SecureErase(K, sizeof(K));
+    SecUtil::SecureErase(&K_last, sizeof(K_last));
+
+    return processed;
+}
+
+/*
+ * AESIntelVAES::DecryptBlocks512()
+ *
+ *  Description:
+ *      This function will decrypt as many blocks as possible using 512-bit
+ *      registers, each holding four blocks.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The ciphertext blocks to decrypt.
+ *
+ *      p [out]
+ *          The buffer into which the plaintext is written.  This may be the
+ *          same memory location as the ciphertext.
+ *
+ *      blocks [in]
+ *          The number of blocks to decrypt.
+ *
+ *  Returns:
+ *      The number of blocks decrypted, which will be a multiple of four.
+ *
+ *  Comments:
+ *      See the comments for EncryptBlocks512().
+ */
+TERRA_VAES_TARGET std::size_t AESIntelVAES::DecryptBlocks512(
+                                                const std::uint8_t *c,
+                                                std::uint8_t *p,
+                                                std::size_t blocks) const
+                                                noexcept
+{
+    const std::size_t rounds = Nr;
+    std::size_t processed{};
+    __m512i K[Max_Rounds + 1];
+    __m512i K_last;
+    __m512i B0, B1, B2, B3;
+
+    // Broadcast each round key to all lanes (the masked form avoids
+    // an uninitialized variable warning in some compilers' headers)
+    for (std::size_t i = 0; i <= Max_Rounds; i++)
+    {
+        K[i] = _mm512_maskz_broadcast_i32x4(0xffff, DW[i]);
+    }
+    K_last = _mm512_maskz_broadcast_i32x4(0xffff, DW[rounds]);
+
+    // Process 16 blocks at a time
+    for (; blocks - processed >= 16; processed += 16, c += 256, p += 256)
+    {
+        // Step 1 - AddRoundKey() (i.e., XOR with DW[0])
+        B0 = _mm512_xor_si512(_mm512_loadu_si512(c), K[0]);
+        B1 = _mm512_xor_si512(_mm512_loadu_si512(c + 64), K[0]);
+        B2 = _mm512_xor_si512(_mm512_loadu_si512(c + 128), K[0]);
+        B3 = _mm512_xor_si512(_mm512_loadu_si512(c + 192), K[0]);
+
+        // Step 2 - Rounds 1 to Nr
+        B0 = DecryptRounds512(B0, K, K_last, rounds);
+        B1 = DecryptRounds512(B1, K, K_last, rounds);
+        B2 = DecryptRounds512(B2, K, K_last, rounds);
+        B3 = DecryptRounds512(B3, K, K_last, rounds);
+
+        // Step 3 - Store the results
+        _mm512_storeu_si512(p, B0);
+        _mm512_storeu_si512(p + 64, B1);
+        _mm512_storeu_si512(p + 128, B2);
+        _mm512_storeu_si512(p + 192, B3);
+    }
+
+    // Process four blocks at a time
+    for (; blocks - processed >= 4; processed += 4, c += 64, p += 64)
+    {
+        B0 = _mm512_xor_si512(_mm512_loadu_si512(c), K[0]);
+        B0 = DecryptRounds512(B0, K, K_last, rounds);
+        _mm512_storeu_si512(p, B0);
+    }
+
+    // Erase the broadcast round keys
+    SecUtil::SecureErase(K, sizeof(K));
+    SecUtil::SecureErase(&K_last, sizeof(K_last));
+
+    return processed;
+}
+
+/*
+ * AESIntelVAES::EncryptBlocks256()
+ *
+ *  Description:
+ *      This function will encrypt as many blocks as possible using 256-bit
+ *      registers, each holding two blocks.
+ *
+ *  Parameters:
+ *      p [in]
+ *          The plaintext blocks to encrypt.
+ *
+ *      c [out]
+ *          The buffer into which the ciphertext is written.  This may be the
+ *          same memory location as the plaintext.
+ *
+ *      blocks [in]
+ *          The number of blocks to encrypt.
+ *
+ *  Returns:
+ *      The number of blocks encrypted, which will be a multiple of two.
+ *
+ *  Comments:
+ *      Eight blocks are processed per iteration, followed by groups of
+ *      two blocks.
+ */
+TERRA_VAES256_TARGET std::size_t AESIntelVAES::EncryptBlocks256(
+                                                const std::uint8_t *p,
+                                                std::uint8_t *c,
+                                                std::size_t blocks) const
+                                                noexcept
+{
+    const std::size_t rounds = Nr;
+    std::size_t processed{};
+    __m256i K[Max_Rounds + 1];
+    __m256i K_last;
+    __m256i B0, B1, B2, B3;
+
+    // Broadcast each round key to all lanes
+    for (std::size_t i = 0; i <= Max_Rounds; i++)
+    {
+        K[i] = _mm256_broadcastsi128_si256(W[i]);
+    }
+    K_last = _mm256_broadcastsi128_si256(W[rounds]);
+
+    // Process 8 blocks at a time
+    for (; blocks - processed >= 8; processed += 8, p += 128, c += 128)
+    {
+        // Step 1 - AddRoundKey() (i.e., XOR with W[0])
+        B0 = _mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)),
+            K[0]);
+        B1 = _mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32)),
+            K[0]);
+        B2 = _mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 64)),
+            K[0]);
+        B3 = _mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 96)),
+            K[0]);
+
+        // Step 2 - Rounds 1 to Nr
+        B0 = EncryptRounds256(B0, K, K_last, rounds);
+        B1 = EncryptRounds256(B1, K, K_last, rounds);
+        B2 = EncryptRounds256(B2, K, K_last, rounds);
+        B3 = EncryptRounds256(B3, K, K_last, rounds);
+
+        // Step 3 - Store the results
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(c), B0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(c + 32), B1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(c + 64), B2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(c + 96), B3);
+    }
+
+    // Process two blocks at a time
+    for (; blocks - processed >= 2; processed += 2, p += 32, c += 32)
+    {
+        B0 = _mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)),
+            K[0]);
+        B0 = EncryptRounds256(B0, K, K_last, rounds);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(c), B0);
+    }
+
+    // Erase the broadcast round keys
+    SecUtil::SecureErase(K, sizeof(K));
+    SecUtil::SecureErase(&K_last, sizeof(K_last));
+
+    return processed;
+}
+
+/*
+ * AESIntelVAES::DecryptBlocks256()
+ *
+ *  Description:
+ *      This function will decrypt as many blocks as possible using 256-bit
+ *      registers, each holding two blocks.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The ciphertext blocks to decrypt.
+ *
+ *      p [out]
+ *          The buffer into which the plaintext is written.  This may be the
+ *          same memory location as the ciphertext.
+ *
+ *      blocks [in]
+ *          The number of blocks to decrypt.
+ *
+ *  Returns:
+ *      The number of blocks decrypted, which will be a multiple of two.
+ *
+ *  Comments:
+ *      See the comments for EncryptBlocks256().
+ */
+TERRA_VAES256_TARGET std::size_t AESIntelVAES::DecryptBlocks256(
+                                                const std::uint8_t *c,
+                                                std::uint8_t *p,
+                                                std::size_t blocks) const
+                                                noexcept
+{
+    const std::size_t rounds = Nr;
+    std::size_t processed{};
+    __m256i K[Max_Rounds + 1];
+    __m256i K_last;
+    __m256i B0, B1, B2, B3;
+
+    // Broadcast each round key to all lanes
+    for (std::size_t i = 0; i <= Max_Rounds; i++)
+    {
+        K[i] = _mm256_broadcastsi128_si256(DW[i]);
+    }
+    K_last = _mm256_broadcastsi128_si256(DW[rounds]);
+
+    // Process 8 blocks at a time
+    for (; blocks - processed >= 8; processed += 8, c += 128, p += 128)
+    {
+        // Step 1 - AddRoundKey() (i.e., XOR with DW[0])
+        B0 = _mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c)),
+            K[0]);
+        B1 = _mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c + 32)),
+            K[0]);
+        B2 = _mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c + 64)),
+            K[0]);
+        B3 = _mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c + 96)),
+            K[0]);
+
+        // Step 2 - Rounds 1 to Nr
+        B0 = DecryptRounds256(B0, K, K_last, rounds);
+        B1 = DecryptRounds256(B1, K, K_last, rounds);
+        B2 = DecryptRounds256(B2, K, K_last, rounds);
+        B3 = DecryptRounds256(B3, K, K_last, rounds);
+
+        // Step 3 - Store the results
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), B0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p + 32), B1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p + 64), B2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p + 96), B3);
+    }
+
+    // Process two blocks at a time
+    for (; blocks - processed >= 2; processed += 2, c += 32, p += 32)
+    {
+        B0 = _mm256_xor_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c)),
+            K[0]);
+        B0 = DecryptRounds256(B0, K, K_last, rounds);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), B0);
+    }
+
+    // Erase the broadcast round keys
+    SecUtil::SecureErase(K, sizeof(K));
+    SecUtil::SecureErase(&K_last, sizeof(K_last));
+
+    return processed;
+}
+
+} // namespace Terra::Crypto::Cipher
+
+#endif // HAVE_VAES
+
+#endif // TERRA_USE_INTEL_INTRINSICS
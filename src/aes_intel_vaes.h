@@ -0,0 +1,128 @@
+/*
+ *  aes_intel_vaes.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESIntelVAES object which performs encryption
+ *      and decryption as specified in FIPS 197 ("Advanced Encryption
+ *      Standard") using the vector AES (VAES) instructions.  VAES applies
+ *      an AES round to every 128-bit lane of a 256-bit (AVX2) or 512-bit
+ *      (AVX-512) register, so two or four blocks are processed with each
+ *      instruction.
+ *
+ *      This engine is derived from AESIntel, using the same key schedule
+ *      and single-block functions.  Only the multi-block functions differ,
+ *      using 512-bit registers when the processor supports AVX-512F and
+ *      256-bit registers otherwise.
+ *
+ *      As with AESIntel, if one attempts to use this AES engine on a
+ *      processor that does not support the VAES instructions it will not
+ *      work and will likely cause a core dump.  One should always call
+ *      GetEngineType() to ensure that it does not return
+ *      "AESEngineType::Unavailable" before attempting to use any of the
+ *      functions.
+ *
+ *  Portability Issues:
+ *      The functions using VAES are compiled with a target attribute on
+ *      GCC and Clang so that the rest of the library does not require
+ *      AVX2 or AVX-512 support.  The HAVE_VAES macro is defined by CMake
+ *      when the compiler supports this.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <terra/crypto/cipher/aes.h>
+#include "intel_intrinsics.h"
+#include "cpu_check.h"
+#include "aes_intel.h"
+#include "aes_unavailable.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+#if defined(TERRA_USE_INTEL_INTRINSICS) && defined(HAVE_VAES)
+
+// Enable the required instruction set extensions for specific functions
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TERRA_VAES_TARGET
+#define TERRA_VAES256_TARGET
+#else
+#define TERRA_VAES_TARGET __attribute__((target("avx2,avx512f,vaes")))
+#define TERRA_VAES256_TARGET __attribute__((target("avx2,vaes")))
+#endif
+
+// Define the AESIntelVAES class
+class AESIntelVAES : public AESIntel
+{
+    protected:
+        // Fewer blocks than this are processed using AES-NI instructions
+        static constexpr std::size_t Minimum_Wide_Blocks{16};
+
+    public:
+        AESIntelVAES() noexcept;
+        AESIntelVAES(const std::span<const std::uint8_t> key);
+        AESIntelVAES(const AESIntelVAES &other) noexcept = default;
+        AESIntelVAES(AESIntelVAES &&other) noexcept = default;
+        ~AESIntelVAES() = default;
+
+        AESIntelVAES &operator=(const AESIntelVAES &other) = default;
+        AESIntelVAES &operator=(AESIntelVAES &&other) noexcept = default;
+
+        AESEngineType GetEngineType() const noexcept override
+        {
+            if (CPUSupportsAES_NI() && CPUSupportsVAES())
+            {
+                return AESEngineType::IntelVAES;
+            }
+
+            return AESEngineType::Unavailable;
+        }
+
+        void EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const noexcept
+            override;
+
+        void DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const noexcept
+            override;
+
+    protected:
+        TERRA_VAES_TARGET std::size_t EncryptBlocks512(
+                                             const std::uint8_t *p,
+                                             std::uint8_t *c,
+                                             std::size_t blocks) const noexcept;
+        TERRA_VAES_TARGET std::size_t DecryptBlocks512(
+                                             const std::uint8_t *c,
+                                             std::uint8_t *p,
+                                             std::size_t blocks) const noexcept;
+        TERRA_VAES256_TARGET std::size_t EncryptBlocks256(
+                                             const std::uint8_t *p,
+                                             std::uint8_t *c,
+                                             std::size_t blocks) const noexcept;
+        TERRA_VAES256_TARGET std::size_t DecryptBlocks256(
+                                             const std::uint8_t *c,
+                                             std::uint8_t *p,
+                                             std::size_t blocks) const noexcept;
+
+        // Use 512-bit registers (AVX-512F) rather than 256-bit (AVX2)
+        bool use_512_bit;
+};
+
+#else // TERRA_USE_INTEL_INTRINSICS && HAVE_VAES
+
+// If building without VAES support, alias this engine type as unavailable
+
+using AESIntelVAES = AESUnavailable;
+
+#endif // TERRA_USE_INTEL_INTRINSICS && HAVE_VAES
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,802 @@
+/*
+ *  aes_key_pool.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AESKeyPool object, which holds many AES key
+ *      schedules in a single region of memory.  The engine for each key is
+ *      constructed within its slot and calls are dispatched on the engine
+ *      type to a non-virtual call to that engine's member function, as is
+ *      done by AESInline.
+ *
+ *  Portability Issues:
+ *      Locked memory is allocated using mmap() and mlock() on POSIX systems
+ *      and VirtualAlloc() and VirtualLock() on Windows.
+ */
+
+#include <cassert>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <terra/secutil/secure_erase.h>
+#include <terra/crypto/cipher/aes_key_pool.h>
+#include <terra/crypto/cipher/aes_inline.h>
+#include "engine_dispatch.h"
+#include "instrumentation.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace Terra::Crypto::Cipher
+{
+
+namespace
+{
+
+/*
+ *  EngineSize()
+ *
+ *  Description:
+ *      Return the number of octets occupied by the engine of the given type.
+ *
+ *  Parameters:
+ *      engine_type [in]
+ *          The AES engine type.
+ *
+ *  Returns:
+ *      The size of the engine object.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t EngineSize(AESEngineType engine_type) noexcept
+{
+    switch (engine_type)
+    {
+        case AESEngineType::IntelVAES:
+            return sizeof(AESIntelVAES);
+
+        case AESEngineType::Intel:
+            return sizeof(AESIntel);
+
+        case AESEngineType::ARM:
+            return sizeof(AESARM);
+
+        case AESEngineType::VectorPermute:
+            return sizeof(AESVectorPermute);
+
+        default:
+            return sizeof(AESUniversal);
+    }
+}
+
+/*
+ *  ConstructEngine()
+ *
+ *  Description:
+ *      Construct an engine of the given type, with no key, in the given
+ *      storage.
+ *
+ *  Parameters:
+ *      engine_type [in]
+ *          The AES engine type.
+ *
+ *      storage [in]
+ *          The storage in which to construct the engine.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ConstructEngine(AESEngineType engine_type, std::uint8_t *storage) noexcept
+{
+    switch (engine_type)
+    {
+        case AESEngineType::IntelVAES:
+            new (storage) AESIntelVAES();
+            break;
+
+        case AESEngineType::Intel:
+            new (storage) AESIntel();
+            break;
+
+        case AESEngineType::ARM:
+            new (storage) AESARM();
+            break;
+
+        case AESEngineType::VectorPermute:
+            new (storage) AESVectorPermute();
+            break;
+
+        default:
+            new (storage) AESUniversal();
+            break;
+    }
+}
+
+/*
+ *  AllocateStorage()
+ *
+ *  Description:
+ *      Allocate memory to hold the key slots.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The number of octets to allocate.
+ *
+ *      memory [in]
+ *          The type of memory to allocate.
+ *
+ *  Returns:
+ *      A pointer to the memory, which is aligned to at least
+ *      AESKeyPool::Slot_Alignment octets.  An exception is thrown if the
+ *      memory cannot be allocated or locked.
+ *
+ *  Comments:
+ *      Locked memory is also excluded from core dumps where that is supported.
+ */
+std::uint8_t *AllocateStorage(std::size_t size, AESKeyPoolMemory memory)
+{
+    if (memory == AESKeyPoolMemory::Heap)
+    {
+        return static_cast<std::uint8_t *>(::operator new(
+            size,
+            std::align_val_t{AESKeyPool::Slot_Alignment}));
+    }
+
+#ifdef _WIN32
+    void *region = VirtualAlloc(nullptr,
+                                size,
+                                MEM_COMMIT | MEM_RESERVE,
+                                PAGE_READWRITE);
+    if (region == nullptr)
+    {
+        throw AESException("Unable to allocate key pool memory");
+    }
+
+    if (!VirtualLock(region, size))
+    {
+        VirtualFree(region, 0, MEM_RELEASE);
+        throw AESException("Unable to lock key pool memory");
+    }
+#else
+    void *region = mmap(nullptr,
+                        size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1,
+                        0);
+    if (region == MAP_FAILED)
+    {
+        throw AESException("Unable to allocate key pool memory");
+    }
+
+    if (mlock(region, size) != 0)
+    {
+        munmap(region, size);
+        throw AESException("Unable to lock key pool memory");
+    }
+
+#ifdef MADV_DONTDUMP
+    madvise(region, size, MADV_DONTDUMP);
+#endif
+#endif
+
+    return static_cast<std::uint8_t *>(region);
+}
+
+/*
+ *  ReleaseStorage()
+ *
+ *  Description:
+ *      Release memory allocated by AllocateStorage().
+ *
+ *  Parameters:
+ *      storage [in]
+ *          The memory to release.
+ *
+ *      size [in]
+ *          The number of octets allocated.
+ *
+ *      memory [in]
+ *          The type of memory allocated.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ReleaseStorage(std::uint8_t *storage,
+                    std::size_t size,
+                    AESKeyPoolMemory memory) noexcept
+{
+    if (memory == AESKeyPoolMemory::Heap)
+    {
+        ::operator delete(storage,
+                          std::align_val_t{AESKeyPool::Slot_Alignment});
+        return;
+    }
+
+#ifdef _WIN32
+    VirtualUnlock(storage, size);
+    VirtualFree(storage, 0, MEM_RELEASE);
+#else
+    munlock(storage, size);
+    munmap(storage, size);
+#endif
+}
+
+} // namespace
+
+/*
+ *  AESKeyPool::AESKeyPool()
+ *
+ *  Description:
+ *      This is a constructor for the AESKeyPool object, which selects the
+ *      AES engine and allocates memory for the given number of keys.
+ *
+ *  Parameters:
+ *      capacity [in]
+ *          The number of keys the pool can hold.
+ *
+ *      memory [in]
+ *          The type of memory to use.  If AESKeyPoolMemory::Locked, the
+ *          memory is locked so that it is not written to swap space.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the capacity is zero
+ *      or if the memory cannot be allocated or locked.
+ *
+ *  Comments:
+ *      None.
+ */
+AESKeyPool::AESKeyPool(std::size_t capacity, AESKeyPoolMemory memory) :
+    engine_type{AESInline().GetEngineType()},
+    memory{memory},
+    capacity{capacity},
+    slot_size{(EngineSize(engine_type) + Slot_Alignment - 1) &
+              ~(Slot_Alignment - 1)},
+    storage_size{},
+    storage{}
+{
+    // Ensure each engine that might be selected observes the slot alignment
+    static_assert(alignof(AESIntelVAES) <= Slot_Alignment);
+    static_assert(alignof(AESIntel) <= Slot_Alignment);
+    static_assert(alignof(AESARM) <= Slot_Alignment);
+    static_assert(alignof(AESVectorPermute) <= Slot_Alignment);
+    static_assert(alignof(AESUniversal) <= Slot_Alignment);
+
+    if ((capacity == 0) ||
+        (capacity > std::numeric_limits<std::size_t>::max() / slot_size))
+    {
+        throw AESException("Invalid key pool capacity");
+    }
+
+    storage_size = capacity * slot_size;
+
+    // Slots are allocated from the back of the list, so list them in reverse
+    free_slots.reserve(capacity);
+    for (std::size_t i = capacity; i > 0; i--) free_slots.push_back(i - 1);
+
+    allocated.resize(capacity, false);
+    key_usage.resize(capacity, AESKeyUsage::EncryptDecrypt);
+
+    storage = AllocateStorage(storage_size, memory);
+}
+
+/*
+ *  AESKeyPool::~AESKeyPool()
+ *
+ *  Description:
+ *      This is the destructor for the AESKeyPool object, which erases every
+ *      key and releases the memory.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESKeyPool::~AESKeyPool()
+{
+    for (std::size_t i = 0; i < capacity; i++)
+    {
+        if (allocated[i]) DestroySlot(i);
+    }
+
+    SecUtil::SecureErase(storage, storage_size);
+
+    ReleaseStorage(storage, storage_size, memory);
+}
+
+/*
+ *  AESKeyPool::Allocate()
+ *
+ *  Description:
+ *      Allocate a slot and expand the given key into it.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key, which must be 16, 24, or 32 octets.
+ *
+ *      key_usage [in]
+ *          Indicates whether the key will be used for both encryption and
+ *          decryption or only for encryption.  If AESKeyUsage::EncryptOnly,
+ *          Decrypt() and DecryptBlocks() must not be called using this key.
+ *
+ *  Returns:
+ *      The handle used to refer to the key in other calls.  An exception is
+ *      thrown if the pool is full or the key length is invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t AESKeyPool::Allocate(const std::span<const std::uint8_t> key,
+                                 AESKeyUsage key_usage)
+{
+    if (free_slots.empty()) throw AESException("The key pool is full");
+
+    const std::size_t handle = free_slots.back();
+    std::uint8_t *slot = Slot(handle);
+
+    ConstructEngine(engine_type, slot);
+
+    try
+    {
+        Dispatch(engine_type,
+                 slot,
+                 [&](auto &engine)
+                 {
+                     using Engine = std::remove_cvref_t<decltype(engine)>;
+
+                     engine.Engine::SetKey(key, key_usage);
+                 });
+    }
+    catch (...)
+    {
+        DestroySlot(handle);
+        throw;
+    }
+
+    free_slots.pop_back();
+    allocated[handle] = true;
+    this->key_usage[handle] = key_usage;
+
+    RecordAESEvent(*this, AESCounter::KeySetups);
+
+    return handle;
+}
+
+/*
+ *  AESKeyPool::Allocate()
+ *
+ *  Description:
+ *      Allocate a slot for each of the given keys and expand the keys into
+ *      them.  Where the engine supports it, several keys are expanded at
+ *      once, which is considerably faster than allocating each key
+ *      individually.
+ *
+ *  Parameters:
+ *      keys [in]
+ *          The encryption keys, each of which must be 16, 24, or 32 octets.
+ *
+ *      handles [out]
+ *          The handle used to refer to each key in other calls, in the same
+ *          order as the keys.
+ *
+ *      key_usage [in]
+ *          Indicates whether the keys will be used for both encryption and
+ *          decryption or only for encryption.  If AESKeyUsage::EncryptOnly,
+ *          Decrypt() and DecryptBlocks() must not be called using these keys.
+ *
+ *  Returns:
+ *      Nothing, though an exception is thrown if the number of handles does
+ *      not match the number of keys, if the pool does not have room for all
+ *      of the keys, or if any key length is invalid.  No slot is allocated
+ *      if an exception is thrown.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESKeyPool::Allocate(
+                    const std::span<const std::span<const std::uint8_t>> keys,
+                    std::span<std::size_t> handles,
+                    AESKeyUsage key_usage)
+{
+    if (keys.size() != handles.size())
+    {
+        throw AESException("There must be one handle for each key");
+    }
+
+    if (keys.size() > free_slots.size())
+    {
+        throw AESException("The key pool is full");
+    }
+
+    // Verify all of the keys before constructing any engine
+    for (const auto &key : keys)
+    {
+        if ((key.size() != 16) && (key.size() != 24) && (key.size() != 32))
+        {
+            throw AESException("Invalid key length provided");
+        }
+    }
+
+    // Construct the engines in the slots at the back of the free list
+    for (std::size_t i = 0; i < keys.size(); i++)
+    {
+        handles[i] = free_slots[free_slots.size() - 1 - i];
+        ConstructEngine(engine_type, Slot(handles[i]));
+    }
+
+    try
+    {
+        ExpandKeys(keys, handles, key_usage);
+    }
+    catch (...)
+    {
+        for (std::size_t handle : handles) DestroySlot(handle);
+        throw;
+    }
+
+    for (std::size_t handle : handles)
+    {
+        free_slots.pop_back();
+        allocated[handle] = true;
+        this->key_usage[handle] = key_usage;
+    }
+
+    RecordAESEvent(*this, AESCounter::KeySetups, keys.size());
+}
+
+/*
+ *  AESKeyPool::Free()
+ *
+ *  Description:
+ *      Erase the key held in the given slot and return the slot to the pool.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The handle returned by Allocate().
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the handle does not
+ *      refer to an allocated slot.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESKeyPool::Free(std::size_t handle)
+{
+    if (!ValidHandle(handle)) throw AESException("Invalid key pool handle");
+
+    DestroySlot(handle);
+
+    allocated[handle] = false;
+    free_slots.push_back(handle);
+}
+
+/*
+ *  AESKeyPool::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt a block of plaintext using the given key.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The handle returned by Allocate(), which must not have been freed.
+ *
+ *      plaintext [in]
+ *          A block of plaintext to encrypt.
+ *
+ *      ciphertext [out]
+ *          The ciphertext produced by encrypting the plaintext.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The plaintext and ciphertext may refer to the same memory.
+ */
+void AESKeyPool::Encrypt(std::size_t handle,
+                         const std::span<const std::uint8_t, 16> plaintext,
+                         std::span<std::uint8_t, 16> ciphertext) const noexcept
+{
+    assert(ValidHandle(handle));
+
+    Dispatch(engine_type,
+             static_cast<const std::uint8_t *>(Slot(handle)),
+             [&](const auto &engine)
+             {
+                 using Engine = std::remove_cvref_t<decltype(engine)>;
+
+                 engine.Engine::Encrypt(plaintext, ciphertext);
+             });
+
+    RecordAESEvent(*this, AESCounter::BlocksEncrypted);
+}
+
+/*
+ *  AESKeyPool::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt a block of ciphertext using the given key.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The handle returned by Allocate(), which must not have been freed.
+ *
+ *      ciphertext [in]
+ *          A block of ciphertext to decrypt.
+ *
+ *      plaintext [out]
+ *          The plaintext produced by decrypting the ciphertext.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The ciphertext and plaintext may refer to the same memory.
+ */
+void AESKeyPool::Decrypt(std::size_t handle,
+                         const std::span<const std::uint8_t, 16> ciphertext,
+                         std::span<std::uint8_t, 16> plaintext) const noexcept
+{
+    // The decryption key schedule must have been computed
+    assert(ValidHandle(handle));
+    assert(key_usage[handle] == AESKeyUsage::EncryptDecrypt);
+
+    Dispatch(engine_type,
+             static_cast<const std::uint8_t *>(Slot(handle)),
+             [&](const auto &engine)
+             {
+                 using Engine = std::remove_cvref_t<decltype(engine)>;
+
+                 engine.Engine::Decrypt(ciphertext, plaintext);
+             });
+
+    RecordAESEvent(*this, AESCounter::BlocksDecrypted);
+}
+
+/*
+ *  AESKeyPool::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a series of independent blocks of
+ *      plaintext using the given key.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The handle returned by Allocate(), which must not have been freed.
+ *
+ *      plaintext [in]
+ *          The plaintext to encrypt, which must be a multiple of 16 octets.
+ *
+ *      ciphertext [out]
+ *          The ciphertext, which must be the same length as the plaintext.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the spans are not the
+ *      same length or not a multiple of 16 octets, or if the handle does not
+ *      refer to an allocated slot.
+ *
+ *  Comments:
+ *      The plaintext and ciphertext may refer to the same memory.
+ */
+void AESKeyPool::EncryptBlocks(std::size_t handle,
+                               const std::span<const std::uint8_t> plaintext,
+                               std::span<std::uint8_t> ciphertext) const
+{
+    // Ensure the spans are of equal length and are whole blocks
+    if ((plaintext.size() != ciphertext.size()) ||
+        ((plaintext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    if (!ValidHandle(handle)) throw AESException("Invalid key pool handle");
+
+    Dispatch(engine_type,
+             static_cast<const std::uint8_t *>(Slot(handle)),
+             [&](const auto &engine)
+             {
+                 using Engine = std::remove_cvref_t<decltype(engine)>;
+
+                 engine.Engine::EncryptBlocks(plaintext, ciphertext);
+             });
+
+    RecordAESEvent(*this, AESCounter::BlocksEncrypted, plaintext.size() / 16);
+}
+
+/*
+ *  AESKeyPool::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a series of independent blocks of
+ *      ciphertext using the given key.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The handle returned by Allocate(), which must not have been freed.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to decrypt, which must be a multiple of 16 octets.
+ *
+ *      plaintext [out]
+ *          The plaintext, which must be the same length as the ciphertext.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the spans are not the
+ *      same length or not a multiple of 16 octets, if the handle does not
+ *      refer to an allocated slot, or if the key was allocated for
+ *      encryption only.
+ *
+ *  Comments:
+ *      The ciphertext and plaintext may refer to the same memory.
+ */
+void AESKeyPool::DecryptBlocks(std::size_t handle,
+                               const std::span<const std::uint8_t> ciphertext,
+                               std::span<std::uint8_t> plaintext) const
+{
+    // Ensure the spans are of equal length and are whole blocks
+    if ((ciphertext.size() != plaintext.size()) ||
+        ((ciphertext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    if (!ValidHandle(handle)) throw AESException("Invalid key pool handle");
+
+    // The decryption key schedule must have been computed
+    if (key_usage[handle] == AESKeyUsage::EncryptOnly)
+    {
+        throw AESException("The key was set for encryption only");
+    }
+
+    Dispatch(engine_type,
+             static_cast<const std::uint8_t *>(Slot(handle)),
+             [&](const auto &engine)
+             {
+                 using Engine = std::remove_cvref_t<decltype(engine)>;
+
+                 engine.Engine::DecryptBlocks(ciphertext, plaintext);
+             });
+
+    RecordAESEvent(*this, AESCounter::BlocksDecrypted, ciphertext.size() / 16);
+}
+
+/*
+ *  AESKeyPool::ExpandKeys()
+ *
+ *  Description:
+ *      Expand each of the given keys into the engine constructed in the
+ *      corresponding slot, using the engine's batch key expansion if it has
+ *      one.
+ *
+ *  Parameters:
+ *      keys [in]
+ *          The encryption keys.
+ *
+ *      handles [in]
+ *          The slot holding the engine for each key.
+ *
+ *      key_usage [in]
+ *          Indicates whether the keys will be used for both encryption and
+ *          decryption or only for encryption.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if any key length is
+ *      invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESKeyPool::ExpandKeys(
+                    const std::span<const std::span<const std::uint8_t>> keys,
+                    const std::span<const std::size_t> handles,
+                    AESKeyUsage key_usage)
+{
+    switch (engine_type)
+    {
+#ifdef TERRA_USE_INTEL_INTRINSICS
+#ifdef HAVE_VAES
+        case AESEngineType::IntelVAES:
+#endif
+        case AESEngineType::Intel:
+        {
+            std::vector<AESIntel *> engines(handles.size());
+
+            for (std::size_t i = 0; i < handles.size(); i++)
+            {
+#ifdef HAVE_VAES
+                if (engine_type == AESEngineType::IntelVAES)
+                {
+                    engines[i] = &StoredEngine<AESIntelVAES>(Slot(handles[i]));
+                    continue;
+                }
+#endif
+                engines[i] = &StoredEngine<AESIntel>(Slot(handles[i]));
+            }
+
+            AESIntel::SetKeys(engines, keys, key_usage);
+            break;
+        }
+#endif
+
+        case AESEngineType::ARM:
+        case AESEngineType::VectorPermute:
+            for (std::size_t i = 0; i < handles.size(); i++)
+            {
+                Dispatch(engine_type,
+                         Slot(handles[i]),
+                         [&](auto &engine)
+                         {
+                             using Engine =
+                                 std::remove_cvref_t<decltype(engine)>;
+
+                             engine.Engine::SetKey(keys[i], key_usage);
+                         });
+            }
+            break;
+
+        default:
+        {
+            std::vector<AESUniversal *> engines(handles.size());
+
+            for (std::size_t i = 0; i < handles.size(); i++)
+            {
+                engines[i] = &StoredEngine<AESUniversal>(Slot(handles[i]));
+            }
+
+            AESUniversal::SetKeys(engines, keys, key_usage);
+            break;
+        }
+    }
+}
+
+/*
+ *  AESKeyPool::DestroySlot()
+ *
+ *  Description:
+ *      Destroy the engine held in the given slot and erase the slot.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The slot to destroy.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESKeyPool::DestroySlot(std::size_t handle) noexcept
+{
+    Dispatch(engine_type,
+             Slot(handle),
+             [](auto &engine)
+             {
+                 using Engine = std::remove_cvref_t<decltype(engine)>;
+
+                 engine.~Engine();
+             });
+
+    SecUtil::SecureErase(Slot(handle), slot_size);
+}
+
+} // namespace Terra::Crypto::Cipher
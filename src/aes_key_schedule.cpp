@@ -0,0 +1,466 @@
+/*
+ *  aes_key_schedule.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AESKeySchedule object, which holds an
+ *      expanded AES key that may be shared by multiple threads.  The key is
+ *      expanded once at construction and every other function only reads
+ *      the key schedule.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <terra/crypto/cipher/aes_key_schedule.h>
+#include "engine_dispatch.h"
+#include "instrumentation.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+/*
+ *  AESKeySchedule::AESKeySchedule()
+ *
+ *  Description:
+ *      This is a constructor for the AESKeySchedule object that accepts a
+ *      span of octets as input that contains the key.  The key schedule is
+ *      computed here and does not change for the life of the object.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *      key_usage [in]
+ *          Indicates whether the key will be used for both encryption and
+ *          decryption or only for encryption.  If AESKeyUsage::EncryptOnly,
+ *          the decryption key schedule is not computed, DecryptBlocks()
+ *          and DecryptMultiKey() will throw an exception, and Decrypt()
+ *          must not be called.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *      This corresponds to 128, 192, and 256 bits.
+ *
+ *  Comments:
+ *      None.
+ */
+AESKeySchedule::AESKeySchedule(const std::span<const std::uint8_t> key,
+                               AESKeyUsage key_usage) :
+    engine{key, key_usage}
+{
+}
+
+/*
+ *  AESKeySchedule::AESKeySchedule()
+ *
+ *  Description:
+ *      This is a copy constructor for the AESKeySchedule object that accepts
+ *      a reference to another AESKeySchedule object as a parameter.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESKeySchedule object from which to copy values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Copying only reads the other object, so it is safe to copy an object
+ *      that other threads are using.
+ */
+AESKeySchedule::AESKeySchedule(const AESKeySchedule &other) noexcept :
+    engine{other.engine}
+{
+}
+
+/*
+ *  AESKeySchedule::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt a block of plaintext and return the
+ *      ciphertext.
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The 16-octet data block to encrypt.
+ *
+ *      ciphertext [out]
+ *          The 16-octet encrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the plaintext span.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      This function may be called concurrently from multiple threads.
+ */
+void AESKeySchedule::Encrypt(
+            const std::span<const std::uint8_t, 16> plaintext,
+            std::span<std::uint8_t, 16> ciphertext) const noexcept
+{
+    engine.Encrypt(plaintext, ciphertext);
+}
+
+/*
+ *  AESKeySchedule::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt a block of ciphertext and return the
+ *      plaintext.
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The 16-octet data block to decrypt.
+ *
+ *      plaintext [out]
+ *          The 16-octet decrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the ciphertext span.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      This function may be called concurrently from multiple threads.
+ */
+void AESKeySchedule::Decrypt(
+            const std::span<const std::uint8_t, 16> ciphertext,
+            std::span<std::uint8_t, 16> plaintext) const noexcept
+{
+    engine.Decrypt(ciphertext, plaintext);
+}
+
+/*
+ *  AESKeySchedule::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a contiguous series of plaintext blocks
+ *      and return the ciphertext (i.e., ECB mode).
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The data to encrypt.  The length must be an integral number of
+ *          16-octet blocks.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.  An exception will be thrown if the span lengths
+ *      are invalid.
+ *
+ *  Comments:
+ *      This function may be called concurrently from multiple threads.
+ */
+void AESKeySchedule::EncryptBlocks(
+            const std::span<const std::uint8_t> plaintext,
+            std::span<std::uint8_t> ciphertext) const
+{
+    engine.EncryptBlocks(plaintext, ciphertext);
+}
+
+/*
+ *  AESKeySchedule::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a contiguous series of ciphertext blocks
+ *      and return the plaintext (i.e., ECB mode).
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The data to decrypt.  The length must be an integral number of
+ *          16-octet blocks.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.  An exception will be thrown if the span lengths
+ *      are invalid or if the key was set for encryption only.
+ *
+ *  Comments:
+ *      This function may be called concurrently from multiple threads.
+ */
+void AESKeySchedule::DecryptBlocks(
+            const std::span<const std::uint8_t> ciphertext,
+            std::span<std::uint8_t> plaintext) const
+{
+    engine.DecryptBlocks(ciphertext, plaintext);
+}
+
+/*
+ *  AESKeySchedule::EncryptMultiKey()
+ *
+ *  Description:
+ *      This function will encrypt one block of plaintext using each of the
+ *      given key schedules.
+ *
+ *  Parameters:
+ *      key_schedules [in]
+ *          The key schedules to use.  The same key schedule may appear more
+ *          than once.
+ *
+ *      plaintext [in]
+ *          The blocks to encrypt, one 16-octet block for each key schedule
+ *          in order.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.  An exception will be thrown if the span lengths
+ *      are invalid.
+ *
+ *  Comments:
+ *      This function may be called concurrently from multiple threads.
+ */
+void AESKeySchedule::EncryptMultiKey(
+            const std::span<const AESKeySchedule * const> key_schedules,
+            const std::span<const std::uint8_t> plaintext,
+            std::span<std::uint8_t> ciphertext)
+{
+    ProcessMultiKey(true, key_schedules, plaintext, ciphertext);
+}
+
+/*
+ *  AESKeySchedule::DecryptMultiKey()
+ *
+ *  Description:
+ *      This function will decrypt one block of ciphertext using each of the
+ *      given key schedules.
+ *
+ *  Parameters:
+ *      key_schedules [in]
+ *          The key schedules to use.  The same key schedule may appear more
+ *          than once.
+ *
+ *      ciphertext [in]
+ *          The blocks to decrypt, one 16-octet block for each key schedule
+ *          in order.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.  An exception will be thrown if the span lengths
+ *      are invalid or if the key was set for encryption only.
+ *
+ *  Comments:
+ *      This function may be called concurrently from multiple threads.
+ */
+void AESKeySchedule::DecryptMultiKey(
+            const std::span<const AESKeySchedule * const> key_schedules,
+            const std::span<const std::uint8_t> ciphertext,
+            std::span<std::uint8_t> plaintext)
+{
+    ProcessMultiKey(false, key_schedules, ciphertext, plaintext);
+}
+
+/*
+ *  AESKeySchedule::ProcessMultiKey()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt one block using each of the
+ *      given key schedules.
+ *
+ *  Parameters:
+ *      encrypt [in]
+ *          True to encrypt the blocks, false to decrypt them.
+ *
+ *      key_schedules [in]
+ *          The key schedules to use.
+ *
+ *      input [in]
+ *          The blocks to encrypt or decrypt, one for each key schedule.
+ *
+ *      output [out]
+ *          The resulting blocks, which may refer to the same memory
+ *          location as the input.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the span lengths are
+ *      invalid.
+ *
+ *  Comments:
+ *      Where eight consecutive key schedules are all held by the AES-NI
+ *      engine (or the VAES engine, which uses the same key schedule), those
+ *      eight blocks are processed in lockstep.  All other blocks are
+ *      processed one at a time using the engine holding the key.
+ */
+void AESKeySchedule::ProcessMultiKey(
+            bool encrypt,
+            const std::span<const AESKeySchedule * const> key_schedules,
+            const std::span<const std::uint8_t> input,
+            std::span<std::uint8_t> output)
+{
+    std::size_t lane{};
+
+    // There must be exactly one block for each key schedule
+    if ((input.size() != key_schedules.size() * 16) ||
+        (output.size() != input.size()))
+    {
+        throw AESException("There must be one block for each key schedule");
+    }
+
+    // The decryption key schedules must have been computed
+    if (!encrypt &&
+        std::any_of(key_schedules.begin(),
+                    key_schedules.end(),
+                    [](const AESKeySchedule *key_schedule)
+                    {
+                        return key_schedule->GetKeyUsage() ==
+                               AESKeyUsage::EncryptOnly;
+                    }))
+    {
+        throw AESException("The key was set for encryption only");
+    }
+
+    // Process the block for the given lane using its key schedule alone
+    auto ProcessBlock = [&](std::size_t block)
+    {
+        const auto in = input.subspan(block * 16).first<16>();
+        auto out = output.subspan(block * 16).first<16>();
+
+        if (encrypt)
+        {
+            key_schedules[block]->Encrypt(in, out);
+        }
+        else
+        {
+            key_schedules[block]->Decrypt(in, out);
+        }
+    };
+
+#ifdef TERRA_USE_INTEL_INTRINSICS
+    constexpr std::size_t Lanes = AESIntel::Multi_Key_Lanes;
+    const AESIntel *engines[Lanes];
+
+    // Return the AES-NI engine holding the key schedule, if there is one
+    auto IntelEngine = [](const AESKeySchedule *key_schedule)
+        -> const AESIntel *
+    {
+        const AESInline &engine = key_schedule->engine;
+
+        switch (engine.engine_type)
+        {
+#ifdef HAVE_VAES
+            case AESEngineType::IntelVAES:
+                return &StoredEngine<AESIntelVAES>(engine.engine_storage);
+#endif
+
+            case AESEngineType::Intel:
+                return &StoredEngine<AESIntel>(engine.engine_storage);
+
+            default:
+                return nullptr;
+        }
+    };
+
+    while (key_schedules.size() - lane >= Lanes)
+    {
+        std::size_t count{};
+
+        // Gather the engines for the next group of blocks
+        for (; count < Lanes; count++)
+        {
+            engines[count] = IntelEngine(key_schedules[lane + count]);
+            if (engines[count] == nullptr) break;
+        }
+
+        // If a key is not held by the AES-NI engine, process the blocks up
+        // to and including that one individually
+        if (count < Lanes)
+        {
+            for (std::size_t i = 0; i <= count; i++) ProcessBlock(lane++);
+            continue;
+        }
+
+        const auto in = input.subspan(lane * 16).first<Lanes * 16>();
+        auto out = output.subspan(lane * 16).first<Lanes * 16>();
+
+        if (encrypt)
+        {
+            AESIntel::EncryptMultiKey(engines, in, out);
+        }
+        else
+        {
+            AESIntel::DecryptMultiKey(engines, in, out);
+        }
+
+        for (std::size_t i = 0; i < Lanes; i++)
+        {
+            RecordAESEvent(*key_schedules[lane + i],
+                           encrypt ? AESCounter::BlocksEncrypted :
+                                     AESCounter::BlocksDecrypted);
+        }
+
+        lane += Lanes;
+    }
+#endif
+
+    // Process any remaining blocks individually
+    for (; lane < key_schedules.size(); lane++) ProcessBlock(lane);
+}
+
+/*
+ *  AESKeySchedule::operator==()
+ *
+ *  Description:
+ *      Compare two AESKeySchedule objects for equality.  Equality means that
+ *      the two objects use the same engine and have the same key schedule.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESKeySchedule object with which to compare.
+ *
+ *  Returns:
+ *      True if the objects are equal, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESKeySchedule::operator==(const AESKeySchedule &other) const noexcept
+{
+    return engine == other.engine;
+}
+
+/*
+ *  AESKeySchedule::operator!=()
+ *
+ *  Description:
+ *      Compare two AESKeySchedule objects for inequality.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESKeySchedule object with which to compare.
+ *
+ *  Returns:
+ *      True if the objects are not equal, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESKeySchedule::operator!=(const AESKeySchedule &other) const noexcept
+{
+    return !(*this == other);
+}
+
+} // namespace Terra::Crypto::Cipher
@@ -13,6 +13,13 @@
  *      Padding (RFC 5649).  Functions are provided to both perform
  *      key wrap and unwrap.
  *
+ *      The batch functions (e.g., WrapKeys()) assign up to Parallel_Blocks
+ *      keys to "lanes".  Each step of the key wrap algorithm forms the block
+ *      A | R[i] for every lane, and all of those blocks are processed with a
+ *      single call to AES::EncryptBlocks() or AES::DecryptBlocks().  When a
+ *      key is complete, its lane is given to the next key waiting to be
+ *      processed.
+ *
  *      These routines are also documented in NIST Special Publication 800-38F.
  *
  *  Portability Issues:
@@ -24,21 +31,64 @@
 #include <terra/crypto/cipher/aes_key_wrap.h>
 #include <terra/bitutil/byte_order.h>
 #include <terra/secutil/secure_erase.h>
+#include "instrumentation.h"
 
 namespace Terra::Crypto::Cipher
 {
 
+namespace
+{
+
+// State of one key being processed by the batch functions
+struct KeyWrapLane
+{
+    std::size_t item;                       // Index of the key
+    std::uint64_t A;                        // Integrity check register
+    std::uint8_t *R;                        // Registers R[1] to R[n]
+    std::size_t n;                          // Number of 64-bit blocks
+    std::size_t i;                          // Current register (1 to n)
+    std::size_t t;                          // Step counter
+    std::size_t steps;                      // Steps remaining
+};
+
 /*
- *  AESKeyWrap::AESKeyWrap()
+ *  LoadWord()
  *
  *  Description:
- *      This is a constructor for the AESKeyWrap object with no given key.
- *      Since a key is not provided to this version of the constructor, one
- *      must call SetKey() with a valid key before calling wrap or unwrap
- *      functions, as the results will otherwise be invalid.
+ *      Load eight octets from memory into a 64-bit word.  The octets are not
+ *      reordered, so the word holds the value in network byte order.
  *
  *  Parameters:
+ *      p [in]
+ *          Pointer to the eight octets to load.  No alignment is required.
+ *
+ *  Returns:
+ *      The 64-bit word.
+ *
+ *  Comments:
  *      None.
+ */
+inline std::uint64_t LoadWord(const std::uint8_t *p) noexcept
+{
+    std::uint64_t word;
+
+    std::memcpy(&word, p, sizeof(word));
+
+    return word;
+}
+
+/*
+ *  StoreWord()
+ *
+ *  Description:
+ *      Store a 64-bit word loaded via LoadWord() into memory.
+ *
+ *  Parameters:
+ *      p [out]
+ *          Pointer to the eight octets to write.  No alignment is required.
+ *
+ *      word [in]
+ *          The 64-bit word to store.
  *
  *  Returns:
  *      Nothing.
@@ -46,96 +96,501 @@ namespace Terra::Crypto::Cipher
  *  Comments:
  *      None.
  */
-AESKeyWrap::AESKeyWrap() :
-    aes(),
-    i{},
-    j{},
-    k{},
-    n{},
-    t{},
-    tt{},
-    A{},
-    B{},
-    R{},
-    network_word{},
-    padding_length{},
-    message_length_indicator{},
-    integrity_data{},
-    plaintext_buffer{}
+inline void StoreWord(std::uint8_t *p, const std::uint64_t word) noexcept
 {
-    // Nothing more to do
+    std::memcpy(p, &word, sizeof(word));
 }
 
 /*
- *  AESKeyWrap::AESKeyWrap()
+ *  XorCounter()
  *
  *  Description:
- *      This is a constructor for the AESKeyWrap object that accepts a span
- *      of octets holding a AES key that will be used for subsequent encryption
- *      operations.
+ *      XOR the step counter t into the integrity check register A, with t
+ *      treated as a 64-bit big endian integer.
  *
  *  Parameters:
- *      key [in]
- *          The encryption key to use with this instance of the object.  The
- *          length of the key must be 16, 24, or 32 octets.
+ *      A [in/out]
+ *          The integrity check register, held in network byte order.
+ *
+ *      t [in]
+ *          The step counter.
  *
  *  Returns:
- *      Nothing, though an AESException will be thrown if the key provided is
- *      an invalid length.
+ *      Nothing.
  *
  *  Comments:
  *      None.
  */
-AESKeyWrap::AESKeyWrap(const std::span<const std::uint8_t> key) :
-    aes(key),
-    i{},
-    j{},
-    k{},
-    n{},
-    t{},
-    tt{},
-    A{},
-    B{},
-    R{},
-    network_word{},
-    padding_length{},
-    message_length_indicator{},
-    integrity_data{},
-    plaintext_buffer{}
+inline void XorCounter(std::uint64_t &A, const std::size_t t) noexcept
 {
-    // Nothing more to do
+    A ^= BitUtil::NetworkByteOrder(static_cast<std::uint64_t>(t));
 }
 
 /*
- *  AESKeyWrap::~AESKeyWrap()
+ *  PaddedIntegrityWord()
  *
  *  Description:
- *      This is the destructor for the AESKeyWrap object and is responsible for
- *      zeroing memory to ensure a clean termination with no residue.
+ *      Form the initial value of A for AES Key Wrap with Padding, which is
+ *      the four octet alternative IV followed by the 32-bit message length
+ *      indicator (RFC 5649 Section 3).
  *
  *  Parameters:
+ *      alternative_iv [in]
+ *          The four octet alternative IV.
+ *
+ *      message_length [in]
+ *          The length of the plaintext in octets.
+ *
+ *  Returns:
+ *      The initial value of A in network byte order.
+ *
+ *  Comments:
  *      None.
+ */
+inline std::uint64_t PaddedIntegrityWord(
+                    const std::span<const std::uint8_t, 4> alternative_iv,
+                    const std::size_t message_length) noexcept
+{
+    std::uint64_t value{};
+
+    for (const std::uint8_t octet : alternative_iv)
+    {
+        value = (value << 8) | octet;
+    }
+
+    value = (value << 32) | static_cast<std::uint32_t>(message_length);
+
+    return BitUtil::NetworkByteOrder(value);
+}
+
+/*
+ *  WrapRegisters()
+ *
+ *  Description:
+ *      Perform the six passes of the AES Key Wrap procedure (RFC 3394
+ *      Section 2.2.1) over the registers R[1] to R[n] in place.
+ *
+ *  Parameters:
+ *      aes [in]
+ *          The AES object holding the key encryption key.
+ *
+ *      A [in]
+ *          The initial value of the integrity check register.
+ *
+ *      R [in/out]
+ *          The n 64-bit registers, which hold the plaintext on input and
+ *          the ciphertext on output.
+ *
+ *      n [in]
+ *          The number of 64-bit registers.
  *
  *  Returns:
- *      Nothing.
+ *      The final value of A.
+ *
+ *  Comments:
+ *      A is held in the first word of the block given to AES, so only the
+ *      register R[i] is moved in and out of the block on each step.
+ */
+std::uint64_t WrapRegisters(const AES &aes,
+                            const std::uint64_t A,
+                            std::uint8_t *R,
+                            const std::size_t n)
+{
+    std::array<std::uint64_t, 2> B{A, 0};
+    const std::span<std::uint8_t, 16> block(
+        reinterpret_cast<std::uint8_t *>(B.data()),
+        16);
+
+    for (std::size_t j = 0, t = 1; j < 6; j++)
+    {
+        for (std::uint8_t *Ri = R; Ri < R + (n << 3); Ri += 8, t++)
+        {
+            B[1] = LoadWord(Ri);
+            aes.Encrypt(block, block);
+            XorCounter(B[0], t);
+            StoreWord(Ri, B[1]);
+        }
+    }
+
+    const std::uint64_t result = B[0];
+
+    SecUtil::SecureErase(&B, sizeof(B));
+
+    return result;
+}
+
+/*
+ *  UnwrapRegisters()
+ *
+ *  Description:
+ *      Perform the six passes of the AES Key Unwrap procedure (RFC 3394
+ *      Section 2.2.2) over the registers R[1] to R[n] in place.
+ *
+ *  Parameters:
+ *      aes [in]
+ *          The AES object holding the key encryption key.
+ *
+ *      A [in]
+ *          The initial value of the integrity check register (i.e., C[0]).
+ *
+ *      R [in/out]
+ *          The n 64-bit registers, which hold the ciphertext C[1] to C[n]
+ *          on input and the plaintext on output.
+ *
+ *      n [in]
+ *          The number of 64-bit registers.
+ *
+ *  Returns:
+ *      The final value of A, which the caller must verify.
  *
  *  Comments:
  *      None.
  */
-AESKeyWrap::~AESKeyWrap()
+std::uint64_t UnwrapRegisters(const AES &aes,
+                              const std::uint64_t A,
+                              std::uint8_t *R,
+                              const std::size_t n)
 {
-    SecUtil::SecureErase(&i, sizeof(i));
-    SecUtil::SecureErase(&t, sizeof(t));
-    SecUtil::SecureErase(&tt, sizeof(tt));
-    SecUtil::SecureErase(&j, sizeof(j));
-    SecUtil::SecureErase(&k, sizeof(k));
+    std::array<std::uint64_t, 2> B{A, 0};
+    const std::span<std::uint8_t, 16> block(
+        reinterpret_cast<std::uint8_t *>(B.data()),
+        16);
+
+    for (std::size_t j = 0, t = 6 * n; j < 6; j++)
+    {
+        for (std::uint8_t *Ri = R + (n << 3); Ri > R; t--)
+        {
+            Ri -= 8;
+            XorCounter(B[0], t);
+            B[1] = LoadWord(Ri);
+            aes.Decrypt(block, block);
+            StoreWord(Ri, B[1]);
+        }
+    }
+
+    const std::uint64_t result = B[0];
+
     SecUtil::SecureErase(&B, sizeof(B));
-    SecUtil::SecureErase(&padding_length, sizeof(padding_length));
-    SecUtil::SecureErase(&network_word, sizeof(network_word));
-    SecUtil::SecureErase(&message_length_indicator,
-                         sizeof(message_length_indicator));
-    SecUtil::SecureErase(&integrity_data, sizeof(integrity_data));
-    SecUtil::SecureErase(&plaintext_buffer, sizeof(plaintext_buffer));
+
+    return result;
+}
+
+/*
+ *  ProcessLanes()
+ *
+ *  Description:
+ *      Perform the wrap or unwrap steps for a number of keys, processing
+ *      the next step of up to AESKeyWrap::Parallel_Blocks keys with each
+ *      call to the AES engine.
+ *
+ *  Parameters:
+ *      aes [in]
+ *          The AES object holding the key encryption key.
+ *
+ *      wrap [in]
+ *          True to perform the wrap steps, false to perform the unwrap steps.
+ *
+ *      assign [in]
+ *          A function that accepts a KeyWrapLane and assigns it the next key
+ *          to process, setting item, A, R, n, and steps.  It returns false
+ *          if there are no more keys.  A lane having n equal to 1 and a
+ *          single step is processed as one AES block (RFC 5649 Section 4.1).
+ *
+ *      complete [in]
+ *          A function that accepts a KeyWrapLane for which all steps are
+ *          complete.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename Assign, typename Complete>
+void ProcessLanes(const AES &aes,
+                  bool wrap,
+                  Assign &&assign,
+                  Complete &&complete)
+{
+    std::array<KeyWrapLane, AESKeyWrap::Parallel_Blocks> lanes{};
+    std::array<std::uint64_t, 2 * AESKeyWrap::Parallel_Blocks> blocks{};
+    std::size_t active{};
+
+    // Assign the next key to the given lane, initializing the counters
+    auto AssignLane = [&](KeyWrapLane &lane) -> bool
+    {
+        if (!assign(lane)) return false;
+
+        lane.i = wrap ? 1 : lane.n;
+        lane.t = wrap ? 1 : lane.steps;
+
+        return true;
+    };
+
+    // Initially assign keys to all available lanes
+    while ((active < lanes.size()) && AssignLane(lanes[active])) active++;
+
+    while (active > 0)
+    {
+        const std::span<std::uint8_t> data(
+            reinterpret_cast<std::uint8_t *>(blocks.data()),
+            active * 16);
+
+        // Form the block A | R[i] for each lane
+        for (std::size_t l = 0; l < active; l++)
+        {
+            KeyWrapLane &lane = lanes[l];
+
+            if (!wrap && (lane.n > 1)) XorCounter(lane.A, lane.t);
+
+            blocks[2 * l] = lane.A;
+            blocks[2 * l + 1] = LoadWord(lane.R + (lane.i - 1) * 8);
+        }
+
+        // Process one block from every lane
+        if (wrap)
+        {
+            aes.EncryptBlocks(data, data);
+        }
+        else
+        {
+            aes.DecryptBlocks(data, data);
+        }
+
+        // Update A and R[i] of each lane and advance to the next step
+        for (std::size_t l = 0; l < active; l++)
+        {
+            KeyWrapLane &lane = lanes[l];
+
+            lane.A = blocks[2 * l];
+            StoreWord(lane.R + (lane.i - 1) * 8, blocks[2 * l + 1]);
+
+            if (wrap)
+            {
+                if (lane.n > 1) XorCounter(lane.A, lane.t);
+                lane.i = (lane.i == lane.n) ? 1 : lane.i + 1;
+                lane.t++;
+            }
+            else
+            {
+                lane.i = (lane.i == 1) ? lane.n : lane.i - 1;
+                lane.t--;
+            }
+
+            lane.steps--;
+        }
+
+        // Replace completed keys, compacting the lanes if none remain
+        for (std::size_t l = 0; l < active;)
+        {
+            if (lanes[l].steps > 0)
+            {
+                l++;
+                continue;
+            }
+
+            complete(lanes[l]);
+
+            if (AssignLane(lanes[l]))
+            {
+                l++;
+                continue;
+            }
+
+            active--;
+            lanes[l] = lanes[active];
+        }
+    }
+
+    SecUtil::SecureErase(&lanes, sizeof(lanes));
+    SecUtil::SecureErase(&blocks, sizeof(blocks));
+}
+
+/*
+ *  CheckPaddedIntegrity()
+ *
+ *  Description:
+ *      Verify the integrity data recovered by AES Key Unwrap with Padding
+ *      and the padding that follows the message, per RFC 5649 Section 3.
+ *
+ *  Parameters:
+ *      integrity [in]
+ *          The 64-bit integrity data (i.e., the final value of A) in network
+ *          byte order.
+ *
+ *      plaintext [in]
+ *          The unwrapped plaintext, including padding.
+ *
+ *      alternative_iv [in]
+ *          The four octet alternative IV expected, or an empty span if the
+ *          default AIV from RFC 5649 is expected.
+ *
+ *  Returns:
+ *      The length of the message, or zero if the integrity check failed.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t CheckPaddedIntegrity(
+                            const std::uint64_t integrity,
+                            const std::span<const std::uint8_t> plaintext,
+                            const std::span<const std::uint8_t> alternative_iv)
+{
+    const std::uint64_t value = BitUtil::NetworkByteOrder(integrity);
+    const std::span<const std::uint8_t, 4> expected_iv =
+        (alternative_iv.size() == 4)
+            ? std::span<const std::uint8_t, 4>(alternative_iv.data(), 4)
+            : std::span<const std::uint8_t, 4>(AESKeyWrap::Alternative_IV);
+
+    std::uint64_t expected_aiv{};
+
+    for (const std::uint8_t octet : expected_iv)
+    {
+        expected_aiv = (expected_aiv << 8) | octet;
+    }
+
+    // Verify that the first 4 octets of the integrity data are correct
+    if ((value >> 32) != expected_aiv) return 0;
+
+    // Ensure the message length indicator has a valid range
+    const std::size_t message_length_indicator = value & 0xffffffff;
+    if ((message_length_indicator > plaintext.size()) ||
+        (message_length_indicator < (plaintext.size() - 7)))
+    {
+        return 0;
+    }
+
+    // Ensure that all padding bits are zero
+    if (!std::all_of(plaintext.begin() + message_length_indicator,
+                     plaintext.end(),
+                     [](std::uint8_t v) -> bool { return v == 0; }))
+    {
+        return 0;
+    }
+
+    return message_length_indicator;
+}
+
+/*
+ *  CheckIntegrity()
+ *
+ *  Description:
+ *      Verify the integrity data recovered by AES Key Unwrap, counting a
+ *      failure if it is incorrect.
+ *
+ *  Parameters:
+ *      aes [in]
+ *          The AES object that performed the unwrap.
+ *
+ *      integrity [in]
+ *          The 64-bit integrity data (i.e., the final value of A).
+ *
+ *      alternative_iv [in]
+ *          The eight octet alternative IV expected, or an empty span if the
+ *          default IV from RFC 3394 is expected.
+ *
+ *  Returns:
+ *      True if the integrity data is correct, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool CheckIntegrity(const AES &aes,
+                    const std::uint64_t integrity,
+                    const std::span<const std::uint8_t> alternative_iv)
+{
+    const std::uint64_t expected =
+        (alternative_iv.size() == 8)
+            ? LoadWord(alternative_iv.data())
+            : LoadWord(AESKeyWrap::AES_Key_Wrap_Default_IV.data());
+
+    if (integrity != expected)
+    {
+        RecordAESEvent(aes, AESCounter::IntegrityFailures);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ *  RecordPaddedUnwrap()
+ *
+ *  Description:
+ *      Count an AES Key Unwrap with Padding, along with a failure if the
+ *      integrity check failed.
+ *
+ *  Parameters:
+ *      aes [in]
+ *          The AES object that performed the unwrap.
+ *
+ *      message_length [in]
+ *          The result of CheckPaddedIntegrity().
+ *
+ *  Returns:
+ *      The message length given.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t RecordPaddedUnwrap(const AES &aes,
+                               const std::size_t message_length)
+{
+    RecordAESEvent(aes, AESCounter::KeyUnwraps);
+
+    if (message_length == 0) RecordAESEvent(aes, AESCounter::IntegrityFailures);
+
+    return message_length;
+}
+
+} // namespace
+
+/*
+ *  AESKeyWrap::AESKeyWrap()
+ *
+ *  Description:
+ *      This is a constructor for the AESKeyWrap object with no given key.
+ *      Since a key is not provided to this version of the constructor, one
+ *      must call SetKey() with a valid key before calling wrap or unwrap
+ *      functions, as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESKeyWrap::AESKeyWrap() : aes()
+{
+    // Nothing more to do
+}
+
+/*
+ *  AESKeyWrap::AESKeyWrap()
+ *
+ *  Description:
+ *      This is a constructor for the AESKeyWrap object that accepts a span
+ *      of octets holding a AES key that will be used for subsequent encryption
+ *      operations.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  The
+ *          length of the key must be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the key provided is
+ *      an invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+AESKeyWrap::AESKeyWrap(const std::span<const std::uint8_t> key) : aes(key)
+{
+    // Nothing more to do
 }
 
 /*
@@ -183,13 +638,15 @@ void AESKeyWrap::SetKey(const std::span<const std::uint8_t> key)
  *          An eight octet initialization vector to use with AES Key Wrap.
  *          If this value is not exactly eight octets, then the default IV will
  *          be used as per RFC 3394.  Generally, one should not pass this
- *          parameter, though this is used by WrapWithPadding().
+ *          parameter.
  *
  *  Returns:
  *      Nothing, though the output will be placed in ciphertext.
  *
  *  Comments:
- *      The plaintext and ciphertext buffers must be distinct.
+ *      The plaintext and ciphertext buffers must be distinct.  The plaintext
+ *      is copied into the ciphertext buffer and wrapped there; to avoid that
+ *      copy, use WrapInPlace().
  */
 void AESKeyWrap::Wrap(const std::span<const std::uint8_t> plaintext,
                       std::span<std::uint8_t> ciphertext,
@@ -203,38 +660,59 @@ void AESKeyWrap::Wrap(const std::span<const std::uint8_t> plaintext,
         throw AESException("One or more spans have an invalid length");
     }
 
-    // Determine the number of 64-bit blocks to process
-    n = (plaintext.size() >> 3);
+    // Copy the plaintext into the registers R[1] to R[n]
+    std::copy(plaintext.begin(), plaintext.end(), ciphertext.begin() + 8);
 
-    // Assign the IV
-    A = B.data();
-    if (!alternative_iv.empty())
-    {
-        std::copy(alternative_iv.begin(), alternative_iv.end(), A);
-    }
-    else
-    {
-        std::copy(AES_Key_Wrap_Default_IV.begin(),
-                  AES_Key_Wrap_Default_IV.end(),
-                  A);
-    }
+    WrapInPlace(ciphertext, alternative_iv);
+}
 
-    // Perform the key wrap
-    std::copy(plaintext.begin(), plaintext.end(), ciphertext.data() + 8);
-    for (j = 0, t = 1; j < 6; j++)
+/*
+ *  AESKeyWrap::WrapInPlace()
+ *
+ *  Description:
+ *      This performs the AES Key Wrap as per RFC 3394 within a single buffer.
+ *      The buffer holds eight octets reserved for the integrity check
+ *      register followed by the plaintext, and on return holds the
+ *      ciphertext.
+ *
+ *  Parameters:
+ *      data [in/out]
+ *          The buffer holding the plaintext starting at octet eight.  The
+ *          first eight octets are overwritten, so their content on input is
+ *          not used.  The plaintext must be at least 16 octets and an
+ *          integral number of eight octets, so this span must be at least
+ *          24 octets.  On return, this holds the ciphertext.
+ *
+ *      alternative_iv [in]
+ *          An eight octet initialization vector to use with AES Key Wrap.
+ *          If empty, the default IV will be used as per RFC 3394.
+ *
+ *  Returns:
+ *      Nothing, though the output will be placed in data.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESKeyWrap::WrapInPlace(std::span<std::uint8_t> data,
+                             const std::span<const std::uint8_t> alternative_iv)
+{
+    // Ensure buffers appear sane ("& 0x07" performs a mod 8 check)
+    if ((data.size() < 24) || ((data.size() & 0x07) != 0) ||
+        (!alternative_iv.empty() && (alternative_iv.size() != 8)))
     {
-        for (i = 1, R = ciphertext.data() + 8; i <= n; i++, t++, R += 8)
-        {
-            std::copy(R, R + 8, B.data() + 8);
-            aes.Encrypt(B, B);
-            for (k = 8, tt = t; (k > 0) && (tt > 0); k--, tt >>= 8)
-            {
-                A[k - 1] ^= static_cast<std::uint8_t>(tt & 0xff);
-            }
-            std::copy(B.begin() + 8, B.end(), R);
-        }
+        throw AESException("One or more spans have an invalid length");
     }
-    std::copy(A, A + 8, ciphertext.begin());
+
+    // Assign the IV
+    const std::uint64_t A = alternative_iv.empty() ?
+                                LoadWord(AES_Key_Wrap_Default_IV.data()) :
+                                LoadWord(alternative_iv.data());
+
+    // Perform the key wrap, placing A in C[0]
+    StoreWord(data.data(),
+              WrapRegisters(aes, A, data.data() + 8, (data.size() - 8) >> 3));
+
+    RecordAESEvent(aes, AESCounter::KeyWraps);
 }
 
 /*
@@ -269,8 +747,7 @@ void AESKeyWrap::Wrap(const std::span<const std::uint8_t> plaintext,
  *          integrity checking and simply return the integrity data to the
  *          caller to be checked.  If both this and the initialization_vector
  *          are present, this parameter takes precedence.  This would normally
- *          not be provided by the caller, though is used by the routing
- *          UnwrapWithPadding().
+ *          not be provided by the caller.
  *
  *      alternative_iv [in]
  *          The eight octet initialization vector to use with AES Key Wrap.  If
@@ -284,7 +761,9 @@ void AESKeyWrap::Wrap(const std::span<const std::uint8_t> plaintext,
  *      caller without the integrity data being checked.
  *
  *  Comments:
- *      The plaintext and ciphertext buffers must be distinct.
+ *      The plaintext and ciphertext buffers must be distinct.  The ciphertext
+ *      is copied into the plaintext buffer and unwrapped there; to avoid that
+ *      copy, use UnwrapInPlace().
  */
 bool AESKeyWrap::Unwrap(const std::span<const std::uint8_t> ciphertext,
                         std::span<std::uint8_t> plaintext,
@@ -300,48 +779,77 @@ bool AESKeyWrap::Unwrap(const std::span<const std::uint8_t> ciphertext,
         throw AESException("One or more spans are invalid");
     }
 
-    // Determine the number of 64-bit blocks to process
-    n = (ciphertext.size() - 8) >> 3;
+    // Copy C[1] to C[n] into the registers R[1] to R[n]
+    std::copy(ciphertext.begin() + 8, ciphertext.end(), plaintext.begin());
 
-    // Assign A to be C[0] (first 64-bit block of the ciphertext)
-    A = B.data();
-    std::copy(ciphertext.begin(), ciphertext.begin() + 8, A);
+    // Perform the key unwrap, with A initially being C[0]
+    const std::uint64_t A = UnwrapRegisters(aes,
+                                            LoadWord(ciphertext.data()),
+                                            plaintext.data(),
+                                            plaintext.size() >> 3);
 
-    // Perform the key wrap
-    std::copy(ciphertext.begin() + 8, ciphertext.end(), plaintext.begin());
-    for (j = 0, t = 6 * n; j < 6; j++)
-    {
-        for (i = n, R = plaintext.data() + ciphertext.size() - 16;
-             i >= 1;
-             i--, t--, R -= 8)
-        {
-            for (k = 8, tt = t; (k > 0) && (tt > 0); k--, tt >>= 8)
-            {
-                A[k - 1] ^= static_cast<std::uint8_t>(tt & 0xff);
-            }
-            std::copy(R, R + 8, B.begin() + 8);
-            aes.Decrypt(B, B);
-            std::copy(B.begin() + 8, B.end(), R);
-        }
-    }
+    RecordAESEvent(aes, AESCounter::KeyUnwraps);
 
     // If the integrity parameter is provided, return A[] to the caller
     // so that the caller can perform integrity checking
     if (!integrity.empty())
     {
-        std::copy(A, A + 8, integrity.begin());
-        return true;
+        StoreWord(integrity.data(), A);
+        return true;
+    }
+
+    // Perform integrity checking internally
+    return CheckIntegrity(aes, A, alternative_iv);
+}
+
+/*
+ *  AESKeyWrap::UnwrapInPlace()
+ *
+ *  Description:
+ *      This performs the AES Key Unwrap as per RFC 3394 within a single
+ *      buffer.  On return, the plaintext begins at octet eight of the
+ *      buffer and the first eight octets hold the recovered integrity check
+ *      register (A[] as defined in RFC 3394).
+ *
+ *  Parameters:
+ *      data [in/out]
+ *          The ciphertext that is to be decrypted with the given key.  This
+ *          must be at least 24 octets and an integral number of eight
+ *          octets.  On return, this holds the integrity data followed by the
+ *          plaintext.
+ *
+ *      alternative_iv [in]
+ *          The eight octet initialization vector to use with AES Key Wrap.  If
+ *          this value is empty, the default IV will be used as per RFC 3394.
+ *
+ *  Returns:
+ *      True if successful, false if there was an integrity error.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESKeyWrap::UnwrapInPlace(
+                            std::span<std::uint8_t> data,
+                            const std::span<const std::uint8_t> alternative_iv)
+{
+    // Ensure buffers appear sane ("& 0x07" performs a mod 8 check)
+    if ((data.size() < 24) || ((data.size() & 0x07) != 0) ||
+        (!alternative_iv.empty() && (alternative_iv.size() != 8)))
+    {
+        throw AESException("One or more spans are invalid");
     }
 
-    // Perform integrity checking internally
-    if (alternative_iv.size() == 8)
-    {
-        return std::equal(alternative_iv.begin(), alternative_iv.end(), A);
-    }
+    // Perform the key unwrap, with A initially being C[0]
+    const std::uint64_t A = UnwrapRegisters(aes,
+                                            LoadWord(data.data()),
+                                            data.data() + 8,
+                                            (data.size() - 8) >> 3);
+
+    StoreWord(data.data(), A);
 
-    return std::equal(AES_Key_Wrap_Default_IV.begin(),
-                      AES_Key_Wrap_Default_IV.end(),
-                      A);
+    RecordAESEvent(aes, AESCounter::KeyUnwraps);
+
+    return CheckIntegrity(aes, A, alternative_iv);
 }
 
 /*
@@ -383,7 +891,9 @@ bool AESKeyWrap::Unwrap(const std::span<const std::uint8_t> ciphertext,
  *      input spans, an exception will be thrown.
  *
  *  Comments:
- *      The plaintext and ciphertext buffers must be distinct.
+ *      The plaintext and ciphertext buffers must be distinct.  The plaintext
+ *      is copied into the ciphertext buffer and wrapped there; to avoid that
+ *      copy, use WrapWithPaddingInPlace().
  */
 std::size_t AESKeyWrap::WrapWithPadding(
                             const std::span<const std::uint8_t> plaintext,
@@ -396,79 +906,109 @@ std::size_t AESKeyWrap::WrapWithPadding(
         throw AESException("Invalid plaintext length");
     }
 
-    // Ensure the alternative IV has a valid length
-    if ((!alternative_iv.empty() && (alternative_iv.size() != 4)))
-    {
-        throw AESException("Invalid Alternative IV length");
-    }
-
-    // Compute padding to be an even 8 octets (note: "& 0x07" == "% 8")
-    if ((plaintext.size() & 0x07) != 0)
-    {
-        padding_length = 8 - (plaintext.size() & 0x07);
-    }
-    else
-    {
-        padding_length = 0;
-    }
-
     // Ensure the ciphertext buffer is of sufficient length
-    if (ciphertext.size() < plaintext.size() + padding_length + 8)
+    if (ciphertext.size() < ((plaintext.size() + 7) & ~std::size_t(7)) + 8)
     {
         throw AESException("Ciphertext buffer is too short");
     }
 
-    // Store the initialization vector as the first 4 octets of the ciphertext
-    if (alternative_iv.empty())
+    // Copy the plaintext into the ciphertext buffer for encryption
+    std::copy(plaintext.begin(), plaintext.end(), ciphertext.begin() + 8);
+
+    return WrapWithPaddingInPlace(ciphertext, plaintext.size(), alternative_iv);
+}
+
+/*
+ *  AESKeyWrap::WrapWithPaddingInPlace()
+ *
+ *  Description:
+ *      This fuction performs the AES Key Wrap with Padding as specified in
+ *      RFC 5649 within a single buffer.  The buffer holds eight octets
+ *      reserved for the integrity data followed by the plaintext, and on
+ *      return holds the ciphertext.
+ *
+ *  Parameters:
+ *      data [in/out]
+ *          The buffer holding the plaintext starting at octet eight.  The
+ *          first eight octets and any padding octets following the plaintext
+ *          are overwritten, so their content on input is not used.  The span
+ *          must be large enough to hold the ciphertext, as described for
+ *          WrapWithPadding().
+ *
+ *      plaintext_length [in]
+ *          The length of the plaintext, which must be between 1 and
+ *          AES_Key_Wrap_with_Padding_Max.
+ *
+ *      alternative_iv [in]
+ *          This is an alternative_iv vector to use.  If provided, the length
+ *          must be exactly four octets.  Otherwise, the default value
+ *          specified in RFC 5649 is used.
+ *
+ *  Returns:
+ *      The length of the ciphertext.  If there is an error in one of the
+ *      input spans, an exception will be thrown.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t AESKeyWrap::WrapWithPaddingInPlace(
+                            std::span<std::uint8_t> data,
+                            const std::size_t plaintext_length,
+                            const std::span<const std::uint8_t> alternative_iv)
+{
+    // Check to ensure that the plaintext length is properly bounded
+    if ((plaintext_length == 0) ||
+        (plaintext_length > AES_Key_Wrap_with_Padding_Max))
     {
-        std::copy(Alternative_IV.begin(),
-                  Alternative_IV.end(),
-                  ciphertext.begin());
+        throw AESException("Invalid plaintext length");
     }
-    else
+
+    // Ensure the alternative IV has a valid length
+    if ((!alternative_iv.empty() && (alternative_iv.size() != 4)))
     {
-        std::copy(alternative_iv.begin(),
-                  alternative_iv.end(),
-                  ciphertext.begin());
+        throw AESException("Invalid Alternative IV length");
     }
 
-    // Store the original message length in network byte order as the
-    // second 4 octets of the buffer
-    network_word = BitUtil::NetworkByteOrder(
-                                static_cast<std::uint32_t>(plaintext.size()));
-    std::copy(reinterpret_cast<std::uint8_t *>(&network_word),
-              reinterpret_cast<std::uint8_t *>(&network_word) + 4,
-              ciphertext.begin() + 4);
-
-    // Copy the plaintext into the ciphertext buffer for encryption
-    std::copy(plaintext.begin(), plaintext.end(), ciphertext.begin() + 8);
+    // Compute the length padded to be an even 8 octets
+    const std::size_t padded_length =
+        (plaintext_length + 7) & ~std::size_t(7);
 
-    // Pad the buffer to be an even 8 octets with zeros
-    if (padding_length > 0)
+    // Ensure the buffer is of sufficient length
+    if (data.size() < padded_length + 8)
     {
-        std::fill(ciphertext.begin() + plaintext.size() + 8,
-                  ciphertext.begin() + plaintext.size() + 8 + padding_length,
-                  std::uint8_t(0));
+        throw AESException("Ciphertext buffer is too short");
     }
 
+    // Pad the buffer to be an even 8 octets with zeros
+    std::fill(data.begin() + 8 + plaintext_length,
+              data.begin() + 8 + padded_length,
+              std::uint8_t(0));
+
+    // A is the alternative IV followed by the message length indicator
+    const std::uint64_t A = PaddedIntegrityWord(
+        alternative_iv.empty() ?
+            std::span<const std::uint8_t, 4>(Alternative_IV) :
+            std::span<const std::uint8_t, 4>(alternative_iv.data(), 4),
+        plaintext_length);
+
     // Encrypt the plaintext
-    if (plaintext.size() <= 8)
+    if (padded_length == 8)
     {
         // Encrypt using AES ECB mode
-        aes.Encrypt(std::span<const std::uint8_t, 16>(ciphertext.data(), 16),
-                    std::span<std::uint8_t, 16>(ciphertext.data(), 16));
+        StoreWord(data.data(), A);
+        aes.Encrypt(std::span<const std::uint8_t, 16>(data.data(), 16),
+                    std::span<std::uint8_t, 16>(data.data(), 16));
     }
     else
     {
-        // Encrypt using AES Key Wrap; note that while this buffer use violates
-        // the requirement that buffers be distinct when calling Wrap(), this
-        // is safe given how data is positioned in the buffer
-        Wrap({ciphertext.data() + 8, plaintext.size() + padding_length},
-             {ciphertext.data(), plaintext.size() + padding_length + 8},
-             {ciphertext.data(), 8});
+        // Encrypt using AES Key Wrap
+        StoreWord(data.data(),
+                  WrapRegisters(aes, A, data.data() + 8, padded_length >> 3));
     }
 
-    return plaintext.size() + padding_length + 8;
+    RecordAESEvent(aes, AESCounter::KeyWraps);
+
+    return padded_length + 8;
 }
 
 /*
@@ -500,13 +1040,16 @@ std::size_t AESKeyWrap::WrapWithPadding(
  *      thrown.
  *
  *  Comments:
- *      The plaintext and ciphertext buffers must be distinct.
+ *      The plaintext and ciphertext buffers must be distinct.  To avoid
+ *      copying the ciphertext, use UnwrapWithPaddingInPlace().
  */
 std::size_t AESKeyWrap::UnwrapWithPadding(
                             const std::span<const std::uint8_t> ciphertext,
                             std::span<std::uint8_t> plaintext,
                             const std::span<const std::uint8_t> alternative_iv)
 {
+    std::uint64_t A;
+
     // Ensure buffers appear sane ("& 0x07" performs a mod 8 check)
     if ((ciphertext.size() < 16) || ((ciphertext.size() & 0x07) != 0) ||
         (plaintext.size() < (ciphertext.size() - 8)) ||
@@ -515,82 +1058,526 @@ std::size_t AESKeyWrap::UnwrapWithPadding(
         throw AESException("One or more spans have an invalid length");
     }
 
-    // Ensure the alternative IV has a valid length
-    if ((!alternative_iv.empty() && (alternative_iv.size() != 4)))
-    {
-        throw AESException("Invalid Alternative IV length");
-    }
-
     // Decrypt the ciphertext
     if (ciphertext.size() == 16)
     {
+        std::array<std::uint64_t, 2> B;
+        const std::span<std::uint8_t, 16> block(
+            reinterpret_cast<std::uint8_t *>(B.data()),
+            16);
+
         // Decrypt using AES ECB mode
         aes.Decrypt(std::span<const std::uint8_t, 16>(ciphertext.data(), 16),
-                    plaintext_buffer);
+                    block);
+
+        A = B[0];
+        StoreWord(plaintext.data(), B[1]);
+
+        SecUtil::SecureErase(&B, sizeof(B));
+    }
+    else
+    {
+        // Copy C[1] to C[n] into the registers R[1] to R[n]
+        std::copy(ciphertext.begin() + 8, ciphertext.end(), plaintext.begin());
 
-        // Copy the integrity array
-        std::copy(plaintext_buffer.begin(),
-                  plaintext_buffer.begin() + 8,
-                  integrity_data.begin());
+        // Decrypt using AES Key Wrap
+        A = UnwrapRegisters(aes,
+                            LoadWord(ciphertext.data()),
+                            plaintext.data(),
+                            (ciphertext.size() - 8) >> 3);
+    }
+
+    // Verify the integrity data and padding
+    return RecordPaddedUnwrap(
+        aes,
+        CheckPaddedIntegrity(A,
+                             {plaintext.data(), ciphertext.size() - 8},
+                             alternative_iv));
+}
+
+/*
+ *  AESKeyWrap::UnwrapWithPaddingInPlace()
+ *
+ *  Description:
+ *      This fuction performs the AES Key Unwrap with Padding as specified in
+ *      RFC 5649 within a single buffer.  On return, the plaintext begins at
+ *      octet eight of the buffer and the first eight octets hold the
+ *      recovered integrity data.
+ *
+ *  Parameters:
+ *      data [in/out]
+ *          The ciphertext to decrypt, which must be at least 16 octets and an
+ *          integral number of eight octets.  On return, this holds the
+ *          integrity data followed by the plaintext and any padding.
+ *
+ *      alternative_iv [in]
+ *          This is an alternative_iv vector to use.  If provided, the length
+ *          must be exactly four octets.  Otherwise, the default value
+ *          specified in RFC 5649 is used.
+ *
+ *  Returns:
+ *      The length of the plaintext or zero if the integrity check failed.
+ *      If there is an error in one of the input spans, an exception will be
+ *      thrown.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t AESKeyWrap::UnwrapWithPaddingInPlace(
+                            std::span<std::uint8_t> data,
+                            const std::span<const std::uint8_t> alternative_iv)
+{
+    // Ensure buffers appear sane ("& 0x07" performs a mod 8 check)
+    if ((data.size() < 16) || ((data.size() & 0x07) != 0) ||
+        (!alternative_iv.empty() && (alternative_iv.size() != 4)))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
 
-        // Copy the plaintext into the output buffer
-        std::copy(plaintext_buffer.begin() + 8,
-                  plaintext_buffer.end(),
-                  plaintext.begin());
+    // Decrypt the ciphertext
+    if (data.size() == 16)
+    {
+        // Decrypt using AES ECB mode
+        aes.Decrypt(std::span<const std::uint8_t, 16>(data.data(), 16),
+                    std::span<std::uint8_t, 16>(data.data(), 16));
     }
     else
     {
         // Decrypt using AES Key Wrap
-        if (!Unwrap(ciphertext,
-                    {plaintext.data(), ciphertext.size() - 8},
-                    integrity_data))
+        StoreWord(data.data(),
+                  UnwrapRegisters(aes,
+                                  LoadWord(data.data()),
+                                  data.data() + 8,
+                                  (data.size() - 8) >> 3));
+    }
+
+    // Verify the integrity data and padding
+    return RecordPaddedUnwrap(aes,
+                             CheckPaddedIntegrity(LoadWord(data.data()),
+                                                  data.subspan(8),
+                                                  alternative_iv));
+}
+
+/*
+ *  AESKeyWrap::WrapKeys()
+ *
+ *  Description:
+ *      This function performs the AES Key Wrap as per RFC 3394 on a number
+ *      of independent keys, producing the same result as calling Wrap()
+ *      for each.  Up to Parallel_Blocks keys are processed in lockstep so
+ *      that the AES engine can encrypt the blocks of different keys in
+ *      parallel.
+ *
+ *  Parameters:
+ *      plaintexts [in]
+ *          The keys to be wrapped.  Each must be at least 16 octets and an
+ *          integral number of eight octets, though the keys may differ in
+ *          length.
+ *
+ *      ciphertexts [out]
+ *          A buffer to hold each wrapped key.  Each must be exactly eight
+ *          octets larger than the corresponding plaintext.
+ *
+ *      alternative_iv [in]
+ *          An eight octet initialization vector to use for all keys.  If
+ *          empty, the default IV will be used as per RFC 3394.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the number of
+ *      plaintexts and ciphertexts differ or if any span has an invalid
+ *      length.  Lengths are verified before any key is wrapped.
+ *
+ *  Comments:
+ *      The plaintext and ciphertext buffers must be distinct and the
+ *      ciphertext buffers of different keys must not overlap.
+ */
+void AESKeyWrap::WrapKeys(
+                    const std::span<const std::span<const std::uint8_t>>
+                        plaintexts,
+                    const std::span<const std::span<std::uint8_t>> ciphertexts,
+                    const std::span<const std::uint8_t> alternative_iv)
+{
+    std::size_t next_item{};
+
+    // Ensure buffers appear sane ("& 0x07" performs a mod 8 check)
+    if ((ciphertexts.size() != plaintexts.size()) ||
+        (!alternative_iv.empty() && (alternative_iv.size() != 8)))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+    for (std::size_t i = 0; i < plaintexts.size(); i++)
+    {
+        if ((plaintexts[i].size() < 16) ||
+            ((plaintexts[i].size() & 0x07) != 0) ||
+            (ciphertexts[i].size() != (plaintexts[i].size() + 8)))
         {
-            return 0;
+            throw AESException("One or more spans have an invalid length");
         }
     }
 
-    // Verify that the first 4 octets of the integrity data are correct
-    if (alternative_iv.size() == 4)
+    const std::span<const std::uint8_t> iv =
+        alternative_iv.empty() ? std::span<const std::uint8_t>(
+                                     AES_Key_Wrap_Default_IV)
+                               : alternative_iv;
+
+    ProcessLanes(
+        aes,
+        true,
+        [&](KeyWrapLane &lane) -> bool
+        {
+            if (next_item >= plaintexts.size()) return false;
+
+            const std::span<const std::uint8_t> plaintext =
+                plaintexts[next_item];
+
+            lane.item = next_item++;
+            lane.A = LoadWord(iv.data());
+            lane.R = ciphertexts[lane.item].data() + 8;
+            lane.n = plaintext.size() >> 3;
+            lane.steps = 6 * lane.n;
+            std::copy(plaintext.begin(), plaintext.end(), lane.R);
+
+            return true;
+        },
+        [&](const KeyWrapLane &lane)
+        {
+            StoreWord(ciphertexts[lane.item].data(), lane.A);
+        });
+
+    RecordAESEvent(aes, AESCounter::KeyWraps, plaintexts.size());
+}
+
+/*
+ *  AESKeyWrap::UnwrapKeys()
+ *
+ *  Description:
+ *      This function performs the AES Key Unwrap as per RFC 3394 on a number
+ *      of independent wrapped keys, producing the same result as calling
+ *      Unwrap() for each.  Up to Parallel_Blocks keys are processed in
+ *      lockstep so that the AES engine can decrypt the blocks of different
+ *      keys in parallel.
+ *
+ *  Parameters:
+ *      ciphertexts [in]
+ *          The wrapped keys.  Each must be at least 24 octets and an
+ *          integral number of eight octets, though the keys may differ in
+ *          length.
+ *
+ *      plaintexts [out]
+ *          A buffer to hold each unwrapped key.  Each must be exactly eight
+ *          octets less than the corresponding ciphertext.
+ *
+ *      results [out]
+ *          The result of the integrity check for each key, which will be
+ *          true if the key was successfully unwrapped.  This must have the
+ *          same number of elements as ciphertexts.
+ *
+ *      alternative_iv [in]
+ *          The eight octet initialization vector expected for all keys.  If
+ *          empty, the default IV will be used as per RFC 3394.
+ *
+ *  Returns:
+ *      The number of keys that failed the integrity check.  An AESException
+ *      will be thrown if the number of ciphertexts, plaintexts, and results
+ *      differ or if any span has an invalid length.  Lengths are verified
+ *      before any key is unwrapped.
+ *
+ *  Comments:
+ *      The plaintext and ciphertext buffers must be distinct and the
+ *      plaintext buffers of different keys must not overlap.
+ */
+std::size_t AESKeyWrap::UnwrapKeys(
+                    const std::span<const std::span<const std::uint8_t>>
+                        ciphertexts,
+                    const std::span<const std::span<std::uint8_t>> plaintexts,
+                    std::span<bool> results,
+                    const std::span<const std::uint8_t> alternative_iv)
+{
+    std::size_t next_item{};
+    std::size_t failures{};
+
+    // Ensure buffers appear sane ("& 0x07" performs a mod 8 check)
+    if ((plaintexts.size() != ciphertexts.size()) ||
+        (results.size() != ciphertexts.size()) ||
+        (!alternative_iv.empty() && (alternative_iv.size() != 8)))
     {
-        if (!std::equal(alternative_iv.begin(),
-                        alternative_iv.end(),
-                        integrity_data.begin()))
+        throw AESException("One or more spans have an invalid length");
+    }
+    for (std::size_t i = 0; i < ciphertexts.size(); i++)
+    {
+        if ((ciphertexts[i].size() < 24) ||
+            ((ciphertexts[i].size() & 0x07) != 0) ||
+            (plaintexts[i].size() != (ciphertexts[i].size() - 8)))
         {
-            return 0;
+            throw AESException("One or more spans have an invalid length");
         }
     }
-    else
+
+    const std::span<const std::uint8_t> iv =
+        alternative_iv.empty() ? std::span<const std::uint8_t>(
+                                     AES_Key_Wrap_Default_IV)
+                               : alternative_iv;
+
+    ProcessLanes(
+        aes,
+        false,
+        [&](KeyWrapLane &lane) -> bool
+        {
+            if (next_item >= ciphertexts.size()) return false;
+
+            const std::span<const std::uint8_t> ciphertext =
+                ciphertexts[next_item];
+
+            lane.item = next_item++;
+            lane.A = LoadWord(ciphertext.data());
+            lane.R = plaintexts[lane.item].data();
+            lane.n = (ciphertext.size() - 8) >> 3;
+            lane.steps = 6 * lane.n;
+            std::copy(ciphertext.begin() + 8, ciphertext.end(), lane.R);
+
+            return true;
+        },
+        [&](const KeyWrapLane &lane)
+        {
+            results[lane.item] = (lane.A == LoadWord(iv.data()));
+
+            if (!results[lane.item]) failures++;
+        });
+
+    RecordAESEvent(aes, AESCounter::KeyUnwraps, ciphertexts.size());
+    if (failures > 0)
+    {
+        RecordAESEvent(aes, AESCounter::IntegrityFailures, failures);
+    }
+
+    return failures;
+}
+
+/*
+ *  AESKeyWrap::WrapKeysWithPadding()
+ *
+ *  Description:
+ *      This function performs the AES Key Wrap with Padding as specified in
+ *      RFC 5649 on a number of independent keys, producing the same result
+ *      as calling WrapWithPadding() for each.  Up to Parallel_Blocks keys
+ *      are processed in lockstep so that the AES engine can encrypt the
+ *      blocks of different keys in parallel.
+ *
+ *  Parameters:
+ *      plaintexts [in]
+ *          The keys to be wrapped.  Each must be between 1 and
+ *          AES_Key_Wrap_with_Padding_Max octets in length.
+ *
+ *      ciphertexts [out]
+ *          A buffer to hold each wrapped key.  Each must be large enough to
+ *          hold the output, as described for WrapWithPadding().
+ *
+ *      ciphertext_lengths [out]
+ *          The length of each wrapped key.  This must have the same number of
+ *          elements as plaintexts.
+ *
+ *      alternative_iv [in]
+ *          A four octet alternative IV to use for all keys.  If empty, the
+ *          default value specified in RFC 5649 will be used.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the number of
+ *      plaintexts, ciphertexts, and lengths differ or if any span has an
+ *      invalid length.  Lengths are verified before any key is wrapped.
+ *
+ *  Comments:
+ *      The plaintext and ciphertext buffers must be distinct and the
+ *      ciphertext buffers of different keys must not overlap.
+ */
+void AESKeyWrap::WrapKeysWithPadding(
+                    const std::span<const std::span<const std::uint8_t>>
+                        plaintexts,
+                    const std::span<const std::span<std::uint8_t>> ciphertexts,
+                    std::span<std::size_t> ciphertext_lengths,
+                    const std::span<const std::uint8_t> alternative_iv)
+{
+    std::size_t next_item{};
+
+    if ((ciphertexts.size() != plaintexts.size()) ||
+        (ciphertext_lengths.size() != plaintexts.size()))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    // Ensure the alternative IV has a valid length
+    if ((!alternative_iv.empty() && (alternative_iv.size() != 4)))
+    {
+        throw AESException("Invalid Alternative IV length");
+    }
+
+    // Check the plaintext lengths, computing the padded length of each
+    for (std::size_t i = 0; i < plaintexts.size(); i++)
     {
-        if (!std::equal(Alternative_IV.begin(),
-                        Alternative_IV.end(),
-                        integrity_data.begin()))
+        if (plaintexts[i].empty() ||
+            (plaintexts[i].size() > AES_Key_Wrap_with_Padding_Max))
         {
-            return 0;
+            throw AESException("Invalid plaintext length");
+        }
+
+        // Pad to be an even 8 octets, then add 8 octets for A
+        ciphertext_lengths[i] = ((plaintexts[i].size() + 7) & ~std::size_t(7)) +
+                                8;
+
+        if (ciphertexts[i].size() < ciphertext_lengths[i])
+        {
+            throw AESException("Ciphertext buffer is too short");
         }
     }
 
-    // Copy the integrity check octets
-    std::copy(integrity_data.begin() + 4,
-              integrity_data.begin() + 8,
-              reinterpret_cast<std::uint8_t *>(&network_word));
+    const std::span<const std::uint8_t, 4> iv =
+        alternative_iv.empty() ?
+            std::span<const std::uint8_t, 4>(Alternative_IV) :
+            std::span<const std::uint8_t, 4>(alternative_iv.data(), 4);
 
-    // Ensure the message length indicator has a valid range
-    message_length_indicator = BitUtil::NetworkByteOrder(network_word);
-    if ((message_length_indicator > (ciphertext.size() - 8)) ||
-        (message_length_indicator < ((ciphertext.size() - 8) - 7)))
+    ProcessLanes(
+        aes,
+        true,
+        [&](KeyWrapLane &lane) -> bool
+        {
+            if (next_item >= plaintexts.size()) return false;
+
+            const std::span<const std::uint8_t> plaintext =
+                plaintexts[next_item];
+
+            lane.item = next_item++;
+
+            // A is the alternative IV followed by the message length
+            lane.A = PaddedIntegrityWord(iv, plaintext.size());
+
+            // Copy the plaintext and padding into the ciphertext buffer
+            lane.R = ciphertexts[lane.item].data() + 8;
+            lane.n = (ciphertext_lengths[lane.item] - 8) >> 3;
+            std::copy(plaintext.begin(), plaintext.end(), lane.R);
+            std::fill(lane.R + plaintext.size(),
+                      lane.R + (lane.n << 3),
+                      std::uint8_t(0));
+
+            // A single block is encrypted using AES ECB mode
+            lane.steps = (lane.n == 1) ? 1 : 6 * lane.n;
+
+            return true;
+        },
+        [&](const KeyWrapLane &lane)
+        {
+            StoreWord(ciphertexts[lane.item].data(), lane.A);
+        });
+
+    RecordAESEvent(aes, AESCounter::KeyWraps, plaintexts.size());
+}
+
+/*
+ *  AESKeyWrap::UnwrapKeysWithPadding()
+ *
+ *  Description:
+ *      This function performs the AES Key Unwrap with Padding as specified
+ *      in RFC 5649 on a number of independent wrapped keys, producing the
+ *      same result as calling UnwrapWithPadding() for each.  Up to
+ *      Parallel_Blocks keys are processed in lockstep so that the AES engine
+ *      can decrypt the blocks of different keys in parallel.
+ *
+ *  Parameters:
+ *      ciphertexts [in]
+ *          The wrapped keys.  Each must be at least 16 octets and an
+ *          integral number of eight octets.
+ *
+ *      plaintexts [out]
+ *          A buffer to hold each unwrapped key.  Each must be at least the
+ *          length of the corresponding ciphertext minus 8 octets.
+ *
+ *      plaintext_lengths [out]
+ *          The length of each unwrapped key, or zero if the integrity check
+ *          for that key failed.  This must have the same number of elements
+ *          as ciphertexts.
+ *
+ *      alternative_iv [in]
+ *          The four octet alternative IV expected for all keys.  If empty,
+ *          the default value specified in RFC 5649 will be used.
+ *
+ *  Returns:
+ *      The number of keys that failed the integrity check.  An AESException
+ *      will be thrown if the number of ciphertexts, plaintexts, and lengths
+ *      differ or if any span has an invalid length.  Lengths are verified
+ *      before any key is unwrapped.
+ *
+ *  Comments:
+ *      The plaintext and ciphertext buffers must be distinct and the
+ *      plaintext buffers of different keys must not overlap.
+ */
+std::size_t AESKeyWrap::UnwrapKeysWithPadding(
+                    const std::span<const std::span<const std::uint8_t>>
+                        ciphertexts,
+                    const std::span<const std::span<std::uint8_t>> plaintexts,
+                    std::span<std::size_t> plaintext_lengths,
+                    const std::span<const std::uint8_t> alternative_iv)
+{
+    std::size_t next_item{};
+    std::size_t failures{};
+
+    // Ensure buffers appear sane ("& 0x07" performs a mod 8 check)
+    if ((plaintexts.size() != ciphertexts.size()) ||
+        (plaintext_lengths.size() != ciphertexts.size()))
     {
-        return 0;
+        throw AESException("One or more spans have an invalid length");
+    }
+    for (std::size_t i = 0; i < ciphertexts.size(); i++)
+    {
+        if ((ciphertexts[i].size() < 16) ||
+            ((ciphertexts[i].size() & 0x07) != 0) ||
+            (plaintexts[i].size() < (ciphertexts[i].size() - 8)))
+        {
+            throw AESException("One or more spans have an invalid length");
+        }
     }
 
-    // Ensure that all padding bits are zero
-    std::uint8_t *p = plaintext.data() + message_length_indicator;
-    std::uint8_t *q = plaintext.data() + ciphertext.size() - 8;
-    if (!std::all_of(p, q, [](std::uint8_t v) -> bool { return v == 0; }))
+    // Ensure the alternative IV has a valid length
+    if ((!alternative_iv.empty() && (alternative_iv.size() != 4)))
     {
-        return 0;
+        throw AESException("Invalid Alternative IV length");
     }
 
-    return message_length_indicator;
+    ProcessLanes(
+        aes,
+        false,
+        [&](KeyWrapLane &lane) -> bool
+        {
+            if (next_item >= ciphertexts.size()) return false;
+
+            const std::span<const std::uint8_t> ciphertext =
+                ciphertexts[next_item];
+
+            lane.item = next_item++;
+            lane.A = LoadWord(ciphertext.data());
+            lane.R = plaintexts[lane.item].data();
+            lane.n = (ciphertext.size() - 8) >> 3;
+            std::copy(ciphertext.begin() + 8, ciphertext.end(), lane.R);
+
+            // A single block is decrypted using AES ECB mode
+            lane.steps = (lane.n == 1) ? 1 : 6 * lane.n;
+
+            return true;
+        },
+        [&](const KeyWrapLane &lane)
+        {
+            plaintext_lengths[lane.item] = CheckPaddedIntegrity(
+                lane.A,
+                {lane.R, lane.n << 3},
+                alternative_iv);
+
+            if (plaintext_lengths[lane.item] == 0) failures++;
+        });
+
+    RecordAESEvent(aes, AESCounter::KeyUnwraps, ciphertexts.size());
+    if (failures > 0)
+    {
+        RecordAESEvent(aes, AESCounter::IntegrityFailures, failures);
+    }
+
+    return failures;
 }
 
 } // namespace Terra::Crypto::Cipher
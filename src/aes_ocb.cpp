@@ -0,0 +1,889 @@
+/*
+ *  aes_ocb.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the OCB authenticated encryption algorithm
+ *      (OCB3) as specified in IETF RFC 7253.
+ *
+ *      The offset for block i is the offset for block i - 1 XORed with
+ *      L_{ntz(i)}, where ntz(i) is the number of trailing zero bits in i.
+ *      The offsets for up to Pipeline_Blocks consecutive blocks are
+ *      computed into the offsets buffer, and those blocks are XORed with the
+ *      offsets, enciphered (or deciphered) with a single call to
+ *      AES::EncryptBlocks() (or DecryptBlocks()), and XORed with the offsets
+ *      once more.  The associated data is hashed the same way, using the
+ *      offsets buffer to hold the blocks being enciphered.
+ *
+ *      Ktop depends on all but the low six bits of the nonce, so when the
+ *      nonce is a counter, most messages reuse the Ktop computed for the
+ *      previous message rather than enciphering it again.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <terra/crypto/cipher/aes_ocb.h>
+#include <terra/secutil/secure_erase.h>
+#include "mode_utilities.h"
+#include "instrumentation.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+namespace
+{
+
+/*
+ *  XorIntoBlock()
+ *
+ *  Description:
+ *      XOR each of the given number of consecutive blocks into a block,
+ *      as when computing the OCB checksum or the sum over the associated
+ *      data.
+ *
+ *  Parameters:
+ *      sum [in/out]
+ *          The block into which the blocks are XORed.
+ *
+ *      data [in]
+ *          The blocks to XOR.
+ *
+ *      blocks [in]
+ *          The number of blocks to XOR.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void XorIntoBlock(std::array<std::uint8_t, 16> &sum,
+                  const std::uint8_t *data,
+                  std::size_t blocks) noexcept
+{
+    for (std::size_t i = 0; i < blocks; i++)
+    {
+        XorBuffers(sum.data(), data + i * 16, sum.data(), 16);
+    }
+}
+
+} // namespace
+
+/*
+ *  AESOCB::AESOCB()
+ *
+ *  Description:
+ *      This is a constructor for the AESOCB object with no given key.
+ *      Since a key is not provided to this version of the constructor, one
+ *      must call SetKey() with a valid key before calling Encrypt() or
+ *      Decrypt(), as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESOCB::AESOCB() :
+    aes(),
+    L_star{},
+    L_dollar{},
+    L{},
+    L_extra{},
+    ktop_input{},
+    stretch{},
+    stretch_valid{false},
+    offset{},
+    checksum{},
+    text_blocks{0},
+    aad_offset{},
+    aad_sum{},
+    aad_pending{},
+    aad_pending_length{0},
+    aad_blocks{0},
+    block{},
+    offsets{}
+{
+    // Nothing more to do
+}
+
+/*
+ *  AESOCB::AESOCB()
+ *
+ *  Description:
+ *      This is a constructor for the AESOCB object that accepts a span
+ *      of octets holding the key that will be used for subsequent
+ *      operations.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  This
+ *          must be 16, 24, or 32 octets in length.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the key provided is
+ *      an invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+AESOCB::AESOCB(const std::span<const std::uint8_t> key) :
+    aes(),
+    L_star{},
+    L_dollar{},
+    L{},
+    L_extra{},
+    ktop_input{},
+    stretch{},
+    stretch_valid{false},
+    offset{},
+    checksum{},
+    text_blocks{0},
+    aad_offset{},
+    aad_sum{},
+    aad_pending{},
+    aad_pending_length{0},
+    aad_blocks{0},
+    block{},
+    offsets{}
+{
+    SetKey(key);
+}
+
+/*
+ *  AESOCB::~AESOCB()
+ *
+ *  Description:
+ *      This is the destructor for the AESOCB object and is responsible for
+ *      zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESOCB::~AESOCB()
+{
+    SecUtil::SecureErase(&L_star, sizeof(L_star));
+    SecUtil::SecureErase(&L_dollar, sizeof(L_dollar));
+    SecUtil::SecureErase(&L, sizeof(L));
+    SecUtil::SecureErase(&L_extra, sizeof(L_extra));
+    SecUtil::SecureErase(&stretch, sizeof(stretch));
+    SecUtil::SecureErase(&offset, sizeof(offset));
+    SecUtil::SecureErase(&checksum, sizeof(checksum));
+    SecUtil::SecureErase(&block, sizeof(block));
+    SecUtil::SecureErase(&offsets, sizeof(offsets));
+    ResetAAD();
+}
+
+/*
+ *  AESOCB::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent encryption
+ *      and decryption operations and compute the offsets L_*, L_$, and L_i
+ *      that depend only on the key.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.  This
+ *          must be 16, 24, or 32 octets in length.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      a valid length.
+ *
+ *  Comments:
+ *      Any associated data provided via UpdateAAD() is discarded.
+ */
+void AESOCB::SetKey(const std::span<const std::uint8_t> key)
+{
+    aes.SetKey(key);
+
+    L_star.fill(0);
+    aes.Encrypt(L_star, L_star);
+
+    DoubleBlock(L_star, L_dollar);
+    DoubleBlock(L_dollar, L[0]);
+
+    for (std::size_t i = 1; i < L_Table_Size; i++)
+    {
+        DoubleBlock(L[i - 1], L[i]);
+    }
+
+    stretch_valid = false;
+
+    ResetAAD();
+}
+
+/*
+ *  AESOCB::ResetAAD()
+ *
+ *  Description:
+ *      This function will discard any associated data provided via
+ *      UpdateAAD().
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Encrypt() and Decrypt() call this function, so it is only needed to
+ *      abandon associated data before a message is processed.
+ */
+void AESOCB::ResetAAD() noexcept
+{
+    SecUtil::SecureErase(&aad_offset, sizeof(aad_offset));
+    SecUtil::SecureErase(&aad_sum, sizeof(aad_sum));
+    SecUtil::SecureErase(&aad_pending, sizeof(aad_pending));
+    aad_pending_length = 0;
+    aad_blocks = 0;
+}
+
+/*
+ *  AESOCB::UpdateAAD()
+ *
+ *  Description:
+ *      This function will authenticate the next portion of the associated
+ *      data for the message that is next encrypted or decrypted with the
+ *      forms of Encrypt() and Decrypt() that do not accept associated data.
+ *
+ *  Parameters:
+ *      aad [in]
+ *          The next portion of the associated data, which may be any length.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Since the associated data is hashed independently of the nonce,
+ *      complete blocks are processed immediately and only a partial block
+ *      is retained between calls.
+ */
+void AESOCB::UpdateAAD(const std::span<const std::uint8_t> aad)
+{
+    const std::uint8_t *data = aad.data();
+    std::size_t length = aad.size();
+    std::size_t octets{};
+
+    // Complete any partial block from a previous call
+    if (aad_pending_length > 0)
+    {
+        octets = std::min(length, aad_pending.size() - aad_pending_length);
+        std::copy(data,
+                  data + octets,
+                  aad_pending.begin() + aad_pending_length);
+        aad_pending_length += octets;
+        data += octets;
+        length -= octets;
+
+        if (aad_pending_length < aad_pending.size()) return;
+
+        HashBlocks(aad_pending.data(), 1);
+        aad_pending_length = 0;
+    }
+
+    // Hash all complete blocks directly from the caller's buffer
+    HashBlocks(data, length / 16);
+    data += length - (length % 16);
+    length %= 16;
+
+    // Retain the final partial block
+    std::copy(data, data + length, aad_pending.begin());
+    aad_pending_length = length;
+}
+
+/*
+ *  AESOCB::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt the plaintext and produce an
+ *      authentication tag over the associated data provided via UpdateAAD()
+ *      and the plaintext.
+ *
+ *  Parameters:
+ *      nonce [in]
+ *          The nonce, which must be between 1 and 15 octets in length and
+ *          must never be reused with the same key.
+ *
+ *      plaintext [in]
+ *          The plaintext to be encrypted, which may be empty.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext.  This may be the same memory location as the
+ *          plaintext.
+ *
+ *      tag [out]
+ *          A buffer to hold the authentication tag, which must be between 4
+ *          and 16 octets in length.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length.
+ *
+ *  Comments:
+ *      The tag length is an input to the algorithm, so a shorter tag is not
+ *      a truncation of a longer one.  The associated data is discarded once
+ *      the tag is produced.
+ */
+void AESOCB::Encrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> tag)
+{
+    CheckParameters(nonce, plaintext, ciphertext, tag.size());
+
+    InitialOffset(nonce, tag.size());
+
+    ProcessText(plaintext, ciphertext, true);
+
+    ComputeTag();
+
+    std::copy(block.begin(), block.begin() + tag.size(), tag.begin());
+
+    ResetAAD();
+}
+
+/*
+ *  AESOCB::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt the plaintext and produce an
+ *      authentication tag over the associated data and plaintext.
+ *
+ *  Parameters:
+ *      nonce [in]
+ *          The nonce, which must be between 1 and 15 octets in length and
+ *          must never be reused with the same key.
+ *
+ *      aad [in]
+ *          The additional authenticated data, which may be empty.
+ *
+ *      plaintext [in]
+ *          The plaintext to be encrypted, which may be empty.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext.  This may be the same memory location as the
+ *          plaintext.
+ *
+ *      tag [out]
+ *          A buffer to hold the authentication tag, which must be between 4
+ *          and 16 octets in length.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length.
+ *
+ *  Comments:
+ *      Any associated data previously provided via UpdateAAD() is discarded.
+ */
+void AESOCB::Encrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> tag)
+{
+    CheckParameters(nonce, plaintext, ciphertext, tag.size());
+
+    ResetAAD();
+    UpdateAAD(aad);
+
+    Encrypt(nonce, plaintext, ciphertext, tag);
+}
+
+/*
+ *  AESOCB::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt the ciphertext and verify the
+ *      authentication tag over the associated data provided via UpdateAAD()
+ *      and the plaintext.
+ *
+ *  Parameters:
+ *      nonce [in]
+ *          The nonce used when encrypting.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to be decrypted, which may be empty.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext.  This may be the same memory location as the
+ *          ciphertext.
+ *
+ *      tag [in]
+ *          The authentication tag produced when encrypting.
+ *
+ *  Returns:
+ *      True if the tag is valid, false otherwise.  If the tag is not valid,
+ *      the plaintext buffer is zeroed.  An AESException will be thrown if the
+ *      spans have an invalid length.
+ *
+ *  Comments:
+ *      The associated data is discarded once the tag is verified.
+ */
+bool AESOCB::Decrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext,
+                     const std::span<const std::uint8_t> tag)
+{
+    std::uint8_t difference{};
+
+    CheckParameters(nonce, ciphertext, plaintext, tag.size());
+
+    InitialOffset(nonce, tag.size());
+
+    ProcessText(ciphertext, plaintext, false);
+
+    ComputeTag();
+
+    ResetAAD();
+
+    // Compare the tags in constant time
+    for (std::size_t i = 0; i < tag.size(); i++)
+    {
+        difference |= block[i] ^ tag[i];
+    }
+
+    if (difference != 0)
+    {
+        SecUtil::SecureErase(plaintext.data(), plaintext.size());
+        RecordAESEvent(aes, AESCounter::IntegrityFailures);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ *  AESOCB::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt the ciphertext and verify the
+ *      authentication tag over the associated data and plaintext.
+ *
+ *  Parameters:
+ *      nonce [in]
+ *          The nonce used when encrypting.
+ *
+ *      aad [in]
+ *          The additional authenticated data, which may be empty.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to be decrypted, which may be empty.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext.  This may be the same memory location as the
+ *          ciphertext.
+ *
+ *      tag [in]
+ *          The authentication tag produced when encrypting.
+ *
+ *  Returns:
+ *      True if the tag is valid, false otherwise.  If the tag is not valid,
+ *      the plaintext buffer is zeroed.  An AESException will be thrown if the
+ *      spans have an invalid length.
+ *
+ *  Comments:
+ *      Any associated data previously provided via UpdateAAD() is discarded.
+ */
+bool AESOCB::Decrypt(const std::span<const std::uint8_t> nonce,
+                     const std::span<const std::uint8_t> aad,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext,
+                     const std::span<const std::uint8_t> tag)
+{
+    CheckParameters(nonce, ciphertext, plaintext, tag.size());
+
+    ResetAAD();
+    UpdateAAD(aad);
+
+    return Decrypt(nonce, ciphertext, plaintext, tag);
+}
+
+/*
+ *  AESOCB::CheckParameters()
+ *
+ *  Description:
+ *      This function will verify that the lengths of the parameters to
+ *      Encrypt() or Decrypt() are valid.
+ *
+ *  Parameters:
+ *      nonce [in]
+ *          The nonce.
+ *
+ *      input [in]
+ *          The input text.
+ *
+ *      output [in]
+ *          The output text buffer.
+ *
+ *      tag_length [in]
+ *          The length of the authentication tag.
+ *
+ *  Returns:
+ *      Nothing, though an AESException is thrown if any length is invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESOCB::CheckParameters(const std::span<const std::uint8_t> nonce,
+                             const std::span<const std::uint8_t> input,
+                             const std::span<const std::uint8_t> output,
+                             std::size_t tag_length) const
+{
+    if ((nonce.size() < Min_Nonce_Length) ||
+        (nonce.size() > Max_Nonce_Length) ||
+        (tag_length < Min_Tag_Length) ||
+        (tag_length > Max_Tag_Length) ||
+        (input.size() != output.size()))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+}
+
+/*
+ *  AESOCB::InitialOffset()
+ *
+ *  Description:
+ *      This function will compute the initial offset for the text from the
+ *      nonce and tag length, as described in Section 4.2 of RFC 7253, and
+ *      clear the checksum.
+ *
+ *  Parameters:
+ *      nonce [in]
+ *          The nonce.
+ *
+ *      tag_length [in]
+ *          The length of the authentication tag in octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The nonce is public, so branching on its value (and comparing it to
+ *      the nonce used for the previous message) reveals nothing secret.
+ */
+void AESOCB::InitialOffset(const std::span<const std::uint8_t> nonce,
+                           std::size_t tag_length)
+{
+    // Nonce = num2str(TAGLEN mod 128, 7) || zeros || 1 || N
+    block.fill(0);
+    block[0] = static_cast<std::uint8_t>(((tag_length * 8) % 128) << 1);
+    block[15 - nonce.size()] |= 0x01;
+    std::copy(nonce.begin(), nonce.end(), block.end() - nonce.size());
+
+    // The low six bits select the offset within the stretched Ktop
+    const std::size_t bottom = block[15] & 0x3f;
+    block[15] &= 0xc0;
+
+    if (!stretch_valid || (block != ktop_input))
+    {
+        ktop_input = block;
+
+        aes.Encrypt(block, std::span<std::uint8_t, 16>(stretch.data(), 16));
+
+        // Stretch = Ktop || (Ktop[1..64] xor Ktop[9..72])
+        for (std::size_t i = 0; i < 8; i++)
+        {
+            stretch[16 + i] = stretch[i] ^ stretch[i + 1];
+        }
+
+        stretch_valid = true;
+    }
+
+    // Offset_0 = Stretch[1+bottom..128+bottom]
+    const std::size_t shift_octets = bottom / 8;
+    const unsigned shift_bits = bottom % 8;
+
+    for (std::size_t i = 0; i < 16; i++)
+    {
+        offset[i] = stretch[i + shift_octets];
+
+        if (shift_bits > 0)
+        {
+            offset[i] = static_cast<std::uint8_t>(
+                (offset[i] << shift_bits) |
+                (stretch[i + shift_octets + 1] >> (8 - shift_bits)));
+        }
+    }
+
+    checksum.fill(0);
+    text_blocks = 0;
+}
+
+/*
+ *  AESOCB::GetL()
+ *
+ *  Description:
+ *      This function will return L_i, taking it from the table computed
+ *      when the key was set if possible.
+ *
+ *  Parameters:
+ *      i [in]
+ *          The index of the offset to return.
+ *
+ *  Returns:
+ *      A reference to L_i, which remains valid until the next call.
+ *
+ *  Comments:
+ *      L_i for i of L_Table_Size or more is only needed once every
+ *      2^L_Table_Size blocks, so it is computed when needed.
+ */
+const std::array<std::uint8_t, 16> &AESOCB::GetL(unsigned i)
+{
+    if (i < L_Table_Size) return L[i];
+
+    L_extra = L[L_Table_Size - 1];
+
+    for (std::size_t j = L_Table_Size; j <= i; j++)
+    {
+        DoubleBlock(L_extra, L_extra);
+    }
+
+    return L_extra;
+}
+
+/*
+ *  AESOCB::ComputeOffsets()
+ *
+ *  Description:
+ *      This function will fill the offsets buffer with the offsets for the
+ *      given number of consecutive blocks and advance the current offset
+ *      and block index past those blocks.
+ *
+ *  Parameters:
+ *      current [in/out]
+ *          The offset for the block preceding the first, which is replaced
+ *          with the offset for the last.
+ *
+ *      index [in/out]
+ *          The number of blocks processed so far, which is advanced by the
+ *          number of blocks.
+ *
+ *      blocks [in]
+ *          The number of offsets to compute, which must not be greater
+ *          than Pipeline_Blocks.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESOCB::ComputeOffsets(std::array<std::uint8_t, 16> &current,
+                            std::uint64_t &index,
+                            std::size_t blocks)
+{
+    const std::uint8_t *previous = current.data();
+
+    for (std::size_t i = 0; i < blocks; i++)
+    {
+        index++;
+
+        // Offset_i = Offset_{i-1} xor L_{ntz(i)}
+        XorBuffers(previous,
+                   GetL(static_cast<unsigned>(std::countr_zero(index))).data(),
+                   offsets.data() + i * 16,
+                   16);
+
+        previous = offsets.data() + i * 16;
+    }
+
+    std::copy(previous, previous + 16, current.begin());
+}
+
+/*
+ *  AESOCB::HashBlocks()
+ *
+ *  Description:
+ *      This function will add the given number of complete blocks of
+ *      associated data to the sum over the associated data, as described in
+ *      Section 4.1 of RFC 7253.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The blocks of associated data.
+ *
+ *      blocks [in]
+ *          The number of blocks to process.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESOCB::HashBlocks(const std::uint8_t *data, std::size_t blocks)
+{
+    std::size_t count{};
+
+    while (blocks > 0)
+    {
+        count = std::min(blocks, Pipeline_Blocks);
+
+        ComputeOffsets(aad_offset, aad_blocks, count);
+
+        // Sum_i = Sum_{i-1} xor ENCIPHER(K, A_i xor Offset_i)
+        std::span<std::uint8_t> work(offsets.data(), count * 16);
+        XorBuffers(data, work.data(), work.data(), work.size());
+        aes.EncryptBlocks(work, work);
+        XorIntoBlock(aad_sum, work.data(), count);
+
+        data += count * 16;
+        blocks -= count;
+    }
+}
+
+/*
+ *  AESOCB::ProcessText()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt the text and compute the
+ *      checksum of the plaintext, as described in Sections 4.2 and 4.3 of
+ *      RFC 7253.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The plaintext or ciphertext.
+ *
+ *      output [out]
+ *          The buffer to hold the ciphertext or plaintext, which is the same
+ *          length as the input and may be the same memory location.
+ *
+ *      encrypt [in]
+ *          True to encrypt the input, false to decrypt.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESOCB::ProcessText(const std::span<const std::uint8_t> input,
+                         std::span<std::uint8_t> output,
+                         bool encrypt)
+{
+    const std::size_t complete = input.size() - (input.size() % 16);
+    const std::size_t remaining = input.size() - complete;
+    std::size_t length{};
+
+    for (std::size_t position = 0; position < complete; position += length)
+    {
+        length = std::min(complete - position, offsets.size());
+
+        const std::uint8_t *in = input.data() + position;
+        std::span<std::uint8_t> out = output.subspan(position, length);
+
+        ComputeOffsets(offset, text_blocks, length / 16);
+
+        // Add the plaintext to the checksum before it may be overwritten
+        if (encrypt) XorIntoBlock(checksum, in, length / 16);
+
+        XorBuffers(in, offsets.data(), out.data(), length);
+
+        if (encrypt)
+        {
+            aes.EncryptBlocks(out, out);
+        }
+        else
+        {
+            aes.DecryptBlocks(out, out);
+        }
+
+        XorBuffers(out.data(), offsets.data(), out.data(), length);
+
+        if (!encrypt) XorIntoBlock(checksum, out.data(), length / 16);
+    }
+
+    if (remaining == 0) return;
+
+    // Offset_* = Offset_m xor L_*, and Pad = ENCIPHER(K, Offset_*)
+    XorBuffers(offset.data(), L_star.data(), offset.data(), 16);
+    aes.Encrypt(offset, block);
+
+    // The padded plaintext, P_* || 1 || zeros, is built in the offsets buffer
+    std::fill(offsets.begin(), offsets.begin() + 16, 0);
+
+    if (encrypt)
+    {
+        std::copy(input.begin() + complete, input.end(), offsets.begin());
+    }
+
+    XorBuffers(input.data() + complete,
+               block.data(),
+               output.data() + complete,
+               remaining);
+
+    if (!encrypt)
+    {
+        std::copy(output.begin() + complete, output.end(), offsets.begin());
+    }
+
+    offsets[remaining] = 0x80;
+    XorIntoBlock(checksum, offsets.data(), 1);
+}
+
+/*
+ *  AESOCB::ComputeTag()
+ *
+ *  Description:
+ *      This function will complete the sum over the associated data and
+ *      compute the full 16-octet tag into the block buffer.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Tag = ENCIPHER(K, Checksum xor Offset xor L_$) xor HASH(K, A).
+ */
+void AESOCB::ComputeTag()
+{
+    // Process any final partial block of associated data
+    if (aad_pending_length > 0)
+    {
+        XorBuffers(aad_offset.data(), L_star.data(), aad_offset.data(), 16);
+
+        std::fill(aad_pending.begin() + aad_pending_length,
+                  aad_pending.end(),
+                  0);
+        aad_pending[aad_pending_length] = 0x80;
+
+        XorBuffers(aad_pending.data(), aad_offset.data(), block.data(), 16);
+        aes.Encrypt(block, block);
+        XorIntoBlock(aad_sum, block.data(), 1);
+
+        aad_pending_length = 0;
+    }
+
+    XorBuffers(checksum.data(), offset.data(), block.data(), 16);
+    XorBuffers(block.data(), L_dollar.data(), block.data(), 16);
+    aes.Encrypt(block, block);
+    XorBuffers(block.data(), aad_sum.data(), block.data(), 16);
+}
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,1019 @@
+/*
+ *  aes_parallel.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AESParallel object, which spreads the work
+ *      of encrypting or decrypting a large buffer across multiple threads.
+ *
+ *      Each task processes one chunk of the buffer using only the shared
+ *      AESKeySchedule and buffers on its own stack, so tasks never write to
+ *      shared state other than their own portion of the output.  Any value
+ *      that a chunk requires from outside of itself (e.g., the ciphertext
+ *      block preceding it in CBC mode) is captured before the tasks start,
+ *      which allows the operations to be performed in place.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <terra/crypto/cipher/aes_parallel.h>
+#include <terra/crypto/cipher/aes_xts.h>
+#include <terra/secutil/secure_erase.h>
+#include "mode_utilities.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+namespace
+{
+
+// Number of blocks given to the engine at once within a task
+constexpr std::size_t Task_Blocks{32};
+
+/*
+ *  ProcessCounterChunk()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt one chunk of data using CTR
+ *      mode or the GCTR function, starting with the given counter block.
+ *
+ *  Parameters:
+ *      key_schedule [in]
+ *          The key schedule used to encrypt the counter blocks.
+ *
+ *      counter [in]
+ *          The counter block for the first block of this chunk.
+ *
+ *      input [in]
+ *          The data to encrypt or decrypt.
+ *
+ *      output [out]
+ *          The buffer into which the result is written.  This is the same
+ *          length as the input and may be the same memory location.
+ *
+ *      counter32 [in]
+ *          True if only the rightmost 32 bits of the counter are incremented
+ *          (i.e., inc32() as used by GCM), false if all 128 bits are.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The counter is manipulated as integers rather than octet by octet,
+ *      as is done by AESCTR and AESGCM.
+ */
+void ProcessCounterChunk(const AESKeySchedule &key_schedule,
+                         const std::span<const std::uint8_t, 16> counter,
+                         const std::span<const std::uint8_t> input,
+                         std::span<std::uint8_t> output,
+                         bool counter32)
+{
+    std::array<std::uint8_t, 16 * Task_Blocks> keystream;
+    std::uint64_t high = LoadBigEndian64(counter.data());
+    std::uint64_t low = LoadBigEndian64(counter.data() + 8);
+    std::uint32_t low32 = LoadBigEndian32(counter.data() + 12);
+    std::size_t length{};
+
+    for (std::size_t offset = 0; offset < input.size(); offset += length)
+    {
+        length = std::min(keystream.size(), input.size() - offset);
+
+        const std::span<std::uint8_t> blocks =
+            std::span(keystream).first((length + 15) & ~std::size_t(15));
+
+        // Write one counter block for each block of input
+        for (std::size_t i = 0; i < blocks.size(); i += 16)
+        {
+            if (counter32)
+            {
+                std::copy(counter.begin(),
+                          counter.begin() + 12,
+                          keystream.begin() + i);
+                StoreBigEndian32(low32++, keystream.data() + i + 12);
+            }
+            else
+            {
+                StoreBigEndian64(high, keystream.data() + i);
+                StoreBigEndian64(low, keystream.data() + i + 8);
+                if (++low == 0) high++;
+            }
+        }
+
+        key_schedule.EncryptBlocks(blocks, blocks);
+
+        XorBuffers(input.data() + offset,
+                   keystream.data(),
+                   output.data() + offset,
+                   length);
+    }
+
+    SecUtil::SecureErase(keystream.data(), keystream.size());
+}
+
+/*
+ *  ProcessDataUnit()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt one XTS-AES data unit in the
+ *      same manner as AESXTS.
+ *
+ *  Parameters:
+ *      key_schedule [in]
+ *          The key schedule for the data key.
+ *
+ *      tweak [in]
+ *          The encrypted tweak for the first block of the data unit.
+ *
+ *      input [in]
+ *          The plaintext or ciphertext to process, which is at least 16
+ *          octets in length.
+ *
+ *      output [out]
+ *          The buffer into which the result is written.  This is the same
+ *          length as the input and may be the same memory location.
+ *
+ *      encrypt [in]
+ *          True to encrypt, false to decrypt.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      When the length is not a multiple of 16, the final full block and
+ *      the partial block are processed using ciphertext stealing.
+ */
+void ProcessDataUnit(const AESKeySchedule &key_schedule,
+                     std::span<std::uint8_t, 16> tweak,
+                     const std::span<const std::uint8_t> input,
+                     std::span<std::uint8_t> output,
+                     bool encrypt)
+{
+    std::array<std::uint8_t, 16 * AESXTS::Parallel_Blocks> tweaks;
+    std::array<std::uint8_t, 16> block;
+    std::size_t remainder = input.size() & 0x0f;
+    std::size_t length{};
+    std::uint8_t octet{};
+
+    // Encrypt or decrypt the block buffer using the given tweak
+    auto ProcessBlock = [&](std::size_t tweak_index)
+    {
+        const std::uint8_t *t = tweaks.data() + tweak_index * 16;
+
+        XorBuffers(block.data(), t, block.data(), block.size());
+
+        if (encrypt)
+        {
+            key_schedule.Encrypt(block, block);
+        }
+        else
+        {
+            key_schedule.Decrypt(block, block);
+        }
+
+        XorBuffers(block.data(), t, block.data(), block.size());
+    };
+
+    // Hold back the last full block if ciphertext stealing is required
+    const std::size_t bulk =
+        input.size() - remainder - (remainder > 0 ? 16 : 0);
+
+    for (std::size_t offset = 0; offset < bulk; offset += length)
+    {
+        length = std::min(tweaks.size(), bulk - offset);
+
+        ComputeXTSTweaks(tweak, tweaks.data(), length / 16);
+
+        XorBuffers(input.data() + offset,
+                   tweaks.data(),
+                   output.data() + offset,
+                   length);
+
+        if (encrypt)
+        {
+            key_schedule.EncryptBlocks(output.subspan(offset, length),
+                                       output.subspan(offset, length));
+        }
+        else
+        {
+            key_schedule.DecryptBlocks(output.subspan(offset, length),
+                                       output.subspan(offset, length));
+        }
+
+        XorBuffers(output.data() + offset,
+                   tweaks.data(),
+                   output.data() + offset,
+                   length);
+    }
+
+    if (remainder > 0)
+    {
+        // Compute the tweaks for the final full block and the partial block
+        ComputeXTSTweaks(tweak, tweaks.data(), 2);
+
+        // Process the last full block; when decrypting, its tweak is the one
+        // that was used for the partial block when it was encrypted
+        std::copy(input.begin() + bulk,
+                  input.begin() + bulk + 16,
+                  block.begin());
+        ProcessBlock(encrypt ? 0 : 1);
+
+        // Steal the tail of that block to fill out the partial block
+        for (std::size_t i = 0; i < remainder; i++)
+        {
+            octet = input[bulk + 16 + i];
+            output[bulk + 16 + i] = block[i];
+            block[i] = octet;
+        }
+
+        // Process the reassembled block to produce the last full block
+        ProcessBlock(encrypt ? 1 : 0);
+        std::copy(block.begin(), block.end(), output.begin() + bulk);
+    }
+
+    SecUtil::SecureErase(tweaks.data(), tweaks.size());
+    SecUtil::SecureErase(block.data(), block.size());
+    SecUtil::SecureErase(&octet, sizeof(octet));
+}
+
+} // namespace
+
+/*
+ *  AESParallel::AESParallel()
+ *
+ *  Description:
+ *      This is a constructor for the AESParallel object that will create
+ *      threads as needed for each call.
+ *
+ *  Parameters:
+ *      threads [in]
+ *          The maximum number of threads to use, including the calling
+ *          thread.  If zero, the number of hardware threads is used.
+ *
+ *      chunk_size [in]
+ *          The number of octets to process with each task.  This is rounded
+ *          down to a multiple of 16 and must be at least 16.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the chunk size is
+ *      invalid.
+ *
+ *  Comments:
+ *      Threads claim the next unprocessed chunk as they finish the previous
+ *      one, so faster threads process more of the buffer.
+ */
+AESParallel::AESParallel(std::size_t threads, std::size_t chunk_size) :
+    executor{},
+    threads{threads > 0 ? threads : std::thread::hardware_concurrency()},
+    chunk_size{chunk_size & ~std::size_t(15)}
+{
+    if (this->threads == 0) this->threads = 1;
+
+    if (this->chunk_size == 0) throw AESException("Invalid chunk size");
+}
+
+/*
+ *  AESParallel::AESParallel()
+ *
+ *  Description:
+ *      This is a constructor for the AESParallel object that will run tasks
+ *      using the given executor, such as an application's thread pool.
+ *
+ *  Parameters:
+ *      executor [in]
+ *          The function that runs the tasks for each call.  It must call each
+ *          task exactly once and return only after all tasks are complete.
+ *
+ *      chunk_size [in]
+ *          The number of octets to process with each task.  This is rounded
+ *          down to a multiple of 16 and must be at least 16.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the executor is
+ *      empty or if the chunk size is invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+AESParallel::AESParallel(AESTaskExecutor executor, std::size_t chunk_size) :
+    executor{std::move(executor)},
+    threads{1},
+    chunk_size{chunk_size & ~std::size_t(15)}
+{
+    if (!this->executor) throw AESException("Invalid executor");
+
+    if (this->chunk_size == 0) throw AESException("Invalid chunk size");
+}
+
+/*
+ *  AESParallel::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a series of independent blocks (i.e., ECB
+ *      mode) using multiple threads.
+ *
+ *  Parameters:
+ *      key_schedule [in]
+ *          The key schedule to use.
+ *
+ *      plaintext [in]
+ *          The data to encrypt.  The length must be an integral number of
+ *          16-octet blocks.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the span lengths
+ *      are invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESParallel::EncryptBlocks(const AESKeySchedule &key_schedule,
+                                const std::span<const std::uint8_t> plaintext,
+                                std::span<std::uint8_t> ciphertext) const
+{
+    // Ensure buffers appear sane ("& 0x0f" performs a mod 16 check)
+    if ((plaintext.size() != ciphertext.size()) ||
+        ((plaintext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    Run((plaintext.size() + chunk_size - 1) / chunk_size,
+        [&](std::size_t task)
+        {
+            const std::size_t offset = task * chunk_size;
+            const std::size_t length =
+                std::min(chunk_size, plaintext.size() - offset);
+
+            key_schedule.EncryptBlocks(plaintext.subspan(offset, length),
+                                       ciphertext.subspan(offset, length));
+        });
+}
+
+/*
+ *  AESParallel::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a series of independent blocks (i.e., ECB
+ *      mode) using multiple threads.
+ *
+ *  Parameters:
+ *      key_schedule [in]
+ *          The key schedule to use.  The decryption key schedule must have
+ *          been computed.
+ *
+ *      ciphertext [in]
+ *          The data to decrypt.  The length must be an integral number of
+ *          16-octet blocks.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the span lengths
+ *      are invalid or if the key schedule was set for encryption only.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESParallel::DecryptBlocks(const AESKeySchedule &key_schedule,
+                                const std::span<const std::uint8_t> ciphertext,
+                                std::span<std::uint8_t> plaintext) const
+{
+    // Ensure buffers appear sane ("& 0x0f" performs a mod 16 check)
+    if ((plaintext.size() != ciphertext.size()) ||
+        ((ciphertext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    // Check the key here, as an exception cannot leave a worker thread
+    if (key_schedule.GetKeyUsage() == AESKeyUsage::EncryptOnly)
+    {
+        throw AESException("The key was set for encryption only");
+    }
+
+    Run((ciphertext.size() + chunk_size - 1) / chunk_size,
+        [&](std::size_t task)
+        {
+            const std::size_t offset = task * chunk_size;
+            const std::size_t length =
+                std::min(chunk_size, ciphertext.size() - offset);
+
+            key_schedule.DecryptBlocks(ciphertext.subspan(offset, length),
+                                       plaintext.subspan(offset, length));
+        });
+}
+
+/*
+ *  AESParallel::EncryptCTR()
+ *
+ *  Description:
+ *      This function will encrypt the plaintext using CTR mode, producing
+ *      the same result as a newly initialized AESCTR object.
+ *
+ *  Parameters:
+ *      key_schedule [in]
+ *          The key schedule to use.  Only the encryption key schedule is
+ *          required.
+ *
+ *      counter [in]
+ *          The initial counter block, which is treated as a 128-bit big
+ *          endian integer.
+ *
+ *      plaintext [in]
+ *          The plaintext to encrypt, which may be of any length.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext and may be the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have
+ *      different lengths.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESParallel::EncryptCTR(const AESKeySchedule &key_schedule,
+                             const std::span<const std::uint8_t, 16> counter,
+                             const std::span<const std::uint8_t> plaintext,
+                             std::span<std::uint8_t> ciphertext) const
+{
+    ProcessCounter(key_schedule, counter, plaintext, ciphertext, false);
+}
+
+/*
+ *  AESParallel::DecryptCTR()
+ *
+ *  Description:
+ *      This function will decrypt the ciphertext using CTR mode.  This is
+ *      the same operation as EncryptCTR() and is provided for readability.
+ *
+ *  Parameters:
+ *      key_schedule [in]
+ *          The key schedule to use.  Only the encryption key schedule is
+ *          required.
+ *
+ *      counter [in]
+ *          The initial counter block used when encrypting.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to decrypt, which may be of any length.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext and may be the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have
+ *      different lengths.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESParallel::DecryptCTR(const AESKeySchedule &key_schedule,
+                             const std::span<const std::uint8_t, 16> counter,
+                             const std::span<const std::uint8_t> ciphertext,
+                             std::span<std::uint8_t> plaintext) const
+{
+    ProcessCounter(key_schedule, counter, ciphertext, plaintext, false);
+}
+
+/*
+ *  AESParallel::EncryptGCTR()
+ *
+ *  Description:
+ *      This function will apply the GCTR function defined in NIST SP
+ *      800-38D, which is CTR mode incrementing only the rightmost 32 bits
+ *      of the counter block.  This is the keystream portion of GCM.
+ *
+ *  Parameters:
+ *      key_schedule [in]
+ *          The key schedule to use.  Only the encryption key schedule is
+ *          required.
+ *
+ *      counter [in]
+ *          The initial counter block.  For GCM encryption, this is inc32(J0),
+ *          which for a 96-bit IV is the IV followed by 0x00000002.
+ *
+ *      plaintext [in]
+ *          The plaintext to encrypt, which may be of any length.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext and may be the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have
+ *      different lengths.
+ *
+ *  Comments:
+ *      The authentication tag is not computed; GHASH must be applied to the
+ *      ciphertext separately.
+ */
+void AESParallel::EncryptGCTR(const AESKeySchedule &key_schedule,
+                              const std::span<const std::uint8_t, 16> counter,
+                              const std::span<const std::uint8_t> plaintext,
+                              std::span<std::uint8_t> ciphertext) const
+{
+    ProcessCounter(key_schedule, counter, plaintext, ciphertext, true);
+}
+
+/*
+ *  AESParallel::DecryptGCTR()
+ *
+ *  Description:
+ *      This function will apply the GCTR function to decrypt ciphertext.
+ *      This is the same operation as EncryptGCTR() and is provided for
+ *      readability.
+ *
+ *  Parameters:
+ *      key_schedule [in]
+ *          The key schedule to use.  Only the encryption key schedule is
+ *          required.
+ *
+ *      counter [in]
+ *          The initial counter block used when encrypting.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to decrypt, which may be of any length.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext and may be the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have
+ *      different lengths.
+ *
+ *  Comments:
+ *      The authentication tag is not verified.
+ */
+void AESParallel::DecryptGCTR(const AESKeySchedule &key_schedule,
+                              const std::span<const std::uint8_t, 16> counter,
+                              const std::span<const std::uint8_t> ciphertext,
+                              std::span<std::uint8_t> plaintext) const
+{
+    ProcessCounter(key_schedule, counter, ciphertext, plaintext, true);
+}
+
+/*
+ *  AESParallel::DecryptCBC()
+ *
+ *  Description:
+ *      This function will decrypt the ciphertext using CBC mode, producing
+ *      the same result as AESCBC::Decrypt().
+ *
+ *  Parameters:
+ *      key_schedule [in]
+ *          The key schedule to use.  The decryption key schedule must have
+ *          been computed.
+ *
+ *      iv [in]
+ *          The initialization vector used when encrypting.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to be decrypted.  This must be an integral number
+ *          of 16-octet blocks.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext and may be the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length or if the key schedule was set for encryption only.
+ *
+ *  Comments:
+ *      The ciphertext block preceding each chunk is copied before any task
+ *      starts, since another task may overwrite it when decrypting in place.
+ */
+void AESParallel::DecryptCBC(const AESKeySchedule &key_schedule,
+                             const std::span<const std::uint8_t, 16> iv,
+                             const std::span<const std::uint8_t> ciphertext,
+                             std::span<std::uint8_t> plaintext) const
+{
+    // Ensure buffers appear sane ("& 0x0f" performs a mod 16 check)
+    if ((plaintext.size() != ciphertext.size()) ||
+        ((ciphertext.size() & 0x0f) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    // Check the key here, as an exception cannot leave a worker thread
+    if (key_schedule.GetKeyUsage() == AESKeyUsage::EncryptOnly)
+    {
+        throw AESException("The key was set for encryption only");
+    }
+
+    const std::size_t tasks = (ciphertext.size() + chunk_size - 1) / chunk_size;
+
+    // Retain the block preceding each chunk (the IV for the first chunk)
+    std::vector<std::uint8_t> chain(tasks * 16);
+    for (std::size_t task = 0; task < tasks; task++)
+    {
+        const std::uint8_t *previous =
+            (task == 0) ? iv.data()
+                        : ciphertext.data() + task * chunk_size - 16;
+
+        std::copy(previous, previous + 16, chain.begin() + task * 16);
+    }
+
+    Run(tasks,
+        [&](std::size_t task)
+        {
+            std::array<std::uint8_t, 16 * Task_Blocks> buffer;
+            std::array<std::uint8_t, 16> previous;
+            const std::size_t start = task * chunk_size;
+            const std::size_t end =
+                std::min(start + chunk_size, ciphertext.size());
+            std::size_t length{};
+
+            std::copy(chain.begin() + task * 16,
+                      chain.begin() + task * 16 + 16,
+                      previous.begin());
+
+            for (std::size_t offset = start; offset < end; offset += length)
+            {
+                length = std::min(buffer.size(), end - offset);
+
+                // Retain the ciphertext, as it may be overwritten
+                std::copy(ciphertext.begin() + offset,
+                          ciphertext.begin() + offset + length,
+                          buffer.begin());
+
+                key_schedule.DecryptBlocks(ciphertext.subspan(offset, length),
+                                           plaintext.subspan(offset, length));
+
+                // XOR each block with the preceding ciphertext block
+                XorBuffers(plaintext.data() + offset,
+                           previous.data(),
+                           plaintext.data() + offset,
+                           16);
+                XorBuffers(plaintext.data() + offset + 16,
+                           buffer.data(),
+                           plaintext.data() + offset + 16,
+                           length - 16);
+
+                std::copy(buffer.begin() + length - 16,
+                          buffer.begin() + length,
+                          previous.begin());
+            }
+        });
+}
+
+/*
+ *  AESParallel::EncryptXTS()
+ *
+ *  Description:
+ *      This function will encrypt a series of consecutive XTS-AES data units
+ *      (sectors), producing the same result as calling AESXTS::Encrypt()
+ *      for each sector in turn.
+ *
+ *  Parameters:
+ *      data_key_schedule [in]
+ *          The key schedule for the data key (the first half of the XTS-AES
+ *          key).
+ *
+ *      tweak_key_schedule [in]
+ *          The key schedule for the tweak key (the second half of the XTS-AES
+ *          key).  Only the encryption key schedule is required.
+ *
+ *      sector [in]
+ *          The sector number of the first data unit.  Each subsequent data
+ *          unit has the next sector number.
+ *
+ *      sector_size [in]
+ *          The length of each data unit, which must be at least 16 octets and
+ *          at most AESXTS::Max_Data_Unit_Length octets.
+ *
+ *      plaintext [in]
+ *          The plaintext to be encrypted.  The length must be an integral
+ *          number of data units.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext and may be the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans or the
+ *      sector size have an invalid length.
+ *
+ *  Comments:
+ *      Each task processes whole data units, so a task may be larger than
+ *      the chunk size if the sector size is.
+ */
+void AESParallel::EncryptXTS(const AESKeySchedule &data_key_schedule,
+                             const AESKeySchedule &tweak_key_schedule,
+                             const std::uint64_t sector,
+                             const std::size_t sector_size,
+                             const std::span<const std::uint8_t> plaintext,
+                             std::span<std::uint8_t> ciphertext) const
+{
+    ProcessXTS(data_key_schedule,
+               tweak_key_schedule,
+               sector,
+               sector_size,
+               plaintext,
+               ciphertext,
+               true);
+}
+
+/*
+ *  AESParallel::DecryptXTS()
+ *
+ *  Description:
+ *      This function will decrypt a series of consecutive XTS-AES data units
+ *      (sectors), producing the same result as calling AESXTS::Decrypt()
+ *      for each sector in turn.
+ *
+ *  Parameters:
+ *      data_key_schedule [in]
+ *          The key schedule for the data key (the first half of the XTS-AES
+ *          key).  The decryption key schedule must have been computed.
+ *
+ *      tweak_key_schedule [in]
+ *          The key schedule for the tweak key (the second half of the XTS-AES
+ *          key).  Only the encryption key schedule is required.
+ *
+ *      sector [in]
+ *          The sector number of the first data unit.  Each subsequent data
+ *          unit has the next sector number.
+ *
+ *      sector_size [in]
+ *          The length of each data unit, which must be at least 16 octets and
+ *          at most AESXTS::Max_Data_Unit_Length octets.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to be decrypted.  The length must be an integral
+ *          number of data units.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext and may be the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans or the
+ *      sector size have an invalid length or if the data key schedule was
+ *      set for encryption only.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESParallel::DecryptXTS(const AESKeySchedule &data_key_schedule,
+                             const AESKeySchedule &tweak_key_schedule,
+                             const std::uint64_t sector,
+                             const std::size_t sector_size,
+                             const std::span<const std::uint8_t> ciphertext,
+                             std::span<std::uint8_t> plaintext) const
+{
+    ProcessXTS(data_key_schedule,
+               tweak_key_schedule,
+               sector,
+               sector_size,
+               ciphertext,
+               plaintext,
+               false);
+}
+
+/*
+ *  AESParallel::ProcessCounter()
+ *
+ *  Description:
+ *      This function will apply CTR mode or the GCTR function to the input,
+ *      giving each task the counter block for the first block of its chunk.
+ *
+ *  Parameters:
+ *      key_schedule [in]
+ *          The key schedule to use.
+ *
+ *      counter [in]
+ *          The initial counter block.
+ *
+ *      input [in]
+ *          The data to encrypt or decrypt.
+ *
+ *      output [out]
+ *          The buffer into which the result is written.  This must be the
+ *          same length as the input and may be the same memory location.
+ *
+ *      counter32 [in]
+ *          True if only the rightmost 32 bits of the counter are incremented,
+ *          false if all 128 bits are.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have
+ *      different lengths.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESParallel::ProcessCounter(
+                            const AESKeySchedule &key_schedule,
+                            const std::span<const std::uint8_t, 16> counter,
+                            const std::span<const std::uint8_t> input,
+                            std::span<std::uint8_t> output,
+                            bool counter32) const
+{
+    if (input.size() != output.size())
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    Run((input.size() + chunk_size - 1) / chunk_size,
+        [&](std::size_t task)
+        {
+            std::array<std::uint8_t, 16> chunk_counter;
+            const std::size_t offset = task * chunk_size;
+            const std::size_t length =
+                std::min(chunk_size, input.size() - offset);
+
+            // Advance the counter to the first block of this chunk
+            std::copy(counter.begin(), counter.end(), chunk_counter.begin());
+            if (counter32)
+            {
+                AddToCounter32(chunk_counter, offset / 16);
+            }
+            else
+            {
+                AddToCounter(chunk_counter, offset / 16);
+            }
+
+            ProcessCounterChunk(key_schedule,
+                                chunk_counter,
+                                input.subspan(offset, length),
+                                output.subspan(offset, length),
+                                counter32);
+        });
+}
+
+/*
+ *  AESParallel::ProcessXTS()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt a series of consecutive XTS-AES
+ *      data units, giving each task a whole number of data units.
+ *
+ *  Parameters:
+ *      data_key_schedule [in]
+ *          The key schedule for the data key.
+ *
+ *      tweak_key_schedule [in]
+ *          The key schedule for the tweak key.
+ *
+ *      sector [in]
+ *          The sector number of the first data unit.
+ *
+ *      sector_size [in]
+ *          The length of each data unit.
+ *
+ *      input [in]
+ *          The data to encrypt or decrypt.
+ *
+ *      output [out]
+ *          The buffer into which the result is written.  This must be the
+ *          same length as the input and may be the same memory location.
+ *
+ *      encrypt [in]
+ *          True to encrypt, false to decrypt.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans or the
+ *      sector size have an invalid length or if decrypting with a data key
+ *      schedule set for encryption only.
+ *
+ *  Comments:
+ *      The sector number wraps modulo 2^64, as it is given as a 64-bit value.
+ */
+void AESParallel::ProcessXTS(const AESKeySchedule &data_key_schedule,
+                             const AESKeySchedule &tweak_key_schedule,
+                             const std::uint64_t sector,
+                             const std::size_t sector_size,
+                             const std::span<const std::uint8_t> input,
+                             std::span<std::uint8_t> output,
+                             bool encrypt) const
+{
+    // Ensure buffers appear sane
+    if ((sector_size < 16) || (sector_size > AESXTS::Max_Data_Unit_Length) ||
+        (input.size() != output.size()) || ((input.size() % sector_size) != 0))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    // Check the key here, as an exception cannot leave a worker thread
+    if (!encrypt &&
+        (data_key_schedule.GetKeyUsage() == AESKeyUsage::EncryptOnly))
+    {
+        throw AESException("The key was set for encryption only");
+    }
+
+    const std::size_t sectors = input.size() / sector_size;
+    const std::size_t sectors_per_task =
+        std::max(std::size_t(1), chunk_size / sector_size);
+
+    Run((sectors + sectors_per_task - 1) / sectors_per_task,
+        [&](std::size_t task)
+        {
+            std::array<std::uint8_t, 16> tweak;
+            const std::size_t first = task * sectors_per_task;
+            const std::size_t last =
+                std::min(first + sectors_per_task, sectors);
+
+            for (std::size_t i = first; i < last; i++)
+            {
+                // Form the tweak from the sector number and encrypt it
+                StoreLittleEndian64(sector + i, tweak.data());
+                StoreLittleEndian64(0, tweak.data() + 8);
+                tweak_key_schedule.Encrypt(tweak, tweak);
+
+                ProcessDataUnit(data_key_schedule,
+                                tweak,
+                                input.subspan(i * sector_size, sector_size),
+                                output.subspan(i * sector_size, sector_size),
+                                encrypt);
+            }
+
+            SecUtil::SecureErase(tweak.data(), tweak.size());
+        });
+}
+
+/*
+ *  AESParallel::Run()
+ *
+ *  Description:
+ *      This function will run the given number of tasks, returning once all
+ *      of them are complete.
+ *
+ *  Parameters:
+ *      tasks [in]
+ *          The number of tasks to run.
+ *
+ *      task [in]
+ *          The function to call with the index of each task.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If there is no executor, up to threads - 1 threads are created and
+ *      the calling thread also runs tasks.  Each thread takes the next task
+ *      from a shared counter, so no thread sits idle while tasks remain.  If
+ *      a thread cannot be created, the tasks are run by the threads that
+ *      were created.
+ */
+void AESParallel::Run(std::size_t tasks,
+                      const std::function<void(std::size_t)> &task) const
+{
+    if (tasks == 0) return;
+
+    if (executor)
+    {
+        executor(tasks, task);
+        return;
+    }
+
+    std::atomic<std::size_t> next_task{};
+    std::vector<std::thread> workers;
+
+    auto Worker = [&]()
+    {
+        for (std::size_t i = next_task++; i < tasks; i = next_task++) task(i);
+    };
+
+    for (std::size_t i = 1; i < std::min(threads, tasks); i++)
+    {
+        try
+        {
+            workers.emplace_back(Worker);
+        }
+        catch (const std::system_error &)
+        {
+            break;
+        }
+    }
+
+    Worker();
+
+    for (auto &worker : workers) worker.join();
+}
+
+} // namespace Terra::Crypto::Cipher
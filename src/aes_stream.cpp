@@ -0,0 +1,1585 @@
+/*
+ *  aes_stream.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AESStream object that encrypts or decrypts
+ *      files and streams one chunk at a time using CTR, GCM, or XTS mode.
+ *
+ *      Files are mapped one chunk at a time rather than all at once, so that
+ *      files of any size may be processed regardless of the address space
+ *      available and so that the pages of completed chunks are released.
+ *      Mapping the next chunk and advising the operating system that it
+ *      will be needed starts the read-ahead of that chunk, which proceeds
+ *      while the cipher runs over the current chunk.  Once a chunk is
+ *      complete, writing it back is started (on Linux) before it is
+ *      unmapped, so that writing also overlaps with the cipher.
+ *
+ *      Streams are read on another thread into the buffer not in use while
+ *      the current buffer is processed in place and written.
+ *
+ *  Portability Issues:
+ *      On Windows, files are read and written using file streams rather
+ *      than being memory mapped.
+ */
+
+#include <algorithm>
+#include <future>
+#include <fstream>
+#include <functional>
+#include <terra/crypto/cipher/aes_stream.h>
+#include <terra/secutil/secure_erase.h>
+#include "instrumentation.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Terra::Crypto::Cipher
+{
+
+namespace
+{
+
+// Error reported when the input and output files are the same file
+constexpr const char *Same_File_Error =
+    "The input and output are the same file; use EncryptFileInPlace() or "
+    "DecryptFileInPlace()";
+
+/*
+ *  OutputGuard
+ *
+ *  Description:
+ *      This object truncates the output file when destroyed unless it has
+ *      been dismissed, so that a partly written file (which, when decrypting
+ *      with GCM, would hold unauthenticated plaintext) is not left behind if
+ *      processing fails.
+ */
+class OutputGuard
+{
+    public:
+        OutputGuard(const std::filesystem::path &path) : path{path} {}
+        OutputGuard(const OutputGuard &) = delete;
+        ~OutputGuard()
+        {
+            std::error_code error;
+
+            if (!dismissed) std::filesystem::resize_file(path, 0, error);
+        }
+
+        OutputGuard &operator=(const OutputGuard &) = delete;
+
+        void Dismiss() noexcept
+        {
+            dismissed = true;
+        }
+
+    protected:
+        const std::filesystem::path &path;
+        bool dismissed{};
+};
+
+#ifndef _WIN32
+
+/*
+ *  FileDescriptor
+ *
+ *  Description:
+ *      This object owns an open file descriptor, closing it when destroyed.
+ */
+class FileDescriptor
+{
+    public:
+        FileDescriptor(const std::filesystem::path &path, int flags) :
+            descriptor{::open(path.c_str(), flags | O_CLOEXEC, 0666)}
+        {
+            if (descriptor < 0)
+            {
+                throw AESException("Unable to open the file");
+            }
+        }
+        FileDescriptor(const FileDescriptor &) = delete;
+        ~FileDescriptor()
+        {
+            ::close(descriptor);
+        }
+
+        FileDescriptor &operator=(const FileDescriptor &) = delete;
+
+        int Get() const noexcept
+        {
+            return descriptor;
+        }
+
+        std::uint64_t Size() const
+        {
+            struct stat status{};
+
+            if (::fstat(descriptor, &status) != 0)
+            {
+                throw AESException("Unable to determine the file size");
+            }
+
+            return static_cast<std::uint64_t>(status.st_size);
+        }
+
+        bool SameFile(const FileDescriptor &other) const
+        {
+            struct stat status{};
+            struct stat other_status{};
+
+            if ((::fstat(descriptor, &status) != 0) ||
+                (::fstat(other.descriptor, &other_status) != 0))
+            {
+                throw AESException("Unable to determine the file identity");
+            }
+
+            return (status.st_dev == other_status.st_dev) &&
+                   (status.st_ino == other_status.st_ino);
+        }
+
+    protected:
+        int descriptor;
+};
+
+/*
+ *  MappedChunk
+ *
+ *  Description:
+ *      This object maps one chunk of a file into memory, unmapping it when
+ *      destroyed or when another chunk is mapped.
+ */
+class MappedChunk
+{
+    public:
+        MappedChunk() : data{}, length{}, offset{} {}
+        MappedChunk(const MappedChunk &) = delete;
+        ~MappedChunk()
+        {
+            Unmap();
+        }
+
+        MappedChunk &operator=(const MappedChunk &) = delete;
+
+        void Map(const FileDescriptor &file,
+                 std::uint64_t chunk_offset,
+                 std::size_t chunk_length,
+                 bool writable);
+        void WriteBack(const FileDescriptor &file) const noexcept;
+        void Unmap() noexcept;
+
+        std::uint8_t *data;                     // Mapped octets
+        std::size_t length;                     // Length of the mapping
+        std::uint64_t offset;                   // Offset in the file
+};
+
+/*
+ *  MappedChunk::Map()
+ *
+ *  Description:
+ *      Map the given part of the file into memory and advise the operating
+ *      system that it will be needed soon, which starts reading it.
+ *
+ *  Parameters:
+ *      file [in]
+ *          The file to map.
+ *
+ *      chunk_offset [in]
+ *          The offset of the chunk in the file, which must be a multiple of
+ *          the page size.
+ *
+ *      chunk_length [in]
+ *          The length of the chunk, which must not be zero.
+ *
+ *      writable [in]
+ *          True if the mapping will be written, false if only read.
+ *
+ *  Returns:
+ *      Nothing, though an AESException is thrown if the file cannot be
+ *      mapped.
+ *
+ *  Comments:
+ *      The advice is only a hint, so failure to follow it is not an error.
+ */
+void MappedChunk::Map(const FileDescriptor &file,
+                      std::uint64_t chunk_offset,
+                      std::size_t chunk_length,
+                      bool writable)
+{
+    Unmap();
+
+    void *address = ::mmap(nullptr,
+                           chunk_length,
+                           writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                           MAP_SHARED,
+                           file.Get(),
+                           static_cast<off_t>(chunk_offset));
+
+    if (address == MAP_FAILED) throw AESException("Unable to map the file");
+
+    data = static_cast<std::uint8_t *>(address);
+    length = chunk_length;
+    offset = chunk_offset;
+
+    ::posix_madvise(address, chunk_length, POSIX_MADV_WILLNEED);
+}
+
+/*
+ *  MappedChunk::WriteBack()
+ *
+ *  Description:
+ *      Start writing the modified pages of the chunk to the file without
+ *      waiting for the writes to complete.
+ *
+ *  Parameters:
+ *      file [in]
+ *          The file that is mapped.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Linux ignores MS_ASYNC, as dirty pages are written back eventually
+ *      in any case, so sync_file_range() is used to start the writes now.
+ */
+void MappedChunk::WriteBack([[maybe_unused]] const FileDescriptor &file)
+    const noexcept
+{
+#ifdef __linux__
+    ::sync_file_range(file.Get(),
+                      static_cast<off_t>(offset),
+                      static_cast<off_t>(length),
+                      SYNC_FILE_RANGE_WRITE);
+#else
+    ::msync(data, length, MS_ASYNC);
+#endif
+}
+
+/*
+ *  MappedChunk::Unmap()
+ *
+ *  Description:
+ *      Unmap the chunk, if one is mapped.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Modified pages of a shared mapping remain in the page cache and are
+ *      written to the file after the mapping is removed.
+ */
+void MappedChunk::Unmap() noexcept
+{
+    if (data == nullptr) return;
+
+    ::munmap(data, length);
+
+    data = nullptr;
+    length = 0;
+}
+
+#endif // _WIN32
+
+/*
+ *  ElapsedTime()
+ *
+ *  Description:
+ *      Return the time elapsed since the given time.
+ *
+ *  Parameters:
+ *      start [in]
+ *          The time from which to measure.
+ *
+ *  Returns:
+ *      The elapsed time in nanoseconds.
+ *
+ *  Comments:
+ *      None.
+ */
+std::chrono::nanoseconds ElapsedTime(
+    const std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
+} // namespace
+
+/*
+ *  AESStream::AESStream()
+ *
+ *  Description:
+ *      This is a constructor for the AESStream object with no given key.
+ *      Since a key is not provided to this version of the constructor, one
+ *      must call SetKey() with a valid key before encrypting or decrypting,
+ *      as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      mode [in]
+ *          The mode of operation to use.
+ *
+ *      chunk_size [in]
+ *          The number of octets processed at a time, which must be a
+ *          non-zero multiple of Chunk_Alignment.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the chunk size is
+ *      invalid.
+ *
+ *  Comments:
+ *      A chunk should be large enough that the time to map or read it is
+ *      small relative to the time to process it.
+ */
+AESStream::AESStream(AESStreamMode mode, std::size_t chunk_size) :
+    mode{mode},
+    chunk_size{chunk_size},
+    first_data_unit{},
+    data_unit_length{Default_Data_Unit_Length},
+    data_unit{},
+    statistics{}
+{
+    if ((chunk_size == 0) || ((chunk_size % Chunk_Alignment) != 0))
+    {
+        throw AESException("The chunk size is invalid");
+    }
+}
+
+/*
+ *  AESStream::AESStream()
+ *
+ *  Description:
+ *      This is a constructor for the AESStream object that accepts a span
+ *      of octets holding a key that will be used for subsequent operations.
+ *
+ *  Parameters:
+ *      mode [in]
+ *          The mode of operation to use.
+ *
+ *      key [in]
+ *          The key to use with this instance of the object.  The length of
+ *          the key must be 16, 24, or 32 octets, or 32, 48, or 64 octets if
+ *          the mode is XTS.
+ *
+ *      chunk_size [in]
+ *          The number of octets processed at a time, which must be a
+ *          non-zero multiple of Chunk_Alignment.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the key or chunk
+ *      size is invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+AESStream::AESStream(AESStreamMode mode,
+                     const std::span<const std::uint8_t> key,
+                     std::size_t chunk_size) :
+    AESStream(mode, chunk_size)
+{
+    SetKey(key);
+}
+
+/*
+ *  AESStream::~AESStream()
+ *
+ *  Description:
+ *      This is the destructor for the AESStream object and is responsible
+ *      for zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESStream::~AESStream()
+{
+    SecUtil::SecureErase(iv.data(), iv.size());
+    SecUtil::SecureErase(aad.data(), aad.size());
+    for (auto &buffer : buffers)
+    {
+        SecUtil::SecureErase(buffer.data(), buffer.size());
+    }
+}
+
+/*
+ *  AESStream::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent encryption
+ *      and decryption calls.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The key to use with this instance of the object.  The length of
+ *          the key must be 16, 24, or 32 octets, or 32, 48, or 64 octets if
+ *          the mode is XTS.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the key is an
+ *      invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESStream::SetKey(const std::span<const std::uint8_t> key)
+{
+    switch (mode)
+    {
+        case AESStreamMode::CTR:
+            ctr.SetKey(key);
+            break;
+
+        case AESStreamMode::GCM:
+            gcm.SetKey(key);
+            break;
+
+        case AESStreamMode::XTS:
+            xts.SetKey(key);
+            break;
+    }
+}
+
+/*
+ *  AESStream::SetIV()
+ *
+ *  Description:
+ *      This function will set the initial counter block (CTR) or the
+ *      initialization vector (GCM) used for the next encryption and for
+ *      any subsequent decryptions.
+ *
+ *  Parameters:
+ *      iv [in]
+ *          The initial counter block, which must be 16 octets, or the IV,
+ *          which must not be empty and should be 12 octets.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the IV is not
+ *      valid for the mode or if the mode is XTS.
+ *
+ *  Comments:
+ *      Each encryption consumes the IV, so this must be called again with a
+ *      new IV before encrypting again.  A counter or IV must never be reused
+ *      with the same key.
+ */
+void AESStream::SetIV(const std::span<const std::uint8_t> iv)
+{
+    if ((mode == AESStreamMode::XTS) ||
+        ((mode == AESStreamMode::CTR) && (iv.size() != 16)) || iv.empty())
+    {
+        throw AESException("The IV is invalid for the mode");
+    }
+
+    SecUtil::SecureErase(this->iv.data(), this->iv.size());
+    this->iv.assign(iv.begin(), iv.end());
+}
+
+/*
+ *  AESStream::ClearIV()
+ *
+ *  Description:
+ *      This function will erase the IV so that it is not used again.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESStream::ClearIV() noexcept
+{
+    SecUtil::SecureErase(iv.data(), iv.size());
+    iv.clear();
+}
+
+/*
+ *  AESStream::SetAAD()
+ *
+ *  Description:
+ *      This function will set the additional authenticated data used for
+ *      subsequent GCM operations.
+ *
+ *  Parameters:
+ *      aad [in]
+ *          Additional authenticated data, which may be empty.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the mode is not
+ *      GCM.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESStream::SetAAD(const std::span<const std::uint8_t> aad)
+{
+    if (mode != AESStreamMode::GCM)
+    {
+        throw AESException("Additional data is only used with GCM");
+    }
+
+    SecUtil::SecureErase(this->aad.data(), this->aad.size());
+    this->aad.assign(aad.begin(), aad.end());
+}
+
+/*
+ *  AESStream::SetDataUnit()
+ *
+ *  Description:
+ *      This function will set the number of the first XTS data unit (e.g.,
+ *      sector) and the length of each data unit used for subsequent
+ *      operations.  Each data unit is numbered one greater than the last.
+ *
+ *  Parameters:
+ *      data_unit [in]
+ *          The number of the first data unit.
+ *
+ *      data_unit_length [in]
+ *          The length of each data unit, which must be a multiple of 16
+ *          octets no greater than AESXTS::Max_Data_Unit_Length and a
+ *          divisor of the chunk size.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the data unit
+ *      length is invalid or if the mode is not XTS.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESStream::SetDataUnit(std::uint64_t data_unit,
+                            std::size_t data_unit_length)
+{
+    if ((mode != AESStreamMode::XTS) || (data_unit_length == 0) ||
+        ((data_unit_length % 16) != 0) ||
+        (data_unit_length > AESXTS::Max_Data_Unit_Length) ||
+        ((chunk_size % data_unit_length) != 0))
+    {
+        throw AESException("The data unit length is invalid");
+    }
+
+    first_data_unit = data_unit;
+    this->data_unit_length = data_unit_length;
+}
+
+/*
+ *  AESStream::EncryptFile()
+ *
+ *  Description:
+ *      This function will encrypt the input file, writing the ciphertext to
+ *      the output file, which is created or replaced.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The file holding the plaintext.
+ *
+ *      output [in]
+ *          The file to hold the ciphertext.  This must not be the same file
+ *          as the input, which is checked before the output is modified.
+ *
+ *      tag [out]
+ *          A buffer to hold the GCM authentication tag, which must be one of
+ *          4, 8, 12, 13, 14, 15, or 16 octets in length.  This must be empty
+ *          for other modes.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if any parameter is
+ *      invalid, if the input and output are the same file, or if the files
+ *      cannot be read or written.
+ *
+ *  Comments:
+ *      If an error occurs once the output file has been truncated, it is
+ *      truncated again so that no partial ciphertext remains.
+ */
+void AESStream::EncryptFile(const std::filesystem::path &input,
+                            const std::filesystem::path &output,
+                            std::span<std::uint8_t> tag)
+{
+    Start(tag.size(), true);
+    ProcessFile(input, output, true);
+    Final(tag);
+}
+
+/*
+ *  AESStream::DecryptFile()
+ *
+ *  Description:
+ *      This function will decrypt the input file, writing the plaintext to
+ *      the output file, which is created or replaced.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The file holding the ciphertext.
+ *
+ *      output [in]
+ *          The file to hold the plaintext.  This must not be the same file
+ *          as the input, which is checked before the output is modified.
+ *
+ *      tag [in]
+ *          The GCM authentication tag to verify, which must be one of 4, 8,
+ *          12, 13, 14, 15, or 16 octets in length.  This must be empty for
+ *          other modes.
+ *
+ *  Returns:
+ *      True if the plaintext is authentic or the mode is not GCM, false
+ *      otherwise.  An AESException will be thrown if any parameter is
+ *      invalid, if the input and output are the same file, or if the files
+ *      cannot be read or written.
+ *
+ *  Comments:
+ *      If the tag is not valid or an error occurs once the output file has
+ *      been truncated, the output file is truncated so that unauthenticated
+ *      plaintext is not released.
+ */
+bool AESStream::DecryptFile(const std::filesystem::path &input,
+                            const std::filesystem::path &output,
+                            const std::span<const std::uint8_t> tag)
+{
+    Start(tag.size(), false);
+    ProcessFile(input, output, false);
+
+    if (!Verify(tag))
+    {
+        std::filesystem::resize_file(output, 0);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ *  AESStream::EncryptFileInPlace()
+ *
+ *  Description:
+ *      This function will encrypt the given file, replacing the plaintext
+ *      with the ciphertext.
+ *
+ *  Parameters:
+ *      file [in]
+ *          The file holding the plaintext.
+ *
+ *      tag [out]
+ *          A buffer to hold the GCM authentication tag, which must be one of
+ *          4, 8, 12, 13, 14, 15, or 16 octets in length.  This must be empty
+ *          for other modes.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if any parameter is
+ *      invalid or if the file cannot be read or written.
+ *
+ *  Comments:
+ *      If an exception is thrown, part of the file may have been encrypted.
+ */
+void AESStream::EncryptFileInPlace(const std::filesystem::path &file,
+                                   std::span<std::uint8_t> tag)
+{
+    Start(tag.size(), true);
+    ProcessFileInPlace(file, true, false);
+    Final(tag);
+}
+
+/*
+ *  AESStream::DecryptFileInPlace()
+ *
+ *  Description:
+ *      This function will decrypt the given file, replacing the ciphertext
+ *      with the plaintext.
+ *
+ *  Parameters:
+ *      file [in]
+ *          The file holding the ciphertext.
+ *
+ *      tag [in]
+ *          The GCM authentication tag to verify, which must be one of 4, 8,
+ *          12, 13, 14, 15, or 16 octets in length.  This must be empty for
+ *          other modes.
+ *
+ *  Returns:
+ *      True if the plaintext is authentic or the mode is not GCM, false
+ *      otherwise.  An AESException will be thrown if any parameter is
+ *      invalid or if the file cannot be read or written.
+ *
+ *  Comments:
+ *      With GCM, the file is read and authenticated before it is decrypted
+ *      in a second pass, so the file is unchanged if the tag is not valid.
+ */
+bool AESStream::DecryptFileInPlace(const std::filesystem::path &file,
+                                   const std::span<const std::uint8_t> tag)
+{
+    Start(tag.size(), false);
+
+    if (mode == AESStreamMode::GCM)
+    {
+        ProcessFileInPlace(file, false, true);
+        if (!Verify(tag)) return false;
+
+        Start(tag.size(), false);
+    }
+
+    ProcessFileInPlace(file, false, false);
+
+    return Verify(tag);
+}
+
+/*
+ *  AESStream::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt the input stream until the end of the
+ *      stream is reached, writing the ciphertext to the output stream.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The stream from which the plaintext is read.
+ *
+ *      output [in]
+ *          The stream to which the ciphertext is written.  This must not be
+ *          the same stream as the input.
+ *
+ *      tag [out]
+ *          A buffer to hold the GCM authentication tag, which must be one of
+ *          4, 8, 12, 13, 14, 15, or 16 octets in length.  This must be empty
+ *          for other modes.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if any parameter is
+ *      invalid or if the streams cannot be read or written.
+ *
+ *  Comments:
+ *      The input stream is read on another thread.
+ */
+void AESStream::Encrypt(std::istream &input,
+                        std::ostream &output,
+                        std::span<std::uint8_t> tag)
+{
+    Start(tag.size(), true);
+    ProcessStream(input, output, true);
+    Final(tag);
+}
+
+/*
+ *  AESStream::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt the input stream until the end of the
+ *      stream is reached, writing the plaintext to the output stream.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The stream from which the ciphertext is read.
+ *
+ *      output [in]
+ *          The stream to which the plaintext is written.  This must not be
+ *          the same stream as the input.
+ *
+ *      tag [in]
+ *          The GCM authentication tag to verify, which must be one of 4, 8,
+ *          12, 13, 14, 15, or 16 octets in length.  This must be empty for
+ *          other modes.
+ *
+ *  Returns:
+ *      True if the plaintext is authentic or the mode is not GCM, false
+ *      otherwise.  An AESException will be thrown if any parameter is
+ *      invalid or if the streams cannot be read or written.
+ *
+ *  Comments:
+ *      The plaintext is written as it is produced, so with GCM it must not
+ *      be used unless this function returns true.
+ */
+bool AESStream::Decrypt(std::istream &input,
+                        std::ostream &output,
+                        const std::span<const std::uint8_t> tag)
+{
+    Start(tag.size(), false);
+    ProcessStream(input, output, false);
+
+    return Verify(tag);
+}
+
+/*
+ *  AESStream::GetEngineType()
+ *
+ *  Description:
+ *      Return the AES engine used by the mode of operation.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The engine type.
+ *
+ *  Comments:
+ *      None.
+ */
+AESEngineType AESStream::GetEngineType() const noexcept
+{
+    switch (mode)
+    {
+        case AESStreamMode::CTR:
+            return ctr.GetEngineType();
+
+        case AESStreamMode::GCM:
+            return gcm.GetEngineType();
+
+        case AESStreamMode::XTS:
+            return xts.GetEngineType();
+    }
+
+    return AESEngineType::Unavailable;
+}
+
+/*
+ *  AESStream::Start()
+ *
+ *  Description:
+ *      This function will verify the tag length and prepare the mode of
+ *      operation to process a new file or stream.
+ *
+ *  Parameters:
+ *      tag_length [in]
+ *          The length of the tag given to the calling function.
+ *
+ *      encrypt [in]
+ *          True if encrypting, false if decrypting.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the tag length is
+ *      invalid or if the IV has not been set.
+ *
+ *  Comments:
+ *      The tag length is checked before any data is processed so that an
+ *      invalid length is not reported only at the end of a large file.
+ *      When encrypting with CTR or GCM, the IV is erased once it has been
+ *      given to the mode, so that it cannot be reused by a later operation
+ *      and SetIV() must be called again before the next encryption.
+ */
+void AESStream::Start(std::size_t tag_length, bool encrypt)
+{
+    statistics = {};
+
+    switch (mode)
+    {
+        case AESStreamMode::CTR:
+            if (tag_length != 0)
+            {
+                throw AESException("A tag is only used with GCM");
+            }
+            if (iv.size() != 16)
+            {
+                throw AESException("The initial counter has not been set");
+            }
+            ctr.SetCounter(std::span<const std::uint8_t, 16>(iv.data(), 16));
+            if (encrypt) ClearIV();
+            break;
+
+        case AESStreamMode::GCM:
+            if ((tag_length != 4) && (tag_length != 8) &&
+                ((tag_length < 12) || (tag_length > 16)))
+            {
+                throw AESException("The tag length is invalid");
+            }
+            if (iv.empty())
+            {
+                throw AESException("The IV has not been set");
+            }
+            gcm.Start(iv, aad);
+            if (encrypt) ClearIV();
+            break;
+
+        case AESStreamMode::XTS:
+            if (tag_length != 0)
+            {
+                throw AESException("A tag is only used with GCM");
+            }
+            data_unit = first_data_unit;
+            break;
+    }
+}
+
+/*
+ *  AESStream::Final()
+ *
+ *  Description:
+ *      This function will produce the GCM authentication tag once all of
+ *      the plaintext has been encrypted.
+ *
+ *  Parameters:
+ *      tag [out]
+ *          A buffer to hold the authentication tag, which is empty unless
+ *          the mode is GCM.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESStream::Final(std::span<std::uint8_t> tag)
+{
+    if (mode == AESStreamMode::GCM) gcm.Final(tag);
+}
+
+/*
+ *  AESStream::Verify()
+ *
+ *  Description:
+ *      This function will verify the GCM authentication tag once all of the
+ *      ciphertext has been processed.
+ *
+ *  Parameters:
+ *      tag [in]
+ *          The authentication tag, which is empty unless the mode is GCM.
+ *
+ *  Returns:
+ *      True if the tag is valid or the mode is not GCM, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESStream::Verify(const std::span<const std::uint8_t> tag)
+{
+    if (mode == AESStreamMode::GCM) return gcm.Verify(tag);
+
+    return true;
+}
+
+/*
+ *  AESStream::CheckLength()
+ *
+ *  Description:
+ *      This function will check that data of the given length can be
+ *      processed in the current mode.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The total length of the data to process.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the final XTS data
+ *      unit would be shorter than 16 octets or if the length exceeds the
+ *      maximum length of a GCM message.
+ *
+ *  Comments:
+ *      This is called with the length of a file before any of it is
+ *      processed, as these errors would otherwise only be detected once
+ *      the final chunk is reached.
+ */
+void AESStream::CheckLength(std::uint64_t length) const
+{
+    if ((mode == AESStreamMode::XTS) &&
+        ((length % data_unit_length) > 0) &&
+        ((length % data_unit_length) < 16))
+    {
+        throw AESException("The final data unit must be at least 16 octets");
+    }
+
+    if ((mode == AESStreamMode::GCM) &&
+        (length > AESGCM::Max_Plaintext_Length))
+    {
+        throw AESException("The data is too long for GCM");
+    }
+}
+
+/*
+ *  AESStream::ProcessChunk()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt one chunk of data.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The chunk to encrypt or decrypt.
+ *
+ *      output [out]
+ *          The buffer to hold the result, which may be the same as the
+ *          input.
+ *
+ *      length [in]
+ *          The length of the chunk, which is less than the chunk size only
+ *          for the final chunk.
+ *
+ *      encrypt [in]
+ *          True to encrypt the chunk, false to decrypt it.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown by the mode of
+ *      operation if the data cannot be processed.
+ *
+ *  Comments:
+ *      Since the chunk size is a multiple of the XTS data unit length, each
+ *      chunk holds whole data units, except possibly for the last.
+ */
+void AESStream::ProcessChunk(const std::uint8_t *input,
+                             std::uint8_t *output,
+                             std::size_t length,
+                             bool encrypt)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const std::span<const std::uint8_t> in(input, length);
+    const std::span<std::uint8_t> out(output, length);
+
+    switch (mode)
+    {
+        case AESStreamMode::CTR:
+            if (encrypt)
+            {
+                ctr.Encrypt(in, out);
+            }
+            else
+            {
+                ctr.Decrypt(in, out);
+            }
+            break;
+
+        case AESStreamMode::GCM:
+            if (encrypt)
+            {
+                gcm.EncryptUpdate(in, out);
+            }
+            else
+            {
+                gcm.DecryptUpdate(in, out);
+            }
+            break;
+
+        case AESStreamMode::XTS:
+            for (std::size_t offset = 0; offset < length;)
+            {
+                const std::size_t unit_length =
+                    std::min(data_unit_length, length - offset);
+
+                if (encrypt)
+                {
+                    xts.Encrypt(data_unit,
+                                in.subspan(offset, unit_length),
+                                out.subspan(offset, unit_length));
+                }
+                else
+                {
+                    xts.Decrypt(data_unit,
+                                in.subspan(offset, unit_length),
+                                out.subspan(offset, unit_length));
+                }
+
+                data_unit++;
+                offset += unit_length;
+            }
+            break;
+    }
+
+    statistics.cipher_time += ElapsedTime(start);
+}
+
+/*
+ *  AESStream::ProcessStream()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt the input stream until the end
+ *      of the stream is reached, writing the result to the output stream.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The stream to read.
+ *
+ *      output [in]
+ *          The stream to write.
+ *
+ *      encrypt [in]
+ *          True to encrypt, false to decrypt.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the streams
+ *      cannot be read or written.
+ *
+ *  Comments:
+ *      Each chunk is processed in place in its buffer.  As a buffer is
+ *      processed and written, the next chunk is read into the other buffer
+ *      on another thread.
+ */
+void AESStream::ProcessStream(std::istream &input,
+                              std::ostream &output,
+                              bool encrypt)
+{
+    auto last = std::chrono::steady_clock::now();
+    std::size_t current{};
+
+    for (auto &buffer : buffers) buffer.resize(chunk_size);
+
+    auto read = [&input](std::vector<std::uint8_t> &buffer) -> std::size_t
+    {
+        input.read(reinterpret_cast<char *>(buffer.data()),
+                   static_cast<std::streamsize>(buffer.size()));
+
+        if (input.bad())
+        {
+            throw AESException("Unable to read from the input stream");
+        }
+
+        return static_cast<std::size_t>(input.gcount());
+    };
+
+    auto io_start = std::chrono::steady_clock::now();
+    std::size_t length = read(buffers[current]);
+    statistics.io_time += ElapsedTime(io_start);
+
+    while (length > 0)
+    {
+        std::future<std::size_t> next;
+
+        // Read the next chunk unless the end of the stream was reached
+        if (length == chunk_size)
+        {
+            next = std::async(std::launch::async,
+                              read,
+                              std::ref(buffers[current ^ 1]));
+        }
+
+        ProcessChunk(buffers[current].data(),
+                     buffers[current].data(),
+                     length,
+                     encrypt);
+
+        io_start = std::chrono::steady_clock::now();
+
+        output.write(reinterpret_cast<const char *>(buffers[current].data()),
+                     static_cast<std::streamsize>(length));
+
+        if (!output)
+        {
+            throw AESException("Unable to write to the output stream");
+        }
+
+        RecordChunk(length, last);
+
+        length = next.valid() ? next.get() : 0;
+        current ^= 1;
+
+        statistics.io_time += ElapsedTime(io_start);
+    }
+
+    for (auto &buffer : buffers)
+    {
+        SecUtil::SecureErase(buffer.data(), buffer.size());
+    }
+}
+
+#ifndef _WIN32
+
+/*
+ *  AESStream::ProcessFile()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt the input file, writing the
+ *      result to the output file.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The file to read.
+ *
+ *      output [in]
+ *          The file to write, which is created or replaced.
+ *
+ *      encrypt [in]
+ *          True to encrypt, false to decrypt.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the input and
+ *      output are the same file, if the length of the input is invalid for
+ *      the mode, or if the files cannot be read or written.
+ *
+ *  Comments:
+ *      The output file is opened without truncating it and compared with
+ *      the input file, so that naming the same file twice (including via a
+ *      link) does not destroy the input.  It is then truncated and extended
+ *      to its final length before any data is written.  On Linux, space for
+ *      the file is allocated, so that a lack of space is reported as an
+ *      error rather than by a fault when a mapped page is written.  If an
+ *      error occurs once the output has been truncated, it is truncated again
+ *      so that no partial result remains.
+ */
+void AESStream::ProcessFile(const std::filesystem::path &input,
+                            const std::filesystem::path &output,
+                            bool encrypt)
+{
+    auto last = std::chrono::steady_clock::now();
+    FileDescriptor input_file(input, O_RDONLY);
+    FileDescriptor output_file(output, O_RDWR | O_CREAT);
+    const std::uint64_t size = input_file.Size();
+    MappedChunk input_chunks[2];
+    MappedChunk output_chunk;
+    std::size_t current{};
+
+    if (output_file.SameFile(input_file)) throw AESException(Same_File_Error);
+
+    CheckLength(size);
+
+    OutputGuard output_guard(output);
+
+    if (::ftruncate(output_file.Get(), 0) != 0)
+    {
+        throw AESException("Unable to truncate the output file");
+    }
+
+    if (size == 0)
+    {
+        output_guard.Dismiss();
+        return;
+    }
+
+    if (::ftruncate(output_file.Get(), static_cast<off_t>(size)) != 0)
+    {
+        throw AESException("Unable to set the length of the output file");
+    }
+
+#ifdef __linux__
+    if (::posix_fallocate(output_file.Get(), 0, static_cast<off_t>(size)) !=
+        0)
+    {
+        throw AESException("Unable to allocate space for the output file");
+    }
+#endif
+
+    input_chunks[current].Map(input_file,
+                              0,
+                              static_cast<std::size_t>(
+                                  std::min<std::uint64_t>(chunk_size, size)),
+                              false);
+
+    for (std::uint64_t offset = 0; offset < size; offset += chunk_size)
+    {
+        const std::size_t length = input_chunks[current].length;
+        const std::uint64_t remaining = size - offset - length;
+
+        auto io_start = std::chrono::steady_clock::now();
+
+        // Start reading the next chunk as this one is processed
+        if (remaining > 0)
+        {
+            input_chunks[current ^ 1].Map(
+                input_file,
+                offset + length,
+                static_cast<std::size_t>(
+                    std::min<std::uint64_t>(chunk_size, remaining)),
+                false);
+        }
+
+        output_chunk.Map(output_file, offset, length, true);
+
+        statistics.io_time += ElapsedTime(io_start);
+
+        ProcessChunk(input_chunks[current].data,
+                     output_chunk.data,
+                     length,
+                     encrypt);
+
+        io_start = std::chrono::steady_clock::now();
+
+        output_chunk.WriteBack(output_file);
+        output_chunk.Unmap();
+        input_chunks[current].Unmap();
+
+        statistics.io_time += ElapsedTime(io_start);
+
+        RecordChunk(length, last);
+
+        current ^= 1;
+    }
+
+    output_guard.Dismiss();
+}
+
+/*
+ *  AESStream::ProcessFileInPlace()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt the given file in place or,
+ *      with GCM, authenticate the file without modifying it.
+ *
+ *  Parameters:
+ *      file [in]
+ *          The file to process.
+ *
+ *      encrypt [in]
+ *          True to encrypt, false to decrypt.
+ *
+ *      authenticate_only [in]
+ *          True if the file is to be decrypted only to compute the tag, in
+ *          which case the plaintext is discarded and the file unchanged.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the length of the
+ *      file is invalid for the mode or if the file cannot be read or
+ *      written.
+ *
+ *  Comments:
+ *      The length of the file is checked before any of it is processed, so
+ *      that the file is not left partly processed.  When authenticating,
+ *      each chunk is decrypted into a buffer that is erased once the whole
+ *      file has been processed.
+ */
+void AESStream::ProcessFileInPlace(const std::filesystem::path &file,
+                                   bool encrypt,
+                                   bool authenticate_only)
+{
+    auto last = std::chrono::steady_clock::now();
+    FileDescriptor data_file(file, authenticate_only ? O_RDONLY : O_RDWR);
+    const std::uint64_t size = data_file.Size();
+    MappedChunk chunks[2];
+    std::size_t current{};
+
+    CheckLength(size);
+
+    if (size == 0) return;
+
+    if (authenticate_only) buffers[0].resize(chunk_size);
+
+    chunks[current].Map(data_file,
+                        0,
+                        static_cast<std::size_t>(
+                            std::min<std::uint64_t>(chunk_size, size)),
+                        !authenticate_only);
+
+    for (std::uint64_t offset = 0; offset < size; offset += chunk_size)
+    {
+        const std::size_t length = chunks[current].length;
+        const std::uint64_t remaining = size - offset - length;
+
+        auto io_start = std::chrono::steady_clock::now();
+
+        // Start reading the next chunk as this one is processed
+        if (remaining > 0)
+        {
+            chunks[current ^ 1].Map(
+                data_file,
+                offset + length,
+                static_cast<std::size_t>(
+                    std::min<std::uint64_t>(chunk_size, remaining)),
+                !authenticate_only);
+        }
+
+        statistics.io_time += ElapsedTime(io_start);
+
+        ProcessChunk(chunks[current].data,
+                     authenticate_only ? buffers[0].data() :
+                                         chunks[current].data,
+                     length,
+                     encrypt);
+
+        io_start = std::chrono::steady_clock::now();
+
+        if (!authenticate_only) chunks[current].WriteBack(data_file);
+        chunks[current].Unmap();
+
+        statistics.io_time += ElapsedTime(io_start);
+
+        RecordChunk(length, last);
+
+        current ^= 1;
+    }
+
+    if (authenticate_only)
+    {
+        SecUtil::SecureErase(buffers[0].data(), buffers[0].size());
+    }
+}
+
+#else // _WIN32
+
+/*
+ *  AESStream::ProcessFile()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt the input file, writing the
+ *      result to the output file.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The file to read.
+ *
+ *      output [in]
+ *          The file to write, which is created or replaced.
+ *
+ *      encrypt [in]
+ *          True to encrypt, false to decrypt.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the input and
+ *      output are the same file, if the length of the input is invalid for
+ *      the mode, or if the files cannot be read or written.
+ *
+ *  Comments:
+ *      The files are processed as streams.  The files are compared before
+ *      the output is opened, as opening it truncates it.  If an error occurs
+ *      once the output has been opened, it is truncated so that no partial
+ *      result remains.
+ */
+void AESStream::ProcessFile(const std::filesystem::path &input,
+                            const std::filesystem::path &output,
+                            bool encrypt)
+{
+    std::error_code error;
+
+    std::ifstream input_file(input, std::ios::binary);
+    if (!input_file) throw AESException("Unable to open the file");
+
+    if (std::filesystem::equivalent(input, output, error))
+    {
+        throw AESException(Same_File_Error);
+    }
+
+    CheckLength(std::filesystem::file_size(input));
+
+    OutputGuard output_guard(output);
+
+    std::ofstream output_file(output, std::ios::binary | std::ios::trunc);
+    if (!output_file) throw AESException("Unable to open the file");
+
+    ProcessStream(input_file, output_file, encrypt);
+
+    output_file.flush();
+    if (!output_file) throw AESException("Unable to write to the file");
+
+    output_guard.Dismiss();
+}
+
+/*
+ *  AESStream::ProcessFileInPlace()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt the given file in place or,
+ *      with GCM, authenticate the file without modifying it.
+ *
+ *  Parameters:
+ *      file [in]
+ *          The file to process.
+ *
+ *      encrypt [in]
+ *          True to encrypt, false to decrypt.
+ *
+ *      authenticate_only [in]
+ *          True if the file is to be decrypted only to compute the tag, in
+ *          which case the plaintext is discarded and the file unchanged.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the length of the
+ *      file is invalid for the mode or if the file cannot be read or
+ *      written.
+ *
+ *  Comments:
+ *      Each chunk is read, processed, and written back in turn, once the
+ *      length of the file has been checked.
+ */
+void AESStream::ProcessFileInPlace(const std::filesystem::path &file,
+                                   bool encrypt,
+                                   bool authenticate_only)
+{
+    auto last = std::chrono::steady_clock::now();
+    std::fstream data_file(file, std::ios::binary | std::ios::in |
+                                     (authenticate_only ? std::ios::openmode{}
+                                                        : std::ios::out));
+    std::uint64_t offset{};
+
+    if (!data_file) throw AESException("Unable to open the file");
+
+    CheckLength(std::filesystem::file_size(file));
+
+    buffers[0].resize(chunk_size);
+
+    while (true)
+    {
+        auto io_start = std::chrono::steady_clock::now();
+
+        data_file.seekg(static_cast<std::streamoff>(offset));
+        data_file.read(reinterpret_cast<char *>(buffers[0].data()),
+                       static_cast<std::streamsize>(buffers[0].size()));
+        if (data_file.bad()) throw AESException("Unable to read the file");
+
+        const auto length = static_cast<std::size_t>(data_file.gcount());
+        data_file.clear();
+
+        statistics.io_time += ElapsedTime(io_start);
+
+        if (length == 0) break;
+
+        ProcessChunk(buffers[0].data(), buffers[0].data(), length, encrypt);
+
+        if (!authenticate_only)
+        {
+            io_start = std::chrono::steady_clock::now();
+
+            data_file.seekp(static_cast<std::streamoff>(offset));
+            data_file.write(reinterpret_cast<const char *>(buffers[0].data()),
+                            static_cast<std::streamsize>(length));
+            if (!data_file) throw AESException("Unable to write to the file");
+
+            statistics.io_time += ElapsedTime(io_start);
+        }
+
+        RecordChunk(length, last);
+
+        offset += length;
+    }
+
+    SecUtil::SecureErase(buffers[0].data(), buffers[0].size());
+}
+
+#endif // _WIN32
+
+/*
+ *  AESStream::RecordChunk()
+ *
+ *  Description:
+ *      This function will account for a chunk that has been processed in
+ *      the statistics and instrumentation counters.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the chunk.
+ *
+ *      last [in/out]
+ *          The time the previous chunk was recorded or the operation began,
+ *          which is updated to the current time.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The time recorded for each chunk is the time since the previous
+ *      chunk, so that the total is the duration of the operation.
+ */
+void AESStream::RecordChunk(std::size_t length,
+                            std::chrono::steady_clock::time_point &last)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto duration =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - last);
+
+    statistics.octets += length;
+    statistics.chunks++;
+    statistics.elapsed += duration;
+
+    RecordAESEvent(*this, AESCounter::StreamOctets, length);
+    RecordAESEvent(*this,
+                   AESCounter::StreamNanoseconds,
+                   static_cast<std::uint64_t>(duration.count()));
+
+    last = now;
+}
+
+} // namespace Terra::Crypto::Cipher
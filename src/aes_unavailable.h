@@ -41,17 +41,28 @@ struct AESUnavailable : public AESEngine
         return AESEngineType::Unavailable;
     }
 
-    void SetKey(const std::span<const std::uint8_t>) override {}
+    void SetKey(const std::span<const std::uint8_t>,
+                AESKeyUsage = AESKeyUsage::EncryptDecrypt) override {}
 
     void ClearKeyState() override {}
 
     void Encrypt(const std::span<const std::uint8_t, 16>,
-                 std::span<std::uint8_t, 16>) noexcept override
+                 std::span<std::uint8_t, 16>) const noexcept override
     {
     }
 
     void Decrypt(const std::span<const std::uint8_t, 16>,
-                 std::span<std::uint8_t, 16>) noexcept override
+                 std::span<std::uint8_t, 16>) const noexcept override
+    {
+    }
+
+    void EncryptBlocks(const std::span<const std::uint8_t>,
+                       std::span<std::uint8_t>) const noexcept override
+    {
+    }
+
+    void DecryptBlocks(const std::span<const std::uint8_t>,
+                       std::span<std::uint8_t>) const noexcept override
     {
     }
 
@@ -24,6 +24,11 @@
  *      This implementation of AES is called "universal" as it can operate on
  *      any processor and is not dependent on processor-specific features.
  *
+ *      The rounds use four 1 KiB tables each for encryption and decryption.
+ *      If TERRA_ENABLE_AES_COMPACT_TABLES is defined, a single table of each
+ *      is used and its entries rotated to produce the others, reducing the
+ *      cache footprint at the expense of three rotations per column.
+ *
  *  Portability Issues:
  *      None.
  */
@@ -61,8 +66,6 @@ AESUniversal::AESUniversal() noexcept :
     AESEngine(),
     Nr{},
     Nk{},
-    state{},
-    alt_state{},
     W{},
     DW{}
 {
@@ -238,6 +241,12 @@ AESUniversal &AESUniversal::operator=(AESUniversal &&other) noexcept
  *      key [in]
  *          The encryption key to use with this instance of the object.
  *
+ *      key_usage [in]
+ *          Indicates whether the key will be used for both encryption and
+ *          decryption or only for encryption.  If AESKeyUsage::EncryptOnly,
+ *          the decryption key schedule is not computed and Decrypt() and
+ *          DecryptBlocks() must not be called until the key is set again.
+ *
  *  Returns:
  *      Nothing, though an exception will be thrown if the key provided is not
  *      one of 16, 24, or 32 octets in length as required by the standard.
@@ -245,7 +254,8 @@ AESUniversal &AESUniversal::operator=(AESUniversal &&other) noexcept
  *  Comments:
  *      None.
  */
-void AESUniversal::SetKey(const std::span<const std::uint8_t> key)
+void AESUniversal::SetKey(const std::span<const std::uint8_t> key,
+                          AESKeyUsage key_usage)
 {
     // Zero the key schedule
     SecUtil::SecureErase(W);
@@ -343,6 +353,30 @@ void AESUniversal::SetKey(const std::span<const std::uint8_t> key)
             break;
     }
 
+    // The decryption round keys are not needed if only encrypting
+    if (key_usage == AESKeyUsage::EncryptOnly) return;
+
+    SetDecryptionKeys();
+}
+
+/*
+ * AESUniversal::SetDecryptionKeys()
+ *
+ *  Description:
+ *      Compute the decryption round keys (DW) from the encryption round
+ *      keys (W).
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESUniversal::SetDecryptionKeys() noexcept
+{
     // Populate decryption round key array (DW)
     for (std::uint_fast32_t *dw = DW.data(),
                             *w = W.data() + (Nr * Nb),
@@ -368,6 +402,183 @@ void AESUniversal::SetKey(const std::span<const std::uint8_t> key)
     }
 }
 
+/*
+ * AESUniversal::SetKeys()
+ *
+ *  Description:
+ *      This function will set the key for each of the given engines,
+ *      expanding several keys at once where possible.
+ *
+ *  Parameters:
+ *      engines [in]
+ *          The engines whose keys are to be set.
+ *
+ *      keys [in]
+ *          The key for each engine, in the same order as the engines.
+ *
+ *      key_usage [in]
+ *          Indicates whether the keys will be used for both encryption and
+ *          decryption or only for encryption.  See SetKey().
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the number of keys
+ *      does not match the number of engines or if any key is not 16, 24, or
+ *      32 octets in length.  No engine is modified if an exception is thrown.
+ *
+ *  Comments:
+ *      Groups of four consecutive keys having the same length are expanded
+ *      together so that the table lookups for the four keys may proceed in
+ *      parallel.  Any other key is expanded individually via SetKey().
+ *      Rather than erasing the entire key schedule first, only round keys
+ *      not replaced by the new key schedule are erased.
+ */
+void AESUniversal::SetKeys(
+            const std::span<AESUniversal * const> engines,
+            const std::span<const std::span<const std::uint8_t>> keys,
+            AESKeyUsage key_usage)
+{
+    std::size_t i{};
+
+    // There must be exactly one key for each engine
+    if (engines.size() != keys.size())
+    {
+        throw AESException("There must be one key for each engine");
+    }
+
+    // Verify all of the keys before modifying any engine
+    for (const auto &key : keys)
+    {
+        if ((key.size() != 16) && (key.size() != 24) && (key.size() != 32))
+        {
+            throw AESException("Invalid key length provided");
+        }
+    }
+
+    while (i < engines.size())
+    {
+        const std::size_t key_length = keys[i].size();
+        std::size_t count = 1;
+
+        // Count the consecutive keys having the same length
+        while ((count < Key_Expansion_Lanes) && (i + count < keys.size()) &&
+               (keys[i + count].size() == key_length))
+        {
+            count++;
+        }
+
+        // Expand this key alone if it cannot be expanded with others
+        if (count < Key_Expansion_Lanes)
+        {
+            engines[i]->AESUniversal::SetKey(keys[i], key_usage);
+            i++;
+            continue;
+        }
+
+        ExpandKeys(engines.data() + i, keys.data() + i);
+
+        for (std::size_t j = i; j < i + Key_Expansion_Lanes; j++)
+        {
+            AESUniversal &engine = *engines[j];
+            const std::size_t used = Nb * (engine.Nr + 1);
+            const std::size_t unused = engine.W.size() - used;
+
+            // Erase only the round keys the new key schedule does not replace
+            SecUtil::SecureErase(engine.W.data() + used,
+                                 unused * sizeof(std::uint_fast32_t));
+
+            // The decryption round keys are not needed if only encrypting
+            if (key_usage == AESKeyUsage::EncryptOnly)
+            {
+                SecUtil::SecureErase(engine.DW);
+                continue;
+            }
+
+            engine.SetDecryptionKeys();
+            SecUtil::SecureErase(engine.DW.data() + used,
+                                 unused * sizeof(std::uint_fast32_t));
+        }
+
+        i += Key_Expansion_Lanes;
+    }
+}
+
+/*
+ * AESUniversal::ExpandKeys()
+ *
+ *  Description:
+ *      Compute the encryption round keys (W) for four keys of the same
+ *      length at once.
+ *
+ *  Parameters:
+ *      engines [in]
+ *          The four engines whose round keys are to be computed.
+ *
+ *      keys [in]
+ *          The four keys, which must all be 16, 24, or 32 octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This follows the key expansion in Section 5.2 of FIPS 197, computing
+ *      each word of the key schedule for all four keys before moving to the
+ *      next word.  Words beyond those used by the key are not modified.
+ */
+void AESUniversal::ExpandKeys(
+            AESUniversal * const *engines,
+            const std::span<const std::uint8_t> *keys) noexcept
+{
+    const std::size_t Nk = keys[0].size() / 4;
+    const std::size_t Nr = Nk + 6;
+    const std::size_t words = Nb * (Nr + 1);
+
+    ForEachLane<Key_Expansion_Lanes>([&](auto lane)
+    {
+        AESUniversal &engine = *engines[lane];
+
+        engine.Nr = Nr;
+        engine.Nk = Nk;
+
+        // Fill the first Nk 32-bit words in the round key array W
+        for (std::size_t i = 0; i < Nk; i++)
+        {
+            engine.W[i] = GetWordFromBuffer<std::uint_fast32_t>(keys[lane], i);
+        }
+    });
+
+    // Fill the remaining words in the round key arrays
+    for (std::size_t i = Nk, j = 0, k = 0; i < words; i++)
+    {
+        if (k == 0)
+        {
+            ForEachLane<Key_Expansion_Lanes>([&](auto lane)
+            {
+                std::uint_fast32_t *w = engines[lane]->W.data();
+                w[i] = w[i - Nk] ^ SubBytes(RotWord(w[i - 1])) ^ Rcon[j];
+            });
+            j++;
+        }
+        else if ((Nk > 6) && (k == 4))
+        {
+            ForEachLane<Key_Expansion_Lanes>([&](auto lane)
+            {
+                std::uint_fast32_t *w = engines[lane]->W.data();
+                w[i] = w[i - Nk] ^ SubBytes(w[i - 1]);
+            });
+        }
+        else
+        {
+            ForEachLane<Key_Expansion_Lanes>([&](auto lane)
+            {
+                std::uint_fast32_t *w = engines[lane]->W.data();
+                w[i] = w[i - Nk] ^ w[i - 1];
+            });
+        }
+
+        if (++k == Nk) k = 0;
+    }
+}
+
 /*
  * AESUniversal::ClearKeyState()
  *
@@ -387,26 +598,25 @@ void AESUniversal::ClearKeyState()
 {
     SecUtil::SecureErase(&Nr, sizeof(Nr));
     SecUtil::SecureErase(&Nk, sizeof(Nk));
-    SecUtil::SecureErase(state);
-    SecUtil::SecureErase(alt_state);
     SecUtil::SecureErase(W);
     SecUtil::SecureErase(DW);
 }
 
 /*
- * AESUniversal::Encrypt()
+ * AESUniversal::EncryptRounds()
  *
  *  Description:
- *      This function will encrypt a block of plaintext and return the
- *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *      This function will encrypt a series of plaintext blocks using a key
+ *      schedule with the number of rounds given as the template parameter.
  *
  *  Parameters:
  *      plaintext [in]
- *          The 16-octet data block to encrypt.
+ *          The data to encrypt, which must be an integral number of 16-octet
+ *          blocks.
  *
  *      ciphertext [out]
- *          The 16-octet encrypted data block.  AES operates in place, so this
- *          span may be the same memory location as the plaintext span.
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
  *
  *  Returns:
  *      Nothing, though the encrypted data is stored in the ciphertext
@@ -423,143 +633,88 @@ void AESUniversal::ClearKeyState()
  *          3. Final round
  *              3a. ShiftRow
  *              3b. AddRoundKey
+ *
+ *      Since the number of rounds is known at compile time, the rounds are
+ *      fully unrolled and every index into the key schedule is a constant.
  */
-void AESUniversal::Encrypt(
-                const std::span<const std::uint8_t, AES_Block_Size> plaintext,
-                std::span<std::uint8_t, AES_Block_Size> ciphertext) noexcept
+template<std::size_t Rounds>
+void AESUniversal::EncryptRounds(
+                const std::span<const std::uint8_t> plaintext,
+                std::span<std::uint8_t> ciphertext) const noexcept
 {
-    // Step 1 - AddRoundKey() (i.e., XOR with W[i])
-    state[0] =
-        AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(plaintext, 0), W[0]);
-    state[1] =
-        AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(plaintext, 1), W[1]);
-    state[2] =
-        AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(plaintext, 2), W[2]);
-    state[3] =
-        AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(plaintext, 3), W[3]);
-
-    // Step 2 - Rounds 1 to Nr - 1 (MixColumns handled via array subscripts)
-
-    // Round 1
-    alt_state[0] = AddRoundKey(MixColShiftRow(0, state), W[4]);
-    alt_state[1] = AddRoundKey(MixColShiftRow(1, state), W[5]);
-    alt_state[2] = AddRoundKey(MixColShiftRow(2, state), W[6]);
-    alt_state[3] = AddRoundKey(MixColShiftRow(3, state), W[7]);
-
-    // Round 2
-    state[0] = AddRoundKey(MixColShiftRow(0, alt_state), W[8]);
-    state[1] = AddRoundKey(MixColShiftRow(1, alt_state), W[9]);
-    state[2] = AddRoundKey(MixColShiftRow(2, alt_state), W[10]);
-    state[3] = AddRoundKey(MixColShiftRow(3, alt_state), W[11]);
-
-    // Round 3
-    alt_state[0] = AddRoundKey(MixColShiftRow(0, state), W[12]);
-    alt_state[1] = AddRoundKey(MixColShiftRow(1, state), W[13]);
-    alt_state[2] = AddRoundKey(MixColShiftRow(2, state), W[14]);
-    alt_state[3] = AddRoundKey(MixColShiftRow(3, state), W[15]);
-
-    // Round 4
-    state[0] = AddRoundKey(MixColShiftRow(0, alt_state), W[16]);
-    state[1] = AddRoundKey(MixColShiftRow(1, alt_state), W[17]);
-    state[2] = AddRoundKey(MixColShiftRow(2, alt_state), W[18]);
-    state[3] = AddRoundKey(MixColShiftRow(3, alt_state), W[19]);
-
-    // Round 5
-    alt_state[0] = AddRoundKey(MixColShiftRow(0, state), W[20]);
-    alt_state[1] = AddRoundKey(MixColShiftRow(1, state), W[21]);
-    alt_state[2] = AddRoundKey(MixColShiftRow(2, state), W[22]);
-    alt_state[3] = AddRoundKey(MixColShiftRow(3, state), W[23]);
-
-    // Round 6
-    state[0] = AddRoundKey(MixColShiftRow(0, alt_state), W[24]);
-    state[1] = AddRoundKey(MixColShiftRow(1, alt_state), W[25]);
-    state[2] = AddRoundKey(MixColShiftRow(2, alt_state), W[26]);
-    state[3] = AddRoundKey(MixColShiftRow(3, alt_state), W[27]);
-
-    // Round 7
-    alt_state[0] = AddRoundKey(MixColShiftRow(0, state), W[28]);
-    alt_state[1] = AddRoundKey(MixColShiftRow(1, state), W[29]);
-    alt_state[2] = AddRoundKey(MixColShiftRow(2, state), W[30]);
-    alt_state[3] = AddRoundKey(MixColShiftRow(3, state), W[31]);
-
-    // Round 8
-    state[0] = AddRoundKey(MixColShiftRow(0, alt_state), W[32]);
-    state[1] = AddRoundKey(MixColShiftRow(1, alt_state), W[33]);
-    state[2] = AddRoundKey(MixColShiftRow(2, alt_state), W[34]);
-    state[3] = AddRoundKey(MixColShiftRow(3, alt_state), W[35]);
-
-    // Round 9
-    alt_state[0] = AddRoundKey(MixColShiftRow(0, state), W[36]);
-    alt_state[1] = AddRoundKey(MixColShiftRow(1, state), W[37]);
-    alt_state[2] = AddRoundKey(MixColShiftRow(2, state), W[38]);
-    alt_state[3] = AddRoundKey(MixColShiftRow(3, state), W[39]);
-
-    if (Nr > 10)
+    // State array of four columns and the alternating state array used
+    // between rounds (on the stack so the key schedule is never modified)
+    SecUtil::SecureArray<std::uint_fast32_t, Nb> state;
+    SecUtil::SecureArray<std::uint_fast32_t, Nb> alt_state;
+
+    for (std::size_t offset = 0; offset < plaintext.size();
+         offset += AES_Block_Size)
     {
-        // Round 10
-        state[0] = AddRoundKey(MixColShiftRow(0, alt_state), W[40]);
-        state[1] = AddRoundKey(MixColShiftRow(1, alt_state), W[41]);
-        state[2] = AddRoundKey(MixColShiftRow(2, alt_state), W[42]);
-        state[3] = AddRoundKey(MixColShiftRow(3, alt_state), W[43]);
-
-        // Round 11
-        alt_state[0] = AddRoundKey(MixColShiftRow(0, state), W[44]);
-        alt_state[1] = AddRoundKey(MixColShiftRow(1, state), W[45]);
-        alt_state[2] = AddRoundKey(MixColShiftRow(2, state), W[46]);
-        alt_state[3] = AddRoundKey(MixColShiftRow(3, state), W[47]);
-
-        if (Nr > 12)
+        const auto input = plaintext.subspan(offset).first<AES_Block_Size>();
+        auto output = ciphertext.subspan(offset).first<AES_Block_Size>();
+
+        // Step 1 - AddRoundKey() (i.e., XOR with W[i])
+        state[0] =
+            AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(input, 0), W[0]);
+        state[1] =
+            AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(input, 1), W[1]);
+        state[2] =
+            AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(input, 2), W[2]);
+        state[3] =
+            AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(input, 3), W[3]);
+
+        // Step 2 - Rounds 1 to Nr - 1 (MixColumns handled via array
+        // subscripts), with odd rounds reading from the state array and even
+        // rounds reading from the alternating state array
+        ForEachRound<Rounds>([&](auto round)
         {
-            // Round 12
-            state[0] = AddRoundKey(MixColShiftRow(0, alt_state), W[48]);
-            state[1] = AddRoundKey(MixColShiftRow(1, alt_state), W[49]);
-            state[2] = AddRoundKey(MixColShiftRow(2, alt_state), W[50]);
-            state[3] = AddRoundKey(MixColShiftRow(3, alt_state), W[51]);
-
-            // Round 13
-            alt_state[0] = AddRoundKey(MixColShiftRow(0, state), W[52]);
-            alt_state[1] = AddRoundKey(MixColShiftRow(1, state), W[53]);
-            alt_state[2] = AddRoundKey(MixColShiftRow(2, state), W[54]);
-            alt_state[3] = AddRoundKey(MixColShiftRow(3, state), W[55]);
-        }
+            auto &in = (round % 2) ? state : alt_state;
+            auto &out = (round % 2) ? alt_state : state;
+
+            out[0] = AddRoundKey(MixColShiftRow(0, in), W[(round << 2) + 0]);
+            out[1] = AddRoundKey(MixColShiftRow(1, in), W[(round << 2) + 1]);
+            out[2] = AddRoundKey(MixColShiftRow(2, in), W[(round << 2) + 2]);
+            out[3] = AddRoundKey(MixColShiftRow(3, in), W[(round << 2) + 3]);
+        });
+
+        // Step 3 - Final round, then move into ciphertext
+        //     While this is a bit verbose, there is no need to store these
+        //     results back into the state array, as the result can be placed
+        //     directly into the ciphertext buffer
+        PutStateColumn(
+            AddRoundKey(SubBytesShiftRows(0, alt_state), W[(Rounds << 2) + 0]),
+            0,
+            output);
+        PutStateColumn(
+            AddRoundKey(SubBytesShiftRows(1, alt_state), W[(Rounds << 2) + 1]),
+            1,
+            output);
+        PutStateColumn(
+            AddRoundKey(SubBytesShiftRows(2, alt_state), W[(Rounds << 2) + 2]),
+            2,
+            output);
+        PutStateColumn(
+            AddRoundKey(SubBytesShiftRows(3, alt_state), W[(Rounds << 2) + 3]),
+            3,
+            output);
     }
-
-    // Step 3 - Final round, then move into ciphertext
-    //     While this is a bit verbose, there is no need to store these results
-    //     back into the state array, as the result can be placed directly
-    //     into the ciphertext buffer
-    PutStateColumn(
-        AddRoundKey(SubBytesShiftRows(0, alt_state), W[(Nr << 2) + 0]),
-        0,
-        ciphertext);
-    PutStateColumn(
-        AddRoundKey(SubBytesShiftRows(1, alt_state), W[(Nr << 2) + 1]),
-        1,
-        ciphertext);
-    PutStateColumn(
-        AddRoundKey(SubBytesShiftRows(2, alt_state), W[(Nr << 2) + 2]),
-        2,
-        ciphertext);
-    PutStateColumn(
-        AddRoundKey(SubBytesShiftRows(3, alt_state), W[(Nr << 2) + 3]),
-        3,
-        ciphertext);
 }
 
 /*
- * AESUniversal::Decrypt()
+ * AESUniversal::DecryptRounds()
  *
  *  Description:
- *      This function will decrypt a block of ciphertext and return the
- *      plaintext.  It is assumed the key was previously set via SetKey().
+ *      This function will decrypt a series of ciphertext blocks using a key
+ *      schedule with the number of rounds given as the template parameter.
  *
  *  Parameters:
  *      ciphertext [in]
- *          The 16-octet data block to decrypt.
+ *          The data to decrypt, which must be an integral number of 16-octet
+ *          blocks.
  *
  *      plaintext [out]
- *          The 16-octet decrypted data block.  AES operates in place, so this
- *          span may be the same memory location as the ciphertext span.
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
  *
  *  Returns:
  *      Nothing, though the decrypted data is stored in the plaintext
@@ -578,125 +733,231 @@ void AESUniversal::Encrypt(
  *              3a. InverseSubBytes
  *              3b. InverseShiftRows
  *              3c. AddRoundKey
+ *
+ *      See the comments for EncryptRounds().
  */
-void AESUniversal::Decrypt(
-                const std::span<const std::uint8_t, AES_Block_Size> ciphertext,
-                std::span<std::uint8_t, AES_Block_Size> plaintext) noexcept
+template<std::size_t Rounds>
+void AESUniversal::DecryptRounds(
+                const std::span<const std::uint8_t> ciphertext,
+                std::span<std::uint8_t> plaintext) const noexcept
 {
-    // Step 1 - AddRoundKey() (i.e., XOR with DW[0])
-    state[0] = AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(ciphertext, 0),
-                           DW[0]);
-    state[1] = AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(ciphertext, 1),
-                           DW[1]);
-    state[2] = AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(ciphertext, 2),
-                           DW[2]);
-    state[3] = AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(ciphertext, 3),
-                           DW[3]);
-
-    // Round 1
-    alt_state[0] = AddRoundKey(InvMixColShiftRow(0, state), DW[4]);
-    alt_state[1] = AddRoundKey(InvMixColShiftRow(1, state), DW[5]);
-    alt_state[2] = AddRoundKey(InvMixColShiftRow(2, state), DW[6]);
-    alt_state[3] = AddRoundKey(InvMixColShiftRow(3, state), DW[7]);
-
-    // Round 2
-    state[0] = AddRoundKey(InvMixColShiftRow(0, alt_state), DW[8]);
-    state[1] = AddRoundKey(InvMixColShiftRow(1, alt_state), DW[9]);
-    state[2] = AddRoundKey(InvMixColShiftRow(2, alt_state), DW[10]);
-    state[3] = AddRoundKey(InvMixColShiftRow(3, alt_state), DW[11]);
-
-    // Round 3
-    alt_state[0] = AddRoundKey(InvMixColShiftRow(0, state), DW[12]);
-    alt_state[1] = AddRoundKey(InvMixColShiftRow(1, state), DW[13]);
-    alt_state[2] = AddRoundKey(InvMixColShiftRow(2, state), DW[14]);
-    alt_state[3] = AddRoundKey(InvMixColShiftRow(3, state), DW[15]);
-
-    // Round 4
-    state[0] = AddRoundKey(InvMixColShiftRow(0, alt_state), DW[16]);
-    state[1] = AddRoundKey(InvMixColShiftRow(1, alt_state), DW[17]);
-    state[2] = AddRoundKey(InvMixColShiftRow(2, alt_state), DW[18]);
-    state[3] = AddRoundKey(InvMixColShiftRow(3, alt_state), DW[19]);
-
-    // Round 5
-    alt_state[0] = AddRoundKey(InvMixColShiftRow(0, state), DW[20]);
-    alt_state[1] = AddRoundKey(InvMixColShiftRow(1, state), DW[21]);
-    alt_state[2] = AddRoundKey(InvMixColShiftRow(2, state), DW[22]);
-    alt_state[3] = AddRoundKey(InvMixColShiftRow(3, state), DW[23]);
-
-    // Round 6
-    state[0] = AddRoundKey(InvMixColShiftRow(0, alt_state), DW[24]);
-    state[1] = AddRoundKey(InvMixColShiftRow(1, alt_state), DW[25]);
-    state[2] = AddRoundKey(InvMixColShiftRow(2, alt_state), DW[26]);
-    state[3] = AddRoundKey(InvMixColShiftRow(3, alt_state), DW[27]);
-
-    // Round 7
-    alt_state[0] = AddRoundKey(InvMixColShiftRow(0, state), DW[28]);
-    alt_state[1] = AddRoundKey(InvMixColShiftRow(1, state), DW[29]);
-    alt_state[2] = AddRoundKey(InvMixColShiftRow(2, state), DW[30]);
-    alt_state[3] = AddRoundKey(InvMixColShiftRow(3, state), DW[31]);
-
-    // Round 8
-    state[0] = AddRoundKey(InvMixColShiftRow(0, alt_state), DW[32]);
-    state[1] = AddRoundKey(InvMixColShiftRow(1, alt_state), DW[33]);
-    state[2] = AddRoundKey(InvMixColShiftRow(2, alt_state), DW[34]);
-    state[3] = AddRoundKey(InvMixColShiftRow(3, alt_state), DW[35]);
-
-    // Round 9
-    alt_state[0] = AddRoundKey(InvMixColShiftRow(0, state), DW[36]);
-    alt_state[1] = AddRoundKey(InvMixColShiftRow(1, state), DW[37]);
-    alt_state[2] = AddRoundKey(InvMixColShiftRow(2, state), DW[38]);
-    alt_state[3] = AddRoundKey(InvMixColShiftRow(3, state), DW[39]);
-
-    if (Nr > 10)
+    // State array of four columns and the alternating state array used
+    // between rounds (on the stack so the key schedule is never modified)
+    SecUtil::SecureArray<std::uint_fast32_t, Nb> state;
+    SecUtil::SecureArray<std::uint_fast32_t, Nb> alt_state;
+
+    for (std::size_t offset = 0; offset < ciphertext.size();
+         offset += AES_Block_Size)
     {
-        // Round 10
-        state[0] = AddRoundKey(InvMixColShiftRow(0, alt_state), DW[40]);
-        state[1] = AddRoundKey(InvMixColShiftRow(1, alt_state), DW[41]);
-        state[2] = AddRoundKey(InvMixColShiftRow(2, alt_state), DW[42]);
-        state[3] = AddRoundKey(InvMixColShiftRow(3, alt_state), DW[43]);
-
-        // Round 11
-        alt_state[0] = AddRoundKey(InvMixColShiftRow(0, state), DW[44]);
-        alt_state[1] = AddRoundKey(InvMixColShiftRow(1, state), DW[45]);
-        alt_state[2] = AddRoundKey(InvMixColShiftRow(2, state), DW[46]);
-        alt_state[3] = AddRoundKey(InvMixColShiftRow(3, state), DW[47]);
-
-        if (Nr > 12)
+        const auto input = ciphertext.subspan(offset).first<AES_Block_Size>();
+        auto output = plaintext.subspan(offset).first<AES_Block_Size>();
+
+        // Step 1 - AddRoundKey() (i.e., XOR with DW[0])
+        state[0] = AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(input, 0),
+                               DW[0]);
+        state[1] = AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(input, 1),
+                               DW[1]);
+        state[2] = AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(input, 2),
+                               DW[2]);
+        state[3] = AddRoundKey(GetWordFromBuffer<std::uint_fast32_t>(input, 3),
+                               DW[3]);
+
+        // Step 2 - Rounds 1 to Nr - 1, with odd rounds reading from the state
+        // array and even rounds reading from the alternating state array
+        ForEachRound<Rounds>([&](auto round)
         {
-            // Round 12
-            state[0] = AddRoundKey(InvMixColShiftRow(0, alt_state), DW[48]);
-            state[1] = AddRoundKey(InvMixColShiftRow(1, alt_state), DW[49]);
-            state[2] = AddRoundKey(InvMixColShiftRow(2, alt_state), DW[50]);
-            state[3] = AddRoundKey(InvMixColShiftRow(3, alt_state), DW[51]);
-
-            // Round 13
-            alt_state[0] = AddRoundKey(InvMixColShiftRow(0, state), DW[52]);
-            alt_state[1] = AddRoundKey(InvMixColShiftRow(1, state), DW[53]);
-            alt_state[2] = AddRoundKey(InvMixColShiftRow(2, state), DW[54]);
-            alt_state[3] = AddRoundKey(InvMixColShiftRow(3, state), DW[55]);
-        }
+            auto &in = (round % 2) ? state : alt_state;
+            auto &out = (round % 2) ? alt_state : state;
+
+            out[0] =
+                AddRoundKey(InvMixColShiftRow(0, in), DW[(round << 2) + 0]);
+            out[1] =
+                AddRoundKey(InvMixColShiftRow(1, in), DW[(round << 2) + 1]);
+            out[2] =
+                AddRoundKey(InvMixColShiftRow(2, in), DW[(round << 2) + 2]);
+            out[3] =
+                AddRoundKey(InvMixColShiftRow(3, in), DW[(round << 2) + 3]);
+        });
+
+        // Step 3 - Final round, then move result into plaintext buffer
+        //     While this is a bit verbose, there is no need to store these
+        //     results back into the state array, as the result can be placed
+        //     directly into the plaintext buffer
+        PutStateColumn(AddRoundKey(InvSubBytesShiftRows(0, alt_state),
+                                   DW[(Rounds << 2) + 0]),
+                       0,
+                       output);
+        PutStateColumn(AddRoundKey(InvSubBytesShiftRows(1, alt_state),
+                                   DW[(Rounds << 2) + 1]),
+                       1,
+                       output);
+        PutStateColumn(AddRoundKey(InvSubBytesShiftRows(2, alt_state),
+                                   DW[(Rounds << 2) + 2]),
+                       2,
+                       output);
+        PutStateColumn(AddRoundKey(InvSubBytesShiftRows(3, alt_state),
+                                   DW[(Rounds << 2) + 3]),
+                       3,
+                       output);
     }
+}
 
-    // Step 3 - Final round, then move result into plaintext buffer
-    //     While this is a bit verbose, there is no need to store these results
-    //     back into the state array, as the result can be placed directly
-    //     into the plaintext buffer
-    PutStateColumn(
-        AddRoundKey(InvSubBytesShiftRows(0, alt_state), DW[(Nr << 2) + 0]),
-        0,
-        plaintext);
-    PutStateColumn(
-        AddRoundKey(InvSubBytesShiftRows(1, alt_state), DW[(Nr << 2) + 1]),
-        1,
-        plaintext);
-    PutStateColumn(
-        AddRoundKey(InvSubBytesShiftRows(2, alt_state), DW[(Nr << 2) + 2]),
-        2,
-        plaintext);
-    PutStateColumn(
-        AddRoundKey(InvSubBytesShiftRows(3, alt_state), DW[(Nr << 2) + 3]),
-        3,
-        plaintext);
+/*
+ * AESUniversal::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt a block of plaintext and return the
+ *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The 16-octet data block to encrypt.
+ *
+ *      ciphertext [out]
+ *          The 16-octet encrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the plaintext span.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESUniversal::Encrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> plaintext,
+            std::span<std::uint8_t, AES_Block_Size> ciphertext) const noexcept
+{
+    AESUniversal::EncryptBlocks(plaintext, ciphertext);
+}
+
+/*
+ * AESUniversal::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt a block of ciphertext and return the
+ *      plaintext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The 16-octet data block to decrypt.
+ *
+ *      plaintext [out]
+ *          The 16-octet decrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the ciphertext span.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESUniversal::Decrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> ciphertext,
+            std::span<std::uint8_t, AES_Block_Size> plaintext) const noexcept
+{
+    AESUniversal::DecryptBlocks(ciphertext, plaintext);
+}
+
+/*
+ * AESUniversal::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a series of plaintext blocks and return the
+ *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The data to encrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      The table-driven rounds do not benefit from interleaving blocks, so
+ *      the blocks are processed one after another.  The number of rounds is
+ *      checked once here, rather than for every block, to select the
+ *      specialization of EncryptRounds() for the key size.
+ *
+ *      If TERRA_ENABLE_AES_TABLE_PREFETCH is defined, the tables are
+ *      prefetched before the blocks are encrypted.
+ */
+void AESUniversal::EncryptBlocks(
+                const std::span<const std::uint8_t> plaintext,
+                std::span<std::uint8_t> ciphertext) const noexcept
+{
+#ifdef TERRA_ENABLE_AES_TABLE_PREFETCH
+    PrefetchEncryptTables();
+#endif
+
+    switch (Nr)
+    {
+        case 10:
+            EncryptRounds<10>(plaintext, ciphertext);
+            break;
+
+        case 12:
+            EncryptRounds<12>(plaintext, ciphertext);
+            break;
+
+        default:
+            EncryptRounds<14>(plaintext, ciphertext);
+            break;
+    }
+}
+
+/*
+ * AESUniversal::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a series of ciphertext blocks and return the
+ *      plaintext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The data to decrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      See the comments for EncryptBlocks().
+ */
+void AESUniversal::DecryptBlocks(
+                const std::span<const std::uint8_t> ciphertext,
+                std::span<std::uint8_t> plaintext) const noexcept
+{
+#ifdef TERRA_ENABLE_AES_TABLE_PREFETCH
+    PrefetchDecryptTables();
+#endif
+
+    switch (Nr)
+    {
+        case 10:
+            DecryptRounds<10>(ciphertext, plaintext);
+            break;
+
+        case 12:
+            DecryptRounds<12>(ciphertext, plaintext);
+            break;
+
+        default:
+            DecryptRounds<14>(ciphertext, plaintext);
+            break;
+    }
 }
 
 /*
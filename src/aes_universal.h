@@ -51,6 +51,9 @@ class AESUniversal : public AESEngine
         static constexpr std::size_t Max_Rounds{14};
 
     public:
+        // Number of keys expanded together by SetKeys()
+        static constexpr std::size_t Key_Expansion_Lanes{4};
+
         AESUniversal() noexcept;
         AESUniversal(const std::span<const std::uint8_t> key);
         AESUniversal(const AESUniversal &other) noexcept;
@@ -65,32 +68,55 @@ class AESUniversal : public AESEngine
             return AESEngineType::Universal;
         }
 
-        void SetKey(const std::span<const std::uint8_t> key) override;
+        void SetKey(
+            const std::span<const std::uint8_t> key,
+            AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt) override;
+
+        static void SetKeys(
+            const std::span<AESUniversal * const> engines,
+            const std::span<const std::span<const std::uint8_t>> keys,
+            AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt);
 
         void ClearKeyState() override;
 
         void Encrypt(
             const std::span<const std::uint8_t, AES_Block_Size> plaintext,
-            std::span<std::uint8_t, AES_Block_Size> ciphertext) noexcept
+            std::span<std::uint8_t, AES_Block_Size> ciphertext) const noexcept
             override;
 
         void Decrypt(
             const std::span<const std::uint8_t, AES_Block_Size> ciphertext,
-            std::span<std::uint8_t, AES_Block_Size> plaintext) noexcept
+            std::span<std::uint8_t, AES_Block_Size> plaintext) const noexcept
+            override;
+
+        void EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const noexcept
+            override;
+
+        void DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const noexcept
             override;
 
         bool operator==(const AESUniversal &other) const;
         bool operator!=(const AESUniversal &other) const;
 
     protected:
-        std::size_t Nr;                         // Number of encryption rounds
-        std::size_t Nk;                         // 32-bit words in cipher key
+        void SetDecryptionKeys() noexcept;
+
+        static void ExpandKeys(
+            AESUniversal * const *engines,
+            const std::span<const std::uint8_t> *keys) noexcept;
 
-        // State array of four columns
-        SecUtil::SecureArray<std::uint_fast32_t, Nb> state;
+        template<std::size_t Rounds>
+        void EncryptRounds(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const noexcept;
 
-        // Alternating state array (temporary use during encryption/decryption)
-        SecUtil::SecureArray<std::uint_fast32_t, Nb> alt_state;
+        template<std::size_t Rounds>
+        void DecryptRounds(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const noexcept;
+
+        std::size_t Nr;                         // Number of encryption rounds
+        std::size_t Nk;                         // 32-bit words in cipher key
 
         // Encryption round key schedule array
         SecUtil::SecureArray<std::uint_fast32_t, Nb * (Max_Rounds + 1)> W;
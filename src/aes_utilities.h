@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <array>
 #include <span>
+#include <utility>
 #include <terra/bitutil/bit_rotation.h>
 #include "aes_tables.h"
 
@@ -245,6 +246,36 @@ constexpr T AddRoundKey(const T x, const T y)
     return x ^ y;
 }
 
+/*
+ *  RotateTableEntry
+ *
+ *  Description:
+ *      This function will right rotate an entry from the constants table
+ *      Enc0 or Dec0 by the given number of rows (8 bits per row) to produce
+ *      the corresponding entry from table Enc1..Enc3 or Dec1..Dec3.
+ *
+ *  Parameters:
+ *      entry [in]
+ *          The 32-bit entry from the table Enc0 or Dec0.
+ *
+ *      rows [in]
+ *          The number of rows to rotate, which must be 1, 2, or 3.
+ *
+ *  Returns:
+ *      The entry rotated right by the given number of rows.
+ *
+ *  Comments:
+ *      This is used only when building with compact tables.
+ */
+template<Unsigned32OrLarger T>
+constexpr T RotateTableEntry(const T entry, const unsigned rows)
+{
+    return Terra::BitUtil::RotateLeft(entry,
+                                      32 - (rows * 8),
+                                      32,
+                                      T(0xffff'ffff));
+}
+
 /*
  *  MixColShiftRow
  *
@@ -265,16 +296,26 @@ constexpr T AddRoundKey(const T x, const T y)
  *      MixColumns() operations.
  *
  *  Comments:
- *      The constants added to column performs the row shifts.
+ *      The constants added to column performs the row shifts.  When built
+ *      with compact tables, Enc1..Enc3 are produced by rotating entries of
+ *      Enc0.
  */
 template<Unsigned32OrLarger T>
 constexpr T MixColShiftRow(const std::size_t column,
                            const std::array<T, 4> &state)
 {
+#ifdef TERRA_ENABLE_AES_COMPACT_TABLES
+    return static_cast<T>(
+        Enc0[(state[(0 + column) % 4] >> 24) & 0xff] ^
+        RotateTableEntry(Enc0[(state[(1 + column) % 4] >> 16) & 0xff], 1) ^
+        RotateTableEntry(Enc0[(state[(2 + column) % 4] >>  8) & 0xff], 2) ^
+        RotateTableEntry(Enc0[(state[(3 + column) % 4]      ) & 0xff], 3));
+#else
     return static_cast<T>(Enc0[(state[(0 + column) % 4] >> 24) & 0xff] ^
                           Enc1[(state[(1 + column) % 4] >> 16) & 0xff] ^
                           Enc2[(state[(2 + column) % 4] >>  8) & 0xff] ^
                           Enc3[(state[(3 + column) % 4]      ) & 0xff]);
+#endif
 }
 
 /*
@@ -311,10 +352,18 @@ constexpr T MixColShiftRow(const std::size_t column,
 template<Unsigned32OrLarger T>
 constexpr T FastInvMixColumn(const T value)
 {
+#ifdef TERRA_ENABLE_AES_COMPACT_TABLES
+    return static_cast<T>(
+        Dec0[Sbox[(value >> 24) & 0xff]] ^
+        RotateTableEntry(Dec0[Sbox[(value >> 16) & 0xff]], 1) ^
+        RotateTableEntry(Dec0[Sbox[(value >>  8) & 0xff]], 2) ^
+        RotateTableEntry(Dec0[Sbox[(value      ) & 0xff]], 3));
+#else
     return static_cast<T>(Dec0[static_cast<T>(Sbox[(value >> 24) & 0xff])] ^
                           Dec1[static_cast<T>(Sbox[(value >> 16) & 0xff])] ^
                           Dec2[static_cast<T>(Sbox[(value >>  8) & 0xff])] ^
                           Dec3[static_cast<T>(Sbox[(value      ) & 0xff])]);
+#endif
 }
 
 /*
@@ -337,16 +386,179 @@ constexpr T FastInvMixColumn(const T value)
  *      InvMixColumns() operations.
  *
  *  Comments:
- *      The constants added to column performs the row shifts.
+ *      The constants added to column performs the row shifts.  When built
+ *      with compact tables, Dec1..Dec3 are produced by rotating entries of
+ *      Dec0.
  */
 template<Unsigned32OrLarger T>
 constexpr T InvMixColShiftRow(const std::size_t column,
                               const std::array<T, 4> &state)
 {
+#ifdef TERRA_ENABLE_AES_COMPACT_TABLES
+    return static_cast<T>(
+        Dec0[(state[(0 + column) % 4] >> 24) & 0xff] ^
+        RotateTableEntry(Dec0[(state[(3 + column) % 4] >> 16) & 0xff], 1) ^
+        RotateTableEntry(Dec0[(state[(2 + column) % 4] >>  8) & 0xff], 2) ^
+        RotateTableEntry(Dec0[(state[(1 + column) % 4]      ) & 0xff], 3));
+#else
     return static_cast<T>(Dec0[(state[(0 + column) % 4] >> 24) & 0xff] ^
                           Dec1[(state[(3 + column) % 4] >> 16) & 0xff] ^
                           Dec2[(state[(2 + column) % 4] >>  8) & 0xff] ^
                           Dec3[(state[(1 + column) % 4]      ) & 0xff]);
+#endif
+}
+
+/*
+ *  PrefetchTable
+ *
+ *  Description:
+ *      This function will request that each cache line of the given table
+ *      be loaded into the processor cache.
+ *
+ *  Parameters:
+ *      table [in]
+ *          The table to load into the cache, which must be aligned on a
+ *          64-octet boundary.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This is used only when TERRA_ENABLE_AES_TABLE_PREFETCH is defined.
+ *      Where the compiler does not provide a prefetch intrinsic, one octet
+ *      from each cache line is read instead.
+ */
+template<typename T, std::size_t N>
+inline void PrefetchTable(const std::array<T, N> &table)
+{
+    const auto *octets = reinterpret_cast<const std::uint8_t *>(table.data());
+
+    for (std::size_t i = 0; i < sizeof(T) * N; i += 64)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(octets + i);
+#else
+        const volatile std::uint8_t *line = octets + i;
+        static_cast<void>(*line);
+#endif
+    }
+}
+
+/*
+ *  PrefetchEncryptTables
+ *
+ *  Description:
+ *      This function will request that the tables used to encrypt be loaded
+ *      into the processor cache.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This is called before encrypting each series of blocks, so that the
+ *      tables evicted by other data since the previous call are reloaded
+ *      together rather than one cache miss at a time.
+ */
+inline void PrefetchEncryptTables()
+{
+    PrefetchTable(Sbox);
+    PrefetchTable(Enc0);
+#ifndef TERRA_ENABLE_AES_COMPACT_TABLES
+    PrefetchTable(Enc1);
+    PrefetchTable(Enc2);
+    PrefetchTable(Enc3);
+#endif
+}
+
+/*
+ *  PrefetchDecryptTables
+ *
+ *  Description:
+ *      This function will request that the tables used to decrypt be loaded
+ *      into the processor cache.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      See the comments for PrefetchEncryptTables().
+ */
+inline void PrefetchDecryptTables()
+{
+    PrefetchTable(InverseSbox);
+    PrefetchTable(Dec0);
+#ifndef TERRA_ENABLE_AES_COMPACT_TABLES
+    PrefetchTable(Dec1);
+    PrefetchTable(Dec2);
+    PrefetchTable(Dec3);
+#endif
+}
+
+/*
+ *  ForEachRound
+ *
+ *  Description:
+ *      This function will call the given function once for each of the
+ *      rounds 1 to Rounds - 1, passing the round number as a constant.
+ *      It is used to produce fully unrolled rounds for a key size known
+ *      at compile time.
+ *
+ *  Parameters:
+ *      function [in]
+ *          The function to call, which accepts a std::integral_constant
+ *          holding the round number.  Since the round number is a
+ *          constant, it may be used to index the round keys or as a template
+ *          argument.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The calls are expanded from a parameter pack, so there is no loop
+ *      for the compiler to unroll and no branch on the number of rounds.
+ */
+template<std::size_t Rounds, typename F>
+constexpr void ForEachRound(F &&function)
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        (function(std::integral_constant<std::size_t, I + 1>{}), ...);
+    }(std::make_index_sequence<Rounds - 1>{});
+}
+
+/*
+ *  ForEachLane
+ *
+ *  Description:
+ *      This function will call the given function once for each of the
+ *      lanes 0 to Lanes - 1, passing the lane number as a constant.  It is
+ *      used to interleave operations on several independent blocks or keys.
+ *
+ *  Parameters:
+ *      function [in]
+ *          The function to call, which accepts a std::integral_constant
+ *          holding the lane number.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      As with ForEachRound(), the calls are expanded from a parameter pack
+ *      so that arrays indexed by the lane number may be held in registers.
+ */
+template<std::size_t Lanes, typename F>
+constexpr void ForEachLane(F &&function)
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        (function(std::integral_constant<std::size_t, I>{}), ...);
+    }(std::make_index_sequence<Lanes>{});
 }
 
 } // namespace
@@ -0,0 +1,1324 @@
+/*
+ *  aes_vector_permute.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the AESVectorPermute object which performs
+ *      encryption and decryption as specified in FIPS 197 ("Advanced
+ *      Encryption Standard") using vector permute instructions.
+ *
+ *      This follows the approach of Mike Hamburg's "Accelerating AES with
+ *      Vector Permute Instructions" (CHES 2009), which is also the basis of
+ *      the "vpaes" code in OpenSSL.  Each octet of the state is represented
+ *      in a basis where GF(2^8) is viewed as an extension of GF(2^4), so
+ *      the multiplicative inverse can be computed from its two 4-bit halves
+ *      using 16-entry tables.  A 16-entry table lookup for all sixteen
+ *      octets is one permute instruction (pshufb or tbl) with the table held
+ *      in a register, so the memory accessed does not depend on the key or
+ *      data.  Further 16-entry tables combine the affine transformation of
+ *      the S-box with the multiplications of MixColumns (or, for decryption,
+ *      InvMixColumns), and ShiftRows is a permute of the entire state.
+ *
+ *      The round keys are transformed into the same basis during key
+ *      expansion, including the effects of the constant 0x63 that is not
+ *      applied by the S-box tables.
+ *
+ *  Portability Issues:
+ *      SSSE3 is required on Intel processors, which is checked at runtime.
+ */
+
+#include "intel_intrinsics.h"
+#include "arm_intrinsics.h"
+
+// Do not attempt to compile unless told to use Intel or ARM intrinsics
+#if defined(TERRA_USE_INTEL_INTRINSICS) || defined(TERRA_USE_ARM_INTRINSICS)
+
+#include <array>
+#include <cstring>
+#include <terra/secutil/secure_erase.h>
+#include "aes_vector_permute.h"
+#include "aes_tables.h"
+
+// Enable the SSSE3 instructions for specific functions
+#if defined(TERRA_USE_INTEL_INTRINSICS) && \
+    !(defined(_MSC_VER) && !defined(__clang__))
+#define TERRA_SSSE3_TARGET __attribute__((target("ssse3")))
+#else
+#define TERRA_SSSE3_TARGET
+#endif
+
+namespace Terra::Crypto::Cipher
+{
+
+namespace
+{
+
+// Inverse in GF(2^4), where 0x80 (for zero) causes later lookups to yield 0
+constexpr std::uint8_t Inverse[16] =
+{
+    0x80, 0x01, 0x08, 0x0d, 0x0f, 0x06, 0x05, 0x0e,
+    0x02, 0x0c, 0x0b, 0x0a, 0x09, 0x03, 0x07, 0x04
+};
+
+// Inverse-related table used with the low nibble when inverting in GF(2^8)
+constexpr std::uint8_t Inverse_A[16] =
+{
+    0x80, 0x07, 0x0b, 0x0f, 0x06, 0x0a, 0x04, 0x01,
+    0x09, 0x08, 0x05, 0x02, 0x0c, 0x0e, 0x0d, 0x03
+};
+
+// Transformation of the input for encryption (low and high nibbles)
+constexpr std::uint8_t Encrypt_Input_Low[16] =
+{
+    0x00, 0x70, 0x2a, 0x5a, 0x98, 0xe8, 0xb2, 0xc2,
+    0x08, 0x78, 0x22, 0x52, 0x90, 0xe0, 0xba, 0xca
+};
+constexpr std::uint8_t Encrypt_Input_High[16] =
+{
+    0x00, 0x4d, 0x7c, 0x31, 0x7d, 0x30, 0x01, 0x4c,
+    0x81, 0xcc, 0xfd, 0xb0, 0xfc, 0xb1, 0x80, 0xcd
+};
+
+// S-box output in the internal basis (multiplied by 1 and by 2)
+constexpr std::uint8_t SBox1_U[16] =
+{
+    0x00, 0x3e, 0x50, 0xcb, 0x8f, 0xe1, 0x9b, 0xb1,
+    0x44, 0xf5, 0x2a, 0x14, 0x6e, 0x7a, 0xdf, 0xa5
+};
+constexpr std::uint8_t SBox1_T[16] =
+{
+    0x00, 0x23, 0xe2, 0xfa, 0x15, 0xd4, 0x18, 0x36,
+    0xef, 0xd9, 0x2e, 0x0d, 0xc1, 0xcc, 0xf7, 0x3b
+};
+constexpr std::uint8_t SBox2_U[16] =
+{
+    0x00, 0x24, 0x71, 0x0b, 0xc6, 0x93, 0x7a, 0xe2,
+    0xcd, 0x2f, 0x98, 0xbc, 0x55, 0xe9, 0xb7, 0x5e
+};
+constexpr std::uint8_t SBox2_T[16] =
+{
+    0x00, 0x29, 0xe1, 0x0a, 0x40, 0x88, 0xeb, 0x69,
+    0x4a, 0x23, 0x82, 0xab, 0xc8, 0x63, 0xa1, 0xc2
+};
+
+// S-box output in the standard basis, for the final round
+constexpr std::uint8_t SBox_Output_U[16] =
+{
+    0x00, 0xc7, 0xbd, 0x6f, 0x17, 0x6d, 0xd2, 0xd0,
+    0x78, 0xa8, 0x02, 0xc5, 0x7a, 0xbf, 0xaa, 0x15
+};
+constexpr std::uint8_t SBox_Output_T[16] =
+{
+    0x00, 0x6a, 0xbb, 0x5f, 0xa5, 0x74, 0xe4, 0xcf,
+    0xfa, 0x35, 0x2b, 0x41, 0xd1, 0x90, 0x1e, 0x8e
+};
+
+// Transformation of the input for decryption (low and high nibbles)
+constexpr std::uint8_t Decrypt_Input_Low[16] =
+{
+    0x00, 0x5f, 0x54, 0x0b, 0x04, 0x5b, 0x50, 0x0f,
+    0x1a, 0x45, 0x4e, 0x11, 0x1e, 0x41, 0x4a, 0x15
+};
+constexpr std::uint8_t Decrypt_Input_High[16] =
+{
+    0x00, 0x65, 0x05, 0x60, 0xe6, 0x83, 0xe3, 0x86,
+    0x94, 0xf1, 0x91, 0xf4, 0x72, 0x17, 0x77, 0x12
+};
+
+// Inverse S-box output in the internal basis, multiplied by 9, 13, 11, 14
+constexpr std::uint8_t InvSBox9_U[16] =
+{
+    0x00, 0xd6, 0x86, 0x9a, 0x53, 0x03, 0x1c, 0x85,
+    0xc9, 0x4c, 0x99, 0x4f, 0x50, 0x1f, 0xd5, 0xca
+};
+constexpr std::uint8_t InvSBox9_T[16] =
+{
+    0x00, 0x49, 0xd7, 0xec, 0x89, 0x17, 0x3b, 0xc0,
+    0x65, 0xa5, 0xfb, 0xb2, 0x9e, 0x2c, 0x5e, 0x72
+};
+constexpr std::uint8_t InvSBoxD_U[16] =
+{
+    0x00, 0xa2, 0xb1, 0xe6, 0xdf, 0xcc, 0x57, 0x7d,
+    0x39, 0x44, 0x2a, 0x88, 0x13, 0x9b, 0x6e, 0xf5
+};
+constexpr std::uint8_t InvSBoxD_T[16] =
+{
+    0x00, 0xcb, 0xc6, 0x24, 0xf7, 0xfa, 0xe2, 0x3c,
+    0xd3, 0xef, 0xde, 0x15, 0x0d, 0x18, 0x31, 0x29
+};
+constexpr std::uint8_t InvSBoxB_U[16] =
+{
+    0x00, 0x42, 0xb4, 0x96, 0x92, 0x64, 0x22, 0xd0,
+    0x04, 0xd4, 0xf2, 0xb0, 0xf6, 0x46, 0x26, 0x60
+};
+constexpr std::uint8_t InvSBoxB_T[16] =
+{
+    0x00, 0x67, 0x59, 0xcd, 0xa6, 0x98, 0x94, 0xc1,
+    0x6b, 0xaa, 0x55, 0x32, 0x3e, 0x0c, 0xff, 0xf3
+};
+constexpr std::uint8_t InvSBoxE_U[16] =
+{
+    0x00, 0xd0, 0xd4, 0x26, 0x96, 0x92, 0xf2, 0x46,
+    0xb0, 0xf6, 0xb4, 0x64, 0x04, 0x60, 0x42, 0x22
+};
+constexpr std::uint8_t InvSBoxE_T[16] =
+{
+    0x00, 0xc1, 0xaa, 0xff, 0xcd, 0xa6, 0x55, 0x0c,
+    0x32, 0x3e, 0x59, 0x98, 0x6b, 0xf3, 0x67, 0x94
+};
+
+// Inverse S-box output in the standard basis, for the final round
+constexpr std::uint8_t InvSBox_Output_U[16] =
+{
+    0x00, 0x40, 0xf9, 0x7e, 0x53, 0xea, 0x87, 0x13,
+    0x2d, 0x3e, 0x94, 0xd4, 0xb9, 0x6d, 0xaa, 0xc7
+};
+constexpr std::uint8_t InvSBox_Output_T[16] =
+{
+    0x00, 0x1d, 0x44, 0x93, 0x0f, 0x56, 0xd7, 0x12,
+    0x9c, 0x8e, 0xc5, 0xd8, 0x59, 0x81, 0x4b, 0xca
+};
+
+// A permutation of the sixteen octets of the state, where octet i of the
+// result is octet mask[i] of the input
+using Mask = std::array<std::uint8_t, 16>;
+
+// Move each octet to the row above within its column (i.e., row r + 1)
+constexpr Mask Rotate_Forward =
+{
+    0x01, 0x02, 0x03, 0x00, 0x05, 0x06, 0x07, 0x04,
+    0x09, 0x0a, 0x0b, 0x08, 0x0d, 0x0e, 0x0f, 0x0c
+};
+
+// Move each octet to the row below within its column (i.e., row r - 1)
+constexpr Mask Rotate_Backward =
+{
+    0x03, 0x00, 0x01, 0x02, 0x07, 0x04, 0x05, 0x06,
+    0x0b, 0x08, 0x09, 0x0a, 0x0f, 0x0c, 0x0d, 0x0e
+};
+
+// ShiftRows() as a permutation of the state
+constexpr Mask Shift_Rows =
+{
+    0x00, 0x05, 0x0a, 0x0f, 0x04, 0x09, 0x0e, 0x03,
+    0x08, 0x0d, 0x02, 0x07, 0x0c, 0x01, 0x06, 0x0b
+};
+
+// InvShiftRows() as a permutation of the state
+constexpr Mask Inv_Shift_Rows =
+{
+    0x00, 0x0d, 0x0a, 0x07, 0x04, 0x01, 0x0e, 0x0b,
+    0x08, 0x05, 0x02, 0x0f, 0x0c, 0x09, 0x06, 0x03
+};
+
+/*
+ *  Compose()
+ *
+ *  Description:
+ *      Produce the mask that has the effect of permuting with the mask
+ *      "first" and then with the mask "second".
+ *
+ *  Parameters:
+ *      first [in]
+ *          The first permutation to apply.
+ *
+ *      second [in]
+ *          The second permutation to apply.
+ *
+ *  Returns:
+ *      The composed permutation.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr Mask Compose(const Mask &first, const Mask &second) noexcept
+{
+    Mask result{};
+
+    for (std::size_t i = 0; i < result.size(); i++)
+    {
+        result[i] = first[second[i]];
+    }
+
+    return result;
+}
+
+/*
+ *  Layouts()
+ *
+ *  Description:
+ *      Rather than permuting the state with ShiftRows() (or InvShiftRows())
+ *      in each round, the octets are left in place and the position of each
+ *      octet of the logical state is tracked.  Since ShiftRows() repeats
+ *      after four rounds, there are only four layouts.  Octet i of the
+ *      state as held in a register after r rounds is octet layout[r % 4][i]
+ *      of the logical state.
+ *
+ *  Parameters:
+ *      inverse_shift [in]
+ *          The inverse of the row shifting applied in each round.
+ *
+ *  Returns:
+ *      The four layouts of the state.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr std::array<Mask, 4> Layouts(const Mask &inverse_shift) noexcept
+{
+    std::array<Mask, 4> layouts{};
+
+    for (std::size_t i = 0; i < 16; i++)
+    {
+        layouts[0][i] = static_cast<std::uint8_t>(i);
+    }
+
+    for (std::size_t r = 1; r < layouts.size(); r++)
+    {
+        layouts[r] = Compose(layouts[r - 1], inverse_shift);
+    }
+
+    return layouts;
+}
+
+/*
+ *  Rotations()
+ *
+ *  Description:
+ *      Produce the masks that perform a given rotation within the columns
+ *      of the logical state when the state is held in each of the layouts.
+ *
+ *  Parameters:
+ *      rotation [in]
+ *          The rotation to perform on the logical state.
+ *
+ *      layouts [in]
+ *          The layouts of the state.
+ *
+ *      inverse_layouts [in]
+ *          The inverses of the layouts of the state.
+ *
+ *  Returns:
+ *      The rotation masks to use for each layout.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr std::array<Mask, 4> Rotations(
+                        const Mask &rotation,
+                        const std::array<Mask, 4> &layouts,
+                        const std::array<Mask, 4> &inverse_layouts) noexcept
+{
+    std::array<Mask, 4> rotations{};
+
+    for (std::size_t r = 0; r < rotations.size(); r++)
+    {
+        rotations[r] =
+            Compose(Compose(inverse_layouts[r], rotation), layouts[r]);
+    }
+
+    return rotations;
+}
+
+// Layouts of the state during encryption and decryption; since the two
+// shifts are inverses, each set of layouts is the inverse of the other
+constexpr std::array<Mask, 4> Encrypt_Layouts = Layouts(Inv_Shift_Rows);
+constexpr std::array<Mask, 4> Decrypt_Layouts = Layouts(Shift_Rows);
+
+// Rotations within columns for each layout of the state
+constexpr std::array<Mask, 4> Encrypt_Forward =
+    Rotations(Rotate_Forward, Encrypt_Layouts, Decrypt_Layouts);
+constexpr std::array<Mask, 4> Encrypt_Backward =
+    Rotations(Rotate_Backward, Encrypt_Layouts, Decrypt_Layouts);
+constexpr std::array<Mask, 4> Decrypt_Forward =
+    Rotations(Rotate_Forward, Decrypt_Layouts, Encrypt_Layouts);
+
+#ifdef TERRA_USE_INTEL_INTRINSICS
+
+using Vector = __m128i;
+
+TERRA_SSSE3_TARGET inline Vector Load(const std::uint8_t *p) noexcept
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+TERRA_SSSE3_TARGET inline void Store(std::uint8_t *p, const Vector x) noexcept
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), x);
+}
+
+TERRA_SSSE3_TARGET inline Vector Broadcast(const std::uint8_t x) noexcept
+{
+    return _mm_set1_epi8(static_cast<char>(x));
+}
+
+TERRA_SSSE3_TARGET inline Vector Xor(const Vector a, const Vector b) noexcept
+{
+    return _mm_xor_si128(a, b);
+}
+
+TERRA_SSSE3_TARGET inline Vector Permute(const Vector table,
+                                         const Vector index) noexcept
+{
+    return _mm_shuffle_epi8(table, index);
+}
+
+TERRA_SSSE3_TARGET inline Vector LowNibbles(const Vector x) noexcept
+{
+    return _mm_and_si128(x, _mm_set1_epi8(0x0f));
+}
+
+TERRA_SSSE3_TARGET inline Vector HighNibbles(const Vector x) noexcept
+{
+    return _mm_and_si128(_mm_srli_epi32(x, 4), _mm_set1_epi8(0x0f));
+}
+
+#else // TERRA_USE_INTEL_INTRINSICS
+
+using Vector = uint8x16_t;
+
+inline Vector Load(const std::uint8_t *p) noexcept
+{
+    return vld1q_u8(p);
+}
+
+inline void Store(std::uint8_t *p, const Vector x) noexcept
+{
+    vst1q_u8(p, x);
+}
+
+inline Vector Broadcast(const std::uint8_t x) noexcept
+{
+    return vdupq_n_u8(x);
+}
+
+inline Vector Xor(const Vector a, const Vector b) noexcept
+{
+    return veorq_u8(a, b);
+}
+
+// Indices of 0x80 or more yield zero, as with pshufb
+inline Vector Permute(const Vector table, const Vector index) noexcept
+{
+    return vqtbl1q_u8(table, index);
+}
+
+inline Vector LowNibbles(const Vector x) noexcept
+{
+    return vandq_u8(x, vdupq_n_u8(0x0f));
+}
+
+inline Vector HighNibbles(const Vector x) noexcept
+{
+    return vshrq_n_u8(x, 4);
+}
+
+#endif // TERRA_USE_INTEL_INTRINSICS
+
+/*
+ *  Transform()
+ *
+ *  Description:
+ *      Apply a linear transformation to each octet, given as a pair of
+ *      tables indexed by the low and high nibbles.
+ *
+ *  Parameters:
+ *      x [in]
+ *          The value to transform.
+ *
+ *      low [in]
+ *          The 16-entry table for the low nibble.
+ *
+ *      high [in]
+ *          The 16-entry table for the high nibble.
+ *
+ *  Returns:
+ *      The transformed value.
+ *
+ *  Comments:
+ *      None.
+ */
+TERRA_SSSE3_TARGET inline Vector Transform(const Vector x,
+                                           const std::uint8_t *low,
+                                           const std::uint8_t *high) noexcept
+{
+    return Xor(Permute(Load(low), LowNibbles(x)),
+               Permute(Load(high), HighNibbles(x)));
+}
+
+/*
+ *  Invert()
+ *
+ *  Description:
+ *      Compute the multiplicative inverse of each octet of the state, which
+ *      is in the internal basis.  The result is not a single value, but
+ *      rather a pair of 4-bit values that are used to index the output
+ *      tables (e.g., the S-box tables).
+ *
+ *  Parameters:
+ *      x [in]
+ *          The state to invert.
+ *
+ *      io [out]
+ *          The first index into the output tables.
+ *
+ *      jo [out]
+ *          The second index into the output tables.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+TERRA_SSSE3_TARGET inline void Invert(const Vector x,
+                                      Vector &io,
+                                      Vector &jo) noexcept
+{
+    const Vector inverse = Load(Inverse);
+    const Vector i = HighNibbles(x);
+    const Vector k = LowNibbles(x);
+    const Vector ak = Permute(Load(Inverse_A), k);
+    const Vector j = Xor(i, k);
+    const Vector iak = Xor(Permute(inverse, i), ak);
+    const Vector jak = Xor(Permute(inverse, j), ak);
+
+    io = Xor(Permute(inverse, iak), j);
+    jo = Xor(Permute(inverse, jak), i);
+}
+
+/*
+ *  Lookup()
+ *
+ *  Description:
+ *      Produce the output of a pair of output tables for the indices
+ *      produced by Invert().
+ *
+ *  Parameters:
+ *      u [in]
+ *          The output table indexed by io.
+ *
+ *      t [in]
+ *          The output table indexed by jo.
+ *
+ *      io [in]
+ *          The first index produced by Invert().
+ *
+ *      jo [in]
+ *          The second index produced by Invert().
+ *
+ *  Returns:
+ *      The resulting value.
+ *
+ *  Comments:
+ *      None.
+ */
+TERRA_SSSE3_TARGET inline Vector Lookup(const std::uint8_t *u,
+                                        const std::uint8_t *t,
+                                        const Vector io,
+                                        const Vector jo) noexcept
+{
+    return Xor(Permute(Load(u), io), Permute(Load(t), jo));
+}
+
+/*
+ *  EncryptBlock()
+ *
+ *  Description:
+ *      Encrypt a single block using the transformed key schedule.
+ *
+ *  Parameters:
+ *      x [in]
+ *          The plaintext block.
+ *
+ *      W [in]
+ *          The transformed encryption key schedule.
+ *
+ *      Nr [in]
+ *          The number of rounds.
+ *
+ *  Returns:
+ *      The ciphertext block.
+ *
+ *  Comments:
+ *      In each round, A is the S-box output plus the round key and 2A is
+ *      twice the S-box output, so MixColumns is formed as 2A + 3B + C + D,
+ *      where B, C, and D are A rotated by one, two, and three rows.  (The
+ *      round keys were transformed so that this adds the actual round key.)
+ *
+ *      ShiftRows() is not performed on the state, but rather the rotations
+ *      and round keys are arranged for the layout of the state in each
+ *      round, with the octets moved into place once at the end.
+ */
+TERRA_SSSE3_TARGET inline Vector EncryptBlock(
+                                    Vector x,
+                                    const std::uint8_t (*W)[16],
+                                    const std::size_t Nr) noexcept
+{
+    Vector io, jo;
+
+    // Transform the input and the first round key
+    x = Xor(Transform(x, Encrypt_Input_Low, Encrypt_Input_High), Load(W[0]));
+
+    for (std::size_t round = 1; round < Nr; round++)
+    {
+        const Vector forward = Load(Encrypt_Forward[round & 3].data());
+        const Vector backward = Load(Encrypt_Backward[round & 3].data());
+
+        Invert(x, io, jo);
+
+        const Vector a = Xor(Lookup(SBox1_U, SBox1_T, io, jo),
+                             Load(W[round]));
+        const Vector a2b = Xor(Lookup(SBox2_U, SBox2_T, io, jo),
+                               Permute(a, forward));
+
+        // 2A + B + D + (2B + C)
+        x = Xor(Xor(a2b, Permute(a, backward)), Permute(a2b, forward));
+    }
+
+    // Final round
+    Invert(x, io, jo);
+
+    x = Xor(Lookup(SBox_Output_U, SBox_Output_T, io, jo), Load(W[Nr]));
+
+    // Move the octets to their positions in the logical state
+    return Permute(x, Load(Decrypt_Layouts[Nr & 3].data()));
+}
+
+/*
+ *  DecryptBlock()
+ *
+ *  Description:
+ *      Decrypt a single block using the transformed key schedule.
+ *
+ *  Parameters:
+ *      x [in]
+ *          The ciphertext block.
+ *
+ *      DW [in]
+ *          The transformed decryption key schedule.
+ *
+ *      Nr [in]
+ *          The number of rounds.
+ *
+ *  Returns:
+ *      The plaintext block.
+ *
+ *  Comments:
+ *      InvMixColumns is computed with Horner's rule, rotating the sum by
+ *      one row before adding each of the inverse S-box outputs multiplied by
+ *      9, 13, 11, and 14.  As with encryption, InvShiftRows() is folded
+ *      into the rotations and round keys.
+ */
+TERRA_SSSE3_TARGET inline Vector DecryptBlock(
+                                    Vector x,
+                                    const std::uint8_t (*DW)[16],
+                                    const std::size_t Nr) noexcept
+{
+    Vector io, jo;
+
+    // Transform the input and the first round key
+    x = Xor(Transform(x, Decrypt_Input_Low, Decrypt_Input_High), Load(DW[0]));
+
+    for (std::size_t round = 1; round < Nr; round++)
+    {
+        const Vector forward = Load(Decrypt_Forward[round & 3].data());
+
+        Invert(x, io, jo);
+
+        x = Xor(Load(DW[round]), Lookup(InvSBox9_U, InvSBox9_T, io, jo));
+        x = Xor(Permute(x, forward), Lookup(InvSBoxD_U, InvSBoxD_T, io, jo));
+        x = Xor(Permute(x, forward), Lookup(InvSBoxB_U, InvSBoxB_T, io, jo));
+        x = Xor(Permute(x, forward), Lookup(InvSBoxE_U, InvSBoxE_T, io, jo));
+    }
+
+    // Final round
+    Invert(x, io, jo);
+
+    x = Xor(Lookup(InvSBox_Output_U, InvSBox_Output_T, io, jo), Load(DW[Nr]));
+
+    // Move the octets to their positions in the logical state
+    return Permute(x, Load(Encrypt_Layouts[Nr & 3].data()));
+}
+
+/*
+ *  SubWord()
+ *
+ *  Description:
+ *      Apply the S-box to each of the four octets of a word in the key
+ *      expansion, without the use of table lookups in memory.
+ *
+ *  Parameters:
+ *      word [in/out]
+ *          The four octets to transform.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+TERRA_SSSE3_TARGET inline void SubWord(std::uint8_t *word) noexcept
+{
+    std::uint8_t block[16]{};
+    Vector io, jo;
+
+    std::memcpy(block, word, 4);
+
+    Invert(Transform(Load(block), Encrypt_Input_Low, Encrypt_Input_High),
+           io,
+           jo);
+
+    // The output table does not add the constant 0x63
+    Store(block,
+          Xor(Lookup(SBox_Output_U, SBox_Output_T, io, jo), Broadcast(0x63)));
+
+    std::memcpy(word, block, 4);
+
+    Terra::SecUtil::SecureErase(block, sizeof(block));
+}
+
+/*
+ *  Multiply()
+ *
+ *  Description:
+ *      Multiply an octet by a constant in GF(2^8) in constant time.
+ *
+ *  Parameters:
+ *      x [in]
+ *          The value to multiply.
+ *
+ *      y [in]
+ *          The constant by which to multiply (not secret).
+ *
+ *  Returns:
+ *      The product.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr std::uint8_t Multiply(std::uint8_t x, std::uint8_t y) noexcept
+{
+    std::uint8_t result{};
+
+    while (y != 0)
+    {
+        if (y & 1) result ^= x;
+
+        // Multiply x by {02}, reducing without a data-dependent branch
+        x = static_cast<std::uint8_t>((x << 1) ^ (0x1b & (0 - (x >> 7))));
+        y >>= 1;
+    }
+
+    return result;
+}
+
+/*
+ *  InvMixColumns()
+ *
+ *  Description:
+ *      Apply the InvMixColumns() transformation to a round key.
+ *
+ *  Parameters:
+ *      key [in/out]
+ *          The 16-octet round key.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr void InvMixColumns(std::uint8_t *key) noexcept
+{
+    for (std::size_t c = 0; c < 16; c += 4)
+    {
+        const std::uint8_t a0 = key[c];
+        const std::uint8_t a1 = key[c + 1];
+        const std::uint8_t a2 = key[c + 2];
+        const std::uint8_t a3 = key[c + 3];
+
+        key[c    ] = Multiply(a0, 14) ^ Multiply(a1, 11) ^
+                     Multiply(a2, 13) ^ Multiply(a3,  9);
+        key[c + 1] = Multiply(a0,  9) ^ Multiply(a1, 14) ^
+                     Multiply(a2, 11) ^ Multiply(a3, 13);
+        key[c + 2] = Multiply(a0, 13) ^ Multiply(a1,  9) ^
+                     Multiply(a2, 14) ^ Multiply(a3, 11);
+        key[c + 3] = Multiply(a0, 11) ^ Multiply(a1, 13) ^
+                     Multiply(a2,  9) ^ Multiply(a3, 14);
+    }
+}
+
+} // namespace
+
+/*
+ * AESVectorPermute::AESVectorPermute()
+ *
+ *  Description:
+ *      This is a constructor for the AESVectorPermute object with no given
+ *      key.  It will initialize internal structures to zero.  Since a key is
+ *      not provided to this version of the constructor, one must call
+ *      SetKey() with a valid key before calling Encrypt() or Decrypt(),
+ *      as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESVectorPermute::AESVectorPermute() noexcept :
+    AESEngine(),
+    Nr{},
+    W{},
+    DW{}
+{
+    // Nothing to do
+}
+
+/*
+ * AESVectorPermute::AESVectorPermute()
+ *
+ *  Description:
+ *      This is a constructor for the AESVectorPermute object that accepts a
+ *      span of octets as input that contains the key.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *      This corresponds to 128, 192, and 256 bits.
+ *
+ *  Comments:
+ *      None.
+ */
+AESVectorPermute::AESVectorPermute(const std::span<const std::uint8_t> key) :
+    AESVectorPermute()
+{
+    // Only set the key if the vector permute instructions are supported
+    if (GetEngineType() == AESEngineType::VectorPermute) SetKey(key);
+}
+
+/*
+ * AESVectorPermute::AESVectorPermute()
+ *
+ *  Description:
+ *      This is a copy constructor for the AESVectorPermute object that
+ *      accepts a reference to another AESVectorPermute object as a parameter.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESVectorPermute object from which to copy values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESVectorPermute::AESVectorPermute(const AESVectorPermute &other) noexcept :
+    AESVectorPermute()
+{
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+    std::memcpy(DW, other.DW, sizeof(DW));
+}
+
+/*
+ * AESVectorPermute::AESVectorPermute()
+ *
+ *  Description:
+ *      This is a move constructor for the AESVectorPermute object that
+ *      accepts a reference to another AESVectorPermute object as a
+ *      parameter.  Note that this move operation actually just performs a
+ *      copy of data, since there is no dynamic data to really move.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESVectorPermute object from which to move values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function just copies the other AESVectorPermute object's values
+ *      since there is no internal data that can be moved.
+ */
+AESVectorPermute::AESVectorPermute(AESVectorPermute &&other) noexcept :
+    AESVectorPermute()
+{
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+    std::memcpy(DW, other.DW, sizeof(DW));
+}
+
+/*
+ * AESVectorPermute::~AESVectorPermute()
+ *
+ *  Description:
+ *      This is the destructor for the AESVectorPermute object and is
+ *      responsible for zeroing memory to ensure a clean termination with no
+ *      residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESVectorPermute::~AESVectorPermute()
+{
+    SecUtil::SecureErase(&Nr, sizeof(Nr));
+    SecUtil::SecureErase(W, sizeof(W));
+    SecUtil::SecureErase(DW, sizeof(DW));
+}
+
+/*
+ * AESVectorPermute::operator=()
+ *
+ *  Description:
+ *      Assign one AESVectorPermute object to another.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESVectorPermute from which to copy data.
+ *
+ *  Returns:
+ *      A reference to this AESVectorPermute object.
+ *
+ *  Comments:
+ *      None.
+ */
+AESVectorPermute &AESVectorPermute::operator=(const AESVectorPermute &other)
+{
+    // If this is the same object, just return this
+    if (this == &other) return *this;
+
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+    std::memcpy(DW, other.DW, sizeof(DW));
+
+    return *this;
+}
+
+/*
+ * AESVectorPermute::operator=()
+ *
+ *  Description:
+ *      Move assignment operator to assign another AESVectorPermute object to
+ *      this one.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESVectorPermute from which to move data.
+ *
+ *  Returns:
+ *      A reference to this AESVectorPermute object.
+ *
+ *  Comments:
+ *      None.
+ */
+AESVectorPermute &AESVectorPermute::operator=(
+                                        AESVectorPermute &&other) noexcept
+{
+    // If this is the same object, just return this
+    if (this == &other) return *this;
+
+    Nr = other.Nr;
+    std::memcpy(W, other.W, sizeof(W));
+    std::memcpy(DW, other.DW, sizeof(DW));
+
+    return *this;
+}
+
+/*
+ * AESVectorPermute::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent calls to
+ *      Encrypt() or Decrypt().
+ *
+ *  Parameters:
+ *      key [in]
+ *          The encryption key to use with this instance of the object.
+ *
+ *      key_usage [in]
+ *          Indicates whether the key will be used for both encryption and
+ *          decryption or only for encryption.  If AESKeyUsage::EncryptOnly,
+ *          the decryption key schedule is not computed and Decrypt() and
+ *          DecryptBlocks() must not be called until the key is set again.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      one of 16, 24, or 32 octets in length as required by the standard.
+ *
+ *  Comments:
+ *      The key schedule is computed per FIPS 197 Section 5.2, using the
+ *      vector permute S-box, and each round key is then transformed into
+ *      the form used by the rounds in EncryptBlock() and DecryptBlock().
+ *      Decryption uses the Equivalent Inverse Cipher (FIPS 197 Section
+ *      5.3.5), with InvMixColumns applied to the inner round keys.
+ */
+TERRA_SSSE3_TARGET void AESVectorPermute::SetKey(
+                                    const std::span<const std::uint8_t> key,
+                                    AESKeyUsage key_usage)
+{
+    std::uint8_t schedule[AES_Block_Size * (Max_Rounds + 1)];
+    std::uint8_t round_key[AES_Block_Size];
+    std::uint8_t temp[4];
+    std::size_t Nk;
+
+    // Zero the key schedule
+    SecUtil::SecureErase(W, sizeof(W));
+    SecUtil::SecureErase(DW, sizeof(DW));
+
+    // Determine the number of rounds given the key length
+    switch (key.size())
+    {
+        case 16:
+            Nr = 10;
+            Nk = 4;
+            break;
+
+        case 24:
+            Nr = 12;
+            Nk = 6;
+            break;
+
+        case 32:
+            Nr = 14;
+            Nk = 8;
+            break;
+
+        default:
+            throw AESException("Invalid key length provided");
+    }
+
+    // Fill the first Nk words of the key schedule
+    std::memcpy(schedule, key.data(), key.size());
+
+    // Fill the remaining words of the key schedule
+    for (std::size_t i = Nk; i < Nb * (Nr + 1); i++)
+    {
+        std::memcpy(temp, schedule + ((i - 1) << 2), sizeof(temp));
+
+        if ((i % Nk) == 0)
+        {
+            // RotWord()
+            const std::uint8_t t = temp[0];
+            temp[0] = temp[1];
+            temp[1] = temp[2];
+            temp[2] = temp[3];
+            temp[3] = t;
+
+            SubWord(temp);
+
+            temp[0] ^= static_cast<std::uint8_t>(Rcon[(i / Nk) - 1] >> 24);
+        }
+        else if ((Nk > 6) && ((i % Nk) == 4))
+        {
+            SubWord(temp);
+        }
+
+        for (std::size_t j = 0; j < 4; j++)
+        {
+            schedule[(i << 2) + j] = schedule[((i - Nk) << 2) + j] ^ temp[j];
+        }
+    }
+
+    const Vector forward = Load(Rotate_Forward.data());
+    const Vector constant = Broadcast(0x63);
+
+    // The first encryption round key only needs to match the input basis
+    Store(W[0],
+          Transform(Load(schedule), Encrypt_Input_Low, Encrypt_Input_High));
+
+    // The S-box tables omit 0x63, and a key k is added as k rotated by one,
+    // two, and three rows in each round (and that operation is its own
+    // inverse), so the round keys are adjusted accordingly
+    for (std::size_t i = 1; i < Nr; i++)
+    {
+        const Vector k = Transform(
+            Xor(Load(schedule + (i * AES_Block_Size)), constant),
+            Encrypt_Input_Low,
+            Encrypt_Input_High);
+        const Vector b = Permute(k, forward);
+        const Vector c = Permute(b, forward);
+        const Vector d = Permute(c, forward);
+
+        Store(W[i], Xor(Xor(b, c), d));
+    }
+
+    // The final round key is in the standard basis, but adds the 0x63
+    Store(W[Nr], Xor(Load(schedule + (Nr * AES_Block_Size)), constant));
+
+    // Arrange each round key for the layout of the state in that round
+    for (std::size_t i = 1; i <= Nr; i++)
+    {
+        Store(W[i], Permute(Load(W[i]), Load(Encrypt_Layouts[i & 3].data())));
+    }
+
+    // Create the decryption round keys, unless only encrypting
+    if (key_usage == AESKeyUsage::EncryptDecrypt)
+    {
+        // The decryption input transformation also absorbs 0x63
+        Store(DW[0],
+              Transform(Xor(Load(schedule + (Nr * AES_Block_Size)), constant),
+                        Decrypt_Input_Low,
+                        Decrypt_Input_High));
+
+        // The inner decryption round keys are rotated three times with the
+        // state, so they are rotated once here to complete the cycle
+        for (std::size_t i = 1; i < Nr; i++)
+        {
+            std::memcpy(round_key,
+                        schedule + ((Nr - i) * AES_Block_Size),
+                        sizeof(round_key));
+
+            InvMixColumns(round_key);
+
+            Store(DW[i],
+                  Permute(Transform(Xor(Load(round_key), constant),
+                                    Decrypt_Input_Low,
+                                    Decrypt_Input_High),
+                          forward));
+        }
+
+        // The final round key is in the standard basis
+        std::memcpy(DW[Nr], schedule, AES_Block_Size);
+
+        // Arrange each round key for the layout of the state in that round
+        for (std::size_t i = 1; i <= Nr; i++)
+        {
+            Store(DW[i],
+                  Permute(Load(DW[i]), Load(Decrypt_Layouts[i & 3].data())));
+        }
+    }
+
+    // Erase the temporary key material
+    SecUtil::SecureErase(schedule, sizeof(schedule));
+    SecUtil::SecureErase(round_key, sizeof(round_key));
+    SecUtil::SecureErase(temp, sizeof(temp));
+}
+
+/*
+ * AESVectorPermute::ClearKeyState()
+ *
+ *  Description:
+ *      Clear the key and all state data.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESVectorPermute::ClearKeyState()
+{
+    SecUtil::SecureErase(&Nr, sizeof(Nr));
+    SecUtil::SecureErase(W, sizeof(W));
+    SecUtil::SecureErase(DW, sizeof(DW));
+}
+
+/*
+ * AESVectorPermute::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt a block of plaintext and return the
+ *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The 16-octet data block to encrypt.
+ *
+ *      ciphertext [out]
+ *          The 16-octet encrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the plaintext span.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+TERRA_SSSE3_TARGET void AESVectorPermute::Encrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> plaintext,
+            std::span<std::uint8_t, AES_Block_Size> ciphertext) const noexcept
+{
+    Store(ciphertext.data(), EncryptBlock(Load(plaintext.data()), W, Nr));
+}
+
+/*
+ * AESVectorPermute::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt a block of ciphertext and return the
+ *      plaintext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The 16-octet data block to decrypt.
+ *
+ *      plaintext [out]
+ *          The 16-octet decrypted data block.  AES operates in place, so this
+ *          span may be the same memory location as the ciphertext span.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+TERRA_SSSE3_TARGET void AESVectorPermute::Decrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> ciphertext,
+            std::span<std::uint8_t, AES_Block_Size> plaintext) const noexcept
+{
+    Store(plaintext.data(), DecryptBlock(Load(ciphertext.data()), DW, Nr));
+}
+
+/*
+ * AESVectorPermute::EncryptBlocks()
+ *
+ *  Description:
+ *      This function will encrypt a series of plaintext blocks and return the
+ *      ciphertext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      plaintext [in]
+ *          The data to encrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      ciphertext [out]
+ *          The encrypted data blocks.  This span must be the same length as
+ *          the plaintext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the encrypted data is stored in the ciphertext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+TERRA_SSSE3_TARGET void AESVectorPermute::EncryptBlocks(
+                const std::span<const std::uint8_t> plaintext,
+                std::span<std::uint8_t> ciphertext) const noexcept
+{
+    const std::uint8_t *p = plaintext.data();
+    std::uint8_t *c = ciphertext.data();
+
+    for (std::size_t i = 0; i < plaintext.size(); i += AES_Block_Size)
+    {
+        Store(c + i, EncryptBlock(Load(p + i), W, Nr));
+    }
+}
+
+/*
+ * AESVectorPermute::DecryptBlocks()
+ *
+ *  Description:
+ *      This function will decrypt a series of ciphertext blocks and return
+ *      the plaintext.  It is assumed the key was previously set via SetKey().
+ *
+ *  Parameters:
+ *      ciphertext [in]
+ *          The data to decrypt, which must be an integral number of 16-octet
+ *          blocks.
+ *
+ *      plaintext [out]
+ *          The decrypted data blocks.  This span must be the same length as
+ *          the ciphertext span and may refer to the same memory location.
+ *
+ *  Returns:
+ *      Nothing, though the decrypted data is stored in the plaintext
+ *      parameter as output.
+ *
+ *  Comments:
+ *      None.
+ */
+TERRA_SSSE3_TARGET void AESVectorPermute::DecryptBlocks(
+                const std::span<const std::uint8_t> ciphertext,
+                std::span<std::uint8_t> plaintext) const noexcept
+{
+    const std::uint8_t *c = ciphertext.data();
+    std::uint8_t *p = plaintext.data();
+
+    for (std::size_t i = 0; i < ciphertext.size(); i += AES_Block_Size)
+    {
+        Store(p + i, DecryptBlock(Load(c + i), DW, Nr));
+    }
+}
+
+/*
+ * AESVectorPermute::operator==()
+ *
+ *  Description:
+ *      Compare two AESVectorPermute objects for equality.  Equality means
+ *      that the two objects have the same key data.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESVectorPermute object with which to compare.
+ *
+ *  Returns:
+ *      True if the objects are equal, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESVectorPermute::operator==(const AESVectorPermute &other) const
+{
+    // If comparing to self, return true
+    if (this == &other) return true;
+
+    if (Nr != other.Nr) return false;
+
+    // Compare the key schedules
+    if (std::memcmp(W, other.W, sizeof(W)) != 0) return false;
+
+    return std::memcmp(DW, other.DW, sizeof(DW)) == 0;
+}
+
+/*
+ * AESVectorPermute::operator!=()
+ *
+ *  Description:
+ *      Compare two AESVectorPermute objects for inequality.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The other AESVectorPermute object with which to compare.
+ *
+ *  Returns:
+ *      True if the objects are not equal, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AESVectorPermute::operator!=(const AESVectorPermute &other) const
+{
+    return !(*this == other);
+}
+
+} // namespace Terra::Crypto::Cipher
+
+#endif // TERRA_USE_INTEL_INTRINSICS || TERRA_USE_ARM_INTRINSICS
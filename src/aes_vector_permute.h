@@ -0,0 +1,130 @@
+/*
+ *  aes_vector_permute.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the AESVectorPermute object which performs
+ *      encryption and decryption as specified in FIPS 197 ("Advanced
+ *      Encryption Standard") using vector permute instructions (SSSE3
+ *      pshufb or NEON tbl) in place of table lookups in memory.
+ *
+ *      This engine is intended for processors that have SIMD registers, but
+ *      lack AES instructions.  Unlike the bitsliced engine, a single block
+ *      is processed as quickly as any other, so it is well suited to modes
+ *      that must process one block at a time (e.g., CBC encryption).
+ *
+ *      Note that if one attempts to use this AES engine on a processor that
+ *      does not support SSSE3 it will not work and will likely cause the
+ *      process to terminate with an illegal instruction.  One should always
+ *      call GetEngineType() to ensure that it does not return
+ *      "AESEngineType::Unavailable" before attempting to use any of the
+ *      functions.
+ *
+ *  Portability Issues:
+ *      On Intel processors, the functions using SSSE3 are compiled with a
+ *      target attribute on GCC and Clang so that the rest of the library
+ *      does not require SSSE3.  NEON is always present on 64-bit ARM.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <terra/crypto/cipher/aes.h>
+#include "intel_intrinsics.h"
+#include "arm_intrinsics.h"
+#include "cpu_check.h"
+#include "aes_unavailable.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+#if defined(TERRA_USE_INTEL_INTRINSICS) || defined(TERRA_USE_ARM_INTRINSICS)
+
+// Define the AESVectorPermute class
+class AESVectorPermute : public AESEngine
+{
+    protected:
+        // The block size of the AES cipher is fixed at 16 octets
+        static constexpr std::size_t AES_Block_Size{16};
+
+        // Number of columns in the State array
+        static constexpr std::size_t Nb{4};
+
+        // Specify the maximum number of rounds per the standard
+        static constexpr std::size_t Max_Rounds{14};
+
+    public:
+        AESVectorPermute() noexcept;
+        AESVectorPermute(const std::span<const std::uint8_t> key);
+        AESVectorPermute(const AESVectorPermute &other) noexcept;
+        AESVectorPermute(AESVectorPermute &&other) noexcept;
+        ~AESVectorPermute();
+
+        AESVectorPermute &operator=(const AESVectorPermute &other);
+        AESVectorPermute &operator=(AESVectorPermute &&other) noexcept;
+
+        AESEngineType GetEngineType() const noexcept override
+        {
+#ifdef TERRA_USE_INTEL_INTRINSICS
+            if (!CPUSupportsSSSE3()) return AESEngineType::Unavailable;
+#endif
+
+            return AESEngineType::VectorPermute;
+        }
+
+        void SetKey(
+            const std::span<const std::uint8_t> key,
+            AESKeyUsage key_usage = AESKeyUsage::EncryptDecrypt) override;
+
+        void ClearKeyState() override;
+
+        void Encrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> plaintext,
+            std::span<std::uint8_t, AES_Block_Size> ciphertext) const noexcept
+            override;
+
+        void Decrypt(
+            const std::span<const std::uint8_t, AES_Block_Size> ciphertext,
+            std::span<std::uint8_t, AES_Block_Size> plaintext) const noexcept
+            override;
+
+        void EncryptBlocks(const std::span<const std::uint8_t> plaintext,
+                           std::span<std::uint8_t> ciphertext) const noexcept
+            override;
+
+        void DecryptBlocks(const std::span<const std::uint8_t> ciphertext,
+                           std::span<std::uint8_t> plaintext) const noexcept
+            override;
+
+        bool operator==(const AESVectorPermute &other) const;
+        bool operator!=(const AESVectorPermute &other) const;
+
+    protected:
+        // Number of encryption rounds
+        std::size_t Nr;
+
+        // Encryption round keys, transformed for the vector permute rounds
+        std::uint8_t W[Max_Rounds + 1][AES_Block_Size];
+
+        // Decryption round keys, transformed for the vector permute rounds
+        std::uint8_t DW[Max_Rounds + 1][AES_Block_Size];
+};
+
+#else
+
+// If building without Intel or ARM intrinsics, alias this engine type as
+// unavailable
+
+using AESVectorPermute = AESUnavailable;
+
+#endif
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,504 @@
+/*
+ *  aes_xts.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the XTS-AES mode of operation as specified in
+ *      IEEE Std 1619 and NIST Special Publication 800-38E.
+ *
+ *      The tweaks for Parallel_Blocks consecutive blocks are computed into a
+ *      buffer by repeatedly multiplying the encrypted tweak by the primitive
+ *      element x in GF(2^128).  The data blocks are XORed with those tweaks,
+ *      enciphered with a single call to AES::EncryptBlocks() (or
+ *      DecryptBlocks()), and XORed with the tweaks once more.  All work is
+ *      performed in the output buffer and fixed-size member buffers, so no
+ *      memory is allocated while processing a data unit.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <terra/crypto/cipher/aes_xts.h>
+#include <terra/secutil/secure_erase.h>
+#include "mode_utilities.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+/*
+ *  AESXTS::AESXTS()
+ *
+ *  Description:
+ *      This is a constructor for the AESXTS object with no given key.
+ *      Since a key is not provided to this version of the constructor, one
+ *      must call SetKey() with a valid key before calling Encrypt() or
+ *      Decrypt(), as the results will otherwise be invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESXTS::AESXTS() :
+    data_aes(),
+    tweak_aes(),
+    tweak{},
+    tweaks{},
+    block{}
+{
+    // Nothing more to do
+}
+
+/*
+ *  AESXTS::AESXTS()
+ *
+ *  Description:
+ *      This is a constructor for the AESXTS object that accepts a span
+ *      of octets holding the XTS-AES key that will be used for subsequent
+ *      operations.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The XTS-AES key to use with this instance of the object.  This is
+ *          the data key followed by the tweak key and must be 32 or 64
+ *          octets in length.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the key provided is
+ *      an invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+AESXTS::AESXTS(const std::span<const std::uint8_t> key) :
+    data_aes(),
+    tweak_aes(),
+    tweak{},
+    tweaks{},
+    block{}
+{
+    SetKey(key);
+}
+
+/*
+ *  AESXTS::~AESXTS()
+ *
+ *  Description:
+ *      This is the destructor for the AESXTS object and is responsible for
+ *      zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AESXTS::~AESXTS()
+{
+    SecUtil::SecureErase(&tweak, sizeof(tweak));
+    SecUtil::SecureErase(&tweaks, sizeof(tweaks));
+    SecUtil::SecureErase(&block, sizeof(block));
+}
+
+/*
+ *  AESXTS::SetKey()
+ *
+ *  Description:
+ *      This function will set the key to be used for subsequent encryption
+ *      and decryption calls.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The XTS-AES key to use with this instance of the object.  This is
+ *          the data key followed by the tweak key and must be 32 or 64
+ *          octets in length.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if the key provided is not
+ *      32 or 64 octets in length.
+ *
+ *  Comments:
+ *      Only the encryption key schedule is computed for the tweak key, since
+ *      the tweak is always encrypted.
+ */
+void AESXTS::SetKey(const std::span<const std::uint8_t> key)
+{
+    if ((key.size() != 32) && (key.size() != 64))
+    {
+        throw AESException("Invalid key length provided");
+    }
+
+    data_aes.SetKey(key.first(key.size() / 2));
+    tweak_aes.SetKey(key.subspan(key.size() / 2), AESKeyUsage::EncryptOnly);
+}
+
+/*
+ *  AESXTS::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt a data unit (sector) identified by the
+ *      given sector number.
+ *
+ *  Parameters:
+ *      sector [in]
+ *          The sector number (data unit sequence number) of this data
+ *          unit.  This is encoded as a 128-bit little endian integer to form
+ *          the tweak, as specified in IEEE Std 1619.
+ *
+ *      plaintext [in]
+ *          The plaintext to be encrypted.  This must be at least 16 octets
+ *          and at most Max_Data_Unit_Length octets in length.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext.  This may be the same memory location as the
+ *          plaintext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESXTS::Encrypt(const std::uint64_t sector,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext)
+{
+    InitializeTweak(sector);
+
+    ProcessDataUnit(plaintext, ciphertext, true);
+}
+
+/*
+ *  AESXTS::Encrypt()
+ *
+ *  Description:
+ *      This function will encrypt a data unit using the given 16-octet
+ *      tweak value.
+ *
+ *  Parameters:
+ *      tweak [in]
+ *          The 16-octet tweak value for this data unit.
+ *
+ *      plaintext [in]
+ *          The plaintext to be encrypted.  This must be at least 16 octets
+ *          and at most Max_Data_Unit_Length octets in length.
+ *
+ *      ciphertext [out]
+ *          A buffer to hold the ciphertext.  This must be the same length
+ *          as the plaintext.  This may be the same memory location as the
+ *          plaintext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESXTS::Encrypt(const std::span<const std::uint8_t, 16> tweak,
+                     const std::span<const std::uint8_t> plaintext,
+                     std::span<std::uint8_t> ciphertext)
+{
+    InitializeTweak(tweak);
+
+    ProcessDataUnit(plaintext, ciphertext, true);
+}
+
+/*
+ *  AESXTS::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt a data unit (sector) identified by the
+ *      given sector number.
+ *
+ *  Parameters:
+ *      sector [in]
+ *          The sector number (data unit sequence number) used when the data
+ *          unit was encrypted.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to be decrypted.  This must be at least 16 octets
+ *          and at most Max_Data_Unit_Length octets in length.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext.  This may be the same memory location as the
+ *          ciphertext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESXTS::Decrypt(const std::uint64_t sector,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext)
+{
+    InitializeTweak(sector);
+
+    ProcessDataUnit(ciphertext, plaintext, false);
+}
+
+/*
+ *  AESXTS::Decrypt()
+ *
+ *  Description:
+ *      This function will decrypt a data unit using the given 16-octet
+ *      tweak value.
+ *
+ *  Parameters:
+ *      tweak [in]
+ *          The 16-octet tweak value used when the data unit was encrypted.
+ *
+ *      ciphertext [in]
+ *          The ciphertext to be decrypted.  This must be at least 16 octets
+ *          and at most Max_Data_Unit_Length octets in length.
+ *
+ *      plaintext [out]
+ *          A buffer to hold the plaintext.  This must be the same length
+ *          as the ciphertext.  This may be the same memory location as the
+ *          ciphertext.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESXTS::Decrypt(const std::span<const std::uint8_t, 16> tweak,
+                     const std::span<const std::uint8_t> ciphertext,
+                     std::span<std::uint8_t> plaintext)
+{
+    InitializeTweak(tweak);
+
+    ProcessDataUnit(ciphertext, plaintext, false);
+}
+
+/*
+ *  AESXTS::InitializeTweak()
+ *
+ *  Description:
+ *      This function will form the tweak value from the given sector number
+ *      and encrypt it using the tweak key.
+ *
+ *  Parameters:
+ *      sector [in]
+ *          The sector number, which is encoded as a 128-bit little endian
+ *          integer.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESXTS::InitializeTweak(const std::uint64_t sector)
+{
+    StoreLittleEndian64(sector, block.data());
+    StoreLittleEndian64(0, block.data() + 8);
+
+    tweak_aes.Encrypt(block, tweak);
+}
+
+/*
+ *  AESXTS::InitializeTweak()
+ *
+ *  Description:
+ *      This function will encrypt the given tweak value using the tweak key.
+ *
+ *  Parameters:
+ *      tweak [in]
+ *          The 16-octet tweak value.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESXTS::InitializeTweak(const std::span<const std::uint8_t, 16> tweak)
+{
+    tweak_aes.Encrypt(tweak, this->tweak);
+}
+
+/*
+ *  AESXTS::ComputeTweaks()
+ *
+ *  Description:
+ *      This function will fill the tweaks buffer with the tweaks for the
+ *      given number of consecutive blocks, starting with the current tweak,
+ *      and then advance the current tweak past those blocks.
+ *
+ *  Parameters:
+ *      blocks [in]
+ *          The number of tweaks to compute.  This must not exceed
+ *          Parallel_Blocks.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESXTS::ComputeTweaks(std::size_t blocks)
+{
+    ComputeXTSTweaks(tweak, tweaks.data(), blocks);
+}
+
+/*
+ *  AESXTS::ProcessDataUnit()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt a complete data unit, using the
+ *      current tweak (which must have been initialized) for the first block.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The plaintext or ciphertext to process.
+ *
+ *      output [out]
+ *          The buffer into which the result is written.  This must be the
+ *          same length as the input and may be the same memory location.
+ *
+ *      encrypt [in]
+ *          True to encrypt, false to decrypt.
+ *
+ *  Returns:
+ *      Nothing, though an AESException will be thrown if the spans have an
+ *      invalid length.
+ *
+ *  Comments:
+ *      When the length is not a multiple of 16, the final full block and
+ *      the partial block are processed using ciphertext stealing.  The
+ *      partial block is read before the output is written so that the
+ *      operation may be performed in place.
+ */
+void AESXTS::ProcessDataUnit(const std::span<const std::uint8_t> input,
+                             std::span<std::uint8_t> output,
+                             bool encrypt)
+{
+    std::size_t remainder = input.size() & 0x0f;
+    std::size_t length{};
+    std::size_t bulk{};
+    std::uint8_t octet{};
+
+    // Ensure buffers appear sane
+    if ((input.size() != output.size()) || (input.size() < 16) ||
+        (input.size() > Max_Data_Unit_Length))
+    {
+        throw AESException("One or more spans have an invalid length");
+    }
+
+    // Hold back the last full block if ciphertext stealing is required
+    bulk = input.size() - remainder - (remainder > 0 ? 16 : 0);
+
+    for (std::size_t offset = 0; offset < bulk; offset += length)
+    {
+        length = std::min(tweaks.size(), bulk - offset);
+
+        ComputeTweaks(length / 16);
+
+        XorBuffers(input.data() + offset,
+                   tweaks.data(),
+                   output.data() + offset,
+                   length);
+
+        if (encrypt)
+        {
+            data_aes.EncryptBlocks(output.subspan(offset, length),
+                                   output.subspan(offset, length));
+        }
+        else
+        {
+            data_aes.DecryptBlocks(output.subspan(offset, length),
+                                   output.subspan(offset, length));
+        }
+
+        XorBuffers(output.data() + offset,
+                   tweaks.data(),
+                   output.data() + offset,
+                   length);
+    }
+
+    if (remainder == 0) return;
+
+    // Compute the tweaks for the final full block and the partial block
+    ComputeTweaks(2);
+
+    // Process the last full block; when decrypting, its tweak is the one
+    // that was used for the partial block when it was encrypted
+    std::copy(input.begin() + bulk, input.begin() + bulk + 16, block.begin());
+    ProcessBlock(encrypt ? 0 : 1, encrypt);
+
+    // Steal the tail of that block to fill out the partial block, writing
+    // the leading octets as the final partial output block
+    for (std::size_t i = 0; i < remainder; i++)
+    {
+        octet = input[bulk + 16 + i];
+        output[bulk + 16 + i] = block[i];
+        block[i] = octet;
+    }
+
+    // Process the reassembled block to produce the last full output block
+    ProcessBlock(encrypt ? 1 : 0, encrypt);
+    std::copy(block.begin(), block.end(), output.begin() + bulk);
+}
+
+/*
+ *  AESXTS::ProcessBlock()
+ *
+ *  Description:
+ *      This function will encrypt or decrypt the contents of the block
+ *      buffer in place using the given tweak from the tweaks buffer.
+ *
+ *  Parameters:
+ *      tweak_index [in]
+ *          The index of the tweak within the tweaks buffer.
+ *
+ *      encrypt [in]
+ *          True to encrypt, false to decrypt.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void AESXTS::ProcessBlock(std::size_t tweak_index, bool encrypt)
+{
+    const std::uint8_t *t = tweaks.data() + tweak_index * 16;
+
+    XorBuffers(block.data(), t, block.data(), block.size());
+
+    if (encrypt)
+    {
+        data_aes.Encrypt(block, block);
+    }
+    else
+    {
+        data_aes.Decrypt(block, block);
+    }
+
+    XorBuffers(block.data(), t, block.data(), block.size());
+}
+
+} // namespace Terra::Crypto::Cipher
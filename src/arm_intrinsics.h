@@ -0,0 +1,35 @@
+/*
+ *  arm_intrinsics.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file will check to see if the platform might support the ARMv8
+ *      Cryptography Extension and set TERRA_USE_ARM_INTRINSICS if so, while
+ *      also including the ARM NEON intrinsics header file.  If one wants to
+ *      disable use of ARM intrinsics, turn off TERRA_ENABLE_ARM_INTRINSICS.
+ *
+ *  Portability Issues:
+ *      Only 64-bit ARM (AArch64) is supported.
+ */
+
+#pragma once
+
+#ifdef TERRA_ENABLE_ARM_INTRINSICS
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#ifndef TERRA_USE_ARM_INTRINSICS
+#define TERRA_USE_ARM_INTRINSICS 1
+#endif
+
+#include <arm_neon.h>
+
+#endif // CPU definitions
+
+#endif // TERRA_ENABLE_ARM_INTRINSICS
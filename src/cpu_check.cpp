@@ -1,7 +1,7 @@
 /*
  *  cpu_check.cpp
  *
- *  Copyright (C) 2024, 2025
+ *  Copyright (C) 2024, 2025, 2026
  *  Terrapane Corporation
  *  All Rights Reserved
  *
@@ -9,17 +9,39 @@
  *      Paul E. Jones <paulej@packetizer.com>
  *
  *  Description:
- *      This module defines a function that will verify that the Intel
- *      processor supports the AES-NI instructions.  When calling the cpuid()
- *      function with function_id 1, bit 25 of the ecx register will contain
- *      a 1 if the AES-NI instructions are supported.  Source:
+ *      This module defines the function that probes the processor for the
+ *      features used by this library.  When calling the cpuid() function
+ *      with function_id 1, bit 25 of the ecx register will contain a 1 if
+ *      the AES-NI instructions are supported, bit 1 will contain a 1 if the
+ *      PCLMULQDQ instruction is supported, and bit 9 will contain a 1 if the
+ *      SSSE3 instructions are supported.
+ *      Source:
  *      https://www.intel.com/content/dam/doc/white-paper/advanced-encryption-standard-new-instructions-set-paper.pdf
  *
+ *      Support for the wide vector instructions is reported by cpuid()
+ *      with function_id 7 (sub-leaf 0): bit 5 of ebx indicates AVX2, bit 16
+ *      of ebx indicates AVX-512F, and bit 9 of ecx indicates VAES.  Since
+ *      the operating system must also preserve the wider registers across
+ *      context switches, the XCR0 register is checked via xgetbv when
+ *      function_id 1 reports OSXSAVE (bit 27 of ecx).
+ *
+ *      On 64-bit ARM processors, support for the AES instructions of the
+ *      ARMv8 Cryptography Extension is reported by the operating system.
+ *      Linux and Android expose it via getauxval(AT_HWCAP) (HWCAP_AES),
+ *      FreeBSD via elf_aux_info(), Apple platforms via sysctlbyname(), and
+ *      Windows via IsProcessorFeaturePresent().
+ *
+ *      The probe is performed once, when GetCPUFeatures() is first called.
+ *      The function-local static used to hold the results is initialized in
+ *      a thread-safe manner as guaranteed by the C++ standard.
+ *
  *  Portability Issues:
  *      None.
  */
 
 #include "intel_intrinsics.h"
+#include "arm_intrinsics.h"
+#include "cpu_check.h"
 
 #ifdef TERRA_USE_INTEL_INTRINSICS
 #include <cstdint>
@@ -31,6 +53,18 @@
 #endif
 #endif
 
+#ifdef TERRA_USE_ARM_INTRINSICS
+#include <cstddef>
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <sys/types.h>
+#include <sys/sysctl.h>
+#elif defined(__linux__) || defined(__FreeBSD__)
+#include <sys/auxv.h>
+#endif
+#endif
+
 namespace Terra::Crypto::Cipher
 {
 
@@ -39,36 +73,99 @@ namespace Terra::Crypto::Cipher
 // Set the feature bit representing AES (25th bit) (0x0200'0000)
 constexpr std::uint32_t Intel_AES_Bit = 0x0200'0000;
 
+// Set the feature bit representing PCLMULQDQ (1st bit) (0x0000'0002)
+constexpr std::uint32_t Intel_PCLMULQDQ_Bit = 0x0000'0002;
+
+// Set the feature bit representing SSSE3 (9th bit) (0x0000'0200)
+constexpr std::uint32_t Intel_SSSE3_Bit = 0x0000'0200;
+
+// Set the feature bit representing OSXSAVE (27th bit) (0x0800'0000)
+constexpr std::uint32_t Intel_OSXSAVE_Bit = 0x0800'0000;
+
+// Set the extended feature bit (ebx) representing AVX2 (5th bit)
+constexpr std::uint32_t Intel_AVX2_Bit = 0x0000'0020;
+
+// Set the extended feature bit (ebx) representing AVX-512F (16th bit)
+constexpr std::uint32_t Intel_AVX512F_Bit = 0x0001'0000;
+
+// Set the extended feature bit (ecx) representing VAES (9th bit)
+constexpr std::uint32_t Intel_VAES_Bit = 0x0000'0200;
+
+// XCR0 bits indicating the OS saves the SSE and AVX (YMM) state
+constexpr std::uint64_t XCR0_YMM_State = 0x06;
+
+// XCR0 bits indicating the OS also saves the AVX-512 (opmask and ZMM) state
+constexpr std::uint64_t XCR0_ZMM_State = 0xe6;
+
 #ifdef _WIN32
 
-bool CPUSupportsAES_NI()
+static std::uint32_t CPUFeatureFlags()
 {
     // Ensure we can query via cpuid
     {
         std::array<int, 4> cpu_info{};
         __cpuid(cpu_info.data(), 0);
-        if (cpu_info[0] < 1) return false;
+        if (cpu_info[0] < 1) return 0;
     }
 
     std::array<int, 4> cpu_info{};
     __cpuid(cpu_info.data(), 1);
-    return (cpu_info[2] & Intel_AES_Bit) != 0;
+    return static_cast<std::uint32_t>(cpu_info[2]);
+}
+
+static void CPUExtendedFeatureFlags(std::uint32_t &ebx, std::uint32_t &ecx)
+{
+    ebx = ecx = 0;
+
+    // Ensure we can query via cpuid with leaf value 7
+    {
+        std::array<int, 4> cpu_info{};
+        __cpuid(cpu_info.data(), 0);
+        if (cpu_info[0] < 7) return;
+    }
+
+    std::array<int, 4> cpu_info{};
+    __cpuidex(cpu_info.data(), 7, 0);
+    ebx = static_cast<std::uint32_t>(cpu_info[1]);
+    ecx = static_cast<std::uint32_t>(cpu_info[2]);
+}
+
+static std::uint64_t ReadXCR0(std::uint32_t feature_flags)
+{
+    if ((feature_flags & Intel_OSXSAVE_Bit) == 0) return 0;
+
+    return _xgetbv(0);
 }
 
 #elif defined(HAVE_CPUID)
 
-bool CPUSupportsAES_NI()
+static std::uint32_t CPUFeatureFlags()
 {
     // Ensure we can query via cpuid with leaf value 1
     {
         std::uint32_t eax{}, ebx{}, ecx{}, edx{};
         __cpuid(0, eax, ebx, ecx, edx);
-        if (eax < 1) return false;
+        if (eax < 1) return 0;
     }
 
     std::uint32_t eax{}, ebx{}, ecx{}, edx{};
     __cpuid(1, eax, ebx, ecx, edx);
-    return (ecx & Intel_AES_Bit) != 0;
+    return ecx;
+}
+
+static void CPUExtendedFeatureFlags(std::uint32_t &ebx, std::uint32_t &ecx)
+{
+    ebx = ecx = 0;
+
+    // Ensure we can query via cpuid with leaf value 7
+    {
+        std::uint32_t eax{}, ebx0{}, ecx0{}, edx{};
+        __cpuid(0, eax, ebx0, ecx0, edx);
+        if (eax < 7) return;
+    }
+
+    std::uint32_t eax{}, edx{};
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
 }
 
 #else
@@ -77,29 +174,213 @@ bool CPUSupportsAES_NI()
     __asm__ __volatile__ ("cpuid": "=a" (eax), "=b" (ebx), "=c" (ecx), \
                                    "=d" (edx) : "a" (function_id));
 
-bool CPUSupportsAES_NI()
+static std::uint32_t CPUFeatureFlags()
 {
     // Ensure we can query via cpuid with leaf value 1
     {
         std::uint32_t eax{}, ebx{}, ecx{}, edx{};
         cpuid(0, eax, ebx, ecx, edx);
-        if (eax < 1) return false;
+        if (eax < 1) return 0;
     }
 
     std::uint32_t eax{}, ebx{}, ecx{}, edx{};
     cpuid(1, eax, ebx, ecx, edx);
-    return (ecx & Intel_AES_Bit) != 0;
+    return ecx;
+}
+
+static void CPUExtendedFeatureFlags(std::uint32_t &ebx, std::uint32_t &ecx)
+{
+    ebx = ecx = 0;
+
+    // Ensure we can query via cpuid with leaf value 7
+    {
+        std::uint32_t eax{}, ebx0{}, ecx0{}, edx{};
+        cpuid(0, eax, ebx0, ecx0, edx);
+        if (eax < 7) return;
+    }
+
+    std::uint32_t eax{}, edx{};
+    __asm__ __volatile__ ("cpuid": "=a" (eax), "=b" (ebx), "=c" (ecx),
+                                   "=d" (edx) : "a" (7), "c" (0));
+}
+
+#endif // _WIN32
+
+#ifndef _WIN32
+
+static std::uint64_t ReadXCR0(std::uint32_t feature_flags)
+{
+    if ((feature_flags & Intel_OSXSAVE_Bit) == 0) return 0;
+
+    std::uint32_t eax{}, edx{};
+    __asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+    return (static_cast<std::uint64_t>(edx) << 32) | eax;
 }
 
 #endif // _WIN32
 
+/*
+ *  ProbeIntelFeatures()
+ *
+ *  Description:
+ *      Query the Intel processor for the features used by this library.
+ *
+ *  Parameters:
+ *      features [out]
+ *          The structure into which the Intel features are stored.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+static void ProbeIntelFeatures(CPUFeatures &features)
+{
+    std::uint32_t ebx{}, ecx{};
+
+    const std::uint32_t feature_flags = CPUFeatureFlags();
+    const std::uint64_t xcr0 = ReadXCR0(feature_flags);
+
+    CPUExtendedFeatureFlags(ebx, ecx);
+
+    features.aes_ni = (feature_flags & Intel_AES_Bit) != 0;
+    features.pclmulqdq = (feature_flags & Intel_PCLMULQDQ_Bit) != 0;
+    features.ssse3 = (feature_flags & Intel_SSSE3_Bit) != 0;
+    features.avx2 = ((ebx & Intel_AVX2_Bit) != 0) &&
+                    ((xcr0 & XCR0_YMM_State) == XCR0_YMM_State);
+    features.vaes = features.avx2 && ((ecx & Intel_VAES_Bit) != 0);
+    features.avx512f = ((ebx & Intel_AVX512F_Bit) != 0) &&
+                       ((xcr0 & XCR0_ZMM_State) == XCR0_ZMM_State);
+}
+
 #else // TERRA_USE_INTEL_INTRINSICS
 
-bool CPUSupportsAES_NI()
+static void ProbeIntelFeatures(CPUFeatures &)
 {
-    return false;
+    // Nothing to do
 }
 
 #endif // TERRA_USE_INTEL_INTRINSICS
 
+#ifdef TERRA_USE_ARM_INTRINSICS
+
+#if defined(__linux__) || defined(__FreeBSD__)
+
+// Set the AT_HWCAP bit representing the AES instructions (3rd bit)
+constexpr unsigned long ARM_HWCAP_AES_Bit = 0x0000'0008;
+
+#endif
+
+#if defined(__APPLE__)
+
+/*
+ *  AppleFeature()
+ *
+ *  Description:
+ *      Query the named processor feature via sysctlbyname().
+ *
+ *  Parameters:
+ *      name [in]
+ *          The sysctl name of the feature (e.g., "hw.optional.arm.FEAT_AES").
+ *
+ *  Returns:
+ *      True if the feature is present, false otherwise.
+ *
+ *  Comments:
+ *      Every 64-bit Apple processor implements the cryptography extension,
+ *      so support is assumed if the sysctl name is unknown (as on releases
+ *      prior to macOS 12).
+ */
+static bool AppleFeature(const char *name)
+{
+    int value{};
+    std::size_t length = sizeof(value);
+
+    if (sysctlbyname(name, &value, &length, nullptr, 0)) return true;
+
+    return value != 0;
+}
+
+#endif
+
+/*
+ *  ProbeARMFeatures()
+ *
+ *  Description:
+ *      Query the ARM processor (via the operating system) for the features
+ *      used by this library.
+ *
+ *  Parameters:
+ *      features [out]
+ *          The structure into which the ARM features are stored.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+static void ProbeARMFeatures(CPUFeatures &features)
+{
+#if defined(_WIN32)
+    features.arm_aes = IsProcessorFeaturePresent(
+                           PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined(__APPLE__)
+    features.arm_aes = AppleFeature("hw.optional.arm.FEAT_AES");
+#elif defined(__linux__)
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+
+    features.arm_aes = (hwcap & ARM_HWCAP_AES_Bit) != 0;
+#elif defined(__FreeBSD__)
+    unsigned long hwcap{};
+
+    if (elf_aux_info(AT_HWCAP, &hwcap, sizeof(hwcap))) return;
+
+    features.arm_aes = (hwcap & ARM_HWCAP_AES_Bit) != 0;
+#else
+    static_cast<void>(features);
+#endif
+}
+
+#else // TERRA_USE_ARM_INTRINSICS
+
+static void ProbeARMFeatures(CPUFeatures &)
+{
+    // Nothing to do
+}
+
+#endif // TERRA_USE_ARM_INTRINSICS
+
+/*
+ *  GetCPUFeatures()
+ *
+ *  Description:
+ *      Return the processor features used by this library.  The processor
+ *      is probed the first time this function is called.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the structure holding the processor features.
+ *
+ *  Comments:
+ *      None.
+ */
+const CPUFeatures &GetCPUFeatures() noexcept
+{
+    static const CPUFeatures features = []()
+    {
+        CPUFeatures result{};
+
+        ProbeIntelFeatures(result);
+        ProbeARMFeatures(result);
+
+        return result;
+    }();
+
+    return features;
+}
+
 } // namespace Terra::Crypto::Cipher
@@ -1,7 +1,7 @@
 /*
- *  cpu_check.cpp
+ *  cpu_check.h
  *
- *  Copyright (C) 2024, 2025
+ *  Copyright (C) 2024, 2025, 2026
  *  Terrapane Corporation
  *  All Rights Reserved
  *
@@ -9,8 +9,19 @@
  *      Paul E. Jones <paulej@packetizer.com>
  *
  *  Description:
- *      This module declares a function that will verify that the Intel
- *      processor supports the AES-NI instructions.
+ *      This module declares a function that reports which of the processor
+ *      features used by this library are present: the Intel AES-NI,
+ *      PCLMULQDQ, SSSE3, AVX2, and VAES instructions and AVX-512F registers,
+ *      and the ARMv8 AES instructions.
+ *
+ *      The processor is probed only once, the first time the features are
+ *      requested, and the results are retained for the life of the process.
+ *      This avoids repeatedly executing cpuid (a serializing instruction
+ *      that also causes a VM exit under virtualization) or querying the
+ *      operating system when AES objects are constructed.
+ *
+ *      The CPUSupports*() functions are provided for convenience and simply
+ *      return the corresponding member of the feature structure.
  *
  *  Portability Issues:
  *      None.
@@ -21,6 +32,53 @@
 namespace Terra::Crypto::Cipher
 {
 
-bool CPUSupportsAES_NI();
+// Processor features used by the AES engines and modes
+struct CPUFeatures
+{
+    bool aes_ni;                                // Intel AES-NI
+    bool pclmulqdq;                             // Intel PCLMULQDQ
+    bool ssse3;                                 // Intel SSSE3
+    bool avx2;                                  // AVX2 with OS support
+    bool vaes;                                  // VAES with AVX2
+    bool avx512f;                               // AVX-512F with OS support
+    bool arm_aes;                               // ARMv8 AES
+};
+
+const CPUFeatures &GetCPUFeatures() noexcept;
+
+inline bool CPUSupportsAES_NI() noexcept
+{
+    return GetCPUFeatures().aes_ni;
+}
+
+inline bool CPUSupportsPCLMULQDQ() noexcept
+{
+    return GetCPUFeatures().pclmulqdq;
+}
+
+inline bool CPUSupportsSSSE3() noexcept
+{
+    return GetCPUFeatures().ssse3;
+}
+
+inline bool CPUSupportsAVX2() noexcept
+{
+    return GetCPUFeatures().avx2;
+}
+
+inline bool CPUSupportsVAES() noexcept
+{
+    return GetCPUFeatures().vaes;
+}
+
+inline bool CPUSupportsAVX512F() noexcept
+{
+    return GetCPUFeatures().avx512f;
+}
+
+inline bool CPUSupportsARM_AES() noexcept
+{
+    return GetCPUFeatures().arm_aes;
+}
 
 } // namespace Terra::Crypto::Cipher
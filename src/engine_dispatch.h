@@ -0,0 +1,147 @@
+/*
+ *  engine_dispatch.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines functions used by objects that construct an AES
+ *      engine within storage they own, rather than allocating it on the
+ *      heap, and that call the engine's member functions without virtual
+ *      dispatch by switching on the engine type.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <terra/crypto/cipher/aes.h>
+#include "aes_universal.h"
+#include "aes_intel.h"
+#include "aes_intel_vaes.h"
+#include "aes_arm.h"
+#include "aes_vector_permute.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+/*
+ *  StoredEngine()
+ *
+ *  Description:
+ *      Return a reference to the engine of the given type that resides in
+ *      the given storage.
+ *
+ *  Parameters:
+ *      storage [in]
+ *          The storage holding the engine.
+ *
+ *  Returns:
+ *      A reference to the engine.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename T, typename Storage>
+auto &StoredEngine(Storage *storage) noexcept
+{
+    using Engine = std::conditional_t<std::is_const_v<Storage>, const T, T>;
+
+    return *std::launder(reinterpret_cast<Engine *>(storage));
+}
+
+/*
+ *  Dispatch()
+ *
+ *  Description:
+ *      Call the given function with a reference to the engine held in the
+ *      storage, cast to its actual type.
+ *
+ *  Parameters:
+ *      engine_type [in]
+ *          The type of engine held in the storage.
+ *
+ *      storage [in]
+ *          The storage holding the engine.
+ *
+ *      function [in]
+ *          The function to call, which will be given the engine.
+ *
+ *  Returns:
+ *      The value returned by the function.
+ *
+ *  Comments:
+ *      Since the function receives the engine as its actual type, it may
+ *      call the engine's member functions with a qualified name so that no
+ *      virtual call is made (see the DISPATCH macro in aes_inline.cpp).  The
+ *      universal engine is assumed for any unexpected engine type, though
+ *      that cannot happen as the engine is always one of those constructed
+ *      via TryEngine() or as the fallback.
+ */
+template<typename Storage, typename Function>
+decltype(auto) Dispatch(AESEngineType engine_type,
+                        Storage *storage,
+                        Function &&function)
+{
+    switch (engine_type)
+    {
+        case AESEngineType::IntelVAES:
+            return function(StoredEngine<AESIntelVAES>(storage));
+
+        case AESEngineType::Intel:
+            return function(StoredEngine<AESIntel>(storage));
+
+        case AESEngineType::ARM:
+            return function(StoredEngine<AESARM>(storage));
+
+        case AESEngineType::VectorPermute:
+            return function(StoredEngine<AESVectorPermute>(storage));
+
+        default:
+            return function(StoredEngine<AESUniversal>(storage));
+    }
+}
+
+/*
+ *  TryEngine()
+ *
+ *  Description:
+ *      Construct the engine of the given type in the given storage if that
+ *      engine can be used on this processor.
+ *
+ *  Parameters:
+ *      storage [in]
+ *          The storage in which to construct the engine.
+ *
+ *      engine_type [out]
+ *          The type of engine constructed, if successful.
+ *
+ *  Returns:
+ *      True if the engine was constructed, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename T>
+bool TryEngine(std::uint8_t *storage, AESEngineType &engine_type) noexcept
+{
+    T *engine = new (storage) T();
+
+    engine_type = engine->T::GetEngineType();
+
+    if (engine_type != AESEngineType::Unavailable) return true;
+
+    engine->~T();
+
+    return false;
+}
+
+} // namespace Terra::Crypto::Cipher
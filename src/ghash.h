@@ -0,0 +1,57 @@
+/*
+ *  ghash.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the GHASHEngine interface that is implemented by
+ *      the various GHASH engines used by the AESGCM object.  GHASH is the
+ *      universal hash function defined in NIST Special Publication 800-38D
+ *      Section 6.4 that operates on 128-bit blocks over GF(2^128).
+ *
+ *      Data passed to Update() is processed as a series of 128-bit blocks.
+ *      If the length of the data is not an integral number of blocks, the
+ *      final partial block is padded with zeros.  Thus, only the last call
+ *      to Update() for a given input string (e.g., the additional
+ *      authenticated data or the ciphertext) may contain a partial block.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+namespace Terra::Crypto::Cipher
+{
+
+// Define the GHASHEngine interface
+class GHASHEngine
+{
+    public:
+        // GHASH operates on 128-bit blocks
+        static constexpr std::size_t GHASH_Block_Size{16};
+
+        virtual ~GHASHEngine() = default;
+
+        virtual void SetKey(const std::span<const std::uint8_t, 16> H)
+            noexcept = 0;
+
+        virtual void Reset() noexcept = 0;
+
+        virtual void Update(const std::span<const std::uint8_t> data)
+            noexcept = 0;
+
+        virtual void GetDigest(std::span<std::uint8_t, 16> digest)
+            const noexcept = 0;
+};
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,394 @@
+/*
+ *  ghash_intel.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This is the implementation file for the GHASHIntel object that
+ *      implements the GHASH function defined in NIST Special Publication
+ *      800-38D using the PCLMULQDQ instruction.
+ *
+ *      Blocks are byte reversed when loaded so that the bit-reflected
+ *      polynomial representation used by GCM maps onto the carry-less
+ *      multiplication instruction.  The 256-bit product is then shifted left
+ *      by one bit and reduced modulo x^128 + x^7 + x^2 + x + 1 as described
+ *      in the Intel white paper (Algorithm 5).
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include "intel_intrinsics.h"
+
+// Do not attempt to compile unless told to use Intel Intrinsics
+#ifdef TERRA_USE_INTEL_INTRINSICS
+
+#include <algorithm>
+#include <terra/secutil/secure_erase.h>
+#include "ghash_intel.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+namespace
+{
+
+/*
+ *  ByteReverse()
+ *
+ *  Description:
+ *      Reverse the order of the sixteen octets in the given value.  This
+ *      uses only SSE2 instructions so that SSSE3 is not required.
+ *
+ *  Parameters:
+ *      x [in]
+ *          The value to reverse.
+ *
+ *  Returns:
+ *      The byte-reversed value.
+ *
+ *  Comments:
+ *      None.
+ */
+inline __m128i ByteReverse(__m128i x) noexcept
+{
+    x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+    x = _mm_shufflelo_epi16(x, 0x1b);
+    x = _mm_shufflehi_epi16(x, 0x1b);
+    return _mm_shuffle_epi32(x, 0x4e);
+}
+
+/*
+ *  MultiplyAccumulate()
+ *
+ *  Description:
+ *      Multiply a and b (carry-less) and add the unreduced 256-bit product
+ *      to the accumulators lo, mid, and hi.
+ *
+ *  Parameters:
+ *      a [in]
+ *          The first multiplicand.
+ *
+ *      b [in]
+ *          The second multiplicand.
+ *
+ *      lo [in/out]
+ *          Accumulator for the product of the low 64-bit halves.
+ *
+ *      mid [in/out]
+ *          Accumulator for the cross products.
+ *
+ *      hi [in/out]
+ *          Accumulator for the product of the high 64-bit halves.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Since reduction is linear, several products may be accumulated and
+ *      then reduced once via Reduce().
+ */
+inline void MultiplyAccumulate(const __m128i a,
+                               const __m128i b,
+                               __m128i &lo,
+                               __m128i &mid,
+                               __m128i &hi) noexcept
+{
+    lo = _mm_xor_si128(lo, _mm_clmulepi64_si128(a, b, 0x00));
+    hi = _mm_xor_si128(hi, _mm_clmulepi64_si128(a, b, 0x11));
+    mid = _mm_xor_si128(mid, _mm_clmulepi64_si128(a, b, 0x10));
+    mid = _mm_xor_si128(mid, _mm_clmulepi64_si128(a, b, 0x01));
+}
+
+/*
+ *  Reduce()
+ *
+ *  Description:
+ *      Reduce the accumulated 256-bit product modulo the GCM polynomial.
+ *
+ *  Parameters:
+ *      lo [in]
+ *          Accumulated product of the low 64-bit halves.
+ *
+ *      mid [in]
+ *          Accumulated cross products.
+ *
+ *      hi [in]
+ *          Accumulated product of the high 64-bit halves.
+ *
+ *  Returns:
+ *      The reduced 128-bit value.
+ *
+ *  Comments:
+ *      None.
+ */
+inline __m128i Reduce(__m128i lo, __m128i mid, __m128i hi) noexcept
+{
+    __m128i t1, t2, t3;
+
+    // Fold the cross products into the low and high halves
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    // Shift the 256-bit value hi:lo left by one bit
+    t1 = _mm_srli_epi32(lo, 31);
+    t2 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    t3 = _mm_srli_si128(t1, 12);
+    t2 = _mm_slli_si128(t2, 4);
+    t1 = _mm_slli_si128(t1, 4);
+    lo = _mm_or_si128(lo, t1);
+    hi = _mm_or_si128(hi, t2);
+    hi = _mm_or_si128(hi, t3);
+
+    // First phase of the reduction
+    t1 = _mm_slli_epi32(lo, 31);
+    t2 = _mm_slli_epi32(lo, 30);
+    t3 = _mm_slli_epi32(lo, 25);
+    t1 = _mm_xor_si128(t1, t2);
+    t1 = _mm_xor_si128(t1, t3);
+    t2 = _mm_srli_si128(t1, 4);
+    t1 = _mm_slli_si128(t1, 12);
+    lo = _mm_xor_si128(lo, t1);
+
+    // Second phase of the reduction
+    t1 = _mm_srli_epi32(lo, 1);
+    t3 = _mm_srli_epi32(lo, 2);
+    t1 = _mm_xor_si128(t1, t3);
+    t3 = _mm_srli_epi32(lo, 7);
+    t1 = _mm_xor_si128(t1, t3);
+    t1 = _mm_xor_si128(t1, t2);
+    lo = _mm_xor_si128(lo, t1);
+
+    return _mm_xor_si128(hi, lo);
+}
+
+} // namespace
+
+/*
+ *  GHASHIntel::GHASHIntel()
+ *
+ *  Description:
+ *      This is the constructor for the GHASHIntel object.  One must call
+ *      SetKey() before calling Update(), as the results will otherwise be
+ *      invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+GHASHIntel::GHASHIntel() noexcept : HP{}, X{}
+{
+    // Nothing more to do
+}
+
+/*
+ *  GHASHIntel::~GHASHIntel()
+ *
+ *  Description:
+ *      This is the destructor for the GHASHIntel object and is responsible
+ *      for zeroing memory to ensure a clean termination with no residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+GHASHIntel::~GHASHIntel()
+{
+    SecUtil::SecureErase(HP, sizeof(HP));
+    SecUtil::SecureErase(&X, sizeof(X));
+}
+
+/*
+ *  GHASHIntel::SetKey()
+ *
+ *  Description:
+ *      This function will set the hash subkey H and compute the powers
+ *      H^2 through H^8 used for aggregated reduction.  The hash value is
+ *      also reset.
+ *
+ *  Parameters:
+ *      H [in]
+ *          The hash subkey (i.e., the encryption of the zero block).
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void GHASHIntel::SetKey(const std::span<const std::uint8_t, 16> H) noexcept
+{
+    HP[0] = ByteReverse(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(H.data())));
+
+    for (std::size_t i = 1; i < Aggregated_Blocks; i++)
+    {
+        __m128i lo = _mm_setzero_si128();
+        __m128i mid = _mm_setzero_si128();
+        __m128i hi = _mm_setzero_si128();
+
+        MultiplyAccumulate(HP[i - 1], HP[0], lo, mid, hi);
+        HP[i] = Reduce(lo, mid, hi);
+    }
+
+    Reset();
+}
+
+/*
+ *  GHASHIntel::Reset()
+ *
+ *  Description:
+ *      This function will reset the hash value to zero so that a new hash
+ *      computation may begin using the same hash subkey.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void GHASHIntel::Reset() noexcept
+{
+    X = _mm_setzero_si128();
+}
+
+/*
+ *  GHASHIntel::Update()
+ *
+ *  Description:
+ *      This function will add the given data to the hash computation.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to hash.  If this is not an integral number of 16-octet
+ *          blocks, the final block is padded with zeros.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Eight blocks at a time are multiplied by H^8 through H^1,
+ *      respectively, and summed before a single reduction, which is
+ *      equivalent to eight iterations of X = (X ^ C) * H.
+ */
+void GHASHIntel::Update(const std::span<const std::uint8_t> data) noexcept
+{
+    const __m128i *p = reinterpret_cast<const __m128i *>(data.data());
+    std::size_t blocks = data.size() / GHASH_Block_Size;
+    __m128i lo, mid, hi;
+
+    // Process eight blocks per reduction
+    for (; blocks >= Aggregated_Blocks; blocks -= Aggregated_Blocks)
+    {
+        lo = _mm_setzero_si128();
+        mid = _mm_setzero_si128();
+        hi = _mm_setzero_si128();
+
+        MultiplyAccumulate(_mm_xor_si128(X, ByteReverse(_mm_loadu_si128(p))),
+                           HP[7],
+                           lo,
+                           mid,
+                           hi);
+        for (std::size_t i = 1; i < Aggregated_Blocks; i++)
+        {
+            MultiplyAccumulate(ByteReverse(_mm_loadu_si128(p + i)),
+                               HP[Aggregated_Blocks - 1 - i],
+                               lo,
+                               mid,
+                               hi);
+        }
+
+        X = Reduce(lo, mid, hi);
+        p += Aggregated_Blocks;
+    }
+
+    // Process any remaining complete blocks one at a time
+    for (; blocks > 0; blocks--, p++)
+    {
+        lo = _mm_setzero_si128();
+        mid = _mm_setzero_si128();
+        hi = _mm_setzero_si128();
+
+        MultiplyAccumulate(_mm_xor_si128(X, ByteReverse(_mm_loadu_si128(p))),
+                           HP[0],
+                           lo,
+                           mid,
+                           hi);
+
+        X = Reduce(lo, mid, hi);
+    }
+
+    // Process any remaining partial block padded with zeros
+    if ((data.size() % GHASH_Block_Size) != 0)
+    {
+        alignas(16) std::uint8_t block[GHASH_Block_Size]{};
+
+        std::copy(data.begin() + (data.size() & ~(GHASH_Block_Size - 1)),
+                  data.end(),
+                  block);
+
+        lo = _mm_setzero_si128();
+        mid = _mm_setzero_si128();
+        hi = _mm_setzero_si128();
+
+        MultiplyAccumulate(
+            _mm_xor_si128(
+                X,
+                ByteReverse(_mm_load_si128(
+                    reinterpret_cast<const __m128i *>(block)))),
+            HP[0],
+            lo,
+            mid,
+            hi);
+
+        X = Reduce(lo, mid, hi);
+
+        SecUtil::SecureErase(block, sizeof(block));
+    }
+}
+
+/*
+ *  GHASHIntel::GetDigest()
+ *
+ *  Description:
+ *      This function will return the current hash value.
+ *
+ *  Parameters:
+ *      digest [out]
+ *          The buffer into which the hash value is written.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void GHASHIntel::GetDigest(std::span<std::uint8_t, 16> digest) const noexcept
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(digest.data()),
+                     ByteReverse(X));
+}
+
+} // namespace Terra::Crypto::Cipher
+
+#endif // TERRA_USE_INTEL_INTRINSICS
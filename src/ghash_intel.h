@@ -0,0 +1,84 @@
+/*
+ *  ghash_intel.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the GHASHIntel object that implements the GHASH
+ *      function defined in NIST Special Publication 800-38D using the
+ *      Intel carry-less multiplication (PCLMULQDQ) instruction.
+ *
+ *      Reference document:
+ *      https://www.intel.com/content/dam/develop/external/us/en/documents/clmul-wp-rev-2-02-2014-04-20.pdf
+ *
+ *      Eight blocks are processed per iteration using the aggregated
+ *      reduction method described in that paper: the powers H^1 through H^8
+ *      are computed when the key is set, the eight products are summed, and
+ *      only a single reduction is performed per eight blocks.
+ *
+ *      Note that if one attempts to use this engine on a processor that
+ *      does not support the PCLMULQDQ instruction it will not work and will
+ *      likely cause a core dump.  One should call CPUSupportsPCLMULQDQ()
+ *      before creating this object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include "intel_intrinsics.h"
+#include "ghash.h"
+#include "ghash_universal.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+#ifdef TERRA_USE_INTEL_INTRINSICS
+
+// Define the GHASHIntel class
+class GHASHIntel : public GHASHEngine
+{
+    public:
+        // Number of blocks processed per reduction
+        static constexpr std::size_t Aggregated_Blocks{8};
+
+        GHASHIntel() noexcept;
+        ~GHASHIntel();
+
+        void SetKey(const std::span<const std::uint8_t, 16> H) noexcept
+            override;
+
+        void Reset() noexcept override;
+
+        void Update(const std::span<const std::uint8_t> data) noexcept
+            override;
+
+        void GetDigest(std::span<std::uint8_t, 16> digest) const noexcept
+            override;
+
+    protected:
+        // Powers of the hash subkey (H^1 at index 0), byte reversed
+        __m128i HP[Aggregated_Blocks];
+
+        // Current hash value, byte reversed
+        __m128i X;
+};
+
+#else // TERRA_USE_INTEL_INTRINSICS
+
+// If building without Intel Intrinsics, alias this engine to the universal one
+
+using GHASHIntel = GHASHUniversal;
+
+#endif // TERRA_USE_INTEL_INTRINSICS
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,287 @@
+/*
+ *  ghash_universal.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This is the implementation file for the GHASHUniversal object that
+ *      implements the GHASH function defined in NIST Special Publication
+ *      800-38D using 4-bit multiplication tables.
+ *
+ *      Multiplication by H processes the 128-bit input four bits at a time,
+ *      starting with the last (i.e., least significant in GCM's reflected
+ *      bit ordering) nibble.  After each nibble, the accumulated value is
+ *      divided by x^4 and any bits shifted out are reduced modulo the GCM
+ *      polynomial using a small (16 entry) reduction table.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <terra/secutil/secure_erase.h>
+#include "ghash_universal.h"
+#include "mode_utilities.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+namespace
+{
+
+// Reduction values for the four bits shifted out of the low end of the value
+constexpr std::array<std::uint64_t, 16> Reduction_Table =
+{
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+} // namespace
+
+/*
+ *  GHASHUniversal::GHASHUniversal()
+ *
+ *  Description:
+ *      This is the constructor for the GHASHUniversal object.  One must call
+ *      SetKey() before calling Update(), as the results will otherwise be
+ *      invalid.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+GHASHUniversal::GHASHUniversal() noexcept : HH{}, HL{}, ZH{}, ZL{}
+{
+    // Nothing more to do
+}
+
+/*
+ *  GHASHUniversal::~GHASHUniversal()
+ *
+ *  Description:
+ *      This is the destructor for the GHASHUniversal object and is
+ *      responsible for zeroing memory to ensure a clean termination with no
+ *      residue.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+GHASHUniversal::~GHASHUniversal()
+{
+    SecUtil::SecureErase(&HH, sizeof(HH));
+    SecUtil::SecureErase(&HL, sizeof(HL));
+    SecUtil::SecureErase(&ZH, sizeof(ZH));
+    SecUtil::SecureErase(&ZL, sizeof(ZL));
+}
+
+/*
+ *  GHASHUniversal::SetKey()
+ *
+ *  Description:
+ *      This function will set the hash subkey H and compute the table of
+ *      multiples of H used by MultiplyH().  The hash value is also reset.
+ *
+ *  Parameters:
+ *      H [in]
+ *          The hash subkey (i.e., the encryption of the zero block).
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Entry 8 of the table holds H, entry 4 holds H*x, entry 2 holds H*x^2,
+ *      and entry 1 holds H*x^3 (due to GCM's reflected bit ordering).  The
+ *      remaining entries are formed by adding (XOR) those values.
+ */
+void GHASHUniversal::SetKey(const std::span<const std::uint8_t, 16> H) noexcept
+{
+    std::uint64_t vh = LoadBigEndian64(H.data());
+    std::uint64_t vl = LoadBigEndian64(H.data() + 8);
+
+    HH[0] = 0;
+    HL[0] = 0;
+    HH[8] = vh;
+    HL[8] = vl;
+
+    // Multiply by x for entries 4, 2, and 1
+    for (std::size_t i = 4; i > 0; i >>= 1)
+    {
+        std::uint64_t t = (vl & 1) * 0xe100'0000'0000'0000;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ t;
+        HH[i] = vh;
+        HL[i] = vl;
+    }
+
+    // Form the remaining entries as sums of the above
+    for (std::size_t i = 2; i <= 8; i <<= 1)
+    {
+        for (std::size_t j = 1; j < i; j++)
+        {
+            HH[i + j] = HH[i] ^ HH[j];
+            HL[i + j] = HL[i] ^ HL[j];
+        }
+    }
+
+    SecUtil::SecureErase(&vh, sizeof(vh));
+    SecUtil::SecureErase(&vl, sizeof(vl));
+
+    Reset();
+}
+
+/*
+ *  GHASHUniversal::Reset()
+ *
+ *  Description:
+ *      This function will reset the hash value to zero so that a new hash
+ *      computation may begin using the same hash subkey.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void GHASHUniversal::Reset() noexcept
+{
+    ZH = 0;
+    ZL = 0;
+}
+
+/*
+ *  GHASHUniversal::Update()
+ *
+ *  Description:
+ *      This function will add the given data to the hash computation.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to hash.  If this is not an integral number of 16-octet
+ *          blocks, the final block is padded with zeros.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void GHASHUniversal::Update(const std::span<const std::uint8_t> data) noexcept
+{
+    std::size_t offset{};
+
+    // Process all complete blocks
+    for (; data.size() - offset >= GHASH_Block_Size; offset += GHASH_Block_Size)
+    {
+        ZH ^= LoadBigEndian64(data.data() + offset);
+        ZL ^= LoadBigEndian64(data.data() + offset + 8);
+        MultiplyH();
+    }
+
+    // Process any remaining partial block padded with zeros
+    if (offset < data.size())
+    {
+        std::array<std::uint8_t, GHASH_Block_Size> block{};
+
+        std::copy(data.begin() + offset, data.end(), block.begin());
+        ZH ^= LoadBigEndian64(block.data());
+        ZL ^= LoadBigEndian64(block.data() + 8);
+        MultiplyH();
+
+        SecUtil::SecureErase(&block, sizeof(block));
+    }
+}
+
+/*
+ *  GHASHUniversal::GetDigest()
+ *
+ *  Description:
+ *      This function will return the current hash value.
+ *
+ *  Parameters:
+ *      digest [out]
+ *          The buffer into which the hash value is written.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void GHASHUniversal::GetDigest(std::span<std::uint8_t, 16> digest)
+    const noexcept
+{
+    StoreBigEndian64(ZH, digest.data());
+    StoreBigEndian64(ZL, digest.data() + 8);
+}
+
+/*
+ *  GHASHUniversal::MultiplyH()
+ *
+ *  Description:
+ *      This function will multiply the current hash value by H in GF(2^128).
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void GHASHUniversal::MultiplyH() noexcept
+{
+    std::array<std::uint8_t, GHASH_Block_Size> x;
+    std::uint64_t zh{};
+    std::uint64_t zl{};
+    std::uint8_t remainder{};
+
+    StoreBigEndian64(ZH, x.data());
+    StoreBigEndian64(ZL, x.data() + 8);
+
+    for (std::size_t i = x.size(); i > 0; i--)
+    {
+        // Divide by x^4 (except initially) and add the low nibble multiple
+        if (i != x.size())
+        {
+            remainder = static_cast<std::uint8_t>(zl & 0x0f);
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (Reduction_Table[remainder] << 48);
+        }
+        zh ^= HH[x[i - 1] & 0x0f];
+        zl ^= HL[x[i - 1] & 0x0f];
+
+        // Divide by x^4 and add the high nibble multiple
+        remainder = static_cast<std::uint8_t>(zl & 0x0f);
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (Reduction_Table[remainder] << 48);
+        zh ^= HH[x[i - 1] >> 4];
+        zl ^= HL[x[i - 1] >> 4];
+    }
+
+    ZH = zh;
+    ZL = zl;
+
+    SecUtil::SecureErase(&x, sizeof(x));
+}
+
+} // namespace Terra::Crypto::Cipher
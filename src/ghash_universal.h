@@ -0,0 +1,69 @@
+/*
+ *  ghash_universal.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the GHASHUniversal object that implements the GHASH
+ *      function defined in NIST Special Publication 800-38D using a table
+ *      of sixteen precomputed multiples of the hash subkey H (i.e., the
+ *      "4-bit tables" method described by Shoup and in Section 4.1 of
+ *      McGrew and Viega's "The Galois/Counter Mode of Operation (GCM)").
+ *
+ *      This implementation of GHASH is called "universal" as it can operate
+ *      on any processor and is not dependent on processor-specific
+ *      instructions.
+ *
+ *  Portability Issues:
+ *      Table lookups are indexed by data-dependent values, so this engine
+ *      may leak timing information via the processor cache.  The GHASHIntel
+ *      engine should be preferred when available.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <array>
+#include "ghash.h"
+
+namespace Terra::Crypto::Cipher
+{
+
+// Define the GHASHUniversal class
+class GHASHUniversal : public GHASHEngine
+{
+    public:
+        GHASHUniversal() noexcept;
+        ~GHASHUniversal();
+
+        void SetKey(const std::span<const std::uint8_t, 16> H) noexcept
+            override;
+
+        void Reset() noexcept override;
+
+        void Update(const std::span<const std::uint8_t> data) noexcept
+            override;
+
+        void GetDigest(std::span<std::uint8_t, 16> digest) const noexcept
+            override;
+
+    protected:
+        void MultiplyH() noexcept;
+
+        // Multiples of H (high and low 64 bits) indexed by a 4-bit value
+        std::array<std::uint64_t, 16> HH;
+        std::array<std::uint64_t, 16> HL;
+
+        // The current hash value as a pair of 64-bit big endian values
+        std::uint64_t ZH;
+        std::uint64_t ZL;
+};
+
+} // namespace Terra::Crypto::Cipher
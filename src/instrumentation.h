@@ -0,0 +1,91 @@
+/*
+ *  instrumentation.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the RecordAESEvent() function that the library
+ *      calls to count the work performed, as reported via the functions
+ *      in aes_instrumentation.h.  Unless TERRA_ENABLE_AES_INSTRUMENTATION is
+ *      defined, RecordAESEvent() is empty and the engine type is never
+ *      queried, so calls have no cost.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <terra/crypto/cipher/aes_instrumentation.h>
+
+namespace Terra::Crypto::Cipher
+{
+
+#ifdef TERRA_ENABLE_AES_INSTRUMENTATION
+
+// Number of counters maintained per engine
+constexpr std::size_t AES_Counter_Count{8};
+
+// Counters for one engine, each occupying its own cache line
+struct alignas(64) AESEngineCounterSet
+{
+    std::atomic<std::uint64_t> counters[AES_Counter_Count];
+};
+
+extern AESEngineCounterSet AES_Engine_Counters[AES_Engine_Type_Count];
+extern std::atomic<AESInstrumentationHook> AES_Instrumentation_Hook;
+
+#endif
+
+/*
+ *  RecordAESEvent()
+ *
+ *  Description:
+ *      Add the given count to the counter for the engine used by the given
+ *      object and call the instrumentation hook, if one is set.
+ *
+ *  Parameters:
+ *      source [in]
+ *          The object performing the operation, which must provide the
+ *          GetEngineType() function.
+ *
+ *      counter [in]
+ *          The counter to increment.
+ *
+ *      count [in]
+ *          The amount by which to increment the counter.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename T>
+inline void RecordAESEvent([[maybe_unused]] const T &source,
+                           [[maybe_unused]] AESCounter counter,
+                           [[maybe_unused]] std::uint64_t count = 1) noexcept
+{
+#ifdef TERRA_ENABLE_AES_INSTRUMENTATION
+    const AESEngineType engine_type = source.GetEngineType();
+
+    AES_Engine_Counters[static_cast<std::size_t>(engine_type)]
+        .counters[static_cast<std::size_t>(counter)]
+        .fetch_add(count, std::memory_order_relaxed);
+
+    AESInstrumentationHook hook =
+        AES_Instrumentation_Hook.load(std::memory_order_relaxed);
+
+    if (hook != nullptr) hook(engine_type, counter, count);
+#endif
+}
+
+} // namespace Terra::Crypto::Cipher
@@ -0,0 +1,499 @@
+/*
+ *  mode_utilities.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This header file defines some functions that are common to the
+ *      various block cipher modes of operation, such as combining buffers
+ *      via XOR, incrementing counter blocks, doubling blocks in GF(2^128),
+ *      and reading and writing big and little endian integers.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <array>
+#include <bit>
+#include <terra/bitutil/byte_order.h>
+#include "intel_intrinsics.h"
+
+namespace
+{
+
+/*
+ *  XorBuffers
+ *
+ *  Description:
+ *      This function will XOR two buffers of the given length, placing the
+ *      result in the output buffer.  Data is processed 128 bits at a time
+ *      when Intel Intrinsics are available and 64 bits at a time otherwise.
+ *
+ *  Parameters:
+ *      a [in]
+ *          The first buffer to XOR.
+ *
+ *      b [in]
+ *          The second buffer to XOR.
+ *
+ *      output [out]
+ *          The buffer into which the result is written.  This may be the same
+ *          memory location as either input buffer.
+ *
+ *      length [in]
+ *          The number of octets to process.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      std::memcpy() is used to load and store 64-bit words so that there are
+ *      no alignment requirements; compilers reduce these to plain loads and
+ *      stores.  Writing whole blocks also allows a subsequent 128-bit load of
+ *      the output (e.g., by GHASH) to be forwarded from the store buffer.
+ */
+inline void XorBuffers(const std::uint8_t *a,
+                       const std::uint8_t *b,
+                       std::uint8_t *output,
+                       std::size_t length) noexcept
+{
+    std::uint64_t x{};
+    std::uint64_t y{};
+
+#ifdef TERRA_USE_INTEL_INTRINSICS
+    for (; length >= 16; length -= 16, a += 16, b += 16, output += 16)
+    {
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(output),
+            _mm_xor_si128(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(a)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(b))));
+    }
+#endif
+
+    for (; length >= 8; length -= 8, a += 8, b += 8, output += 8)
+    {
+        std::memcpy(&x, a, 8);
+        std::memcpy(&y, b, 8);
+        x ^= y;
+        std::memcpy(output, &x, 8);
+    }
+
+    for (; length > 0; length--) *output++ = *a++ ^ *b++;
+}
+
+/*
+ *  IncrementCounter
+ *
+ *  Description:
+ *      This function will increment the given 128-bit big endian counter
+ *      block by one, wrapping to zero on overflow.  This is the standard
+ *      incrementing function described in Appendix B.1 of NIST SP 800-38A
+ *      with m equal to the block size.
+ *
+ *  Parameters:
+ *      counter [in/out]
+ *          The counter block to increment.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr void IncrementCounter(std::span<std::uint8_t, 16> counter) noexcept
+{
+    for (std::size_t i = counter.size(); i > 0; i--)
+    {
+        if (++counter[i - 1] != 0) break;
+    }
+}
+
+/*
+ *  IncrementCounter32
+ *
+ *  Description:
+ *      This function will increment the rightmost 32 bits of the given
+ *      counter block by one modulo 2^32, leaving the leftmost 96 bits
+ *      unchanged.  This is the inc32() function described in Section 6.2 of
+ *      NIST SP 800-38D.
+ *
+ *  Parameters:
+ *      counter [in/out]
+ *          The counter block to increment.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr void IncrementCounter32(std::span<std::uint8_t, 16> counter) noexcept
+{
+    for (std::size_t i = counter.size(); i > counter.size() - 4; i--)
+    {
+        if (++counter[i - 1] != 0) break;
+    }
+}
+
+/*
+ *  LoadBigEndian32
+ *
+ *  Description:
+ *      This function will read a 32-bit unsigned integer stored in big endian
+ *      (network) byte order from the given buffer.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to the four octets to read.
+ *
+ *  Returns:
+ *      The 32-bit value in host byte order.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::uint32_t LoadBigEndian32(const std::uint8_t *p) noexcept
+{
+    std::uint32_t value{};
+
+    std::memcpy(&value, p, sizeof(value));
+
+    return Terra::BitUtil::NetworkByteOrder(value);
+}
+
+/*
+ *  StoreBigEndian32
+ *
+ *  Description:
+ *      This function will write a 32-bit unsigned integer into the given
+ *      buffer in big endian (network) byte order.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value to write.
+ *
+ *      p [out]
+ *          Pointer to the four octets to write.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void StoreBigEndian32(std::uint32_t value, std::uint8_t *p) noexcept
+{
+    value = Terra::BitUtil::NetworkByteOrder(value);
+
+    std::memcpy(p, &value, sizeof(value));
+}
+
+/*
+ *  LoadBigEndian64
+ *
+ *  Description:
+ *      This function will read a 64-bit unsigned integer stored in big endian
+ *      (network) byte order from the given buffer.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to the eight octets to read.
+ *
+ *  Returns:
+ *      The 64-bit value in host byte order.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::uint64_t LoadBigEndian64(const std::uint8_t *p) noexcept
+{
+    std::uint64_t value{};
+
+    std::memcpy(&value, p, sizeof(value));
+
+    return Terra::BitUtil::NetworkByteOrder(value);
+}
+
+/*
+ *  StoreBigEndian64
+ *
+ *  Description:
+ *      This function will write a 64-bit unsigned integer into the given
+ *      buffer in big endian (network) byte order.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value to write.
+ *
+ *      p [out]
+ *          Pointer to the eight octets to write.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void StoreBigEndian64(std::uint64_t value, std::uint8_t *p) noexcept
+{
+    value = Terra::BitUtil::NetworkByteOrder(value);
+
+    std::memcpy(p, &value, sizeof(value));
+}
+
+/*
+ *  LoadLittleEndian64
+ *
+ *  Description:
+ *      This function will read a 64-bit unsigned integer stored in little
+ *      endian byte order from the given buffer.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to the eight octets to read.
+ *
+ *  Returns:
+ *      The 64-bit value in host byte order.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::uint64_t LoadLittleEndian64(const std::uint8_t *p) noexcept
+{
+    std::uint64_t value{};
+
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        std::memcpy(&value, p, sizeof(value));
+    }
+    else
+    {
+        for (std::size_t i = sizeof(value); i > 0; i--)
+        {
+            value = (value << 8) | p[i - 1];
+        }
+    }
+
+    return value;
+}
+
+/*
+ *  StoreLittleEndian64
+ *
+ *  Description:
+ *      This function will write a 64-bit unsigned integer into the given
+ *      buffer in little endian byte order.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value to write.
+ *
+ *      p [out]
+ *          Pointer to the eight octets to write.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void StoreLittleEndian64(std::uint64_t value, std::uint8_t *p) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        std::memcpy(p, &value, sizeof(value));
+    }
+    else
+    {
+        for (std::size_t i = 0; i < sizeof(value); i++, value >>= 8)
+        {
+            p[i] = static_cast<std::uint8_t>(value);
+        }
+    }
+}
+
+/*
+ *  AddToCounter
+ *
+ *  Description:
+ *      This function will add the given number of blocks to the counter
+ *      block, treating all 128 bits as a single big endian integer that
+ *      wraps to zero on overflow.  This is equivalent to calling
+ *      IncrementCounter() the given number of times.
+ *
+ *  Parameters:
+ *      counter [in/out]
+ *          The counter block to advance.
+ *
+ *      blocks [in]
+ *          The number of blocks by which to advance the counter.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void AddToCounter(std::span<std::uint8_t, 16> counter,
+                         std::uint64_t blocks) noexcept
+{
+    std::uint64_t high = LoadBigEndian64(counter.data());
+    std::uint64_t low = LoadBigEndian64(counter.data() + 8);
+
+    low += blocks;
+    if (low < blocks) high++;
+
+    StoreBigEndian64(high, counter.data());
+    StoreBigEndian64(low, counter.data() + 8);
+}
+
+/*
+ *  AddToCounter32
+ *
+ *  Description:
+ *      This function will add the given number of blocks to the rightmost
+ *      32 bits of the counter block modulo 2^32, leaving the leftmost 96
+ *      bits unchanged.  This is equivalent to calling IncrementCounter32()
+ *      the given number of times.
+ *
+ *  Parameters:
+ *      counter [in/out]
+ *          The counter block to advance.
+ *
+ *      blocks [in]
+ *          The number of blocks by which to advance the counter.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void AddToCounter32(std::span<std::uint8_t, 16> counter,
+                           std::uint64_t blocks) noexcept
+{
+    StoreBigEndian32(LoadBigEndian32(counter.data() + 12) +
+                         static_cast<std::uint32_t>(blocks),
+                     counter.data() + 12);
+}
+
+/*
+ *  ComputeXTSTweaks
+ *
+ *  Description:
+ *      This function will fill the tweaks buffer with the tweaks for the
+ *      given number of consecutive XTS-AES blocks, starting with the given
+ *      tweak, and then advance the tweak past those blocks.
+ *
+ *  Parameters:
+ *      tweak [in/out]
+ *          The tweak for the first block, which is replaced with the tweak
+ *          for the block following the last.
+ *
+ *      tweaks [out]
+ *          The buffer into which the tweaks are written.  This must be at
+ *          least 16 * blocks octets in length.
+ *
+ *      blocks [in]
+ *          The number of tweaks to compute.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The tweak is a little endian element of GF(2^128) and each successive
+ *      tweak is the previous multiplied by x: the 128-bit value is shifted
+ *      left one bit and, if a bit was shifted out, the low octet is XORed
+ *      with 0x87.  With Intel Intrinsics, the shift is performed on both
+ *      64-bit halves at once and the carries are positioned with a shuffle.
+ */
+inline void ComputeXTSTweaks(std::span<std::uint8_t, 16> tweak,
+                             std::uint8_t *tweaks,
+                             std::size_t blocks) noexcept
+{
+#ifdef TERRA_USE_INTEL_INTRINSICS
+    const __m128i mask = _mm_set_epi64x(1, 0x87);
+    __m128i t =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(tweak.data()));
+    __m128i carry;
+
+    for (std::size_t i = 0; i < blocks; i++)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(tweaks + i * 16), t);
+
+        // Copy the sign of word 3 to word 0 and of word 1 to word 2
+        carry = _mm_shuffle_epi32(_mm_srai_epi32(t, 31), 0x13);
+        t = _mm_xor_si128(_mm_add_epi64(t, t), _mm_and_si128(carry, mask));
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(tweak.data()), t);
+#else
+    std::uint64_t low = LoadLittleEndian64(tweak.data());
+    std::uint64_t high = LoadLittleEndian64(tweak.data() + 8);
+    std::uint64_t carry{};
+
+    for (std::size_t i = 0; i < blocks; i++)
+    {
+        StoreLittleEndian64(low, tweaks + i * 16);
+        StoreLittleEndian64(high, tweaks + i * 16 + 8);
+
+        carry = high >> 63;
+        high = (high << 1) | (low >> 63);
+        low = (low << 1) ^ (0x87 & (0 - carry));
+    }
+
+    StoreLittleEndian64(low, tweak.data());
+    StoreLittleEndian64(high, tweak.data() + 8);
+#endif
+}
+
+/*
+ *  DoubleBlock()
+ *
+ *  Description:
+ *      Multiply the given block by x in GF(2^128) using the big endian
+ *      convention of CMAC (RFC 4493 Section 2.3) and OCB (RFC 7253
+ *      Section 2).
+ *
+ *  Parameters:
+ *      input [in]
+ *          The block to double.
+ *
+ *      output [out]
+ *          The doubled block, which may be the same memory as the input.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The block is shifted left one bit and, if a bit was shifted out, the
+ *      last octet is XORed with 0x87.  This is done on two 64-bit words and
+ *      without branching on the value of the block.
+ */
+inline void DoubleBlock(const std::array<std::uint8_t, 16> &input,
+                        std::array<std::uint8_t, 16> &output) noexcept
+{
+    std::uint64_t high = LoadBigEndian64(input.data());
+    std::uint64_t low = LoadBigEndian64(input.data() + 8);
+    std::uint64_t carry = high >> 63;
+
+    high = (high << 1) | (low >> 63);
+    low = (low << 1) ^ (0x87 & (0 - carry));
+
+    StoreBigEndian64(high, output.data());
+    StoreBigEndian64(low, output.data() + 8);
+}
+
+} // namespace
@@ -21,6 +21,8 @@
 #include <ostream>
 #include <iomanip>
 #include <vector>
+#include <array>
+#include <algorithm>
 #include <terra/crypto/cipher/aes.h>
 #include <terra/stf/adapters/integral_array.h>
 #include <terra/stf/stf.h>
@@ -564,3 +566,208 @@ STF_TEST(AES, TestDecryptVectorAPI)
     // at the top of this file
     STF_ASSERT_EQ(expected_plaintext, plaintext);
 }
+
+// Test the batch encryption and decryption API
+STF_TEST(AES, TestEncryptDecryptBlocks)
+{
+    const std::array<std::uint8_t, 32> aes_key =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+
+    const std::array<std::uint8_t, 16> block =
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+    };
+
+    const std::array<std::uint8_t, 16> expected_block =
+    {
+        0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+        0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+    };
+
+    // Use enough blocks to exercise the parallel code paths
+    std::array<std::uint8_t, 16 * 13> plaintext{};
+    std::array<std::uint8_t, 16 * 13> expected_ciphertext{};
+    std::array<std::uint8_t, 16 * 13> ciphertext{};
+
+    for (std::size_t i = 0; i < 13; i++)
+    {
+        std::copy(block.begin(), block.end(), plaintext.begin() + i * 16);
+        std::copy(expected_block.begin(),
+                  expected_block.end(),
+                  expected_ciphertext.begin() + i * 16);
+    }
+
+    AES aes(aes_key);
+
+    aes.EncryptBlocks(plaintext, ciphertext);
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+
+    aes.DecryptBlocks(ciphertext, ciphertext);
+    STF_ASSERT_EQ(plaintext, ciphertext);
+}
+
+// Test that a key set for encryption only produces the same ciphertext
+STF_TEST(AES, TestEncryptOnly)
+{
+    const std::array<std::uint8_t, 32> aes_key =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+
+    const std::array<std::uint8_t, 16> plaintext =
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+    };
+
+    const std::array<std::uint8_t, 16> expected_ciphertext =
+    {
+        0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+        0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+    };
+
+    std::array<std::uint8_t, 16> ciphertext{};
+    std::array<std::uint8_t, 16> decrypted{};
+
+    AES aes;
+
+    aes.SetKey(aes_key, AESKeyUsage::EncryptOnly);
+
+    aes.Encrypt(plaintext, ciphertext);
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+
+    // Decryption is rejected, as there is no decryption key schedule
+    STF_ASSERT_EXCEPTION_E(aes.DecryptBlocks(ciphertext, decrypted),
+                           AESException);
+
+    // Setting the key again for both directions enables decryption
+    aes.SetKey(aes_key);
+
+    aes.Decrypt(ciphertext, decrypted);
+    STF_ASSERT_EQ(plaintext, decrypted);
+}
+
+// Test that the batch API rejects spans that are not whole blocks
+STF_TEST(AES, TestBlocksInvalidLength)
+{
+    const std::array<std::uint8_t, 16> aes_key{};
+    std::array<std::uint8_t, 24> plaintext{};
+    std::array<std::uint8_t, 32> ciphertext{};
+    bool expected_failure = false;
+
+    AES aes(aes_key);
+
+    // Partial block
+    try
+    {
+        aes.EncryptBlocks(plaintext, std::span<std::uint8_t>(ciphertext.data(),
+                                                             24));
+    }
+    catch (const AESException &)
+    {
+        expected_failure = true;
+    }
+
+    STF_ASSERT_TRUE(expected_failure);
+
+    // Mismatched lengths
+    expected_failure = false;
+    try
+    {
+        aes.DecryptBlocks(std::span<const std::uint8_t>(plaintext.data(), 16),
+                          ciphertext);
+    }
+    catch (const AESException &)
+    {
+        expected_failure = true;
+    }
+
+    STF_ASSERT_TRUE(expected_failure);
+}
+
+// Test that the engine type reports the engine selected or requested
+STF_TEST(AES, TestEngineType)
+{
+    AES aes;
+
+    STF_ASSERT_NE(aes.GetEngineType(), AESEngineType::Unavailable);
+
+    // The universal and bitsliced engines are available on all processors
+    AES aes_universal(AESEngineType::Universal);
+    STF_ASSERT_EQ(aes_universal.GetEngineType(), AESEngineType::Universal);
+
+    AES aes_bitsliced(AESEngineType::Bitsliced);
+    STF_ASSERT_EQ(aes_bitsliced.GetEngineType(), AESEngineType::Bitsliced);
+
+    // A copy uses the same engine
+    AES aes_copy(aes_bitsliced);
+    STF_ASSERT_EQ(aes_copy.GetEngineType(), AESEngineType::Bitsliced);
+
+    // An engine that cannot be used falls back to the usual selection
+    AES aes_unavailable(AESEngineType::Unavailable);
+    STF_ASSERT_EQ(aes_unavailable.GetEngineType(), aes.GetEngineType());
+}
+
+// Test that the engine preferred by the process is used
+STF_TEST(AES, TestPreferredEngine)
+{
+    const std::array<std::uint8_t, 32> aes_key =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+
+    const std::array<std::uint8_t, 16> plaintext =
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+    };
+
+    const std::array<std::uint8_t, 16> expected_ciphertext =
+    {
+        0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+        0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+    };
+
+    std::array<std::uint8_t, 16> ciphertext{};
+
+    AESEngineType original_engine = AES::GetPreferredEngine();
+
+    AES::SetPreferredEngine(AESEngineType::Universal);
+    STF_ASSERT_EQ(AES::GetPreferredEngine(), AESEngineType::Universal);
+
+    AES aes_universal(aes_key);
+    STF_ASSERT_EQ(aes_universal.GetEngineType(), AESEngineType::Universal);
+
+    aes_universal.Encrypt(plaintext, ciphertext);
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+
+    // An engine type given to the constructor takes precedence
+    AES aes_bitsliced(aes_key, AESEngineType::Bitsliced);
+    STF_ASSERT_EQ(aes_bitsliced.GetEngineType(), AESEngineType::Bitsliced);
+
+    AES::SetPreferredEngine(AESEngineType::Bitsliced);
+
+    AES aes_preferred(aes_key);
+    STF_ASSERT_EQ(aes_preferred.GetEngineType(), AESEngineType::Bitsliced);
+
+    ciphertext = {};
+    aes_preferred.Encrypt(plaintext, ciphertext);
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+
+    // Existing objects retain their engines
+    STF_ASSERT_EQ(aes_universal.GetEngineType(), AESEngineType::Universal);
+
+    AES::SetPreferredEngine(original_engine);
+}
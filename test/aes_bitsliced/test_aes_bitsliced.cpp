@@ -0,0 +1,222 @@
+/*
+ *  test_aes_bitsliced.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the core AES encryption and decryption
+ *      routines in the AESBitsliced module, comparing multi-block results
+ *      against the AESUniversal module.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <aes_bitsliced.h>
+#include <aes_universal.h>
+#include <terra/stf/adapters/integral_vector.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+const std::uint8_t aes_key[32] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+const std::uint8_t plaintext[16] =
+{
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+
+} // namespace
+
+// Test the function that indicated the engine type
+STF_TEST(AESBitsliced, EngineCheck)
+{
+    AESBitsliced aes;
+
+    STF_ASSERT_EQ(aes.GetEngineType(), AESEngineType::Bitsliced);
+}
+
+// Test from Appendix C.1
+STF_TEST(AESBitsliced, TestVectorC1128)
+{
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+        0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+    };
+
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    AESBitsliced aes({aes_key, 16});
+
+    aes.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+
+    aes.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test from Appendix C.2
+STF_TEST(AESBitsliced, TestVectorC2192)
+{
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0,
+        0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91
+    };
+
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    AESBitsliced aes({aes_key, 24});
+
+    aes.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+
+    aes.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test from Appendix C.3
+STF_TEST(AESBitsliced, TestVectorC3256)
+{
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+        0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+    };
+
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    AESBitsliced aes(aes_key);
+
+    aes.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+
+    aes.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Compare multi-block operations against the AESUniversal engine
+STF_TEST(AESBitsliced, TestEncryptDecryptBlocks)
+{
+    // Exercise each key length and enough blocks to use each code path
+    for (std::size_t key_length : {16, 24, 32})
+    {
+        AESUniversal aes_universal({aes_key, key_length});
+        AESBitsliced aes_bitsliced({aes_key, key_length});
+
+        for (std::size_t blocks = 1; blocks <= 27; blocks++)
+        {
+            std::vector<std::uint8_t> data(blocks * 16);
+            std::vector<std::uint8_t> expected(blocks * 16);
+            std::vector<std::uint8_t> ciphertext(blocks * 16);
+
+            for (std::size_t i = 0; i < data.size(); i++)
+            {
+                data[i] = static_cast<std::uint8_t>(i * 7 + blocks);
+            }
+
+            aes_universal.EncryptBlocks(data, expected);
+
+            aes_bitsliced.EncryptBlocks(data, ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+
+            // Decrypt in place
+            aes_bitsliced.DecryptBlocks(ciphertext, ciphertext);
+            STF_ASSERT_EQ(data, ciphertext);
+        }
+    }
+}
+
+// Test copy constructor, assignment, and equality
+STF_TEST(AESBitsliced, TestCopyAndEquality)
+{
+    AESBitsliced aes1(aes_key);
+    AESBitsliced aes2 = aes1;
+    AESBitsliced aes3({aes_key, 16});
+
+    STF_ASSERT_TRUE(aes1 == aes2);
+    STF_ASSERT_TRUE(aes1 != aes3);
+
+    aes3 = aes1;
+
+    STF_ASSERT_TRUE(aes1 == aes3);
+}
+
+// Test that an invalid key length is rejected
+STF_TEST(AESBitsliced, TestInvalidKey)
+{
+    AESBitsliced aes;
+    bool expected_failure = false;
+
+    try
+    {
+        aes.SetKey({aes_key, 20});
+    }
+    catch (const AESException &)
+    {
+        expected_failure = true;
+    }
+
+    STF_ASSERT_TRUE(expected_failure);
+}
+
+// Test that the AES object uses the bitsliced engine when requested
+STF_TEST(AESBitsliced, TestAESEngineSelection)
+{
+    std::vector<std::uint8_t> data(16 * 19);
+    std::vector<std::uint8_t> expected(data.size());
+    std::vector<std::uint8_t> ciphertext(data.size());
+
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i);
+    }
+
+    AESUniversal aes_universal(aes_key);
+    AES aes(aes_key, AESEngineType::Bitsliced);
+    AES aes_copy = aes;
+
+    aes_universal.EncryptBlocks(data, expected);
+
+    aes.EncryptBlocks(data, ciphertext);
+    STF_ASSERT_EQ(expected, ciphertext);
+
+    aes_copy.DecryptBlocks(ciphertext, ciphertext);
+    STF_ASSERT_EQ(data, ciphertext);
+
+    STF_ASSERT_TRUE(aes == aes_copy);
+}
@@ -0,0 +1,244 @@
+/*
+ *  test_aes_cbc.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AES Cipher Block Chaining (CBC) mode
+ *      logic, including multi-stream encryption.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <terra/crypto/cipher/aes_cbc.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Plaintext from NIST SP 800-38A Appendix F.2
+constexpr std::array<std::uint8_t, 64> SP800_38A_Plaintext =
+{
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+    0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+    0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+    0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+
+// Initialization vector from NIST SP 800-38A Appendix F.2
+constexpr std::array<std::uint8_t, 16> SP800_38A_IV =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+// AES-128 key from NIST SP 800-38A Appendix F.2.1
+constexpr std::array<std::uint8_t, 16> SP800_38A_Key_128 =
+{
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+} // namespace
+
+// Test vector in NIST SP 800-38A Appendix F.2.1 and F.2.2
+STF_TEST(AESCBC, SP800_38A_F_2_1)
+{
+    const std::array<std::uint8_t, 64> expected_ciphertext =
+    {
+        0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46,
+        0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+        0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee,
+        0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+        0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b,
+        0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+        0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09,
+        0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7
+    };
+    std::array<std::uint8_t, 64> ciphertext{};
+    std::array<std::uint8_t, 64> plaintext{};
+
+    AESCBC aes_cbc(SP800_38A_Key_128);
+
+    aes_cbc.Encrypt(SP800_38A_IV, SP800_38A_Plaintext, ciphertext);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+
+    aes_cbc.Decrypt(SP800_38A_IV, ciphertext, plaintext);
+
+    STF_ASSERT_EQ(SP800_38A_Plaintext, plaintext);
+}
+
+// Test vector in NIST SP 800-38A Appendix F.2.5 and F.2.6
+STF_TEST(AESCBC, SP800_38A_F_2_5)
+{
+    const std::array<std::uint8_t, 32> key =
+    {
+        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+        0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+        0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+    };
+    const std::array<std::uint8_t, 64> expected_ciphertext =
+    {
+        0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba,
+        0x77, 0x9e, 0xab, 0xfb, 0x5f, 0x7b, 0xfb, 0xd6,
+        0x9c, 0xfc, 0x4e, 0x96, 0x7e, 0xdb, 0x80, 0x8d,
+        0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70, 0x2c, 0x7d,
+        0x39, 0xf2, 0x33, 0x69, 0xa9, 0xd9, 0xba, 0xcf,
+        0xa5, 0x30, 0xe2, 0x63, 0x04, 0x23, 0x14, 0x61,
+        0xb2, 0xeb, 0x05, 0xe2, 0xc3, 0x9b, 0xe9, 0xfc,
+        0xda, 0x6c, 0x19, 0x07, 0x8c, 0x6a, 0x9d, 0x1b
+    };
+    std::array<std::uint8_t, 64> buffer = SP800_38A_Plaintext;
+
+    AESCBC aes_cbc;
+
+    aes_cbc.SetKey(key);
+
+    // Encrypt and decrypt in place
+    aes_cbc.Encrypt(SP800_38A_IV, buffer, buffer);
+
+    STF_ASSERT_EQ(expected_ciphertext, buffer);
+
+    aes_cbc.Decrypt(SP800_38A_IV, buffer, buffer);
+
+    STF_ASSERT_EQ(SP800_38A_Plaintext, buffer);
+}
+
+// Decrypt messages spanning several groups of blocks, including in place
+STF_TEST(AESCBC, LongDecrypt)
+{
+    for (std::size_t blocks = 1; blocks <= 37; blocks++)
+    {
+        std::vector<std::uint8_t> plaintext(blocks * 16);
+        std::vector<std::uint8_t> ciphertext(plaintext.size());
+        std::vector<std::uint8_t> plaintext_check(plaintext.size());
+
+        for (std::size_t i = 0; i < plaintext.size(); i++)
+        {
+            plaintext[i] = static_cast<std::uint8_t>(i * 7 + blocks);
+        }
+
+        AESCBC aes_cbc(SP800_38A_Key_128);
+
+        aes_cbc.Encrypt(SP800_38A_IV, plaintext, ciphertext);
+
+        aes_cbc.Decrypt(SP800_38A_IV, ciphertext, plaintext_check);
+
+        STF_ASSERT_EQ(plaintext, plaintext_check);
+
+        aes_cbc.Decrypt(SP800_38A_IV, ciphertext, ciphertext);
+
+        STF_ASSERT_EQ(plaintext, ciphertext);
+    }
+}
+
+// Ensure multi-stream encryption matches encrypting each stream separately
+STF_TEST(AESCBC, EncryptStreams)
+{
+    constexpr std::size_t Streams = 13;
+    std::vector<std::vector<std::uint8_t>> ivs(Streams);
+    std::vector<std::vector<std::uint8_t>> plaintexts(Streams);
+    std::vector<std::vector<std::uint8_t>> ciphertexts(Streams);
+    std::vector<std::span<const std::uint8_t>> iv_spans;
+    std::vector<std::span<const std::uint8_t>> plaintext_spans;
+    std::vector<std::span<std::uint8_t>> ciphertext_spans;
+    std::array<std::uint8_t, 16> iv{};
+
+    for (std::size_t i = 0; i < Streams; i++)
+    {
+        // Streams of differing lengths, including an empty one
+        ivs[i].resize(16);
+        plaintexts[i].resize(((i * 5) % 11) * 16);
+        ciphertexts[i].resize(plaintexts[i].size());
+
+        for (std::size_t j = 0; j < ivs[i].size(); j++)
+        {
+            ivs[i][j] = static_cast<std::uint8_t>(i * 16 + j);
+        }
+        for (std::size_t j = 0; j < plaintexts[i].size(); j++)
+        {
+            plaintexts[i][j] = static_cast<std::uint8_t>(i + j * 3);
+        }
+
+        iv_spans.emplace_back(ivs[i]);
+        plaintext_spans.emplace_back(plaintexts[i]);
+        ciphertext_spans.emplace_back(ciphertexts[i]);
+    }
+
+    AESCBC aes_cbc(SP800_38A_Key_128);
+
+    aes_cbc.EncryptStreams(iv_spans, plaintext_spans, ciphertext_spans);
+
+    for (std::size_t i = 0; i < Streams; i++)
+    {
+        std::vector<std::uint8_t> expected_ciphertext(plaintexts[i].size());
+
+        std::copy(ivs[i].begin(), ivs[i].end(), iv.begin());
+        aes_cbc.Encrypt(iv, plaintexts[i], expected_ciphertext);
+
+        STF_ASSERT_EQ(expected_ciphertext, ciphertexts[i]);
+    }
+}
+
+// Ensure invalid span lengths are rejected
+STF_TEST(AESCBC, InvalidLength)
+{
+    std::array<std::uint8_t, 63> short_buffer{};
+    std::array<std::uint8_t, 64> buffer{};
+    std::array<std::uint8_t, 8> short_iv{};
+    std::array<std::span<const std::uint8_t>, 1> iv_spans = {short_iv};
+    std::array<std::span<const std::uint8_t>, 1> plaintext_spans = {
+        SP800_38A_Plaintext};
+    std::array<std::span<std::uint8_t>, 1> ciphertext_spans = {buffer};
+    std::size_t exceptions{};
+
+    AESCBC aes_cbc(SP800_38A_Key_128);
+
+    try
+    {
+        aes_cbc.Encrypt(SP800_38A_IV, short_buffer, short_buffer);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    try
+    {
+        aes_cbc.Decrypt(SP800_38A_IV, SP800_38A_Plaintext, short_buffer);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    try
+    {
+        aes_cbc.EncryptStreams(iv_spans, plaintext_spans, ciphertext_spans);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    STF_ASSERT_EQ(std::size_t(3), exceptions);
+}
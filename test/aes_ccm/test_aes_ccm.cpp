@@ -0,0 +1,407 @@
+/*
+ *  test_aes_ccm.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AES Counter with CBC-MAC (CCM) logic.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <span>
+#include <terra/crypto/cipher/aes_ccm.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Key from NIST SP 800-38C Appendix C
+constexpr std::array<std::uint8_t, 16> SP800_38C_Key =
+{
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+    0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f
+};
+
+// Encrypt and decrypt the given example, verifying the results
+void VerifyExample(const std::span<const std::uint8_t> key,
+                   const std::span<const std::uint8_t> nonce,
+                   const std::span<const std::uint8_t> aad,
+                   const std::span<const std::uint8_t> plaintext,
+                   const std::span<const std::uint8_t> expected_ciphertext,
+                   const std::span<const std::uint8_t> expected_tag)
+{
+    std::vector<std::uint8_t> ciphertext(plaintext.size());
+    std::vector<std::uint8_t> decrypted(plaintext.size());
+    std::vector<std::uint8_t> tag(expected_tag.size());
+
+    AESCCM aes_ccm(key);
+
+    aes_ccm.Encrypt(nonce, aad, plaintext, ciphertext, tag);
+    STF_ASSERT_MEM_EQ(expected_ciphertext.data(),
+                      ciphertext.data(),
+                      ciphertext.size());
+    STF_ASSERT_MEM_EQ(expected_tag.data(), tag.data(), tag.size());
+
+    STF_ASSERT_TRUE(aes_ccm.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(plaintext.data(), decrypted.data(), decrypted.size());
+}
+
+} // namespace
+
+// Test vector in NIST SP 800-38C Appendix C.1
+STF_TEST(AESCCM, SP800_38C_Example_1)
+{
+    const std::array<std::uint8_t, 7> nonce =
+    {
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16
+    };
+    const std::array<std::uint8_t, 8> aad =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+    };
+    const std::array<std::uint8_t, 4> plaintext =
+    {
+        0x20, 0x21, 0x22, 0x23
+    };
+    const std::array<std::uint8_t, 4> ciphertext =
+    {
+        0x71, 0x62, 0x01, 0x5b
+    };
+    const std::array<std::uint8_t, 4> tag =
+    {
+        0x4d, 0xac, 0x25, 0x5d
+    };
+
+    VerifyExample(SP800_38C_Key, nonce, aad, plaintext, ciphertext, tag);
+}
+
+// Test vector in NIST SP 800-38C Appendix C.2
+STF_TEST(AESCCM, SP800_38C_Example_2)
+{
+    const std::array<std::uint8_t, 8> nonce =
+    {
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17
+    };
+    const std::array<std::uint8_t, 16> aad =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    };
+    const std::array<std::uint8_t, 16> plaintext =
+    {
+        0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+        0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f
+    };
+    const std::array<std::uint8_t, 16> ciphertext =
+    {
+        0xd2, 0xa1, 0xf0, 0xe0, 0x51, 0xea, 0x5f, 0x62,
+        0x08, 0x1a, 0x77, 0x92, 0x07, 0x3d, 0x59, 0x3d
+    };
+    const std::array<std::uint8_t, 6> tag =
+    {
+        0x1f, 0xc6, 0x4f, 0xbf, 0xac, 0xcd
+    };
+
+    VerifyExample(SP800_38C_Key, nonce, aad, plaintext, ciphertext, tag);
+}
+
+// Test vector in NIST SP 800-38C Appendix C.3
+STF_TEST(AESCCM, SP800_38C_Example_3)
+{
+    const std::array<std::uint8_t, 12> nonce =
+    {
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b
+    };
+    const std::array<std::uint8_t, 20> aad =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13
+    };
+    const std::array<std::uint8_t, 24> plaintext =
+    {
+        0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+        0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+        0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37
+    };
+    const std::array<std::uint8_t, 24> ciphertext =
+    {
+        0xe3, 0xb2, 0x01, 0xa9, 0xf5, 0xb7, 0x1a, 0x7a,
+        0x9b, 0x1c, 0xea, 0xec, 0xcd, 0x97, 0xe7, 0x0b,
+        0x61, 0x76, 0xaa, 0xd9, 0xa4, 0x42, 0x8a, 0xa5
+    };
+    const std::array<std::uint8_t, 8> tag =
+    {
+        0x48, 0x43, 0x92, 0xfb, 0xc1, 0xb0, 0x99, 0x51
+    };
+
+    VerifyExample(SP800_38C_Key, nonce, aad, plaintext, ciphertext, tag);
+}
+
+// Test vector in RFC 3610 Section 8, Packet Vector #1
+STF_TEST(AESCCM, RFC3610_Packet_Vector_1)
+{
+    const std::array<std::uint8_t, 16> key =
+    {
+        0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+        0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf
+    };
+    const std::array<std::uint8_t, 13> nonce =
+    {
+        0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0,
+        0xa1, 0xa2, 0xa3, 0xa4, 0xa5
+    };
+    const std::array<std::uint8_t, 8> aad =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+    };
+    const std::array<std::uint8_t, 23> plaintext =
+    {
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e
+    };
+    const std::array<std::uint8_t, 23> ciphertext =
+    {
+        0x58, 0x8c, 0x97, 0x9a, 0x61, 0xc6, 0x63, 0xd2,
+        0xf0, 0x66, 0xd0, 0xc2, 0xc0, 0xf9, 0x89, 0x80,
+        0x6d, 0x5f, 0x6b, 0x61, 0xda, 0xc3, 0x84
+    };
+    const std::array<std::uint8_t, 8> tag =
+    {
+        0x17, 0xe8, 0xd1, 0x2c, 0xfd, 0xf9, 0x26, 0xe0
+    };
+
+    VerifyExample(key, nonce, aad, plaintext, ciphertext, tag);
+}
+
+// Test associated data long enough to require the six-octet length encoding
+STF_TEST(AESCCM, LongAAD)
+{
+    const std::array<std::uint8_t, 32> key =
+    {
+        0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+        0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+        0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,
+        0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f
+    };
+    const std::array<std::uint8_t, 12> nonce =
+    {
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b
+    };
+    const std::array<std::uint8_t, 50> ciphertext =
+    {
+        0x25, 0xdd, 0xa6, 0x87, 0x9a, 0x88, 0x32, 0x01,
+        0xdb, 0xc0, 0x3e, 0xbf, 0xd7, 0x4a, 0xa7, 0x20,
+        0x21, 0x31, 0xe1, 0xed, 0x12, 0x7b, 0x00, 0x94,
+        0x06, 0x83, 0xca, 0x4d, 0x4b, 0xa5, 0x93, 0xb3,
+        0x47, 0x80, 0x78, 0x25, 0xf4, 0x6a, 0x49, 0x6d,
+        0x3c, 0xb0, 0x89, 0x75, 0x04, 0x3a, 0x12, 0xee,
+        0x84, 0xd1
+    };
+    const std::array<std::uint8_t, 16> tag =
+    {
+        0x7f, 0xeb, 0x80, 0xa7, 0x92, 0xf6, 0xf6, 0x80,
+        0x26, 0x72, 0x4e, 0x09, 0x37, 0x29, 0x96, 0xf7
+    };
+    std::vector<std::uint8_t> aad(0xff00);
+    std::vector<std::uint8_t> plaintext(50);
+
+    for (std::size_t i = 0; i < aad.size(); i++)
+    {
+        aad[i] = static_cast<std::uint8_t>(i * 7);
+    }
+    for (std::size_t i = 0; i < plaintext.size(); i++)
+    {
+        plaintext[i] = static_cast<std::uint8_t>(i * 3 + 1);
+    }
+
+    VerifyExample(key, nonce, aad, plaintext, ciphertext, tag);
+}
+
+// Test a message with neither associated data nor payload
+STF_TEST(AESCCM, EmptyMessage)
+{
+    const std::array<std::uint8_t, 24> key =
+    {
+        0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+        0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+        0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57
+    };
+    const std::array<std::uint8_t, 13> nonce =
+    {
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c
+    };
+    const std::array<std::uint8_t, 4> tag =
+    {
+        0xfd, 0x9a, 0x93, 0xe8
+    };
+
+    VerifyExample(key, nonce, {}, {}, {}, tag);
+}
+
+// Test encryption and decryption in place
+STF_TEST(AESCCM, InPlace)
+{
+    std::vector<std::uint8_t> data(100);
+    std::vector<std::uint8_t> original(data.size());
+    std::array<std::uint8_t, 12> nonce{};
+    std::array<std::uint8_t, 16> aad{};
+    std::array<std::uint8_t, 16> tag{};
+    std::array<std::uint8_t, 16> expected_tag{};
+    std::vector<std::uint8_t> expected(data.size());
+
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i);
+    }
+    original = data;
+
+    AESCCM aes_ccm(SP800_38C_Key);
+
+    // Produce the expected result using separate buffers
+    aes_ccm.Encrypt(nonce, aad, original, expected, expected_tag);
+
+    aes_ccm.Encrypt(nonce, aad, data, data, tag);
+    STF_ASSERT_MEM_EQ(expected.data(), data.data(), data.size());
+    STF_ASSERT_MEM_EQ(expected_tag.data(), tag.data(), tag.size());
+
+    STF_ASSERT_TRUE(aes_ccm.Decrypt(nonce, aad, data, data, tag));
+    STF_ASSERT_MEM_EQ(original.data(), data.data(), data.size());
+}
+
+// Test that modification of the tag, ciphertext, or associated data is
+// detected and that no plaintext is released
+STF_TEST(AESCCM, Tampered)
+{
+    std::vector<std::uint8_t> plaintext(40, 0x5a);
+    std::vector<std::uint8_t> ciphertext(plaintext.size());
+    std::vector<std::uint8_t> decrypted(plaintext.size());
+    const std::vector<std::uint8_t> zeros(plaintext.size());
+    std::array<std::uint8_t, 13> nonce{};
+    std::array<std::uint8_t, 8> aad{};
+    std::array<std::uint8_t, 10> tag{};
+
+    AESCCM aes_ccm(SP800_38C_Key);
+
+    aes_ccm.Encrypt(nonce, aad, plaintext, ciphertext, tag);
+
+    // Modify the tag
+    tag[9] ^= 0x01;
+    STF_ASSERT_FALSE(
+        aes_ccm.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(zeros.data(), decrypted.data(), decrypted.size());
+    tag[9] ^= 0x01;
+
+    // Modify the ciphertext
+    ciphertext[20] ^= 0x80;
+    STF_ASSERT_FALSE(
+        aes_ccm.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(zeros.data(), decrypted.data(), decrypted.size());
+    ciphertext[20] ^= 0x80;
+
+    // Modify the associated data
+    aad[0] ^= 0x01;
+    STF_ASSERT_FALSE(
+        aes_ccm.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(zeros.data(), decrypted.data(), decrypted.size());
+    aad[0] ^= 0x01;
+
+    // Modify the nonce
+    nonce[12] ^= 0x01;
+    STF_ASSERT_FALSE(
+        aes_ccm.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(zeros.data(), decrypted.data(), decrypted.size());
+    nonce[12] ^= 0x01;
+
+    // Unmodified input should decrypt
+    STF_ASSERT_TRUE(aes_ccm.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(plaintext.data(), decrypted.data(), decrypted.size());
+}
+
+// Test that invalid nonce, tag, and span lengths are rejected
+STF_TEST(AESCCM, InvalidLengths)
+{
+    std::vector<std::uint8_t> plaintext(32);
+    std::vector<std::uint8_t> ciphertext(plaintext.size());
+    std::array<std::uint8_t, 14> nonce{};
+    std::array<std::uint8_t, 18> tag{};
+
+    AESCCM aes_ccm(SP800_38C_Key);
+
+    // Nonce too short or too long
+    STF_ASSERT_EXCEPTION_E(
+        aes_ccm.Encrypt(std::span(nonce).first(6),
+                        {},
+                        plaintext,
+                        ciphertext,
+                        std::span(tag).first(8)),
+        AESException);
+    STF_ASSERT_EXCEPTION_E(
+        aes_ccm.Encrypt(nonce,
+                        {},
+                        plaintext,
+                        ciphertext,
+                        std::span(tag).first(8)),
+        AESException);
+
+    // Tag too short, too long, or of odd length
+    for (const std::size_t length : {0u, 2u, 5u, 15u, 18u})
+    {
+        STF_ASSERT_EXCEPTION_E(
+            aes_ccm.Encrypt(std::span(nonce).first(12),
+                            {},
+                            plaintext,
+                            ciphertext,
+                            std::span(tag).first(length)),
+            AESException);
+    }
+
+    // Output span length does not match the input
+    STF_ASSERT_EXCEPTION_E(
+        aes_ccm.Encrypt(std::span(nonce).first(12),
+                        {},
+                        plaintext,
+                        std::span(ciphertext).first(31),
+                        std::span(tag).first(8)),
+        AESException);
+    STF_ASSERT_EXCEPTION_E(
+        aes_ccm.Decrypt(std::span(nonce).first(12),
+                        {},
+                        std::span(ciphertext).first(31),
+                        plaintext,
+                        std::span(tag).first(8)),
+        AESException);
+
+    // A 13-octet nonce leaves two octets for the payload length
+    std::vector<std::uint8_t> large(65536);
+    STF_ASSERT_EXCEPTION_E(
+        aes_ccm.Encrypt(std::span(nonce).first(13),
+                        {},
+                        large,
+                        large,
+                        std::span(tag).first(8)),
+        AESException);
+    aes_ccm.Encrypt(std::span(nonce).first(13),
+                    {},
+                    std::span(large).first(65535),
+                    std::span(large).first(65535),
+                    std::span(tag).first(8));
+}
+
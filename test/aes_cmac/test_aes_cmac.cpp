@@ -0,0 +1,303 @@
+/*
+ *  test_aes_cmac.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AES-CMAC logic, including incremental
+ *      and multi-message tag computation.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <span>
+#include <terra/crypto/cipher/aes_cmac.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Message from RFC 4493 Section 4 and NIST SP 800-38B Appendix D
+constexpr std::array<std::uint8_t, 64> Message =
+{
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+    0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+    0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+    0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+
+// Length of the message used for each example
+constexpr std::size_t Message_Lengths[] = {0, 16, 40, 64};
+
+// AES-128 key from RFC 4493 Section 4 and NIST SP 800-38B Appendix D.1
+constexpr std::array<std::uint8_t, 16> Key_128 =
+{
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+// Tags for each example from RFC 4493 Section 4
+constexpr std::array<std::uint8_t, 16> Tags_128[4] =
+{
+    {
+        0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28,
+        0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46
+    },
+    {
+        0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44,
+        0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c
+    },
+    {
+        0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30,
+        0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27
+    },
+    {
+        0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92,
+        0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe
+    }
+};
+
+// AES-192 key from NIST SP 800-38B Appendix D.2
+constexpr std::array<std::uint8_t, 24> Key_192 =
+{
+    0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52,
+    0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+    0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b
+};
+
+// Tags for each example from NIST SP 800-38B Appendix D.2
+constexpr std::array<std::uint8_t, 16> Tags_192[4] =
+{
+    {
+        0xd1, 0x7d, 0xdf, 0x46, 0xad, 0xaa, 0xcd, 0xe5,
+        0x31, 0xca, 0xc4, 0x83, 0xde, 0x7a, 0x93, 0x67
+    },
+    {
+        0x9e, 0x99, 0xa7, 0xbf, 0x31, 0xe7, 0x10, 0x90,
+        0x06, 0x62, 0xf6, 0x5e, 0x61, 0x7c, 0x51, 0x84
+    },
+    {
+        0x8a, 0x1d, 0xe5, 0xbe, 0x2e, 0xb3, 0x1a, 0xad,
+        0x08, 0x9a, 0x82, 0xe6, 0xee, 0x90, 0x8b, 0x0e
+    },
+    {
+        0xa1, 0xd5, 0xdf, 0x0e, 0xed, 0x79, 0x0f, 0x79,
+        0x4d, 0x77, 0x58, 0x96, 0x59, 0xf3, 0x9a, 0x11
+    }
+};
+
+// AES-256 key from NIST SP 800-38B Appendix D.3
+constexpr std::array<std::uint8_t, 32> Key_256 =
+{
+    0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+    0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+    0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+    0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+};
+
+// Tags for each example from NIST SP 800-38B Appendix D.3
+constexpr std::array<std::uint8_t, 16> Tags_256[4] =
+{
+    {
+        0x02, 0x89, 0x62, 0xf6, 0x1b, 0x7b, 0xf8, 0x9e,
+        0xfc, 0x6b, 0x55, 0x1f, 0x46, 0x67, 0xd9, 0x83
+    },
+    {
+        0x28, 0xa7, 0x02, 0x3f, 0x45, 0x2e, 0x8f, 0x82,
+        0xbd, 0x4b, 0xf2, 0x8d, 0x8c, 0x37, 0xc3, 0x5c
+    },
+    {
+        0xaa, 0xf3, 0xd8, 0xf1, 0xde, 0x56, 0x40, 0xc2,
+        0x32, 0xf5, 0xb1, 0x69, 0xb9, 0xc9, 0x11, 0xe6
+    },
+    {
+        0xe1, 0x99, 0x21, 0x90, 0x54, 0x9f, 0x6e, 0xd5,
+        0x69, 0x6a, 0x2c, 0x05, 0x6c, 0x31, 0x54, 0x10
+    }
+};
+
+// Verify the examples for one key using both the one-shot and incremental
+// interfaces
+void VerifyExamples(const std::span<const std::uint8_t> key,
+                    const std::array<std::uint8_t, 16> (&expected)[4])
+{
+    std::array<std::uint8_t, 16> tag{};
+
+    AESCMAC aes_cmac(key);
+
+    for (std::size_t i = 0; i < std::size(Message_Lengths); i++)
+    {
+        std::span<const std::uint8_t> message(Message.data(),
+                                              Message_Lengths[i]);
+
+        aes_cmac.Compute(message, tag);
+        STF_ASSERT_EQ(expected[i], tag);
+
+        STF_ASSERT_TRUE(aes_cmac.Verify(message, expected[i]));
+
+        aes_cmac.Update(message);
+        aes_cmac.Final(tag);
+        STF_ASSERT_EQ(expected[i], tag);
+    }
+}
+
+} // namespace
+
+// Test the AES-128 examples
+STF_TEST(AESCMAC, Examples_128)
+{
+    VerifyExamples(Key_128, Tags_128);
+}
+
+// Test the AES-192 examples
+STF_TEST(AESCMAC, Examples_192)
+{
+    VerifyExamples(Key_192, Tags_192);
+}
+
+// Test the AES-256 examples
+STF_TEST(AESCMAC, Examples_256)
+{
+    VerifyExamples(Key_256, Tags_256);
+}
+
+// Test that splitting a message among calls to Update() has no effect
+STF_TEST(AESCMAC, IncrementalUpdate)
+{
+    std::array<std::uint8_t, 16> tag{};
+
+    AESCMAC aes_cmac(Key_128);
+
+    for (std::size_t split = 0; split <= Message.size(); split++)
+    {
+        aes_cmac.Update(std::span(Message).first(split));
+        aes_cmac.Update(std::span(Message).subspan(split));
+        aes_cmac.Final(tag);
+        STF_ASSERT_EQ(Tags_128[3], tag);
+    }
+
+    // Feed the message one octet at a time
+    for (std::uint8_t octet : Message) aes_cmac.Update({&octet, 1});
+    aes_cmac.Final(tag);
+    STF_ASSERT_EQ(Tags_128[3], tag);
+
+    // Abandoning a partial message does not affect the next one
+    aes_cmac.Update(std::span(Message).first(20));
+    aes_cmac.Reset();
+    aes_cmac.Update(std::span(Message).first(40));
+    aes_cmac.Final(tag);
+    STF_ASSERT_EQ(Tags_128[2], tag);
+}
+
+// Test truncated tags and verification failures
+STF_TEST(AESCMAC, TruncatedTag)
+{
+    std::array<std::uint8_t, 8> tag{};
+
+    AESCMAC aes_cmac(Key_256);
+
+    aes_cmac.Compute(Message, tag);
+    STF_ASSERT_MEM_EQ(Tags_256[3].data(), tag.data(), tag.size());
+    STF_ASSERT_TRUE(aes_cmac.Verify(Message, tag));
+
+    tag[7] ^= 0x01;
+    STF_ASSERT_FALSE(aes_cmac.Verify(Message, tag));
+
+    // The message is altered
+    std::array<std::uint8_t, 64> message = Message;
+    message[63] ^= 0x80;
+    STF_ASSERT_FALSE(aes_cmac.Verify(message, Tags_256[3]));
+}
+
+// Test that tags computed together match tags computed individually
+STF_TEST(AESCMAC, ComputeTags)
+{
+    constexpr std::size_t Messages = 37;
+    std::vector<std::vector<std::uint8_t>> messages;
+    std::vector<std::span<const std::uint8_t>> message_spans;
+    std::vector<std::array<std::uint8_t, 16>> tags(Messages);
+    std::vector<std::span<std::uint8_t>> tag_spans;
+    std::array<std::uint8_t, 16> expected{};
+
+    AESCMAC aes_cmac(Key_192);
+
+    // Use lengths that vary so that lanes complete at different times
+    for (std::size_t i = 0; i < Messages; i++)
+    {
+        std::vector<std::uint8_t> message((i * 29) % 200);
+
+        for (std::size_t j = 0; j < message.size(); j++)
+        {
+            message[j] = static_cast<std::uint8_t>(i + j * 5);
+        }
+
+        messages.push_back(message);
+    }
+
+    for (std::size_t i = 0; i < Messages; i++)
+    {
+        message_spans.emplace_back(messages[i]);
+        tag_spans.emplace_back(tags[i].data(), 4 + i % 13);
+    }
+
+    // A message being authenticated incrementally is not disturbed
+    aes_cmac.Update(std::span(Message).first(24));
+
+    aes_cmac.ComputeTags(message_spans, tag_spans);
+
+    for (std::size_t i = 0; i < Messages; i++)
+    {
+        aes_cmac.Compute(messages[i], expected);
+        STF_ASSERT_MEM_EQ(expected.data(),
+                          tag_spans[i].data(),
+                          tag_spans[i].size());
+    }
+
+    aes_cmac.Update(std::span(Message).subspan(24, 16));
+    aes_cmac.Final(expected);
+    STF_ASSERT_EQ(Tags_192[2], expected);
+}
+
+// Test that invalid lengths are rejected
+STF_TEST(AESCMAC, InvalidLength)
+{
+    std::array<std::uint8_t, 17> tag{};
+    std::array<std::span<const std::uint8_t>, 2> messages = {Message, Message};
+    std::array<std::span<std::uint8_t>, 2> tags =
+    {
+        std::span(tag).first(16), std::span(tag).first(3)
+    };
+
+    AESCMAC aes_cmac(Key_128);
+
+    STF_ASSERT_EXCEPTION_E(aes_cmac.Compute(Message, std::span(tag).first(3)),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(aes_cmac.Compute(Message, tag), AESException);
+    STF_ASSERT_EXCEPTION_E(aes_cmac.Final(std::span(tag).first(3)),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(aes_cmac.Verify(Message, tag), AESException);
+    STF_ASSERT_EXCEPTION_E(aes_cmac.ComputeTags(messages, tags),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(
+        aes_cmac.ComputeTags(messages, std::span(tags).first(1)),
+        AESException);
+
+    // An invalid key length
+    STF_ASSERT_EXCEPTION_E(AESCMAC(std::span(tag).first(15)), AESException);
+}
@@ -0,0 +1,230 @@
+/*
+ *  test_aes_ctr.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AES Counter (CTR) mode logic.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <terra/crypto/cipher/aes_ctr.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Plaintext from NIST SP 800-38A Appendix F.5
+constexpr std::array<std::uint8_t, 64> SP800_38A_Plaintext =
+{
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+    0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+    0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+    0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+
+// Initial counter block from NIST SP 800-38A Appendix F.5
+constexpr std::array<std::uint8_t, 16> SP800_38A_Counter =
+{
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+    0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+
+// AES-128 key from NIST SP 800-38A Appendix F.5.1
+constexpr std::array<std::uint8_t, 16> SP800_38A_Key_128 =
+{
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+} // namespace
+
+// Test vector in NIST SP 800-38A Appendix F.5.1
+STF_TEST(AESCTR, SP800_38A_F_5_1)
+{
+    const std::array<std::uint8_t, 64> expected_ciphertext =
+    {
+        0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26,
+        0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+        0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff,
+        0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+        0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e,
+        0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+        0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1,
+        0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee
+    };
+    std::array<std::uint8_t, 64> ciphertext{};
+    std::array<std::uint8_t, 64> plaintext{};
+
+    AESCTR aes_ctr(SP800_38A_Key_128, SP800_38A_Counter);
+
+    aes_ctr.Encrypt(SP800_38A_Plaintext, ciphertext);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+
+    // Reset the counter and decrypt
+    aes_ctr.SetCounter(SP800_38A_Counter);
+    aes_ctr.Decrypt(ciphertext, plaintext);
+
+    STF_ASSERT_EQ(SP800_38A_Plaintext, plaintext);
+}
+
+// Test vector in NIST SP 800-38A Appendix F.5.5
+STF_TEST(AESCTR, SP800_38A_F_5_5)
+{
+    const std::array<std::uint8_t, 32> key =
+    {
+        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+        0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+        0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+    };
+    const std::array<std::uint8_t, 64> expected_ciphertext =
+    {
+        0x60, 0x1e, 0xc3, 0x13, 0x77, 0x57, 0x89, 0xa5,
+        0xb7, 0xa7, 0xf5, 0x04, 0xbb, 0xf3, 0xd2, 0x28,
+        0xf4, 0x43, 0xe3, 0xca, 0x4d, 0x62, 0xb5, 0x9a,
+        0xca, 0x84, 0xe9, 0x90, 0xca, 0xca, 0xf5, 0xc5,
+        0x2b, 0x09, 0x30, 0xda, 0xa2, 0x3d, 0xe9, 0x4c,
+        0xe8, 0x70, 0x17, 0xba, 0x2d, 0x84, 0x98, 0x8d,
+        0xdf, 0xc9, 0xc5, 0x8d, 0xb6, 0x7a, 0xad, 0xa6,
+        0x13, 0xc2, 0xdd, 0x08, 0x45, 0x79, 0x41, 0xa6
+    };
+    std::array<std::uint8_t, 64> ciphertext{};
+
+    AESCTR aes_ctr;
+
+    aes_ctr.SetKey(key);
+    aes_ctr.SetCounter(SP800_38A_Counter);
+    aes_ctr.Encrypt(SP800_38A_Plaintext, ciphertext);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+}
+
+// Ensure the counter carries across all 128 bits and wraps to zero
+STF_TEST(AESCTR, CounterWrap)
+{
+    const std::array<std::uint8_t, 16> counter =
+    {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe
+    };
+    const std::array<std::uint8_t, 50> expected_ciphertext =
+    {
+        0xba, 0x76, 0xaa, 0x54, 0xd5, 0xb5, 0x60, 0x67,
+        0xc1, 0xa7, 0x90, 0x3b, 0x3f, 0xdd, 0xfa, 0x89,
+        0x24, 0xdf, 0x0c, 0x56, 0x5c, 0xf4, 0x2a, 0x68,
+        0x97, 0x87, 0x13, 0xb6, 0x7a, 0xd1, 0x24, 0xfd,
+        0x4d, 0x3f, 0x77, 0x4a, 0xb9, 0xe4, 0x7d, 0xa2,
+        0xdb, 0xb9, 0x31, 0x5e, 0xa3, 0x11, 0x06, 0x80,
+        0xa1, 0x8d
+    };
+    std::array<std::uint8_t, 50> ciphertext{};
+
+    AESCTR aes_ctr(SP800_38A_Key_128, counter);
+
+    aes_ctr.Encrypt(std::span(SP800_38A_Plaintext).first(50), ciphertext);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+}
+
+// Ensure splitting input across calls yields the same result as one call
+STF_TEST(AESCTR, Streaming)
+{
+    const std::array<std::size_t, 9> chunk_sizes = {1, 15, 16, 17, 0, 127,
+                                                    128, 129, 300};
+    std::vector<std::uint8_t> plaintext(1000);
+    std::vector<std::uint8_t> expected_ciphertext(plaintext.size());
+    std::vector<std::uint8_t> ciphertext(plaintext.size());
+    std::size_t offset{};
+
+    for (std::size_t i = 0; i < plaintext.size(); i++)
+    {
+        plaintext[i] = static_cast<std::uint8_t>(i * 7);
+    }
+
+    AESCTR aes_ctr(SP800_38A_Key_128, SP800_38A_Counter);
+
+    // Encrypt with a single call
+    aes_ctr.Encrypt(plaintext, expected_ciphertext);
+
+    // Encrypt again in chunks of assorted sizes
+    aes_ctr.SetCounter(SP800_38A_Counter);
+    for (std::size_t i = 0; offset < plaintext.size(); i++)
+    {
+        std::size_t length = std::min(chunk_sizes[i % chunk_sizes.size()],
+                                      plaintext.size() - offset);
+        aes_ctr.Encrypt(std::span(plaintext).subspan(offset, length),
+                        std::span(ciphertext).subspan(offset, length));
+        offset += length;
+    }
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+}
+
+// Ensure encryption and decryption may be performed in place
+STF_TEST(AESCTR, InPlace)
+{
+    std::vector<std::uint8_t> expected_ciphertext(333);
+    std::vector<std::uint8_t> buffer(expected_ciphertext.size());
+
+    for (std::size_t i = 0; i < buffer.size(); i++)
+    {
+        buffer[i] = static_cast<std::uint8_t>(i);
+    }
+
+    AESCTR aes_ctr(SP800_38A_Key_128, SP800_38A_Counter);
+
+    aes_ctr.Encrypt(buffer, expected_ciphertext);
+
+    aes_ctr.SetCounter(SP800_38A_Counter);
+    aes_ctr.Encrypt(buffer, buffer);
+
+    STF_ASSERT_EQ(expected_ciphertext, buffer);
+
+    aes_ctr.SetCounter(SP800_38A_Counter);
+    aes_ctr.Decrypt(buffer, buffer);
+
+    for (std::size_t i = 0; i < buffer.size(); i++)
+    {
+        STF_ASSERT_EQ(static_cast<std::uint8_t>(i), buffer[i]);
+    }
+}
+
+// Ensure mismatched span lengths are rejected
+STF_TEST(AESCTR, InvalidLength)
+{
+    std::array<std::uint8_t, 32> ciphertext{};
+    bool exception_thrown = false;
+
+    AESCTR aes_ctr(SP800_38A_Key_128, SP800_38A_Counter);
+
+    try
+    {
+        aes_ctr.Encrypt(SP800_38A_Plaintext, ciphertext);
+    }
+    catch (const AESException &)
+    {
+        exception_thrown = true;
+    }
+
+    STF_ASSERT_TRUE(exception_thrown);
+}
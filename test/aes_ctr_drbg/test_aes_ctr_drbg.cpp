@@ -0,0 +1,376 @@
+/*
+ *  test_aes_ctr_drbg.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AES-256 CTR_DRBG logic, including the
+ *      buffering of output, additional input, reseeding, and prediction
+ *      resistance.  A deterministic entropy source is used so that the
+ *      output may be compared against known results.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <span>
+#include <thread>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+#include <terra/crypto/cipher/aes_ctr_drbg.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Entropy source producing a distinct, predictable value for each call
+struct TestEntropy
+{
+    std::size_t calls{};
+
+    AESEntropySource Source()
+    {
+        return [this](std::span<std::uint8_t> entropy)
+        {
+            for (std::size_t i = 0; i < entropy.size(); i++)
+            {
+                entropy[i] =
+                    static_cast<std::uint8_t>(calls * entropy.size() + i);
+            }
+            calls++;
+        };
+    }
+};
+
+// Personalization string used with the buffered output test
+constexpr std::array<std::uint8_t, 16> Personalization =
+{
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f
+};
+
+} // namespace
+
+// Test that buffered output matches known results and does not depend on
+// how the requests are divided
+STF_TEST(AESCTRDRBG, BufferedOutput)
+{
+    const std::array<std::uint8_t, 32> expected_1 =
+    {
+        0x06, 0x97, 0x64, 0xa0, 0xe8, 0x83, 0xa5, 0x5c,
+        0x64, 0x25, 0xcf, 0x3d, 0x72, 0xd8, 0x30, 0xe2,
+        0xa9, 0x60, 0x53, 0x48, 0xcc, 0xfa, 0x6a, 0x65,
+        0xe2, 0x89, 0x24, 0xd9, 0x7b, 0x29, 0xd4, 0x3c
+    };
+    const std::array<std::uint8_t, 32> expected_2 =
+    {
+        0x0c, 0xa4, 0x95, 0x17, 0x60, 0x7f, 0x55, 0x76,
+        0x14, 0x71, 0x78, 0xc0, 0xda, 0x8d, 0x99, 0xad,
+        0x86, 0xd5, 0x9c, 0xc0, 0x2b, 0x39, 0xb5, 0xf8,
+        0x27, 0xeb, 0x12, 0x6a, 0x40, 0x91, 0xd7, 0x3a
+    };
+    std::vector<std::uint8_t> whole(2 * AESCTRDRBG::Buffer_Size);
+    std::vector<std::uint8_t> pieces(whole.size());
+    TestEntropy entropy_1;
+    TestEntropy entropy_2;
+
+    AESCTRDRBG drbg_1(entropy_1.Source(), Personalization);
+    AESCTRDRBG drbg_2(entropy_2.Source(), Personalization);
+
+    drbg_1.Generate(whole);
+
+    // Each buffer is the output of one generate request
+    STF_ASSERT_MEM_EQ(expected_1.data(), whole.data(), expected_1.size());
+    STF_ASSERT_MEM_EQ(expected_2.data(),
+                      whole.data() + AESCTRDRBG::Buffer_Size,
+                      expected_2.size());
+
+    // Requests of varying length must produce the same octets
+    std::size_t position{};
+    for (std::size_t length = 1; position < pieces.size(); length += 7)
+    {
+        length = std::min(length, pieces.size() - position);
+        drbg_2.Generate(std::span(pieces).subspan(position, length));
+        position += length;
+    }
+    STF_ASSERT_EQ(whole, pieces);
+
+    // Only the instantiation requires entropy
+    STF_ASSERT_EQ(1, entropy_1.calls);
+    STF_ASSERT_EQ(1, entropy_2.calls);
+}
+
+// Test generate requests having additional input, one of which produces a
+// partial final block
+STF_TEST(AESCTRDRBG, AdditionalInput)
+{
+    const std::array<std::uint8_t, 16> additional_1 =
+    {
+        0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+        0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf
+    };
+    const std::array<std::uint8_t, 48> additional_2 =
+    {
+        0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+        0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+        0xd0, 0xd1, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7,
+        0xd8, 0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde, 0xdf,
+        0xe0, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7,
+        0xe8, 0xe9, 0xea, 0xeb, 0xec, 0xed, 0xee, 0xef
+    };
+    const std::array<std::uint8_t, 64> expected_1 =
+    {
+        0x98, 0x4c, 0x90, 0xa9, 0xd9, 0x10, 0xd4, 0x50,
+        0x11, 0xb0, 0x2e, 0xf1, 0xa9, 0x2d, 0xa4, 0x3d,
+        0xac, 0x01, 0x20, 0x57, 0xdb, 0x06, 0x34, 0x9b,
+        0x8d, 0x7d, 0x92, 0xae, 0x63, 0x6b, 0xc6, 0x18,
+        0xb8, 0x42, 0x46, 0x89, 0x3f, 0x71, 0x75, 0x29,
+        0xa2, 0xb2, 0xbe, 0x8c, 0x26, 0x9d, 0x6b, 0xec,
+        0x16, 0xc4, 0xd0, 0x11, 0xdf, 0xac, 0x51, 0x3c,
+        0x69, 0x8c, 0xfa, 0x62, 0x4b, 0x58, 0xb7, 0xa4
+    };
+    const std::array<std::uint8_t, 40> expected_2 =
+    {
+        0x1a, 0x35, 0x8d, 0x65, 0xe9, 0xe8, 0x51, 0x4d,
+        0xe1, 0xf5, 0x1b, 0x89, 0xa9, 0x49, 0xf4, 0x0b,
+        0x5d, 0xec, 0x9e, 0xb4, 0xd3, 0x33, 0x05, 0x13,
+        0x80, 0x4d, 0xb5, 0x2d, 0xa7, 0x2d, 0x62, 0xc2,
+        0x0b, 0x4b, 0xd3, 0xb4, 0x06, 0xd2, 0xf7, 0xea
+    };
+    std::array<std::uint8_t, 64> output_1{};
+    std::array<std::uint8_t, 40> output_2{};
+    TestEntropy entropy;
+
+    AESCTRDRBG drbg(entropy.Source());
+
+    drbg.Generate(output_1, additional_1);
+    STF_ASSERT_MEM_EQ(expected_1.data(), output_1.data(), output_1.size());
+
+    drbg.Generate(output_2, additional_2);
+    STF_ASSERT_MEM_EQ(expected_2.data(), output_2.data(), output_2.size());
+}
+
+// Test that prediction resistance reseeds before every request
+STF_TEST(AESCTRDRBG, PredictionResistance)
+{
+    const std::array<std::uint8_t, 32> expected =
+    {
+        0x7b, 0x58, 0x11, 0xe6, 0x34, 0xba, 0x47, 0xe2,
+        0x07, 0x90, 0x3d, 0x97, 0x81, 0xf7, 0xa1, 0xa3,
+        0xe8, 0x7e, 0x37, 0xfd, 0x93, 0xe2, 0x2a, 0xfb,
+        0x97, 0xbf, 0x7e, 0x49, 0x46, 0xc6, 0xa3, 0x2f
+    };
+    std::vector<std::uint8_t> output(100);
+    TestEntropy entropy;
+
+    AESCTRDRBG drbg(entropy.Source());
+
+    drbg.SetPredictionResistance(true);
+    STF_ASSERT_TRUE(drbg.GetPredictionResistance());
+
+    drbg.Generate(output);
+    STF_ASSERT_MEM_EQ(expected.data(), output.data(), expected.size());
+    STF_ASSERT_EQ(2, entropy.calls);
+
+    // Long outputs are divided into requests of the maximum length
+    output.resize(AESCTRDRBG::Max_Request_Length + 1);
+    drbg.Generate(output);
+    STF_ASSERT_EQ(4, entropy.calls);
+
+    // Buffered output resumes when prediction resistance is disabled
+    drbg.SetPredictionResistance(false);
+    drbg.Generate(output);
+    drbg.Generate(output);
+    STF_ASSERT_EQ(4, entropy.calls);
+}
+
+// Test that the DRBG is reseeded once the reseed interval is reached
+STF_TEST(AESCTRDRBG, ReseedInterval)
+{
+    const std::array<std::uint8_t, 32> expected =
+    {
+        0x84, 0xbb, 0xfe, 0xdf, 0x43, 0xe4, 0x8b, 0xa4,
+        0x97, 0x0f, 0x30, 0x54, 0x97, 0x60, 0xe8, 0xd8,
+        0x76, 0x4d, 0x0d, 0x49, 0x06, 0x2e, 0x5d, 0x30,
+        0xa5, 0x24, 0xa4, 0x0a, 0x8f, 0x92, 0x03, 0x7b
+    };
+    std::vector<std::uint8_t> output(3 * AESCTRDRBG::Buffer_Size);
+    TestEntropy entropy;
+
+    AESCTRDRBG drbg(entropy.Source());
+
+    drbg.SetReseedInterval(2);
+
+    // The third buffer exceeds the interval of two requests
+    drbg.Generate(output);
+    STF_ASSERT_EQ(2, entropy.calls);
+    STF_ASSERT_MEM_EQ(expected.data(),
+                      output.data() + 2 * AESCTRDRBG::Buffer_Size,
+                      expected.size());
+}
+
+// Test that an explicit reseed discards buffered output
+STF_TEST(AESCTRDRBG, Reseed)
+{
+    const std::array<std::uint8_t, 32> expected =
+    {
+        0x74, 0x81, 0xf1, 0xe2, 0x58, 0x5a, 0x93, 0x1b,
+        0xd2, 0xba, 0x40, 0x93, 0xe0, 0x92, 0x98, 0x91,
+        0xae, 0x70, 0x4f, 0x2e, 0xc9, 0x08, 0x6f, 0x0e,
+        0x69, 0xc8, 0x87, 0xbe, 0x8d, 0xea, 0xe2, 0x4e
+    };
+    const std::vector<std::uint8_t> additional(20, 0x55);
+    std::array<std::uint8_t, 32> output{};
+    TestEntropy entropy;
+
+    AESCTRDRBG drbg(entropy.Source());
+
+    drbg.Generate(output);
+    drbg.Reseed(additional);
+    STF_ASSERT_EQ(2, entropy.calls);
+
+    drbg.Generate(output);
+    STF_ASSERT_MEM_EQ(expected.data(), output.data(), output.size());
+}
+
+// Test that invalid lengths and intervals are rejected
+STF_TEST(AESCTRDRBG, InvalidParameters)
+{
+    const std::vector<std::uint8_t> too_long(AESCTRDRBG::Seed_Length + 1);
+    std::vector<std::uint8_t> output(AESCTRDRBG::Max_Request_Length + 1);
+    TestEntropy entropy;
+
+    STF_ASSERT_EXCEPTION_E(AESCTRDRBG(entropy.Source(), too_long),
+                           AESException);
+
+    AESCTRDRBG drbg(entropy.Source());
+
+    STF_ASSERT_EXCEPTION_E(drbg.Reseed(too_long), AESException);
+    STF_ASSERT_EXCEPTION_E(
+        drbg.Generate(std::span(output).first(16), too_long),
+        AESException);
+    STF_ASSERT_EXCEPTION_E(
+        drbg.Generate(output, std::span(too_long).first(16)),
+        AESException);
+    STF_ASSERT_EXCEPTION_E(drbg.SetReseedInterval(0), AESException);
+    STF_ASSERT_EXCEPTION_E(
+        drbg.SetReseedInterval(AESCTRDRBG::Max_Reseed_Interval + 1),
+        AESException);
+
+    // An entropy source that fails prevents instantiation
+    STF_ASSERT_EXCEPTION_E(
+        AESCTRDRBG([](std::span<std::uint8_t>)
+                   {
+                       throw AESException("No entropy");
+                   }),
+        AESException);
+}
+
+// Test that each thread has its own instance seeded from the system
+STF_TEST(AESCTRDRBG, ThreadInstance)
+{
+    AESCTRDRBG *instance_1 = &AESCTRDRBG::ThreadInstance();
+    AESCTRDRBG *instance_2{};
+    std::array<std::uint8_t, 32> output_1{};
+    std::array<std::uint8_t, 32> output_2{};
+
+    STF_ASSERT_EQ(instance_1, &AESCTRDRBG::ThreadInstance());
+
+    std::thread thread([&]()
+    {
+        instance_2 = &AESCTRDRBG::ThreadInstance();
+        instance_2->Generate(output_2);
+    });
+    thread.join();
+
+    instance_1->Generate(output_1);
+
+    STF_ASSERT_NE(instance_1, instance_2);
+    STF_ASSERT_NE(output_1, output_2);
+}
+
+// Test that the system entropy source fills the whole buffer and produces
+// different octets on each call
+STF_TEST(AESCTRDRBG, SystemEntropy)
+{
+    std::vector<std::uint8_t> entropy_1(4096);
+    std::vector<std::uint8_t> entropy_2(4096);
+    std::vector<std::uint8_t> empty;
+
+    AESCTRDRBG::SystemEntropy(entropy_1);
+    AESCTRDRBG::SystemEntropy(entropy_2);
+    AESCTRDRBG::SystemEntropy(empty);
+
+    STF_ASSERT_NE(entropy_1, entropy_2);
+
+    // The final octets are not left unset
+    STF_ASSERT_FALSE(std::all_of(entropy_1.end() - 64,
+                                 entropy_1.end(),
+                                 [](std::uint8_t octet) { return !octet; }));
+}
+
+#ifndef _WIN32
+// Test that a parent and child process produce different output after a
+// fork, both from the thread's instance and from an object with buffered
+// octets remaining
+STF_TEST(AESCTRDRBG, Fork)
+{
+    TestEntropy entropy;
+    AESCTRDRBG drbg(entropy.Source());
+    AESCTRDRBG &instance = AESCTRDRBG::ThreadInstance();
+    std::array<std::uint8_t, 16> output{};
+    std::array<std::uint8_t, 32> parent{};
+    std::array<std::uint8_t, 32> child{};
+    int pipe_fds[2]{};
+    int status{};
+
+    // Leave octets in each buffer before forking
+    drbg.Generate(output);
+    instance.Generate(output);
+
+    STF_ASSERT_EQ(pipe(pipe_fds), 0);
+
+    pid_t pid = fork();
+    STF_ASSERT_GE(pid, 0);
+
+    if (pid == 0)
+    {
+        drbg.Generate(std::span(child).first(16));
+        instance.Generate(std::span(child).subspan(16));
+        bool written =
+            write(pipe_fds[1], child.data(), child.size()) ==
+                static_cast<ssize_t>(child.size());
+        _exit(written ? 0 : 1);
+    }
+
+    drbg.Generate(std::span(parent).first(16));
+    instance.Generate(std::span(parent).subspan(16));
+
+    close(pipe_fds[1]);
+    STF_ASSERT_EQ(read(pipe_fds[0], child.data(), child.size()),
+                  static_cast<ssize_t>(child.size()));
+    close(pipe_fds[0]);
+
+    STF_ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    STF_ASSERT_TRUE(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+
+    STF_ASSERT_FALSE(
+        std::equal(parent.begin(), parent.begin() + 16, child.begin()));
+    STF_ASSERT_FALSE(
+        std::equal(parent.begin() + 16, parent.end(), child.begin() + 16));
+}
+#endif
@@ -0,0 +1,506 @@
+/*
+ *  test_aes_gcm.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AES Galois/Counter Mode (GCM) logic.
+ *      Test vectors are from McGrew and Viega, "The Galois/Counter Mode of
+ *      Operation (GCM)", Appendix B.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <span>
+#include <terra/crypto/cipher/aes_gcm.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Key used in test cases 2 through 6
+constexpr std::array<std::uint8_t, 16> Test_Key =
+{
+    0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+    0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08
+};
+
+// IV used in test cases 3 and 4
+constexpr std::array<std::uint8_t, 12> Test_IV =
+{
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+    0xde, 0xca, 0xf8, 0x88
+};
+
+// Plaintext used in test cases 4 through 6
+constexpr std::array<std::uint8_t, 60> Test_Plaintext =
+{
+    0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5,
+    0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+    0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda,
+    0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+    0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53,
+    0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+    0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57,
+    0xba, 0x63, 0x7b, 0x39
+};
+
+// Additional authenticated data used in test cases 4 through 6
+constexpr std::array<std::uint8_t, 20> Test_AAD =
+{
+    0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+    0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+    0xab, 0xad, 0xda, 0xd2
+};
+
+} // namespace
+
+// Test case 1: empty plaintext and AAD
+STF_TEST(AESGCM, TestCase1)
+{
+    const std::array<std::uint8_t, 16> key{};
+    const std::array<std::uint8_t, 12> iv{};
+    const std::array<std::uint8_t, 16> expected_tag =
+    {
+        0x58, 0xe2, 0xfc, 0xce, 0xfa, 0x7e, 0x30, 0x61,
+        0x36, 0x7f, 0x1d, 0x57, 0xa4, 0xe7, 0x45, 0x5a
+    };
+    std::array<std::uint8_t, 16> tag{};
+
+    AESGCM aes_gcm(key);
+
+    aes_gcm.Encrypt(iv, {}, {}, {}, tag);
+
+    STF_ASSERT_EQ(expected_tag, tag);
+
+    STF_ASSERT_TRUE(aes_gcm.Decrypt(iv, {}, {}, {}, tag));
+}
+
+// Test case 2: a single zero block
+STF_TEST(AESGCM, TestCase2)
+{
+    const std::array<std::uint8_t, 16> key{};
+    const std::array<std::uint8_t, 12> iv{};
+    const std::array<std::uint8_t, 16> plaintext{};
+    const std::array<std::uint8_t, 16> expected_ciphertext =
+    {
+        0x03, 0x88, 0xda, 0xce, 0x60, 0xb6, 0xa3, 0x92,
+        0xf3, 0x28, 0xc2, 0xb9, 0x71, 0xb2, 0xfe, 0x78
+    };
+    const std::array<std::uint8_t, 16> expected_tag =
+    {
+        0xab, 0x6e, 0x47, 0xd4, 0x2c, 0xec, 0x13, 0xbd,
+        0xf5, 0x3a, 0x67, 0xb2, 0x12, 0x57, 0xbd, 0xdf
+    };
+    std::array<std::uint8_t, 16> ciphertext{};
+    std::array<std::uint8_t, 16> plaintext_check{};
+    std::array<std::uint8_t, 16> tag{};
+
+    AESGCM aes_gcm(key);
+
+    aes_gcm.Encrypt(iv, {}, plaintext, ciphertext, tag);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+    STF_ASSERT_EQ(expected_tag, tag);
+
+    STF_ASSERT_TRUE(aes_gcm.Decrypt(iv, {}, ciphertext, plaintext_check, tag));
+
+    STF_ASSERT_EQ(plaintext, plaintext_check);
+}
+
+// Test case 4: partial final block with AAD
+STF_TEST(AESGCM, TestCase4)
+{
+    const std::array<std::uint8_t, 60> expected_ciphertext =
+    {
+        0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24,
+        0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+        0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0,
+        0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+        0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c,
+        0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+        0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97,
+        0x3d, 0x58, 0xe0, 0x91
+    };
+    const std::array<std::uint8_t, 16> expected_tag =
+    {
+        0x5b, 0xc9, 0x4f, 0xbc, 0x32, 0x21, 0xa5, 0xdb,
+        0x94, 0xfa, 0xe9, 0x5a, 0xe7, 0x12, 0x1a, 0x47
+    };
+    std::array<std::uint8_t, 60> ciphertext{};
+    std::array<std::uint8_t, 60> plaintext{};
+    std::array<std::uint8_t, 16> tag{};
+
+    AESGCM aes_gcm(Test_Key);
+
+    aes_gcm.Encrypt(Test_IV, Test_AAD, Test_Plaintext, ciphertext, tag);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+    STF_ASSERT_EQ(expected_tag, tag);
+
+    STF_ASSERT_TRUE(
+        aes_gcm.Decrypt(Test_IV, Test_AAD, ciphertext, plaintext, tag));
+
+    STF_ASSERT_EQ(Test_Plaintext, plaintext);
+}
+
+// Test case 5: 64-bit IV, which requires J0 be computed with GHASH
+STF_TEST(AESGCM, TestCase5)
+{
+    const std::array<std::uint8_t, 8> iv =
+    {
+        0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad
+    };
+    const std::array<std::uint8_t, 60> expected_ciphertext =
+    {
+        0x61, 0x35, 0x3b, 0x4c, 0x28, 0x06, 0x93, 0x4a,
+        0x77, 0x7f, 0xf5, 0x1f, 0xa2, 0x2a, 0x47, 0x55,
+        0x69, 0x9b, 0x2a, 0x71, 0x4f, 0xcd, 0xc6, 0xf8,
+        0x37, 0x66, 0xe5, 0xf9, 0x7b, 0x6c, 0x74, 0x23,
+        0x73, 0x80, 0x69, 0x00, 0xe4, 0x9f, 0x24, 0xb2,
+        0x2b, 0x09, 0x75, 0x44, 0xd4, 0x89, 0x6b, 0x42,
+        0x49, 0x89, 0xb5, 0xe1, 0xeb, 0xac, 0x0f, 0x07,
+        0xc2, 0x3f, 0x45, 0x98
+    };
+    const std::array<std::uint8_t, 16> expected_tag =
+    {
+        0x36, 0x12, 0xd2, 0xe7, 0x9e, 0x3b, 0x07, 0x85,
+        0x56, 0x1b, 0xe1, 0x4a, 0xac, 0xa2, 0xfc, 0xcb
+    };
+    std::array<std::uint8_t, 60> ciphertext{};
+    std::array<std::uint8_t, 60> plaintext{};
+    std::array<std::uint8_t, 16> tag{};
+
+    AESGCM aes_gcm(Test_Key);
+
+    aes_gcm.Encrypt(iv, Test_AAD, Test_Plaintext, ciphertext, tag);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+    STF_ASSERT_EQ(expected_tag, tag);
+
+    STF_ASSERT_TRUE(aes_gcm.Decrypt(iv, Test_AAD, ciphertext, plaintext, tag));
+
+    STF_ASSERT_EQ(Test_Plaintext, plaintext);
+}
+
+// Test case 16: AES-256 with partial final block and AAD
+STF_TEST(AESGCM, TestCase16)
+{
+    const std::array<std::uint8_t, 32> key =
+    {
+        0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+        0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+        0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+        0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08
+    };
+    const std::array<std::uint8_t, 60> expected_ciphertext =
+    {
+        0x52, 0x2d, 0xc1, 0xf0, 0x99, 0x56, 0x7d, 0x07,
+        0xf4, 0x7f, 0x37, 0xa3, 0x2a, 0x84, 0x42, 0x7d,
+        0x64, 0x3a, 0x8c, 0xdc, 0xbf, 0xe5, 0xc0, 0xc9,
+        0x75, 0x98, 0xa2, 0xbd, 0x25, 0x55, 0xd1, 0xaa,
+        0x8c, 0xb0, 0x8e, 0x48, 0x59, 0x0d, 0xbb, 0x3d,
+        0xa7, 0xb0, 0x8b, 0x10, 0x56, 0x82, 0x88, 0x38,
+        0xc5, 0xf6, 0x1e, 0x63, 0x93, 0xba, 0x7a, 0x0a,
+        0xbc, 0xc9, 0xf6, 0x62
+    };
+    const std::array<std::uint8_t, 16> expected_tag =
+    {
+        0x76, 0xfc, 0x6e, 0xce, 0x0f, 0x4e, 0x17, 0x68,
+        0xcd, 0xdf, 0x88, 0x53, 0xbb, 0x2d, 0x55, 0x1b
+    };
+    std::array<std::uint8_t, 60> ciphertext{};
+    std::array<std::uint8_t, 16> tag{};
+
+    AESGCM aes_gcm;
+
+    aes_gcm.SetKey(key);
+    aes_gcm.Encrypt(Test_IV, Test_AAD, Test_Plaintext, ciphertext, tag);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+    STF_ASSERT_EQ(expected_tag, tag);
+}
+
+// A message spanning multiple eight-block groups, encrypted in place
+STF_TEST(AESGCM, LongMessageInPlace)
+{
+    std::array<std::uint8_t, 16> key{};
+    std::array<std::uint8_t, 12> iv{};
+    std::array<std::uint8_t, 20> aad{};
+    std::vector<std::uint8_t> buffer(200);
+    std::array<std::uint8_t, 16> tag{};
+    const std::array<std::uint8_t, 200> expected_ciphertext =
+    {
+        0xc4, 0x2d, 0x05, 0xa6, 0x03, 0x40, 0xa4, 0xfa,
+        0x0f, 0xc6, 0x43, 0xd4, 0xe3, 0x00, 0xc1, 0x13,
+        0x0a, 0x8f, 0x42, 0xbe, 0x0a, 0xcb, 0x29, 0xfa,
+        0xcd, 0x80, 0x67, 0x40, 0x33, 0x52, 0x4b, 0xf0,
+        0xb2, 0xba, 0x47, 0x56, 0xed, 0xc9, 0x89, 0x69,
+        0x9b, 0xdb, 0xab, 0x49, 0x5e, 0x57, 0xdb, 0x96,
+        0x19, 0x2b, 0x67, 0xb2, 0x65, 0x5c, 0x19, 0x4d,
+        0xc3, 0xbe, 0x83, 0x07, 0x33, 0x27, 0xfc, 0x25,
+        0x9e, 0x9b, 0xd4, 0x6d, 0xee, 0x58, 0xaf, 0x4e,
+        0x16, 0x5b, 0xa4, 0xa1, 0x49, 0x46, 0x46, 0xcc,
+        0x86, 0x71, 0x42, 0x77, 0x85, 0x3c, 0xac, 0xd5,
+        0x55, 0x73, 0x9d, 0xf6, 0xe4, 0xc7, 0xe7, 0x6b,
+        0xb1, 0x03, 0xe6, 0xb1, 0x8d, 0xe0, 0x8f, 0xfc,
+        0x29, 0x52, 0xab, 0xfe, 0xa7, 0x38, 0x49, 0xd6,
+        0x0c, 0x98, 0x28, 0xbd, 0xa2, 0xc9, 0xea, 0x8b,
+        0xd1, 0xf6, 0xcf, 0x12, 0xfb, 0x2b, 0x05, 0xdc,
+        0xbc, 0x36, 0x64, 0x6a, 0xa6, 0x64, 0x2b, 0x97,
+        0x52, 0xc3, 0x1c, 0xa4, 0xa0, 0xf8, 0xca, 0xba,
+        0x70, 0x7b, 0x9e, 0xf1, 0xf1, 0x0a, 0xd2, 0xcc,
+        0x9a, 0x32, 0x34, 0x3e, 0xd0, 0x66, 0xc5, 0x63,
+        0x86, 0x63, 0x44, 0xc9, 0x2e, 0x32, 0x4b, 0x57,
+        0x88, 0x60, 0x20, 0xf7, 0x55, 0x42, 0xb5, 0x86,
+        0x0f, 0x4a, 0x13, 0xcb, 0xf4, 0x20, 0x3e, 0xa0,
+        0x60, 0x1d, 0xcf, 0x91, 0xbc, 0x33, 0x14, 0x43,
+        0xfa, 0xea, 0xdc, 0x94, 0x39, 0xa2, 0x7e, 0xcf
+    };
+    const std::array<std::uint8_t, 16> expected_tag =
+    {
+        0xab, 0x59, 0xe0, 0x28, 0xc7, 0x55, 0xef, 0x76,
+        0x7b, 0x57, 0x78, 0x90, 0xda, 0x63, 0x23, 0xb0
+    };
+
+    for (std::size_t i = 0; i < key.size(); i++)
+    {
+        key[i] = static_cast<std::uint8_t>(i);
+    }
+    for (std::size_t i = 0; i < iv.size(); i++)
+    {
+        iv[i] = static_cast<std::uint8_t>(0x10 + i);
+    }
+    for (std::size_t i = 0; i < aad.size(); i++)
+    {
+        aad[i] = static_cast<std::uint8_t>(0x20 + i);
+    }
+    for (std::size_t i = 0; i < buffer.size(); i++)
+    {
+        buffer[i] = static_cast<std::uint8_t>(i * 3);
+    }
+
+    AESGCM aes_gcm(key);
+
+    aes_gcm.Encrypt(iv, aad, buffer, buffer, tag);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext.data(),
+                      buffer.data(),
+                      expected_ciphertext.size());
+    STF_ASSERT_EQ(expected_tag, tag);
+
+    STF_ASSERT_TRUE(aes_gcm.Decrypt(iv, aad, buffer, buffer, tag));
+
+    for (std::size_t i = 0; i < buffer.size(); i++)
+    {
+        STF_ASSERT_EQ(static_cast<std::uint8_t>(i * 3), buffer[i]);
+    }
+}
+
+// Truncated tags are the leading octets of the full tag
+STF_TEST(AESGCM, TruncatedTag)
+{
+    std::array<std::uint8_t, 60> ciphertext{};
+    std::array<std::uint8_t, 60> plaintext{};
+    std::array<std::uint8_t, 16> full_tag{};
+    std::array<std::uint8_t, 12> tag{};
+
+    AESGCM aes_gcm(Test_Key);
+
+    aes_gcm.Encrypt(Test_IV, Test_AAD, Test_Plaintext, ciphertext, full_tag);
+    aes_gcm.Encrypt(Test_IV, Test_AAD, Test_Plaintext, ciphertext, tag);
+
+    STF_ASSERT_MEM_EQ(full_tag.data(), tag.data(), tag.size());
+
+    STF_ASSERT_TRUE(
+        aes_gcm.Decrypt(Test_IV, Test_AAD, ciphertext, plaintext, tag));
+
+    STF_ASSERT_EQ(Test_Plaintext, plaintext);
+}
+
+// Modified ciphertext, AAD, or tag must fail authentication
+STF_TEST(AESGCM, AuthenticationFailure)
+{
+    std::array<std::uint8_t, 60> ciphertext{};
+    std::array<std::uint8_t, 60> plaintext{};
+    std::array<std::uint8_t, 20> aad = Test_AAD;
+    std::array<std::uint8_t, 16> tag{};
+    const std::array<std::uint8_t, 60> zero_plaintext{};
+
+    AESGCM aes_gcm(Test_Key);
+
+    aes_gcm.Encrypt(Test_IV, Test_AAD, Test_Plaintext, ciphertext, tag);
+
+    // Modify the ciphertext
+    ciphertext[59] ^= 0x01;
+    STF_ASSERT_FALSE(
+        aes_gcm.Decrypt(Test_IV, Test_AAD, ciphertext, plaintext, tag));
+    ciphertext[59] ^= 0x01;
+
+    // The plaintext buffer must be cleared on failure
+    STF_ASSERT_EQ(zero_plaintext, plaintext);
+
+    // Modify the AAD
+    aad[0] ^= 0x80;
+    STF_ASSERT_FALSE(aes_gcm.Decrypt(Test_IV, aad, ciphertext, plaintext, tag));
+
+    // Modify the tag
+    tag[15] ^= 0x01;
+    STF_ASSERT_FALSE(
+        aes_gcm.Decrypt(Test_IV, Test_AAD, ciphertext, plaintext, tag));
+    tag[15] ^= 0x01;
+
+    // Verify the unmodified inputs still succeed
+    STF_ASSERT_TRUE(
+        aes_gcm.Decrypt(Test_IV, Test_AAD, ciphertext, plaintext, tag));
+}
+
+// Ensure invalid span lengths are rejected
+STF_TEST(AESGCM, InvalidLength)
+{
+    std::array<std::uint8_t, 60> ciphertext{};
+    std::array<std::uint8_t, 59> short_ciphertext{};
+    std::array<std::uint8_t, 16> tag{};
+    std::array<std::uint8_t, 10> invalid_tag{};
+    std::size_t exceptions{};
+
+    AESGCM aes_gcm(Test_Key);
+
+    try
+    {
+        aes_gcm.Encrypt({}, Test_AAD, Test_Plaintext, ciphertext, tag);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    try
+    {
+        aes_gcm.Encrypt(Test_IV, Test_AAD, Test_Plaintext, short_ciphertext,
+                        tag);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    try
+    {
+        aes_gcm.Encrypt(Test_IV, Test_AAD, Test_Plaintext, ciphertext,
+                        invalid_tag);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    STF_ASSERT_EQ(std::size_t(3), exceptions);
+}
+
+// Incremental processing must produce the same result as a single call
+STF_TEST(AESGCM, Incremental)
+{
+    std::array<std::uint8_t, 60> expected_ciphertext{};
+    std::array<std::uint8_t, 16> expected_tag{};
+    std::array<std::uint8_t, 60> ciphertext{};
+    std::array<std::uint8_t, 60> plaintext{};
+    std::array<std::uint8_t, 16> tag{};
+    const std::span<const std::uint8_t> input(Test_Plaintext);
+    const std::span<std::uint8_t> output(ciphertext);
+    std::size_t exceptions{};
+
+    AESGCM aes_gcm(Test_Key);
+
+    aes_gcm.Encrypt(Test_IV,
+                    Test_AAD,
+                    Test_Plaintext,
+                    expected_ciphertext,
+                    expected_tag);
+
+    // Encrypt in parts, with only the last holding a partial block
+    aes_gcm.Start(Test_IV, Test_AAD);
+    aes_gcm.EncryptUpdate(input.first(16), output.first(16));
+    aes_gcm.EncryptUpdate(input.subspan(16, 0), output.subspan(16, 0));
+    aes_gcm.EncryptUpdate(input.subspan(16, 32), output.subspan(16, 32));
+    aes_gcm.EncryptUpdate(input.subspan(48), output.subspan(48));
+    aes_gcm.Final(tag);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+    STF_ASSERT_EQ(expected_tag, tag);
+
+    // Decrypt in parts
+    aes_gcm.Start(Test_IV, Test_AAD);
+    aes_gcm.DecryptUpdate(std::span(ciphertext).first(32),
+                          std::span(plaintext).first(32));
+    aes_gcm.DecryptUpdate(std::span(ciphertext).subspan(32),
+                          std::span(plaintext).subspan(32));
+    STF_ASSERT_TRUE(aes_gcm.Verify(tag));
+
+    STF_ASSERT_EQ(Test_Plaintext, plaintext);
+
+    // A modified tag must fail verification
+    tag[0] ^= 0x01;
+    aes_gcm.Start(Test_IV, Test_AAD);
+    aes_gcm.DecryptUpdate(ciphertext, plaintext);
+    STF_ASSERT_FALSE(aes_gcm.Verify(tag));
+
+    // Only the final update may hold a partial block
+    aes_gcm.Start(Test_IV, Test_AAD);
+    aes_gcm.EncryptUpdate(input.first(20), output.first(20));
+
+    try
+    {
+        aes_gcm.EncryptUpdate(input.subspan(20), output.subspan(20));
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    STF_ASSERT_EQ(std::size_t(1), exceptions);
+}
+
+// Completing a message more than once must give the same result, and the
+// message may not be extended once complete
+STF_TEST(AESGCM, RepeatedFinal)
+{
+    std::array<std::uint8_t, 60> ciphertext{};
+    std::array<std::uint8_t, 60> plaintext{};
+    std::array<std::uint8_t, 16> tag{};
+    std::array<std::uint8_t, 16> second_tag{};
+
+    AESGCM aes_gcm(Test_Key);
+
+    aes_gcm.Start(Test_IV, Test_AAD);
+    aes_gcm.EncryptUpdate(Test_Plaintext, ciphertext);
+    aes_gcm.Final(tag);
+    aes_gcm.Final(second_tag);
+
+    STF_ASSERT_EQ(tag, second_tag);
+
+    STF_ASSERT_EXCEPTION_E(aes_gcm.EncryptUpdate(Test_Plaintext, ciphertext),
+                           AESException);
+
+    aes_gcm.Start(Test_IV, Test_AAD);
+    aes_gcm.DecryptUpdate(ciphertext, plaintext);
+    STF_ASSERT_TRUE(aes_gcm.Verify(tag));
+    STF_ASSERT_TRUE(aes_gcm.Verify(tag));
+
+    STF_ASSERT_EXCEPTION_E(aes_gcm.DecryptUpdate(ciphertext, plaintext),
+                           AESException);
+
+    STF_ASSERT_EQ(Test_Plaintext, plaintext);
+}
@@ -0,0 +1,337 @@
+/*
+ *  test_aes_inline.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AESInline object with whichever
+ *      underlying AES engine is employed, comparing results against the
+ *      AES object.  Test sections referenced are from the FIPS 197
+ *      specification.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <terra/crypto/cipher/aes.h>
+#include <terra/crypto/cipher/aes_inline.h>
+#include <terra/stf/adapters/integral_vector.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+const std::uint8_t aes_key[32] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+const std::uint8_t plaintext[16] =
+{
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+
+// Ciphertext from Appendix C.3
+const std::uint8_t expected_ciphertext_256[16] =
+{
+    0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+    0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+};
+
+} // namespace
+
+// Test that one of the default engines was selected
+STF_TEST(AESInline, EngineCheck)
+{
+    AESInline aes;
+
+    STF_ASSERT_NE(aes.GetEngineType(), AESEngineType::Unavailable);
+    STF_ASSERT_NE(aes.GetEngineType(), AESEngineType::Bitsliced);
+}
+
+// Test from Appendix C.1
+STF_TEST(AESInline, TestVectorC1128)
+{
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+        0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+    };
+
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    AESInline aes({aes_key, 16});
+
+    aes.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+
+    aes.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test from Appendix C.2
+STF_TEST(AESInline, TestVectorC2192)
+{
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0,
+        0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91
+    };
+
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    AESInline aes({aes_key, 24});
+
+    aes.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+
+    aes.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test from Appendix C.3
+STF_TEST(AESInline, TestVectorC3256)
+{
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    AESInline aes(aes_key);
+
+    aes.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                      ciphertext,
+                      sizeof(expected_ciphertext_256));
+
+    aes.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test copy constructor and assignment
+STF_TEST(AESInline, TestCopy)
+{
+    std::uint8_t ciphertext[16];
+
+    AESInline aes1(aes_key);
+    AESInline aes2 = aes1;
+    AESInline aes3({aes_key, 16});
+
+    aes2.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                      ciphertext,
+                      sizeof(expected_ciphertext_256));
+
+    aes3 = aes1;
+
+    aes3.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                      ciphertext,
+                      sizeof(expected_ciphertext_256));
+}
+
+// Test move constructor and move assignment
+STF_TEST(AESInline, TestMove)
+{
+    std::uint8_t ciphertext[16];
+
+    AESInline aes1(aes_key);
+    AESInline reference(aes_key);
+
+    AESInline aes2(std::move(aes1));
+
+    aes2.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                      ciphertext,
+                      sizeof(expected_ciphertext_256));
+
+    // The key state of the moved-from object is cleared
+    STF_ASSERT_TRUE(aes1 != reference);
+
+    AESInline aes3;
+
+    aes3 = std::move(aes2);
+
+    aes3.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                      ciphertext,
+                      sizeof(expected_ciphertext_256));
+
+    STF_ASSERT_TRUE(aes2 != reference);
+}
+
+// Test equality and inequality
+STF_TEST(AESInline, TestEquality)
+{
+    AESInline aes1(aes_key);
+    AESInline aes2(aes_key);
+    AESInline aes3({aes_key, 16});
+
+    STF_ASSERT_TRUE(aes1 == aes2);
+    STF_ASSERT_FALSE(aes1 != aes2);
+    STF_ASSERT_TRUE(aes1 != aes3);
+
+    aes3.SetKey(aes_key);
+
+    STF_ASSERT_TRUE(aes1 == aes3);
+}
+
+// Compare multi-block operations against the AES object
+STF_TEST(AESInline, TestEncryptDecryptBlocks)
+{
+    for (std::size_t key_length : {16, 24, 32})
+    {
+        AES aes({aes_key, key_length});
+        AESInline aes_inline({aes_key, key_length});
+
+        for (std::size_t blocks = 1; blocks <= 21; blocks++)
+        {
+            std::vector<std::uint8_t> data(blocks * 16);
+            std::vector<std::uint8_t> expected(blocks * 16);
+            std::vector<std::uint8_t> ciphertext(blocks * 16);
+
+            for (std::size_t i = 0; i < data.size(); i++)
+            {
+                data[i] = static_cast<std::uint8_t>(i * 7 + blocks);
+            }
+
+            aes.EncryptBlocks(data, expected);
+
+            aes_inline.EncryptBlocks(data, ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+
+            // Decrypt in place
+            aes_inline.DecryptBlocks(ciphertext, ciphertext);
+            STF_ASSERT_EQ(data, ciphertext);
+        }
+    }
+}
+
+// Test that decrypting with a key set for encryption only is rejected
+STF_TEST(AESInline, TestEncryptOnly)
+{
+    AESInline aes_inline({aes_key, 16}, AESKeyUsage::EncryptOnly);
+    std::vector<std::uint8_t> data(32);
+
+    STF_ASSERT_EQ(AESKeyUsage::EncryptOnly, aes_inline.GetKeyUsage());
+    STF_ASSERT_EXCEPTION_E(aes_inline.DecryptBlocks(data, data),
+                           AESException);
+
+    // The usage is carried by copies and replaced when the key is set
+    AESInline copy(aes_inline);
+    STF_ASSERT_EXCEPTION_E(copy.DecryptBlocks(data, data), AESException);
+
+    copy.SetKey({aes_key, 16});
+    STF_ASSERT_EQ(AESKeyUsage::EncryptDecrypt, copy.GetKeyUsage());
+    copy.DecryptBlocks(data, data);
+}
+
+// Test that an invalid key length is rejected
+STF_TEST(AESInline, TestInvalidKey)
+{
+    bool expected_failure = false;
+
+    try
+    {
+        AESInline aes({aes_key, 20});
+    }
+    catch (const AESException &)
+    {
+        expected_failure = true;
+    }
+
+    STF_ASSERT_TRUE(expected_failure);
+}
+
+// Test that the batch API rejects spans that are not whole blocks
+STF_TEST(AESInline, TestBlocksInvalidLength)
+{
+    std::vector<std::uint8_t> data(24);
+    std::vector<std::uint8_t> output(32);
+    bool expected_failure = false;
+
+    AESInline aes(aes_key);
+
+    // Partial block
+    try
+    {
+        aes.EncryptBlocks(data, std::span<std::uint8_t>(output.data(), 24));
+    }
+    catch (const AESException &)
+    {
+        expected_failure = true;
+    }
+
+    STF_ASSERT_TRUE(expected_failure);
+
+    // Mismatched lengths
+    expected_failure = false;
+    try
+    {
+        aes.DecryptBlocks(std::span<const std::uint8_t>(data.data(), 16),
+                          output);
+    }
+    catch (const AESException &)
+    {
+        expected_failure = true;
+    }
+
+    STF_ASSERT_TRUE(expected_failure);
+}
+
+// Test that the engine preferred by the process is used when possible
+STF_TEST(AESInline, TestPreferredEngine)
+{
+    AESEngineType original_engine = AES::GetPreferredEngine();
+    AESInline aes_default;
+
+    AES::SetPreferredEngine(AESEngineType::Universal);
+
+    AESInline aes_universal(aes_key);
+    STF_ASSERT_EQ(aes_universal.GetEngineType(), AESEngineType::Universal);
+
+    std::uint8_t ciphertext[16];
+
+    aes_universal.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                      ciphertext,
+                      sizeof(expected_ciphertext_256));
+
+    // The bitsliced engine is not held inline, so the usual selection is used
+    AES::SetPreferredEngine(AESEngineType::Bitsliced);
+
+    AESInline aes_fallback;
+    STF_ASSERT_EQ(aes_fallback.GetEngineType(), aes_default.GetEngineType());
+
+    AES::SetPreferredEngine(original_engine);
+}
@@ -0,0 +1,305 @@
+/*
+ *  test_aes_instrumentation.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the instrumentation counters and hook.  If
+ *      the library was not built with TERRA_ENABLE_AES_INSTRUMENTATION, the
+ *      tests verify that nothing is counted.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <terra/crypto/cipher/aes.h>
+#include <terra/crypto/cipher/aes_ccm.h>
+#include <terra/crypto/cipher/aes_cmac.h>
+#include <terra/crypto/cipher/aes_gcm.h>
+#include <terra/crypto/cipher/aes_key_wrap.h>
+#include <terra/crypto/cipher/aes_ocb.h>
+#include <terra/crypto/cipher/aes_stream.h>
+#include <terra/crypto/cipher/aes_instrumentation.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+const std::array<std::uint8_t, 16> aes_key =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+// Counts of events passed to the hook
+std::atomic<std::uint64_t> hook_calls{};
+std::atomic<std::uint64_t> hook_blocks_encrypted{};
+
+void Hook(AESEngineType engine_type, AESCounter counter, std::uint64_t count)
+{
+    hook_calls++;
+    if ((engine_type == AESEngineType::Universal) &&
+        (counter == AESCounter::BlocksEncrypted))
+    {
+        hook_blocks_encrypted += count;
+    }
+}
+
+// Return the counters for the given engine
+AESEngineCounters Counters(AESEngineType engine_type)
+{
+    return GetAESInstrumentation()[static_cast<std::size_t>(engine_type)];
+}
+
+} // namespace
+
+// Test that block and key setup counts are attributed to the engine used
+STF_TEST(AESInstrumentation, BlockCounts)
+{
+    std::array<std::uint8_t, 16 * 4> buffer{};
+
+    ResetAESInstrumentation();
+
+    AES aes(aes_key, AESEngineType::Universal);
+
+    aes.Encrypt(std::span<std::uint8_t, 16>(buffer.data(), 16),
+                std::span<std::uint8_t, 16>(buffer.data(), 16));
+    aes.EncryptBlocks(buffer, buffer);
+    aes.Decrypt(std::span<std::uint8_t, 16>(buffer.data(), 16),
+                std::span<std::uint8_t, 16>(buffer.data(), 16));
+    aes.DecryptBlocks(std::span<std::uint8_t>(buffer.data(), 32),
+                      std::span<std::uint8_t>(buffer.data(), 32));
+
+    AESEngineCounters counters = Counters(AESEngineType::Universal);
+
+    if (!AESInstrumentationEnabled())
+    {
+        STF_ASSERT_EQ(0, counters.key_setups);
+        STF_ASSERT_EQ(0, counters.blocks_encrypted);
+        STF_ASSERT_EQ(0, counters.blocks_decrypted);
+        return;
+    }
+
+    STF_ASSERT_EQ(1, counters.key_setups);
+    STF_ASSERT_EQ(5, counters.blocks_encrypted);
+    STF_ASSERT_EQ(3, counters.blocks_decrypted);
+
+    // No work was attributed to another engine
+    STF_ASSERT_EQ(0, Counters(AESEngineType::Bitsliced).blocks_encrypted);
+
+    // Resetting clears the counters
+    ResetAESInstrumentation();
+    counters = Counters(AESEngineType::Universal);
+    STF_ASSERT_EQ(0, counters.key_setups);
+    STF_ASSERT_EQ(0, counters.blocks_encrypted);
+    STF_ASSERT_EQ(0, counters.blocks_decrypted);
+}
+
+// Test that key wrap, unwrap, and integrity failures are counted
+STF_TEST(AESInstrumentation, KeyWrapCounts)
+{
+    const std::array<std::uint8_t, 16> plaintext{};
+    std::array<std::uint8_t, 24> ciphertext{};
+    std::array<std::uint8_t, 16> unwrapped{};
+    std::array<std::uint8_t, 24> padded_ciphertext{};
+    std::array<std::uint8_t, 24> padded_unwrapped{};
+
+    ResetAESInstrumentation();
+
+    AESKeyWrap aes_key_wrap(aes_key);
+
+    aes_key_wrap.Wrap(plaintext, ciphertext);
+    STF_ASSERT_TRUE(aes_key_wrap.Unwrap(ciphertext, unwrapped));
+
+    ciphertext[0] ^= 0x01;
+    STF_ASSERT_FALSE(aes_key_wrap.Unwrap(ciphertext, unwrapped));
+
+    std::size_t length = aes_key_wrap.WrapWithPadding(
+        std::span<const std::uint8_t>(plaintext.data(), 9),
+        padded_ciphertext);
+    STF_ASSERT_EQ(9, aes_key_wrap.UnwrapWithPadding(
+        std::span<const std::uint8_t>(padded_ciphertext.data(), length),
+        padded_unwrapped));
+
+    AESEngineCounters counters = Counters(AES(aes_key).GetEngineType());
+
+    if (!AESInstrumentationEnabled())
+    {
+        STF_ASSERT_EQ(0, counters.key_wraps);
+        STF_ASSERT_EQ(0, counters.key_unwraps);
+        STF_ASSERT_EQ(0, counters.integrity_failures);
+        return;
+    }
+
+    STF_ASSERT_EQ(2, counters.key_wraps);
+    STF_ASSERT_EQ(3, counters.key_unwraps);
+    STF_ASSERT_EQ(1, counters.integrity_failures);
+
+    // The AES operations performed by key wrap are counted as well
+    STF_ASSERT_GT(counters.blocks_encrypted, 0);
+    STF_ASSERT_GT(counters.blocks_decrypted, 0);
+}
+
+// Test that GCM authentication failures are counted
+STF_TEST(AESInstrumentation, GCMIntegrityFailure)
+{
+    const std::array<std::uint8_t, 12> iv{};
+    std::array<std::uint8_t, 32> plaintext{};
+    std::array<std::uint8_t, 32> ciphertext{};
+    std::array<std::uint8_t, 16> tag{};
+
+    ResetAESInstrumentation();
+
+    AESGCM aes_gcm(aes_key);
+
+    aes_gcm.Encrypt(iv, {}, plaintext, ciphertext, tag);
+
+    tag[0] ^= 0x01;
+    STF_ASSERT_FALSE(aes_gcm.Decrypt(iv, {}, ciphertext, plaintext, tag));
+
+    AESEngineCounters counters = Counters(AES(aes_key).GetEngineType());
+
+    STF_ASSERT_EQ(AESInstrumentationEnabled() ? 1 : 0,
+                  counters.integrity_failures);
+}
+
+// Test that CMAC verification failures are counted
+STF_TEST(AESInstrumentation, CMACIntegrityFailure)
+{
+    const std::array<std::uint8_t, 32> message{};
+    std::array<std::uint8_t, 16> tag{};
+
+    ResetAESInstrumentation();
+
+    AESCMAC aes_cmac(aes_key);
+
+    aes_cmac.Compute(message, tag);
+    STF_ASSERT_TRUE(aes_cmac.Verify(message, tag));
+
+    tag[0] ^= 0x01;
+    STF_ASSERT_FALSE(aes_cmac.Verify(message, tag));
+
+    AESEngineCounters counters = Counters(AES(aes_key).GetEngineType());
+
+    STF_ASSERT_EQ(AESInstrumentationEnabled() ? 1 : 0,
+                  counters.integrity_failures);
+}
+
+// Test that CCM decryption failures are counted
+STF_TEST(AESInstrumentation, CCMIntegrityFailure)
+{
+    const std::array<std::uint8_t, 12> nonce{};
+    std::array<std::uint8_t, 32> data{};
+    std::array<std::uint8_t, 16> tag{};
+
+    ResetAESInstrumentation();
+
+    AESCCM aes_ccm(aes_key);
+
+    aes_ccm.Encrypt(nonce, {}, data, data, tag);
+
+    tag[0] ^= 0x01;
+    STF_ASSERT_FALSE(aes_ccm.Decrypt(nonce, {}, data, data, tag));
+
+    AESEngineCounters counters = Counters(AES(aes_key).GetEngineType());
+
+    STF_ASSERT_EQ(AESInstrumentationEnabled() ? 1 : 0,
+                  counters.integrity_failures);
+}
+
+// Test that OCB decryption failures are counted
+STF_TEST(AESInstrumentation, OCBIntegrityFailure)
+{
+    const std::array<std::uint8_t, 12> nonce{};
+    std::array<std::uint8_t, 32> data{};
+    std::array<std::uint8_t, 16> tag{};
+
+    ResetAESInstrumentation();
+
+    AESOCB aes_ocb(aes_key);
+
+    aes_ocb.Encrypt(nonce, {}, data, data, tag);
+
+    tag[0] ^= 0x01;
+    STF_ASSERT_FALSE(aes_ocb.Decrypt(nonce, {}, data, data, tag));
+
+    AESEngineCounters counters = Counters(AES(aes_key).GetEngineType());
+
+    STF_ASSERT_EQ(AESInstrumentationEnabled() ? 1 : 0,
+                  counters.integrity_failures);
+}
+
+// Test that the octets and time processed by AESStream are counted
+STF_TEST(AESInstrumentation, StreamCounts)
+{
+    const std::array<std::uint8_t, 16> counter{};
+    const std::string plaintext(3 * AESStream::Chunk_Alignment + 100, 'a');
+
+    ResetAESInstrumentation();
+
+    AESStream aes_stream(AESStreamMode::CTR,
+                         aes_key,
+                         AESStream::Chunk_Alignment);
+    aes_stream.SetIV(counter);
+
+    std::istringstream input(plaintext);
+    std::ostringstream output;
+    aes_stream.Encrypt(input, output);
+
+    AESEngineCounters counters = Counters(aes_stream.GetEngineType());
+
+    if (!AESInstrumentationEnabled())
+    {
+        STF_ASSERT_EQ(0, counters.stream_octets);
+        STF_ASSERT_EQ(0, counters.stream_nanoseconds);
+        return;
+    }
+
+    STF_ASSERT_EQ(plaintext.size(), counters.stream_octets);
+    STF_ASSERT_GT(counters.stream_nanoseconds, 0);
+    STF_ASSERT_EQ(aes_stream.GetStatistics().elapsed.count(),
+                  static_cast<std::int64_t>(counters.stream_nanoseconds));
+}
+
+// Test that the hook is called for each event counted
+STF_TEST(AESInstrumentation, Hook)
+{
+    std::array<std::uint8_t, 16 * 3> buffer{};
+
+    hook_calls = 0;
+    hook_blocks_encrypted = 0;
+
+    SetAESInstrumentationHook(Hook);
+
+    AES aes(aes_key, AESEngineType::Universal);
+
+    aes.EncryptBlocks(buffer, buffer);
+
+    SetAESInstrumentationHook(nullptr);
+
+    // No further calls are made once the hook is removed
+    aes.EncryptBlocks(buffer, buffer);
+
+    if (!AESInstrumentationEnabled())
+    {
+        STF_ASSERT_EQ(0, hook_calls);
+        return;
+    }
+
+    // One call for the key setup and one for the blocks encrypted
+    STF_ASSERT_EQ(2, hook_calls);
+    STF_ASSERT_EQ(3, hook_blocks_encrypted);
+}
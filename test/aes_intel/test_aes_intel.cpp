@@ -20,6 +20,8 @@
 #include <ostream>
 #include <iomanip>
 #include <vector>
+#include <iterator>
+#include <span>
 #include <bit>
 #include <intel_intrinsics.h>
 #include <aes_intel.h>
@@ -1008,6 +1010,197 @@ STF_TEST(AESIntel, TestDecryptVectorAPI)
     STF_ASSERT_EQ(expected_plaintext, plaintext);
 }
 
+// Test that the batch functions agree with the single-block functions
+STF_TEST(AESIntel, TestEncryptDecryptBlocks)
+{
+    if (!CPUSupportsAES_NI())
+    {
+        std::cerr << "AES-NI is not supported on this processor" << std::endl;
+        return;
+    }
+
+    const std::uint8_t aes_key[32] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+
+    // Exercise each key length and enough blocks to use each code path
+    for (std::size_t key_length : {16, 24, 32})
+    {
+        for (std::size_t blocks = 1; blocks <= 21; blocks++)
+        {
+            std::vector<std::uint8_t> plaintext(blocks * 16);
+            std::vector<std::uint8_t> expected(blocks * 16);
+            std::vector<std::uint8_t> ciphertext(blocks * 16);
+
+            for (std::size_t i = 0; i < plaintext.size(); i++)
+            {
+                plaintext[i] = static_cast<std::uint8_t>(i * 7 + blocks);
+            }
+
+            AESIntel aes({aes_key, key_length});
+
+            // Produce the expected result one block at a time
+            for (std::size_t i = 0; i < blocks; i++)
+            {
+                aes.Encrypt(
+                    std::span<const std::uint8_t, 16>(plaintext.data() + i * 16,
+                                                      16),
+                    std::span<std::uint8_t, 16>(expected.data() + i * 16, 16));
+            }
+
+            aes.EncryptBlocks(plaintext, ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+
+            // Decrypt in place
+            aes.DecryptBlocks(ciphertext, ciphertext);
+            STF_ASSERT_EQ(plaintext, ciphertext);
+        }
+    }
+}
+
+// Test that an encrypt-only key produces the same ciphertext
+STF_TEST(AESIntel, TestEncryptOnly)
+{
+    if (!CPUSupportsAES_NI())
+    {
+        std::cerr << "AES-NI is not supported on this processor" << std::endl;
+        return;
+    }
+
+    const std::uint8_t aes_key[32] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+
+    for (std::size_t key_length : {16, 24, 32})
+    {
+        AESIntel aes_full({aes_key, key_length});
+        AESIntel aes_encrypt_only;
+
+        aes_encrypt_only.SetKey({aes_key, key_length},
+                                AESKeyUsage::EncryptOnly);
+
+        // The decryption key schedule was not computed
+        STF_ASSERT_TRUE(aes_full != aes_encrypt_only);
+
+        for (std::size_t blocks = 1; blocks <= 21; blocks++)
+        {
+            std::vector<std::uint8_t> data(blocks * 16);
+            std::vector<std::uint8_t> expected(blocks * 16);
+            std::vector<std::uint8_t> ciphertext(blocks * 16);
+
+            for (std::size_t i = 0; i < data.size(); i++)
+            {
+                data[i] = static_cast<std::uint8_t>(i * 7 + blocks);
+            }
+
+            aes_full.EncryptBlocks(data, expected);
+
+            aes_encrypt_only.EncryptBlocks(data, ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+        }
+
+        // Setting the key for both directions restores decryption
+        aes_encrypt_only.SetKey({aes_key, key_length});
+
+        STF_ASSERT_TRUE(aes_full == aes_encrypt_only);
+    }
+}
+
+// Test that keys set together match keys set individually
+STF_TEST(AESIntel, TestSetKeys)
+{
+    if (!CPUSupportsAES_NI())
+    {
+        std::cerr << "AES-NI is not supported on this processor" << std::endl;
+        return;
+    }
+
+    const std::size_t key_lengths[] =
+    {
+        16, 16, 16, 16, 16, 24, 24, 24, 24, 32, 32, 32, 32, 32,
+        16, 24, 16, 16, 32, 32, 16, 16, 16
+    };
+    constexpr std::size_t Keys = std::size(key_lengths);
+
+    for (AESKeyUsage key_usage : {AESKeyUsage::EncryptDecrypt,
+                                  AESKeyUsage::EncryptOnly})
+    {
+        std::vector<std::vector<std::uint8_t>> keys;
+        std::vector<std::span<const std::uint8_t>> key_spans;
+        std::vector<AESIntel> expected(Keys);
+        std::vector<AESIntel> actual(Keys);
+        std::vector<AESIntel *> engines;
+
+        for (std::size_t i = 0; i < Keys; i++)
+        {
+            std::vector<std::uint8_t> key(key_lengths[i]);
+
+            for (std::size_t j = 0; j < key.size(); j++)
+            {
+                key[j] = static_cast<std::uint8_t>(i * 13 + j);
+            }
+
+            keys.push_back(key);
+        }
+
+        for (std::size_t i = 0; i < Keys; i++)
+        {
+            key_spans.emplace_back(keys[i]);
+            expected[i].SetKey(keys[i], key_usage);
+
+            // Give each engine a prior key that must be replaced
+            actual[i].SetKey(keys[Keys - 1 - i]);
+            engines.push_back(&actual[i]);
+        }
+
+        AESIntel::SetKeys(engines, key_spans, key_usage);
+
+        for (std::size_t i = 0; i < Keys; i++)
+        {
+            STF_ASSERT_TRUE(expected[i] == actual[i]);
+        }
+    }
+}
+
+// Test that invalid arguments to SetKeys() leave the engines unchanged
+STF_TEST(AESIntel, TestSetKeysInvalid)
+{
+    if (!CPUSupportsAES_NI())
+    {
+        std::cerr << "AES-NI is not supported on this processor" << std::endl;
+        return;
+    }
+
+    const std::uint8_t aes_key[32]{};
+    const std::span<const std::uint8_t> keys[4] =
+    {
+        {aes_key, 16}, {aes_key, 16}, {aes_key, 16}, {aes_key, 17}
+    };
+    std::vector<AESIntel> actual(4);
+    std::vector<AESIntel *> engines;
+
+    for (AESIntel &engine : actual) engines.push_back(&engine);
+
+    STF_ASSERT_EXCEPTION_E(AESIntel::SetKeys(engines, keys), AESException);
+    STF_ASSERT_EXCEPTION_E(
+        AESIntel::SetKeys(std::span(engines).first(3),
+                       std::span(keys).first(2)),
+        AESException);
+
+    for (const AESIntel &engine : actual)
+    {
+        STF_ASSERT_TRUE(engine == AESIntel());
+    }
+}
+
 // This function tests the performance of the encryption code
 STF_TEST(AESIntel, EncryptionSpeedTest128)
 {
@@ -0,0 +1,188 @@
+/*
+ *  test_aes_intel_vaes.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the multi-block encryption and decryption
+ *      routines in the AESIntelVAES module, comparing the results against
+ *      the AESIntel module.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+#include <intel_intrinsics.h>
+#include <aes_intel.h>
+#include <aes_intel_vaes.h>
+#include <cpu_check.h>
+#include <terra/stf/adapters/integral_vector.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+#if defined(TERRA_USE_INTEL_INTRINSICS) && defined(HAVE_VAES)
+
+namespace
+{
+
+const std::uint8_t aes_key[32] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+// Engine restricted to 256-bit registers to exercise that code path
+class AESIntelVAES256 : public AESIntelVAES
+{
+    public:
+        AESIntelVAES256(const std::span<const std::uint8_t> key) :
+            AESIntelVAES(key)
+        {
+            use_512_bit = false;
+        }
+};
+
+} // namespace
+
+// Test the function that indicated the engine type
+STF_TEST(AESIntelVAES, EngineCheck)
+{
+    AESIntelVAES aes;
+
+    if (!CPUSupportsAES_NI() || !CPUSupportsVAES())
+    {
+        std::cerr << "VAES is not supported on this processor" << std::endl;
+        STF_ASSERT_EQ(aes.GetEngineType(), AESEngineType::Unavailable);
+        return;
+    }
+
+    STF_ASSERT_EQ(aes.GetEngineType(), AESEngineType::IntelVAES);
+}
+
+// Test single-block encryption using the FIPS 197 Appendix C.3 vector
+STF_TEST(AESIntelVAES, TestVectorC3Encrypt256)
+{
+    if (!CPUSupportsAES_NI() || !CPUSupportsVAES())
+    {
+        std::cerr << "VAES is not supported on this processor" << std::endl;
+        return;
+    }
+
+    const std::uint8_t plaintext[16] =
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+    };
+
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+        0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+    };
+
+    std::uint8_t ciphertext[16];
+
+    AESIntelVAES aes(aes_key);
+
+    aes.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+}
+
+// Compare multi-block operations against the AESIntel engine
+STF_TEST(AESIntelVAES, TestEncryptDecryptBlocks)
+{
+    if (!CPUSupportsAES_NI() || !CPUSupportsVAES())
+    {
+        std::cerr << "VAES is not supported on this processor" << std::endl;
+        return;
+    }
+
+    // Exercise each key length and enough blocks to use each code path
+    for (std::size_t key_length : {16, 24, 32})
+    {
+        AESIntel aes_intel({aes_key, key_length});
+        AESIntelVAES aes_vaes({aes_key, key_length});
+        AESIntelVAES256 aes_vaes_256({aes_key, key_length});
+
+        for (std::size_t blocks = 1; blocks <= 41; blocks++)
+        {
+            std::vector<std::uint8_t> plaintext(blocks * 16);
+            std::vector<std::uint8_t> expected(blocks * 16);
+            std::vector<std::uint8_t> ciphertext(blocks * 16);
+
+            for (std::size_t i = 0; i < plaintext.size(); i++)
+            {
+                plaintext[i] = static_cast<std::uint8_t>(i * 7 + blocks);
+            }
+
+            aes_intel.EncryptBlocks(plaintext, expected);
+
+            aes_vaes.EncryptBlocks(plaintext, ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+
+            // Decrypt in place
+            aes_vaes.DecryptBlocks(ciphertext, ciphertext);
+            STF_ASSERT_EQ(plaintext, ciphertext);
+
+            // Repeat using only 256-bit registers
+            aes_vaes_256.EncryptBlocks(plaintext, ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+
+            aes_vaes_256.DecryptBlocks(ciphertext, ciphertext);
+            STF_ASSERT_EQ(plaintext, ciphertext);
+        }
+    }
+}
+
+// Test copy constructor and equality
+STF_TEST(AESIntelVAES, TestCopyConstructor)
+{
+    if (!CPUSupportsAES_NI() || !CPUSupportsVAES())
+    {
+        std::cerr << "VAES is not supported on this processor" << std::endl;
+        return;
+    }
+
+    std::vector<std::uint8_t> plaintext(16 * 20, 0x5a);
+    std::vector<std::uint8_t> ciphertext1(plaintext.size());
+    std::vector<std::uint8_t> ciphertext2(plaintext.size());
+
+    AESIntelVAES aes1(aes_key);
+
+    // aes2 will copy key information from aes1
+    AESIntelVAES aes2 = aes1;
+
+    STF_ASSERT_TRUE(aes1 == aes2);
+
+    aes1.EncryptBlocks(plaintext, ciphertext1);
+    aes2.EncryptBlocks(plaintext, ciphertext2);
+
+    STF_ASSERT_EQ(ciphertext1, ciphertext2);
+}
+
+#else
+
+// If not built with VAES support, the VAES engine should be unavailable
+STF_TEST(AESIntelVAES, EngineCheck)
+{
+    AESIntelVAES aes;
+
+    STF_ASSERT_EQ(aes.GetEngineType(), AESEngineType::Unavailable);
+}
+
+#endif // TERRA_USE_INTEL_INTRINSICS && HAVE_VAES
@@ -0,0 +1,423 @@
+/*
+ *  test_aes_key_pool.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AESKeyPool object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <iterator>
+#include <span>
+#include <vector>
+#include <terra/crypto/cipher/aes.h>
+#include <terra/crypto/cipher/aes_inline.h>
+#include <terra/crypto/cipher/aes_key_pool.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+const std::uint8_t aes_key[32] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+const std::uint8_t plaintext[16] =
+{
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+
+// Ciphertext from Appendix C.1
+const std::uint8_t expected_ciphertext_128[16] =
+{
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+
+// Ciphertext from Appendix C.3
+const std::uint8_t expected_ciphertext_256[16] =
+{
+    0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+    0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+};
+
+// Key lengths for the batch tests, mixing runs of equal and unequal lengths
+const std::size_t batch_key_lengths[] =
+{
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 24, 24, 24, 24, 24, 32, 32, 32, 32,
+    32, 32, 16, 32, 16, 16, 24, 16, 16, 16, 16, 32, 32, 24, 32, 32, 32, 16
+};
+
+// Allocate keys in a batch and verify them against separate AES objects
+void VerifyBatchAllocate(AESKeyUsage key_usage)
+{
+    constexpr std::size_t Keys = std::size(batch_key_lengths);
+    std::vector<std::vector<std::uint8_t>> keys;
+    std::vector<std::span<const std::uint8_t>> key_spans;
+    std::vector<std::size_t> handles(Keys);
+    std::vector<std::uint8_t> data(16 * 3);
+    std::vector<std::uint8_t> expected(data.size());
+    std::vector<std::uint8_t> actual(data.size());
+
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i);
+    }
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        std::vector<std::uint8_t> key(batch_key_lengths[i]);
+
+        for (std::size_t j = 0; j < key.size(); j++)
+        {
+            key[j] = static_cast<std::uint8_t>(i * 7 + j);
+        }
+
+        keys.push_back(key);
+    }
+
+    for (const auto &key : keys) key_spans.emplace_back(key);
+
+    AESKeyPool pool(Keys);
+
+    pool.Allocate(key_spans, handles, key_usage);
+
+    STF_ASSERT_EQ(Keys, pool.GetAllocated());
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        AES aes(keys[i]);
+        aes.EncryptBlocks(data, expected);
+
+        pool.EncryptBlocks(handles[i], data, actual);
+        STF_ASSERT_EQ(expected, actual);
+
+        if (key_usage == AESKeyUsage::EncryptOnly) continue;
+
+        pool.DecryptBlocks(handles[i], actual, actual);
+        STF_ASSERT_EQ(data, actual);
+    }
+}
+
+} // namespace
+
+// Test that the pool uses the engine AESInline selects and aligned slots
+STF_TEST(AESKeyPool, EngineCheck)
+{
+    AESKeyPool pool(4);
+
+    STF_ASSERT_EQ(AESInline().GetEngineType(), pool.GetEngineType());
+    STF_ASSERT_EQ(0, pool.GetSlotSize() % AESKeyPool::Slot_Alignment);
+    STF_ASSERT_EQ(4, pool.GetCapacity());
+    STF_ASSERT_EQ(0, pool.GetAllocated());
+}
+
+// Test encryption and decryption with keys from Appendix C
+STF_TEST(AESKeyPool, TestVectors)
+{
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    AESKeyPool pool(2);
+
+    std::size_t key_128 = pool.Allocate({aes_key, 16});
+    std::size_t key_256 = pool.Allocate({aes_key, 32});
+
+    STF_ASSERT_NE(key_128, key_256);
+    STF_ASSERT_EQ(2, pool.GetAllocated());
+
+    pool.Encrypt(key_128, plaintext, ciphertext);
+    STF_ASSERT_MEM_EQ(expected_ciphertext_128,
+                      ciphertext,
+                      sizeof(expected_ciphertext_128));
+
+    pool.Decrypt(key_128, ciphertext, decrypted);
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+
+    pool.Encrypt(key_256, plaintext, ciphertext);
+    STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                      ciphertext,
+                      sizeof(expected_ciphertext_256));
+
+    pool.Decrypt(key_256, ciphertext, decrypted);
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test that many keys in one pool match separately created AES objects
+STF_TEST(AESKeyPool, ManyKeys)
+{
+    constexpr std::size_t Keys = 1000;
+    std::vector<std::uint8_t> data(16 * 9);
+    std::vector<std::uint8_t> expected(data.size());
+    std::vector<std::uint8_t> actual(data.size());
+    std::vector<std::size_t> handles;
+
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i);
+    }
+
+    AESKeyPool pool(Keys);
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        std::array<std::uint8_t, 16> key{};
+        key[0] = static_cast<std::uint8_t>(i);
+        key[1] = static_cast<std::uint8_t>(i >> 8);
+        handles.push_back(pool.Allocate(key));
+    }
+
+    STF_ASSERT_EQ(Keys, pool.GetAllocated());
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        std::array<std::uint8_t, 16> key{};
+        key[0] = static_cast<std::uint8_t>(i);
+        key[1] = static_cast<std::uint8_t>(i >> 8);
+
+        AES aes(key);
+        aes.EncryptBlocks(data, expected);
+
+        pool.EncryptBlocks(handles[i], data, actual);
+        STF_ASSERT_EQ(expected, actual);
+
+        pool.DecryptBlocks(handles[i], actual, actual);
+        STF_ASSERT_EQ(data, actual);
+    }
+}
+
+// Test allocating many keys at once
+STF_TEST(AESKeyPool, BatchAllocate)
+{
+    VerifyBatchAllocate(AESKeyUsage::EncryptDecrypt);
+    VerifyBatchAllocate(AESKeyUsage::EncryptOnly);
+}
+
+// Test allocating many keys at once using the universal engine
+STF_TEST(AESKeyPool, BatchAllocateUniversal)
+{
+    AESEngineType original_engine = AES::GetPreferredEngine();
+
+    AES::SetPreferredEngine(AESEngineType::Universal);
+
+    try
+    {
+        STF_ASSERT_EQ(AESEngineType::Universal,
+                      AESKeyPool(1).GetEngineType());
+
+        VerifyBatchAllocate(AESKeyUsage::EncryptDecrypt);
+        VerifyBatchAllocate(AESKeyUsage::EncryptOnly);
+    }
+    catch (...)
+    {
+        AES::SetPreferredEngine(original_engine);
+        throw;
+    }
+
+    AES::SetPreferredEngine(original_engine);
+}
+
+// Test that a failed batch allocation does not consume any slot
+STF_TEST(AESKeyPool, BatchAllocateInvalid)
+{
+    std::array<std::size_t, 5> handles{};
+    const std::span<const std::uint8_t> keys[5] =
+    {
+        {aes_key, 16}, {aes_key, 16}, {aes_key, 16}, {aes_key, 16},
+        {aes_key, 20}
+    };
+
+    AESKeyPool pool(5);
+
+    // One key has an invalid length
+    STF_ASSERT_EXCEPTION_E(pool.Allocate(keys, handles), AESException);
+    STF_ASSERT_EQ(0, pool.GetAllocated());
+
+    // The number of handles does not match the number of keys
+    STF_ASSERT_EXCEPTION_E(
+        pool.Allocate(std::span(keys).first(4),
+                      std::span(handles).first(3)),
+        AESException);
+    STF_ASSERT_EQ(0, pool.GetAllocated());
+
+    // There is not enough room in the pool
+    pool.Allocate({aes_key, 32});
+    std::size_t second = pool.Allocate({aes_key, 32});
+    STF_ASSERT_EXCEPTION_E(
+        pool.Allocate(std::span(keys).first(4),
+                      std::span(handles).first(4)),
+        AESException);
+    STF_ASSERT_EQ(2, pool.GetAllocated());
+
+    // The keys may be allocated at once once there is room
+    pool.Free(second);
+    pool.Allocate(std::span(keys).first(4), std::span(handles).first(4));
+    STF_ASSERT_EQ(5, pool.GetAllocated());
+
+    std::uint8_t ciphertext[16];
+    pool.Encrypt(handles[3], plaintext, ciphertext);
+    STF_ASSERT_MEM_EQ(expected_ciphertext_128,
+                      ciphertext,
+                      sizeof(expected_ciphertext_128));
+}
+
+// Test allocating and freeing slots
+STF_TEST(AESKeyPool, AllocateFree)
+{
+    AESKeyPool pool(3);
+
+    std::size_t first = pool.Allocate({aes_key, 16});
+    std::size_t second = pool.Allocate({aes_key, 24});
+    std::size_t third = pool.Allocate({aes_key, 32});
+
+    STF_ASSERT_EQ(3, pool.GetAllocated());
+
+    // The pool is full
+    STF_ASSERT_EXCEPTION_E(pool.Allocate({aes_key, 16}), AESException);
+
+    // A freed slot is reused by the next allocation
+    pool.Free(second);
+    STF_ASSERT_EQ(2, pool.GetAllocated());
+    STF_ASSERT_EQ(second, pool.Allocate({aes_key, 16}));
+
+    // The reused slot holds the new key
+    std::uint8_t ciphertext[16];
+    pool.Encrypt(second, plaintext, ciphertext);
+    STF_ASSERT_MEM_EQ(expected_ciphertext_128,
+                      ciphertext,
+                      sizeof(expected_ciphertext_128));
+
+    // Freeing twice or freeing an invalid handle is an error
+    pool.Free(first);
+    STF_ASSERT_EXCEPTION_E(pool.Free(first), AESException);
+    STF_ASSERT_EXCEPTION_E(pool.Free(3), AESException);
+
+    pool.Free(third);
+    pool.Free(second);
+    STF_ASSERT_EQ(0, pool.GetAllocated());
+}
+
+// Test that an invalid key does not consume a slot
+STF_TEST(AESKeyPool, InvalidKey)
+{
+    AESKeyPool pool(1);
+
+    STF_ASSERT_EXCEPTION_E(pool.Allocate({aes_key, 15}), AESException);
+    STF_ASSERT_EQ(0, pool.GetAllocated());
+
+    std::size_t handle = pool.Allocate({aes_key, 32});
+
+    std::uint8_t ciphertext[16];
+    pool.Encrypt(handle, plaintext, ciphertext);
+    STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                      ciphertext,
+                      sizeof(expected_ciphertext_256));
+}
+
+// Test that a pool cannot be created with no capacity
+STF_TEST(AESKeyPool, InvalidCapacity)
+{
+    STF_ASSERT_EXCEPTION_E(AESKeyPool(0), AESException);
+}
+
+// Test the batch API rejects spans that are not whole blocks
+STF_TEST(AESKeyPool, BlocksInvalidLength)
+{
+    std::array<std::uint8_t, 24> data{};
+
+    AESKeyPool pool(1);
+
+    std::size_t handle = pool.Allocate({aes_key, 16});
+
+    STF_ASSERT_EXCEPTION_E(pool.EncryptBlocks(handle, data, data),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(
+        pool.DecryptBlocks(handle,
+                           data,
+                           std::span<std::uint8_t>(data.data(), 16)),
+        AESException);
+}
+
+// Test the batch API rejects invalid handles and encrypt-only keys
+STF_TEST(AESKeyPool, BlocksInvalidHandle)
+{
+    std::array<std::uint8_t, 32> data{};
+    std::array<std::size_t, 1> handles{};
+    const std::span<const std::uint8_t> keys[] = {{aes_key, 16}};
+
+    AESKeyPool pool(3);
+
+    std::size_t handle = pool.Allocate({aes_key, 16});
+    std::size_t freed = pool.Allocate({aes_key, 16});
+    pool.Free(freed);
+
+    // Handles that are freed, never allocated, or beyond the capacity
+    STF_ASSERT_EXCEPTION_E(pool.EncryptBlocks(freed, data, data),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(pool.DecryptBlocks(freed, data, data),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(pool.EncryptBlocks(2, data, data), AESException);
+    STF_ASSERT_EXCEPTION_E(pool.DecryptBlocks(3, data, data), AESException);
+
+    // Keys allocated for encryption only may not be used to decrypt
+    std::size_t encrypt_only =
+        pool.Allocate({aes_key, 16}, AESKeyUsage::EncryptOnly);
+    pool.EncryptBlocks(encrypt_only, data, data);
+    STF_ASSERT_EXCEPTION_E(pool.DecryptBlocks(encrypt_only, data, data),
+                           AESException);
+
+    pool.Free(encrypt_only);
+    pool.Allocate(keys, handles, AESKeyUsage::EncryptOnly);
+    STF_ASSERT_EXCEPTION_E(pool.DecryptBlocks(handles[0], data, data),
+                           AESException);
+
+    // A slot reused for a key that decrypts may decrypt
+    pool.Free(handles[0]);
+    std::size_t reused = pool.Allocate({aes_key, 16});
+    STF_ASSERT_EQ(handles[0], reused);
+    const std::array<std::uint8_t, 32> original = data;
+    pool.EncryptBlocks(reused, data, data);
+    pool.DecryptBlocks(reused, data, data);
+    STF_ASSERT_EQ(original, data);
+
+    pool.DecryptBlocks(handle, data, data);
+}
+
+// Test a pool held in locked memory, if the system permits locking it
+STF_TEST(AESKeyPool, LockedMemory)
+{
+    try
+    {
+        AESKeyPool pool(16, AESKeyPoolMemory::Locked);
+
+        std::size_t handle = pool.Allocate({aes_key, 32});
+
+        std::uint8_t ciphertext[16];
+        pool.Encrypt(handle, plaintext, ciphertext);
+        STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                          ciphertext,
+                          sizeof(expected_ciphertext_256));
+    }
+    catch (const AESException &)
+    {
+        // The system's limit on locked memory may have been reached
+    }
+}
@@ -0,0 +1,401 @@
+/*
+ *  test_aes_key_schedule.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AESKeySchedule object, including use
+ *      of a single object from several threads concurrently.  Test sections
+ *      referenced are from the FIPS 197 specification.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <terra/crypto/cipher/aes.h>
+#include <terra/crypto/cipher/aes_key_schedule.h>
+#include <terra/stf/adapters/integral_vector.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+const std::uint8_t aes_key[32] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+const std::uint8_t plaintext[16] =
+{
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+
+// Ciphertext from Appendix C.1
+const std::uint8_t expected_ciphertext_128[16] =
+{
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+
+// Ciphertext from Appendix C.3
+const std::uint8_t expected_ciphertext_256[16] =
+{
+    0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+    0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+};
+
+} // namespace
+
+// Test from Appendix C.1
+STF_TEST(AESKeySchedule, TestVectorC1128)
+{
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    const AESKeySchedule key_schedule({aes_key, 16});
+
+    STF_ASSERT_NE(key_schedule.GetEngineType(), AESEngineType::Unavailable);
+
+    key_schedule.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext_128,
+                      ciphertext,
+                      sizeof(expected_ciphertext_128));
+
+    key_schedule.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test from Appendix C.2
+STF_TEST(AESKeySchedule, TestVectorC2192)
+{
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0,
+        0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91
+    };
+
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    const AESKeySchedule key_schedule({aes_key, 24});
+
+    key_schedule.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+
+    key_schedule.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test from Appendix C.3
+STF_TEST(AESKeySchedule, TestVectorC3256)
+{
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    const AESKeySchedule key_schedule(aes_key);
+
+    key_schedule.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                      ciphertext,
+                      sizeof(expected_ciphertext_256));
+
+    key_schedule.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test copy construction and equality
+STF_TEST(AESKeySchedule, TestCopyEquality)
+{
+    std::uint8_t ciphertext[16];
+
+    const AESKeySchedule key_schedule1(aes_key);
+    const AESKeySchedule key_schedule2 = key_schedule1;
+    const AESKeySchedule key_schedule3({aes_key, 16});
+
+    STF_ASSERT_TRUE(key_schedule1 == key_schedule2);
+    STF_ASSERT_FALSE(key_schedule1 != key_schedule2);
+    STF_ASSERT_TRUE(key_schedule1 != key_schedule3);
+
+    key_schedule2.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext_256,
+                      ciphertext,
+                      sizeof(expected_ciphertext_256));
+}
+
+// Compare multi-block operations against the AES object
+STF_TEST(AESKeySchedule, TestEncryptDecryptBlocks)
+{
+    for (std::size_t key_length : {16, 24, 32})
+    {
+        AES aes({aes_key, key_length});
+        const AESKeySchedule key_schedule({aes_key, key_length});
+
+        for (std::size_t blocks = 1; blocks <= 21; blocks++)
+        {
+            std::vector<std::uint8_t> data(blocks * 16);
+            std::vector<std::uint8_t> expected(blocks * 16);
+            std::vector<std::uint8_t> ciphertext(blocks * 16);
+
+            for (std::size_t i = 0; i < data.size(); i++)
+            {
+                data[i] = static_cast<std::uint8_t>(i * 7 + blocks);
+            }
+
+            aes.EncryptBlocks(data, expected);
+
+            key_schedule.EncryptBlocks(data, ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+
+            // Decrypt in place
+            key_schedule.DecryptBlocks(ciphertext, ciphertext);
+            STF_ASSERT_EQ(data, ciphertext);
+        }
+    }
+}
+
+// Test that one key schedule may be used by several threads at once
+STF_TEST(AESKeySchedule, TestConcurrentUse)
+{
+    constexpr std::size_t Thread_Count = 8;
+    constexpr std::size_t Iterations = 2000;
+    constexpr std::size_t Blocks = 7;
+
+    const AESKeySchedule key_schedule(aes_key);
+    std::vector<std::uint8_t> data(Blocks * 16);
+    std::vector<std::uint8_t> expected(Blocks * 16);
+    std::atomic<std::size_t> failures{};
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i * 13);
+    }
+
+    AES aes(aes_key);
+    aes.EncryptBlocks(data, expected);
+
+    for (std::size_t t = 0; t < Thread_Count; t++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                std::uint8_t ciphertext[16];
+                std::uint8_t decrypted[16];
+                std::vector<std::uint8_t> blocks(Blocks * 16);
+
+                for (std::size_t i = 0; i < Iterations; i++)
+                {
+                    key_schedule.Encrypt(plaintext, ciphertext);
+                    key_schedule.Decrypt(ciphertext, decrypted);
+
+                    if ((std::memcmp(ciphertext,
+                                     expected_ciphertext_256,
+                                     sizeof(ciphertext)) != 0) ||
+                        (std::memcmp(decrypted,
+                                     plaintext,
+                                     sizeof(decrypted)) != 0))
+                    {
+                        failures++;
+                    }
+
+                    key_schedule.EncryptBlocks(data, blocks);
+                    if (blocks != expected) failures++;
+
+                    key_schedule.DecryptBlocks(blocks, blocks);
+                    if (blocks != data) failures++;
+                }
+            });
+    }
+
+    for (auto &thread : threads) thread.join();
+
+    STF_ASSERT_EQ(std::size_t(0), failures.load());
+}
+
+// Test that an invalid key length is rejected
+STF_TEST(AESKeySchedule, TestInvalidKey)
+{
+    bool expected_failure = false;
+
+    try
+    {
+        const AESKeySchedule key_schedule({aes_key, 20});
+    }
+    catch (const AESException &)
+    {
+        expected_failure = true;
+    }
+
+    STF_ASSERT_TRUE(expected_failure);
+}
+
+// Test encrypting one block under each of many keys of mixed lengths
+STF_TEST(AESKeySchedule, TestMultiKey)
+{
+    std::vector<AESKeySchedule> key_schedules;
+    std::vector<const AESKeySchedule *> pointers;
+
+    key_schedules.reserve(43);
+
+    // Create keys of each length, with each run of eight keys the same length
+    for (std::size_t i = 0; i < 43; i++)
+    {
+        std::uint8_t key[32];
+        std::size_t key_length = std::size_t(16) + ((i / 8) % 3) * 8;
+
+        for (std::size_t j = 0; j < sizeof(key); j++)
+        {
+            key[j] = static_cast<std::uint8_t>(i * 31 + j);
+        }
+
+        key_schedules.emplace_back(std::span<const std::uint8_t>(key,
+                                                                 key_length));
+    }
+
+    // Use one key schedule more than once
+    for (const AESKeySchedule &key_schedule : key_schedules)
+    {
+        pointers.push_back(&key_schedule);
+    }
+    pointers[3] = pointers[0];
+
+    for (std::size_t count = 0; count <= pointers.size(); count++)
+    {
+        std::vector<std::uint8_t> data(count * 16);
+        std::vector<std::uint8_t> expected(count * 16);
+        std::vector<std::uint8_t> ciphertext(count * 16);
+
+        for (std::size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = static_cast<std::uint8_t>(i * 11 + count);
+        }
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            pointers[i]->Encrypt(
+                std::span<const std::uint8_t, 16>(data.data() + i * 16, 16),
+                std::span<std::uint8_t, 16>(expected.data() + i * 16, 16));
+        }
+
+        const std::span<const AESKeySchedule * const> keys(pointers.data(),
+                                                           count);
+
+        AESKeySchedule::EncryptMultiKey(keys, data, ciphertext);
+        STF_ASSERT_EQ(expected, ciphertext);
+
+        // Decrypt in place
+        AESKeySchedule::DecryptMultiKey(keys, ciphertext, ciphertext);
+        STF_ASSERT_EQ(data, ciphertext);
+    }
+}
+
+// Test multiple keys where some use an engine that cannot run in lockstep
+STF_TEST(AESKeySchedule, TestMultiKeyMixedEngines)
+{
+    AESEngineType original_engine = AES::GetPreferredEngine();
+    std::vector<AESKeySchedule> key_schedules;
+    std::vector<const AESKeySchedule *> pointers;
+    std::vector<std::uint8_t> data(20 * 16);
+    std::vector<std::uint8_t> expected(data.size());
+    std::vector<std::uint8_t> ciphertext(data.size());
+
+    key_schedules.reserve(20);
+
+    for (std::size_t i = 0; i < 20; i++)
+    {
+        std::uint8_t key[16];
+
+        for (std::size_t j = 0; j < sizeof(key); j++)
+        {
+            key[j] = static_cast<std::uint8_t>(i + j * 3);
+        }
+
+        // Key 10 uses the universal engine
+        AES::SetPreferredEngine((i == 10) ? AESEngineType::Universal :
+                                            original_engine);
+        key_schedules.emplace_back(key);
+    }
+
+    AES::SetPreferredEngine(original_engine);
+
+    STF_ASSERT_EQ(AESEngineType::Universal, key_schedules[10].GetEngineType());
+
+    for (const AESKeySchedule &key_schedule : key_schedules)
+    {
+        pointers.push_back(&key_schedule);
+    }
+
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i);
+    }
+
+    for (std::size_t i = 0; i < pointers.size(); i++)
+    {
+        pointers[i]->Encrypt(
+            std::span<const std::uint8_t, 16>(data.data() + i * 16, 16),
+            std::span<std::uint8_t, 16>(expected.data() + i * 16, 16));
+    }
+
+    AESKeySchedule::EncryptMultiKey(pointers, data, ciphertext);
+    STF_ASSERT_EQ(expected, ciphertext);
+
+    AESKeySchedule::DecryptMultiKey(pointers, ciphertext, ciphertext);
+    STF_ASSERT_EQ(data, ciphertext);
+}
+
+// Test that the number of blocks must match the number of key schedules
+STF_TEST(AESKeySchedule, TestMultiKeyInvalidLength)
+{
+    const AESKeySchedule key_schedule(aes_key);
+    const AESKeySchedule *pointers[2] = {&key_schedule, &key_schedule};
+    std::uint8_t data[48]{};
+
+    STF_ASSERT_EXCEPTION_E(
+        AESKeySchedule::EncryptMultiKey(pointers, {data, 48}, {data, 48}),
+        AESException);
+    STF_ASSERT_EXCEPTION_E(
+        AESKeySchedule::DecryptMultiKey(pointers, {data, 32}, {data, 16}),
+        AESException);
+}
+
+// Test that decrypting with a key set for encryption only is rejected
+STF_TEST(AESKeySchedule, TestEncryptOnly)
+{
+    const AESKeySchedule key_schedule(aes_key, AESKeyUsage::EncryptOnly);
+    const AESKeySchedule *pointers[2] = {&key_schedule, &key_schedule};
+    std::uint8_t data[32]{};
+
+    STF_ASSERT_EQ(AESKeyUsage::EncryptOnly, key_schedule.GetKeyUsage());
+    STF_ASSERT_EXCEPTION_E(key_schedule.DecryptBlocks(data, data),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(
+        AESKeySchedule::DecryptMultiKey(pointers, data, data),
+        AESException);
+}
@@ -17,7 +17,11 @@
  */
 
 #include <cstdint>
+#include <cstddef>
+#include <algorithm>
 #include <array>
+#include <vector>
+#include <span>
 #include <terra/crypto/cipher/aes_key_wrap.h>
 #include <terra/stf/stf.h>
 
@@ -717,3 +721,368 @@ STF_TEST(AESKeyWrapWithPadding, SixteenOctetPlaintext)
                       plaintext_check.data(),
                       plaintext.size());
 }
+
+// Test vector in RFC 3394 Section 4.1 using a single buffer
+STF_TEST(AESKeyWrap, RFC3394_4_1_InPlace)
+{
+    const std::array<std::uint8_t, 16> key =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    };
+    const std::array<std::uint8_t, 16> plaintext =
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+    };
+    const std::array<std::uint8_t, 24> expected_ciphertext =
+    {
+        0x1f, 0xa6, 0x8b, 0x0a, 0x81, 0x12, 0xb4, 0x47,
+        0xae, 0xf3, 0x4b, 0xd8, 0xfb, 0x5a, 0x7b, 0x82,
+        0x9d, 0x3e, 0x86, 0x23, 0x71, 0xd2, 0xcf, 0xe5
+    };
+    std::array<std::uint8_t, expected_ciphertext.size()> buffer{};
+
+    // Create AESKeyWrap object using the given key and length
+    AESKeyWrap aes_kw(key);
+
+    // Place the plaintext after the space reserved for the integrity data
+    std::copy(plaintext.begin(), plaintext.end(), buffer.begin() + 8);
+
+    // Perform the AES key wrap
+    aes_kw.WrapInPlace(buffer);
+
+    // Verify result
+    STF_ASSERT_EQ(expected_ciphertext, buffer);
+
+    // Perform the key unwrap operation
+    STF_ASSERT_TRUE(aes_kw.UnwrapInPlace(buffer));
+
+    // Verify the integrity data and plaintext
+    STF_ASSERT_MEM_EQ(AESKeyWrap::AES_Key_Wrap_Default_IV.data(),
+                      buffer.data(),
+                      8);
+    STF_ASSERT_MEM_EQ(plaintext.data(), buffer.data() + 8, plaintext.size());
+
+    // Verify that a modified ciphertext fails the integrity check
+    buffer = expected_ciphertext;
+    buffer[20] ^= 0x01;
+    STF_ASSERT_FALSE(aes_kw.UnwrapInPlace(buffer));
+}
+
+// Test vectors in RFC 5649 Section 6 using a single buffer
+STF_TEST(AESKeyWrapWithPadding, RFC5649_6_InPlace)
+{
+    const std::array<std::uint8_t, 24> key =
+    {
+        0x58, 0x40, 0xdf, 0x6e, 0x29, 0xb0, 0x2a, 0xf1,
+        0xab, 0x49, 0x3b, 0x70, 0x5b, 0xf1, 0x6e, 0xa1,
+        0xae, 0x83, 0x38, 0xf4, 0xdc, 0xc1, 0x76, 0xa8
+    };
+    const std::array<std::uint8_t, 20> plaintext_20 =
+    {
+        0xc3, 0x7b, 0x7e, 0x64, 0x92, 0x58, 0x43, 0x40,
+        0xbe, 0xd1, 0x22, 0x07, 0x80, 0x89, 0x41, 0x15,
+        0x50, 0x68, 0xf7, 0x38
+    };
+    const std::array<std::uint8_t, 32> expected_ciphertext_20 =
+    {
+        0x13, 0x8b, 0xde, 0xaa, 0x9b, 0x8f, 0xa7, 0xfc,
+        0x61, 0xf9, 0x77, 0x42, 0xe7, 0x22, 0x48, 0xee,
+        0x5a, 0xe6, 0xae, 0x53, 0x60, 0xd1, 0xae, 0x6a,
+        0x5f, 0x54, 0xf3, 0x73, 0xfa, 0x54, 0x3b, 0x6a
+    };
+    const std::array<std::uint8_t, 7> plaintext_7 =
+    {
+        0x46, 0x6f, 0x72, 0x50, 0x61, 0x73, 0x69
+    };
+    const std::array<std::uint8_t, 16> expected_ciphertext_7 =
+    {
+        0xaf, 0xbe, 0xb0, 0xf0, 0x7d, 0xfb, 0xf5, 0x41,
+        0x92, 0x00, 0xf2, 0xcc, 0xb5, 0x0b, 0xb2, 0x4f
+    };
+    std::array<std::uint8_t, 40> buffer;
+
+    // Create AESKeyWrap object using the given key and length
+    AESKeyWrap aes_kw(key);
+
+    // Fill the buffer so that padding is known to be written
+    buffer.fill(0xff);
+    std::copy(plaintext_20.begin(), plaintext_20.end(), buffer.begin() + 8);
+
+    // Perform the AES key wrap and unwrap on the 20 octet plaintext
+    STF_ASSERT_EQ(expected_ciphertext_20.size(),
+                  aes_kw.WrapWithPaddingInPlace(buffer, plaintext_20.size()));
+    STF_ASSERT_MEM_EQ(expected_ciphertext_20.data(),
+                      buffer.data(),
+                      expected_ciphertext_20.size());
+    STF_ASSERT_EQ(plaintext_20.size(),
+                  aes_kw.UnwrapWithPaddingInPlace(
+                      {buffer.data(), expected_ciphertext_20.size()}));
+    STF_ASSERT_MEM_EQ(plaintext_20.data(),
+                      buffer.data() + 8,
+                      plaintext_20.size());
+
+    // Perform the AES key wrap and unwrap on the 7 octet plaintext
+    buffer.fill(0xff);
+    std::copy(plaintext_7.begin(), plaintext_7.end(), buffer.begin() + 8);
+    STF_ASSERT_EQ(expected_ciphertext_7.size(),
+                  aes_kw.WrapWithPaddingInPlace(buffer, plaintext_7.size()));
+    STF_ASSERT_MEM_EQ(expected_ciphertext_7.data(),
+                      buffer.data(),
+                      expected_ciphertext_7.size());
+    STF_ASSERT_EQ(plaintext_7.size(),
+                  aes_kw.UnwrapWithPaddingInPlace(
+                      {buffer.data(), expected_ciphertext_7.size()}));
+    STF_ASSERT_MEM_EQ(plaintext_7.data(),
+                      buffer.data() + 8,
+                      plaintext_7.size());
+
+    // Verify that a modified ciphertext fails the integrity check
+    std::copy(expected_ciphertext_20.begin(),
+              expected_ciphertext_20.end(),
+              buffer.begin());
+    buffer[0] ^= 0x80;
+    STF_ASSERT_EQ(std::size_t(0),
+                  aes_kw.UnwrapWithPaddingInPlace(
+                      {buffer.data(), expected_ciphertext_20.size()}));
+}
+
+// Compare batch wrap and unwrap against wrapping each key individually
+STF_TEST(AESKeyWrapBatch, WrapUnwrapKeys)
+{
+    const std::array<std::uint8_t, 16> key =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    };
+    constexpr std::size_t Keys = 13;
+    std::vector<std::vector<std::uint8_t>> plaintexts(Keys);
+    std::vector<std::vector<std::uint8_t>> ciphertexts(Keys);
+    std::vector<std::vector<std::uint8_t>> plaintext_checks(Keys);
+    std::vector<std::span<const std::uint8_t>> plaintext_spans;
+    std::vector<std::span<std::uint8_t>> ciphertext_spans;
+    std::vector<std::span<const std::uint8_t>> ciphertext_const_spans;
+    std::vector<std::span<std::uint8_t>> plaintext_check_spans;
+    std::array<bool, Keys> results{};
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        // Keys of differing lengths, from 16 to 64 octets
+        plaintexts[i].resize(16 + ((i * 5) % 7) * 8);
+        ciphertexts[i].resize(plaintexts[i].size() + 8);
+        plaintext_checks[i].resize(plaintexts[i].size());
+
+        for (std::size_t j = 0; j < plaintexts[i].size(); j++)
+        {
+            plaintexts[i][j] = static_cast<std::uint8_t>(i * 31 + j);
+        }
+
+        plaintext_spans.emplace_back(plaintexts[i]);
+        ciphertext_spans.emplace_back(ciphertexts[i]);
+        ciphertext_const_spans.emplace_back(ciphertexts[i]);
+        plaintext_check_spans.emplace_back(plaintext_checks[i]);
+    }
+
+    AESKeyWrap aes_kw(key);
+
+    aes_kw.WrapKeys(plaintext_spans, ciphertext_spans);
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        std::vector<std::uint8_t> expected_ciphertext(ciphertexts[i].size());
+
+        aes_kw.Wrap(plaintexts[i], expected_ciphertext);
+
+        STF_ASSERT_EQ(expected_ciphertext, ciphertexts[i]);
+    }
+
+    STF_ASSERT_EQ(std::size_t(0),
+                  aes_kw.UnwrapKeys(ciphertext_const_spans,
+                                    plaintext_check_spans,
+                                    results));
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        STF_ASSERT_TRUE(results[i]);
+        STF_ASSERT_EQ(plaintexts[i], plaintext_checks[i]);
+    }
+
+    // Corrupt two of the wrapped keys; only those should fail
+    ciphertexts[3][0] ^= 0x01;
+    ciphertexts[11].back() ^= 0x80;
+
+    STF_ASSERT_EQ(std::size_t(2),
+                  aes_kw.UnwrapKeys(ciphertext_const_spans,
+                                    plaintext_check_spans,
+                                    results));
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        if ((i == 3) || (i == 11))
+        {
+            STF_ASSERT_FALSE(results[i]);
+        }
+        else
+        {
+            STF_ASSERT_TRUE(results[i]);
+            STF_ASSERT_EQ(plaintexts[i], plaintext_checks[i]);
+        }
+    }
+}
+
+// Compare batch wrap and unwrap with padding against individual calls
+STF_TEST(AESKeyWrapBatch, WrapUnwrapKeysWithPadding)
+{
+    const std::array<std::uint8_t, 24> key =
+    {
+        0x58, 0x40, 0xdf, 0x6e, 0x29, 0xb0, 0x2a, 0xf1,
+        0xab, 0x49, 0x3b, 0x70, 0x5b, 0xf1, 0x6e, 0xa1,
+        0xae, 0x83, 0x38, 0xf4, 0xdc, 0xc1, 0x76, 0xa8
+    };
+    constexpr std::size_t Keys = 21;
+    std::vector<std::vector<std::uint8_t>> plaintexts(Keys);
+    std::vector<std::vector<std::uint8_t>> ciphertexts(Keys);
+    std::vector<std::vector<std::uint8_t>> plaintext_checks(Keys);
+    std::vector<std::span<const std::uint8_t>> plaintext_spans;
+    std::vector<std::span<std::uint8_t>> ciphertext_spans;
+    std::vector<std::span<const std::uint8_t>> ciphertext_const_spans;
+    std::vector<std::span<std::uint8_t>> plaintext_check_spans;
+    std::array<std::size_t, Keys> ciphertext_lengths{};
+    std::array<std::size_t, Keys> plaintext_lengths{};
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        // Keys of 1 to 41 octets, including those wrapped as a single block
+        plaintexts[i].resize(1 + i * 2);
+        ciphertexts[i].resize(plaintexts[i].size() + 16);
+
+        for (std::size_t j = 0; j < plaintexts[i].size(); j++)
+        {
+            plaintexts[i][j] = static_cast<std::uint8_t>(i * 17 + j + 1);
+        }
+
+        plaintext_spans.emplace_back(plaintexts[i]);
+        ciphertext_spans.emplace_back(ciphertexts[i]);
+    }
+
+    AESKeyWrap aes_kw(key);
+
+    aes_kw.WrapKeysWithPadding(plaintext_spans,
+                               ciphertext_spans,
+                               ciphertext_lengths);
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        std::vector<std::uint8_t> expected_ciphertext(ciphertexts[i].size());
+
+        STF_ASSERT_EQ(aes_kw.WrapWithPadding(plaintexts[i],
+                                             expected_ciphertext),
+                      ciphertext_lengths[i]);
+
+        STF_ASSERT_MEM_EQ(expected_ciphertext.data(),
+                          ciphertexts[i].data(),
+                          ciphertext_lengths[i]);
+
+        // Unwrap only the octets produced
+        ciphertext_const_spans.emplace_back(ciphertexts[i].data(),
+                                            ciphertext_lengths[i]);
+        plaintext_checks[i].resize(ciphertext_lengths[i] - 8);
+        plaintext_check_spans.emplace_back(plaintext_checks[i]);
+    }
+
+    STF_ASSERT_EQ(std::size_t(0),
+                  aes_kw.UnwrapKeysWithPadding(ciphertext_const_spans,
+                                               plaintext_check_spans,
+                                               plaintext_lengths));
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        STF_ASSERT_EQ(plaintexts[i].size(), plaintext_lengths[i]);
+        STF_ASSERT_MEM_EQ(plaintexts[i].data(),
+                          plaintext_checks[i].data(),
+                          plaintexts[i].size());
+    }
+
+    // Corrupt a single block key and a multi-block key
+    ciphertexts[2][5] ^= 0x10;
+    ciphertexts[15][0] ^= 0x01;
+
+    STF_ASSERT_EQ(std::size_t(2),
+                  aes_kw.UnwrapKeysWithPadding(ciphertext_const_spans,
+                                               plaintext_check_spans,
+                                               plaintext_lengths));
+
+    for (std::size_t i = 0; i < Keys; i++)
+    {
+        if ((i == 2) || (i == 15))
+        {
+            STF_ASSERT_EQ(std::size_t(0), plaintext_lengths[i]);
+        }
+        else
+        {
+            STF_ASSERT_EQ(plaintexts[i].size(), plaintext_lengths[i]);
+        }
+    }
+}
+
+// Ensure the batch functions reject invalid span lengths
+STF_TEST(AESKeyWrapBatch, InvalidLength)
+{
+    const std::array<std::uint8_t, 16> key{};
+    std::array<std::uint8_t, 16> plaintext{};
+    std::array<std::uint8_t, 16> short_ciphertext{};
+    std::array<std::span<const std::uint8_t>, 1> plaintext_spans = {plaintext};
+    std::array<std::span<std::uint8_t>, 1> ciphertext_spans = {
+        short_ciphertext};
+    std::array<std::span<const std::uint8_t>, 1> ciphertext_const_spans = {
+        short_ciphertext};
+    std::array<std::span<std::uint8_t>, 1> plaintext_out_spans = {plaintext};
+    std::array<bool, 2> results{};
+    std::array<std::size_t, 1> lengths{};
+    std::size_t exceptions{};
+
+    AESKeyWrap aes_kw(key);
+
+    // Ciphertext must be eight octets longer than the plaintext
+    try
+    {
+        aes_kw.WrapKeys(plaintext_spans, ciphertext_spans);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    // The number of results must match the number of keys
+    try
+    {
+        aes_kw.UnwrapKeys(ciphertext_const_spans, plaintext_out_spans, results);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    // Ciphertext buffer is too short for 16 octets of plaintext
+    try
+    {
+        aes_kw.WrapKeysWithPadding(plaintext_spans, ciphertext_spans, lengths);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    // Plaintext buffer count differs from the ciphertext count
+    try
+    {
+        aes_kw.UnwrapKeysWithPadding(ciphertext_const_spans, {}, lengths);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    STF_ASSERT_EQ(std::size_t(4), exceptions);
+}
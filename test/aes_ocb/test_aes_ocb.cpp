@@ -0,0 +1,676 @@
+/*
+ *  test_aes_ocb.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the OCB (RFC 7253) authenticated encryption
+ *      logic, including incremental processing of associated data.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <span>
+#include <terra/crypto/cipher/aes_ocb.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Sample results from RFC 7253 Appendix A
+struct SampleResult
+{
+    std::size_t aad_length;
+    std::size_t text_length;
+    std::vector<std::uint8_t> ciphertext_and_tag;
+};
+
+// Key and nonce prefix used for the samples in RFC 7253 Appendix A
+constexpr std::array<std::uint8_t, 16> Sample_Key =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+// The A and P values for each sample are a prefix of this sequence
+constexpr std::array<std::uint8_t, 40> Sample_Data =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27
+};
+
+const std::vector<SampleResult> Sample_Results =
+{
+    {
+        0, 0,
+        {
+            0x78, 0x54, 0x07, 0xbf, 0xff, 0xc8, 0xad, 0x9e,
+            0xdc, 0xc5, 0x52, 0x0a, 0xc9, 0x11, 0x1e, 0xe6
+        }
+    },
+    {
+        8, 8,
+        {
+            0x68, 0x20, 0xb3, 0x65, 0x7b, 0x6f, 0x61, 0x5a,
+            0x57, 0x25, 0xbd, 0xa0, 0xd3, 0xb4, 0xeb, 0x3a,
+            0x25, 0x7c, 0x9a, 0xf1, 0xf8, 0xf0, 0x30, 0x09
+        }
+    },
+    {
+        8, 0,
+        {
+            0x81, 0x01, 0x7f, 0x82, 0x03, 0xf0, 0x81, 0x27,
+            0x71, 0x52, 0xfa, 0xde, 0x69, 0x4a, 0x0a, 0x00
+        }
+    },
+    {
+        0, 8,
+        {
+            0x45, 0xdd, 0x69, 0xf8, 0xf5, 0xaa, 0xe7, 0x24,
+            0x14, 0x05, 0x4c, 0xd1, 0xf3, 0x5d, 0x82, 0x76,
+            0x0b, 0x2c, 0xd0, 0x0d, 0x2f, 0x99, 0xbf, 0xa9
+        }
+    },
+    {
+        16, 16,
+        {
+            0x57, 0x1d, 0x53, 0x5b, 0x60, 0xb2, 0x77, 0x18,
+            0x8b, 0xe5, 0x14, 0x71, 0x70, 0xa9, 0xa2, 0x2c,
+            0x3a, 0xd7, 0xa4, 0xff, 0x38, 0x35, 0xb8, 0xc5,
+            0x70, 0x1c, 0x1c, 0xce, 0xc8, 0xfc, 0x33, 0x58
+        }
+    },
+    {
+        16, 0,
+        {
+            0x8c, 0xf7, 0x61, 0xb6, 0x90, 0x2e, 0xf7, 0x64,
+            0x46, 0x2a, 0xd8, 0x64, 0x98, 0xca, 0x6b, 0x97
+        }
+    },
+    {
+        0, 16,
+        {
+            0x5c, 0xe8, 0x8e, 0xc2, 0xe0, 0x69, 0x27, 0x06,
+            0xa9, 0x15, 0xc0, 0x0a, 0xeb, 0x8b, 0x23, 0x96,
+            0xf4, 0x0e, 0x1c, 0x74, 0x3f, 0x52, 0x43, 0x6b,
+            0xdf, 0x06, 0xd8, 0xfa, 0x1e, 0xca, 0x34, 0x3d
+        }
+    },
+    {
+        24, 24,
+        {
+            0x1c, 0xa2, 0x20, 0x73, 0x08, 0xc8, 0x7c, 0x01,
+            0x07, 0x56, 0x10, 0x4d, 0x88, 0x40, 0xce, 0x19,
+            0x52, 0xf0, 0x96, 0x73, 0xa4, 0x48, 0xa1, 0x22,
+            0xc9, 0x2c, 0x62, 0x24, 0x10, 0x51, 0xf5, 0x73,
+            0x56, 0xd7, 0xf3, 0xc9, 0x0b, 0xb0, 0xe0, 0x7f
+        }
+    },
+    {
+        24, 0,
+        {
+            0x6d, 0xc2, 0x25, 0xa0, 0x71, 0xfc, 0x1b, 0x9f,
+            0x7c, 0x69, 0xf9, 0x3b, 0x0f, 0x1e, 0x10, 0xde
+        }
+    },
+    {
+        0, 24,
+        {
+            0x22, 0x1b, 0xd0, 0xde, 0x7f, 0xa6, 0xfe, 0x99,
+            0x3e, 0xcc, 0xd7, 0x69, 0x46, 0x0a, 0x0a, 0xf2,
+            0xd6, 0xcd, 0xed, 0x0c, 0x39, 0x5b, 0x1c, 0x3c,
+            0xe7, 0x25, 0xf3, 0x24, 0x94, 0xb9, 0xf9, 0x14,
+            0xd8, 0x5c, 0x0b, 0x1e, 0xb3, 0x83, 0x57, 0xff
+        }
+    },
+    {
+        32, 32,
+        {
+            0xbd, 0x6f, 0x6c, 0x49, 0x62, 0x01, 0xc6, 0x92,
+            0x96, 0xc1, 0x1e, 0xfd, 0x13, 0x8a, 0x46, 0x7a,
+            0xbd, 0x3c, 0x70, 0x79, 0x24, 0xb9, 0x64, 0xde,
+            0xaf, 0xfc, 0x40, 0x31, 0x9a, 0xf5, 0xa4, 0x85,
+            0x40, 0xfb, 0xba, 0x18, 0x6c, 0x55, 0x53, 0xc6,
+            0x8a, 0xd9, 0xf5, 0x92, 0xa7, 0x9a, 0x42, 0x40
+        }
+    },
+    {
+        32, 0,
+        {
+            0xfe, 0x80, 0x69, 0x0b, 0xee, 0x8a, 0x48, 0x5d,
+            0x11, 0xf3, 0x29, 0x65, 0xbc, 0x9d, 0x2a, 0x32
+        }
+    },
+    {
+        0, 32,
+        {
+            0x29, 0x42, 0xbf, 0xc7, 0x73, 0xbd, 0xa2, 0x3c,
+            0xab, 0xc6, 0xac, 0xfd, 0x9b, 0xfd, 0x58, 0x35,
+            0xbd, 0x30, 0x0f, 0x09, 0x73, 0x79, 0x2e, 0xf4,
+            0x60, 0x40, 0xc5, 0x3f, 0x14, 0x32, 0xbc, 0xdf,
+            0xb5, 0xe1, 0xdd, 0xe3, 0xbc, 0x18, 0xa5, 0xf8,
+            0x40, 0xb5, 0x2e, 0x65, 0x34, 0x44, 0xd5, 0xdf
+        }
+    },
+    {
+        40, 40,
+        {
+            0xd5, 0xca, 0x91, 0x74, 0x84, 0x10, 0xc1, 0x75,
+            0x1f, 0xf8, 0xa2, 0xf6, 0x18, 0x25, 0x5b, 0x68,
+            0xa0, 0xa1, 0x2e, 0x09, 0x3f, 0xf4, 0x54, 0x60,
+            0x6e, 0x59, 0xf9, 0xc1, 0xd0, 0xdd, 0xc5, 0x4b,
+            0x65, 0xe8, 0x62, 0x8e, 0x56, 0x8b, 0xad, 0x7a,
+            0xed, 0x07, 0xba, 0x06, 0xa4, 0xa6, 0x94, 0x83,
+            0xa7, 0x03, 0x54, 0x90, 0xc5, 0x76, 0x9e, 0x60
+        }
+    },
+    {
+        40, 0,
+        {
+            0xc5, 0xcd, 0x9d, 0x18, 0x50, 0xc1, 0x41, 0xe3,
+            0x58, 0x64, 0x99, 0x94, 0xee, 0x70, 0x1b, 0x68
+        }
+    },
+    {
+        0, 40,
+        {
+            0x44, 0x12, 0x92, 0x34, 0x93, 0xc5, 0x7d, 0x5d,
+            0xe0, 0xd7, 0x00, 0xf7, 0x53, 0xcc, 0xe0, 0xd1,
+            0xd2, 0xd9, 0x50, 0x60, 0x12, 0x2e, 0x9f, 0x15,
+            0xa5, 0xdd, 0xbf, 0xc5, 0x78, 0x7e, 0x50, 0xb5,
+            0xcc, 0x55, 0xee, 0x50, 0x7b, 0xcb, 0x08, 0x4e,
+            0x47, 0x9a, 0xd3, 0x63, 0xac, 0x36, 0x6b, 0x95,
+            0xa9, 0x8c, 0xa5, 0xf3, 0x00, 0x0b, 0x14, 0x79
+        }
+    }
+};
+
+// Return the nonce for the given sample in RFC 7253 Appendix A
+std::array<std::uint8_t, 12> SampleNonce(std::size_t sample)
+{
+    return
+    {
+        0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44,
+        0x33, 0x22, 0x11, static_cast<std::uint8_t>(sample)
+    };
+}
+
+// Return the result of the iterated test in RFC 7253 Appendix A
+std::vector<std::uint8_t> IteratedResult(std::size_t key_length,
+                                         std::size_t tag_length)
+{
+    std::vector<std::uint8_t> key(key_length);
+    std::vector<std::uint8_t> S;
+    std::vector<std::uint8_t> C;
+    std::vector<std::uint8_t> output(128 + 16);
+    std::array<std::uint8_t, 12> nonce{};
+    std::vector<std::uint8_t> tag(tag_length);
+
+    // K = zeros(KEYLEN - 8) || num2str(TAGLEN, 8)
+    key.back() = static_cast<std::uint8_t>(tag_length * 8);
+
+    AESOCB aes_ocb(key);
+
+    // Append the ciphertext and tag for the given nonce, A, and P to C
+    auto append = [&](std::size_t n,
+                      const std::vector<std::uint8_t> &aad,
+                      const std::vector<std::uint8_t> &plaintext)
+    {
+        nonce[10] = static_cast<std::uint8_t>(n >> 8);
+        nonce[11] = static_cast<std::uint8_t>(n);
+
+        std::span<std::uint8_t> ciphertext(output.data(), plaintext.size());
+        aes_ocb.Encrypt(nonce, aad, plaintext, ciphertext, tag);
+
+        C.insert(C.end(), ciphertext.begin(), ciphertext.end());
+        C.insert(C.end(), tag.begin(), tag.end());
+    };
+
+    for (std::size_t i = 0; i < 128; i++)
+    {
+        S.assign(i, 0);
+
+        append(3 * i + 1, S, S);
+        append(3 * i + 2, {}, S);
+        append(3 * i + 3, S, {});
+    }
+
+    nonce[10] = static_cast<std::uint8_t>(385 >> 8);
+    nonce[11] = static_cast<std::uint8_t>(385 & 0xff);
+    aes_ocb.Encrypt(nonce, C, {}, {}, tag);
+
+    return tag;
+}
+
+} // namespace
+
+// Test the samples in RFC 7253 Appendix A
+STF_TEST(AESOCB, RFC7253_Samples)
+{
+    AESOCB aes_ocb(Sample_Key);
+
+    for (std::size_t i = 0; i < Sample_Results.size(); i++)
+    {
+        const SampleResult &result = Sample_Results[i];
+        const std::array<std::uint8_t, 12> nonce = SampleNonce(i);
+        std::span<const std::uint8_t> aad(Sample_Data.data(),
+                                          result.aad_length);
+        std::span<const std::uint8_t> plaintext(Sample_Data.data(),
+                                                result.text_length);
+        std::vector<std::uint8_t> ciphertext(result.text_length);
+        std::vector<std::uint8_t> decrypted(result.text_length);
+        std::array<std::uint8_t, 16> tag{};
+
+        aes_ocb.Encrypt(nonce, aad, plaintext, ciphertext, tag);
+
+        STF_ASSERT_EQ(result.text_length + tag.size(),
+                      result.ciphertext_and_tag.size());
+        STF_ASSERT_MEM_EQ(result.ciphertext_and_tag.data(),
+                          ciphertext.data(),
+                          ciphertext.size());
+        STF_ASSERT_MEM_EQ(result.ciphertext_and_tag.data() + ciphertext.size(),
+                          tag.data(),
+                          tag.size());
+
+        STF_ASSERT_TRUE(
+            aes_ocb.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+        STF_ASSERT_MEM_EQ(plaintext.data(), decrypted.data(), decrypted.size());
+    }
+}
+
+// Test the sample in RFC 7253 Appendix A having a 96-bit tag
+STF_TEST(AESOCB, RFC7253_Sample_Tag_96)
+{
+    const std::array<std::uint8_t, 16> key =
+    {
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+        0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
+    };
+    const std::array<std::uint8_t, 12> nonce =
+    {
+        0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44,
+        0x33, 0x22, 0x11, 0x0d
+    };
+    const std::array<std::uint8_t, 40> ciphertext =
+    {
+        0x17, 0x92, 0xa4, 0xe3, 0x1e, 0x07, 0x55, 0xfb,
+        0x03, 0xe3, 0x1b, 0x22, 0x11, 0x6e, 0x6c, 0x2d,
+        0xdf, 0x9e, 0xfd, 0x6e, 0x33, 0xd5, 0x36, 0xf1,
+        0xa0, 0x12, 0x4b, 0x0a, 0x55, 0xba, 0xe8, 0x84,
+        0xed, 0x93, 0x48, 0x15, 0x29, 0xc7, 0x6b, 0x6a
+    };
+    const std::array<std::uint8_t, 12> expected_tag =
+    {
+        0xd0, 0xc5, 0x15, 0xf4, 0xd1, 0xcd, 0xd4, 0xfd,
+        0xac, 0x4f, 0x02, 0xaa
+    };
+    std::array<std::uint8_t, 40> output{};
+    std::array<std::uint8_t, 12> tag{};
+
+    AESOCB aes_ocb(key);
+
+    aes_ocb.Encrypt(nonce, Sample_Data, Sample_Data, output, tag);
+    STF_ASSERT_MEM_EQ(ciphertext.data(), output.data(), output.size());
+    STF_ASSERT_MEM_EQ(expected_tag.data(), tag.data(), tag.size());
+
+    STF_ASSERT_TRUE(aes_ocb.Decrypt(nonce, Sample_Data, output, output, tag));
+    STF_ASSERT_MEM_EQ(Sample_Data.data(), output.data(), output.size());
+}
+
+// Test the iterated test in RFC 7253 Appendix A for each key length with a
+// 128-bit tag and for a 128-bit key with 96-bit and 64-bit tags
+STF_TEST(AESOCB, RFC7253_Iterated)
+{
+    const std::vector<std::uint8_t> expected_128 =
+    {
+        0x67, 0xe9, 0x44, 0xd2, 0x32, 0x56, 0xc5, 0xe0,
+        0xb6, 0xc6, 0x1f, 0xa2, 0x2f, 0xdf, 0x1e, 0xa2
+    };
+    const std::vector<std::uint8_t> expected_192 =
+    {
+        0xf6, 0x73, 0xf2, 0xc3, 0xe7, 0x17, 0x4a, 0xae,
+        0x7b, 0xae, 0x98, 0x6c, 0xa9, 0xf2, 0x9e, 0x17
+    };
+    const std::vector<std::uint8_t> expected_256 =
+    {
+        0xd9, 0x0e, 0xb8, 0xe9, 0xc9, 0x77, 0xc8, 0x8b,
+        0x79, 0xdd, 0x79, 0x3d, 0x7f, 0xfa, 0x16, 0x1c
+    };
+    const std::vector<std::uint8_t> expected_128_96 =
+    {
+        0x77, 0xa3, 0xd8, 0xe7, 0x35, 0x89, 0x15, 0x8d,
+        0x25, 0xd0, 0x12, 0x09
+    };
+    const std::vector<std::uint8_t> expected_128_64 =
+    {
+        0x19, 0x2c, 0x9b, 0x7b, 0xd9, 0x0b, 0xa0, 0x6a
+    };
+
+    STF_ASSERT_EQ(expected_128, IteratedResult(16, 16));
+    STF_ASSERT_EQ(expected_192, IteratedResult(24, 16));
+    STF_ASSERT_EQ(expected_256, IteratedResult(32, 16));
+    STF_ASSERT_EQ(expected_128_96, IteratedResult(16, 12));
+    STF_ASSERT_EQ(expected_128_64, IteratedResult(16, 8));
+}
+
+// Test a message spanning several groups of pipelined blocks and ending
+// with a partial block, with associated data also ending in a partial block
+STF_TEST(AESOCB, LongMessage)
+{
+    const std::array<std::uint8_t, 32> key =
+    {
+        0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+        0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+        0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,
+        0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f
+    };
+    const std::array<std::uint8_t, 12> nonce =
+    {
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b
+    };
+    const std::array<std::uint8_t, 300> expected =
+    {
+        0x51, 0x28, 0x3d, 0x43, 0xfa, 0xe2, 0x48, 0xc5,
+        0x5e, 0x08, 0xa8, 0x0c, 0x17, 0xf2, 0xff, 0x70,
+        0x16, 0x20, 0x5e, 0xb1, 0x4e, 0xd2, 0x9b, 0xea,
+        0xb3, 0xb4, 0x9c, 0xf4, 0x38, 0x60, 0x78, 0x2c,
+        0xdb, 0xed, 0xe0, 0x66, 0x6f, 0xe8, 0x73, 0xbe,
+        0x0e, 0x78, 0xed, 0x1f, 0x26, 0x45, 0x63, 0x8d,
+        0x16, 0x7a, 0x15, 0x08, 0x28, 0x86, 0x1c, 0xc2,
+        0x48, 0x02, 0xad, 0x7f, 0x2e, 0xa2, 0xf5, 0xe3,
+        0x6e, 0xf4, 0xa8, 0x83, 0xf2, 0x5e, 0x53, 0x63,
+        0xc2, 0x10, 0x63, 0x9f, 0xda, 0x22, 0x07, 0x5e,
+        0x3c, 0x95, 0x14, 0xe8, 0x25, 0xaf, 0x3f, 0x49,
+        0x0c, 0x8f, 0x66, 0x8f, 0x30, 0x36, 0x3e, 0x92,
+        0x2f, 0xbe, 0x18, 0xf1, 0x4e, 0x9e, 0xfe, 0xa3,
+        0xc0, 0xa6, 0x5c, 0x64, 0x2f, 0x28, 0xa9, 0x0c,
+        0xec, 0x37, 0x08, 0xfe, 0x2d, 0x16, 0x97, 0x6d,
+        0x2d, 0x96, 0x70, 0x7c, 0xa4, 0x32, 0x5f, 0x07,
+        0x8c, 0x7f, 0xe3, 0x1c, 0xa5, 0x17, 0x3b, 0xc2,
+        0x23, 0x24, 0xa6, 0xc9, 0x17, 0xc9, 0x27, 0xf1,
+        0xda, 0xb2, 0x2c, 0xbb, 0xa2, 0xcf, 0x5b, 0x8c,
+        0x3e, 0x2a, 0x05, 0x98, 0x0f, 0x05, 0x4e, 0x21,
+        0x21, 0x16, 0x98, 0x4b, 0x02, 0x98, 0xf0, 0xc5,
+        0xd5, 0x2a, 0xb6, 0x47, 0x5f, 0xb8, 0xc0, 0xf7,
+        0x21, 0x3f, 0x6e, 0xd7, 0x13, 0xcb, 0x6e, 0xa3,
+        0x2b, 0xa6, 0x39, 0x0a, 0xd2, 0xab, 0xb7, 0x44,
+        0x74, 0xf5, 0xd9, 0xe2, 0xeb, 0xc5, 0x20, 0xbd,
+        0xd0, 0xac, 0x16, 0x76, 0x20, 0x95, 0x33, 0xef,
+        0x4c, 0xd0, 0xc1, 0x1d, 0x61, 0xb9, 0xb3, 0x2e,
+        0x99, 0xd0, 0x53, 0x5e, 0x4a, 0x69, 0x88, 0x09,
+        0xde, 0x27, 0xb1, 0x6a, 0x61, 0xd2, 0x21, 0x09,
+        0x92, 0x6f, 0x1a, 0x4a, 0x59, 0xa9, 0xcb, 0xa8,
+        0x2e, 0x68, 0x0e, 0x04, 0x1d, 0xc5, 0x23, 0xba,
+        0x9e, 0x88, 0xb7, 0x9f, 0xad, 0x42, 0xd3, 0xee,
+        0xe2, 0x51, 0x51, 0xf8, 0xa7, 0x2f, 0xd6, 0x23,
+        0x15, 0x09, 0x1d, 0x68, 0xc6, 0x38, 0x8a, 0x00,
+        0x9b, 0x6b, 0x89, 0x63, 0xb1, 0x06, 0x20, 0x91,
+        0x9a, 0x46, 0xbe, 0xc9, 0x9f, 0x5e, 0x9e, 0xc5,
+        0x6f, 0xf4, 0x09, 0xa0, 0x70, 0x35, 0xf0, 0xc8,
+        0xbb, 0xf6, 0xd9, 0x93
+    };
+    const std::array<std::uint8_t, 16> expected_tag =
+    {
+        0x60, 0xe1, 0x27, 0xa9, 0xaf, 0x09, 0x7c, 0x2e,
+        0xbc, 0xcd, 0x17, 0xb7, 0x35, 0x97, 0xde, 0xd5
+    };
+    std::vector<std::uint8_t> aad(75);
+    std::vector<std::uint8_t> plaintext(300);
+    std::vector<std::uint8_t> ciphertext(plaintext.size());
+    std::vector<std::uint8_t> decrypted(plaintext.size());
+    std::array<std::uint8_t, 16> tag{};
+
+    for (std::size_t i = 0; i < aad.size(); i++)
+    {
+        aad[i] = static_cast<std::uint8_t>(i * 7);
+    }
+    for (std::size_t i = 0; i < plaintext.size(); i++)
+    {
+        plaintext[i] = static_cast<std::uint8_t>(i * 3 + 1);
+    }
+
+    AESOCB aes_ocb(key);
+
+    aes_ocb.Encrypt(nonce, aad, plaintext, ciphertext, tag);
+    STF_ASSERT_MEM_EQ(expected.data(), ciphertext.data(), ciphertext.size());
+    STF_ASSERT_MEM_EQ(expected_tag.data(), tag.data(), tag.size());
+
+    STF_ASSERT_TRUE(aes_ocb.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(plaintext.data(), decrypted.data(), decrypted.size());
+}
+
+// Test that associated data provided in pieces produces the same result as
+// providing it all at once
+STF_TEST(AESOCB, IncrementalAAD)
+{
+    std::vector<std::uint8_t> aad(150);
+    std::array<std::uint8_t, 40> expected{};
+    std::array<std::uint8_t, 16> expected_tag{};
+    std::array<std::uint8_t, 40> ciphertext{};
+    std::array<std::uint8_t, 40> decrypted{};
+    std::array<std::uint8_t, 16> tag{};
+    const std::array<std::uint8_t, 12> nonce = SampleNonce(0);
+
+    for (std::size_t i = 0; i < aad.size(); i++)
+    {
+        aad[i] = static_cast<std::uint8_t>(i);
+    }
+
+    AESOCB aes_ocb(Sample_Key);
+
+    aes_ocb.Encrypt(nonce, aad, Sample_Data, expected, expected_tag);
+
+    for (const std::size_t piece : {1u, 5u, 15u, 16u, 17u, 64u, 149u, 150u})
+    {
+        for (std::size_t i = 0; i < aad.size(); i += piece)
+        {
+            aes_ocb.UpdateAAD(
+                std::span(aad).subspan(i, std::min(piece, aad.size() - i)));
+        }
+
+        aes_ocb.Encrypt(nonce, Sample_Data, ciphertext, tag);
+        STF_ASSERT_MEM_EQ(expected.data(), ciphertext.data(), expected.size());
+        STF_ASSERT_MEM_EQ(expected_tag.data(), tag.data(), tag.size());
+
+        // The associated data was consumed, so provide it again to decrypt
+        aes_ocb.UpdateAAD(std::span(aad).first(piece));
+        aes_ocb.UpdateAAD(std::span(aad).subspan(piece));
+
+        STF_ASSERT_TRUE(aes_ocb.Decrypt(nonce, ciphertext, decrypted, tag));
+        STF_ASSERT_MEM_EQ(Sample_Data.data(),
+                          decrypted.data(),
+                          decrypted.size());
+    }
+
+    // Associated data given directly replaces that given via UpdateAAD()
+    aes_ocb.UpdateAAD(aad);
+    aes_ocb.Encrypt(nonce, aad, Sample_Data, ciphertext, tag);
+    STF_ASSERT_MEM_EQ(expected_tag.data(), tag.data(), tag.size());
+
+    // ResetAAD() discards associated data given via UpdateAAD()
+    aes_ocb.UpdateAAD(aad);
+    aes_ocb.ResetAAD();
+    aes_ocb.UpdateAAD(aad);
+    aes_ocb.Encrypt(nonce, Sample_Data, ciphertext, tag);
+    STF_ASSERT_MEM_EQ(expected_tag.data(), tag.data(), tag.size());
+}
+
+// Test that reusing Ktop across nonces sharing all but the low six bits
+// produces the same results as computing it for each nonce
+STF_TEST(AESOCB, NonceSequence)
+{
+    std::array<std::uint8_t, 12> nonce = SampleNonce(0);
+    std::array<std::uint8_t, 40> ciphertext{};
+    std::array<std::uint8_t, 40> expected{};
+    std::array<std::uint8_t, 16> tag{};
+    std::array<std::uint8_t, 16> expected_tag{};
+
+    AESOCB aes_ocb(Sample_Key);
+
+    for (std::size_t i = 0; i < 300; i++)
+    {
+        nonce[10] = static_cast<std::uint8_t>(i >> 8);
+        nonce[11] = static_cast<std::uint8_t>(i);
+
+        AESOCB aes_ocb_once(Sample_Key);
+
+        aes_ocb_once.Encrypt(nonce, {}, Sample_Data, expected, expected_tag);
+        aes_ocb.Encrypt(nonce, {}, Sample_Data, ciphertext, tag);
+
+        STF_ASSERT_MEM_EQ(expected.data(), ciphertext.data(), expected.size());
+        STF_ASSERT_MEM_EQ(expected_tag.data(), tag.data(), tag.size());
+    }
+}
+
+// Test encryption and decryption in place
+STF_TEST(AESOCB, InPlace)
+{
+    std::vector<std::uint8_t> data(203);
+    std::vector<std::uint8_t> original(data.size());
+    std::vector<std::uint8_t> expected(data.size());
+    std::array<std::uint8_t, 12> nonce = SampleNonce(1);
+    std::array<std::uint8_t, 16> tag{};
+    std::array<std::uint8_t, 16> expected_tag{};
+
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i);
+    }
+    original = data;
+
+    AESOCB aes_ocb(Sample_Key);
+
+    // Produce the expected result using separate buffers
+    aes_ocb.Encrypt(nonce, Sample_Data, original, expected, expected_tag);
+
+    aes_ocb.Encrypt(nonce, Sample_Data, data, data, tag);
+    STF_ASSERT_MEM_EQ(expected.data(), data.data(), data.size());
+    STF_ASSERT_MEM_EQ(expected_tag.data(), tag.data(), tag.size());
+
+    STF_ASSERT_TRUE(aes_ocb.Decrypt(nonce, Sample_Data, data, data, tag));
+    STF_ASSERT_MEM_EQ(original.data(), data.data(), data.size());
+}
+
+// Test that modification of the tag, ciphertext, associated data, or nonce
+// is detected and that no plaintext is released
+STF_TEST(AESOCB, Tampered)
+{
+    std::vector<std::uint8_t> plaintext(70, 0x5a);
+    std::vector<std::uint8_t> ciphertext(plaintext.size());
+    std::vector<std::uint8_t> decrypted(plaintext.size());
+    const std::vector<std::uint8_t> zeros(plaintext.size());
+    std::array<std::uint8_t, 15> nonce{};
+    std::array<std::uint8_t, 20> aad{};
+    std::array<std::uint8_t, 12> tag{};
+
+    AESOCB aes_ocb(Sample_Key);
+
+    aes_ocb.Encrypt(nonce, aad, plaintext, ciphertext, tag);
+
+    // Modify the tag
+    tag[11] ^= 0x01;
+    STF_ASSERT_FALSE(
+        aes_ocb.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(zeros.data(), decrypted.data(), decrypted.size());
+    tag[11] ^= 0x01;
+
+    // Modify a complete block and then the partial block of ciphertext
+    for (const std::size_t position : {20u, 68u})
+    {
+        ciphertext[position] ^= 0x80;
+        STF_ASSERT_FALSE(
+            aes_ocb.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+        STF_ASSERT_MEM_EQ(zeros.data(), decrypted.data(), decrypted.size());
+        ciphertext[position] ^= 0x80;
+    }
+
+    // Modify the associated data
+    aad[19] ^= 0x01;
+    STF_ASSERT_FALSE(
+        aes_ocb.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(zeros.data(), decrypted.data(), decrypted.size());
+    aad[19] ^= 0x01;
+
+    // Modify the nonce
+    nonce[0] ^= 0x01;
+    STF_ASSERT_FALSE(
+        aes_ocb.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(zeros.data(), decrypted.data(), decrypted.size());
+    nonce[0] ^= 0x01;
+
+    // A shorter tag is not a truncation of the longer tag
+    STF_ASSERT_FALSE(aes_ocb.Decrypt(nonce,
+                                     aad,
+                                     ciphertext,
+                                     decrypted,
+                                     std::span(tag).first(8)));
+
+    // Unmodified input should decrypt
+    STF_ASSERT_TRUE(aes_ocb.Decrypt(nonce, aad, ciphertext, decrypted, tag));
+    STF_ASSERT_MEM_EQ(plaintext.data(), decrypted.data(), decrypted.size());
+}
+
+// Test that invalid nonce, tag, and span lengths are rejected
+STF_TEST(AESOCB, InvalidLengths)
+{
+    std::vector<std::uint8_t> plaintext(32);
+    std::vector<std::uint8_t> ciphertext(plaintext.size());
+    std::array<std::uint8_t, 16> nonce{};
+    std::array<std::uint8_t, 17> tag{};
+
+    AESOCB aes_ocb(Sample_Key);
+
+    // Nonce empty or too long
+    for (const std::size_t length : {0u, 16u})
+    {
+        STF_ASSERT_EXCEPTION_E(
+            aes_ocb.Encrypt(std::span(nonce).first(length),
+                            plaintext,
+                            ciphertext,
+                            std::span(tag).first(16)),
+            AESException);
+    }
+
+    // Tag too short or too long
+    for (const std::size_t length : {0u, 3u, 17u})
+    {
+        STF_ASSERT_EXCEPTION_E(
+            aes_ocb.Encrypt(std::span(nonce).first(12),
+                            plaintext,
+                            ciphertext,
+                            std::span(tag).first(length)),
+            AESException);
+    }
+
+    // Output span length does not match the input
+    STF_ASSERT_EXCEPTION_E(
+        aes_ocb.Encrypt(std::span(nonce).first(12),
+                        {},
+                        plaintext,
+                        std::span(ciphertext).first(31),
+                        std::span(tag).first(16)),
+        AESException);
+    STF_ASSERT_EXCEPTION_E(
+        aes_ocb.Decrypt(std::span(nonce).first(12),
+                        {},
+                        std::span(ciphertext).first(31),
+                        plaintext,
+                        std::span(tag).first(16)),
+        AESException);
+}
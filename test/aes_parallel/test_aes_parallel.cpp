@@ -0,0 +1,384 @@
+/*
+ *  test_aes_parallel.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AESParallel object, verifying that
+ *      each mode produces the same output as the corresponding single-
+ *      threaded object.  Small chunk sizes are used so that each buffer is
+ *      split across many tasks.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <vector>
+#include <terra/crypto/cipher/aes.h>
+#include <terra/crypto/cipher/aes_ctr.h>
+#include <terra/crypto/cipher/aes_cbc.h>
+#include <terra/crypto/cipher/aes_xts.h>
+#include <terra/crypto/cipher/aes_gcm.h>
+#include <terra/crypto/cipher/aes_key_schedule.h>
+#include <terra/crypto/cipher/aes_parallel.h>
+#include <terra/stf/adapters/integral_vector.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+const std::uint8_t aes_key[64] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+    0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f
+};
+
+// Produce a buffer of the given length with varying content
+std::vector<std::uint8_t> MakeData(std::size_t length)
+{
+    std::vector<std::uint8_t> data(length);
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i * 7 + (i >> 8));
+    }
+
+    return data;
+}
+
+} // namespace
+
+// Compare ECB encryption and decryption against the AES object
+STF_TEST(AESParallel, TestBlocks)
+{
+    const AESParallel parallel(4, 256);
+    const AESKeySchedule key_schedule({aes_key, 16});
+    AES aes({aes_key, 16});
+
+    for (std::size_t blocks : {1, 15, 16, 17, 100, 1000})
+    {
+        std::vector<std::uint8_t> data = MakeData(blocks * 16);
+        std::vector<std::uint8_t> expected(data.size());
+        std::vector<std::uint8_t> ciphertext(data.size());
+
+        aes.EncryptBlocks(data, expected);
+
+        parallel.EncryptBlocks(key_schedule, data, ciphertext);
+        STF_ASSERT_EQ(expected, ciphertext);
+
+        // Decrypt in place
+        parallel.DecryptBlocks(key_schedule, ciphertext, ciphertext);
+        STF_ASSERT_EQ(data, ciphertext);
+    }
+}
+
+// Compare CTR mode against the AESCTR object
+STF_TEST(AESParallel, TestCTR)
+{
+    const AESParallel parallel(4, 256);
+    const AESKeySchedule key_schedule({aes_key, 32}, AESKeyUsage::EncryptOnly);
+
+    // The low 64 bits of the counter overflow within the buffer
+    const std::array<std::uint8_t, 16> counter =
+    {
+        0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80
+    };
+
+    for (std::size_t length : {1, 16, 255, 256, 257, 4099, 20000})
+    {
+        std::vector<std::uint8_t> data = MakeData(length);
+        std::vector<std::uint8_t> expected(length);
+        std::vector<std::uint8_t> ciphertext(length);
+
+        AESCTR aes_ctr({aes_key, 32}, counter);
+        aes_ctr.Encrypt(data, expected);
+
+        parallel.EncryptCTR(key_schedule, counter, data, ciphertext);
+        STF_ASSERT_EQ(expected, ciphertext);
+
+        // Decrypt in place
+        parallel.DecryptCTR(key_schedule, counter, ciphertext, ciphertext);
+        STF_ASSERT_EQ(data, ciphertext);
+    }
+}
+
+// Compare the GCTR function against the ciphertext produced by AESGCM
+STF_TEST(AESParallel, TestGCTR)
+{
+    const AESParallel parallel(4, 256);
+    const AESKeySchedule key_schedule({aes_key, 16}, AESKeyUsage::EncryptOnly);
+    const std::array<std::uint8_t, 12> iv =
+    {
+        0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+        0xde, 0xca, 0xf8, 0x88
+    };
+    std::array<std::uint8_t, 16> counter{};
+    std::array<std::uint8_t, 16> tag;
+
+    // For a 96-bit IV, the first counter block is the IV || 0x00000002
+    std::copy(iv.begin(), iv.end(), counter.begin());
+    counter[15] = 0x02;
+
+    AESGCM aes_gcm({aes_key, 16});
+
+    for (std::size_t length : {1, 60, 256, 1000, 20000})
+    {
+        std::vector<std::uint8_t> data = MakeData(length);
+        std::vector<std::uint8_t> expected(length);
+        std::vector<std::uint8_t> ciphertext(length);
+
+        aes_gcm.Encrypt(iv, {}, data, expected, tag);
+
+        parallel.EncryptGCTR(key_schedule, counter, data, ciphertext);
+        STF_ASSERT_EQ(expected, ciphertext);
+
+        parallel.DecryptGCTR(key_schedule, counter, ciphertext, ciphertext);
+        STF_ASSERT_EQ(data, ciphertext);
+    }
+}
+
+// Ensure only the rightmost 32 bits of the GCTR counter are incremented
+STF_TEST(AESParallel, TestGCTRWrap)
+{
+    const AESParallel parallel(4, 64);
+    const AESKeySchedule key_schedule({aes_key, 16}, AESKeyUsage::EncryptOnly);
+    std::array<std::uint8_t, 16> counter =
+    {
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        0x09, 0x0a, 0x0b, 0xff, 0xff, 0xff, 0xff, 0xfa
+    };
+    std::vector<std::uint8_t> data = MakeData(16 * 20);
+    std::vector<std::uint8_t> expected(data.size());
+    std::vector<std::uint8_t> ciphertext(data.size());
+    std::array<std::uint8_t, 16> block;
+
+    parallel.EncryptGCTR(key_schedule, counter, data, ciphertext);
+
+    // Compute the expected result one block at a time
+    for (std::size_t i = 0; i < data.size(); i += 16)
+    {
+        key_schedule.Encrypt(counter, block);
+
+        for (std::size_t j = 0; j < 16; j++)
+        {
+            expected[i + j] = data[i + j] ^ block[j];
+        }
+
+        for (std::size_t j = 16; j > 12; j--)
+        {
+            if (++counter[j - 1] != 0) break;
+        }
+    }
+
+    STF_ASSERT_EQ(expected, ciphertext);
+}
+
+// Compare CBC decryption against the AESCBC object
+STF_TEST(AESParallel, TestCBC)
+{
+    const AESParallel parallel(4, 256);
+    const AESKeySchedule key_schedule({aes_key, 24});
+    const std::array<std::uint8_t, 16> iv =
+    {
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+        0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
+    };
+
+    AESCBC aes_cbc({aes_key, 24});
+
+    for (std::size_t blocks : {1, 15, 16, 17, 33, 1000})
+    {
+        std::vector<std::uint8_t> data = MakeData(blocks * 16);
+        std::vector<std::uint8_t> ciphertext(data.size());
+        std::vector<std::uint8_t> plaintext(data.size());
+
+        aes_cbc.Encrypt(iv, data, ciphertext);
+
+        parallel.DecryptCBC(key_schedule, iv, ciphertext, plaintext);
+        STF_ASSERT_EQ(data, plaintext);
+
+        // Decrypt in place, where chunks overwrite the preceding ciphertext
+        parallel.DecryptCBC(key_schedule, iv, ciphertext, ciphertext);
+        STF_ASSERT_EQ(data, ciphertext);
+    }
+}
+
+// Compare XTS-AES against the AESXTS object, including ciphertext stealing
+STF_TEST(AESParallel, TestXTS)
+{
+    const AESParallel parallel(4, 1024);
+
+    for (std::size_t key_length : {32, 64})
+    {
+        const std::span<const std::uint8_t> key(aes_key, key_length);
+        const AESKeySchedule data_key_schedule(key.first(key_length / 2));
+        const AESKeySchedule tweak_key_schedule(key.subspan(key_length / 2),
+                                                AESKeyUsage::EncryptOnly);
+
+        AESXTS aes_xts(key);
+
+        for (std::size_t sector_size : {16, 17, 512, 520, 4096})
+        {
+            constexpr std::uint64_t First_Sector = 0xfffffffffffffff0;
+            constexpr std::size_t Sectors = 23;
+            std::vector<std::uint8_t> data = MakeData(sector_size * Sectors);
+            std::vector<std::uint8_t> expected(data.size());
+            std::vector<std::uint8_t> ciphertext(data.size());
+
+            for (std::size_t i = 0; i < Sectors; i++)
+            {
+                aes_xts.Encrypt(
+                    First_Sector + i,
+                    std::span(data).subspan(i * sector_size, sector_size),
+                    std::span(expected).subspan(i * sector_size, sector_size));
+            }
+
+            parallel.EncryptXTS(data_key_schedule,
+                                tweak_key_schedule,
+                                First_Sector,
+                                sector_size,
+                                data,
+                                ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+
+            // Decrypt in place
+            parallel.DecryptXTS(data_key_schedule,
+                                tweak_key_schedule,
+                                First_Sector,
+                                sector_size,
+                                ciphertext,
+                                ciphertext);
+            STF_ASSERT_EQ(data, ciphertext);
+        }
+    }
+}
+
+// Ensure tasks are run by a caller-supplied executor
+STF_TEST(AESParallel, TestExecutor)
+{
+    std::atomic<std::size_t> calls{};
+    std::size_t tasks_run{};
+
+    // Run the tasks serially in reverse order to show order does not matter
+    const AESParallel parallel(
+        [&](std::size_t tasks, const std::function<void(std::size_t)> &task)
+        {
+            calls++;
+            for (std::size_t i = tasks; i > 0; i--, tasks_run++) task(i - 1);
+        },
+        128);
+    const AESKeySchedule key_schedule({aes_key, 16});
+    const std::array<std::uint8_t, 16> counter{};
+    std::vector<std::uint8_t> data = MakeData(1000);
+    std::vector<std::uint8_t> expected(data.size());
+    std::vector<std::uint8_t> ciphertext(data.size());
+
+    AESCTR aes_ctr({aes_key, 16}, counter);
+    aes_ctr.Encrypt(data, expected);
+
+    parallel.EncryptCTR(key_schedule, counter, data, ciphertext);
+
+    STF_ASSERT_EQ(expected, ciphertext);
+    STF_ASSERT_EQ(std::size_t(1), calls.load());
+    STF_ASSERT_EQ(std::size_t(8), tasks_run);
+}
+
+// Ensure invalid parameters are rejected
+STF_TEST(AESParallel, TestInvalidParameters)
+{
+    const AESParallel parallel(2, 256);
+    const AESKeySchedule key_schedule({aes_key, 16});
+    const AESKeySchedule encrypt_only({aes_key, 16}, AESKeyUsage::EncryptOnly);
+    const std::array<std::uint8_t, 16> iv{};
+    std::vector<std::uint8_t> data(100);
+    std::vector<std::uint8_t> blocks(96);
+    std::size_t exceptions{};
+
+    // The chunk size must be at least one block
+    try
+    {
+        const AESParallel invalid(2, 15);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    // An executor must be provided
+    try
+    {
+        const AESParallel invalid(AESTaskExecutor{});
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    // ECB requires whole blocks
+    try
+    {
+        parallel.EncryptBlocks(key_schedule, data, data);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    // The buffer must hold whole sectors
+    try
+    {
+        parallel.EncryptXTS(key_schedule, key_schedule, 0, 16, data, data);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    // Decryption requires the decryption key schedule
+    try
+    {
+        parallel.DecryptBlocks(encrypt_only, blocks, blocks);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    try
+    {
+        parallel.DecryptCBC(encrypt_only, iv, blocks, blocks);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    try
+    {
+        parallel.DecryptXTS(encrypt_only, key_schedule, 0, 16, blocks, blocks);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    STF_ASSERT_EQ(std::size_t(7), exceptions);
+}
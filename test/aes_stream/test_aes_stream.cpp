@@ -0,0 +1,520 @@
+/*
+ *  test_aes_stream.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the AESStream logic for streams, files,
+ *      and files processed in place, comparing the results against the
+ *      AESCTR, AESGCM, and AESXTS objects.  Data lengths span several chunks
+ *      and end with a partial chunk.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <span>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <terra/crypto/cipher/aes_stream.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Smallest chunk size, so that tests span several chunks
+constexpr std::size_t Chunk_Size{AESStream::Chunk_Alignment};
+
+// Length of the test data: three chunks and a partial chunk
+constexpr std::size_t Data_Length{3 * Chunk_Size + 1000};
+
+const std::array<std::uint8_t, 32> aes_key =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+const std::array<std::uint8_t, 16> counter =
+{
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+    0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+
+const std::array<std::uint8_t, 12> gcm_iv =
+{
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+    0xde, 0xca, 0xf8, 0x88
+};
+
+const std::array<std::uint8_t, 5> gcm_aad =
+{
+    0x01, 0x02, 0x03, 0x04, 0x05
+};
+
+// Return test data of the given length
+std::vector<std::uint8_t> TestData(std::size_t length)
+{
+    std::vector<std::uint8_t> data(length);
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        data[i] = static_cast<std::uint8_t>((i * 7) ^ (i >> 8));
+    }
+
+    return data;
+}
+
+// Convert between octets and strings for use with string streams
+std::string ToString(const std::vector<std::uint8_t> &data)
+{
+    return std::string(data.begin(), data.end());
+}
+
+std::vector<std::uint8_t> ToOctets(const std::string &data)
+{
+    return std::vector<std::uint8_t>(data.begin(), data.end());
+}
+
+// Write and read the contents of a file
+void WriteFile(const std::filesystem::path &path,
+               const std::vector<std::uint8_t> &data)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    file.write(reinterpret_cast<const char *>(data.data()),
+               static_cast<std::streamsize>(data.size()));
+}
+
+std::vector<std::uint8_t> ReadFile(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file),
+                                     std::istreambuf_iterator<char>());
+}
+
+// Return a path for a temporary file used by this test
+std::filesystem::path TempFile(const std::string &name)
+{
+    return std::filesystem::temp_directory_path() /
+           ("test_aes_stream_" + name);
+}
+
+} // namespace
+
+// CTR streams must match AESCTR
+STF_TEST(AESStream, CTRStream)
+{
+    const std::vector<std::uint8_t> plaintext = TestData(Data_Length);
+    std::vector<std::uint8_t> expected(Data_Length);
+
+    AESCTR aes_ctr(aes_key, counter);
+    aes_ctr.Encrypt(plaintext, expected);
+
+    AESStream aes_stream(AESStreamMode::CTR, aes_key, Chunk_Size);
+    aes_stream.SetIV(counter);
+
+    std::istringstream input(ToString(plaintext));
+    std::ostringstream output;
+    aes_stream.Encrypt(input, output);
+
+    STF_ASSERT_EQ(expected, ToOctets(output.str()));
+    STF_ASSERT_EQ(std::uint64_t(Data_Length),
+                  aes_stream.GetStatistics().octets);
+    STF_ASSERT_EQ(std::uint64_t(4), aes_stream.GetStatistics().chunks);
+
+    // Encryption consumes the counter, so it is set again to decrypt
+    aes_stream.SetIV(counter);
+
+    std::istringstream ciphertext(output.str());
+    std::ostringstream decrypted;
+    STF_ASSERT_TRUE(aes_stream.Decrypt(ciphertext, decrypted));
+
+    STF_ASSERT_EQ(plaintext, ToOctets(decrypted.str()));
+}
+
+// GCM streams must match AESGCM and fail with a modified tag
+STF_TEST(AESStream, GCMStream)
+{
+    const std::vector<std::uint8_t> plaintext = TestData(Data_Length);
+    std::vector<std::uint8_t> expected(Data_Length);
+    std::array<std::uint8_t, 16> expected_tag{};
+    std::array<std::uint8_t, 16> tag{};
+
+    AESGCM aes_gcm(aes_key);
+    aes_gcm.Encrypt(gcm_iv, gcm_aad, plaintext, expected, expected_tag);
+
+    AESStream aes_stream(AESStreamMode::GCM, aes_key, Chunk_Size);
+    aes_stream.SetIV(gcm_iv);
+    aes_stream.SetAAD(gcm_aad);
+
+    std::istringstream input(ToString(plaintext));
+    std::ostringstream output;
+    aes_stream.Encrypt(input, output, tag);
+
+    STF_ASSERT_EQ(expected, ToOctets(output.str()));
+    STF_ASSERT_EQ(expected_tag, tag);
+
+    aes_stream.SetIV(gcm_iv);
+
+    std::istringstream ciphertext(output.str());
+    std::ostringstream decrypted;
+    STF_ASSERT_TRUE(aes_stream.Decrypt(ciphertext, decrypted, tag));
+
+    STF_ASSERT_EQ(plaintext, ToOctets(decrypted.str()));
+
+    tag[0] ^= 0x01;
+
+    std::istringstream modified(output.str());
+    std::ostringstream rejected;
+    STF_ASSERT_FALSE(aes_stream.Decrypt(modified, rejected, tag));
+}
+
+// XTS streams must match AESXTS applied to each data unit
+STF_TEST(AESStream, XTSStream)
+{
+    const std::vector<std::uint8_t> plaintext = TestData(Data_Length);
+    std::vector<std::uint8_t> expected(Data_Length);
+    constexpr std::size_t Unit_Length{512};
+    constexpr std::uint64_t First_Unit{1000};
+
+    AESXTS aes_xts(aes_key);
+    for (std::size_t offset = 0; offset < Data_Length; offset += Unit_Length)
+    {
+        const std::size_t length =
+            std::min(Unit_Length, Data_Length - offset);
+
+        aes_xts.Encrypt(First_Unit + offset / Unit_Length,
+                        std::span(plaintext).subspan(offset, length),
+                        std::span(expected).subspan(offset, length));
+    }
+
+    AESStream aes_stream(AESStreamMode::XTS, aes_key, Chunk_Size);
+    aes_stream.SetDataUnit(First_Unit, Unit_Length);
+
+    std::istringstream input(ToString(plaintext));
+    std::ostringstream output;
+    aes_stream.Encrypt(input, output);
+
+    STF_ASSERT_EQ(expected, ToOctets(output.str()));
+
+    std::istringstream ciphertext(output.str());
+    std::ostringstream decrypted;
+    STF_ASSERT_TRUE(aes_stream.Decrypt(ciphertext, decrypted));
+
+    STF_ASSERT_EQ(plaintext, ToOctets(decrypted.str()));
+}
+
+// Files must produce the same result as streams
+STF_TEST(AESStream, Files)
+{
+    const std::vector<std::uint8_t> plaintext = TestData(Data_Length);
+    const std::filesystem::path plaintext_file = TempFile("plaintext");
+    const std::filesystem::path ciphertext_file = TempFile("ciphertext");
+    const std::filesystem::path decrypted_file = TempFile("decrypted");
+    std::array<std::uint8_t, 16> stream_tag{};
+    std::array<std::uint8_t, 16> tag{};
+
+    WriteFile(plaintext_file, plaintext);
+
+    AESStream aes_stream(AESStreamMode::GCM, aes_key, Chunk_Size);
+    aes_stream.SetIV(gcm_iv);
+    aes_stream.SetAAD(gcm_aad);
+
+    std::istringstream input(ToString(plaintext));
+    std::ostringstream output;
+    aes_stream.Encrypt(input, output, stream_tag);
+
+    aes_stream.SetIV(gcm_iv);
+    aes_stream.EncryptFile(plaintext_file, ciphertext_file, tag);
+
+    STF_ASSERT_EQ(ToOctets(output.str()), ReadFile(ciphertext_file));
+    STF_ASSERT_EQ(stream_tag, tag);
+    STF_ASSERT_EQ(std::uint64_t(Data_Length),
+                  aes_stream.GetStatistics().octets);
+    STF_ASSERT_EQ(std::uint64_t(4), aes_stream.GetStatistics().chunks);
+
+    aes_stream.SetIV(gcm_iv);
+    STF_ASSERT_TRUE(
+        aes_stream.DecryptFile(ciphertext_file, decrypted_file, tag));
+    STF_ASSERT_EQ(plaintext, ReadFile(decrypted_file));
+
+    // The output is truncated if the tag is not valid
+    tag[15] ^= 0x01;
+    STF_ASSERT_FALSE(
+        aes_stream.DecryptFile(ciphertext_file, decrypted_file, tag));
+    STF_ASSERT_EQ(std::uintmax_t(0),
+                  std::filesystem::file_size(decrypted_file));
+
+    std::filesystem::remove(plaintext_file);
+    std::filesystem::remove(ciphertext_file);
+    std::filesystem::remove(decrypted_file);
+}
+
+// Files processed in place must produce the same result as streams
+STF_TEST(AESStream, FilesInPlace)
+{
+    const std::vector<std::uint8_t> plaintext = TestData(Data_Length);
+    const std::filesystem::path data_file = TempFile("in_place");
+    std::array<std::uint8_t, 16> stream_tag{};
+    std::array<std::uint8_t, 16> tag{};
+
+    WriteFile(data_file, plaintext);
+
+    AESStream aes_stream(AESStreamMode::GCM, aes_key, Chunk_Size);
+    aes_stream.SetIV(gcm_iv);
+
+    std::istringstream input(ToString(plaintext));
+    std::ostringstream output;
+    aes_stream.Encrypt(input, output, stream_tag);
+
+    aes_stream.SetIV(gcm_iv);
+    aes_stream.EncryptFileInPlace(data_file, tag);
+
+    const std::vector<std::uint8_t> ciphertext = ReadFile(data_file);
+    STF_ASSERT_EQ(ToOctets(output.str()), ciphertext);
+    STF_ASSERT_EQ(stream_tag, tag);
+
+    aes_stream.SetIV(gcm_iv);
+
+    // The file is unchanged if the tag is not valid
+    tag[0] ^= 0x01;
+    STF_ASSERT_FALSE(aes_stream.DecryptFileInPlace(data_file, tag));
+    STF_ASSERT_EQ(ciphertext, ReadFile(data_file));
+    tag[0] ^= 0x01;
+
+    STF_ASSERT_TRUE(aes_stream.DecryptFileInPlace(data_file, tag));
+    STF_ASSERT_EQ(plaintext, ReadFile(data_file));
+
+    // XTS in place
+    AESStream aes_xts(AESStreamMode::XTS, aes_key, Chunk_Size);
+
+    aes_xts.EncryptFileInPlace(data_file);
+    STF_ASSERT_TRUE(plaintext != ReadFile(data_file));
+    STF_ASSERT_TRUE(aes_xts.DecryptFileInPlace(data_file));
+    STF_ASSERT_EQ(plaintext, ReadFile(data_file));
+
+    std::filesystem::remove(data_file);
+}
+
+// Naming the same file as the input and output, directly or via a link, is
+// rejected without modifying the file
+STF_TEST(AESStream, SameFile)
+{
+    const std::vector<std::uint8_t> plaintext = TestData(Data_Length);
+    const std::filesystem::path data_file = TempFile("same");
+    const std::filesystem::path link_file = TempFile("same_link");
+    std::array<std::uint8_t, 16> tag{};
+
+    WriteFile(data_file, plaintext);
+    std::filesystem::remove(link_file);
+    std::filesystem::create_hard_link(data_file, link_file);
+
+    AESStream aes_stream(AESStreamMode::GCM, aes_key, Chunk_Size);
+    aes_stream.SetIV(gcm_iv);
+
+    STF_ASSERT_EXCEPTION_E(aes_stream.EncryptFile(data_file, data_file, tag),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(aes_stream.EncryptFile(data_file, link_file, tag),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(aes_stream.DecryptFile(link_file, data_file, tag),
+                           AESException);
+
+    STF_ASSERT_EQ(plaintext, ReadFile(data_file));
+
+    std::filesystem::remove(link_file);
+    std::filesystem::remove(data_file);
+}
+
+// A final XTS data unit shorter than 16 octets is rejected before any of the
+// file is processed
+STF_TEST(AESStream, ShortFinalDataUnit)
+{
+    const std::vector<std::uint8_t> plaintext = TestData(3 * Chunk_Size + 1);
+    const std::vector<std::uint8_t> existing = TestData(100);
+    const std::filesystem::path data_file = TempFile("short_unit");
+    const std::filesystem::path output_file = TempFile("short_unit_output");
+
+    WriteFile(data_file, plaintext);
+    WriteFile(output_file, existing);
+
+    AESStream aes_stream(AESStreamMode::XTS, aes_key, Chunk_Size);
+    aes_stream.SetDataUnit(0, 512);
+
+    STF_ASSERT_EXCEPTION_E(aes_stream.EncryptFileInPlace(data_file),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(aes_stream.EncryptFile(data_file, output_file),
+                           AESException);
+
+    STF_ASSERT_EQ(plaintext, ReadFile(data_file));
+    STF_ASSERT_EQ(existing, ReadFile(output_file));
+
+    std::filesystem::remove(data_file);
+    std::filesystem::remove(output_file);
+}
+
+// Empty input produces empty output and, for GCM, the tag of no text
+STF_TEST(AESStream, EmptyInput)
+{
+    const std::filesystem::path empty_file = TempFile("empty");
+    const std::filesystem::path output_file = TempFile("empty_output");
+    const std::vector<std::uint8_t> empty;
+    std::array<std::uint8_t, 16> expected_tag{};
+    std::array<std::uint8_t, 16> tag{};
+
+    WriteFile(empty_file, {});
+
+    AESGCM aes_gcm(aes_key);
+    aes_gcm.Encrypt(gcm_iv, gcm_aad, empty, {}, expected_tag);
+
+    AESStream aes_stream(AESStreamMode::GCM, aes_key, Chunk_Size);
+    aes_stream.SetIV(gcm_iv);
+    aes_stream.SetAAD(gcm_aad);
+
+    std::istringstream input;
+    std::ostringstream output;
+    aes_stream.Encrypt(input, output, tag);
+
+    STF_ASSERT_TRUE(output.str().empty());
+    STF_ASSERT_EQ(expected_tag, tag);
+
+    aes_stream.SetIV(gcm_iv);
+    aes_stream.EncryptFile(empty_file, output_file, tag);
+
+    STF_ASSERT_EQ(std::uintmax_t(0), std::filesystem::file_size(output_file));
+    STF_ASSERT_EQ(expected_tag, tag);
+    STF_ASSERT_EQ(std::uint64_t(0), aes_stream.GetStatistics().octets);
+
+    std::filesystem::remove(empty_file);
+    std::filesystem::remove(output_file);
+}
+
+// Each encryption consumes the IV, so another requires a new call to SetIV()
+STF_TEST(AESStream, IVRequiredPerEncryption)
+{
+    const std::vector<std::uint8_t> plaintext = TestData(Data_Length);
+    const std::filesystem::path data_file = TempFile("iv_required");
+    std::array<std::uint8_t, 16> tag{};
+
+    WriteFile(data_file, plaintext);
+
+    AESStream aes_ctr(AESStreamMode::CTR, aes_key, Chunk_Size);
+    AESStream aes_gcm(AESStreamMode::GCM, aes_key, Chunk_Size);
+    aes_ctr.SetIV(counter);
+    aes_gcm.SetIV(gcm_iv);
+
+    std::istringstream ctr_input(ToString(plaintext));
+    std::ostringstream ctr_output;
+    aes_ctr.Encrypt(ctr_input, ctr_output);
+
+    std::istringstream gcm_input(ToString(plaintext));
+    std::ostringstream gcm_output;
+    aes_gcm.Encrypt(gcm_input, gcm_output, tag);
+
+    std::istringstream input(ToString(plaintext));
+    std::ostringstream output;
+    STF_ASSERT_EXCEPTION_E(aes_ctr.Encrypt(input, output), AESException);
+    STF_ASSERT_EXCEPTION_E(aes_gcm.Encrypt(input, output, tag),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(aes_ctr.EncryptFileInPlace(data_file),
+                           AESException);
+    STF_ASSERT_EXCEPTION_E(aes_gcm.EncryptFileInPlace(data_file, tag),
+                           AESException);
+    STF_ASSERT_EQ(plaintext, ReadFile(data_file));
+
+    // A new IV permits the next encryption
+    aes_gcm.SetIV(gcm_iv);
+    aes_gcm.EncryptFileInPlace(data_file, tag);
+    STF_ASSERT_EQ(ToOctets(gcm_output.str()), ReadFile(data_file));
+
+    std::filesystem::remove(data_file);
+}
+
+// Ensure invalid parameters are rejected
+STF_TEST(AESStream, InvalidParameters)
+{
+    std::array<std::uint8_t, 16> tag{};
+    std::array<std::uint8_t, 10> invalid_tag{};
+    std::size_t exceptions{};
+
+    auto expect_exception = [&](auto function)
+    {
+        try
+        {
+            function();
+        }
+        catch (const AESException &)
+        {
+            exceptions++;
+        }
+    };
+
+    // Chunk size that is not a multiple of the alignment
+    expect_exception([]() { AESStream(AESStreamMode::CTR, Chunk_Size + 16); });
+
+    AESStream aes_ctr(AESStreamMode::CTR, aes_key, Chunk_Size);
+    AESStream aes_gcm(AESStreamMode::GCM, aes_key, Chunk_Size);
+    AESStream aes_xts(AESStreamMode::XTS, aes_key, Chunk_Size);
+
+    // Counter of the wrong length, AAD or data units for the wrong mode
+    expect_exception([&]() { aes_ctr.SetIV(gcm_iv); });
+    expect_exception([&]() { aes_ctr.SetAAD(gcm_aad); });
+    expect_exception([&]() { aes_ctr.SetDataUnit(0); });
+    expect_exception([&]() { aes_xts.SetIV(counter); });
+
+    // Data unit lengths that are not valid
+    expect_exception([&]() { aes_xts.SetDataUnit(0, 100); });
+    expect_exception([&]() { aes_xts.SetDataUnit(0, 3 * 4096); });
+
+    // The counter has not been set
+    expect_exception(
+        [&]()
+        {
+            std::istringstream input;
+            std::ostringstream output;
+            aes_ctr.Encrypt(input, output);
+        });
+
+    // A tag with CTR, or a tag of an invalid length with GCM
+    aes_ctr.SetIV(counter);
+    aes_gcm.SetIV(gcm_iv);
+    expect_exception(
+        [&]()
+        {
+            std::istringstream input;
+            std::ostringstream output;
+            aes_ctr.Encrypt(input, output, tag);
+        });
+    expect_exception(
+        [&]()
+        {
+            std::istringstream input;
+            std::ostringstream output;
+            aes_gcm.Encrypt(input, output, invalid_tag);
+        });
+
+    // A file that does not exist
+    expect_exception(
+        [&]()
+        {
+            aes_ctr.EncryptFile(TempFile("missing"), TempFile("unused"));
+        });
+
+    STF_ASSERT_EQ(std::size_t(11), exceptions);
+}
@@ -17,11 +17,15 @@
  */
 
 #include <cstdint>
+#include <cstddef>
 #include <ostream>
 #include <iomanip>
 #include <vector>
+#include <iterator>
+#include <span>
 #include <array>
 #include <aes_universal.h>
+#include <aes_tables.h>
 #include <terra/stf/adapters/integral_vector.h>
 #include <terra/stf/stf.h>
 
@@ -777,6 +781,211 @@ STF_TEST(AESUniversal, TestDecryptVectorAPI)
     STF_ASSERT_EQ(expected_plaintext, plaintext);
 }
 
+// Test that the batch functions agree with the single-block functions
+STF_TEST(AESUniversal, TestEncryptDecryptBlocks)
+{
+    const std::uint8_t aes_key[32] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+
+    // Exercise each key length and enough blocks to use each code path
+    for (std::size_t key_length : {16, 24, 32})
+    {
+        for (std::size_t blocks = 1; blocks <= 21; blocks++)
+        {
+            std::vector<std::uint8_t> plaintext(blocks * 16);
+            std::vector<std::uint8_t> expected(blocks * 16);
+            std::vector<std::uint8_t> ciphertext(blocks * 16);
+
+            for (std::size_t i = 0; i < plaintext.size(); i++)
+            {
+                plaintext[i] = static_cast<std::uint8_t>(i * 7 + blocks);
+            }
+
+            AESUniversal aes({aes_key, key_length});
+
+            // Produce the expected result one block at a time
+            for (std::size_t i = 0; i < blocks; i++)
+            {
+                aes.Encrypt(
+                    std::span<const std::uint8_t, 16>(plaintext.data() + i * 16,
+                                                      16),
+                    std::span<std::uint8_t, 16>(expected.data() + i * 16, 16));
+            }
+
+            aes.EncryptBlocks(plaintext, ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+
+            // Decrypt in place
+            aes.DecryptBlocks(ciphertext, ciphertext);
+            STF_ASSERT_EQ(plaintext, ciphertext);
+        }
+    }
+}
+
+// Test that an encrypt-only key produces the same ciphertext
+STF_TEST(AESUniversal, TestEncryptOnly)
+{
+    const std::uint8_t aes_key[32] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+
+    for (std::size_t key_length : {16, 24, 32})
+    {
+        AESUniversal aes_full({aes_key, key_length});
+        AESUniversal aes_encrypt_only;
+
+        aes_encrypt_only.SetKey({aes_key, key_length},
+                                AESKeyUsage::EncryptOnly);
+
+        // The decryption key schedule was not computed
+        STF_ASSERT_TRUE(aes_full != aes_encrypt_only);
+
+        for (std::size_t blocks = 1; blocks <= 21; blocks++)
+        {
+            std::vector<std::uint8_t> data(blocks * 16);
+            std::vector<std::uint8_t> expected(blocks * 16);
+            std::vector<std::uint8_t> ciphertext(blocks * 16);
+
+            for (std::size_t i = 0; i < data.size(); i++)
+            {
+                data[i] = static_cast<std::uint8_t>(i * 7 + blocks);
+            }
+
+            aes_full.EncryptBlocks(data, expected);
+
+            aes_encrypt_only.EncryptBlocks(data, ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+        }
+
+        // Setting the key for both directions restores decryption
+        aes_encrypt_only.SetKey({aes_key, key_length});
+
+        STF_ASSERT_TRUE(aes_full == aes_encrypt_only);
+    }
+}
+
+// Test that keys set together match keys set individually
+STF_TEST(AESUniversal, TestSetKeys)
+{
+    const std::size_t key_lengths[] =
+    {
+        16, 16, 16, 16, 16, 24, 24, 24, 24, 32, 32, 32, 32, 32,
+        16, 24, 16, 16, 32, 32, 16, 16, 16
+    };
+    constexpr std::size_t Keys = std::size(key_lengths);
+
+    for (AESKeyUsage key_usage : {AESKeyUsage::EncryptDecrypt,
+                                  AESKeyUsage::EncryptOnly})
+    {
+        std::vector<std::vector<std::uint8_t>> keys;
+        std::vector<std::span<const std::uint8_t>> key_spans;
+        std::vector<AESUniversal> expected(Keys);
+        std::vector<AESUniversal> actual(Keys);
+        std::vector<AESUniversal *> engines;
+
+        for (std::size_t i = 0; i < Keys; i++)
+        {
+            std::vector<std::uint8_t> key(key_lengths[i]);
+
+            for (std::size_t j = 0; j < key.size(); j++)
+            {
+                key[j] = static_cast<std::uint8_t>(i * 13 + j);
+            }
+
+            keys.push_back(key);
+        }
+
+        for (std::size_t i = 0; i < Keys; i++)
+        {
+            key_spans.emplace_back(keys[i]);
+            expected[i].SetKey(keys[i], key_usage);
+
+            // Give each engine a prior key that must be replaced
+            actual[i].SetKey(keys[Keys - 1 - i]);
+            engines.push_back(&actual[i]);
+        }
+
+        AESUniversal::SetKeys(engines, key_spans, key_usage);
+
+        for (std::size_t i = 0; i < Keys; i++)
+        {
+            STF_ASSERT_TRUE(expected[i] == actual[i]);
+        }
+    }
+}
+
+// Test that invalid arguments to SetKeys() leave the engines unchanged
+STF_TEST(AESUniversal, TestSetKeysInvalid)
+{
+    const std::uint8_t aes_key[32]{};
+    const std::span<const std::uint8_t> keys[4] =
+    {
+        {aes_key, 16}, {aes_key, 16}, {aes_key, 16}, {aes_key, 17}
+    };
+    std::vector<AESUniversal> actual(4);
+    std::vector<AESUniversal *> engines;
+
+    for (AESUniversal &engine : actual) engines.push_back(&engine);
+
+    STF_ASSERT_EXCEPTION_E(AESUniversal::SetKeys(engines, keys), AESException);
+    STF_ASSERT_EXCEPTION_E(
+        AESUniversal::SetKeys(std::span(engines).first(3),
+                       std::span(keys).first(2)),
+        AESException);
+
+    for (const AESUniversal &engine : actual)
+    {
+        STF_ASSERT_TRUE(engine == AESUniversal());
+    }
+}
+
+// Test that the tables are aligned and that each entry of Enc0 and Dec0 holds
+// the column produced by MixColumns() and InvMixColumns(), so that the
+// remaining tables are rotations of these when built with compact tables
+STF_TEST(AESUniversal, TestTableLayout)
+{
+    // Multiply by x in GF(2^8) as defined in Section 4.2.1 of FIPS 197
+    auto xtime = [](std::uint32_t value) -> std::uint32_t
+    {
+        return ((value << 1) ^ ((value & 0x80) ? 0x1b : 0x00)) & 0xff;
+    };
+
+    STF_ASSERT_EQ(reinterpret_cast<std::uintptr_t>(Sbox.data()) % 64, 0);
+    STF_ASSERT_EQ(reinterpret_cast<std::uintptr_t>(InverseSbox.data()) % 64,
+                  0);
+    STF_ASSERT_EQ(reinterpret_cast<std::uintptr_t>(Enc0.data()) % 64, 0);
+    STF_ASSERT_EQ(reinterpret_cast<std::uintptr_t>(Dec0.data()) % 64, 0);
+
+    for (std::size_t i = 0; i < 256; i++)
+    {
+        std::uint32_t s = Sbox[i];
+        std::uint32_t s2 = xtime(s);
+        std::uint32_t s3 = s2 ^ s;
+
+        STF_ASSERT_EQ(Enc0[i], (s2 << 24) | (s << 16) | (s << 8) | s3);
+
+        std::uint32_t v = InverseSbox[i];
+        std::uint32_t v2 = xtime(v);
+        std::uint32_t v4 = xtime(v2);
+        std::uint32_t v8 = xtime(v4);
+        std::uint32_t v9 = v8 ^ v;
+        std::uint32_t v11 = v8 ^ v2 ^ v;
+        std::uint32_t v13 = v8 ^ v4 ^ v;
+        std::uint32_t v14 = v8 ^ v4 ^ v2;
+
+        STF_ASSERT_EQ(Dec0[i], (v14 << 24) | (v9 << 16) | (v13 << 8) | v11);
+    }
+}
+
 // This function tests the performance of the encryption code
 STF_TEST(AESUniversal, EncryptionSpeedTest128)
 {
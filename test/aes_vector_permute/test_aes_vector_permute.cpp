@@ -0,0 +1,321 @@
+/*
+ *  test_aes_vector_permute.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the core AES encryption and decryption
+ *      routines in the AESVectorPermute module, comparing multi-block
+ *      results against the AESUniversal module.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+#include <intel_intrinsics.h>
+#include <arm_intrinsics.h>
+#include <aes_vector_permute.h>
+#include <aes_universal.h>
+#include <terra/crypto/cipher/aes.h>
+#include <terra/stf/adapters/integral_vector.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+#if defined(TERRA_USE_INTEL_INTRINSICS) || defined(TERRA_USE_ARM_INTRINSICS)
+
+namespace
+{
+
+const std::uint8_t aes_key[32] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+const std::uint8_t plaintext[16] =
+{
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+
+bool VectorPermuteSupported()
+{
+    AESVectorPermute aes;
+
+    if (aes.GetEngineType() == AESEngineType::Unavailable)
+    {
+        std::cerr << "Vector permute instructions are not supported on this "
+                     "processor"
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+// Test the function that indicated the engine type
+STF_TEST(AESVectorPermute, EngineCheck)
+{
+    AESVectorPermute aes;
+
+#ifdef TERRA_USE_INTEL_INTRINSICS
+    if (!CPUSupportsSSSE3())
+    {
+        std::cerr << "SSSE3 is not supported on this processor" << std::endl;
+        STF_ASSERT_EQ(aes.GetEngineType(), AESEngineType::Unavailable);
+        return;
+    }
+#endif
+
+    STF_ASSERT_EQ(aes.GetEngineType(), AESEngineType::VectorPermute);
+}
+
+// Test from Appendix C.1
+STF_TEST(AESVectorPermute, TestVectorC1128)
+{
+    if (!VectorPermuteSupported()) return;
+
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+        0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+    };
+
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    AESVectorPermute aes({aes_key, 16});
+
+    aes.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+
+    aes.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test from Appendix C.2
+STF_TEST(AESVectorPermute, TestVectorC2192)
+{
+    if (!VectorPermuteSupported()) return;
+
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0,
+        0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91
+    };
+
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    AESVectorPermute aes({aes_key, 24});
+
+    aes.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+
+    aes.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Test from Appendix C.3
+STF_TEST(AESVectorPermute, TestVectorC3256)
+{
+    if (!VectorPermuteSupported()) return;
+
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+        0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+    };
+
+    std::uint8_t ciphertext[16];
+    std::uint8_t decrypted[16];
+
+    AESVectorPermute aes(aes_key);
+
+    aes.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+
+    aes.Decrypt(ciphertext, decrypted);
+
+    STF_ASSERT_MEM_EQ(plaintext, decrypted, sizeof(plaintext));
+}
+
+// Compare multi-block operations against the AESUniversal engine
+STF_TEST(AESVectorPermute, TestEncryptDecryptBlocks)
+{
+    if (!VectorPermuteSupported()) return;
+
+    // Exercise each key length, varying the key to cover the key schedule
+    for (std::size_t key_length : {16, 24, 32})
+    {
+        for (std::uint8_t k = 0; k < 8; k++)
+        {
+            std::vector<std::uint8_t> key(aes_key, aes_key + key_length);
+
+            for (auto &octet : key) octet = octet * 37 + k * 101;
+
+            AESUniversal aes_universal(key);
+            AESVectorPermute aes_vector_permute(key);
+
+            for (std::size_t blocks = 1; blocks <= 9; blocks++)
+            {
+                std::vector<std::uint8_t> data(blocks * 16);
+                std::vector<std::uint8_t> expected(blocks * 16);
+                std::vector<std::uint8_t> ciphertext(blocks * 16);
+
+                for (std::size_t i = 0; i < data.size(); i++)
+                {
+                    data[i] = static_cast<std::uint8_t>(i * 7 + blocks + k);
+                }
+
+                aes_universal.EncryptBlocks(data, expected);
+
+                aes_vector_permute.EncryptBlocks(data, ciphertext);
+                STF_ASSERT_EQ(expected, ciphertext);
+
+                // Decrypt in place
+                aes_vector_permute.DecryptBlocks(ciphertext, ciphertext);
+                STF_ASSERT_EQ(data, ciphertext);
+            }
+        }
+    }
+}
+
+// Test copy constructor, assignment, and equality
+STF_TEST(AESVectorPermute, TestCopyAndEquality)
+{
+    if (!VectorPermuteSupported()) return;
+
+    AESVectorPermute aes1(aes_key);
+    AESVectorPermute aes2 = aes1;
+    AESVectorPermute aes3({aes_key, 16});
+
+    STF_ASSERT_TRUE(aes1 == aes2);
+    STF_ASSERT_TRUE(aes1 != aes3);
+
+    aes3 = aes1;
+
+    STF_ASSERT_TRUE(aes1 == aes3);
+}
+
+// Test that an invalid key length is rejected
+STF_TEST(AESVectorPermute, TestInvalidKey)
+{
+    if (!VectorPermuteSupported()) return;
+
+    AESVectorPermute aes;
+    bool expected_failure = false;
+
+    try
+    {
+        aes.SetKey({aes_key, 20});
+    }
+    catch (const AESException &)
+    {
+        expected_failure = true;
+    }
+
+    STF_ASSERT_TRUE(expected_failure);
+}
+
+// Test that an encrypt-only key produces the same ciphertext
+STF_TEST(AESVectorPermute, TestEncryptOnly)
+{
+    if (!VectorPermuteSupported()) return;
+
+    for (std::size_t key_length : {16, 24, 32})
+    {
+        AESVectorPermute aes_full({aes_key, key_length});
+        AESVectorPermute aes_encrypt_only;
+
+        aes_encrypt_only.SetKey({aes_key, key_length},
+                                AESKeyUsage::EncryptOnly);
+
+        // The decryption key schedule was not computed
+        STF_ASSERT_TRUE(aes_full != aes_encrypt_only);
+
+        for (std::size_t blocks = 1; blocks <= 21; blocks++)
+        {
+            std::vector<std::uint8_t> data(blocks * 16);
+            std::vector<std::uint8_t> expected(blocks * 16);
+            std::vector<std::uint8_t> ciphertext(blocks * 16);
+
+            for (std::size_t i = 0; i < data.size(); i++)
+            {
+                data[i] = static_cast<std::uint8_t>(i * 7 + blocks);
+            }
+
+            aes_full.EncryptBlocks(data, expected);
+
+            aes_encrypt_only.EncryptBlocks(data, ciphertext);
+            STF_ASSERT_EQ(expected, ciphertext);
+        }
+
+        // Setting the key for both directions restores decryption
+        aes_encrypt_only.SetKey({aes_key, key_length});
+
+        STF_ASSERT_TRUE(aes_full == aes_encrypt_only);
+    }
+}
+
+// Test that the engine may be requested via the AES object
+STF_TEST(AESVectorPermute, TestAESEngineSelection)
+{
+    if (!VectorPermuteSupported()) return;
+
+    const std::uint8_t expected_ciphertext[16] =
+    {
+        0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+        0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+    };
+
+    std::uint8_t ciphertext[16];
+
+    AES aes(aes_key, AESEngineType::VectorPermute);
+    AES aes_copy = aes;
+
+    aes_copy.Encrypt(plaintext, ciphertext);
+
+    STF_ASSERT_MEM_EQ(expected_ciphertext,
+                      ciphertext,
+                      sizeof(expected_ciphertext));
+
+    STF_ASSERT_TRUE(aes == aes_copy);
+}
+
+#else
+
+// If not using Intel or ARM intrinsics, the engine should be unavailable
+STF_TEST(AESVectorPermute, EngineCheck)
+{
+    AESVectorPermute aes;
+
+    STF_ASSERT_EQ(aes.GetEngineType(), AESEngineType::Unavailable);
+}
+
+#endif // TERRA_USE_INTEL_INTRINSICS || TERRA_USE_ARM_INTRINSICS
@@ -0,0 +1,318 @@
+/*
+ *  test_aes_xts.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the XTS-AES mode logic, including
+ *      ciphertext stealing.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <span>
+#include <terra/crypto/cipher/aes_xts.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Key from IEEE Std 1619 test vectors 15 through 19
+constexpr std::array<std::uint8_t, 32> IEEE_1619_Key =
+{
+    0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8,
+    0xf7, 0xf6, 0xf5, 0xf4, 0xf3, 0xf2, 0xf1, 0xf0,
+    0xbf, 0xbe, 0xbd, 0xbc, 0xbb, 0xba, 0xb9, 0xb8,
+    0xb7, 0xb6, 0xb5, 0xb4, 0xb3, 0xb2, 0xb1, 0xb0
+};
+
+// Straightforward block-at-a-time XTS-AES encryption used for comparison
+std::vector<std::uint8_t> ReferenceEncrypt(std::span<const std::uint8_t> key,
+                                           std::uint64_t sector,
+                                           std::span<const std::uint8_t> input)
+{
+    std::vector<std::uint8_t> output(input.size());
+    std::array<std::uint8_t, 16> tweak{};
+    std::array<std::uint8_t, 16> block{};
+    std::size_t full_blocks = input.size() / 16;
+    std::size_t remainder = input.size() % 16;
+
+    AES data_aes(key.first(key.size() / 2));
+    AES tweak_aes(key.subspan(key.size() / 2));
+
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        block[i] = static_cast<std::uint8_t>(sector >> (i * 8));
+    }
+    tweak_aes.Encrypt(block, tweak);
+
+    auto EncryptBlock = [&](const std::uint8_t *in, std::uint8_t *out)
+    {
+        for (std::size_t i = 0; i < 16; i++) block[i] = in[i] ^ tweak[i];
+        data_aes.Encrypt(block, block);
+        for (std::size_t i = 0; i < 16; i++) out[i] = block[i] ^ tweak[i];
+
+        // Multiply the tweak by x
+        std::uint8_t carry = tweak[15] >> 7;
+        for (std::size_t i = 15; i > 0; i--)
+        {
+            tweak[i] = static_cast<std::uint8_t>((tweak[i] << 1) |
+                                                 (tweak[i - 1] >> 7));
+        }
+        tweak[0] = static_cast<std::uint8_t>((tweak[0] << 1) ^
+                                             (carry ? 0x87 : 0x00));
+    };
+
+    for (std::size_t i = 0; i < full_blocks; i++)
+    {
+        EncryptBlock(input.data() + i * 16, output.data() + i * 16);
+    }
+
+    if (remainder > 0)
+    {
+        std::array<std::uint8_t, 16> last{};
+        std::uint8_t *previous = output.data() + (full_blocks - 1) * 16;
+
+        for (std::size_t i = 0; i < 16; i++)
+        {
+            last[i] = (i < remainder) ? input[full_blocks * 16 + i] :
+                                        previous[i];
+        }
+        for (std::size_t i = 0; i < remainder; i++)
+        {
+            output[full_blocks * 16 + i] = previous[i];
+        }
+        EncryptBlock(last.data(), previous);
+    }
+
+    return output;
+}
+
+} // namespace
+
+// IEEE Std 1619 test vector 1
+STF_TEST(AESXTS, IEEE_1619_Vector_1)
+{
+    const std::array<std::uint8_t, 32> key{};
+    const std::array<std::uint8_t, 32> plaintext{};
+    const std::array<std::uint8_t, 32> expected_ciphertext =
+    {
+        0x91, 0x7c, 0xf6, 0x9e, 0xbd, 0x68, 0xb2, 0xec,
+        0x9b, 0x9f, 0xe9, 0xa3, 0xea, 0xdd, 0xa6, 0x92,
+        0xcd, 0x43, 0xd2, 0xf5, 0x95, 0x98, 0xed, 0x85,
+        0x8c, 0x02, 0xc2, 0x65, 0x2f, 0xbf, 0x92, 0x2e
+    };
+    std::array<std::uint8_t, 32> ciphertext{};
+    std::array<std::uint8_t, 32> plaintext_check{};
+
+    AESXTS aes_xts(key);
+
+    aes_xts.Encrypt(0, plaintext, ciphertext);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+
+    aes_xts.Decrypt(0, ciphertext, plaintext_check);
+
+    STF_ASSERT_EQ(plaintext, plaintext_check);
+}
+
+// IEEE Std 1619 test vector 2, using both the sector and tweak interfaces
+STF_TEST(AESXTS, IEEE_1619_Vector_2)
+{
+    const std::array<std::uint8_t, 32> key =
+    {
+        0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+        0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22
+    };
+    const std::array<std::uint8_t, 16> tweak =
+    {
+        0x33, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    std::array<std::uint8_t, 32> plaintext{};
+    const std::array<std::uint8_t, 32> expected_ciphertext =
+    {
+        0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e,
+        0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+        0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4,
+        0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0
+    };
+    std::array<std::uint8_t, 32> ciphertext{};
+
+    plaintext.fill(0x44);
+
+    AESXTS aes_xts;
+
+    aes_xts.SetKey(key);
+
+    aes_xts.Encrypt(0x3333333333, plaintext, ciphertext);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+
+    ciphertext = {};
+    aes_xts.Encrypt(tweak, plaintext, ciphertext);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+
+    // Decrypt in place
+    aes_xts.Decrypt(tweak, ciphertext, ciphertext);
+
+    STF_ASSERT_EQ(plaintext, ciphertext);
+}
+
+// IEEE Std 1619 test vector 15 (ciphertext stealing)
+STF_TEST(AESXTS, IEEE_1619_Vector_15)
+{
+    const std::array<std::uint8_t, 17> plaintext =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10
+    };
+    const std::array<std::uint8_t, 17> expected_ciphertext =
+    {
+        0x6c, 0x16, 0x25, 0xdb, 0x46, 0x71, 0x52, 0x2d,
+        0x3d, 0x75, 0x99, 0x60, 0x1d, 0xe7, 0xca, 0x09,
+        0xed
+    };
+    std::array<std::uint8_t, 17> ciphertext{};
+    std::array<std::uint8_t, 17> plaintext_check{};
+
+    AESXTS aes_xts(IEEE_1619_Key);
+
+    aes_xts.Encrypt(0x123456789a, plaintext, ciphertext);
+
+    STF_ASSERT_EQ(expected_ciphertext, ciphertext);
+
+    aes_xts.Decrypt(0x123456789a, ciphertext, plaintext_check);
+
+    STF_ASSERT_EQ(plaintext, plaintext_check);
+}
+
+// XTS-AES-256 with ciphertext stealing across multiple blocks
+STF_TEST(AESXTS, XTS_AES_256_Stealing)
+{
+    const std::array<std::uint8_t, 64> key =
+    {
+        0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+        0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+        0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+        0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+        0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+        0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+        0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,
+        0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f
+    };
+    const std::array<std::uint8_t, 37> plaintext =
+    {
+        0x05, 0x12, 0x1f, 0x2c, 0x39, 0x46, 0x53, 0x60,
+        0x6d, 0x7a, 0x87, 0x94, 0xa1, 0xae, 0xbb, 0xc8,
+        0xd5, 0xe2, 0xef, 0xfc, 0x09, 0x16, 0x23, 0x30,
+        0x3d, 0x4a, 0x57, 0x64, 0x71, 0x7e, 0x8b, 0x98,
+        0xa5, 0xb2, 0xbf, 0xcc, 0xd9
+    };
+    const std::array<std::uint8_t, 37> expected_ciphertext =
+    {
+        0x6c, 0x6d, 0xf7, 0xd0, 0x6a, 0xaa, 0x2d, 0xc7,
+        0xed, 0xe6, 0x4c, 0x46, 0x91, 0xab, 0x27, 0x4f,
+        0x31, 0xdb, 0xe4, 0xed, 0x7b, 0x55, 0x5e, 0x75,
+        0x51, 0xe0, 0xb4, 0xce, 0x4f, 0xf5, 0x78, 0x40,
+        0xb8, 0x4d, 0x11, 0x5f, 0x2d
+    };
+    std::array<std::uint8_t, 37> buffer = plaintext;
+
+    AESXTS aes_xts(key);
+
+    // Encrypt and decrypt in place
+    aes_xts.Encrypt(0xfedcba9876543210, buffer, buffer);
+
+    STF_ASSERT_EQ(expected_ciphertext, buffer);
+
+    aes_xts.Decrypt(0xfedcba9876543210, buffer, buffer);
+
+    STF_ASSERT_EQ(plaintext, buffer);
+}
+
+// Compare against a block-at-a-time implementation for many lengths
+STF_TEST(AESXTS, CompareReference)
+{
+    std::vector<std::uint8_t> plaintext(300);
+
+    for (std::size_t i = 0; i < plaintext.size(); i++)
+    {
+        plaintext[i] = static_cast<std::uint8_t>(i * 7 + 3);
+    }
+
+    AESXTS aes_xts(IEEE_1619_Key);
+
+    for (std::size_t length = 16; length <= plaintext.size(); length++)
+    {
+        std::span<const std::uint8_t> input(plaintext.data(), length);
+        std::vector<std::uint8_t> ciphertext(length);
+        std::vector<std::uint8_t> plaintext_check(length);
+
+        aes_xts.Encrypt(length, input, ciphertext);
+
+        STF_ASSERT_EQ(ReferenceEncrypt(IEEE_1619_Key, length, input),
+                      ciphertext);
+
+        aes_xts.Decrypt(length, ciphertext, plaintext_check);
+
+        STF_ASSERT_MEM_EQ(input.data(), plaintext_check.data(), length);
+    }
+}
+
+// Ensure invalid key and span lengths are rejected
+STF_TEST(AESXTS, InvalidLength)
+{
+    std::array<std::uint8_t, 48> bad_key{};
+    std::array<std::uint8_t, 15> short_buffer{};
+    std::array<std::uint8_t, 32> buffer{};
+    std::array<std::uint8_t, 31> other_buffer{};
+    std::size_t exceptions{};
+
+    AESXTS aes_xts(IEEE_1619_Key);
+
+    try
+    {
+        aes_xts.SetKey(bad_key);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    try
+    {
+        aes_xts.Encrypt(0, short_buffer, short_buffer);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    try
+    {
+        aes_xts.Decrypt(0, buffer, other_buffer);
+    }
+    catch (const AESException &)
+    {
+        exceptions++;
+    }
+
+    STF_ASSERT_EQ(std::size_t(3), exceptions);
+}
@@ -0,0 +1,150 @@
+/*
+ *  test_ghash.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module will exercise the GHASHUniversal and GHASHIntel engines
+ *      used by the AESGCM object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <iostream>
+#include <intel_intrinsics.h>
+#include <ghash_universal.h>
+#include <ghash_intel.h>
+#include <cpu_check.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra::Crypto::Cipher;
+
+namespace
+{
+
+// Hash subkey from test case 2 of the GCM specification
+constexpr std::array<std::uint8_t, 16> Test_H =
+{
+    0x66, 0xe9, 0x4b, 0xd4, 0xef, 0x8a, 0x2c, 0x3b,
+    0x88, 0x4c, 0xfa, 0x59, 0xca, 0x34, 0x2b, 0x2e
+};
+
+// Ciphertext and length block from test case 2 of the GCM specification
+constexpr std::array<std::uint8_t, 32> Test_Data =
+{
+    0x03, 0x88, 0xda, 0xce, 0x60, 0xb6, 0xa3, 0x92,
+    0xf3, 0x28, 0xc2, 0xb9, 0x71, 0xb2, 0xfe, 0x78,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80
+};
+
+// Expected GHASH output from test case 2 of the GCM specification
+constexpr std::array<std::uint8_t, 16> Test_Digest =
+{
+    0xf3, 0x8c, 0xbb, 0x1a, 0xd6, 0x92, 0x23, 0xdc,
+    0xc3, 0x45, 0x7a, 0xe5, 0xb6, 0xb0, 0xf8, 0x85
+};
+
+} // namespace
+
+// Test the universal engine against the known answer
+STF_TEST(GHASHUniversal, KnownAnswer)
+{
+    std::array<std::uint8_t, 16> digest{};
+
+    GHASHUniversal ghash;
+
+    ghash.SetKey(Test_H);
+    ghash.Update(Test_Data);
+    ghash.GetDigest(digest);
+
+    STF_ASSERT_EQ(Test_Digest, digest);
+
+    // Feeding the data in separate block-aligned calls gives the same result
+    ghash.Reset();
+    ghash.Update(std::span(Test_Data).first(16));
+    ghash.Update(std::span(Test_Data).subspan(16));
+    ghash.GetDigest(digest);
+
+    STF_ASSERT_EQ(Test_Digest, digest);
+}
+
+#ifdef TERRA_USE_INTEL_INTRINSICS
+
+// Test the Intel engine against the known answer
+STF_TEST(GHASHIntel, KnownAnswer)
+{
+    if (!CPUSupportsPCLMULQDQ())
+    {
+        std::cerr << "PCLMULQDQ is not supported on this processor"
+                  << std::endl;
+        return;
+    }
+
+    std::array<std::uint8_t, 16> digest{};
+
+    GHASHIntel ghash;
+
+    ghash.SetKey(Test_H);
+    ghash.Update(Test_Data);
+    ghash.GetDigest(digest);
+
+    STF_ASSERT_EQ(Test_Digest, digest);
+}
+
+// Ensure the Intel engine agrees with the universal engine for all lengths
+// through several aggregated groups, including partial final blocks
+STF_TEST(GHASHIntel, CompareUniversal)
+{
+    if (!CPUSupportsPCLMULQDQ())
+    {
+        std::cerr << "PCLMULQDQ is not supported on this processor"
+                  << std::endl;
+        return;
+    }
+
+    std::array<std::uint8_t, 16> key{};
+    std::vector<std::uint8_t> data(400);
+    std::array<std::uint8_t, 16> expected_digest{};
+    std::array<std::uint8_t, 16> digest{};
+
+    for (std::size_t i = 0; i < key.size(); i++)
+    {
+        key[i] = static_cast<std::uint8_t>(0xa5 ^ (i * 17));
+    }
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i * 31 + 7);
+    }
+
+    GHASHUniversal ghash_universal;
+    GHASHIntel ghash_intel;
+
+    ghash_universal.SetKey(key);
+    ghash_intel.SetKey(key);
+
+    for (std::size_t length = 0; length <= data.size(); length++)
+    {
+        ghash_universal.Reset();
+        ghash_universal.Update(std::span(data).first(length));
+        ghash_universal.GetDigest(expected_digest);
+
+        ghash_intel.Reset();
+        ghash_intel.Update(std::span(data).first(length));
+        ghash_intel.GetDigest(digest);
+
+        STF_ASSERT_EQ(expected_digest, digest);
+    }
+}
+
+#endif // TERRA_USE_INTEL_INTRINSICS